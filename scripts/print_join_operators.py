@@ -0,0 +1,38 @@
+#!/usr/bin/env python3
+
+# Given a benchmark result json that was generated with --sql_metrics, this script prints which join operators the
+# LQPTranslator chose for each benchmark item. Use it to compare the plans of two builds, e.g.:
+#   ./hyriseBenchmarkTPCH -r 1 --sql_metrics -o tpch.json && ./scripts/print_join_operators.py tpch.json
+#   ./hyriseBenchmarkJoinOrder -r 1 --sql_metrics -o job.json && ./scripts/print_join_operators.py job.json
+
+import json
+import sys
+from collections import Counter
+
+if len(sys.argv) != 2:
+    exit("Usage: " + sys.argv[0] + " benchmark.json")
+
+with open(sys.argv[1]) as file:
+    data = json.load(file)
+
+total = Counter()
+
+for benchmark_json in data['benchmarks']:
+    runs = benchmark_json['successful_runs']
+    if len(runs) == 0:
+        continue
+    if len(runs[0]['metrics']) == 0:
+        exit("No metrics found. Did you run the benchmark with --sql_metrics?")
+
+    # The plan does not change between runs, so looking at the first one is sufficient
+    join_operators = Counter()
+    for metrics in runs[0]['metrics']:
+        for statement in metrics['statements']:
+            join_operators.update(statement.get('join_operators', []))
+
+    total.update(join_operators)
+    print('{:<20} {}'.format(benchmark_json['name'],
+                             ', '.join('{}x {}'.format(count, name) for name, count in sorted(join_operators.items()))))
+
+print()
+print('{:<20} {}'.format('Total', ', '.join('{}x {}'.format(count, name) for name, count in sorted(total.items()))))
@@ -79,6 +79,9 @@ def main():
   arguments["--scheduler"] = "true"
   arguments["--clients"] = "4"
   arguments["--verify"] = "true"
+  arguments["--morsel_pipelines"] = "true"
+  arguments["--plan_cache_shards"] = "8"
+  arguments["--statistics_sample_ratio"] = "0.5"
 
   benchmark = initialize(arguments, "hyriseBenchmarkTPCH", True)
 
@@ -90,6 +93,9 @@ def main():
   benchmark.expect_exact("Max runs per item is 100")
   benchmark.expect_exact("Max duration per item is 10 seconds")
   benchmark.expect_exact("Warmup duration per item is 10 seconds")
+  benchmark.expect_exact("Executing chunk-local operators in morsel pipelines")
+  benchmark.expect_exact("Plan caches are split into 8 shards with read-shared locks")
+  benchmark.expect_exact("Building the statistics of large tables from 50% of their chunks")
   benchmark.expect_exact("Benchmarking Queries: [ 2, 4, 6 ]")
   benchmark.expect_exact("TPCH scale factor is 0.01")
   benchmark.expect_exact("Using prepared statements: no")
@@ -5,6 +5,7 @@
 #include "benchmark/benchmark.h"
 #include "operators/aggregate_hash.hpp"
 #include "operators/table_wrapper.hpp"
+#include "synthetic_table_generator.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -24,4 +25,32 @@ BENCHMARK_F(MicroBenchmarkBasicFixture, BM_Aggregate)(benchmark::State& state) {
   }
 }
 
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_AggregateCountDistinctHighCardinality)(benchmark::State& state) {
+  // Most groups have only a few rows, most of which hold a value that is distinct within the group. This stresses the
+  // deduplication of (group, value) pairs rather than the lookup of the groups.
+  const auto row_count = size_t{1'000'000};
+  const auto group_count = 200'000.0;
+  const auto distinct_value_count = 100'000.0;
+
+  const auto table = SyntheticTableGenerator::generate_table(
+      {ColumnDataDistribution::make_uniform_config(0.0, group_count),
+       ColumnDataDistribution::make_uniform_config(0.0, distinct_value_count)},
+      {DataType::Int, DataType::Int}, row_count, ChunkOffset{100'000});
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  _clear_cache();
+
+  std::vector<AggregateColumnDefinition> aggregates = {{ColumnID{1} /* "b" */, AggregateFunction::CountDistinct}};
+
+  std::vector<ColumnID> groupby = {ColumnID{0} /* "a" */};
+
+  auto warm_up = std::make_shared<AggregateHash>(table_wrapper, aggregates, groupby);
+  warm_up->execute();
+  for (auto _ : state) {
+    auto aggregate = std::make_shared<AggregateHash>(table_wrapper, aggregates, groupby);
+    aggregate->execute();
+  }
+}
+
 }  // namespace opossum
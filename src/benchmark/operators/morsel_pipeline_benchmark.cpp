@@ -0,0 +1,108 @@
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "../micro_benchmark_basic_fixture.hpp"
+#include "expression/expression_functional.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "hyrise.hpp"
+#include "operators/aggregate_hash.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/morsel_pipeline.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/operator_task.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+/**
+ * Compares the execution of the same plan with and without MorselPipelines (see create_morsel_pipelines()). The plans
+ * are executed by the NodeQueueScheduler, so that the operators (or morsels) run concurrently.
+ *
+ * @param create_plan is called with fresh TableWrappers of the two tables of the fixture in every iteration.
+ */
+template <UseMorselPipelines use_morsel_pipelines>
+void benchmark_morsel_pipeline_impl(
+    benchmark::State& state, const std::shared_ptr<const Table>& table_a, const std::shared_ptr<const Table>& table_b,
+    const std::function<std::shared_ptr<AbstractOperator>(const std::shared_ptr<AbstractOperator>&,
+                                                          const std::shared_ptr<AbstractOperator>&)>& create_plan) {
+  Hyrise::get().topology.use_default_topology();
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  for (auto _ : state) {
+    auto plan = create_plan(std::make_shared<TableWrapper>(table_a), std::make_shared<TableWrapper>(table_b));
+    if constexpr (use_morsel_pipelines == UseMorselPipelines::Yes) {
+      plan = create_morsel_pipelines(plan);
+    }
+
+    const auto tasks = OperatorTask::make_tasks_from_operator(plan, CleanupTemporaries::Yes);
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+  }
+
+  Hyrise::get().scheduler()->finish();
+}
+
+// TableScan -> TableScan -> Projection
+template <UseMorselPipelines use_morsel_pipelines>
+void benchmark_scan_projection(benchmark::State& state, const std::shared_ptr<const Table>& table_a,
+                               const std::shared_ptr<const Table>& table_b) {
+  const auto a = PQPColumnExpression::from_table(*table_a, "column_1");
+  const auto b = PQPColumnExpression::from_table(*table_a, "column_2");
+
+  benchmark_morsel_pipeline_impl<use_morsel_pipelines>(
+      state, table_a, table_b, [&](const auto& table_wrapper_a, const auto& table_wrapper_b) {
+        const auto table_scan_a = std::make_shared<TableScan>(table_wrapper_a, greater_than_(a, 100));
+        const auto table_scan_b = std::make_shared<TableScan>(table_scan_a, less_than_(b, 900));
+        return std::make_shared<Projection>(table_scan_b, expression_vector(a, add_(a, b)));
+      });
+}
+
+// TableScan -> JoinHash (probing with the scanned rows) -> AggregateHash
+template <UseMorselPipelines use_morsel_pipelines>
+void benchmark_scan_join_aggregate(benchmark::State& state, const std::shared_ptr<const Table>& table_a,
+                                   const std::shared_ptr<const Table>& table_b) {
+  const auto a = PQPColumnExpression::from_table(*table_a, "column_1");
+
+  benchmark_morsel_pipeline_impl<use_morsel_pipelines>(
+      state, table_a, table_b, [&](const auto& table_wrapper_a, const auto& table_wrapper_b) {
+        const auto table_scan = std::make_shared<TableScan>(table_wrapper_a, greater_than_(a, 100));
+        const auto join = std::make_shared<JoinHash>(
+            table_scan, table_wrapper_b, JoinMode::Semi,
+            OperatorJoinPredicate{{ColumnID{1}, ColumnID{0}}, PredicateCondition::Equals});
+        return std::make_shared<AggregateHash>(
+            join, std::vector<AggregateColumnDefinition>{{ColumnID{1}, AggregateFunction::Sum}},
+            std::vector<ColumnID>{ColumnID{0}});
+      });
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_MorselPipeline_ScanProjection_OperatorAtATime)(benchmark::State& state) {
+  _clear_cache();
+  benchmark_scan_projection<UseMorselPipelines::No>(state, _table_wrapper_a->get_output(),
+                                                    _table_wrapper_b->get_output());
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_MorselPipeline_ScanProjection_Pipelined)(benchmark::State& state) {
+  _clear_cache();
+  benchmark_scan_projection<UseMorselPipelines::Yes>(state, _table_wrapper_a->get_output(),
+                                                     _table_wrapper_b->get_output());
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_MorselPipeline_ScanJoinAggregate_OperatorAtATime)(benchmark::State& state) {
+  _clear_cache();
+  benchmark_scan_join_aggregate<UseMorselPipelines::No>(state, _table_wrapper_a->get_output(),
+                                                        _table_wrapper_b->get_output());
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_MorselPipeline_ScanJoinAggregate_Pipelined)(benchmark::State& state) {
+  _clear_cache();
+  benchmark_scan_join_aggregate<UseMorselPipelines::Yes>(state, _table_wrapper_a->get_output(),
+                                                         _table_wrapper_b->get_output());
+}
+
+}  // namespace opossum
@@ -1,10 +1,42 @@
 #include <memory>
+#include <vector>
 
 #include "benchmark/benchmark.h"
 
 #include "../micro_benchmark_basic_fixture.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_wrapper.hpp"
+#include "synthetic_table_generator.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Generates a table with uniformly distributed values that has as many rows and chunks as the tables of the
+// MicroBenchmarkBasicFixture
+std::shared_ptr<TableWrapper> create_sort_input(const std::vector<DataType>& data_types) {
+  const auto column_data_distributions =
+      std::vector<ColumnDataDistribution>(data_types.size(), ColumnDataDistribution::make_uniform_config(0.0, 1'000.0));
+
+  const auto table_wrapper = std::make_shared<TableWrapper>(SyntheticTableGenerator::generate_table(
+      column_data_distributions, data_types, size_t{40'000}, ChunkOffset{2'000}));
+  table_wrapper->execute();
+  return table_wrapper;
+}
+
+void benchmark_sort(benchmark::State& state, const std::shared_ptr<TableWrapper>& input,
+                    const std::vector<SortColumnDefinition>& sort_definitions) {
+  micro_benchmark_clear_cache();
+
+  auto warm_up = std::make_shared<Sort>(input, sort_definitions);
+  warm_up->execute();
+  for (auto _ : state) {
+    auto sort = std::make_shared<Sort>(input, sort_definitions);
+    sort->execute();
+  }
+}
+
+}  // namespace
 
 namespace opossum {
 
@@ -19,4 +51,25 @@ BENCHMARK_F(MicroBenchmarkBasicFixture, BM_Sort)(benchmark::State& state) {
   }
 }
 
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_SortMultiColumn)(benchmark::State& state) {
+  // Few distinct values, so that the secondary and tertiary columns decide the order of many rows
+  const auto input = create_sort_input({DataType::Int, DataType::Long, DataType::Double});
+  benchmark_sort(state, input,
+                 {SortColumnDefinition{ColumnID{0}, OrderByMode::Ascending},
+                  SortColumnDefinition{ColumnID{1}, OrderByMode::Descending},
+                  SortColumnDefinition{ColumnID{2}, OrderByMode::AscendingNullsLast}});
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_SortString)(benchmark::State& state) {
+  const auto input = create_sort_input({DataType::String});
+  benchmark_sort(state, input, {SortColumnDefinition{ColumnID{0}, OrderByMode::Ascending}});
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_SortStringMultiColumn)(benchmark::State& state) {
+  const auto input = create_sort_input({DataType::String, DataType::Int});
+  benchmark_sort(state, input,
+                 {SortColumnDefinition{ColumnID{0}, OrderByMode::Descending},
+                  SortColumnDefinition{ColumnID{1}, OrderByMode::Ascending}});
+}
+
 }  // namespace opossum
@@ -0,0 +1,75 @@
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "hyrise.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+
+namespace opossum {
+
+/**
+ * Measures the throughput of the NodeQueueScheduler for many small JobTasks, as they are spawned by, e.g., JoinHash or
+ * AggregateHash. A number of "operator" tasks is scheduled from the main thread, each of which spawns NUM_JOBS jobs
+ * that only do a minimal amount of work and then waits for them.
+ *
+ * The template parameter determines whether the workers use work-stealing deques, the benchmark argument is the number
+ * of workers. Note that the number of workers is capped by the number of available cores.
+ */
+template <UseWorkerDeques use_worker_deques>
+static void BM_Scheduler_JobThroughput(benchmark::State& state) {  // NOLINT
+  constexpr auto NUM_OPERATOR_TASKS = 16;
+  constexpr auto NUM_JOBS = 256;
+  constexpr auto VALUES_PER_JOB = 1'000;
+
+  const auto num_workers = static_cast<uint32_t>(state.range(0));
+
+  Hyrise::get().topology.use_default_topology(num_workers);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>(use_worker_deques));
+
+  auto values = std::vector<uint64_t>(VALUES_PER_JOB);
+  for (auto value_idx = size_t{0}; value_idx < values.size(); ++value_idx) {
+    values[value_idx] = value_idx;
+  }
+  auto sum = std::atomic<uint64_t>{0};
+
+  for (auto _ : state) {
+    auto operator_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+    operator_tasks.reserve(NUM_OPERATOR_TASKS);
+
+    for (auto operator_task_idx = 0; operator_task_idx < NUM_OPERATOR_TASKS; ++operator_task_idx) {
+      operator_tasks.emplace_back(std::make_shared<JobTask>([&]() {
+        auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+        jobs.reserve(NUM_JOBS);
+
+        for (auto job_idx = 0; job_idx < NUM_JOBS; ++job_idx) {
+          jobs.emplace_back(std::make_shared<JobTask>([&]() {
+            auto local_sum = uint64_t{0};
+            for (const auto value : values) {
+              local_sum += value;
+            }
+            sum += local_sum;
+          }));
+        }
+
+        Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+      }));
+    }
+
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(operator_tasks);
+  }
+
+  benchmark::DoNotOptimize(sum.load());
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * NUM_OPERATOR_TASKS * (NUM_JOBS + 1));
+  state.counters["workers"] = static_cast<double>(Hyrise::get().topology.num_cpus());
+
+  Hyrise::get().scheduler()->finish();
+  Hyrise::reset();
+}
+
+BENCHMARK_TEMPLATE(BM_Scheduler_JobThroughput, UseWorkerDeques::No)->Arg(1)->Arg(8)->Arg(32)->Arg(64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Scheduler_JobThroughput, UseWorkerDeques::Yes)->Arg(1)->Arg(8)->Arg(32)->Arg(64)->UseRealTime();
+
+}  // namespace opossum
@@ -1,9 +1,11 @@
 #include "tpcc/tpcc_table_generator.hpp"
 
 #include <algorithm>
+#include <filesystem>
 
 #include "benchmark_runner.hpp"
 #include "cli_config_parser.hpp"
+#include "hyrise.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "tpcc/constants.hpp"
 #include "tpcc/tpcc_benchmark_item_runner.hpp"
@@ -19,7 +21,7 @@ using namespace opossum;  // NOLINT
  * Other limitations (that may be removed in the future):
  *  - No primary / foreign keys are used as they are currently unsupported
  *  - Values that are "retrieved" by the terminal are just selected, but not necessarily materialized
- *  - Data is not persisted as logging is currently unsupported; this means that the durability tests are not executed
+ *  - Data is only persisted if a redo log is given (--redo_log); even then, the durability tests are not executed
  *  - As decimals are not supported, we use floats instead
  *  - The delivery transaction is not executed in a "deferred" mode; as such, no delivery result file is written
  *  - We do not execute the isolation tests, as we consider our MVCC tests to be sufficient
@@ -41,18 +43,21 @@ int main(int argc, char* argv[]) {
   cli_options.add_options()
     // We use -s instead of -w for consistency with the options of our other TPC-x binaries.
     ("s,scale", "Scale factor (warehouses)", cxxopts::value<int>()->default_value("1")) // NOLINT
-    ("consistency_checks", "Run TPC-C consistency checks after benchmark (included with --verify)", cxxopts::value<bool>()->default_value("false")); // NOLINT
+    ("consistency_checks", "Run TPC-C consistency checks after benchmark (included with --verify)", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("redo_log", "Path of a redo log that committed transactions are written to (an existing file is overwritten)", cxxopts::value<std::string>()->default_value("")); // NOLINT
   // clang-format on
 
   std::shared_ptr<BenchmarkConfig> config;
   int num_warehouses;
   bool consistency_checks;
+  std::string redo_log_path;
 
   if (CLIConfigParser::cli_has_json_config(argc, argv)) {
     // JSON config file was passed in
     const auto json_config = CLIConfigParser::parse_json_config_file(argv[1]);
     num_warehouses = json_config.value("scale", 1);
     consistency_checks = json_config.value("consistency_checks", false);
+    redo_log_path = json_config.value("redo_log", "");
 
     config = std::make_shared<BenchmarkConfig>(CLIConfigParser::parse_basic_options_json_config(json_config));
   } else {
@@ -63,6 +68,7 @@ int main(int argc, char* argv[]) {
 
     num_warehouses = cli_parse_result["scale"].as<int>();
     consistency_checks = cli_parse_result["consistency_checks"].as<bool>();
+    redo_log_path = cli_parse_result["redo_log"].as<std::string>();
 
     config = std::make_shared<BenchmarkConfig>(CLIConfigParser::parse_basic_cli_options(cli_parse_result));
   }
@@ -78,6 +84,14 @@ int main(int argc, char* argv[]) {
   // Add TPC-C-specific information
   context.emplace("scale_factor", num_warehouses);
 
+  // The log is enabled before the tables are generated so that it contains the initial data
+  if (!redo_log_path.empty()) {
+    std::cout << "- Writing redo log to " << redo_log_path << std::endl;
+    std::filesystem::remove(redo_log_path);
+    Hyrise::get().redo_log.enable(redo_log_path);
+    context.emplace("redo_log", redo_log_path);
+  }
+
   // Run the benchmark
   auto item_runner = std::make_unique<TPCCBenchmarkItemRunner>(config, num_warehouses);
   BenchmarkRunner(*config, std::move(item_runner), std::make_unique<TPCCTableGenerator>(num_warehouses, config),
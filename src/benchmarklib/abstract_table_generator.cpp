@@ -6,6 +6,10 @@
 #include "import_export/binary/binary_writer.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_wrapper.hpp"
+#include "resolve_type.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/abstract_histogram.hpp"
+#include "statistics/table_statistics.hpp"
 #include "storage/index/group_key/composite_group_key_index.hpp"
 #include "storage/index/group_key/group_key_index.hpp"
 #include "utils/format_duration.hpp"
@@ -19,7 +23,10 @@ void to_json(nlohmann::json& json, const TableGenerationMetrics& metrics) {
           {"binary_caching_duration", metrics.binary_caching_duration.count()},
           {"sort_duration", metrics.sort_duration.count()},
           {"store_duration", metrics.store_duration.count()},
-          {"index_duration", metrics.index_duration.count()}};
+          {"index_duration", metrics.index_duration.count()},
+          {"complete_statistics_duration", metrics.complete_statistics_duration.count()},
+          {"mean_distinct_count_q_error", metrics.mean_distinct_count_q_error},
+          {"max_distinct_count_q_error", metrics.max_distinct_count_q_error}};
 }
 
 BenchmarkTableInfo::BenchmarkTableInfo(const std::shared_ptr<Table>& table) : table(table) {}
@@ -166,6 +173,57 @@ void AbstractTableGenerator::generate_and_store() {
   std::cout << "- Adding tables to StorageManager and generating statistics done ("
             << format_duration(metrics.store_duration) << ")" << std::endl;
 
+  /**
+   * Compare sampled statistics with complete ones
+   */
+  const auto& sampling = TableStatistics::default_sampling;
+  if (sampling) {
+    std::cout << "- Comparing sampled statistics with complete statistics" << std::endl;
+    auto q_error_sum = 0.0f;
+    auto compared_column_count = size_t{0};
+
+    for (const auto& [table_name, table_info] : table_info_by_name) {
+      const auto& table = *table_info.table;
+      if (!sampling->applies_to(table)) continue;
+
+      const auto sampled_statistics = table.table_statistics();
+      const auto complete_statistics = TableStatistics::from_table(table, std::nullopt);
+
+      for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+        resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+          using ColumnDataType = typename decltype(type)::type;
+
+          const auto distinct_count = [&](const TableStatistics& table_statistics) {
+            const auto& attribute_statistics = static_cast<const AttributeStatistics<ColumnDataType>&>(
+                *table_statistics.column_statistics[column_id]);
+            const auto histogram =
+                std::dynamic_pointer_cast<AbstractHistogram<ColumnDataType>>(attribute_statistics.histogram);
+            return histogram ? histogram->total_distinct_count() : 0.0f;
+          };
+
+          const auto sampled_distinct_count = distinct_count(*sampled_statistics);
+          const auto complete_distinct_count = distinct_count(*complete_statistics);
+          if (sampled_distinct_count == 0.0f || complete_distinct_count == 0.0f) return;
+
+          const auto q_error = std::max(sampled_distinct_count / complete_distinct_count,
+                                        complete_distinct_count / sampled_distinct_count);
+          q_error_sum += q_error;
+          ++compared_column_count;
+          metrics.max_distinct_count_q_error = std::max(metrics.max_distinct_count_q_error, q_error);
+        });
+      }
+    }
+
+    if (compared_column_count > 0) {
+      metrics.mean_distinct_count_q_error = q_error_sum / static_cast<float>(compared_column_count);
+    }
+    metrics.complete_statistics_duration = timer.lap();
+
+    std::cout << "- Comparing sampled statistics with complete statistics done ("
+              << format_duration(metrics.complete_statistics_duration) << "), q-error of the distinct counts: mean "
+              << metrics.mean_distinct_count_q_error << ", max " << metrics.max_distinct_count_q_error << std::endl;
+  }
+
   /**
    * Create indexes if requested by the user
    */
@@ -42,6 +42,13 @@ struct TableGenerationMetrics {
   std::chrono::nanoseconds sort_duration{};
   std::chrono::nanoseconds store_duration{};
   std::chrono::nanoseconds index_duration{};
+
+  // Only set if the statistics are built from samples (see StatisticsSampling). The time to build complete statistics
+  // of the sampled tables and the q-errors of the sampled distinct counts, which allow for weighing the estimate
+  // quality against the time saved in store_duration.
+  std::chrono::nanoseconds complete_statistics_duration{};
+  float mean_distinct_count_q_error{1.0f};
+  float max_distinct_count_q_error{1.0f};
 };
 
 void to_json(nlohmann::json& json, const TableGenerationMetrics& metrics);
@@ -7,7 +7,9 @@ BenchmarkConfig::BenchmarkConfig(const BenchmarkMode benchmark_mode, const Chunk
                                  const Duration& max_duration, const Duration& warmup_duration,
                                  const std::optional<std::string>& output_file_path, const bool enable_scheduler,
                                  const uint32_t cores, const uint32_t clients, const bool enable_visualization,
-                                 const bool verify, const bool cache_binary_tables, const bool sql_metrics)
+                                 const bool verify, const bool cache_binary_tables, const bool sql_metrics,
+                                 const bool morsel_pipelines, const uint32_t plan_cache_shards,
+                                 const bool parameterized_plan_cache, const float statistics_sample_ratio)
     : benchmark_mode(benchmark_mode),
       chunk_size(chunk_size),
       encoding_config(encoding_config),
@@ -22,7 +24,11 @@ BenchmarkConfig::BenchmarkConfig(const BenchmarkMode benchmark_mode, const Chunk
       enable_visualization(enable_visualization),
       verify(verify),
       cache_binary_tables(cache_binary_tables),
-      sql_metrics(sql_metrics) {}
+      sql_metrics(sql_metrics),
+      morsel_pipelines(morsel_pipelines),
+      plan_cache_shards(plan_cache_shards),
+      parameterized_plan_cache(parameterized_plan_cache),
+      statistics_sample_ratio(statistics_sample_ratio) {}
 
 BenchmarkConfig BenchmarkConfig::get_default_config() { return BenchmarkConfig(); }
 
@@ -23,7 +23,9 @@ class BenchmarkConfig {
                   const Duration& max_duration, const Duration& warmup_duration,
                   const std::optional<std::string>& output_file_path, const bool enable_scheduler, const uint32_t cores,
                   const uint32_t clients, const bool enable_visualization, const bool verify,
-                  const bool cache_binary_tables, const bool sql_metrics);
+                  const bool cache_binary_tables, const bool sql_metrics, const bool morsel_pipelines,
+                  const uint32_t plan_cache_shards, const bool parameterized_plan_cache,
+                  const float statistics_sample_ratio);
 
   static BenchmarkConfig get_default_config();
 
@@ -42,6 +44,10 @@ class BenchmarkConfig {
   bool verify = false;
   bool cache_binary_tables = false;
   bool sql_metrics = false;
+  bool morsel_pipelines = false;
+  uint32_t plan_cache_shards = 0;
+  bool parameterized_plan_cache = false;
+  float statistics_sample_ratio = 0.0f;
 
   static const char* description;
 
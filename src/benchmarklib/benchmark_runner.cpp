@@ -8,10 +8,14 @@
 #include "cxxopts.hpp"
 
 #include "benchmark_config.hpp"
+#include "cache/sharded_gdfs_cache.hpp"
 #include "constant_mappings.hpp"
 #include "hyrise.hpp"
 #include "scheduler/job_task.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/worker.hpp"
 #include "sql/sql_pipeline_builder.hpp"
+#include "statistics/table_statistics.hpp"
 #include "storage/chunk.hpp"
 #include "tpch/tpch_table_generator.hpp"
 #include "utils/format_duration.hpp"
@@ -30,6 +34,25 @@ BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& config,
       _context(context) {
   SQLPipelineBuilder::default_pqp_cache = std::make_shared<SQLPhysicalPlanCache>();
   SQLPipelineBuilder::default_lqp_cache = std::make_shared<SQLLogicalPlanCache>();
+  // Generic plans are not pruned or specialized for the literals of a statement, so they change the measured plans
+  if (config.parameterized_plan_cache) {
+    SQLPipelineBuilder::default_parameterized_plan_cache = std::make_shared<SQLParameterizedPlanCache>();
+  }
+
+  // With many clients, the single mutex of the default GDFS cache becomes a contention point for short queries
+  if (config.plan_cache_shards > 0) {
+    SQLPipelineBuilder::default_pqp_cache
+        ->replace_cache_impl<ShardedGDFSCache<std::string, std::shared_ptr<AbstractOperator>>>(
+            DefaultCacheCapacity, config.plan_cache_shards);
+    SQLPipelineBuilder::default_lqp_cache
+        ->replace_cache_impl<ShardedGDFSCache<std::string, std::shared_ptr<AbstractLQPNode>>>(
+            DefaultCacheCapacity, config.plan_cache_shards);
+    if (SQLPipelineBuilder::default_parameterized_plan_cache) {
+      SQLPipelineBuilder::default_parameterized_plan_cache
+          ->replace_cache_impl<ShardedGDFSCache<NormalizedStatement, std::shared_ptr<ParameterizedPlan>>>(
+              DefaultCacheCapacity, config.plan_cache_shards);
+    }
+  }
 
   // Initialise the scheduler if the benchmark was requested to run multi-threaded
   if (config.enable_scheduler) {
@@ -48,6 +71,11 @@ BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& config,
     Hyrise::get().set_scheduler(scheduler);
   }
 
+  // Tables are added to the StorageManager, which builds their statistics, by generate_and_store()
+  if (config.statistics_sample_ratio > 0.0f) {
+    TableStatistics::default_sampling = StatisticsSampling{config.statistics_sample_ratio};
+  }
+
   _table_generator->generate_and_store();
 
   _benchmark_item_runner->on_tables_loaded();
@@ -326,7 +354,11 @@ void BenchmarkRunner::_create_report(std::ostream& stream) const {
                                {"optimization_duration", sql_statement_metrics->optimization_duration.count()},
                                {"lqp_translation_duration", sql_statement_metrics->lqp_translation_duration.count()},
                                {"plan_execution_duration", sql_statement_metrics->plan_execution_duration.count()},
-                               {"query_plan_cache_hit", sql_statement_metrics->query_plan_cache_hit}};
+                               {"query_plan_cache_hit", sql_statement_metrics->query_plan_cache_hit},
+                               {"parameterized_plan_cache_hit", sql_statement_metrics->parameterized_plan_cache_hit},
+                               {"parameterized_plan_cache_hit_rate",
+                                sql_statement_metrics->parameterized_plan_cache_hit_rate},
+                               {"join_operators", sql_statement_metrics->join_operators}};
 
             pipeline_metrics_json["statements"].push_back(sql_statement_metrics_json);
           }
@@ -378,6 +410,30 @@ void BenchmarkRunner::_create_report(std::ostream& stream) const {
       {"table_size_in_bytes", table_size},
       {"total_duration", std::chrono::duration_cast<std::chrono::nanoseconds>(_total_run_duration).count()}};
 
+  // Report how often idle workers were woken up. For short-running items (e.g., TPC-C), the wake-up latency can make
+  // up a significant part of the execution time.
+  if (const auto node_queue_scheduler = std::dynamic_pointer_cast<NodeQueueScheduler>(Hyrise::get().scheduler())) {
+    auto num_wakeups = uint64_t{0};
+    auto num_spurious_wakeups = uint64_t{0};
+    auto accumulated_wakeup_latency = std::chrono::nanoseconds{0};
+    for (const auto& worker : node_queue_scheduler->workers()) {
+      num_wakeups += worker->num_wakeups();
+      num_spurious_wakeups += worker->num_spurious_wakeups();
+      accumulated_wakeup_latency += worker->accumulated_wakeup_latency();
+    }
+
+    summary["scheduler"] = {
+        {"wakeups", num_wakeups},
+        {"spurious_wakeups", num_spurious_wakeups},
+        {"avg_wakeup_latency", num_wakeups > 0 ? accumulated_wakeup_latency.count() / num_wakeups : 0}};
+  }
+
+  // With group commit, the number of records per flush shows how well the cost of fdatasync is amortized
+  const auto& redo_log = Hyrise::get().redo_log;
+  if (redo_log.is_enabled()) {
+    summary["redo_log"] = {{"flushes", redo_log.flush_count()}, {"records", redo_log.flushed_record_count()}};
+  }
+
   nlohmann::json report{{"context", _context},
                         {"benchmarks", benchmarks},
                         {"summary", summary},
@@ -422,7 +478,11 @@ cxxopts::Options BenchmarkRunner::get_basic_cli_options(const std::string& bench
     ("visualize", "Create a visualization image of one LQP and PQP for each query, do not properly run the benchmark", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("verify", "Verify each query by comparing it with the SQLite result", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("cache_binary_tables", "Cache tables as binary files for faster loading on subsequent runs", cxxopts::value<bool>()->default_value("false")) // NOLINT
-    ("sql_metrics", "Track SQL metrics (parse time etc.) for each SQL query and add it to the output JSON (see -o)", cxxopts::value<bool>()->default_value("false")); // NOLINT
+    ("sql_metrics", "Track SQL metrics (parse time etc.) for each SQL query and add it to the output JSON (see -o)", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("morsel_pipelines", "Execute chains of TableScans, Validates, and Projections chunk by chunk instead of materializing each operator's output", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("plan_cache_shards", "Number of shards of the plan caches, which can be read concurrently. Use many --clients to measure the contention. 0 means a single cache behind one mutex", cxxopts::value<uint>()->default_value("0")) // NOLINT
+    ("parameterized_plan_cache", "Reuse a generic plan for statements that only differ in their literals. Generic plans are not pruned or specialized for the literals", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("statistics_sample_ratio", "Share of the chunks from which the histograms of tables with at least a million rows are built. The sampled statistics are compared with complete ones in the table generation metrics. 0 means all chunks", cxxopts::value<float>()->default_value("0")); // NOLINT
   // clang-format on
 
   return cli_options;
@@ -461,6 +521,10 @@ nlohmann::json BenchmarkRunner::create_context(const BenchmarkConfig& config) {
       {"cores", config.cores},
       {"clients", config.clients},
       {"verify", config.verify},
+      {"morsel_pipelines", config.morsel_pipelines},
+      {"plan_cache_shards", config.plan_cache_shards},
+      {"parameterized_plan_cache", config.parameterized_plan_cache},
+      {"statistics_sample_ratio", config.statistics_sample_ratio},
       {"time_unit", "ns"},
       {"GIT-HASH", GIT_HEAD_SHA1 + std::string(GIT_IS_DIRTY ? "-dirty" : "")}};
 }
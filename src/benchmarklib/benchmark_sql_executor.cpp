@@ -8,10 +8,12 @@
 
 namespace opossum {
 BenchmarkSQLExecutor::BenchmarkSQLExecutor(const std::shared_ptr<SQLiteWrapper>& sqlite_wrapper,
-                                           const std::optional<std::string>& visualize_prefix)
+                                           const std::optional<std::string>& visualize_prefix,
+                                           const UseMorselPipelines use_morsel_pipelines)
     : _sqlite_connection(sqlite_wrapper ? std::optional<SQLiteWrapper::Connection>{sqlite_wrapper->new_connection()}
                                         : std::optional<SQLiteWrapper::Connection>{}),
-      _visualize_prefix(visualize_prefix) {
+      _visualize_prefix(visualize_prefix),
+      _use_morsel_pipelines(use_morsel_pipelines) {
   if (_sqlite_connection) {
     _sqlite_connection->raw_execute_query("BEGIN TRANSACTION");
     _sqlite_transaction_open = true;
@@ -23,6 +25,7 @@ std::pair<SQLPipelineStatus, std::shared_ptr<const Table>> BenchmarkSQLExecutor:
   auto pipeline_builder = SQLPipelineBuilder{sql};
   if (_visualize_prefix) pipeline_builder.dont_cleanup_temporaries();
   if (transaction_context) pipeline_builder.with_transaction_context(transaction_context);
+  pipeline_builder.with_morsel_pipelines(_use_morsel_pipelines);
 
   auto pipeline = pipeline_builder.create_pipeline();
 
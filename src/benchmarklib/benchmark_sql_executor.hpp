@@ -14,8 +14,10 @@ class BenchmarkSQLExecutor {
  public:
   // @param visualize_prefix    Prefix for the filename of the generated query plans (e.g., "TPC-H_6-").
   //                            The suffix will be "LQP/PQP-<statement_idx>.<extension>"
+  // @param use_morsel_pipelines  Whether the SQLPipelines fuse chunk-local operators, see MorselPipeline
   BenchmarkSQLExecutor(const std::shared_ptr<SQLiteWrapper>& sqlite_wrapper,
-                       const std::optional<std::string>& visualize_prefix);
+                       const std::optional<std::string>& visualize_prefix,
+                       const UseMorselPipelines use_morsel_pipelines = UseMorselPipelines::No);
 
   ~BenchmarkSQLExecutor();
 
@@ -49,6 +51,8 @@ class BenchmarkSQLExecutor {
 
   const std::optional<std::string> _visualize_prefix;
   uint64_t _num_visualized_plans{0};
+
+  const UseMorselPipelines _use_morsel_pipelines;
 };
 
 }  // namespace opossum
@@ -148,10 +148,44 @@ BenchmarkConfig CLIConfigParser::parse_basic_options_json_config(const nlohmann:
     std::cout << "- Not tracking SQL metrics" << std::endl;
   }
 
+  const auto morsel_pipelines = json_config.value("morsel_pipelines", default_config.morsel_pipelines);
+  if (morsel_pipelines) {
+    std::cout << "- Executing chunk-local operators in morsel pipelines" << std::endl;
+  } else {
+    std::cout << "- Executing operators one at a time" << std::endl;
+  }
+
+  const auto plan_cache_shards = json_config.value("plan_cache_shards", default_config.plan_cache_shards);
+  if (plan_cache_shards > 0) {
+    std::cout << "- Plan caches are split into " << plan_cache_shards << " shards with read-shared locks" << std::endl;
+  } else {
+    std::cout << "- Plan caches are protected by a single mutex" << std::endl;
+  }
+
+  const auto parameterized_plan_cache =
+      json_config.value("parameterized_plan_cache", default_config.parameterized_plan_cache);
+  if (parameterized_plan_cache) {
+    std::cout << "- Caching generic plans of statements that only differ in their literals" << std::endl;
+  } else {
+    std::cout << "- Not caching generic plans" << std::endl;
+  }
+
+  const auto statistics_sample_ratio =
+      json_config.value("statistics_sample_ratio", default_config.statistics_sample_ratio);
+  Assert(statistics_sample_ratio >= 0.0f && statistics_sample_ratio <= 1.0f,
+         "statistics_sample_ratio must be between 0 and 1");
+  if (statistics_sample_ratio > 0.0f) {
+    std::cout << "- Building the statistics of large tables from " << statistics_sample_ratio * 100.0f
+              << "% of their chunks" << std::endl;
+  } else {
+    std::cout << "- Building statistics from all values" << std::endl;
+  }
+
   return BenchmarkConfig{
-      benchmark_mode,  chunk_size,          *encoding_config, indexes, max_runs, timeout_duration,
-      warmup_duration, output_file_path,    enable_scheduler, cores,   clients,  enable_visualization,
-      verify,          cache_binary_tables, sql_metrics};
+      benchmark_mode,   chunk_size,           *encoding_config,         indexes,                 max_runs,
+      timeout_duration, warmup_duration,      output_file_path,         enable_scheduler,        cores,
+      clients,          enable_visualization, verify,                   cache_binary_tables,     sql_metrics,
+      morsel_pipelines, plan_cache_shards,    parameterized_plan_cache, statistics_sample_ratio};
 }
 
 BenchmarkConfig CLIConfigParser::parse_basic_cli_options(const cxxopts::ParseResult& parse_result) {
@@ -177,6 +211,10 @@ nlohmann::json CLIConfigParser::basic_cli_options_to_json(const cxxopts::ParseRe
   json_config.emplace("verify", parse_result["verify"].as<bool>());
   json_config.emplace("cache_binary_tables", parse_result["cache_binary_tables"].as<bool>());
   json_config.emplace("sql_metrics", parse_result["sql_metrics"].as<bool>());
+  json_config.emplace("morsel_pipelines", parse_result["morsel_pipelines"].as<bool>());
+  json_config.emplace("plan_cache_shards", parse_result["plan_cache_shards"].as<uint>());
+  json_config.emplace("parameterized_plan_cache", parse_result["parameterized_plan_cache"].as<bool>());
+  json_config.emplace("statistics_sample_ratio", parse_result["statistics_sample_ratio"].as<float>());
 
   return json_config;
 }
@@ -139,6 +139,8 @@ Console::Console()
   register_command("generate_tpcds", std::bind(&Console::_generate_tpcds, this, std::placeholders::_1));
   register_command("load", std::bind(&Console::_load_table, this, std::placeholders::_1));
   register_command("export", std::bind(&Console::_export_table, this, std::placeholders::_1));
+  register_command("checkpoint", std::bind(&Console::_write_checkpoint, this, std::placeholders::_1));
+  register_command("load_checkpoint", std::bind(&Console::_load_checkpoint, this, std::placeholders::_1));
   register_command("script", std::bind(&Console::_exec_script, this, std::placeholders::_1));
   register_command("print", std::bind(&Console::_print_table, this, std::placeholders::_1));
   register_command("visualize", std::bind(&Console::_visualize, this, std::placeholders::_1));
@@ -410,6 +412,8 @@ int Console::_help(const std::string&) {
   out("  export TABLENAME FILEPATH               - Export table named TABLENAME from storage manager to filepath FILEPATH\n");  // NOLINT
   out("                                               The export type is chosen by the type of FILEPATH.\n");
   out("                                                 Supported types: '.bin', '.csv'\n");
+  out("  checkpoint DIRECTORY                    - Write a consistent snapshot of all tables into DIRECTORY\n");
+  out("  load_checkpoint DIRECTORY               - Load all tables from the checkpoint in DIRECTORY\n");
   out("  script SCRIPTFILE                       - Execute script specified by SCRIPTFILE\n");
   out("  print TABLENAME                         - Fully print the given table (including MVCC data)\n");
   out("  visualize [options] [SQL]               - Visualize a SQL query\n");
@@ -606,6 +610,47 @@ int Console::_export_table(const std::string& args) {
   return ReturnCode::Ok;
 }
 
+int Console::_write_checkpoint(const std::string& args) {
+  std::vector<std::string> arguments = trim_and_split(args);
+
+  if (arguments.size() != 1) {
+    out("Usage:\n");
+    out("  checkpoint DIRECTORY\n");
+    return ReturnCode::Error;
+  }
+
+  out("Writing checkpoint into \"" + arguments[0] + "\" ...\n");
+  try {
+    const auto snapshot_commit_id = Hyrise::get().storage_manager.write_checkpoint(arguments[0]);
+    out("Checkpoint contains all transactions up to CommitID " + std::to_string(snapshot_commit_id) + "\n");
+  } catch (const std::exception& exception) {
+    out("Error: Exception thrown while writing checkpoint:\n  " + std::string(exception.what()) + "\n");
+    return ReturnCode::Error;
+  }
+
+  return ReturnCode::Ok;
+}
+
+int Console::_load_checkpoint(const std::string& args) {
+  std::vector<std::string> arguments = trim_and_split(args);
+
+  if (arguments.size() != 1) {
+    out("Usage:\n");
+    out("  load_checkpoint DIRECTORY\n");
+    return ReturnCode::Error;
+  }
+
+  out("Loading checkpoint from \"" + arguments[0] + "\" ...\n");
+  try {
+    Hyrise::get().storage_manager.load_checkpoint(arguments[0]);
+  } catch (const std::exception& exception) {
+    out("Error: Exception thrown while loading checkpoint:\n  " + std::string(exception.what()) + "\n");
+    return ReturnCode::Error;
+  }
+
+  return ReturnCode::Ok;
+}
+
 int Console::_print_table(const std::string& args) {
   std::vector<std::string> arguments = trim_and_split(args);
 
@@ -113,6 +113,8 @@ class Console : public Singleton<Console> {
   int _generate_tpcds(const std::string& args);
   int _load_table(const std::string& args);
   int _export_table(const std::string& args);
+  int _write_checkpoint(const std::string& args);
+  int _load_checkpoint(const std::string& args);
   int _exec_script(const std::string& script_file);
   int _print_table(const std::string& args);
   int _visualize(const std::string& input);
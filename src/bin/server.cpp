@@ -3,6 +3,7 @@
 #include "hyrise.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "server/server.hpp"
+#include "sql/sql_pipeline_builder.hpp"
 
 cxxopts::Options get_server_cli_options() {
   cxxopts::Options cli_options("./hyriseServer", "Starts Hyrise server in order to accept network requests.");
@@ -40,6 +41,12 @@ int main(int argc, char* argv[]) {
   // Set scheduler so that the server can execute the tasks on separate threads.
   opossum::Hyrise::get().set_scheduler(std::make_shared<opossum::NodeQueueScheduler>());
 
+  // Clients send many statements that only differ in their literals. Cache their plans across sessions.
+  opossum::SQLPipelineBuilder::default_pqp_cache = std::make_shared<opossum::SQLPhysicalPlanCache>();
+  opossum::SQLPipelineBuilder::default_lqp_cache = std::make_shared<opossum::SQLLogicalPlanCache>();
+  opossum::SQLPipelineBuilder::default_parameterized_plan_cache =
+      std::make_shared<opossum::SQLParameterizedPlanCache>();
+
   auto server = opossum::Server{address, port, static_cast<opossum::SendExecutionInfo>(execution_info)};
   server.run();
 
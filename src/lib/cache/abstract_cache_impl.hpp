@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <utility>
 
 #include <boost/iterator/iterator_facade.hpp>
@@ -49,6 +50,12 @@ class AbstractCacheImpl {
   // Causes undefined behavior if the item is not in the cache.
   virtual Value& get(const Key& key) = 0;
 
+  // Get a copy of the cached value at the given key, or std::nullopt if the item is not in the cache.
+  virtual std::optional<Value> try_get(const Key& key) {
+    if (!has(key)) return std::nullopt;
+    return get(key);
+  }
+
   // Returns true if the cache holds an item at the given key.
   virtual bool has(const Key& key) const = 0;
 
@@ -64,13 +71,13 @@ class AbstractCacheImpl {
   virtual ErasedIterator begin() = 0;
   virtual ErasedIterator end() = 0;
 
+  // Returns true if the implementation synchronizes concurrent accesses itself. Otherwise, the Cache serializes them.
+  virtual bool is_thread_safe() const { return false; }
+
   // Return the capacity of the cache.
   size_t capacity() const { return _capacity; }
 
  protected:
-  // Remove an element from the cache according to the cache algorithm's strategy
-  virtual void _evict() = 0;
-
   size_t _capacity;
 };
 
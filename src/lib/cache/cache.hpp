@@ -15,7 +15,8 @@ namespace opossum {
 
 inline constexpr size_t DefaultCacheCapacity = 1024;
 
-// Per-default, uses the GDFS cache as underlying storage.
+// Per-default, uses the GDFS cache as underlying storage. Accesses to implementations that are not thread-safe
+// are serialized by a single mutex.
 template <typename Value, typename Key = std::string>
 class Cache {
  public:
@@ -30,7 +31,7 @@ class Cache {
   void set(const Key& query, const Value& value) {
     if (_impl->capacity() == 0) return;
 
-    std::lock_guard<std::mutex> lock(_mutex);
+    auto lock = _lock();
     _impl->set(query, value);
   }
 
@@ -39,11 +40,18 @@ class Cache {
   std::optional<Value> try_get(const Key& query) {
     if (_impl->capacity() == 0) return {};
 
-    std::lock_guard<std::mutex> lock(_mutex);
-    if (!_impl->has(query)) {
-      return {};
-    }
-    return _impl->get(query);
+    auto lock = _lock();
+    return _impl->try_get(query);
+  }
+
+  // Like try_get(), but treats the entry as missing if @param is_outdated returns true for its value, e.g., for a plan
+  // that was optimized with statistics that have been rebuilt since. As every lookup checks the value, entries that
+  // were already outdated when they were set() are not returned either. The next set() for the query replaces them.
+  template <typename IsOutdated>
+  std::optional<Value> try_get(const Key& query, const IsOutdated& is_outdated) {
+    auto value = try_get(query);
+    if (value && is_outdated(*value)) return {};
+    return value;
   }
 
   // Checks whether an entry for the query exists.
@@ -52,12 +60,15 @@ class Cache {
   // Returns and refreshes the cache entry for the given query.
   // Causes undefined behavior if the query is not in the cache.
   Value get_entry(const Key& query) {
-    std::lock_guard<std::mutex> lock(_mutex);
-    return _impl->get(query);
+    auto lock = _lock();
+    return *_impl->try_get(query);
   }
 
   // Purges all entries from the cache.
-  void clear() { _impl->clear(); }
+  void clear() {
+    auto lock = _lock();
+    _impl->clear();
+  }
 
   void resize(size_t capacity) { _impl->resize(capacity); }
 
@@ -70,10 +81,10 @@ class Cache {
   const AbstractCacheImpl<Key, Value>& cache() const { return *_impl; }
 
   // Replaces the underlying cache by creating a new object
-  // of the given cache type.
-  template <class cache_t>
-  void replace_cache_impl(size_t capacity) {
-    _impl = std::make_unique<cache_t>(capacity);
+  // of the given cache type. Additional arguments are passed to its constructor.
+  template <class cache_t, typename... Args>
+  void replace_cache_impl(size_t capacity, Args&&... args) {
+    _impl = std::make_unique<cache_t>(capacity, std::forward<Args>(args)...);
   }
 
   Iterator begin() { return _impl->begin(); }
@@ -87,6 +98,12 @@ class Cache {
   std::unique_ptr<AbstractCacheImpl<Key, Value>> _impl;
 
   std::mutex _mutex;
+
+  // Locks _mutex unless the underlying cache is thread-safe.
+  std::unique_lock<std::mutex> _lock() {
+    if (_impl->is_thread_safe()) return std::unique_lock<std::mutex>{};
+    return std::unique_lock<std::mutex>{_mutex};
+  }
 };
 
 }  // namespace opossum
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "abstract_cache_impl.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// Generic, thread-safe cache implementation using an approximation of the GDFS policy.
+//
+// The keys are distributed over shards by their hash, each with its own lock and its own capacity. Other than
+// GDFSCache, a hit does not maintain a heap: Frequency and priority of an entry are atomics, so lookups only need a
+// shared lock on their shard and do not block each other. Instead of popping the top of a heap, an eviction samples
+// about EVICTION_SAMPLE_SIZE entries of the shard and evicts the one with the lowest priority. For shards that hold
+// no more than EVICTION_SAMPLE_SIZE entries, this is exactly GDFS.
+//
+// The capacity is split evenly between the shards, so a shard might evict entries while others still have space. If
+// the capacity is smaller than the number of shards, only as many shards as the capacity are used. When the cache is
+// shrunk below its number of shards, keys in shards without capacity are no longer cached.
+template <typename Key, typename Value>
+class ShardedGDFSCache : public AbstractCacheImpl<Key, Value> {
+ public:
+  static constexpr size_t DEFAULT_SHARD_COUNT = 16;
+  static constexpr size_t EVICTION_SAMPLE_SIZE = 8;
+
+  struct ShardedGDFSCacheEntry {
+    ShardedGDFSCacheEntry(const Value& init_value, const double init_size, const double init_priority)
+        : value(init_value), size(init_size), frequency(1), priority(init_priority) {}
+
+    Value value;
+    double size;
+
+    // Updated on hits, which only hold a shared lock
+    std::atomic<size_t> frequency;
+    std::atomic<double> priority;
+  };
+
+  using typename AbstractCacheImpl<Key, Value>::KeyValuePair;
+  using typename AbstractCacheImpl<Key, Value>::AbstractIterator;
+  using typename AbstractCacheImpl<Key, Value>::ErasedIterator;
+
+  // Iterates over a copy of the entries taken by begin(), so that the shards do not need to stay locked.
+  class Iterator : public AbstractIterator {
+   public:
+    using Snapshot = std::vector<KeyValuePair>;
+
+    Iterator(const std::shared_ptr<const Snapshot>& snapshot, const size_t index)
+        : _snapshot(snapshot), _index(index) {}
+
+   private:
+    friend class boost::iterator_core_access;
+    friend class AbstractCacheImpl<Key, Value>::ErasedIterator;
+
+    std::shared_ptr<const Snapshot> _snapshot;
+    size_t _index;
+
+    bool _is_end() const { return !_snapshot || _index >= _snapshot->size(); }
+
+    void increment() { ++_index; }
+
+    bool equal(const AbstractIterator& other) const {
+      const auto& other_iterator = static_cast<const Iterator&>(other);
+      if (_is_end() || other_iterator._is_end()) return _is_end() && other_iterator._is_end();
+      return _snapshot == other_iterator._snapshot && _index == other_iterator._index;
+    }
+
+    const KeyValuePair& dereference() const { return (*_snapshot)[_index]; }
+  };
+
+  explicit ShardedGDFSCache(size_t capacity, size_t shard_count = DEFAULT_SHARD_COUNT)
+      : AbstractCacheImpl<Key, Value>(capacity), _shards(std::max(size_t{1}, std::min(shard_count, capacity))) {
+    Assert(shard_count > 0, "ShardedGDFSCache needs at least one shard");
+
+    for (auto shard_id = size_t{0}; shard_id < _shards.size(); ++shard_id) {
+      _shards[shard_id].capacity = _shard_capacity(shard_id);
+      _shards[shard_id].random_engine.seed(static_cast<std::minstd_rand::result_type>(shard_id + 1));
+    }
+  }
+
+  void set(const Key& key, const Value& value, double cost = 1.0, double size = 1.0) {
+    auto& shard = _shard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto it = shard.map.find(key);
+    if (it != shard.map.end()) {
+      auto& entry = it->second;
+      entry.value = value;
+      entry.size = size;
+      _refresh(shard, entry);
+      return;
+    }
+
+    if (shard.capacity == 0) return;
+
+    if (shard.map.size() >= shard.capacity) {
+      _evict(shard);
+    }
+
+    const auto inflation = shard.inflation.load(std::memory_order_relaxed);
+    shard.map.try_emplace(key, value, size, inflation + 1.0 / size);
+  }
+
+  // Refreshes the entry and returns a reference to its value. As the entry might be evicted concurrently once the
+  // shard is unlocked, concurrent users should call try_get() instead.
+  Value& get(const Key& key) {
+    auto& shard = _shard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto& entry = shard.map.find(key)->second;
+    _refresh(shard, entry);
+    return entry.value;
+  }
+
+  std::optional<Value> try_get(const Key& key) {
+    auto& shard = _shard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    const auto it = shard.map.find(key);
+    if (it == shard.map.end()) return std::nullopt;
+
+    auto& entry = it->second;
+    _refresh(shard, entry);
+    return entry.value;
+  }
+
+  bool has(const Key& key) const {
+    const auto& shard = _shard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.find(key) != shard.map.end();
+  }
+
+  size_t size() const {
+    auto size = size_t{0};
+    for (const auto& shard : _shards) {
+      std::shared_lock<std::shared_mutex> lock(shard.mutex);
+      size += shard.map.size();
+    }
+    return size;
+  }
+
+  void clear() {
+    for (auto& shard : _shards) {
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      shard.map.clear();
+    }
+  }
+
+  void resize(size_t capacity) {
+    this->_capacity = capacity;
+
+    for (auto shard_id = size_t{0}; shard_id < _shards.size(); ++shard_id) {
+      auto& shard = _shards[shard_id];
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+      shard.capacity = _shard_capacity(shard_id);
+      while (shard.map.size() > shard.capacity) {
+        _evict(shard);
+      }
+    }
+  }
+
+  bool is_thread_safe() const { return true; }
+
+  size_t shard_count() const { return _shards.size(); }
+
+  double priority(const Key& key) const {
+    const auto& shard = _shard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.find(key)->second.priority.load(std::memory_order_relaxed);
+  }
+
+  // The inflation of the shard that holds the given key
+  double inflation(const Key& key) const { return _shard(key).inflation.load(std::memory_order_relaxed); }
+
+  size_t frequency(const Key& key) const {
+    const auto& shard = _shard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    const auto it = shard.map.find(key);
+    if (it == shard.map.end()) return size_t{0};
+    return it->second.frequency.load(std::memory_order_relaxed);
+  }
+
+  ErasedIterator begin() {
+    auto snapshot = std::make_shared<typename Iterator::Snapshot>();
+    for (const auto& shard : _shards) {
+      std::shared_lock<std::shared_mutex> lock(shard.mutex);
+      for (const auto& [key, entry] : shard.map) {
+        snapshot->emplace_back(key, entry.value);
+      }
+    }
+    return ErasedIterator{std::make_unique<Iterator>(std::move(snapshot), size_t{0})};
+  }
+
+  ErasedIterator end() { return ErasedIterator{std::make_unique<Iterator>(nullptr, size_t{0})}; }
+
+ protected:
+  // Aligned to cache lines, so that locking one shard does not invalidate the mutex of its neighbor.
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<Key, ShardedGDFSCacheEntry> map;
+    size_t capacity{0};
+
+    // Written while holding the unique lock, read by hits that hold the shared lock
+    std::atomic<double> inflation{0.0};
+
+    // Only used for evictions, which hold the unique lock
+    std::minstd_rand random_engine;
+  };
+
+  std::vector<Shard> _shards;
+
+  Shard& _shard(const Key& key) { return _shards[std::hash<Key>{}(key) % _shards.size()]; }
+  const Shard& _shard(const Key& key) const { return _shards[std::hash<Key>{}(key) % _shards.size()]; }
+
+  size_t _shard_capacity(const size_t shard_id) const {
+    const auto shard_count = _shards.size();
+    return this->_capacity / shard_count + (shard_id < this->_capacity % shard_count ? 1 : 0);
+  }
+
+  // Counts an access to the entry. Safe to call concurrently while holding the shared lock of the shard: Concurrent
+  // hits might store their priorities in a different order than they incremented the frequency, which only makes the
+  // priority lag behind by a few accesses.
+  static void _refresh(Shard& shard, ShardedGDFSCacheEntry& entry) {
+    const auto frequency = entry.frequency.fetch_add(1, std::memory_order_relaxed) + 1;
+    const auto priority =
+        shard.inflation.load(std::memory_order_relaxed) + static_cast<double>(frequency) / entry.size;
+    entry.priority.store(priority, std::memory_order_relaxed);
+  }
+
+  // Evicts the entry with the lowest priority among EVICTION_SAMPLE_SIZE or more entries from random hash buckets.
+  // Expects the unique lock of the shard to be held.
+  void _evict(Shard& shard) {
+    auto& map = shard.map;
+    if (map.empty()) return;
+
+    const Key* victim_key = nullptr;
+    auto victim_priority = 0.0;
+    const auto sample = [&](const auto& key_and_entry) {
+      const auto priority = key_and_entry.second.priority.load(std::memory_order_relaxed);
+      if (!victim_key || priority < victim_priority) {
+        victim_key = &key_and_entry.first;
+        victim_priority = priority;
+      }
+    };
+
+    if (map.size() <= EVICTION_SAMPLE_SIZE) {
+      for (const auto& key_and_entry : map) {
+        sample(key_and_entry);
+      }
+    } else {
+      // Random rather than consecutive buckets, so that keys with similar hashes are not sampled together
+      constexpr auto MAX_SAMPLED_BUCKET_COUNT = EVICTION_SAMPLE_SIZE * 4;
+      auto bucket_distribution = std::uniform_int_distribution<size_t>{0, map.bucket_count() - 1};
+      auto sample_size = size_t{0};
+      for (auto sampled_bucket_count = size_t{0};
+           sampled_bucket_count < MAX_SAMPLED_BUCKET_COUNT && sample_size < EVICTION_SAMPLE_SIZE;
+           ++sampled_bucket_count) {
+        const auto bucket = bucket_distribution(shard.random_engine);
+        for (auto it = map.cbegin(bucket); it != map.cend(bucket); ++it) {
+          sample(*it);
+          ++sample_size;
+        }
+      }
+
+      // After shrinking, most buckets might be empty
+      if (!victim_key) sample(*map.cbegin());
+    }
+
+    shard.inflation.store(victim_priority, std::memory_order_relaxed);
+    map.erase(map.find(*victim_key));
+  }
+};
+
+}  // namespace opossum
@@ -0,0 +1,574 @@
+#include "redo_log.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <boost/crc.hpp>
+
+#include "hyrise.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+enum class FrameType : uint8_t { AddTable, DropTable, Commit };
+enum class EntryType : uint8_t { Insert, Delete };
+
+// Each frame starts with the size of its payload and the CRC32 checksum of the payload
+constexpr auto FRAME_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+template <typename T>
+void write_value(std::vector<char>& buffer, const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written as raw bytes");
+  const auto* const bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename String>
+void write_string(std::vector<char>& buffer, const String& value) {
+  write_value(buffer, static_cast<uint32_t>(value.size()));
+  buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+// Overwrites a value that has been written as a placeholder before
+template <typename T>
+void patch_value(std::vector<char>& buffer, const size_t position, const T& value) {
+  std::memcpy(buffer.data() + position, &value, sizeof(T));
+}
+
+uint32_t checksum(const char* data, const size_t size) {
+  auto crc = boost::crc_32_type{};
+  crc.process_bytes(data, size);
+  return crc.checksum();
+}
+
+// Reads the values written by the functions above. Reading beyond the end of the buffer fails.
+class LogReader {
+ public:
+  LogReader(const char* data, const size_t size) : _data(data), _size(size) {}
+
+  template <typename T>
+  T read() {
+    if constexpr (std::is_same_v<T, pmr_string> || std::is_same_v<T, std::string>) {
+      const auto length = read<uint32_t>();
+      Assert(_offset + length <= _size, "Redo log entry is truncated");
+      auto value = T(_data + _offset, length);
+      _offset += length;
+      return value;
+    } else {
+      Assert(_offset + sizeof(T) <= _size, "Redo log entry is truncated");
+      auto value = T{};
+      std::memcpy(&value, _data + _offset, sizeof(T));
+      _offset += sizeof(T);
+      return value;
+    }
+  }
+
+  // Returns a reader for the next @param size bytes and skips them
+  LogReader sub_reader(const size_t size) {
+    Assert(_offset + size <= _size, "Redo log entry is truncated");
+    auto reader = LogReader{_data + _offset, size};
+    _offset += size;
+    return reader;
+  }
+
+  bool at_end() const { return _offset == _size; }
+
+ private:
+  const char* _data;
+  size_t _size;
+  size_t _offset{0};
+};
+
+// The entries of a table that is to be recovered. Only the table name is read while scanning the log, the (more
+// expensive) decoding of the values happens in parallel for all tables.
+struct RecoveredTable {
+  TableColumnDefinitions column_definitions;
+  ChunkOffset max_chunk_size{};
+  std::vector<LogReader> inserts;
+  std::vector<LogReader> deletes;
+};
+
+void read_entries(LogReader& reader, std::map<std::string, RecoveredTable>& tables) {
+  const auto entry_count = reader.read<uint32_t>();
+  for (auto entry_index = uint32_t{0}; entry_index < entry_count; ++entry_index) {
+    const auto entry_type = reader.read<EntryType>();
+    const auto table_name = reader.read<std::string>();
+    const auto entry_size = reader.read<uint32_t>();
+
+    auto entry_reader = reader.sub_reader(entry_size);
+
+    // A transaction might commit after a table it modified was dropped. Its entries for that table are obsolete.
+    const auto table_iter = tables.find(table_name);
+    if (table_iter == tables.end()) continue;
+
+    auto& entries = entry_type == EntryType::Insert ? table_iter->second.inserts : table_iter->second.deletes;
+    entries.emplace_back(entry_reader);
+  }
+}
+
+std::shared_ptr<Table> rebuild_table(RecoveredTable& recovered_table) {
+  const auto& column_definitions = recovered_table.column_definitions;
+  const auto column_count = static_cast<ColumnID::base_type>(column_definitions.size());
+
+  // Determine the size of each chunk. Positions that are not covered by any insert belong to transactions that were
+  // rolled back (or never committed). They are recreated as invisible rows so that all RowIDs remain the same.
+  auto chunk_sizes = std::vector<ChunkOffset>{};
+  for (auto insert : recovered_table.inserts) {
+    const auto chunk_id = insert.read<ChunkID>();
+    insert.read<ChunkOffset>();
+    const auto end_chunk_offset = insert.read<ChunkOffset>();
+
+    if (static_cast<size_t>(chunk_id) >= chunk_sizes.size()) chunk_sizes.resize(chunk_id + 1, ChunkOffset{0});
+    chunk_sizes[chunk_id] = std::max(chunk_sizes[chunk_id], end_chunk_offset);
+  }
+
+  const auto chunk_count = static_cast<ChunkID::base_type>(chunk_sizes.size());
+  auto segments_by_chunk = std::vector<Segments>(chunk_count);
+  auto mvcc_data_by_chunk = std::vector<std::shared_ptr<MvccData>>(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk_size = chunk_sizes[chunk_id];
+    for (const auto& column_definition : column_definitions) {
+      resolve_data_type(column_definition.data_type, [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        auto values = pmr_concurrent_vector<ColumnDataType>(chunk_size);
+        if (column_definition.nullable) {
+          segments_by_chunk[chunk_id].emplace_back(std::make_shared<ValueSegment<ColumnDataType>>(
+              std::move(values), pmr_concurrent_vector<bool>(chunk_size, true)));
+        } else {
+          segments_by_chunk[chunk_id].emplace_back(std::make_shared<ValueSegment<ColumnDataType>>(std::move(values)));
+        }
+      });
+    }
+
+    mvcc_data_by_chunk[chunk_id] = std::make_shared<MvccData>(chunk_size, CommitID{0});
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      mvcc_data_by_chunk[chunk_id]->set_end_cid(chunk_offset, CommitID{0});
+    }
+  }
+
+  for (auto& insert : recovered_table.inserts) {
+    const auto chunk_id = insert.read<ChunkID>();
+    const auto begin_chunk_offset = insert.read<ChunkOffset>();
+    const auto end_chunk_offset = insert.read<ChunkOffset>();
+
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      const auto nullable = column_definitions[column_id].nullable;
+      resolve_data_type(column_definitions[column_id].data_type, [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        auto& value_segment = static_cast<ValueSegment<ColumnDataType>&>(*segments_by_chunk[chunk_id][column_id]);
+        auto& values = value_segment.values();
+
+        for (auto chunk_offset = begin_chunk_offset; chunk_offset < end_chunk_offset; ++chunk_offset) {
+          if (nullable) {
+            const auto is_null = insert.read<bool>();
+            value_segment.null_values()[chunk_offset] = is_null;
+            if (is_null) continue;
+          }
+          values[chunk_offset] = insert.read<ColumnDataType>();
+        }
+      });
+    }
+    Assert(insert.at_end(), "Redo log insert entry has unexpected size");
+
+    for (auto chunk_offset = begin_chunk_offset; chunk_offset < end_chunk_offset; ++chunk_offset) {
+      mvcc_data_by_chunk[chunk_id]->set_end_cid(chunk_offset, MvccData::MAX_COMMIT_ID);
+    }
+  }
+
+  for (auto& deletion : recovered_table.deletes) {
+    const auto row_count = deletion.read<uint32_t>();
+    for (auto row_index = uint32_t{0}; row_index < row_count; ++row_index) {
+      const auto row_id = deletion.read<RowID>();
+      mvcc_data_by_chunk[row_id.chunk_id]->set_end_cid(row_id.chunk_offset, CommitID{0});
+    }
+  }
+
+  const auto table = std::make_shared<Table>(column_definitions, TableType::Data, recovered_table.max_chunk_size,
+                                             UseMvcc::Yes);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    table->append_chunk(segments_by_chunk[chunk_id], mvcc_data_by_chunk[chunk_id]);
+
+    const auto& chunk = table->get_chunk(chunk_id);
+    auto invalid_row_count = ChunkOffset{0};
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_sizes[chunk_id]; ++chunk_offset) {
+      if (mvcc_data_by_chunk[chunk_id]->get_end_cid(chunk_offset) == CommitID{0}) ++invalid_row_count;
+    }
+    chunk->increase_invalid_row_count(invalid_row_count);
+
+    // Only the last chunk may receive new rows, see Insert
+    const auto is_last_chunk = chunk_id + 1u == chunk_count;
+    if (chunk->size() > 0 && (!is_last_chunk || chunk->size() == recovered_table.max_chunk_size)) {
+      chunk->finalize();
+    }
+  }
+
+  return table;
+}
+
+}  // namespace
+
+namespace opossum {
+
+void RedoLogRecord::add_insert(const std::string& table_name, const Table& table, const ChunkID chunk_id,
+                               const ChunkOffset begin_chunk_offset, const ChunkOffset end_chunk_offset) {
+  write_value(_buffer, EntryType::Insert);
+  write_string(_buffer, table_name);
+  const auto size_position = _buffer.size();
+  write_value(_buffer, uint32_t{0});
+  const auto entry_begin = _buffer.size();
+
+  write_value(_buffer, chunk_id);
+  write_value(_buffer, begin_chunk_offset);
+  write_value(_buffer, end_chunk_offset);
+
+  const auto chunk = table.get_chunk(chunk_id);
+
+  // Newly inserted rows are usually only a small part of a chunk, so we only iterate over them
+  auto position_filter = std::shared_ptr<PosList>{};
+  if (begin_chunk_offset != 0 || end_chunk_offset != chunk->size()) {
+    position_filter = std::make_shared<PosList>();
+    position_filter->guarantee_single_chunk();
+    position_filter->reserve(end_chunk_offset - begin_chunk_offset);
+    for (auto chunk_offset = begin_chunk_offset; chunk_offset < end_chunk_offset; ++chunk_offset) {
+      position_filter->emplace_back(RowID{chunk_id, chunk_offset});
+    }
+  }
+
+  const auto& column_definitions = table.column_definitions();
+  const auto column_count = table.column_count();
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    const auto nullable = column_definitions[column_id].nullable;
+    resolve_data_type(column_definitions[column_id].data_type, [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      segment_iterate_filtered<ColumnDataType>(*chunk->get_segment(column_id), position_filter, [&](const auto& position) {
+        if (nullable) {
+          write_value(_buffer, position.is_null());
+          if (position.is_null()) return;
+        }
+
+        if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+          write_string(_buffer, position.value());
+        } else {
+          write_value(_buffer, position.value());
+        }
+      });
+    });
+  }
+
+  patch_value(_buffer, size_position, static_cast<uint32_t>(_buffer.size() - entry_begin));
+  ++_entry_count;
+}
+
+void RedoLogRecord::add_delete(const std::string& table_name, const std::vector<RowID>& row_ids) {
+  write_value(_buffer, EntryType::Delete);
+  write_string(_buffer, table_name);
+  write_value(_buffer, static_cast<uint32_t>(sizeof(uint32_t) + row_ids.size() * sizeof(RowID)));
+
+  write_value(_buffer, static_cast<uint32_t>(row_ids.size()));
+  for (const auto& row_id : row_ids) {
+    write_value(_buffer, row_id);
+  }
+  ++_entry_count;
+}
+
+bool RedoLogRecord::empty() const { return _entry_count == 0; }
+
+struct RedoLog::Writer {
+  explicit Writer(const std::string& path) {
+    const auto is_new_file = !std::filesystem::exists(path);
+    file_descriptor = open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    Assert(file_descriptor != -1, "Could not open redo log " + path + ": " + std::strerror(errno));
+
+    // Syncing the log file does not persist its directory entry. Without it, a new log could vanish after a crash
+    // together with all transactions that were acknowledged as durable.
+    if (is_new_file) {
+      const auto directory = std::filesystem::absolute(path).parent_path().string();
+      const auto directory_descriptor = open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+      Assert(directory_descriptor != -1, "Could not open directory " + directory + ": " + std::strerror(errno));
+      const auto sync_result = fsync(directory_descriptor);
+      Assert(sync_result == 0, "Could not sync directory " + directory + ": " + std::strerror(errno));
+      close(directory_descriptor);
+    }
+
+    flush_thread = std::thread{[&]() { flush_loop(); }};
+  }
+
+  ~Writer() {
+    {
+      auto lock = std::lock_guard<std::mutex>{mutex};
+      shutdown = true;
+    }
+    condition_variable.notify_one();
+    flush_thread.join();
+
+    close(file_descriptor);
+  }
+
+  void append(const std::vector<char>& payload, std::function<void()>&& on_durable) {
+    auto frame = std::vector<char>{};
+    frame.reserve(FRAME_HEADER_SIZE + payload.size());
+    write_value(frame, static_cast<uint32_t>(payload.size()));
+    write_value(frame, checksum(payload.data(), payload.size()));
+    frame.insert(frame.end(), payload.begin(), payload.end());
+
+    {
+      auto lock = std::lock_guard<std::mutex>{mutex};
+      queued_frames.emplace_back(std::move(frame), std::move(on_durable));
+    }
+    condition_variable.notify_one();
+  }
+
+  // Used for records that are not part of a transaction (e.g., adding a table)
+  void append_and_wait(const std::vector<char>& payload) {
+    auto durable = std::promise<void>{};
+    const auto durable_future = durable.get_future();
+    append(payload, [&durable]() { durable.set_value(); });
+    durable_future.wait();
+  }
+
+  void flush_loop() {
+    auto batch = std::vector<std::pair<std::vector<char>, std::function<void()>>>{};
+    auto batch_buffer = std::vector<char>{};
+
+    while (true) {
+      {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+        condition_variable.wait(lock, [&]() { return !queued_frames.empty() || shutdown; });
+        if (queued_frames.empty()) return;
+        std::swap(batch, queued_frames);
+      }
+
+      // All frames that were queued during the previous flush are written at once
+      batch_buffer.clear();
+      for (const auto& [frame, on_durable] : batch) {
+        batch_buffer.insert(batch_buffer.end(), frame.begin(), frame.end());
+      }
+
+      auto bytes_written = size_t{0};
+      while (bytes_written < batch_buffer.size()) {
+        const auto result = write(file_descriptor, batch_buffer.data() + bytes_written,
+                                  batch_buffer.size() - bytes_written);
+        if (result == -1 && errno == EINTR) continue;
+        Assert(result != -1, std::string{"Could not write redo log: "} + std::strerror(errno));
+        bytes_written += static_cast<size_t>(result);
+      }
+
+#ifdef __APPLE__
+      const auto sync_result = fsync(file_descriptor);
+#else
+      const auto sync_result = fdatasync(file_descriptor);
+#endif
+      Assert(sync_result == 0, std::string{"Could not sync redo log: "} + std::strerror(errno));
+
+      ++flush_count;
+      flushed_record_count += batch.size();
+
+      for (const auto& [frame, on_durable] : batch) {
+        on_durable();
+      }
+      batch.clear();
+    }
+  }
+
+  int file_descriptor;
+
+  std::mutex mutex;
+  std::condition_variable condition_variable;
+  std::vector<std::pair<std::vector<char>, std::function<void()>>> queued_frames;
+  bool shutdown{false};
+
+  std::atomic<size_t> flush_count{0};
+  std::atomic<size_t> flushed_record_count{0};
+
+  std::thread flush_thread;
+};
+
+RedoLog::RedoLog() = default;
+
+RedoLog::~RedoLog() { disable(); }
+
+RedoLog& RedoLog::operator=(RedoLog&& redo_log) noexcept {
+  disable();
+  _writer = std::move(redo_log._writer);
+  return *this;
+}
+
+void RedoLog::enable(const std::string& path) {
+  Assert(!_writer, "Redo log is already enabled");
+  _writer = std::make_unique<Writer>(path);
+}
+
+void RedoLog::disable() {
+  // The Writer's destructor flushes the remaining frames
+  _writer.reset();
+}
+
+bool RedoLog::is_enabled() const { return _writer != nullptr; }
+
+void RedoLog::recover(const std::string& path) const {
+  Assert(!is_enabled(), "Cannot recover while the redo log is enabled");
+
+  if (!std::filesystem::exists(path)) return;
+
+  auto file = std::ifstream{path, std::ios::binary};
+  Assert(file.is_open(), "Could not open redo log " + path);
+  const auto data = std::vector<char>{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  file.close();
+
+  auto tables = std::map<std::string, RecoveredTable>{};
+
+  auto offset = size_t{0};
+  while (offset + FRAME_HEADER_SIZE <= data.size()) {
+    auto header_reader = LogReader{data.data() + offset, FRAME_HEADER_SIZE};
+    const auto payload_size = header_reader.read<uint32_t>();
+    const auto payload_checksum = header_reader.read<uint32_t>();
+
+    // A frame that was not completely written before a crash belongs to a transaction that was never acknowledged
+    const auto* const payload = data.data() + offset + FRAME_HEADER_SIZE;
+    if (offset + FRAME_HEADER_SIZE + payload_size > data.size() ||
+        checksum(payload, payload_size) != payload_checksum) {
+      break;
+    }
+
+    auto reader = LogReader{payload, payload_size};
+    switch (reader.read<FrameType>()) {
+      case FrameType::AddTable: {
+        const auto table_name = reader.read<std::string>();
+        auto recovered_table = RecoveredTable{};
+        recovered_table.max_chunk_size = reader.read<ChunkOffset>();
+        const auto column_count = reader.read<uint16_t>();
+        for (auto column_id = uint16_t{0}; column_id < column_count; ++column_id) {
+          auto column_name = reader.read<std::string>();
+          const auto data_type = reader.read<DataType>();
+          const auto nullable = reader.read<bool>();
+          recovered_table.column_definitions.emplace_back(column_name, data_type, nullable);
+        }
+        tables[table_name] = std::move(recovered_table);
+        read_entries(reader, tables);
+      } break;
+
+      case FrameType::DropTable:
+        tables.erase(reader.read<std::string>());
+        break;
+
+      case FrameType::Commit:
+        reader.read<CommitID>();
+        read_entries(reader, tables);
+        break;
+    }
+    Assert(reader.at_end(), "Redo log frame has unexpected size");
+
+    offset += FRAME_HEADER_SIZE + payload_size;
+  }
+
+  // Discard the incomplete frame at the end of the log, so that new frames are not appended after it
+  if (offset < data.size()) std::filesystem::resize_file(path, offset);
+
+  // Tables are independent of each other and can be rebuilt in parallel
+  auto recovered_tables = std::vector<std::pair<std::string, std::shared_ptr<Table>>>{};
+  recovered_tables.reserve(tables.size());
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto& [table_name, recovered_table] : tables) {
+    auto& table = recovered_tables.emplace_back(table_name, nullptr).second;
+    jobs.emplace_back(std::make_shared<JobTask>([&]() { table = rebuild_table(recovered_table); }));
+    jobs.back()->schedule();
+  }
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+
+  for (auto& [table_name, table] : recovered_tables) {
+    Hyrise::get().storage_manager.add_table(table_name, table);
+  }
+}
+
+void RedoLog::log_add_table(const std::string& table_name, const Table& table) {
+  Assert(_writer, "Redo log is not enabled");
+
+  auto payload = std::vector<char>{};
+  write_value(payload, FrameType::AddTable);
+  write_string(payload, table_name);
+  write_value(payload, table.max_chunk_size());
+
+  const auto& column_definitions = table.column_definitions();
+  write_value(payload, static_cast<uint16_t>(column_definitions.size()));
+  for (const auto& column_definition : column_definitions) {
+    write_string(payload, column_definition.name);
+    write_value(payload, column_definition.data_type);
+    write_value(payload, column_definition.nullable);
+  }
+
+  // The existing rows are logged as if they had been inserted by a transaction. Rows that are not visible are logged
+  // as deleted.
+  auto record = RedoLogRecord{};
+  const auto chunk_count = table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    if (!chunk) continue;
+    const auto chunk_size = chunk->size();
+    if (chunk_size == 0) continue;
+
+    record.add_insert(table_name, table, chunk_id, ChunkOffset{0}, chunk_size);
+
+    auto invisible_row_ids = std::vector<RowID>{};
+    const auto mvcc_data = chunk->get_scoped_mvcc_data_lock();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      if (mvcc_data->get_begin_cid(chunk_offset) == MvccData::MAX_COMMIT_ID ||
+          mvcc_data->get_end_cid(chunk_offset) != MvccData::MAX_COMMIT_ID) {
+        invisible_row_ids.emplace_back(RowID{chunk_id, chunk_offset});
+      }
+    }
+    if (!invisible_row_ids.empty()) record.add_delete(table_name, invisible_row_ids);
+  }
+
+  write_value(payload, record._entry_count);
+  payload.insert(payload.end(), record._buffer.begin(), record._buffer.end());
+
+  _writer->append_and_wait(payload);
+}
+
+void RedoLog::log_drop_table(const std::string& table_name) {
+  Assert(_writer, "Redo log is not enabled");
+
+  auto payload = std::vector<char>{};
+  write_value(payload, FrameType::DropTable);
+  write_string(payload, table_name);
+
+  _writer->append_and_wait(payload);
+}
+
+void RedoLog::log_commit(const CommitID commit_id, RedoLogRecord&& record, std::function<void()>&& on_durable) {
+  Assert(_writer, "Redo log is not enabled");
+
+  auto payload = std::vector<char>{};
+  payload.reserve(sizeof(FrameType) + sizeof(CommitID) + sizeof(uint32_t) + record._buffer.size());
+  write_value(payload, FrameType::Commit);
+  write_value(payload, commit_id);
+  write_value(payload, record._entry_count);
+  payload.insert(payload.end(), record._buffer.begin(), record._buffer.end());
+
+  _writer->append(payload, std::move(on_durable));
+}
+
+size_t RedoLog::flush_count() const { return _writer ? _writer->flush_count.load() : 0; }
+
+size_t RedoLog::flushed_record_count() const { return _writer ? _writer->flushed_record_count.load() : 0; }
+
+}  // namespace opossum
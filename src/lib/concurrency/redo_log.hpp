@@ -0,0 +1,92 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+/**
+ * The effects of a single transaction as they are written to the RedoLog. Read/write operators add their effects when
+ * the transaction commits (see AbstractReadWriteOperator::log_records).
+ *
+ * Rows are identified by their RowID. As tables are append-only and chunks are never reordered, a RowID identifies the
+ * same row for the lifetime of the table. Replaying the log recreates the rows at the same positions, so that later
+ * records (e.g., a delete of a previously inserted row) can refer to them.
+ */
+class RedoLogRecord {
+ public:
+  // Logs the values of the rows [begin_chunk_offset, end_chunk_offset) of the given chunk
+  void add_insert(const std::string& table_name, const Table& table, const ChunkID chunk_id,
+                  const ChunkOffset begin_chunk_offset, const ChunkOffset end_chunk_offset);
+
+  void add_delete(const std::string& table_name, const std::vector<RowID>& row_ids);
+
+  bool empty() const;
+
+ private:
+  friend class RedoLog;
+
+  std::vector<char> _buffer;
+  uint32_t _entry_count{0};
+};
+
+/**
+ * Append-only redo log that makes committed transactions durable. It is disabled by default. Once enabled, it records
+ * which tables are added to and dropped from the StorageManager and what committed transactions inserted and deleted.
+ * Data that is not logged cannot be recovered, so the log should be enabled before any tables are added.
+ *
+ * Commits are group-committed: A dedicated thread writes all records that have been queued since its last flush with
+ * a single write and fdatasync call. Only then are the transactions marked as pending in their CommitContext. Since a
+ * transaction becomes visible only once all transactions with lower commit ids are pending, the CommitContext chain
+ * never publishes a commit that is not durable, and concurrent commits share the cost of the flush.
+ *
+ * The file consists of frames (size, checksum, payload). A frame that was only partially written when the process
+ * crashed is detected by recover() and cut off.
+ */
+class RedoLog : public Noncopyable {
+ public:
+  RedoLog();
+  ~RedoLog();
+
+  RedoLog& operator=(RedoLog&& redo_log) noexcept;
+
+  // Appends all future log records to the file at @param path, which is created if it does not exist
+  void enable(const std::string& path);
+
+  // Flushes all queued records and closes the log file
+  void disable();
+
+  bool is_enabled() const;
+
+  /**
+   * Rebuilds the tables described by the log at @param path and adds them to the StorageManager. Tables are rebuilt
+   * in parallel. All recovered rows are visible to every transaction. A partially written frame at the end of the file
+   * is removed so that the log can be appended to afterwards. Must be called while the log is disabled.
+   */
+  void recover(const std::string& path) const;
+
+  void log_add_table(const std::string& table_name, const Table& table);
+  void log_drop_table(const std::string& table_name);
+
+  // Queues the record of a committing transaction. @param on_durable is called by the flushing thread once the record
+  // has been written to disk.
+  void log_commit(const CommitID commit_id, RedoLogRecord&& record, std::function<void()>&& on_durable);
+
+  // Number of flushes (i.e., fdatasync calls) and of records written so far, used to report the batching in the
+  // benchmarks
+  size_t flush_count() const;
+  size_t flushed_record_count() const;
+
+ private:
+  struct Writer;
+
+  std::unique_ptr<Writer> _writer;
+};
+
+}  // namespace opossum
@@ -2,9 +2,11 @@
 
 #include <future>
 #include <memory>
+#include <utility>
 
 #include "commit_context.hpp"
 #include "hyrise.hpp"
+#include "redo_log.hpp"
 #include "operators/abstract_read_write_operator.hpp"
 #include "utils/assert.hpp"
 
@@ -80,11 +82,28 @@ void TransactionContext::rollback() {
 void TransactionContext::commit_async(const std::function<void(TransactionID)>& callback) {
   _prepare_commit();
 
+  auto& redo_log = Hyrise::get().redo_log;
+  auto redo_log_record = RedoLogRecord{};
+  if (redo_log.is_enabled()) {
+    for (const auto& op : _read_write_operators) {
+      op->log_records(redo_log_record);
+    }
+  }
+
   for (const auto& op : _read_write_operators) {
     op->commit_records(commit_id());
   }
 
-  _mark_as_pending_and_try_commit(callback);
+  if (redo_log_record.empty()) {
+    _mark_as_pending_and_try_commit(callback);
+    return;
+  }
+
+  // The transaction may only become visible once its record is durable. The RedoLog calls the continuation after
+  // flushing, which is usually after commit_async returned - hence, the continuation holds on to the context.
+  redo_log.log_commit(commit_id(), std::move(redo_log_record), [context = shared_from_this(), callback]() {
+    context->_mark_as_pending_and_try_commit(callback);
+  });
 }
 
 void TransactionContext::commit() {
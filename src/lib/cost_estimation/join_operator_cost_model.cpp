@@ -0,0 +1,68 @@
+#include "join_operator_cost_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "utils/assert.hpp"
+
+namespace {
+
+// Materializing and radix-partitioning a value and inserting it into a hash table is more expensive than
+// materializing, partitioning, and looking up a value.
+constexpr auto HASH_BUILD_COST_PER_ROW = 3.0f;
+constexpr auto HASH_PROBE_COST_PER_ROW = 2.0f;
+
+// Materializing a value and merging it with the other side. Sorting is added on top of that for unsorted inputs.
+constexpr auto SORT_MERGE_COST_PER_ROW = 2.0f;
+
+float log2_or_one(const float value) { return std::log2(std::max(value, 2.0f)); }
+
+}  // namespace
+
+namespace opossum {
+
+Cost estimate_join_hash_cost(const JoinMode join_mode, const JoinInputProperties& left_input,
+                             const JoinInputProperties& right_input, const Cardinality output_row_count) {
+  // Mirrors the choice of the build side in JoinHash::_on_execute()
+  const auto build_left = join_mode == JoinMode::Right ||
+                          (join_mode == JoinMode::Inner && left_input.row_count <= right_input.row_count);
+  const auto& build_input = build_left ? left_input : right_input;
+  const auto& probe_input = build_left ? right_input : left_input;
+
+  return build_input.row_count * HASH_BUILD_COST_PER_ROW + probe_input.row_count * HASH_PROBE_COST_PER_ROW +
+         output_row_count;
+}
+
+Cost estimate_join_sort_merge_cost(const JoinInputProperties& left_input, const JoinInputProperties& right_input,
+                                   const Cardinality output_row_count) {
+  auto cost = (left_input.row_count + right_input.row_count) * SORT_MERGE_COST_PER_ROW + output_row_count;
+
+  // JoinSortMerge skips sorting runs that are already in order, so only unsorted inputs incur the n*log(n) term
+  for (const auto& input : {left_input, right_input}) {
+    if (!input.is_sorted) {
+      cost += input.row_count * log2_or_one(input.row_count);
+    }
+  }
+
+  return cost;
+}
+
+Cost estimate_join_index_cost(const IndexSide index_side, const JoinInputProperties& left_input,
+                              const JoinInputProperties& right_input, const Cardinality output_row_count) {
+  const auto& index_input = index_side == IndexSide::Left ? left_input : right_input;
+  const auto& probe_input = index_side == IndexSide::Left ? right_input : left_input;
+  Assert(index_input.indexed_chunk_count, "Index side of JoinIndex needs to be indexed");
+
+  // Each probe value is looked up in the index of every chunk, each lookup is logarithmic in the chunk's size
+  const auto chunk_count = static_cast<float>(std::max(*index_input.indexed_chunk_count, size_t{1}));
+  const auto lookup_cost = log2_or_one(index_input.row_count / chunk_count);
+
+  return probe_input.row_count * chunk_count * lookup_cost + output_row_count;
+}
+
+Cost estimate_join_nested_loop_cost(const JoinInputProperties& left_input, const JoinInputProperties& right_input,
+                                    const Cardinality output_row_count) {
+  return left_input.row_count * right_input.row_count + output_row_count;
+}
+
+}  // namespace opossum
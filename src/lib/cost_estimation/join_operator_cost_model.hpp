@@ -0,0 +1,44 @@
+#pragma once
+
+#include <optional>
+
+#include "operators/abstract_join_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Physical properties of a join input that are relevant for choosing a join operator. They are determined by the
+ * LQPTranslator before the inputs are executed, so they are estimates at best.
+ */
+struct JoinInputProperties {
+  Cardinality row_count{0.0f};
+
+  // True if the input is sorted ascendingly by the join column across all of its chunks
+  bool is_sorted{false};
+
+  // If every chunk of the input has an index on the join column, this holds the number of chunks. JoinIndex looks up
+  // every probe value in each chunk's index separately.
+  std::optional<size_t> indexed_chunk_count{};
+};
+
+/**
+ * Cost model for the physical join operators. Similar to CostEstimatorLogical, the costs roughly correspond to the
+ * number of tuples touched, but tuples are weighted by how expensive touching them is for the respective algorithm
+ * (e.g., random accesses into a hash table are more expensive than the sequential accesses of a merge). The absolute
+ * numbers are meaningless, they are only used to rank the operators that support a given join.
+ */
+Cost estimate_join_hash_cost(const JoinMode join_mode, const JoinInputProperties& left_input,
+                             const JoinInputProperties& right_input, const Cardinality output_row_count);
+
+Cost estimate_join_sort_merge_cost(const JoinInputProperties& left_input, const JoinInputProperties& right_input,
+                                   const Cardinality output_row_count);
+
+// @param index_side    The input whose indexes are used. Its `indexed_chunk_count` must be set.
+Cost estimate_join_index_cost(const IndexSide index_side, const JoinInputProperties& left_input,
+                              const JoinInputProperties& right_input, const Cardinality output_row_count);
+
+Cost estimate_join_nested_loop_cost(const JoinInputProperties& left_input, const JoinInputProperties& right_input,
+                                    const Cardinality output_row_count);
+
+}  // namespace opossum
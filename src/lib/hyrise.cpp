@@ -17,6 +17,7 @@ Hyrise::Hyrise() {
   storage_manager = StorageManager{};
   transaction_manager = TransactionManager{};
   meta_table_manager = MetaTableManager{};
+  encoding_advisor = EncodingAdvisor{};
   topology = Topology{};
   _scheduler = std::make_shared<ImmediateExecutionScheduler>();
 }
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "boost/container/pmr/memory_resource.hpp"
+#include "concurrency/redo_log.hpp"
 #include "concurrency/transaction_manager.hpp"
 #include "scheduler/immediate_execution_scheduler.hpp"
 #include "scheduler/topology.hpp"
+#include "storage/encoding_advisor.hpp"
 #include "storage/storage_manager.hpp"
 #include "utils/meta_table_manager.hpp"
 #include "utils/plugin_manager.hpp"
@@ -32,7 +34,11 @@ class Hyrise : public Singleton<Hyrise> {
   PluginManager plugin_manager;
   StorageManager storage_manager;
   TransactionManager transaction_manager;
+  // Declared after the TransactionManager so that it is destructed first - flushing the redo log completes the
+  // pending commits.
+  RedoLog redo_log;
   MetaTableManager meta_table_manager;
+  EncodingAdvisor encoding_advisor;
   Topology topology;
 
   // The BenchmarkRunner is available here so that non-benchmark components can add information to the benchmark
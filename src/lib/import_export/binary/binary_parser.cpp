@@ -1,12 +1,20 @@
 #include "binary_parser.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <memory>
 #include <numeric>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "constant_mappings.hpp"
 #include "hyrise.hpp"
@@ -17,25 +25,214 @@
 #include "storage/vector_compression/simd_bp128/oversized_types.hpp"
 #include "storage/vector_compression/simd_bp128/simd_bp128_vector.hpp"
 
+#include "scheduler/job_task.hpp"
 #include "utils/assert.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Read-only mapping of a file, unmapped on destruction
+class MappedFile : public Noncopyable {
+ public:
+  explicit MappedFile(const std::string& filename) {
+    const auto file_descriptor = open(filename.c_str(), O_RDONLY);
+    Assert(file_descriptor != -1, "Could not open binary file " + filename);
+
+    struct stat file_stat {};
+    const auto stat_result = fstat(file_descriptor, &file_stat);
+    size = static_cast<size_t>(file_stat.st_size);
+    if (stat_result != 0 || size == 0) {
+      close(file_descriptor);
+      Fail("Could not read binary file " + filename);
+    }
+
+    auto* const mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    close(file_descriptor);
+    Assert(mapping != MAP_FAILED, "Could not map binary file " + filename);
+
+    // The chunks are parsed concurrently, so the whole file is needed soon, but not strictly sequentially
+    madvise(mapping, size, MADV_WILLNEED);
+    data = static_cast<const char*>(mapping);
+  }
+
+  ~MappedFile() { munmap(const_cast<char*>(data), size); }
+
+  const char* data;
+  size_t size;
+};
+
+// Read-only stream buffer over a part of a MappedFile. It lets the parsing functions, which read from an std::istream,
+// copy the values directly from the mapped pages.
+class MappedStreamBuffer : public std::streambuf {
+ public:
+  MappedStreamBuffer(const char* begin, const char* end) {
+    // std::streambuf takes non-const pointers, but the get area is never written to
+    setg(const_cast<char*>(begin), const_cast<char*>(begin), const_cast<char*>(end));
+  }
+
+  size_t position() const { return static_cast<size_t>(gptr() - eback()); }
+};
+
+// Finds the beginning of each chunk without constructing the segments. Only the sizes that are stored in the file are
+// read, which is cheap compared to parsing the values. See BinaryWriter for the layouts.
+class ChunkBoundaryScanner {
+ public:
+  ChunkBoundaryScanner(const char* data, const size_t size, const size_t offset)
+      : _data(data), _size(size), _offset(offset) {}
+
+  size_t offset() const { return _offset; }
+
+  void skip_chunk(const Table& table) {
+    const auto row_count = _read<ChunkOffset>();
+
+    const auto column_count = table.column_count();
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        _skip_segment<ColumnDataType>(row_count, table.column_is_nullable(column_id));
+      });
+    }
+  }
+
+ private:
+  template <typename T>
+  void _skip_segment(const ChunkOffset row_count, const bool is_nullable) {
+    switch (_read<EncodingType>()) {
+      case EncodingType::Unencoded:
+        if (is_nullable) _skip_values<bool>(row_count);
+        _skip_values<T>(row_count);
+        break;
+
+      case EncodingType::Dictionary: {
+        const auto attribute_vector_width = _read_attribute_vector_width();
+        _skip_values<T>(_read<ValueID::base_type>());
+        _skip(static_cast<size_t>(row_count) * attribute_vector_width);
+      } break;
+
+      case EncodingType::RunLength: {
+        const auto run_count = _read<uint32_t>();
+        _skip_values<T>(run_count);
+        _skip_values<bool>(run_count);
+        _skip_values<ChunkOffset>(run_count);
+      } break;
+
+      case EncodingType::FrameOfReference: {
+        const auto offset_value_width = _read_attribute_vector_width();
+        _skip_values<T>(_read<uint32_t>());
+        _skip_values<bool>(_read<uint32_t>());
+        _skip(static_cast<size_t>(row_count) * offset_value_width);
+      } break;
+
+      case EncodingType::LZ4: {
+        _read<uint32_t>();  // Number of elements
+        const auto block_count = _read<uint32_t>();
+        _skip((block_count > 1 ? 2 : 1) * sizeof(uint32_t));  // Block size and last block size
+        auto compressed_size = size_t{0};
+        for (auto block_index = uint32_t{0}; block_index < block_count; ++block_index) {
+          compressed_size += _read<uint32_t>();
+        }
+        _skip(compressed_size);
+        _skip_values<bool>(_read<uint32_t>());
+        _skip_values<char>(_read<uint32_t>());
+        if (_read<uint32_t>() > 0) _skip_values<uint128_t>(_read<uint32_t>());
+      } break;
+
+      default:
+        Fail("Cannot import column: invalid column type");
+    }
+  }
+
+  AttributeVectorWidth _read_attribute_vector_width() {
+    const auto width = _read<AttributeVectorWidth>();
+    Assert(width == 1 || width == 2 || width == 4, "Cannot import attribute vector with width: " + std::to_string(width));
+    return width;
+  }
+
+  template <typename T>
+  T _read() {
+    Assert(_offset + sizeof(T) <= _size, "Binary file is truncated");
+    auto value = T{};
+    std::memcpy(&value, _data + _offset, sizeof(T));
+    _offset += sizeof(T);
+    return value;
+  }
+
+  void _skip(const size_t bytes) {
+    Assert(_offset + bytes <= _size, "Binary file is truncated");
+    _offset += bytes;
+  }
+
+  template <typename T>
+  void _skip_values(const size_t count) {
+    if constexpr (std::is_same_v<T, pmr_string>) {
+      // Strings are stored as their lengths followed by their concatenated characters
+      auto total_length = size_t{0};
+      for (auto index = size_t{0}; index < count; ++index) {
+        total_length += _read<size_t>();
+      }
+      _skip(total_length);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      _skip(count * sizeof(BoolAsByteType));
+    } else {
+      _skip(count * sizeof(T));
+    }
+  }
+
+  const char* _data;
+  size_t _size;
+  size_t _offset;
+};
+
+}  // namespace
+
 namespace opossum {
 
 std::shared_ptr<Table> BinaryParser::parse(const std::string& filename) {
-  std::ifstream file;
-  file.open(filename, std::ios::binary);
-  file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+  const auto file = MappedFile{filename};
+
+  auto header_buffer = MappedStreamBuffer{file.data, file.data + file.size};
+  std::istream header_stream{&header_buffer};
+  header_stream.exceptions(std::istream::failbit | std::istream::badbit);
+  const auto header = _read_header(header_stream);
+  const auto& table = header.first;
+  const auto chunk_count = header.second;
+
+  // As the size of a chunk is not stored in the file, we first determine where each chunk begins. This allows us to
+  // parse the chunks concurrently.
+  auto chunk_offsets = std::vector<size_t>{};
+  chunk_offsets.reserve(chunk_count + 1);
+  auto scanner = ChunkBoundaryScanner{file.data, file.size, header_buffer.position()};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    chunk_offsets.emplace_back(scanner.offset());
+    scanner.skip_chunk(*table);
+  }
+  chunk_offsets.emplace_back(scanner.offset());
+
+  auto chunks = std::vector<std::pair<Segments, ChunkOffset>>(chunk_count);
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      auto chunk_buffer =
+          MappedStreamBuffer{file.data + chunk_offsets[chunk_id], file.data + chunk_offsets[chunk_id + 1]};
+      std::istream chunk_stream{&chunk_buffer};
+      chunk_stream.exceptions(std::istream::failbit | std::istream::badbit);
+      chunks[chunk_id] = read_chunk(chunk_stream, *table);
+    }));
+    jobs.back()->schedule();
+  }
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
 
-  auto [table, chunk_count] = _read_header(file);
-  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
-    _import_chunk(file, table);
+  for (auto& [segments, row_count] : chunks) {
+    table->append_chunk(segments, std::make_shared<MvccData>(row_count, CommitID{0}));
   }
 
   return table;
 }
 
 template <typename T>
-pmr_vector<T> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<T> BinaryParser::_read_values(std::istream& file, const size_t count) {
   pmr_vector<T> values(count);
   file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
   return values;
@@ -43,19 +240,19 @@ pmr_vector<T> BinaryParser::_read_values(std::ifstream& file, const size_t count
 
 // specialized implementation for string values
 template <>
-pmr_vector<pmr_string> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<pmr_string> BinaryParser::_read_values(std::istream& file, const size_t count) {
   return _read_string_values(file, count);
 }
 
 // specialized implementation for bool values
 template <>
-pmr_vector<bool> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<bool> BinaryParser::_read_values(std::istream& file, const size_t count) {
   pmr_vector<BoolAsByteType> readable_bools(count);
   file.read(reinterpret_cast<char*>(readable_bools.data()), readable_bools.size() * sizeof(BoolAsByteType));
   return pmr_vector<bool>(readable_bools.begin(), readable_bools.end());
 }
 
-pmr_vector<pmr_string> BinaryParser::_read_string_values(std::ifstream& file, const size_t count) {
+pmr_vector<pmr_string> BinaryParser::_read_string_values(std::istream& file, const size_t count) {
   const auto string_lengths = _read_values<size_t>(file, count);
   const auto total_length = std::accumulate(string_lengths.cbegin(), string_lengths.cend(), static_cast<size_t>(0));
   const auto buffer = _read_values<char>(file, total_length);
@@ -72,13 +269,13 @@ pmr_vector<pmr_string> BinaryParser::_read_string_values(std::ifstream& file, co
 }
 
 template <typename T>
-T BinaryParser::_read_value(std::ifstream& file) {
+T BinaryParser::_read_value(std::istream& file) {
   T result;
   file.read(reinterpret_cast<char*>(&result), sizeof(T));
   return result;
 }
 
-std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::ifstream& file) {
+std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::istream& file) {
   const auto chunk_size = _read_value<ChunkOffset>(file);
   const auto chunk_count = _read_value<ChunkID>(file);
   const auto column_count = _read_value<ColumnID>(file);
@@ -98,20 +295,19 @@ std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::ifstr
   return std::make_pair(table, chunk_count);
 }
 
-void BinaryParser::_import_chunk(std::ifstream& file, std::shared_ptr<Table>& table) {
+std::pair<Segments, ChunkOffset> BinaryParser::read_chunk(std::istream& file, const Table& table) {
   const auto row_count = _read_value<ChunkOffset>(file);
 
   Segments output_segments;
-  for (ColumnID column_id{0}; column_id < table->column_count(); ++column_id) {
+  for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
     output_segments.push_back(
-        _import_segment(file, row_count, table->column_data_type(column_id), table->column_is_nullable(column_id)));
+        _import_segment(file, row_count, table.column_data_type(column_id), table.column_is_nullable(column_id)));
   }
 
-  const auto mvcc_data = std::make_shared<MvccData>(row_count, CommitID{0});
-  table->append_chunk(output_segments, mvcc_data);
+  return std::make_pair(std::move(output_segments), row_count);
 }
 
-std::shared_ptr<BaseSegment> BinaryParser::_import_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<BaseSegment> BinaryParser::_import_segment(std::istream& file, ChunkOffset row_count,
                                                            DataType data_type, bool is_nullable) {
   std::shared_ptr<BaseSegment> result;
   resolve_data_type(data_type, [&](auto type) {
@@ -123,7 +319,7 @@ std::shared_ptr<BaseSegment> BinaryParser::_import_segment(std::ifstream& file,
 }
 
 template <typename ColumnDataType>
-std::shared_ptr<BaseSegment> BinaryParser::_import_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<BaseSegment> BinaryParser::_import_segment(std::istream& file, ChunkOffset row_count,
                                                            bool is_nullable) {
   const auto column_type = _read_value<EncodingType>(file);
 
@@ -150,7 +346,7 @@ std::shared_ptr<BaseSegment> BinaryParser::_import_segment(std::ifstream& file,
 }
 
 template <typename T>
-std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::istream& file, ChunkOffset row_count,
                                                                      bool is_nullable) {
   // TODO(unknown): Ideally _read_values would directly write into a pmr_concurrent_vector so that no conversion is
   // needed
@@ -166,7 +362,7 @@ std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::ifstre
 }
 
 template <typename T>
-std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(std::ifstream& file,
+std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(std::istream& file,
                                                                                ChunkOffset row_count) {
   const auto attribute_vector_width = _read_value<AttributeVectorWidth>(file);
   const auto dictionary_size = _read_value<ValueID>(file);
@@ -179,7 +375,7 @@ std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(s
 }
 
 template <typename T>
-std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(std::ifstream& file,
+std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(std::istream& file,
                                                                               ChunkOffset row_count) {
   const auto size = _read_value<uint32_t>(file);
   const auto values = std::make_shared<pmr_vector<T>>(_read_values<T>(file, size));
@@ -190,7 +386,7 @@ std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(st
 }
 
 template <typename T>
-std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_reference_segment(std::ifstream& file,
+std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_reference_segment(std::istream& file,
                                                                                              ChunkOffset row_count) {
   const auto attribute_vector_width = _read_value<AttributeVectorWidth>(file);
   const auto block_count = _read_value<uint32_t>(file);
@@ -203,7 +399,7 @@ std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_refer
 }
 
 template <typename T>
-std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::ifstream& file, ChunkOffset row_count) {
+std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::istream& file, ChunkOffset row_count) {
   const auto num_elements = _read_value<uint32_t>(file);
   const auto block_count = _read_value<uint32_t>(file);
 
@@ -261,7 +457,7 @@ std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::ifstream&
 }
 
 std::shared_ptr<BaseCompressedVector> BinaryParser::_import_attribute_vector(
-    std::ifstream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
+    std::istream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
   switch (attribute_vector_width) {
     case 1:
       return std::make_shared<FixedSizeByteAlignedVector<uint8_t>>(_read_values<uint8_t>(file, row_count));
@@ -275,7 +471,7 @@ std::shared_ptr<BaseCompressedVector> BinaryParser::_import_attribute_vector(
 }
 
 std::unique_ptr<const BaseCompressedVector> BinaryParser::_import_offset_value_vector(
-    std::ifstream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
+    std::istream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
   switch (attribute_vector_width) {
     case 1:
       return std::make_unique<FixedSizeByteAlignedVector<uint8_t>>(_read_values<uint8_t>(file, row_count));
@@ -34,19 +34,15 @@ class BinaryParser {
    * --------------
    *
    * ¹ Zero or more chunks
+   *
+   * The file is mapped into memory. After the boundaries of the chunks have been determined, the chunks are parsed
+   * concurrently, one JobTask per chunk.
    */
   static std::shared_ptr<Table> parse(const std::string& filename);
 
- private:
-  /*
-   * Reads the header from the given file.
-   * Creates an empty table from the extracted information and
-   * returns that table and the number of chunks.
-   */
-  static std::pair<std::shared_ptr<Table>, ChunkID> _read_header(std::ifstream& file);
-
   /*
-   * Creates a chunk from chunk information from the given file and adds it to the given table.
+   * Reads a single chunk as written by BinaryWriter::write_chunk. The column definitions are taken from the given
+   * table, but the chunk is not added to it. Returns the segments and the row count of the chunk.
    * The chunk information has the following form:
    *
    * ----------------
@@ -57,48 +53,56 @@ class BinaryParser {
    *
    * ¹Number of columns is provided in the binary header
    */
-  static void _import_chunk(std::ifstream& file, std::shared_ptr<Table>& table);
+  static std::pair<Segments, ChunkOffset> read_chunk(std::istream& file, const Table& table);
+
+ private:
+  /*
+   * Reads the header from the given file.
+   * Creates an empty table from the extracted information and
+   * returns that table and the number of chunks.
+   */
+  static std::pair<std::shared_ptr<Table>, ChunkID> _read_header(std::istream& file);
 
   // Calls the right _import_column<ColumnDataType> depending on the given data_type.
-  static std::shared_ptr<BaseSegment> _import_segment(std::ifstream& file, ChunkOffset row_count, DataType data_type,
+  static std::shared_ptr<BaseSegment> _import_segment(std::istream& file, ChunkOffset row_count, DataType data_type,
                                                       bool is_nullable);
 
   template <typename ColumnDataType>
   // Reads the column type from the given file and chooses a segment import function from it.
-  static std::shared_ptr<BaseSegment> _import_segment(std::ifstream& file, ChunkOffset row_count, bool is_nullable);
+  static std::shared_ptr<BaseSegment> _import_segment(std::istream& file, ChunkOffset row_count, bool is_nullable);
 
   template <typename T>
-  static std::shared_ptr<ValueSegment<T>> _import_value_segment(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<ValueSegment<T>> _import_value_segment(std::istream& file, ChunkOffset row_count,
                                                                 bool is_nullable);
   template <typename T>
-  static std::shared_ptr<DictionarySegment<T>> _import_dictionary_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<DictionarySegment<T>> _import_dictionary_segment(std::istream& file, ChunkOffset row_count);
 
   template <typename T>
-  static std::shared_ptr<RunLengthSegment<T>> _import_run_length_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<RunLengthSegment<T>> _import_run_length_segment(std::istream& file, ChunkOffset row_count);
 
   template <typename T>
-  static std::shared_ptr<FrameOfReferenceSegment<T>> _import_frame_of_reference_segment(std::ifstream& file,
+  static std::shared_ptr<FrameOfReferenceSegment<T>> _import_frame_of_reference_segment(std::istream& file,
                                                                                         ChunkOffset row_count);
   template <typename T>
-  static std::shared_ptr<LZ4Segment<T>> _import_lz4_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<LZ4Segment<T>> _import_lz4_segment(std::istream& file, ChunkOffset row_count);
 
   // Calls the _import_attribute_vector<uintX_t> function that corresponds to the given attribute_vector_width.
-  static std::shared_ptr<BaseCompressedVector> _import_attribute_vector(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<BaseCompressedVector> _import_attribute_vector(std::istream& file, ChunkOffset row_count,
                                                                         AttributeVectorWidth attribute_vector_width);
 
   static std::unique_ptr<const BaseCompressedVector> _import_offset_value_vector(
-      std::ifstream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width);
+      std::istream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width);
 
   // Reads row_count many values from type T and returns them in a vector
   template <typename T>
-  static pmr_vector<T> _read_values(std::ifstream& file, const size_t count);
+  static pmr_vector<T> _read_values(std::istream& file, const size_t count);
 
   // Reads row_count many strings from input file. String lengths are encoded in type T.
-  static pmr_vector<pmr_string> _read_string_values(std::ifstream& file, const size_t count);
+  static pmr_vector<pmr_string> _read_string_values(std::istream& file, const size_t count);
 
   // Reads a single value of type T from the input file.
   template <typename T>
-  static T _read_value(std::ifstream& file);
+  static T _read_value(std::istream& file);
 };
 
 }  // namespace opossum
@@ -105,6 +105,10 @@ void BinaryWriter::write(const Table& table, const std::string& filename) {
   }
 }
 
+void BinaryWriter::write_chunk(const Table& table, const ChunkID chunk_id, std::ofstream& ofstream) {
+  _write_chunk(table, ofstream, chunk_id);
+}
+
 void BinaryWriter::_write_header(const Table& table, std::ofstream& ofstream) {
   export_value(ofstream, static_cast<ChunkOffset>(table.max_chunk_size()));
   export_value(ofstream, static_cast<ChunkID::base_type>(table.chunk_count()));
@@ -21,6 +21,12 @@ class BinaryWriter {
  public:
   static void write(const Table& table, const std::string& filename);
 
+  /**
+   * Writes only the given chunk (i.e., its row count and segments, see _write_chunk). It can be read with
+   * BinaryParser::read_chunk. Used by checkpoints, which write each chunk into a separate file in parallel.
+   */
+  static void write_chunk(const Table& table, const ChunkID chunk_id, std::ofstream& ofstream);
+
  private:
   /**
    * This methods writes the header of this table into the given ofstream.
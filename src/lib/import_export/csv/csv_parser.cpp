@@ -1,11 +1,14 @@
 #include "csv_parser.hpp"
 
+#include <algorithm>
+#include <deque>
 #include <fstream>
 #include <list>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -15,6 +18,8 @@
 #include "import_export/csv/csv_meta.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/job_task.hpp"
+#include "statistics/generate_pruning_statistics.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
 #include "utils/load_table.hpp"
@@ -22,7 +27,15 @@
 namespace opossum {
 
 std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const ChunkOffset chunk_size,
-                                        const std::optional<CsvMeta>& csv_meta) {
+                                        const std::optional<CsvMeta>& csv_meta,
+                                        const std::optional<ChunkEncodingSpec>& chunk_encoding_spec) {
+  return _parse(filename, chunk_size, csv_meta, chunk_encoding_spec, READ_WINDOW_SIZE);
+}
+
+std::shared_ptr<Table> CsvParser::_parse(const std::string& filename, const ChunkOffset chunk_size,
+                                         const std::optional<CsvMeta>& csv_meta,
+                                         const std::optional<ChunkEncodingSpec>& chunk_encoding_spec,
+                                         const size_t read_window_size) {
   // If no meta info is given as a parameter, look for a json file
   CsvMeta meta;
   if (csv_meta == std::nullopt) {
@@ -34,58 +47,107 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const Chunk
   auto escaped_linebreak = std::string(1, meta.config.delimiter_escape) + std::string(1, meta.config.delimiter);
 
   auto table = _create_table_from_meta(chunk_size, meta);
+  Assert(!chunk_encoding_spec || chunk_encoding_spec->size() == static_cast<size_t>(table->column_count()),
+         "Number of column encoding specs must match the table's column count.");
 
   std::ifstream csvfile{filename};
 
   // return empty table if input file is empty
   if (!csvfile || csvfile.peek() == EOF || csvfile.peek() == '\r' || csvfile.peek() == '\n') return table;
 
-  /**
-   * Load the whole file(!) into a std::string using the, hopefully, fastest method to do so.
-   * TODO(anybody) Maybe use mmap() in the future. The current approach needs to have the entire file in RAM, mmap might
-   *               be cleverer, dunno.
-   */
-  csvfile.seekg(0, std::ios::end);
-  const auto csvfile_size = csvfile.tellg();
-  std::string content(csvfile_size, ' ');
-  csvfile.seekg(0);
-  csvfile.read(content.data(), csvfile_size);
+  // Holds the part of the file that has been read, but not yet been handed to a parsing task
+  auto content = std::string{};
+  auto end_of_file = false;
+
+  // Appends the next window of the file to content
+  const auto read_window = [&]() {
+    const auto previous_size = content.size();
+    content.resize(previous_size + read_window_size);
+    csvfile.read(content.data() + previous_size, static_cast<std::streamsize>(read_window_size));
+    content.resize(previous_size + static_cast<size_t>(csvfile.gcount()));
+    end_of_file = csvfile.eof();
+
+    // make sure content ends with a delimiter for better row processing later
+    if (end_of_file && !content.empty() && content.back() != meta.config.delimiter) {
+      content.push_back(meta.config.delimiter);
+    }
+  };
 
-  // make sure content ends with a delimiter for better row processing later
-  if (content.back() != meta.config.delimiter) content.push_back(meta.config.delimiter);
+  // A chunk can only be handed to a parsing task once it is complete, i.e., once all its rows are in content
+  const auto fields_per_chunk = static_cast<size_t>(table->max_chunk_size()) * table->column_count();
 
-  std::string_view content_view{content.c_str(), content.size()};
+  // Bound the number of chunks whose text is held in memory while they wait to be parsed
+  const auto max_tasks_in_flight = size_t{2} * std::max(1u, std::thread::hardware_concurrency());
 
   // Save chunks in list to avoid memory relocation
   std::list<Segments> segments_by_chunks;
-  std::vector<std::shared_ptr<AbstractTask>> tasks;
+  std::deque<std::shared_ptr<AbstractTask>> tasks_in_flight;
   std::vector<size_t> field_ends;
   std::mutex append_chunk_mutex;
-  while (_find_fields_in_chunk(content_view, *table, field_ends, meta)) {
-    // create empty chunk
-    segments_by_chunks.emplace_back();
-    auto& segments = segments_by_chunks.back();
-
-    // Only pass the part of the string that is actually needed to the parsing task
-    std::string_view relevant_content = content_view.substr(0, field_ends.back());
-
-    // Remove processed part of the csv content
-    content_view = content_view.substr(field_ends.back() + 1);
-
-    // create and start parsing task to fill chunk
-    tasks.emplace_back(std::make_shared<JobTask>([relevant_content, field_ends, &table, &segments, &meta,
-                                                  &escaped_linebreak, &append_chunk_mutex]() {
-      _parse_into_chunk(relevant_content, field_ends, *table, segments, meta, escaped_linebreak, append_chunk_mutex);
-    }));
-    tasks.back()->schedule();
+  while (!end_of_file) {
+    read_window();
+
+    auto content_view = std::string_view{content};
+    auto processed_size = size_t{0};
+    while (_find_fields_in_chunk(content_view, *table, field_ends, meta)) {
+      // Rows of an incomplete chunk might continue in the next window
+      if (!end_of_file && field_ends.size() < fields_per_chunk) break;
+
+      // create empty chunk
+      segments_by_chunks.emplace_back();
+      auto& segments = segments_by_chunks.back();
+
+      // Only pass the part of the string that is actually needed to the parsing task. It is copied so that the window
+      // can be reused.
+      auto relevant_content = std::string{content_view.substr(0, field_ends.back())};
+
+      // Remove processed part of the csv content
+      content_view = content_view.substr(field_ends.back() + 1);
+      processed_size += field_ends.back() + 1;
+
+      if (tasks_in_flight.size() == max_tasks_in_flight) {
+        Hyrise::get().scheduler()->wait_for_tasks({tasks_in_flight.front()});
+        tasks_in_flight.pop_front();
+      }
+
+      // create and start parsing task to fill chunk
+      tasks_in_flight.emplace_back(std::make_shared<JobTask>(
+          [relevant_content = std::move(relevant_content), field_ends, &table, &segments, &meta, &escaped_linebreak,
+           &append_chunk_mutex, &chunk_encoding_spec]() mutable {
+            _parse_into_chunk(relevant_content, field_ends, *table, segments, meta, escaped_linebreak,
+                              append_chunk_mutex);
+
+            // The task object lives until all chunks are parsed, so we release the csv text right away
+            relevant_content = std::string{};
+            field_ends = std::vector<size_t>{};
+
+            if (!chunk_encoding_spec) return;
+            const auto column_count = table->column_count();
+            for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+              segments[column_id] = ChunkEncoder::encode_segment(segments[column_id], table->column_data_type(column_id),
+                                                                 (*chunk_encoding_spec)[column_id]);
+            }
+          }));
+      tasks_in_flight.back()->schedule();
+    }
+
+    content.erase(0, processed_size);
   }
 
-  Hyrise::get().scheduler()->wait_for_tasks(tasks);
+  Hyrise::get().scheduler()->wait_for_tasks(
+      std::vector<std::shared_ptr<AbstractTask>>(tasks_in_flight.begin(), tasks_in_flight.end()));
 
   for (auto& segments : segments_by_chunks) {
     DebugAssert(!segments.empty(), "Empty chunks shouldn't occur when importing CSV");
     const auto mvcc_data = std::make_shared<MvccData>(segments.front()->size(), CommitID{0});
     table->append_chunk(segments, mvcc_data);
+
+    // Encoded segments cannot be appended to, so their chunks are finalized
+    if (chunk_encoding_spec) {
+      const auto& chunk = table->last_chunk();
+      chunk->finalize();
+      generate_chunk_pruning_statistics(chunk);
+    }
   }
 
   return table;
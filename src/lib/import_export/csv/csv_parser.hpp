@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "import_export/csv/csv_meta.hpp"
+#include "storage/encoding_type.hpp"
 
 namespace opossum {
 
@@ -21,23 +22,38 @@ class Chunk;
  * For non-RFC 4180, all linebreaks within quoted strings are further escaped with an escape character.
  * For the structure of the meta csv file see export_csv.hpp
  *
- * This parser reads the whole csv file and iterates over it to separate the data into chunks that are aligned with the
- * csv rows.
- * Each data chunk is parsed and converted into a opossum chunk. In the end all chunks are combined to the final table.
+ * This parser reads the csv file in windows of a fixed size and separates the data into chunks that are aligned with the
+ * csv rows. Each data chunk is parsed and converted into a opossum chunk by a JobTask while the next window is read. In
+ * the end all chunks are combined to the final table. Only the current window and the text of the chunks that are
+ * being parsed are kept in memory, not the entire file.
  */
 class CsvParser {
+  friend class CsvParserTest;
+
  public:
   /*
-   * @param filename      Path to the input file.
-   * @param csv_meta      Custom csv meta information which will be used instead of the default "filename" + ".json" meta.
-   * @returns             The table that was created from the csv file.
+   * @param filename            Path to the input file.
+   * @param csv_meta            Custom csv meta information which will be used instead of the default "filename" +
+   *                            ".json" meta.
+   * @param chunk_encoding_spec If given, each chunk is encoded as soon as it is parsed, so that the unencoded segments
+   *                            of only a few chunks exist at a time. Encoded chunks are finalized.
+   * @returns                   The table that was created from the csv file.
    */
   static std::shared_ptr<Table> parse(const std::string& filename, const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE,
-                                      const std::optional<CsvMeta>& csv_meta = std::nullopt);
+                                      const std::optional<CsvMeta>& csv_meta = std::nullopt,
+                                      const std::optional<ChunkEncodingSpec>& chunk_encoding_spec = std::nullopt);
   static std::shared_ptr<Table> create_table_from_meta_file(const std::string& filename,
                                                             const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE);
 
  protected:
+  // Size of the windows in which the file is read
+  static constexpr auto READ_WINDOW_SIZE = size_t{64} * 1024 * 1024;
+
+  static std::shared_ptr<Table> _parse(const std::string& filename, const ChunkOffset chunk_size,
+                                       const std::optional<CsvMeta>& csv_meta,
+                                       const std::optional<ChunkEncodingSpec>& chunk_encoding_spec,
+                                       const size_t read_window_size);
+
   /*
    * Use the meta information stored in _meta to create a new table with according column description.
    */
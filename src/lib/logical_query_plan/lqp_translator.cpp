@@ -1,6 +1,8 @@
 #include "lqp_translator.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -13,6 +15,7 @@
 #include "create_prepared_plan_node.hpp"
 #include "create_table_node.hpp"
 #include "create_view_node.hpp"
+#include "cost_estimation/join_operator_cost_model.hpp"
 #include "delete_node.hpp"
 #include "drop_table_node.hpp"
 #include "drop_view_node.hpp"
@@ -29,6 +32,7 @@
 #include "insert_node.hpp"
 #include "join_node.hpp"
 #include "limit_node.hpp"
+#include "lossless_cast.hpp"
 #include "operators/aggregate_hash.hpp"
 #include "operators/alias_operator.hpp"
 #include "operators/delete.hpp"
@@ -37,6 +41,7 @@
 #include "operators/index_scan.hpp"
 #include "operators/insert.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
 #include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
@@ -52,6 +57,7 @@
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_all.hpp"
 #include "operators/union_positions.hpp"
 #include "operators/update.hpp"
@@ -60,12 +66,141 @@
 #include "projection_node.hpp"
 #include "sort_node.hpp"
 #include "static_table_node.hpp"
+#include "statistics/cardinality_estimator.hpp"
+#include "storage/segment_iterate.hpp"
 #include "stored_table_node.hpp"
 #include "union_node.hpp"
 #include "update_node.hpp"
+#include "utils/meta_table_manager.hpp"
 
 using namespace std::string_literals;  // NOLINT
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Returns the StoredTableNode that @param column_expression originates from if @param node is that StoredTableNode or
+// a ValidateNode directly on top of it. Meta tables are ignored as they are generated on the fly.
+std::shared_ptr<const StoredTableNode> get_stored_table_node(const std::shared_ptr<AbstractLQPNode>& node,
+                                                             const AbstractExpression& column_expression,
+                                                             const bool allow_validate) {
+  const auto lqp_column_expression = dynamic_cast<const LQPColumnExpression*>(&column_expression);
+  if (!lqp_column_expression) return nullptr;
+
+  auto stored_table_node = std::dynamic_pointer_cast<const StoredTableNode>(node);
+  if (!stored_table_node && allow_validate && node->type == LQPNodeType::Validate) {
+    stored_table_node = std::dynamic_pointer_cast<const StoredTableNode>(node->left_input());
+  }
+
+  if (!stored_table_node || lqp_column_expression->column_reference.original_node() != stored_table_node ||
+      MetaTableManager::is_meta_table_name(stored_table_node->table_name)) {
+    return nullptr;
+  }
+
+  return stored_table_node;
+}
+
+// Returns the chunks of the table stored under @param stored_table_node that are neither pruned nor deleted, i.e., the
+// chunks that GetTable will output
+std::vector<std::shared_ptr<Chunk>> get_unpruned_chunks(const StoredTableNode& stored_table_node) {
+  const auto table = Hyrise::get().storage_manager.get_table(stored_table_node.table_name);
+  const auto& pruned_chunk_ids = stored_table_node.pruned_chunk_ids();
+
+  auto chunks = std::vector<std::shared_ptr<Chunk>>{};
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (std::binary_search(pruned_chunk_ids.begin(), pruned_chunk_ids.end(), chunk_id)) continue;
+
+    const auto chunk = table->get_chunk(chunk_id);
+    if (chunk) chunks.emplace_back(chunk);
+  }
+
+  return chunks;
+}
+
+// Returns true if the output of @param node is known to be sorted ascendingly by @param column_expression. This is the
+// case for Sort nodes and for stored tables whose chunks are sorted individually and in the correct order. For other
+// nodes, we do not know whether the order is retained (e.g., TableScan outputs its chunks in non-deterministic order).
+bool is_sorted_by(const std::shared_ptr<AbstractLQPNode>& node, const AbstractExpression& column_expression) {
+  if (const auto sort_node = std::dynamic_pointer_cast<SortNode>(node)) {
+    const auto order_by_mode = sort_node->order_by_modes.front();
+    return *sort_node->node_expressions.front() == column_expression &&
+           (order_by_mode == OrderByMode::Ascending || order_by_mode == OrderByMode::AscendingNullsLast);
+  }
+
+  const auto stored_table_node = get_stored_table_node(node, column_expression, false);
+  if (!stored_table_node) return false;
+
+  const auto column_id =
+      static_cast<const LQPColumnExpression&>(column_expression).column_reference.original_column_id();
+
+  const auto chunks = get_unpruned_chunks(*stored_table_node);
+  for (const auto& chunk : chunks) {
+    if (chunk->size() == 0) continue;
+
+    const auto& ordered_by = chunk->ordered_by();
+    if (!ordered_by || ordered_by->first != column_id ||
+        (ordered_by->second != OrderByMode::Ascending && ordered_by->second != OrderByMode::AscendingNullsLast)) {
+      return false;
+    }
+  }
+
+  // Chunks have to follow each other in order as well. Only the first and the last value of each chunk are read. If
+  // NULLs are at the boundaries, we do not bother looking further.
+  auto is_sorted = true;
+  resolve_data_type(column_expression.data_type(), [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    auto previous_last_value = std::optional<ColumnDataType>{};
+    for (const auto& chunk : chunks) {
+      if (chunk->size() == 0) continue;
+
+      // The iterables only look at the ChunkOffsets of the position filter
+      const auto position_filter = std::make_shared<PosList>();
+      position_filter->guarantee_single_chunk();
+      position_filter->emplace_back(RowID{ChunkID{0}, ChunkOffset{0}});
+      position_filter->emplace_back(RowID{ChunkID{0}, static_cast<ChunkOffset>(chunk->size() - 1)});
+
+      auto boundary_values = std::vector<ColumnDataType>{};
+      const auto& segment = *chunk->get_segment(column_id);
+      segment_iterate_filtered<ColumnDataType>(segment, position_filter, [&](const auto& position) {
+        if (!position.is_null()) boundary_values.emplace_back(position.value());
+      });
+      if (boundary_values.size() != 2 || (previous_last_value && boundary_values.front() < *previous_last_value)) {
+        is_sorted = false;
+        return;
+      }
+
+      previous_last_value = boundary_values.back();
+    }
+  });
+
+  return is_sorted;
+}
+
+// If every chunk of the (potentially validated) stored table @param node has an index on @param column_expression,
+// returns the number of chunks.
+std::optional<size_t> count_indexed_chunks(const std::shared_ptr<AbstractLQPNode>& node,
+                                           const AbstractExpression& column_expression) {
+  const auto stored_table_node = get_stored_table_node(node, column_expression, true);
+  if (!stored_table_node) return std::nullopt;
+
+  const auto column_id =
+      static_cast<const LQPColumnExpression&>(column_expression).column_reference.original_column_id();
+  const auto column_ids = std::vector<ColumnID>{column_id};
+
+  const auto chunks = get_unpruned_chunks(*stored_table_node);
+  if (chunks.empty()) return std::nullopt;
+
+  for (const auto& chunk : chunks) {
+    if (chunk->get_indexes(column_ids).empty()) return std::nullopt;
+  }
+
+  return chunks.size();
+}
+
+}  // namespace
+
 namespace opossum {
 
 std::shared_ptr<AbstractOperator> LQPTranslator::translate_node(const std::shared_ptr<AbstractLQPNode>& node) const {
@@ -200,6 +335,31 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_in
   const auto stored_table_node = std::dynamic_pointer_cast<StoredTableNode>(node->left_input());
   const auto table_name = stored_table_node->table_name;
   const auto table = Hyrise::get().storage_manager.get_table(table_name);
+
+  // A TableIndex covers all chunks, including those added after the translation. GetTable passes it on to the
+  // IndexScan, which falls back to a TableScan if it cannot (see IndexScan). As the TableIndex is looked up with
+  // values of the column's type, it is only used if the values can be cast losslessly.
+  const auto stored_column_id =
+      static_cast<const LQPColumnExpression&>(*predicate->arguments[0]).column_reference.original_column_id();
+  if (table->get_table_index({stored_column_id})) {
+    const auto column_data_type = table->column_data_type(stored_column_id);
+    const auto cast_value = lossless_variant_cast(value_variant, column_data_type);
+    const auto cast_value2 =
+        value2_variant ? lossless_variant_cast(*value2_variant, column_data_type) : std::optional<AllTypeVariant>{};
+
+    if (cast_value && (!value2_variant || cast_value2)) {
+      const auto cast_right_values = std::vector<AllTypeVariant>{*cast_value};
+      auto cast_right_values2 = std::vector<AllTypeVariant>{};
+      if (cast_value2) cast_right_values2.emplace_back(*cast_value2);
+
+      auto index_scan = std::make_shared<IndexScan>(input_operator, SegmentIndexType::GroupKey, column_ids,
+                                                    predicate->predicate_condition, cast_right_values,
+                                                    cast_right_values2);
+      index_scan->lqp_node = node;
+      return index_scan;
+    }
+  }
+
   std::vector<ChunkID> indexed_chunks;
 
   const auto chunk_count = table->chunk_count();
@@ -210,6 +370,11 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_in
     }
   }
 
+  // An IndexScan without included chunks would scan all chunks
+  if (indexed_chunks.empty()) {
+    return _translate_predicate_node_to_table_scan(node, input_operator);
+  }
+
   // All chunks that have an index on column_ids are handled by an IndexScan. All other chunks are handled by
   // TableScan(s).
   auto index_scan = std::make_shared<IndexScan>(input_operator, SegmentIndexType::GroupKey, column_ids,
@@ -261,33 +426,21 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_projection_node(
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_sort_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
   const auto sort_node = std::dynamic_pointer_cast<SortNode>(node);
-  auto input_operator = translate_node(node->left_input());
-
-  /**
-   * Go through all the order descriptions and create a sort operator for each of them.
-   * Iterate in reverse because the sort operator does not support multiple columns, and instead relies on stable sort.
-   * We therefore sort by the n+1-th column before sorting by the n-th column.
-   */
+  const auto input_operator = translate_node(node->left_input());
 
-  std::shared_ptr<AbstractOperator> current_pqp = input_operator;
+  // All ORDER BYs are executed by a single Sort operator, which compares all sort columns at once
+  auto sort_definitions = std::vector<SortColumnDefinition>{};
   const auto& pqp_expressions = _translate_expressions(sort_node->node_expressions, node->left_input());
-  if (pqp_expressions.size() > 1) {
-    PerformanceWarning("Multiple ORDER BYs are executed one-by-one");
-  }
-
-  auto pqp_expression_iter = pqp_expressions.rbegin();
-  auto order_by_mode_iter = sort_node->order_by_modes.rbegin();
-
-  for (; pqp_expression_iter != pqp_expressions.rend(); ++pqp_expression_iter, ++order_by_mode_iter) {
-    const auto& pqp_expression = *pqp_expression_iter;
+  for (auto expression_idx = size_t{0}; expression_idx < pqp_expressions.size(); ++expression_idx) {
+    const auto& pqp_expression = pqp_expressions[expression_idx];
     const auto pqp_column_expression = std::dynamic_pointer_cast<PQPColumnExpression>(pqp_expression);
     Assert(pqp_column_expression,
            "Sort Expression '"s + pqp_expression->as_column_name() + "' must be available as column, LQP is invalid");
 
-    current_pqp = std::make_shared<Sort>(current_pqp, pqp_column_expression->column_id, *order_by_mode_iter);
+    sort_definitions.emplace_back(pqp_column_expression->column_id, sort_node->order_by_modes[expression_idx]);
   }
 
-  return current_pqp;
+  return std::make_shared<Sort>(input_operator, sort_definitions);
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
@@ -323,9 +476,95 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
 
   const auto left_data_type = join_node->join_predicates().front()->arguments[0]->data_type();
   const auto right_data_type = join_node->join_predicates().front()->arguments[1]->data_type();
+  const auto join_configuration =
+      JoinConfiguration{join_node->join_mode, primary_join_predicate.predicate_condition, left_data_type,
+                        right_data_type, !secondary_join_predicates.empty()};
+
+  const auto& left_column_expression =
+      *node->left_input()->column_expressions()[primary_join_predicate.column_ids.first];
+  const auto& right_column_expression =
+      *node->right_input()->column_expressions()[primary_join_predicate.column_ids.second];
+
+  auto left_input_properties = JoinInputProperties{};
+  left_input_properties.is_sorted = is_sorted_by(node->left_input(), left_column_expression);
+  left_input_properties.indexed_chunk_count = count_indexed_chunks(node->left_input(), left_column_expression);
+
+  auto right_input_properties = JoinInputProperties{};
+  right_input_properties.is_sorted = is_sorted_by(node->right_input(), right_column_expression);
+  right_input_properties.indexed_chunk_count = count_indexed_chunks(node->right_input(), right_column_expression);
+
+  // For inputs that are neither sorted nor indexed, the cost model always ranks JoinHash before JoinSortMerge. In
+  // that case, which is by far the most common one, we skip the cardinality estimation and pick the first operator
+  // that supports the join.
+  const auto use_cost_model = left_input_properties.is_sorted || right_input_properties.is_sorted ||
+                              left_input_properties.indexed_chunk_count ||
+                              right_input_properties.indexed_chunk_count;
+
+  if (use_cost_model) {
+    if (!_cardinality_estimator) {
+      // The LQP does not change during the translation, so the cardinalities of the join inputs can be cached
+      _cardinality_estimator = std::make_shared<CardinalityEstimator>();
+      _cardinality_estimator->guarantee_bottom_up_construction();
+    }
 
-  // Lacking a proper cost model, we assume JoinHash is always faster than JoinSortMerge, which is faster than
-  // JoinNestedLoop and thus check for an operator compatible with the JoinNode in that order
+    left_input_properties.row_count = _cardinality_estimator->estimate_cardinality(node->left_input());
+    right_input_properties.row_count = _cardinality_estimator->estimate_cardinality(node->right_input());
+    const auto output_row_count = _cardinality_estimator->estimate_cardinality(node);
+
+    auto join_operator_cost = Cost{0.0f};
+    const auto consider_join_operator = [&](const Cost cost, const auto& create_join_operator) {
+      if (join_operator && join_operator_cost <= cost) return;
+      join_operator = create_join_operator();
+      join_operator_cost = cost;
+    };
+
+    if (JoinHash::supports(join_configuration)) {
+      consider_join_operator(estimate_join_hash_cost(join_node->join_mode, left_input_properties,
+                                                     right_input_properties, output_row_count),
+                             [&]() {
+                               return std::make_shared<JoinHash>(input_left_operator, input_right_operator,
+                                                                 join_node->join_mode, primary_join_predicate,
+                                                                 secondary_join_predicates);
+                             });
+    }
+
+    if (JoinSortMerge::supports(join_configuration)) {
+      consider_join_operator(
+          estimate_join_sort_merge_cost(left_input_properties, right_input_properties, output_row_count), [&]() {
+            return std::make_shared<JoinSortMerge>(input_left_operator, input_right_operator, join_node->join_mode,
+                                                   primary_join_predicate, secondary_join_predicates);
+          });
+    }
+
+    // JoinIndex looks up the values of the probe side in the index side's indexes without converting them
+    if (left_data_type == right_data_type) {
+      for (const auto index_side : {IndexSide::Right, IndexSide::Left}) {
+        const auto& index_input_properties =
+            index_side == IndexSide::Left ? left_input_properties : right_input_properties;
+        if (!index_input_properties.indexed_chunk_count) continue;
+
+        auto index_join_configuration = join_configuration;
+        index_join_configuration.left_table_type =
+            node->left_input()->type == LQPNodeType::StoredTable ? TableType::Data : TableType::References;
+        index_join_configuration.right_table_type =
+            node->right_input()->type == LQPNodeType::StoredTable ? TableType::Data : TableType::References;
+        index_join_configuration.index_side = index_side;
+        if (!JoinIndex::supports(index_join_configuration)) continue;
+
+        consider_join_operator(
+            estimate_join_index_cost(index_side, left_input_properties, right_input_properties, output_row_count),
+            [&]() {
+              return std::make_shared<JoinIndex>(input_left_operator, input_right_operator, join_node->join_mode,
+                                                 primary_join_predicate, secondary_join_predicates, index_side);
+            });
+      }
+    }
+  }
+
+  // JoinNestedLoop is not considered by the cost model. Its costs grow quadratically with the input sizes, so
+  // underestimated inputs (which are common for the upper joins of a plan) would make it disastrously slow. Lacking a
+  // reliable estimation of its costs, we assume JoinHash is always faster than JoinSortMerge, which is faster than
+  // JoinNestedLoop and thus check for an operator compatible with the JoinNode in that order.
   constexpr auto JOIN_OPERATOR_PREFERENCE_ORDER =
       hana::to_tuple(hana::tuple_t<JoinHash, JoinSortMerge, JoinNestedLoop>);
 
@@ -334,8 +573,7 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
 
     if (join_operator) return;
 
-    if (JoinOperator::supports({join_node->join_mode, primary_join_predicate.predicate_condition, left_data_type,
-                                right_data_type, !secondary_join_predicates.empty()})) {
+    if (JoinOperator::supports(join_configuration)) {
       join_operator = std::make_shared<JoinOperator>(input_left_operator, input_right_operator, join_node->join_mode,
                                                      primary_join_predicate, std::move(secondary_join_predicates));
     }
@@ -396,10 +634,28 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_limit_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
-  const auto input_operator = translate_node(node->left_input());
   auto limit_node = std::dynamic_pointer_cast<LimitNode>(node);
-  return std::make_shared<Limit>(
-      input_operator, _translate_expressions({limit_node->num_rows_expression()}, node->left_input()).front());
+  const auto num_rows_expression =
+      _translate_expressions({limit_node->num_rows_expression()}, node->left_input()).front();
+
+  /**
+   * ORDER BY ... LIMIT on a single column is executed by a TopK operator, which does not need to sort the entire input.
+   * TopK compares a single column only, so multiple ORDER BYs are executed by a Sort followed by a Limit.
+   */
+  const auto sort_node = std::dynamic_pointer_cast<SortNode>(node->left_input());
+  if (sort_node && sort_node->output_count() == 1 && sort_node->node_expressions.size() == 1) {
+    const auto input_operator = translate_node(sort_node->left_input());
+    const auto pqp_expression = _translate_expressions(sort_node->node_expressions, sort_node->left_input()).front();
+    const auto pqp_column_expression = std::dynamic_pointer_cast<PQPColumnExpression>(pqp_expression);
+    Assert(pqp_column_expression,
+           "Sort Expression '"s + pqp_expression->as_column_name() + "' must be available as column, LQP is invalid");
+
+    return std::make_shared<TopK>(input_operator, pqp_column_expression->column_id,
+                                  sort_node->order_by_modes.front(), num_rows_expression);
+  }
+
+  const auto input_operator = translate_node(node->left_input());
+  return std::make_shared<Limit>(input_operator, num_rows_expression);
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_insert_node(
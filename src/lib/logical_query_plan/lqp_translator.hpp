@@ -9,6 +9,7 @@
 
 namespace opossum {
 
+class AbstractCardinalityEstimator;
 class AbstractOperator;
 class TransactionContext;
 class AbstractExpression;
@@ -73,6 +74,9 @@ class LQPTranslator {
   //   - identical operators (operators below a diamond shape)
   //   - equal but not identical operators
   mutable LQPNodeUnorderedMap<std::shared_ptr<AbstractOperator>> _operator_by_lqp_node;
+
+  // Used to choose between join operators. Created lazily, as most joins can be translated without it.
+  mutable std::shared_ptr<AbstractCardinalityEstimator> _cardinality_estimator;
 };
 
 }  // namespace opossum
@@ -4,6 +4,7 @@
 
 #include "expression/expression_functional.hpp"
 #include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
 #include "logical_query_plan/abstract_lqp_node.hpp"
 #include "logical_query_plan/delete_node.hpp"
 #include "logical_query_plan/insert_node.hpp"
@@ -12,6 +13,8 @@
 #include "logical_query_plan/stored_table_node.hpp"
 #include "logical_query_plan/union_node.hpp"
 #include "logical_query_plan/update_node.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
 #include "utils/assert.hpp"
 
 using namespace opossum::expression_functional;  // NOLINT
@@ -299,4 +302,27 @@ std::vector<std::shared_ptr<AbstractLQPNode>> lqp_find_subplan_roots(const std::
   return root_nodes;
 }
 
+bool lqp_uses_outdated_statistics(const std::shared_ptr<AbstractLQPNode>& lqp) {
+  const auto& storage_manager = Hyrise::get().storage_manager;
+
+  auto uses_outdated_statistics = false;
+  for (const auto& root_node : lqp_find_subplan_roots(lqp)) {
+    visit_lqp(root_node, [&](const auto& node) {
+      if (uses_outdated_statistics) return LQPVisitation::DoNotVisitInputs;
+
+      if (node->type == LQPNodeType::StoredTable) {
+        const auto& stored_table_node = static_cast<const StoredTableNode&>(*node);
+        // Plans of dropped Tables are outdated as well
+        uses_outdated_statistics =
+            !storage_manager.has_table(stored_table_node.table_name) ||
+            storage_manager.get_table(stored_table_node.table_name)->statistics_version() !=
+                stored_table_node.statistics_version;
+      }
+      return LQPVisitation::VisitInputs;
+    });
+    if (uses_outdated_statistics) return true;
+  }
+  return false;
+}
+
 }  // namespace opossum
@@ -165,4 +165,11 @@ void visit_lqp_upwards(const std::shared_ptr<AbstractLQPNode>& lqp, Visitor visi
  */
 std::vector<std::shared_ptr<AbstractLQPNode>> lqp_find_subplan_roots(const std::shared_ptr<AbstractLQPNode>& lqp);
 
+/**
+ * @return whether the statistics of a Table that a StoredTableNode of @param lqp or of its subqueries references have
+ *         been rebuilt since the node was created, i.e., whether the plan might have been optimized with outdated
+ *         statistics. Rebuilding the statistics of other Tables does not affect the plan.
+ */
+bool lqp_uses_outdated_statistics(const std::shared_ptr<AbstractLQPNode>& lqp);
+
 }  // namespace opossum
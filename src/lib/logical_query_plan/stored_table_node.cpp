@@ -12,7 +12,11 @@
 namespace opossum {
 
 StoredTableNode::StoredTableNode(const std::string& table_name)
-    : AbstractLQPNode(LQPNodeType::StoredTable), table_name(table_name) {}
+    : AbstractLQPNode(LQPNodeType::StoredTable),
+      table_name(table_name),
+      statistics_version(Hyrise::get().storage_manager.has_table(table_name)
+                             ? Hyrise::get().storage_manager.get_table(table_name)->statistics_version()
+                             : 0) {}
 
 LQPColumnReference StoredTableNode::get_column(const std::string& name) const {
   const auto table = Hyrise::get().storage_manager.get_table(table_name);
@@ -128,6 +132,29 @@ std::vector<IndexStatistics> StoredTableNode::indexes_statistics() const {
   return pruned_indexes_statistics;
 }
 
+std::vector<std::vector<ColumnID>> StoredTableNode::table_indexes_column_ids() const {
+  DebugAssert(!left_input() && !right_input(), "StoredTableNode must be a leaf");
+
+  const auto table = Hyrise::get().storage_manager.get_table(table_name);
+  const auto column_id_mapping = column_ids_after_pruning(table->column_count(), _pruned_column_ids);
+
+  auto table_indexes_column_ids = std::vector<std::vector<ColumnID>>{};
+  for (const auto& [stored_column_ids, table_index] : table->table_indexes()) {
+    auto column_ids = std::vector<ColumnID>{};
+    for (const auto stored_column_id : stored_column_ids) {
+      // Indexed column was pruned - skip the index
+      if (!column_id_mapping[stored_column_id]) break;
+      column_ids.emplace_back(*column_id_mapping[stored_column_id]);
+    }
+
+    if (column_ids.size() == stored_column_ids.size()) {
+      table_indexes_column_ids.emplace_back(std::move(column_ids));
+    }
+  }
+
+  return table_indexes_column_ids;
+}
+
 size_t StoredTableNode::_on_shallow_hash() const {
   size_t hash{0};
   boost::hash_combine(hash, table_name);
@@ -144,6 +171,7 @@ std::shared_ptr<AbstractLQPNode> StoredTableNode::_on_shallow_copy(LQPNodeMappin
   const auto copy = make(table_name);
   copy->set_pruned_chunk_ids(_pruned_chunk_ids);
   copy->set_pruned_column_ids(_pruned_column_ids);
+  copy->statistics_version = statistics_version;
   return copy;
 }
 
@@ -39,6 +39,9 @@ class StoredTableNode : public EnableMakeForLQPNode<StoredTableNode>, public Abs
 
   std::vector<IndexStatistics> indexes_statistics() const;
 
+  // ColumnIDs (after pruning) of the TableIndexes of the stored Table whose columns were not pruned
+  std::vector<std::vector<ColumnID>> table_indexes_column_ids() const;
+
   std::string description(const DescriptionMode mode = DescriptionMode::Short) const override;
   const std::vector<std::shared_ptr<AbstractExpression>>& column_expressions() const override;
   bool is_column_nullable(const ColumnID column_id) const override;
@@ -49,6 +52,11 @@ class StoredTableNode : public EnableMakeForLQPNode<StoredTableNode>, public Abs
   // statistics if they have changed from the original table, e.g., as the result of chunk pruning.
   std::shared_ptr<TableStatistics> table_statistics;
 
+  // The version of the statistics of the stored Table (see Table::statistics_version()) when the node was created.
+  // Plans that are optimized from the node are based on these or newer statistics, so plan caches can detect outdated
+  // plans by comparing it with the current version (see lqp_uses_outdated_statistics()).
+  uint64_t statistics_version;
+
  protected:
   size_t _on_shallow_hash() const override;
   std::shared_ptr<AbstractLQPNode> _on_shallow_copy(LQPNodeMapping& node_mapping) const override;
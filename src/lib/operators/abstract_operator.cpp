@@ -87,6 +87,14 @@ std::shared_ptr<AbstractOperator> AbstractOperator::deep_copy() const {
   return _deep_copy_impl(copied_ops);
 }
 
+std::shared_ptr<AbstractOperator> AbstractOperator::copy_with_inputs(
+    const std::shared_ptr<AbstractOperator>& input_left, const std::shared_ptr<AbstractOperator>& input_right) const {
+  const auto copied_op = _on_deep_copy(input_left, input_right);
+  if (_transaction_context) copied_op->set_transaction_context(*_transaction_context);
+  copied_op->lqp_node = lqp_node;
+  return copied_op;
+}
+
 std::shared_ptr<const Table> AbstractOperator::input_table_left() const { return _input_left->get_output(); }
 
 std::shared_ptr<const Table> AbstractOperator::input_table_right() const { return _input_right->get_output(); }
@@ -148,6 +156,9 @@ std::shared_ptr<AbstractOperator> AbstractOperator::_deep_copy_impl(
 
   const auto copied_op = _on_deep_copy(copied_input_left, copied_input_right);
   if (_transaction_context) copied_op->set_transaction_context(*_transaction_context);
+  // Plans from the PQP cache are deep copies. Keeping the LQP node allows, e.g., the EncodingAdvisor to map their
+  // column accesses to stored tables.
+  copied_op->lqp_node = lqp_node;
 
   copied_ops.emplace(this, copied_op);
 
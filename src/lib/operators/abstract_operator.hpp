@@ -31,12 +31,15 @@ enum class OperatorType {
   JoinSortMerge,
   JoinVerification,
   Limit,
+  MorselPipeline,
   Print,
   Product,
   Projection,
+  SetOperationHash,
   Sort,
   TableScan,
   TableWrapper,
+  TopK,
   UnionAll,
   UnionPositions,
   Update,
@@ -103,6 +106,11 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
   // An operator needs to implement this method in order to be cacheable.
   std::shared_ptr<AbstractOperator> deep_copy() const;
 
+  // Returns a new instance of the same operator with the same configuration that consumes the given operators instead
+  // of copies of its own inputs. Used to restructure PQPs, e.g., by create_morsel_pipelines().
+  std::shared_ptr<AbstractOperator> copy_with_inputs(const std::shared_ptr<AbstractOperator>& input_left,
+                                                     const std::shared_ptr<AbstractOperator>& input_right) const;
+
   // Get the input operators.
   std::shared_ptr<const AbstractOperator> input_left() const;
   std::shared_ptr<const AbstractOperator> input_right() const;
@@ -51,6 +51,12 @@ void AbstractReadWriteOperator::rollback_records() {
   _state = ReadWriteOperatorState::RolledBack;
 }
 
+void AbstractReadWriteOperator::log_records(RedoLogRecord& record) const {
+  Assert(_state == ReadWriteOperatorState::Executed, "Operator needs to have state Executed in order to be logged.");
+
+  _on_log_records(record);
+}
+
 bool AbstractReadWriteOperator::execute_failed() const {
   return _state == ReadWriteOperatorState::Failed || _state == ReadWriteOperatorState::RolledBack;
 }
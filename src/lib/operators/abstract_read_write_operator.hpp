@@ -13,6 +13,8 @@
 
 namespace opossum {
 
+class RedoLogRecord;
+
 enum class ReadWriteOperatorState {
   Pending,     // The operator has been instantiated.
   Executed,    // Execution succeeded.
@@ -48,6 +50,12 @@ class AbstractReadWriteOperator : public AbstractOperator {
    */
   void rollback_records();
 
+  /**
+   * Adds the modifications of the operator to the redo log record of its transaction. Called while the transaction
+   * commits, before commit_records, and only if the RedoLog is enabled.
+   */
+  void log_records(RedoLogRecord& record) const;
+
   /**
    * Returns true if a previous call to _on_execute produced an error.
    */
@@ -80,6 +88,12 @@ class AbstractReadWriteOperator : public AbstractOperator {
    */
   virtual void _on_rollback_records() = 0;
 
+  /**
+   * Called by log_records. Operators that only delegate to other read/write operators (e.g., Update) do not need to
+   * log anything themselves, as the delegates are registered with the transaction, too.
+   */
+  virtual void _on_log_records(RedoLogRecord& record) const {}
+
   /**
    * This method is used in sub classes in their _on_execute() method.
    *
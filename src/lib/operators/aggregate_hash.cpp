@@ -1,7 +1,11 @@
 #include "aggregate_hash.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -13,6 +17,7 @@
 #include "aggregate/aggregate_traits.hpp"
 #include "constant_mappings.hpp"
 #include "hyrise.hpp"
+#include "join_hash/join_hash_steps.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
@@ -27,14 +32,14 @@ using namespace opossum;  // NOLINT
 
 // Given an AggregateKey key, and a RowId row_id where this AggregateKey was encountered, this first checks if the
 // AggregateKey was seen before. If not, a new aggregate result is inserted into results and connected to the row id.
-// This is important so that we can reconstruct the original values later. In any case, a reference to the result is
+// This is important so that we can reconstruct the original values later. In any case, the id of the result is
 // returned so that result information, such as the aggregate's count or sum, can be modified by the caller.
 template <typename ResultIds, typename Results, typename AggregateKey>
-typename Results::reference get_or_add_result(ResultIds& result_ids, Results& results, const AggregateKey& key,
-                                              const RowID& row_id) {
+AggregateResultId get_or_add_result_id(ResultIds& result_ids, Results& results, const AggregateKey& key,
+                                       const RowID& row_id) {
   // Get the result id for the current key or add it to the id map
   auto it = result_ids.find(key);
-  if (it != result_ids.end()) return results[it->second];
+  if (it != result_ids.end()) return it->second;
 
   auto result_id = results.size();
 
@@ -45,8 +50,145 @@ typename Results::reference get_or_add_result(ResultIds& result_ids, Results& re
   results.emplace_back();
   results[result_id].row_id = row_id;
 
-  return results[result_id];
+  return result_id;
 }
+
+// Writes the AggregateKeyEntries of the group-by column @param column_id of @param input_table to the position
+// @param group_column_index of the AggregateKeys. NULL values get the entry 0, all other values the entry returned by
+// @param get_entry.
+template <typename ColumnDataType, typename AggregateKey, typename GetEntry>
+void write_aggregate_key_entries(const Table& input_table, const ColumnID column_id, const size_t group_column_index,
+                                 KeysPerChunk<AggregateKey>& keys_per_chunk, const GetEntry& get_entry) {
+  const auto chunk_count = input_table.chunk_count();
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk_in = input_table.get_chunk(chunk_id);
+    if (!chunk_in) continue;
+
+    const auto base_segment = chunk_in->get_segment(column_id);
+    auto& keys = keys_per_chunk[chunk_id];
+    ChunkOffset chunk_offset{0};
+    segment_iterate<ColumnDataType>(*base_segment, [&](const auto& position) {
+      const auto entry = position.is_null() ? AggregateKeyEntry{0} : get_entry(position.value());
+      if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
+        keys[chunk_offset] = entry;
+      } else {
+        keys[chunk_offset][group_column_index] = entry;
+      }
+      ++chunk_offset;
+    });
+  }
+}
+
+AggregateKeyEntry int32_aggregate_key_entry(const int32_t value) {
+  // We need to convert a potentially negative int32_t value into the uint64_t space. We do not care about preserving
+  // the value, just its uniqueness. Subtract the minimum value in int32_t (which is negative itself) to get a positive
+  // number. The entry 0 is reserved for NULL values.
+  const auto shifted_value = static_cast<int64_t>(value) - std::numeric_limits<int32_t>::min();
+  DebugAssert(shifted_value >= 0, "Type conversion failed");
+  return static_cast<uint64_t>(shifted_value) + 1;
+}
+
+// Ids of the values of a group-by column that is not int32_t, similar to dictionary encoding. They are shared by all
+// morsels of a MorselPreAggregation, so that equal values get the same AggregateKeyEntry in every morsel.
+struct BaseGroupKeyIds {
+  virtual ~BaseGroupKeyIds() = default;
+
+  std::mutex mutex;
+  AggregateKeyEntry id_counter{1};
+};
+
+template <typename ColumnDataType>
+struct GroupKeyIds : public BaseGroupKeyIds {
+  std::unordered_map<ColumnDataType, AggregateKeyEntry> ids;
+};
+
+struct MorselPreAggregationImpl : public AggregateHash::MorselPreAggregation {
+  MorselPreAggregationImpl(const size_t morsel_count, const size_t groupby_column_count)
+      : partial_tables_per_morsel(morsel_count),
+        chunk_count_per_morsel(morsel_count),
+        group_key_ids(groupby_column_count) {}
+
+  std::vector<std::vector<std::vector<std::shared_ptr<SegmentVisitorContext>>>> partial_tables_per_morsel;
+  std::vector<ChunkID> chunk_count_per_morsel;
+
+  // Created by the first morsel that needs them
+  std::mutex group_key_ids_mutex;
+  std::vector<std::unique_ptr<BaseGroupKeyIds>> group_key_ids;
+};
+
+// Groups the (AggregateResultId, value) pairs of a COUNT(DISTINCT) context by their AggregateResultId using a counting
+// sort, so that the merge phase can access the distinct values of each partial result. The hash set is freed.
+template <typename Context>
+void group_distinct_values(Context& context) {
+  auto& offsets = context.distinct_value_offsets;
+  offsets.assign(context.results.size() + 1, 0);
+  for (const auto& [result_id, value] : context.distinct_values) {
+    ++offsets[result_id + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  auto write_offsets = std::vector<size_t>(offsets.begin(), offsets.end() - 1);
+  context.grouped_distinct_values.resize(context.distinct_values.size());
+  for (const auto& [result_id, value] : context.distinct_values) {
+    context.grouped_distinct_values[write_offsets[result_id]++] = value;
+  }
+
+  context.distinct_values = {};
+}
+
+// Merges a partial result of the pre-aggregation phase into the final result of the same group. COUNT(DISTINCT) is
+// merged using the distinct values of the contexts instead (see AggregateHash::_aggregate_partitioned()).
+template <AggregateFunction function, typename ColumnDataType, typename AggregateType>
+void merge_aggregate_results(AggregateResult<ColumnDataType, AggregateType>& result,
+                             AggregateResult<ColumnDataType, AggregateType>& partial_result) {
+  static_assert(function != AggregateFunction::CountDistinct, "COUNT(DISTINCT) results cannot be merged on their own");
+
+  if constexpr (function == AggregateFunction::StandardDeviationSample) {
+    if constexpr (std::is_arithmetic_v<AggregateType>) {
+      // Combine the (count, mean, squared_distance_from_mean) triples of Welford's algorithm, see Chan et al.:
+      // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm
+      auto& partial_secondary_aggregates = partial_result.current_secondary_aggregates;
+      auto& secondary_aggregates = result.current_secondary_aggregates;
+      if (partial_secondary_aggregates.empty()) {
+        // Only NULL values were aggregated
+      } else if (secondary_aggregates.empty()) {
+        secondary_aggregates = std::move(partial_secondary_aggregates);
+        result.current_primary_aggregate = partial_result.current_primary_aggregate;
+      } else {
+        const auto count_a = secondary_aggregates[0];
+        const auto count_b = partial_secondary_aggregates[0];
+        const auto count = count_a + count_b;
+        const double delta = partial_secondary_aggregates[1] - secondary_aggregates[1];
+
+        secondary_aggregates[0] = count;
+        secondary_aggregates[1] += delta * count_b / count;
+        secondary_aggregates[2] += partial_secondary_aggregates[2] + delta * delta * count_a * count_b / count;
+
+        // count is at least 2
+        result.current_primary_aggregate = std::sqrt(secondary_aggregates[2] / (count - 1));
+      }
+    } else {
+      Fail("StandardDeviationSample not available for non-arithmetic types.");
+    }
+  } else if (partial_result.current_primary_aggregate) {
+    auto& partial_aggregate = *partial_result.current_primary_aggregate;
+    auto& aggregate = result.current_primary_aggregate;
+
+    if (!aggregate) {
+      aggregate = std::move(partial_aggregate);
+    } else if constexpr (function == AggregateFunction::Min) {
+      if (partial_aggregate < *aggregate) aggregate = std::move(partial_aggregate);
+    } else if constexpr (function == AggregateFunction::Max) {
+      if (partial_aggregate > *aggregate) aggregate = std::move(partial_aggregate);
+    } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+      *aggregate += partial_aggregate;
+    }
+    // ANY keeps the first value, COUNT does not use the primary aggregate
+  }
+
+  result.aggregate_count += partial_result.aggregate_count;
+}
+
 }  // namespace
 
 namespace opossum {
@@ -69,7 +211,35 @@ std::shared_ptr<AbstractOperator> AggregateHash::_on_deep_copy(
 
 void AggregateHash::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
-void AggregateHash::_on_cleanup() { _contexts_per_column.clear(); }
+void AggregateHash::_on_cleanup() {
+  _contexts_per_column.clear();
+  _morsel_pre_aggregation.reset();
+}
+
+std::shared_ptr<AggregateHash::MorselPreAggregation> AggregateHash::create_morsel_pre_aggregation(
+    const size_t morsel_count) const {
+  return std::make_shared<MorselPreAggregationImpl>(morsel_count, _groupby_column_ids.size());
+}
+
+void AggregateHash::pre_aggregate_morsel(MorselPreAggregation& morsel_pre_aggregation, const size_t morsel_id) const {
+  // See _on_execute()
+  switch (_groupby_column_ids.size()) {
+    case 0:
+    case 1:
+      _pre_aggregate_morsel<AggregateKeyEntry>(morsel_pre_aggregation, morsel_id);
+      break;
+    case 2:
+      _pre_aggregate_morsel<std::array<AggregateKeyEntry, 2>>(morsel_pre_aggregation, morsel_id);
+      break;
+    default:
+      _pre_aggregate_morsel<std::vector<AggregateKeyEntry>>(morsel_pre_aggregation, morsel_id);
+      break;
+  }
+}
+
+void AggregateHash::set_morsel_pre_aggregation(const std::shared_ptr<MorselPreAggregation>& morsel_pre_aggregation) {
+  _morsel_pre_aggregation = morsel_pre_aggregation;
+}
 
 /*
 Visitor context for the AggregateVisitor. The AggregateResultContext can be used without knowing the
@@ -83,6 +253,14 @@ struct AggregateResultContext : SegmentVisitorContext {
 
   boost::container::pmr::monotonic_buffer_resource buffer;
   AggregateResults<ColumnDataType, AggregateType> results;
+
+  // Only used for COUNT(DISTINCT), see DistinctValueSet. When a partial result of the two-phase aggregation is handed
+  // over to the merge phase, the set is converted into the distinct values of each result. The values of result i are
+  // stored in grouped_distinct_values, starting at distinct_value_offsets[i] and ending before
+  // distinct_value_offsets[i + 1].
+  DistinctValueSet<ColumnDataType> distinct_values;
+  std::vector<size_t> distinct_value_offsets;
+  std::vector<ColumnDataType> grouped_distinct_values;
 };
 
 template <typename ColumnDataType, typename AggregateType, typename AggregateKey>
@@ -97,14 +275,14 @@ struct AggregateContext : public AggregateResultContext<ColumnDataType, Aggregat
 };
 
 template <typename ColumnDataType, AggregateFunction function, typename AggregateKey>
-void AggregateHash::_aggregate_segment(ChunkID chunk_id, ColumnID column_index, const BaseSegment& base_segment,
-                                       const KeysPerChunk<AggregateKey>& keys_per_chunk) {
+void AggregateHash::_aggregate_segment(ChunkID chunk_id, const BaseSegment& base_segment,
+                                       const KeysPerChunk<AggregateKey>& keys_per_chunk,
+                                       SegmentVisitorContext& base_context) const {
   using AggregateType = typename AggregateTraits<ColumnDataType, function>::AggregateType;
 
   auto aggregator = AggregateFunctionBuilder<ColumnDataType, AggregateType, function>().get_aggregate_function();
 
-  auto& context = *std::static_pointer_cast<AggregateContext<ColumnDataType, AggregateType, AggregateKey>>(
-      _contexts_per_column[column_index]);
+  auto& context = static_cast<AggregateContext<ColumnDataType, AggregateType, AggregateKey>&>(base_context);
 
   auto& result_ids = *context.result_ids;
   auto& results = context.results;
@@ -112,22 +290,27 @@ void AggregateHash::_aggregate_segment(ChunkID chunk_id, ColumnID column_index,
 
   ChunkOffset chunk_offset{0};
   segment_iterate<ColumnDataType>(base_segment, [&](const auto& position) {
-    auto& result = get_or_add_result(result_ids, results, hash_keys[chunk_offset], RowID{chunk_id, chunk_offset});
+    const auto result_id =
+        get_or_add_result_id(result_ids, results, hash_keys[chunk_offset], RowID{chunk_id, chunk_offset});
+    auto& result = results[result_id];
 
     /**
     * If the value is NULL, the current aggregate value does not change.
     */
     if (!position.is_null()) {
-      // If we have a value, use the aggregator lambda to update the current aggregate value for this group
-      aggregator(position.value(), result.current_primary_aggregate, result.current_secondary_aggregates);
-
-      // increase value counter
-      ++result.aggregate_count;
-
       if constexpr (function == AggregateFunction::CountDistinct) {  // NOLINT
         // clang-tidy error: https://bugs.llvm.org/show_bug.cgi?id=35824
-        // for the case of CountDistinct, insert this value into the set to keep track of distinct values
-        result.distinct_values.insert(position.value());
+        // for the case of CountDistinct, the value counter is only increased if the value has not been seen for this
+        // group before
+        if (context.distinct_values.emplace(result_id, position.value()).second) {
+          ++result.aggregate_count;
+        }
+      } else {
+        // If we have a value, use the aggregator lambda to update the current aggregate value for this group
+        aggregator(position.value(), result.current_primary_aggregate, result.current_secondary_aggregates);
+
+        // increase value counter
+        ++result.aggregate_count;
       }
     }
 
@@ -156,6 +339,12 @@ void AggregateHash::_aggregate() {
   // Check for invalid aggregates
   _validate_aggregates();
 
+  // The input was pre-aggregated morsel by morsel while it was produced by a MorselPipeline
+  if (_morsel_pre_aggregation) {
+    _merge_morsel_pre_aggregation<AggregateKey>();
+    return;
+  }
+
   /*
   PARTITIONING PHASE
   First we partition the input chunks by the given group key(s).
@@ -215,8 +404,6 @@ void AggregateHash::_aggregate() {
       const auto column_id = _groupby_column_ids.at(group_column_index);
       const auto data_type = input_table->column_data_type(column_id);
 
-      const auto chunk_count = input_table->chunk_count();
-
       resolve_data_type(data_type, [&](auto type) {
         using ColumnDataType = typename decltype(type)::type;
 
@@ -224,36 +411,8 @@ void AggregateHash::_aggregate() {
           // For values with a smaller type than AggregateKeyEntry, we can use the value itself as an AggregateKeyEntry.
           // We cannot do this for types with the same size as AggregateKeyEntry as we need to have a special NULL
           // value. By using the value itself, we can save us the effort of building the id_map.
-          for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
-            const auto chunk_in = input_table->get_chunk(chunk_id);
-            const auto base_segment = chunk_in->get_segment(column_id);
-            ChunkOffset chunk_offset{0};
-            segment_iterate<ColumnDataType>(*base_segment, [&](const auto& position) {
-              const auto to_uint = [](const int32_t value) {
-                // We need to convert a potentially negative int32_t value into the uint64_t space. We do not care
-                // about preserving the value, just its uniqueness. Subtract the minimum value in int32_t (which is
-                // negative itself) to get a positive number.
-                const auto shifted_value = static_cast<int64_t>(value) - std::numeric_limits<int32_t>::min();
-                DebugAssert(shifted_value >= 0, "Type conversion failed");
-                return static_cast<uint64_t>(shifted_value);
-              };
-
-              if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
-                if (position.is_null()) {
-                  keys_per_chunk[chunk_id][chunk_offset] = 0;
-                } else {
-                  keys_per_chunk[chunk_id][chunk_offset] = to_uint(position.value()) + 1;
-                }
-              } else {
-                if (position.is_null()) {
-                  keys_per_chunk[chunk_id][chunk_offset][group_column_index] = 0;
-                } else {
-                  keys_per_chunk[chunk_id][chunk_offset][group_column_index] = to_uint(position.value()) + 1;
-                }
-              }
-              ++chunk_offset;
-            });
-          }
+          write_aggregate_key_entries<ColumnDataType, AggregateKey>(*input_table, column_id, group_column_index,
+                                                                    keys_per_chunk, int32_aggregate_key_entry);
         } else {
           /*
           Store unique IDs for equal values in the groupby column (similar to dictionary encoding).
@@ -270,35 +429,15 @@ void AggregateHash::_aggregate() {
                                            std::equal_to<>, decltype(allocator)>(allocator);
           AggregateKeyEntry id_counter = 1u;
 
-          for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
-            const auto chunk_in = input_table->get_chunk(chunk_id);
-            if (!chunk_in) continue;
-
-            const auto base_segment = chunk_in->get_segment(column_id);
-            ChunkOffset chunk_offset{0};
-            segment_iterate<ColumnDataType>(*base_segment, [&](const auto& position) {
-              if (position.is_null()) {
-                if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
-                  keys_per_chunk[chunk_id][chunk_offset] = 0u;
-                } else {
-                  keys_per_chunk[chunk_id][chunk_offset][group_column_index] = 0u;
-                }
-              } else {
-                auto inserted = id_map.try_emplace(position.value(), id_counter);
-
-                if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
-                  keys_per_chunk[chunk_id][chunk_offset] = inserted.first->second;
-                } else {
-                  keys_per_chunk[chunk_id][chunk_offset][group_column_index] = inserted.first->second;
-                }
+          write_aggregate_key_entries<ColumnDataType, AggregateKey>(
+              *input_table, column_id, group_column_index, keys_per_chunk, [&](const ColumnDataType& value) {
+                const auto inserted = id_map.try_emplace(value, id_counter);
 
                 // if the id_map didn't have the value as a key and a new element was inserted
                 if (inserted.second) ++id_counter;
-              }
 
-              ++chunk_offset;
-            });
-          }
+                return inserted.first->second;
+              });
         }
       });
     }));
@@ -310,18 +449,26 @@ void AggregateHash::_aggregate() {
   /*
   AGGREGATION PHASE
   */
-  _contexts_per_column = std::vector<std::shared_ptr<SegmentVisitorContext>>(_aggregates.size());
+  const auto chunk_count = input_table->chunk_count();
 
-  if (_aggregates.empty()) {
-    /*
-    Insert a dummy context for the DISTINCT implementation.
-    That way, _contexts_per_column will always have at least one context with results.
-    This is important later on when we write the group keys into the table.
+  // Split the input into ranges of chunks that can be pre-aggregated by separate jobs
+  auto job_chunk_ranges = std::vector<std::pair<ChunkID, ChunkID>>{};
+  auto range_begin = ChunkID{0};
+  auto range_row_count = size_t{0};
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = input_table->get_chunk(chunk_id);
+    if (chunk) range_row_count += chunk->size();
 
-    We choose int8_t for column type and aggregate type because it's small.
-    */
-    auto context = std::make_shared<AggregateContext<DistinctColumnType, DistinctAggregateType, AggregateKey>>();
-    _contexts_per_column.push_back(context);
+    if (range_row_count >= PRE_AGGREGATION_ROWS_PER_JOB || chunk_id + 1 == chunk_count) {
+      job_chunk_ranges.emplace_back(range_begin, ChunkID{chunk_id + 1});
+      range_begin = ChunkID{chunk_id + 1};
+      range_row_count = 0;
+    }
+  }
+
+  if (job_chunk_ranges.size() > 1) {
+    _aggregate_partitioned<AggregateKey>(keys_per_chunk, job_chunk_ranges);
+    return;
   }
 
   /**
@@ -329,139 +476,470 @@ void AggregateHash::_aggregate() {
    * created on. We do this here, and not in the per-chunk-loop below, because there might be no Chunks in the input
    * and _write_aggregate_output() needs these contexts anyway.
    */
-  for (ColumnID column_id{0}; column_id < _aggregates.size(); ++column_id) {
-    const auto& aggregate = _aggregates[column_id];
-    if (aggregate.column == INVALID_COLUMN_ID) {
-      Assert(aggregate.function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
-      // SELECT COUNT(*) - we know the template arguments, so we don't need a visitor
-      auto context = std::make_shared<AggregateContext<CountColumnType, CountAggregateType, AggregateKey>>();
-      _contexts_per_column[column_id] = context;
-      continue;
-    }
-    auto data_type = input_table->column_data_type(aggregate.column);
-    _contexts_per_column[column_id] = _create_aggregate_context<AggregateKey>(data_type, aggregate.function);
-  }
+  _contexts_per_column = _create_aggregate_contexts<AggregateKey>();
 
   // Process Chunks and perform aggregations
-  const auto chunk_count = input_table->chunk_count();
   for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
     const auto chunk_in = input_table->get_chunk(chunk_id);
     if (!chunk_in) continue;
 
-    const auto& hash_keys = keys_per_chunk[chunk_id];
+    _aggregate_chunk<AggregateKey>(chunk_id, keys_per_chunk, _contexts_per_column);
+  }
+}
 
-    // Sometimes, gcc is really bad at accessing loop conditions only once, so we cache that here.
-    const auto input_chunk_size = chunk_in->size();
+template <typename AggregateKey>
+void AggregateHash::_aggregate_partitioned(const KeysPerChunk<AggregateKey>& keys_per_chunk,
+                                           const std::vector<std::pair<ChunkID, ChunkID>>& job_chunk_ranges) {
+  const auto job_count = job_chunk_ranges.size();
 
-    if (_aggregates.empty()) {
-      /**
-       * DISTINCT implementation
-       *
-       * In Opossum we handle the SQL keyword DISTINCT by grouping without aggregation.
-       *
-       * For a query like "SELECT DISTINCT * FROM A;"
-       * we would assume that all columns from A are part of 'groupby_columns',
-       * respectively any columns that were specified in the projection.
-       * The optimizer is responsible to take care of passing in the correct columns.
-       *
-       * How does this operation work?
-       * Distinct rows are retrieved by grouping by vectors of values. Similar as for the usual aggregation
-       * these vectors are used as keys in the 'column_results' map.
-       *
-       * At this point we've got all the different keys from the chunks and accumulate them in 'column_results'.
-       * In order to reuse the aggregation implementation, we add a dummy AggregateResult.
-       * One could optimize here in the future.
-       *
-       * Obviously this implementation is also used for plain GroupBy's.
-       */
+  /*
+  PRE-AGGREGATION PHASE
+  Each job aggregates its range of chunks into job-local tables, see _pre_aggregate_chunks().
+  */
+  using PartialTable = std::vector<std::shared_ptr<SegmentVisitorContext>>;
+  auto partial_tables_per_job = std::vector<std::vector<PartialTable>>(job_count);
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(job_count);
+
+  for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, job_id]() {
+      const auto& [range_begin, range_end] = job_chunk_ranges[job_id];
+      _pre_aggregate_chunks<AggregateKey>(range_begin, range_end, keys_per_chunk, partial_tables_per_job[job_id]);
+    }));
+    jobs.back()->schedule();
+  }
+
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+
+  auto partial_tables = std::vector<PartialTable>{};
+  for (auto& job_partial_tables : partial_tables_per_job) {
+    std::move(job_partial_tables.begin(), job_partial_tables.end(), std::back_inserter(partial_tables));
+  }
+  partial_tables_per_job.clear();
+
+  _merge_partial_tables<AggregateKey>(partial_tables);
+}
+
+template <typename AggregateKey>
+void AggregateHash::_pre_aggregate_chunks(
+    const ChunkID begin_chunk_id, const ChunkID end_chunk_id, const KeysPerChunk<AggregateKey>& keys_per_chunk,
+    std::vector<std::vector<std::shared_ptr<SegmentVisitorContext>>>& partial_tables) const {
+  const auto& input_table = input_table_left();
+  auto contexts = _create_aggregate_contexts<AggregateKey>();
+
+  // Once a table has reached PRE_AGGREGATION_MAX_GROUPS groups, it is kept for the merge phase and replaced by an
+  // empty one
+  const auto hand_over_partial_table = [&]() {
+    for (ColumnID column_index{0}; column_index < contexts.size(); ++column_index) {
+      _resolve_aggregate_context<AggregateKey>(
+          column_index, *contexts[column_index], [&](auto& context, const auto function) {
+            if constexpr (decltype(function)::value == AggregateFunction::CountDistinct) {
+              group_distinct_values(context);
+            }
+          });
+    }
+    partial_tables.emplace_back(std::move(contexts));
+  };
+
+  for (auto chunk_id = begin_chunk_id; chunk_id < end_chunk_id; ++chunk_id) {
+    if (!input_table->get_chunk(chunk_id)) continue;
+
+    _aggregate_chunk<AggregateKey>(chunk_id, keys_per_chunk, contexts);
+
+    if (_group_count<AggregateKey>(contexts) >= PRE_AGGREGATION_MAX_GROUPS) {
+      hand_over_partial_table();
+      contexts = _create_aggregate_contexts<AggregateKey>();
+    }
+  }
+
+  if (_group_count<AggregateKey>(contexts) > 0) {
+    hand_over_partial_table();
+  }
+}
+
+template <typename AggregateKey>
+void AggregateHash::_merge_partial_tables(
+    std::vector<std::vector<std::shared_ptr<SegmentVisitorContext>>>& partial_tables) {
+  using PartialTable = std::vector<std::shared_ptr<SegmentVisitorContext>>;
+
+  _contexts_per_column = _create_aggregate_contexts<AggregateKey>();
+  if (partial_tables.empty()) return;
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+
+  /*
+  PARTITIONING PHASE
+  The groups of all partial tables are materialized into a RadixContainer (one "chunk" per partial table) and
+  radix-partitioned by the hash of their AggregateKey using the partitioning of the hash join. The RowID of each element
+  does not point to the input table but to the partial result, i.e., it holds the index of the partial table and the
+  AggregateResultId within that table.
+  */
+  auto partial_table_offsets = std::vector<size_t>(partial_tables.size());
+  auto partial_group_count = size_t{0};
+  for (auto partial_table_id = size_t{0}; partial_table_id < partial_tables.size(); ++partial_table_id) {
+    partial_table_offsets[partial_table_id] = partial_group_count;
+    partial_group_count += _group_count<AggregateKey>(partial_tables[partial_table_id]);
+  }
+
+  auto radix_bits = size_t{0};
+  while ((partial_group_count >> radix_bits) > MERGE_GROUPS_PER_PARTITION) {
+    ++radix_bits;
+  }
+  const auto partition_count = size_t{1} << radix_bits;
+  const auto mask = partition_count - 1;
+
+  auto materialized_groups = RadixContainer<AggregateKey>{};
+  materialized_groups.elements = std::make_shared<Partition<AggregateKey>>();
+  materialized_groups.elements->resize(partial_group_count);
+  materialized_groups.partition_offsets = {partial_group_count};
+  materialized_groups.null_value_bitvector = std::make_shared<std::vector<bool>>();
+
+  auto histograms = std::vector<std::vector<size_t>>(partial_tables.size());
+
+  jobs.reserve(partial_tables.size());
+  for (auto partial_table_id = size_t{0}; partial_table_id < partial_tables.size(); ++partial_table_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, partial_table_id]() {
+      const auto hash_function = std::hash<AggregateKey>{};
+      auto& elements = *materialized_groups.elements;
+      auto& histogram = histograms[partial_table_id];
+      histogram.resize(partition_count);
+
+      // All contexts of a table share the same AggregateKey -> AggregateResultId mapping, so we use the first one
+      _resolve_aggregate_context<AggregateKey>(
+          ColumnID{0}, *partial_tables[partial_table_id][0], [&](auto& context, const auto function) {
+            for (const auto& [key, result_id] : *context.result_ids) {
+              const auto row_id = RowID{ChunkID{static_cast<ChunkID::base_type>(partial_table_id)},
+                                        static_cast<ChunkOffset>(result_id)};
+              elements[partial_table_offsets[partial_table_id] + result_id] = {row_id, key};
+              ++histogram[hash_function(key) & mask];
+            }
+          });
+    }));
+    jobs.back()->schedule();
+  }
+
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+  jobs.clear();
+
+  if (radix_bits > 0) {
+    materialized_groups = partition_radix_parallel<AggregateKey, AggregateKey, false>(
+        materialized_groups, partial_table_offsets, histograms, radix_bits);
+  }
+
+  /*
+  MERGE PHASE
+  Each partition is merged into its own set of contexts. As no group spans multiple partitions, the results of the
+  partitions are disjoint.
+  */
+  const auto& partition_offsets = materialized_groups.partition_offsets;
+  auto contexts_per_partition = std::vector<PartialTable>(partition_count);
+
+  jobs.reserve(partition_count);
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    const auto partition_begin = partition_id == 0 ? size_t{0} : partition_offsets[partition_id - 1];
+    const auto partition_end = partition_offsets[partition_id];
+    if (partition_begin == partition_end) continue;
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_id, partition_begin, partition_end]() {
+      const auto& elements = *materialized_groups.elements;
+      auto contexts = _create_aggregate_contexts<AggregateKey>();
+
+      // Instead of looking up each group in the AggregateResultIdMap of every context, we only maintain the map of the
+      // first context. As the groups are merged in the same order for all contexts, their results stay aligned.
+      auto result_ids = std::vector<AggregateResultId>(partition_end - partition_begin);
+      _resolve_aggregate_context<AggregateKey>(ColumnID{0}, *contexts[0], [&](auto& context, const auto function) {
+        auto& result_id_map = *context.result_ids;
+        for (auto position = partition_begin; position < partition_end; ++position) {
+          const auto next_result_id = result_id_map.size();
+          const auto [iter, inserted] = result_id_map.emplace(elements[position].value, next_result_id);
+          result_ids[position - partition_begin] = iter->second;
+        }
+      });
+
+      for (ColumnID column_index{0}; column_index < contexts.size(); ++column_index) {
+        _resolve_aggregate_context<AggregateKey>(
+            column_index, *contexts[column_index], [&](auto& context, const auto function) {
+              using Context = std::decay_t<decltype(context)>;
+
+              auto& results = context.results;
 
-      auto context =
-          std::static_pointer_cast<AggregateContext<DistinctColumnType, DistinctAggregateType, AggregateKey>>(
-              _contexts_per_column[0]);
+              for (auto position = partition_begin; position < partition_end; ++position) {
+                const auto& row_id = elements[position].row_id;
+                auto& partial_context = static_cast<Context&>(*partial_tables[row_id.chunk_id][column_index]);
+                auto& partial_result = partial_context.results[row_id.chunk_offset];
 
-      auto& result_ids = *context->result_ids;
-      auto& results = context->results;
+                const auto result_id = result_ids[position - partition_begin];
+                if (result_id == results.size()) {
+                  results.emplace_back();
+                  results.back().row_id = partial_result.row_id;
+                }
 
-      for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-        // Make sure the value or combination of values is added to the list of distinct value(s)
-        get_or_add_result(result_ids, results, hash_keys[chunk_offset], RowID{chunk_id, chunk_offset});
+                if constexpr (decltype(function)::value == AggregateFunction::CountDistinct) {
+                  // The same value might have been seen for this group by multiple pre-aggregation jobs
+                  const auto& offsets = partial_context.distinct_value_offsets;
+                  for (auto value_id = offsets[row_id.chunk_offset]; value_id < offsets[row_id.chunk_offset + 1];
+                       ++value_id) {
+                    const auto& value = partial_context.grouped_distinct_values[value_id];
+                    if (context.distinct_values.emplace(result_id, value).second) {
+                      ++results[result_id].aggregate_count;
+                    }
+                  }
+                } else {
+                  merge_aggregate_results<decltype(function)::value>(results[result_id], partial_result);
+                }
+              }
+            });
       }
+
+      contexts_per_partition[partition_id] = std::move(contexts);
+    }));
+    jobs.back()->schedule();
+  }
+
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+  jobs.clear();
+
+  /*
+  Concatenate the results of all partitions into _contexts_per_column, which is used to write the output. The
+  AggregateResultId maps are not needed anymore and are left empty.
+  */
+  auto output_offsets = std::vector<size_t>(partition_count);
+  auto group_count = size_t{0};
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    output_offsets[partition_id] = group_count;
+    if (!contexts_per_partition[partition_id].empty()) {
+      group_count += _group_count<AggregateKey>(contexts_per_partition[partition_id]);
+    }
+  }
+
+  for (ColumnID column_index{0}; column_index < _contexts_per_column.size(); ++column_index) {
+    _resolve_aggregate_context<AggregateKey>(column_index, *_contexts_per_column[column_index],
+                                             [&](auto& context, const auto function) {
+                                               context.results.resize(group_count);
+                                             });
+  }
+
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    if (contexts_per_partition[partition_id].empty()) continue;
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_id]() {
+      for (ColumnID column_index{0}; column_index < _contexts_per_column.size(); ++column_index) {
+        _resolve_aggregate_context<AggregateKey>(
+            column_index, *_contexts_per_column[column_index], [&](auto& context, const auto function) {
+              using Context = std::decay_t<decltype(context)>;
+
+              auto& partition_results =
+                  static_cast<Context&>(*contexts_per_partition[partition_id][column_index]).results;
+              std::move(partition_results.begin(), partition_results.end(),
+                        context.results.begin() + output_offsets[partition_id]);
+            });
+      }
+    }));
+    jobs.back()->schedule();
+  }
+
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+}
+
+template <typename AggregateKey>
+void AggregateHash::_pre_aggregate_morsel(MorselPreAggregation& morsel_pre_aggregation, const size_t morsel_id) const {
+  auto& pre_aggregation = static_cast<MorselPreAggregationImpl&>(morsel_pre_aggregation);
+  const auto& input_table = input_table_left();
+  const auto chunk_count = input_table->chunk_count();
+
+  // Unlike in _aggregate(), the morsel is small enough for the keys to be created by a single job
+  auto keys_per_chunk = KeysPerChunk<AggregateKey>{};
+  keys_per_chunk.reserve(chunk_count);
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk_size = input_table->get_chunk(chunk_id)->size();
+    if constexpr (std::is_same_v<AggregateKey, std::vector<AggregateKeyEntry>>) {
+      keys_per_chunk.emplace_back(chunk_size, AggregateKey(_groupby_column_ids.size()));
     } else {
-      ColumnID column_index{0};
-      for (const auto& aggregate : _aggregates) {
-        /**
-         * Special COUNT(*) implementation.
-         * Because COUNT(*) does not have a specific target column, we use the maximum ColumnID.
-         * We then go through the keys_per_chunk map and count the occurrences of each group key.
-         * The results are saved in the regular aggregate_count variable so that we don't need a
-         * specific output logic for COUNT(*).
-         */
-        if (aggregate.column == INVALID_COLUMN_ID) {
-          Assert(aggregate.function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
-          auto context = std::static_pointer_cast<AggregateContext<CountColumnType, CountAggregateType, AggregateKey>>(
-              _contexts_per_column[column_index]);
-
-          auto& result_ids = *context->result_ids;
-          auto& results = context->results;
-
-          // count occurrences for each group key
-          for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-            auto& result =
-                get_or_add_result(result_ids, results, hash_keys[chunk_offset], RowID{chunk_id, chunk_offset});
-            ++result.aggregate_count;
-          }
-
-          ++column_index;
-          continue;
+      keys_per_chunk.emplace_back(chunk_size, AggregateKey{});
+    }
+  }
+
+  for (auto group_column_index = size_t{0}; group_column_index < _groupby_column_ids.size(); ++group_column_index) {
+    const auto column_id = _groupby_column_ids[group_column_index];
+    resolve_data_type(input_table->column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      if constexpr (std::is_same_v<ColumnDataType, int32_t>) {
+        write_aggregate_key_entries<ColumnDataType, AggregateKey>(*input_table, column_id, group_column_index,
+                                                                  keys_per_chunk, int32_aggregate_key_entry);
+      } else {
+        auto* group_key_ids = static_cast<GroupKeyIds<ColumnDataType>*>(nullptr);
+        {
+          const auto lock = std::lock_guard<std::mutex>{pre_aggregation.group_key_ids_mutex};
+          auto& base_group_key_ids = pre_aggregation.group_key_ids[group_column_index];
+          if (!base_group_key_ids) base_group_key_ids = std::make_unique<GroupKeyIds<ColumnDataType>>();
+          group_key_ids = static_cast<GroupKeyIds<ColumnDataType>*>(base_group_key_ids.get());
         }
 
-        auto base_segment = chunk_in->get_segment(aggregate.column);
-        auto data_type = input_table->column_data_type(aggregate.column);
-
-        /*
-        Invoke correct aggregator for each segment
-        */
-
-        resolve_data_type(data_type, [&, aggregate](auto type) {
-          using ColumnDataType = typename decltype(type)::type;
-
-          switch (aggregate.function) {
-            case AggregateFunction::Min:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Min, AggregateKey>(chunk_id, column_index,
-                                                                                       *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Max:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Max, AggregateKey>(chunk_id, column_index,
-                                                                                       *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Sum:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Sum, AggregateKey>(chunk_id, column_index,
-                                                                                       *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Avg:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Avg, AggregateKey>(chunk_id, column_index,
-                                                                                       *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Count:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Count, AggregateKey>(chunk_id, column_index,
-                                                                                         *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::CountDistinct:
-              _aggregate_segment<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>(
-                  chunk_id, column_index, *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::StandardDeviationSample:
-              _aggregate_segment<ColumnDataType, AggregateFunction::StandardDeviationSample, AggregateKey>(
-                  chunk_id, column_index, *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Any:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Any, AggregateKey>(chunk_id, column_index,
-                                                                                       *base_segment, keys_per_chunk);
-          }
-        });
+        const auto lock = std::lock_guard<std::mutex>{group_key_ids->mutex};
+        write_aggregate_key_entries<ColumnDataType, AggregateKey>(
+            *input_table, column_id, group_column_index, keys_per_chunk, [&](const ColumnDataType& value) {
+              const auto inserted = group_key_ids->ids.try_emplace(value, group_key_ids->id_counter);
+              if (inserted.second) ++group_key_ids->id_counter;
+              return inserted.first->second;
+            });
+      }
+    });
+  }
+
+  _pre_aggregate_chunks<AggregateKey>(ChunkID{0}, chunk_count, keys_per_chunk,
+                                      pre_aggregation.partial_tables_per_morsel[morsel_id]);
+  pre_aggregation.chunk_count_per_morsel[morsel_id] = chunk_count;
+}
+
+template <typename AggregateKey>
+void AggregateHash::_merge_morsel_pre_aggregation() {
+  auto& pre_aggregation = static_cast<MorselPreAggregationImpl&>(*_morsel_pre_aggregation);
+
+  // The RowIDs of the partial results point into the morsel outputs. In the input table, the chunks of each morsel
+  // output follow those of the previous morsels.
+  auto partial_tables = std::vector<std::vector<std::shared_ptr<SegmentVisitorContext>>>{};
+  auto morsel_begin_chunk_id = ChunkID{0};
+  const auto morsel_count = pre_aggregation.partial_tables_per_morsel.size();
+  for (auto morsel_id = size_t{0}; morsel_id < morsel_count; ++morsel_id) {
+    for (auto& partial_table : pre_aggregation.partial_tables_per_morsel[morsel_id]) {
+      for (ColumnID column_index{0}; column_index < partial_table.size(); ++column_index) {
+        _resolve_aggregate_context<AggregateKey>(
+            column_index, *partial_table[column_index], [&](auto& context, const auto function) {
+              for (auto& result : context.results) {
+                result.row_id.chunk_id = ChunkID{result.row_id.chunk_id + morsel_begin_chunk_id};
+              }
+            });
+      }
+      partial_tables.emplace_back(std::move(partial_table));
+    }
+    morsel_begin_chunk_id = ChunkID{morsel_begin_chunk_id + pre_aggregation.chunk_count_per_morsel[morsel_id]};
+  }
+  Assert(morsel_begin_chunk_id == input_table_left()->chunk_count(), "Input table does not match the morsel outputs");
+
+  _morsel_pre_aggregation.reset();
+  _merge_partial_tables<AggregateKey>(partial_tables);
+}
+
+template <typename AggregateKey>
+void AggregateHash::_aggregate_chunk(ChunkID chunk_id, const KeysPerChunk<AggregateKey>& keys_per_chunk,
+                                     std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts) const {
+  const auto& input_table = input_table_left();
+  const auto chunk_in = input_table->get_chunk(chunk_id);
+
+  const auto& hash_keys = keys_per_chunk[chunk_id];
+
+  // Sometimes, gcc is really bad at accessing loop conditions only once, so we cache that here.
+  const auto input_chunk_size = chunk_in->size();
+
+  if (_aggregates.empty()) {
+    /**
+     * DISTINCT implementation
+     *
+     * In Opossum we handle the SQL keyword DISTINCT by grouping without aggregation.
+     *
+     * For a query like "SELECT DISTINCT * FROM A;"
+     * we would assume that all columns from A are part of 'groupby_columns',
+     * respectively any columns that were specified in the projection.
+     * The optimizer is responsible to take care of passing in the correct columns.
+     *
+     * How does this operation work?
+     * Distinct rows are retrieved by grouping by vectors of values. Similar as for the usual aggregation
+     * these vectors are used as keys in the 'column_results' map.
+     *
+     * At this point we've got all the different keys from the chunks and accumulate them in 'column_results'.
+     * In order to reuse the aggregation implementation, we add a dummy AggregateResult.
+     * One could optimize here in the future.
+     *
+     * Obviously this implementation is also used for plain GroupBy's.
+     */
+
+    auto context = std::static_pointer_cast<AggregateContext<DistinctColumnType, DistinctAggregateType, AggregateKey>>(
+        contexts[0]);
+
+    auto& result_ids = *context->result_ids;
+    auto& results = context->results;
+
+    for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
+      // Make sure the value or combination of values is added to the list of distinct value(s)
+      get_or_add_result_id(result_ids, results, hash_keys[chunk_offset], RowID{chunk_id, chunk_offset});
+    }
+  } else {
+    ColumnID column_index{0};
+    for (const auto& aggregate : _aggregates) {
+      /**
+       * Special COUNT(*) implementation.
+       * Because COUNT(*) does not have a specific target column, we use the maximum ColumnID.
+       * We then go through the keys_per_chunk map and count the occurrences of each group key.
+       * The results are saved in the regular aggregate_count variable so that we don't need a
+       * specific output logic for COUNT(*).
+       */
+      if (aggregate.column == INVALID_COLUMN_ID) {
+        Assert(aggregate.function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
+        auto context = std::static_pointer_cast<AggregateContext<CountColumnType, CountAggregateType, AggregateKey>>(
+            contexts[column_index]);
+
+        auto& result_ids = *context->result_ids;
+        auto& results = context->results;
+
+        // count occurrences for each group key
+        for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
+          const auto result_id =
+              get_or_add_result_id(result_ids, results, hash_keys[chunk_offset], RowID{chunk_id, chunk_offset});
+          ++results[result_id].aggregate_count;
+        }
 
         ++column_index;
+        continue;
       }
+
+      auto base_segment = chunk_in->get_segment(aggregate.column);
+      auto data_type = input_table->column_data_type(aggregate.column);
+
+      /*
+      Invoke correct aggregator for each segment
+      */
+
+      resolve_data_type(data_type, [&, aggregate](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+
+        switch (aggregate.function) {
+          case AggregateFunction::Min:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Min, AggregateKey>(
+                chunk_id, *base_segment, keys_per_chunk, *contexts[column_index]);
+            break;
+          case AggregateFunction::Max:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Max, AggregateKey>(
+                chunk_id, *base_segment, keys_per_chunk, *contexts[column_index]);
+            break;
+          case AggregateFunction::Sum:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Sum, AggregateKey>(
+                chunk_id, *base_segment, keys_per_chunk, *contexts[column_index]);
+            break;
+          case AggregateFunction::Avg:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Avg, AggregateKey>(
+                chunk_id, *base_segment, keys_per_chunk, *contexts[column_index]);
+            break;
+          case AggregateFunction::Count:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Count, AggregateKey>(
+                chunk_id, *base_segment, keys_per_chunk, *contexts[column_index]);
+            break;
+          case AggregateFunction::CountDistinct:
+            _aggregate_segment<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>(
+                chunk_id, *base_segment, keys_per_chunk, *contexts[column_index]);
+            break;
+          case AggregateFunction::StandardDeviationSample:
+            _aggregate_segment<ColumnDataType, AggregateFunction::StandardDeviationSample, AggregateKey>(
+                chunk_id, *base_segment, keys_per_chunk, *contexts[column_index]);
+            break;
+          case AggregateFunction::Any:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Any, AggregateKey>(
+                chunk_id, *base_segment, keys_per_chunk, *contexts[column_index]);
+        }
+      });
+
+      ++column_index;
     }
   }
 }
@@ -560,9 +1038,10 @@ write_aggregate_values(std::shared_ptr<ValueSegment<AggregateType>> segment,
   }
 }
 
-// COUNT writes the aggregate counter
+// COUNT and COUNT(DISTINCT) write the aggregate counter, which holds the number of distinct values for the latter
 template <typename ColumnDataType, typename AggregateType, AggregateFunction func>
-std::enable_if_t<func == AggregateFunction::Count, void> write_aggregate_values(
+std::enable_if_t<func == AggregateFunction::Count || func == AggregateFunction::CountDistinct, void>
+write_aggregate_values(
     std::shared_ptr<ValueSegment<AggregateType>> segment,
     const AggregateResults<ColumnDataType, AggregateType>& results) {
   DebugAssert(!segment->is_nullable(), "Aggregate: Output segment for COUNT shouldn't be nullable");
@@ -577,23 +1056,6 @@ std::enable_if_t<func == AggregateFunction::Count, void> write_aggregate_values(
   }
 }
 
-// COUNT(DISTINCT) writes the number of distinct values
-template <typename ColumnDataType, typename AggregateType, AggregateFunction func>
-std::enable_if_t<func == AggregateFunction::CountDistinct, void> write_aggregate_values(
-    std::shared_ptr<ValueSegment<AggregateType>> segment,
-    const AggregateResults<ColumnDataType, AggregateType>& results) {
-  DebugAssert(!segment->is_nullable(), "Aggregate: Output segment for COUNT shouldn't be nullable");
-
-  auto& values = segment->values();
-  values.resize(results.size());
-
-  size_t i = 0;
-  for (const auto& result : results) {
-    values[i] = result.distinct_values.size();
-    ++i;
-  }
-}
-
 // AVG writes the calculated average from current aggregate and the aggregate counter
 template <typename ColumnDataType, typename AggregateType, AggregateFunction func>
 std::enable_if_t<func == AggregateFunction::Avg && std::is_arithmetic_v<AggregateType>, void> write_aggregate_values(
@@ -853,4 +1315,98 @@ std::shared_ptr<SegmentVisitorContext> AggregateHash::_create_aggregate_context(
   return context;
 }
 
+template <typename AggregateKey>
+std::vector<std::shared_ptr<SegmentVisitorContext>> AggregateHash::_create_aggregate_contexts() const {
+  const auto& input_table = input_table_left();
+
+  if (_aggregates.empty()) {
+    /*
+    Insert a dummy context for the DISTINCT implementation.
+    That way, the contexts will always have at least one context with results.
+    This is important later on when we write the group keys into the table.
+
+    We choose int8_t for column type and aggregate type because it's small.
+    */
+    return {std::make_shared<AggregateContext<DistinctColumnType, DistinctAggregateType, AggregateKey>>()};
+  }
+
+  auto contexts = std::vector<std::shared_ptr<SegmentVisitorContext>>(_aggregates.size());
+  for (ColumnID column_id{0}; column_id < _aggregates.size(); ++column_id) {
+    const auto& aggregate = _aggregates[column_id];
+    if (aggregate.column == INVALID_COLUMN_ID) {
+      Assert(aggregate.function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
+      // SELECT COUNT(*) - we know the template arguments, so we don't need a visitor
+      contexts[column_id] = std::make_shared<AggregateContext<CountColumnType, CountAggregateType, AggregateKey>>();
+      continue;
+    }
+    auto data_type = input_table->column_data_type(aggregate.column);
+    contexts[column_id] = _create_aggregate_context<AggregateKey>(data_type, aggregate.function);
+  }
+  return contexts;
+}
+
+template <typename AggregateKey, typename Functor>
+void AggregateHash::_resolve_aggregate_context(const ColumnID column_index, SegmentVisitorContext& context,
+                                               const Functor& functor) const {
+  using CountFunction = std::integral_constant<AggregateFunction, AggregateFunction::Count>;
+
+  if (_aggregates.empty()) {
+    functor(static_cast<AggregateContext<DistinctColumnType, DistinctAggregateType, AggregateKey>&>(context),
+            CountFunction{});
+    return;
+  }
+
+  const auto& aggregate = _aggregates[column_index];
+  if (aggregate.column == INVALID_COLUMN_ID) {
+    functor(static_cast<AggregateContext<CountColumnType, CountAggregateType, AggregateKey>&>(context),
+            CountFunction{});
+    return;
+  }
+
+  resolve_data_type(input_table_left()->column_data_type(aggregate.column), [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    const auto call_functor = [&](const auto function) {
+      using AggregateType = typename AggregateTraits<ColumnDataType, decltype(function)::value>::AggregateType;
+      functor(static_cast<AggregateContext<ColumnDataType, AggregateType, AggregateKey>&>(context), function);
+    };
+
+    switch (aggregate.function) {
+      case AggregateFunction::Min:
+        call_functor(std::integral_constant<AggregateFunction, AggregateFunction::Min>{});
+        break;
+      case AggregateFunction::Max:
+        call_functor(std::integral_constant<AggregateFunction, AggregateFunction::Max>{});
+        break;
+      case AggregateFunction::Sum:
+        call_functor(std::integral_constant<AggregateFunction, AggregateFunction::Sum>{});
+        break;
+      case AggregateFunction::Avg:
+        call_functor(std::integral_constant<AggregateFunction, AggregateFunction::Avg>{});
+        break;
+      case AggregateFunction::Count:
+        call_functor(std::integral_constant<AggregateFunction, AggregateFunction::Count>{});
+        break;
+      case AggregateFunction::CountDistinct:
+        call_functor(std::integral_constant<AggregateFunction, AggregateFunction::CountDistinct>{});
+        break;
+      case AggregateFunction::StandardDeviationSample:
+        call_functor(std::integral_constant<AggregateFunction, AggregateFunction::StandardDeviationSample>{});
+        break;
+      case AggregateFunction::Any:
+        call_functor(std::integral_constant<AggregateFunction, AggregateFunction::Any>{});
+        break;
+    }
+  });
+}
+
+template <typename AggregateKey>
+size_t AggregateHash::_group_count(const std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts) const {
+  auto group_count = size_t{0};
+  _resolve_aggregate_context<AggregateKey>(ColumnID{0}, *contexts[0], [&](auto& context, const auto function) {
+    group_count = context.results.size();
+  });
+  return group_count;
+}
+
 }  // namespace opossum
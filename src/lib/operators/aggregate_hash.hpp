@@ -4,7 +4,6 @@
 #include <limits>
 #include <memory>
 #include <optional>
-#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -38,6 +37,12 @@ Operator to aggregate columns by certain functions, such as min, max, sum, avera
  i.e. your sorting order.
 
 For implementation details, please check the wiki: https://github.com/hyrise/hyrise/wiki/Operators_Aggregate
+
+Large inputs are aggregated in two phases (see _aggregate_partitioned()) so that high-cardinality GROUP BYs are not
+bound to a single thread. First, each job pre-aggregates a range of chunks into a job-local table (i.e., a set of
+AggregateContexts). Second, the groups of all local tables are radix-partitioned by the hash of their AggregateKey
+and each partition is merged by a separate job. As a partition contains all partial results of its groups, the merged
+partitions are disjoint and can simply be concatenated.
 */
 
 /*
@@ -47,7 +52,7 @@ This result contains:
 [2] the number of rows that were used,
 [3] a vector for additional current (secondary) aggregated values.
 
-[2] is used for AVG and COUNT.
+[2] is used for AVG, COUNT, and COUNT(DISTINCT). For the latter, it holds the number of distinct values.
 [3] is used for STDDEV_SAMP.
 
 */
@@ -56,7 +61,6 @@ struct AggregateResult {
   std::optional<AggregateType> current_primary_aggregate;
   std::vector<AggregateType> current_secondary_aggregates;
   size_t aggregate_count = 0;
-  std::set<ColumnDataType> distinct_values;
   RowID row_id;
 };
 
@@ -74,6 +78,26 @@ using AggregateResultIdMap =
     ska::bytell_hash_map<AggregateKey, AggregateResultId, std::hash<AggregateKey>, std::equal_to<AggregateKey>,
                          AggregateResultIdMapAllocator<AggregateKey>>;
 
+/*
+For COUNT(DISTINCT), the values of all groups are deduplicated in a single flat hash set of (AggregateResultId, value)
+pairs instead of one std::set per group. This avoids a node allocation per distinct value and the pointer chasing of
+tree lookups.
+*/
+template <typename ColumnDataType>
+using DistinctValue = std::pair<AggregateResultId, ColumnDataType>;
+
+template <typename ColumnDataType>
+struct DistinctValueHash {
+  size_t operator()(const DistinctValue<ColumnDataType>& distinct_value) const {
+    auto hash = std::hash<ColumnDataType>{}(distinct_value.second);
+    boost::hash_combine(hash, distinct_value.first);
+    return hash;
+  }
+};
+
+template <typename ColumnDataType>
+using DistinctValueSet = ska::bytell_hash_set<DistinctValue<ColumnDataType>, DistinctValueHash<ColumnDataType>>;
+
 /*
 The key type that is used for the aggregation map.
 */
@@ -95,11 +119,46 @@ using DistinctAggregateType = int8_t;
 
 class AggregateHash : public AbstractAggregateOperator {
  public:
+  // Inputs are aggregated in two phases if they can be split into multiple ranges of chunks with at least this many
+  // rows. With the default chunk size, every chunk is pre-aggregated by its own job.
+  static constexpr auto PRE_AGGREGATION_ROWS_PER_JOB = size_t{1} << 16;
+
+  // If the number of groups in a job-local table exceeds this value after a chunk has been aggregated, the table is
+  // handed over to the merge phase and the job continues with a new one. For high-cardinality GROUP BYs, where
+  // pre-aggregation does not reduce the data, this keeps the local tables small and cache-friendly instead of building
+  // a copy of the final hash table per job.
+  static constexpr auto PRE_AGGREGATION_MAX_GROUPS = size_t{1} << 14;
+
+  // The number of radix partitions for the merge phase is chosen so that each partition holds roughly this many
+  // partial groups.
+  static constexpr auto MERGE_GROUPS_PER_PARTITION = size_t{1} << 14;
+
   AggregateHash(const std::shared_ptr<AbstractOperator>& in, const std::vector<AggregateColumnDefinition>& aggregates,
                 const std::vector<ColumnID>& groupby_column_ids);
 
   const std::string& name() const override;
 
+  /**
+   * Partial results of a MorselPipeline that ends with an AggregateHash (see there). Instead of materializing the
+   * output of all morsels first, each morsel output is pre-aggregated as soon as it has been produced, i.e., while it
+   * is likely to be in the cache. Once all morsels are done, the AggregateHash is executed on the concatenated morsel
+   * outputs and only merges the partial results (see _merge_partial_tables()).
+   */
+  class MorselPreAggregation {
+   public:
+    virtual ~MorselPreAggregation() = default;
+  };
+
+  std::shared_ptr<MorselPreAggregation> create_morsel_pre_aggregation(const size_t morsel_count) const;
+
+  // Pre-aggregates the input table, which is the output of the morsel @param morsel_id, instead of executing this
+  // operator. Different morsels can be pre-aggregated concurrently.
+  void pre_aggregate_morsel(MorselPreAggregation& morsel_pre_aggregation, const size_t morsel_id) const;
+
+  // The next execution merges the partial results of @param morsel_pre_aggregation instead of aggregating the input
+  // table, which has to consist of the chunks of all morsel outputs in the order of the morsels.
+  void set_morsel_pre_aggregation(const std::shared_ptr<MorselPreAggregation>& morsel_pre_aggregation);
+
   // write the aggregated output for a given aggregate column
   template <typename ColumnDataType, AggregateFunction function>
   void write_aggregate_output(ColumnID column_index);
@@ -110,6 +169,31 @@ class AggregateHash : public AbstractAggregateOperator {
   template <typename AggregateKey>
   void _aggregate();
 
+  template <typename AggregateKey>
+  void _aggregate_partitioned(const KeysPerChunk<AggregateKey>& keys_per_chunk,
+                              const std::vector<std::pair<ChunkID, ChunkID>>& job_chunk_ranges);
+
+  // Aggregates the chunks [@param begin_chunk_id, @param end_chunk_id) into partial tables (i.e., sets of contexts)
+  // of at most PRE_AGGREGATION_MAX_GROUPS groups, which are appended to @param partial_tables
+  template <typename AggregateKey>
+  void _pre_aggregate_chunks(const ChunkID begin_chunk_id, const ChunkID end_chunk_id,
+                             const KeysPerChunk<AggregateKey>& keys_per_chunk,
+                             std::vector<std::vector<std::shared_ptr<SegmentVisitorContext>>>& partial_tables) const;
+
+  // Merges the groups of @param partial_tables into _contexts_per_column
+  template <typename AggregateKey>
+  void _merge_partial_tables(std::vector<std::vector<std::shared_ptr<SegmentVisitorContext>>>& partial_tables);
+
+  template <typename AggregateKey>
+  void _pre_aggregate_morsel(MorselPreAggregation& morsel_pre_aggregation, const size_t morsel_id) const;
+
+  template <typename AggregateKey>
+  void _merge_morsel_pre_aggregation();
+
+  template <typename AggregateKey>
+  void _aggregate_chunk(ChunkID chunk_id, const KeysPerChunk<AggregateKey>& keys_per_chunk,
+                        std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts) const;
+
   std::shared_ptr<AbstractOperator> _on_deep_copy(
       const std::shared_ptr<AbstractOperator>& copied_input_left,
       const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
@@ -125,15 +209,29 @@ class AggregateHash : public AbstractAggregateOperator {
   void _write_groupby_output(PosList& pos_list);
 
   template <typename ColumnDataType, AggregateFunction function, typename AggregateKey>
-  void _aggregate_segment(ChunkID chunk_id, ColumnID column_index, const BaseSegment& base_segment,
-                          const KeysPerChunk<AggregateKey>& keys_per_chunk);
+  void _aggregate_segment(ChunkID chunk_id, const BaseSegment& base_segment,
+                          const KeysPerChunk<AggregateKey>& keys_per_chunk, SegmentVisitorContext& base_context) const;
 
   template <typename AggregateKey>
   std::shared_ptr<SegmentVisitorContext> _create_aggregate_context(const DataType data_type,
                                                                    const AggregateFunction function) const;
 
+  // Creates one context per aggregate (or the dummy context used for DISTINCT if there are no aggregates)
+  template <typename AggregateKey>
+  std::vector<std::shared_ptr<SegmentVisitorContext>> _create_aggregate_contexts() const;
+
+  // Casts the context of the given aggregate to its actual AggregateContext type and passes it to the functor, together
+  // with the aggregate function as an std::integral_constant. The contexts for COUNT(*) and for the DISTINCT dummy are
+  // passed with AggregateFunction::Count.
+  template <typename AggregateKey, typename Functor>
+  void _resolve_aggregate_context(ColumnID column_index, SegmentVisitorContext& context, const Functor& functor) const;
+
+  template <typename AggregateKey>
+  size_t _group_count(const std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts) const;
+
   std::vector<std::shared_ptr<BaseValueSegment>> _groupby_segments;
   std::vector<std::shared_ptr<SegmentVisitorContext>> _contexts_per_column;
+  std::shared_ptr<MorselPreAggregation> _morsel_pre_aggregation;
 };
 
 }  // namespace opossum
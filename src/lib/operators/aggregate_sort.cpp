@@ -361,12 +361,19 @@ std::shared_ptr<const Table> AggregateSort::_on_execute() {
    * However, we did not benchmark it, so we cannot prove it.
    */
 
-  // Sort input table consecutively by the group by columns (stable sort)
+  // Sort input table by all group by columns at once. The last group by column is the primary sort column, which
+  // results in the same order as sorting consecutively by the group by columns.
   auto sorted_table = input_table;
-  for (const auto& column_id : _groupby_column_ids) {
-    const auto sorted_wrapper = std::make_shared<TableWrapper>(sorted_table);
+  if (!_groupby_column_ids.empty()) {
+    auto sort_definitions = std::vector<SortColumnDefinition>{};
+    for (auto groupby_column_it = _groupby_column_ids.rbegin(); groupby_column_it != _groupby_column_ids.rend();
+         ++groupby_column_it) {
+      sort_definitions.emplace_back(*groupby_column_it);
+    }
+
+    const auto sorted_wrapper = std::make_shared<TableWrapper>(input_table);
     sorted_wrapper->execute();
-    Sort sort = Sort(sorted_wrapper, column_id);
+    Sort sort = Sort(sorted_wrapper, sort_definitions);
     sort.execute();
     sorted_table = sort.get_output();
   }
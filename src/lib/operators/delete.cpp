@@ -1,11 +1,17 @@
 #include "delete.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "concurrency/redo_log.hpp"
 #include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
 #include "operators/validate.hpp"
 #include "statistics/table_statistics.hpp"
+#include "statistics/update_table_statistics.hpp"
 #include "storage/reference_segment.hpp"
 #include "utils/assert.hpp"
 
@@ -87,12 +93,16 @@ std::shared_ptr<const Table> Delete::_on_execute(std::shared_ptr<TransactionCont
 }
 
 void Delete::_on_commit_records(const CommitID commit_id) {
+  // The number of invalidated rows per referenced table
+  auto referenced_tables = std::unordered_map<std::shared_ptr<const Table>, uint64_t>{};
+
   for (ChunkID referencing_chunk_id{0}; referencing_chunk_id < _referencing_table->chunk_count();
        ++referencing_chunk_id) {
     const auto referencing_chunk = _referencing_table->get_chunk(referencing_chunk_id);
     const auto referencing_segment =
         std::static_pointer_cast<const ReferenceSegment>(referencing_chunk->get_segment(ColumnID{0}));
     const auto referenced_table = referencing_segment->referenced_table();
+    referenced_tables[referenced_table] += referencing_segment->pos_list()->size();
 
     for (const auto& row_id : *referencing_segment->pos_list()) {
       const auto referenced_chunk = referenced_table->get_chunk(row_id.chunk_id);
@@ -102,6 +112,16 @@ void Delete::_on_commit_records(const CommitID commit_id) {
       // We do not unlock the rows so subsequent transactions properly fail when attempting to update these rows.
     }
   }
+
+  // Account for the invalidated rows in the statistics once enough rows have been invalidated. The statistics are only
+  // maintained for tables in the StorageManager.
+  auto& storage_manager = Hyrise::get().storage_manager;
+  for (const auto& [referenced_table, invalidated_row_count] : referenced_tables) {
+    const auto table_name = storage_manager.find_table_name(*referenced_table);
+    if (!table_name) continue;
+
+    schedule_table_statistics_update(storage_manager.get_table(*table_name), invalidated_row_count);
+  }
 }
 
 void Delete::_on_rollback_records() {
@@ -130,6 +150,23 @@ void Delete::_on_rollback_records() {
   }
 }
 
+void Delete::_on_log_records(RedoLogRecord& record) const {
+  for (ChunkID referencing_chunk_id{0}; referencing_chunk_id < _referencing_table->chunk_count();
+       ++referencing_chunk_id) {
+    const auto referencing_chunk = _referencing_table->get_chunk(referencing_chunk_id);
+    const auto referencing_segment =
+        std::static_pointer_cast<const ReferenceSegment>(referencing_chunk->get_segment(ColumnID{0}));
+    const auto referenced_table = referencing_segment->referenced_table();
+
+    // The log identifies tables by their name, which we only know from the StorageManager
+    const auto table_name = Hyrise::get().storage_manager.find_table_name(*referenced_table);
+    Assert(table_name, "Delete can only log rows of tables in the StorageManager");
+
+    const auto& pos_list = *referencing_segment->pos_list();
+    record.add_delete(*table_name, std::vector<RowID>(pos_list.begin(), pos_list.end()));
+  }
+}
+
 std::shared_ptr<AbstractOperator> Delete::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <memory>
-#include <sstream>
 #include <string>
 #include <vector>
 
@@ -12,7 +11,9 @@
 namespace opossum {
 
 /**
- * Note: Difference does not support null values at the moment
+ * Emits all rows of the left input that are not contained in the right input. Unlike EXCEPT (see SetOperationHash),
+ * duplicates of the left input are kept. Rows are compared with their typed values, NULLs are not distinct from each
+ * other.
  */
 class Difference : public AbstractReadOnlyOperator {
  public:
@@ -27,8 +28,5 @@ class Difference : public AbstractReadOnlyOperator {
       const std::shared_ptr<AbstractOperator>& copied_input_left,
       const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
-
- private:
-  static void _append_string_representation(std::ostream& row_string_buffer, const AllTypeVariant& value);
 };
 }  // namespace opossum
@@ -9,6 +9,7 @@
 
 #include "hyrise.hpp"
 #include "types.hpp"
+#include "utils/column_ids_after_pruning.hpp"
 
 namespace opossum {
 
@@ -219,8 +220,33 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
     ++output_chunks_iter;
   }
 
-  return std::make_shared<Table>(pruned_column_definitions, TableType::Data, std::move(output_chunks),
-                                 stored_table->uses_mvcc());
+  const auto output_table = std::make_shared<Table>(pruned_column_definitions, TableType::Data,
+                                                    std::move(output_chunks), stored_table->uses_mvcc());
+
+  /**
+   * Pass on the TableIndexes of the stored table. They contain RowIDs of the stored table, which are only valid for the
+   * output table if its chunks have the same ChunkIDs, i.e., if chunks were excluded only at the end of the table.
+   */
+  const auto excluded_chunks_are_suffix =
+      excluded_chunk_ids.empty() ||
+      static_cast<size_t>(excluded_chunk_ids.front()) == static_cast<size_t>(chunk_count) - excluded_chunk_ids.size();
+  if (excluded_chunks_are_suffix && !stored_table->table_indexes().empty()) {
+    const auto output_column_ids = column_ids_after_pruning(stored_table->column_count(), _pruned_column_ids);
+
+    for (const auto& [stored_column_ids, table_index] : stored_table->table_indexes()) {
+      auto indexed_column_ids = std::vector<ColumnID>{};
+      for (const auto stored_column_id : stored_column_ids) {
+        if (!output_column_ids[stored_column_id]) break;
+        indexed_column_ids.emplace_back(*output_column_ids[stored_column_id]);
+      }
+
+      if (indexed_column_ids.size() == stored_column_ids.size()) {
+        output_table->add_table_index(indexed_column_ids, table_index);
+      }
+    }
+  }
+
+  return output_table;
 }
 
 }  // namespace opossum
@@ -3,13 +3,19 @@
 #include <algorithm>
 
 #include "expression/between_expression.hpp"
+#include "expression/binary_predicate_expression.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "expression/value_expression.hpp"
 
 #include "hyrise.hpp"
 
+#include "operators/table_scan.hpp"
+
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
 
 #include "storage/index/abstract_index.hpp"
+#include "storage/index/table_index.hpp"
 #include "storage/reference_segment.hpp"
 
 #include "utils/assert.hpp"
@@ -38,9 +44,23 @@ std::shared_ptr<const Table> IndexScan::_on_execute() {
 
   _out_table = std::make_shared<Table>(_in_table->column_definitions(), TableType::References);
 
+  if (const auto table_index = _in_table->get_table_index(_left_column_ids)) {
+    _scan_table_index(*table_index);
+    return _out_table;
+  }
+
   std::mutex output_mutex;
 
   auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  auto unindexed_chunk_ids = std::vector<ChunkID>{};
+  const auto schedule_chunk = [&](const ChunkID chunk_id, const auto& chunk) {
+    if (chunk->get_index(_index_type, _left_column_ids)) {
+      jobs.push_back(_create_job_and_schedule(chunk_id, output_mutex));
+    } else {
+      unindexed_chunk_ids.emplace_back(chunk_id);
+    }
+  };
+
   if (included_chunk_ids.empty()) {
     jobs.reserve(_in_table->chunk_count());
     const auto chunk_count = _in_table->chunk_count();
@@ -48,19 +68,23 @@ std::shared_ptr<const Table> IndexScan::_on_execute() {
       const auto chunk = _in_table->get_chunk(chunk_id);
       Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
-      jobs.push_back(_create_job_and_schedule(chunk_id, output_mutex));
+      schedule_chunk(chunk_id, chunk);
     }
   } else {
     jobs.reserve(included_chunk_ids.size());
     for (auto chunk_id : included_chunk_ids) {
-      if (_in_table->get_chunk(chunk_id)) {
-        jobs.push_back(_create_job_and_schedule(chunk_id, output_mutex));
+      if (const auto chunk = _in_table->get_chunk(chunk_id)) {
+        schedule_chunk(chunk_id, chunk);
       }
     }
   }
 
   Hyrise::get().scheduler()->wait_for_tasks(jobs);
 
+  if (!unindexed_chunk_ids.empty()) {
+    _scan_unindexed_chunks(unindexed_chunk_ids);
+  }
+
   return _out_table;
 }
 
@@ -98,6 +122,7 @@ std::shared_ptr<AbstractTask> IndexScan::_create_job_and_schedule(const ChunkID
 }
 
 void IndexScan::_validate_input() {
+  Assert(_index_type != SegmentIndexType::Invalid, "Invalid index type.");
   Assert(_predicate_condition != PredicateCondition::Like, "Predicate condition not supported by index scan.");
   Assert(_predicate_condition != PredicateCondition::NotLike, "Predicate condition not supported by index scan.");
 
@@ -111,6 +136,84 @@ void IndexScan::_validate_input() {
   Assert(_in_table->type() == TableType::Data, "IndexScan only supports persistent tables right now.");
 }
 
+void IndexScan::_scan_table_index(const TableIndex& table_index) {
+  auto matches = table_index.lookup(_predicate_condition, _right_values, _right_values2);
+
+  // Output one chunk per input chunk with matches, as the chunk-wise scan does
+  std::sort(matches.begin(), matches.end());
+
+  const auto chunk_count = _in_table->chunk_count();
+  auto chunk_matches_begin = matches.cbegin();
+  while (chunk_matches_begin != matches.cend()) {
+    const auto chunk_id = chunk_matches_begin->chunk_id;
+    const auto chunk_matches_end = std::find_if(chunk_matches_begin, matches.cend(),
+                                                [&](const auto& row_id) { return row_id.chunk_id != chunk_id; });
+
+    // The index also contains the rows of chunks that were added to the stored table after the input was created
+    if (chunk_id >= chunk_count) break;
+
+    const auto chunk = _in_table->get_chunk(chunk_id);
+    const auto chunk_is_included =
+        included_chunk_ids.empty() ||
+        std::find(included_chunk_ids.cbegin(), included_chunk_ids.cend(), chunk_id) != included_chunk_ids.cend();
+
+    if (chunk && chunk_is_included) {
+      const auto matches_out = std::make_shared<PosList>(chunk_matches_begin, chunk_matches_end);
+      matches_out->guarantee_single_chunk();
+
+      Segments segments;
+      for (ColumnID column_id{0u}; column_id < _in_table->column_count(); ++column_id) {
+        segments.push_back(std::make_shared<ReferenceSegment>(_in_table, column_id, matches_out));
+      }
+      _out_table->append_chunk(segments, nullptr, chunk->get_allocator());
+    }
+
+    chunk_matches_begin = chunk_matches_end;
+  }
+}
+
+void IndexScan::_scan_unindexed_chunks(std::vector<ChunkID> chunk_ids) {
+  Assert(_left_column_ids.size() == 1, "Chunks without an index can only be scanned for single-column predicates");
+
+  const auto column = PQPColumnExpression::from_table(*_in_table, _left_column_ids[0]);
+  const auto value = std::make_shared<ValueExpression>(_right_values[0]);
+  auto predicate = std::shared_ptr<AbstractExpression>{};
+  if (is_between_predicate_condition(_predicate_condition)) {
+    const auto value2 = std::make_shared<ValueExpression>(_right_values2[0]);
+    predicate = std::make_shared<BetweenExpression>(_predicate_condition, column, value, value2);
+  } else {
+    predicate = std::make_shared<BinaryPredicateExpression>(_predicate_condition, column, value);
+  }
+
+  const auto table_scan = std::make_shared<TableScan>(input_left(), predicate);
+
+  std::sort(chunk_ids.begin(), chunk_ids.end());
+  const auto chunk_count = _in_table->chunk_count();
+  auto chunk_ids_iter = chunk_ids.cbegin();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (chunk_ids_iter != chunk_ids.cend() && *chunk_ids_iter == chunk_id) {
+      ++chunk_ids_iter;
+    } else {
+      table_scan->excluded_chunk_ids.emplace_back(chunk_id);
+    }
+  }
+
+  table_scan->execute();
+
+  // The TableScan references the same input table, so that its output chunks can be appended as they are
+  const auto& scan_output = table_scan->get_output();
+  const auto scan_chunk_count = scan_output->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < scan_chunk_count; ++chunk_id) {
+    const auto chunk = scan_output->get_chunk(chunk_id);
+
+    Segments segments;
+    for (ColumnID column_id{0u}; column_id < chunk->column_count(); ++column_id) {
+      segments.push_back(chunk->get_segment(column_id));
+    }
+    _out_table->append_chunk(segments, nullptr, chunk->get_allocator());
+  }
+}
+
 PosList IndexScan::_scan_chunk(const ChunkID chunk_id) {
   const auto to_row_id = [chunk_id](ChunkOffset chunk_offset) { return RowID{chunk_id, chunk_offset}; };
 
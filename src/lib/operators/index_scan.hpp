@@ -12,11 +12,17 @@
 namespace opossum {
 
 class Table;
+class TableIndex;
 class AbstractTask;
 
 /**
  * Operator that performs a predicate search using indexes
  *
+ * If the input table has a TableIndex on the scanned columns, the matches of all chunks are found with a single lookup
+ * in that index. Otherwise, the chunk-local indexes of type index_type are searched chunk by chunk. Chunks without such
+ * an index are scanned by a TableScan. This happens if the optimizer chose the IndexScan because of a TableIndex, but
+ * GetTable could not pass it on, as chunks in the middle of the table were excluded.
+ *
  * Note: Scans only the set of chunks passed to the constructor
  */
 class IndexScan : public AbstractReadOnlyOperator {
@@ -41,6 +47,8 @@ class IndexScan : public AbstractReadOnlyOperator {
   void _validate_input();
   std::shared_ptr<AbstractTask> _create_job_and_schedule(const ChunkID chunk_id, std::mutex& output_mutex);
   PosList _scan_chunk(const ChunkID chunk_id);
+  void _scan_table_index(const TableIndex& table_index);
+  void _scan_unindexed_chunks(std::vector<ChunkID> chunk_ids);
 
  private:
   const SegmentIndexType _index_type;
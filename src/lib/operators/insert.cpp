@@ -5,9 +5,11 @@
 #include <string>
 #include <vector>
 
+#include "concurrency/redo_log.hpp"
 #include "concurrency/transaction_context.hpp"
 #include "hyrise.hpp"
 #include "resolve_type.hpp"
+#include "statistics/update_table_statistics.hpp"
 #include "storage/base_encoded_segment.hpp"
 #include "storage/segment_iterate.hpp"
 #include "storage/value_segment.hpp"
@@ -93,74 +95,95 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
   }
 
   /**
-   * 1. Allocate the required rows in the target Table, without actually copying data to them.
-   *    Do so while locking the table to prevent multiple threads modifying the table's size simultaneously.
-   *    Since allocation is expected to be faster than writing to the memory, allocating under lock and then writing -
-   *    in a second step - without lock will minimize the time that the Table's append_mutex is locked.
+   * 1. Reserve and allocate the required rows in the target Table, without actually copying data to them.
+   *    Concurrent Inserts reserve rows in the last Chunk without a lock and allocate them in the order of their
+   *    reservations (see Chunk::reserve_rows()). Only if the last Chunk is full or immutable, the Table's append_mutex
+   *    is locked to append a new Chunk. The Chunk's segments grow with the allocated rows, the reservation only
+   *    advances the offsets.
    */
-  {
-    const auto append_lock = _target_table->acquire_append_mutex();
+  const auto max_chunk_size = _target_table->max_chunk_size();
+  auto remaining_rows = input_table_left()->row_count();
 
-    auto remaining_rows = input_table_left()->row_count();
+  while (remaining_rows > 0) {
+    const auto chunk_count = _target_table->chunk_count();
+    const auto target_chunk_id = chunk_count > 0 ? ChunkID{chunk_count - 1} : ChunkID{0};
 
-    if (_target_table->chunk_count() == 0) {
-      _target_table->append_mutable_chunk();
+    // The last entry might still be written by an Insert that appends a Chunk, in which case it is nullptr
+    const auto target_chunk = chunk_count > 0 ? _target_table->get_chunk(target_chunk_id) : nullptr;
+
+    // Check the segments before reserving rows: Once rows are reserved, later reservations wait for their allocation.
+    // If it fails, they have to move to a new Chunk (see Chunk::RowAllocationGuard).
+    if (target_chunk) {
+      for (ColumnID column_id{0}; column_id < target_chunk->column_count(); ++column_id) {
+        Assert(!target_chunk->is_mutable() ||
+                   std::dynamic_pointer_cast<BaseValueSegment>(target_chunk->get_segment(column_id)),
+               "Cannot insert into non-ValueColumns");
+      }
     }
-    while (remaining_rows > 0) {
-      auto target_chunk_id = ChunkID{_target_table->chunk_count() - 1};
-      auto target_chunk = _target_table->get_chunk(target_chunk_id);
 
-      // If the last Chunk of the target Table is either immutable or full, append a new mutable Chunk
-      if (!target_chunk->is_mutable() || target_chunk->size() == _target_table->max_chunk_size()) {
+    const auto reserved_rows =
+        target_chunk ? target_chunk->reserve_rows(
+                           static_cast<ChunkOffset>(std::min<uint64_t>(remaining_rows, max_chunk_size)), max_chunk_size)
+                     : std::pair{ChunkOffset{0}, ChunkOffset{0}};
+    const auto begin_chunk_offset = reserved_rows.first;
+    const auto end_chunk_offset = reserved_rows.second;
+
+    if (begin_chunk_offset == end_chunk_offset) {
+      // The last Chunk is full or immutable. Append a new mutable Chunk, unless another Insert did so in the meantime.
+      const auto append_lock = _target_table->acquire_append_mutex();
+      const auto current_chunk_count = _target_table->chunk_count();
+      if (current_chunk_count == 0 || _target_table->get_chunk(ChunkID{current_chunk_count - 1}) == target_chunk) {
         _target_table->append_mutable_chunk();
-        ++target_chunk_id;
-        target_chunk = _target_table->get_chunk(target_chunk_id);
       }
+      continue;
+    }
 
-      const auto num_rows_for_target_chunk =
-          std::min<size_t>(_target_table->max_chunk_size() - target_chunk->size(), remaining_rows);
-
-      _target_chunk_ranges.emplace_back(
-          ChunkRange{target_chunk_id, target_chunk->size(),
-                     static_cast<ChunkOffset>(target_chunk->size() + num_rows_for_target_chunk)});
+    const auto num_rows_for_target_chunk = static_cast<ChunkOffset>(end_chunk_offset - begin_chunk_offset);
 
-      // Grow MVCC vectors and mark new (but still empty) rows as being under modification by current transaction.
-      // Do so before resizing the Segments, because the resize of `Chunk::_segments.front()` is what releases the
-      // new row count.
-      {
-        auto mvcc_data = target_chunk->get_scoped_mvcc_data_lock();
-        mvcc_data->grow_by(num_rows_for_target_chunk, context->transaction_id(), MvccData::MAX_COMMIT_ID);
-      }
+    // If allocating the rows fails, the Inserts that reserved rows after them must not wait for them forever
+    auto allocation_guard = Chunk::RowAllocationGuard{*target_chunk, end_chunk_offset};
 
-      // Grow data Segments.
-      // Do so in REVERSE column order so that the resize of `Chunk::_segments.front()` happens last. It is this last
-      // resize that makes the new row count visible to the outside world.
-      auto old_size = target_chunk->size();
-      for (ColumnID reverse_column_id{0}; reverse_column_id < target_chunk->column_count(); ++reverse_column_id) {
-        const auto column_id = static_cast<ColumnID>(target_chunk->column_count() - reverse_column_id - 1);
+    if (!target_chunk->wait_for_allocated_rows(begin_chunk_offset)) {
+      // The allocation of an earlier reservation failed, so that the Chunk does not accept any more rows. Reserve
+      // the rows in a new Chunk instead.
+      continue;
+    }
 
-        resolve_data_type(_target_table->column_data_type(column_id), [&](const auto data_type_t) {
-          using ColumnDataType = typename decltype(data_type_t)::type;
+    // Grow MVCC vectors and mark new (but still empty) rows as being under modification by current transaction.
+    // Do so before resizing the Segments, because the resize of `Chunk::_segments.front()` is what releases the
+    // new row count.
+    {
+      auto mvcc_data = target_chunk->get_scoped_mvcc_data_lock();
+      mvcc_data->grow_by(num_rows_for_target_chunk, context->transaction_id(), MvccData::MAX_COMMIT_ID);
+    }
 
-          const auto value_segment =
-              std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(target_chunk->get_segment(column_id));
-          Assert(value_segment, "Cannot insert into non-ValueColumns");
+    // Grow data Segments.
+    // Do so in REVERSE column order so that the resize of `Chunk::_segments.front()` happens last. It is this last
+    // resize that makes the new row count visible to the outside world.
+    for (ColumnID reverse_column_id{0}; reverse_column_id < target_chunk->column_count(); ++reverse_column_id) {
+      const auto column_id = static_cast<ColumnID>(target_chunk->column_count() - reverse_column_id - 1);
 
-          const auto new_size = old_size + num_rows_for_target_chunk;
+      resolve_data_type(_target_table->column_data_type(column_id), [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
 
-          value_segment->values().resize(new_size);
+        const auto value_segment =
+            std::static_pointer_cast<ValueSegment<ColumnDataType>>(target_chunk->get_segment(column_id));
 
-          if (value_segment->is_nullable()) {
-            value_segment->null_values().resize(new_size);
-          }
-        });
+        value_segment->values().grow_to_at_least(end_chunk_offset);
 
-        // Make sure the first columns rewrite actually happens last and doesn't get reordered.
-        std::atomic_thread_fence(std::memory_order_seq_cst);
-      }
+        if (value_segment->is_nullable()) {
+          value_segment->null_values().grow_to_at_least(end_chunk_offset);
+        }
+      });
 
-      remaining_rows -= num_rows_for_target_chunk;
+      // Make sure the first columns rewrite actually happens last and doesn't get reordered.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
     }
+
+    allocation_guard.set_allocated();
+    _target_chunk_ranges.emplace_back(ChunkRange{target_chunk_id, begin_chunk_offset, end_chunk_offset});
+
+    remaining_rows -= num_rows_for_target_chunk;
   }
 
   /**
@@ -205,11 +228,25 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
     }
   }
 
+  /**
+   * 3. Add the written rows to the TableIndexes of the target Table. Until the transaction commits, Validate filters
+   *    them from the results of index lookups. Rolled back rows stay in the indexes, just like deleted rows do.
+   */
+  for (const auto& [column_ids, table_index] : _target_table->table_indexes()) {
+    for (const auto& target_chunk_range : _target_chunk_ranges) {
+      const auto target_chunk = _target_table->get_chunk(target_chunk_range.chunk_id);
+      table_index->insert(*target_chunk, target_chunk_range.chunk_id, target_chunk_range.begin_chunk_offset,
+                          target_chunk_range.end_chunk_offset);
+    }
+  }
+
   return nullptr;
 }
 
 void Insert::_on_commit_records(const CommitID cid) {
+  auto committed_row_count = uint64_t{0};
   for (const auto& target_chunk_range : _target_chunk_ranges) {
+    committed_row_count += target_chunk_range.end_chunk_offset - target_chunk_range.begin_chunk_offset;
     const auto target_chunk = _target_table->get_chunk(target_chunk_range.chunk_id);
     auto mvcc_data = target_chunk->get_scoped_mvcc_data_lock();
 
@@ -219,6 +256,9 @@ void Insert::_on_commit_records(const CommitID cid) {
       mvcc_data->tids[chunk_offset] = 0u;
     }
   }
+
+  // Merge the committed rows into the statistics once enough rows have been committed
+  schedule_table_statistics_update(_target_table, committed_row_count);
 }
 
 void Insert::_on_rollback_records() {
@@ -259,6 +299,13 @@ void Insert::_on_rollback_records() {
   }
 }
 
+void Insert::_on_log_records(RedoLogRecord& record) const {
+  for (const auto& target_chunk_range : _target_chunk_ranges) {
+    record.add_insert(_target_table_name, *_target_table, target_chunk_range.chunk_id,
+                      target_chunk_range.begin_chunk_offset, target_chunk_range.end_chunk_offset);
+  }
+}
+
 std::shared_ptr<AbstractOperator> Insert::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
@@ -21,10 +21,25 @@
 
 namespace {
 
+using namespace opossum;  // NOLINT
+
 // Depending on which input table became the build/probe table we have to order the columns of the output table.
 // Semi/Anti* Joins only emit tuples from the probe table
 enum class OutputColumnOrder { BuildFirstProbeSecond, ProbeFirstBuildSecond, ProbeOnly };
 
+// Everything that is needed from the build side to probe a morsel of the probe side, see build_shared_hash_tables()
+template <typename HashedType>
+struct TypedSharedHashTables : public JoinHash::SharedHashTables {
+  std::vector<std::optional<PosHashTable<HashedType>>> hash_tables;
+  std::optional<BloomFilter<HashedType>> bloom_filter;
+
+  // Only set for AntiNullAsTrue joins, which do not emit any tuples if the build column contains NULLs
+  bool build_column_has_null_value{false};
+
+  // Only set if the build side is a reference table and part of the output, see setup_pos_lists_by_chunk()
+  PosListsByChunk build_side_pos_lists_by_segment;
+};
+
 }  // namespace
 
 namespace opossum {
@@ -66,6 +81,68 @@ std::shared_ptr<AbstractOperator> JoinHash::_on_deep_copy(
 
 void JoinHash::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
+bool JoinHash::supports_shared_hash_tables(const JoinMode mode) {
+  // Except for inner joins, where we can choose, the join mode determines the build side (see _on_execute())
+  return mode == JoinMode::Inner || mode == JoinMode::Left || mode == JoinMode::Semi ||
+         mode == JoinMode::AntiNullAsTrue || mode == JoinMode::AntiNullAsFalse;
+}
+
+std::shared_ptr<const JoinHash::SharedHashTables> JoinHash::build_shared_hash_tables(
+    const std::shared_ptr<const Table>& build_input_table, const DataType probe_column_data_type,
+    const size_t probe_row_count) const {
+  Assert(supports_shared_hash_tables(_mode), "JoinMode does not allow building the hash tables from the right input");
+
+  const auto column_ids = std::make_pair(_primary_predicate.column_ids.second, _primary_predicate.column_ids.first);
+  const auto build_column_type = build_input_table->column_data_type(column_ids.first);
+
+  const auto output_column_order =
+      _mode == JoinMode::Inner || _mode == JoinMode::Left ? OutputColumnOrder::ProbeFirstBuildSecond
+                                                          : OutputColumnOrder::ProbeOnly;
+
+  auto secondary_predicates = _secondary_predicates;
+  for (auto& predicate : secondary_predicates) {
+    predicate.flip();
+  }
+
+  auto shared_hash_tables = std::shared_ptr<const SharedHashTables>{};
+  resolve_data_type(build_column_type, [&](const auto build_data_type_t) {
+    using BuildColumnDataType = typename decltype(build_data_type_t)::type;
+    resolve_data_type(probe_column_data_type, [&](const auto probe_data_type_t) {
+      using ProbeColumnDataType = typename decltype(probe_data_type_t)::type;
+
+      constexpr auto BOTH_ARE_STRING =
+          std::is_same_v<pmr_string, BuildColumnDataType> && std::is_same_v<pmr_string, ProbeColumnDataType>;
+      constexpr auto NEITHER_IS_STRING =
+          !std::is_same_v<pmr_string, BuildColumnDataType> && !std::is_same_v<pmr_string, ProbeColumnDataType>;
+
+      if constexpr (BOTH_ARE_STRING || NEITHER_IS_STRING) {
+        const auto radix_bits =
+            _radix_bits ? *_radix_bits
+                        : calculate_radix_bits<BuildColumnDataType>(build_input_table->row_count(), probe_row_count);
+
+        // See _on_execute()
+        const auto max_partition_size = std::numeric_limits<uint32_t>::max() * 0.5;
+        Assert(static_cast<size_t>(build_input_table->row_count() / std::pow(2, radix_bits)) < max_partition_size,
+               "Partition count too small (potential overflows in hash map offsetting).");
+
+        const auto impl = JoinHashImpl<BuildColumnDataType, ProbeColumnDataType>(
+            *this, build_input_table, nullptr, _mode, column_ids, _primary_predicate.predicate_condition,
+            output_column_order, radix_bits, std::move(secondary_predicates));
+        shared_hash_tables = impl.build_shared_hash_tables(probe_row_count);
+      } else {
+        Fail("Cannot join String with non-String column");
+      }
+    });
+  });
+
+  return shared_hash_tables;
+}
+
+void JoinHash::set_shared_hash_tables(const std::shared_ptr<const SharedHashTables>& shared_hash_tables) {
+  Assert(supports_shared_hash_tables(_mode), "JoinMode does not allow building the hash tables from the right input");
+  _shared_hash_tables = shared_hash_tables;
+}
+
 template <typename T>
 size_t JoinHash::calculate_radix_bits(const size_t build_relation_size, const size_t probe_relation_size) {
   /*
@@ -128,10 +205,12 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
    * JoinMode::Left/Right   The outer relation becomes the probe side, the inner relation becomes the build side
    * JoinMode::FullOuter    Not supported by JoinHash
    * JoinMode::Semi/Anti*   The left relation becomes the build side, the right relation becomes the probe side
+   *
+   * If the hash tables are shared (see SharedHashTables), they were built from the right relation.
    */
   const auto build_hash_table_for_right_input =
-      _mode == JoinMode::Left || _mode == JoinMode::AntiNullAsTrue || _mode == JoinMode::AntiNullAsFalse ||
-      _mode == JoinMode::Semi ||
+      _shared_hash_tables || _mode == JoinMode::Left || _mode == JoinMode::AntiNullAsTrue ||
+      _mode == JoinMode::AntiNullAsFalse || _mode == JoinMode::Semi ||
       (_mode == JoinMode::Inner && _input_left->get_output()->row_count() > _input_right->get_output()->row_count());
 
   if (build_hash_table_for_right_input) {
@@ -184,7 +263,10 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
           !std::is_same_v<pmr_string, BuildColumnDataType> && !std::is_same_v<pmr_string, ProbeColumnDataType>;
 
       if constexpr (BOTH_ARE_STRING || NEITHER_IS_STRING) {
-        if (!_radix_bits) {
+        if (_shared_hash_tables) {
+          // The probe side has to be partitioned like the build side that the shared hash tables were built from
+          _radix_bits = _shared_hash_tables->radix_bits;
+        } else if (!_radix_bits) {
           _radix_bits =
               calculate_radix_bits<BuildColumnDataType>(build_input_table->row_count(), probe_input_table->row_count());
         }
@@ -200,7 +282,7 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
         _impl = std::make_unique<JoinHashImpl<BuildColumnDataType, ProbeColumnDataType>>(
             *this, build_input_table, probe_input_table, _mode, adjusted_column_ids,
             _primary_predicate.predicate_condition, output_column_order, *_radix_bits,
-            std::move(adjusted_secondary_predicates));
+            std::move(adjusted_secondary_predicates), _shared_hash_tables);
       } else {
         Fail("Cannot join String with non-String column");
       }
@@ -210,7 +292,10 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
   return _impl->_on_execute();
 }
 
-void JoinHash::_on_cleanup() { _impl.reset(); }
+void JoinHash::_on_cleanup() {
+  _impl.reset();
+  _shared_hash_tables.reset();
+}
 
 template <typename BuildColumnType, typename ProbeColumnType>
 class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
@@ -219,7 +304,8 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
                const std::shared_ptr<const Table>& probe_input_table, const JoinMode mode,
                const ColumnIDPair& column_ids, const PredicateCondition predicate_condition,
                const OutputColumnOrder output_column_order, const size_t radix_bits,
-               std::vector<OperatorJoinPredicate> secondary_predicates = {})
+               std::vector<OperatorJoinPredicate> secondary_predicates = {},
+               const std::shared_ptr<const SharedHashTables>& shared_hash_tables = nullptr)
       : _join_hash(join_hash),
         _build_input_table(build_input_table),
         _probe_input_table(probe_input_table),
@@ -228,7 +314,39 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
         _predicate_condition(predicate_condition),
         _output_column_order(output_column_order),
         _secondary_predicates(std::move(secondary_predicates)),
-        _radix_bits(radix_bits) {}
+        _radix_bits(radix_bits),
+        _keep_nulls_build_column(mode == JoinMode::AntiNullAsTrue),
+        _keep_nulls_probe_column(mode == JoinMode::Left || mode == JoinMode::Right ||
+                                 mode == JoinMode::AntiNullAsTrue || mode == JoinMode::AntiNullAsFalse),
+        _shared_hash_tables(std::dynamic_pointer_cast<const TypedSharedHashTables<HashedType>>(shared_hash_tables)) {
+    Assert(!shared_hash_tables || _shared_hash_tables, "Shared hash tables were built for a different column type");
+  }
+
+  // Materializes and partitions the build column and builds its hash tables, see JoinHash::build_shared_hash_tables()
+  std::shared_ptr<const SharedHashTables> build_shared_hash_tables(const size_t probe_row_count) const {
+    auto shared_hash_tables = std::make_shared<TypedSharedHashTables<HashedType>>();
+    shared_hash_tables->radix_bits = _radix_bits;
+
+    const auto build_chunk_offsets = determine_chunk_offsets(_build_input_table);
+    auto histograms_build_column = std::vector<std::vector<size_t>>{};
+    auto materialized_build_column = _materialize_build_column(build_chunk_offsets, histograms_build_column);
+
+    if (_uses_bloom_filter(probe_row_count)) {
+      shared_hash_tables->bloom_filter =
+          build_bloom_filter<BuildColumnType, HashedType>(materialized_build_column, build_chunk_offsets);
+    }
+
+    auto radix_build_column = RadixContainer<BuildColumnType>{};
+    shared_hash_tables->hash_tables = _partition_build_column_and_build_hash_tables(
+        materialized_build_column, build_chunk_offsets, histograms_build_column, radix_build_column);
+    shared_hash_tables->build_column_has_null_value = _has_null_value(radix_build_column);
+
+    if (_build_input_table->type() == TableType::References && _output_column_order != OutputColumnOrder::ProbeOnly) {
+      shared_hash_tables->build_side_pos_lists_by_segment = setup_pos_lists_by_chunk(_build_input_table);
+    }
+
+    return shared_hash_tables;
+  }
 
  protected:
   const JoinHash& _join_hash;
@@ -245,30 +363,91 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
 
   const size_t _radix_bits;
 
+  /**
+   * Keep/Discard NULLs from build and probe columns as follows
+   *
+   * JoinMode::Inner              Discard NULLs from both columns
+   * JoinMode::Left/Right         Discard NULLs from the build column (the inner relation), but keep them on the probe
+   *                              column (the outer relation)
+   * JoinMode::FullOuter          Not supported by JoinHash
+   * JoinMode::Semi               Discard NULLs from both columns
+   * JoinMode::AntiNullAsFalse    Discard NULLs from the build column (the right relation), but keep them on the probe
+   *                              column (the left relation)
+   * JoinMode::AntiNullAsTrue     Keep NULLs from both columns
+   */
+  const bool _keep_nulls_build_column;
+  const bool _keep_nulls_probe_column;
+
   // Determine correct type for hashing
   using HashedType = typename JoinHashTraits<BuildColumnType, ProbeColumnType>::HashType;
 
-  std::shared_ptr<const Table> _on_execute() override {
-    /**
-     * Keep/Discard NULLs from build and probe columns as follows
-     *
-     * JoinMode::Inner              Discard NULLs from both columns
-     * JoinMode::Left/Right         Discard NULLs from the build column (the inner relation), but keep them on the probe
-     *                              column (the outer relation)
-     * JoinMode::FullOuter          Not supported by JoinHash
-     * JoinMode::Semi               Discard NULLs from both columns
-     * JoinMode::AntiNullAsFalse    Discard NULLs from the build column (the right relation), but keep them on the probe
-     *                              column (the left relation)
-     * JoinMode::AntiNullAsTrue     Keep NULLs from both columns
-     */
+  // If set, the build side is not processed, but the probe side is probed against these hash tables
+  const std::shared_ptr<const TypedSharedHashTables<HashedType>> _shared_hash_tables;
+
+  // For inner and semi joins, probe tuples without a join partner are never emitted. If the probe side is larger
+  // than the build side, we materialize the build column first and create a Bloom filter from its values. That
+  // filter is then used to skip non-matching tuples while the probe column is materialized, so that they are neither
+  // copied nor radix-partitioned. This trades the parallel materialization of both sides for less work and memory
+  // on the (larger) probe side. The partitioning of the build side still overlaps with the probe materialization.
+  bool _uses_bloom_filter(const size_t probe_row_count) const {
+    return (_mode == JoinMode::Inner || _mode == JoinMode::Semi) && probe_row_count > _build_input_table->row_count();
+  }
+
+  RadixContainer<BuildColumnType> _materialize_build_column(const std::vector<size_t>& build_chunk_offsets,
+                                                            std::vector<std::vector<size_t>>& histograms) const {
+    if (_keep_nulls_build_column) {
+      return materialize_input<BuildColumnType, HashedType, true>(_build_input_table, _column_ids.first,
+                                                                   build_chunk_offsets, histograms, _radix_bits);
+    }
+    return materialize_input<BuildColumnType, HashedType, false>(_build_input_table, _column_ids.first,
+                                                                  build_chunk_offsets, histograms, _radix_bits);
+  }
+
+  // Radix partitions @param materialized_build_column into @param radix_build_column (unless _radix_bits is 0) and
+  // builds the hash tables, one for each partition
+  std::vector<std::optional<PosHashTable<HashedType>>> _partition_build_column_and_build_hash_tables(
+      RadixContainer<BuildColumnType>& materialized_build_column, const std::vector<size_t>& build_chunk_offsets,
+      std::vector<std::vector<size_t>>& histograms, RadixContainer<BuildColumnType>& radix_build_column) const {
+    if (_radix_bits > 0) {
+      // radix partition the build table
+      if (_keep_nulls_build_column) {
+        radix_build_column = partition_radix_parallel<BuildColumnType, HashedType, true>(
+            materialized_build_column, build_chunk_offsets, histograms, _radix_bits);
+      } else {
+        radix_build_column = partition_radix_parallel<BuildColumnType, HashedType, false>(
+            materialized_build_column, build_chunk_offsets, histograms, _radix_bits);
+      }
+      // After the data in materialized_build_column has been partitioned, it is not needed anymore.
+      materialized_build_column.clear();
+    } else {
+      // short cut: skip radix partitioning and use materialized data directly
+      radix_build_column = std::move(materialized_build_column);
+    }
+
+    // Build hash tables. In the case of semi or anti joins, we do not need to track all rows on the hashed side,
+    // just one per value. However, if we have secondary predicates, those might fail on that single row. In that
+    // case, we DO need all rows.
+    if (_secondary_predicates.empty() &&
+        (_mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsTrue || _mode == JoinMode::AntiNullAsFalse)) {
+      return build<BuildColumnType, HashedType>(radix_build_column, JoinHashBuildMode::SinglePosition);
+    }
+    return build<BuildColumnType, HashedType>(radix_build_column, JoinHashBuildMode::AllPositions);
+  }
 
-    const auto keep_nulls_build_column = _mode == JoinMode::AntiNullAsTrue;
-    const auto keep_nulls_probe_column = _mode == JoinMode::Left || _mode == JoinMode::Right ||
-                                         _mode == JoinMode::AntiNullAsTrue || _mode == JoinMode::AntiNullAsFalse;
+  // Only NULLs of AntiNullAsTrue joins are kept on the build side, see _on_execute()
+  bool _has_null_value(const RadixContainer<BuildColumnType>& radix_build_column) const {
+    if (!_keep_nulls_build_column) return false;
 
+    const auto& build_column_null_values = radix_build_column.null_value_bitvector;
+    return std::any_of(build_column_null_values->begin(), build_column_null_values->end(),
+                       [](bool is_null) { return is_null; });
+  }
+
+  std::shared_ptr<const Table> _on_execute() override {
     // Pre-partitioning:
-    // Save chunk offsets into the input relation.
-    const auto build_chunk_offsets = determine_chunk_offsets(_build_input_table);
+    // Save chunk offsets into the input relation. Shared hash tables were built from the build side already.
+    const auto build_chunk_offsets =
+        _shared_hash_tables ? std::vector<size_t>{} : determine_chunk_offsets(_build_input_table);
     const auto probe_chunk_offsets = determine_chunk_offsets(_probe_input_table);
 
     // Containers used to store histograms for (potentially subsequent) radix
@@ -294,11 +473,15 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     // We have two data paths, one for build side and one for probe input side. We can prepare (i.e.,
     // materialize(), build(), etc.) both sides in parallel until the actual join takes place.
     // All tasks might spawn concurrent tasks themselves. For example, materialize parallelizes over
-    // the input chunks and the following steps over the radix clusters.
+    // the input chunks and the following steps over the radix clusters. If a Bloom filter is used (see
+    // _uses_bloom_filter()), the materialization of the probe side waits for the filter that is created from the
+    // materialized build side. With shared hash tables, only the probe side is processed.
     //
     //           Build Relation                       Probe Relation
     //                 |                                    |
-    //        materialize_input()                  materialize_input()
+    //        materialize_input()                           |
+    //                 |                                    |
+    //       ( build_bloom_filter() ) ------------>  materialize_input()
     //                 |                                    |
     //  ( partition_radix_parallel() )       ( partition_radix_parallel() )
     //                 |                                    |
@@ -310,64 +493,58 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     //                           \                 /
     //                          Probing (actual Join)
 
-    std::vector<std::shared_ptr<AbstractTask>> jobs;
+    const auto use_bloom_filter = !_shared_hash_tables && _uses_bloom_filter(_probe_input_table->row_count());
+    std::optional<BloomFilter<HashedType>> bloom_filter;
+
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
 
     /**
-     * 1.1 Schedule a JobTask for materialization, optional radix partitioning and hash table building for the build side
+     * 1.1 Schedule JobTasks for the materialization and for the optional radix partitioning and hash table building of
+     *     the build side. If a Bloom filter is used, it is created from the materialized build column.
      */
-    jobs.emplace_back(std::make_shared<JobTask>([&]() {
-      if (keep_nulls_build_column) {
-        materialized_build_column = materialize_input<BuildColumnType, HashedType, true>(
-            _build_input_table, _column_ids.first, build_chunk_offsets, histograms_build_column, _radix_bits);
-      } else {
-        materialized_build_column = materialize_input<BuildColumnType, HashedType, false>(
-            _build_input_table, _column_ids.first, build_chunk_offsets, histograms_build_column, _radix_bits);
-      }
-
-      if (_radix_bits > 0) {
-        // radix partition the build table
-        if (keep_nulls_build_column) {
-          radix_build_column = partition_radix_parallel<BuildColumnType, HashedType, true>(
-              materialized_build_column, build_chunk_offsets, histograms_build_column, _radix_bits);
-        } else {
-          radix_build_column = partition_radix_parallel<BuildColumnType, HashedType, false>(
-              materialized_build_column, build_chunk_offsets, histograms_build_column, _radix_bits);
+    auto build_materialization_job = std::shared_ptr<AbstractTask>{};
+    if (!_shared_hash_tables) {
+      build_materialization_job = std::make_shared<JobTask>([&]() {
+        materialized_build_column = _materialize_build_column(build_chunk_offsets, histograms_build_column);
+        if (use_bloom_filter) {
+          bloom_filter =
+              build_bloom_filter<BuildColumnType, HashedType>(materialized_build_column, build_chunk_offsets);
         }
-        // After the data in materialized_build_column has been partitioned, it is not needed anymore.
-        materialized_build_column.clear();
-      } else {
-        // short cut: skip radix partitioning and use materialized data directly
-        radix_build_column = std::move(materialized_build_column);
-      }
-
-      // Build hash tables. In the case of semi or anti joins, we do not need to track all rows on the hashed side,
-      // just one per value. However, if we have secondary predicates, those might fail on that single row. In that
-      // case, we DO need all rows.
-      if (_secondary_predicates.empty() &&
-          (_mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsTrue || _mode == JoinMode::AntiNullAsFalse)) {
-        hash_tables = build<BuildColumnType, HashedType>(radix_build_column, JoinHashBuildMode::SinglePosition);
-      } else {
-        hash_tables = build<BuildColumnType, HashedType>(radix_build_column, JoinHashBuildMode::AllPositions);
-      }
-    }));
-    jobs.back()->schedule();
+      });
+      const auto build_job = std::make_shared<JobTask>([&]() {
+        hash_tables = _partition_build_column_and_build_hash_tables(materialized_build_column, build_chunk_offsets,
+                                                                    histograms_build_column, radix_build_column);
+      });
+      build_materialization_job->set_as_predecessor_of(build_job);
+
+      jobs.emplace_back(build_materialization_job);
+      jobs.emplace_back(build_job);
+    }
 
     /**
-     * 1.2 Schedule a JobTask for materialization, optional radix partitioning for the probe side
+     * 1.2 Schedule a JobTask for materialization, optional radix partitioning for the probe side. With a Bloom filter,
+     *     it waits for the materialization of the build side, but still runs in parallel to the build() of the hash
+     *     tables.
      */
-    jobs.emplace_back(std::make_shared<JobTask>([&]() {
+    const auto probe_job = std::make_shared<JobTask>([&]() {
+      const auto* probe_bloom_filter = bloom_filter ? &*bloom_filter : nullptr;
+      if (_shared_hash_tables && _shared_hash_tables->bloom_filter) {
+        probe_bloom_filter = &*_shared_hash_tables->bloom_filter;
+      }
+
       // Materialize probe column.
-      if (keep_nulls_probe_column) {
+      if (_keep_nulls_probe_column) {
         materialized_probe_column = materialize_input<ProbeColumnType, HashedType, true>(
             _probe_input_table, _column_ids.second, probe_chunk_offsets, histograms_probe_column, _radix_bits);
       } else {
         materialized_probe_column = materialize_input<ProbeColumnType, HashedType, false>(
-            _probe_input_table, _column_ids.second, probe_chunk_offsets, histograms_probe_column, _radix_bits);
+            _probe_input_table, _column_ids.second, probe_chunk_offsets, histograms_probe_column, _radix_bits,
+            probe_bloom_filter);
       }
 
       if (_radix_bits > 0) {
         // radix partition the probe column.
-        if (keep_nulls_probe_column) {
+        if (_keep_nulls_probe_column) {
           radix_probe_column = partition_radix_parallel<ProbeColumnType, HashedType, true>(
               materialized_probe_column, probe_chunk_offsets, histograms_probe_column, _radix_bits);
         } else {
@@ -380,10 +557,11 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
         // short cut: skip radix partitioning and use materialized data directly
         radix_probe_column = std::move(materialized_probe_column);
       }
-    }));
-    jobs.back()->schedule();
+    });
+    if (use_bloom_filter) build_materialization_job->set_as_predecessor_of(probe_job);
+    jobs.emplace_back(probe_job);
 
-    Hyrise::get().scheduler()->wait_for_tasks(jobs);
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
 
     // Short cut for AntiNullAsTrue
     //   If there is any NULL value on the build side, do not bother probing as no tuples can be emitted
@@ -391,15 +569,17 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     //   right here is hacky, but during probing we assume NULL values on the build side do not matter, so we'd have no
     //   chance detecting a NULL value on the build side there.
     if (_mode == JoinMode::AntiNullAsTrue) {
-      const auto& build_column_null_values = radix_build_column.null_value_bitvector;
-      const auto build_has_any_null_value = std::any_of(
-          build_column_null_values->begin(), build_column_null_values->end(), [](bool is_null) { return is_null; });
+      const auto build_has_any_null_value =
+          _shared_hash_tables ? _shared_hash_tables->build_column_has_null_value : _has_null_value(radix_build_column);
 
       if (build_has_any_null_value) {
         return _join_hash._build_output_table({});
       }
     }
 
+    // The hash tables that are probed, either the shared ones or the ones built above
+    const auto& probed_hash_tables = _shared_hash_tables ? _shared_hash_tables->hash_tables : hash_tables;
+
     /**
      * 2. Probe phase
      */
@@ -423,33 +603,33 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     */
     switch (_mode) {
       case JoinMode::Inner:
-        probe<ProbeColumnType, HashedType, false>(radix_probe_column, hash_tables, build_side_pos_lists,
+        probe<ProbeColumnType, HashedType, false>(radix_probe_column, probed_hash_tables, build_side_pos_lists,
                                                   probe_side_pos_lists, _mode, *_build_input_table, *_probe_input_table,
                                                   _secondary_predicates);
         break;
 
       case JoinMode::Left:
       case JoinMode::Right:
-        probe<ProbeColumnType, HashedType, true>(radix_probe_column, hash_tables, build_side_pos_lists,
+        probe<ProbeColumnType, HashedType, true>(radix_probe_column, probed_hash_tables, build_side_pos_lists,
                                                  probe_side_pos_lists, _mode, *_build_input_table, *_probe_input_table,
                                                  _secondary_predicates);
         break;
 
       case JoinMode::Semi:
-        probe_semi_anti<ProbeColumnType, HashedType, JoinMode::Semi>(radix_probe_column, hash_tables,
+        probe_semi_anti<ProbeColumnType, HashedType, JoinMode::Semi>(radix_probe_column, probed_hash_tables,
                                                                      probe_side_pos_lists, *_build_input_table,
                                                                      *_probe_input_table, _secondary_predicates);
         break;
 
       case JoinMode::AntiNullAsTrue:
         probe_semi_anti<ProbeColumnType, HashedType, JoinMode::AntiNullAsTrue>(
-            radix_probe_column, hash_tables, probe_side_pos_lists, *_build_input_table, *_probe_input_table,
+            radix_probe_column, probed_hash_tables, probe_side_pos_lists, *_build_input_table, *_probe_input_table,
             _secondary_predicates);
         break;
 
       case JoinMode::AntiNullAsFalse:
         probe_semi_anti<ProbeColumnType, HashedType, JoinMode::AntiNullAsFalse>(
-            radix_probe_column, hash_tables, probe_side_pos_lists, *_build_input_table, *_probe_input_table,
+            radix_probe_column, probed_hash_tables, probe_side_pos_lists, *_build_input_table, *_probe_input_table,
             _secondary_predicates);
         break;
 
@@ -488,7 +668,8 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
 
     // build_side_pos_lists_by_segment will only be needed if build is a reference table and being output
     if (_build_input_table->type() == TableType::References && _output_column_order != OutputColumnOrder::ProbeOnly) {
-      build_side_pos_lists_by_segment = setup_pos_lists_by_chunk(_build_input_table);
+      build_side_pos_lists_by_segment = _shared_hash_tables ? _shared_hash_tables->build_side_pos_lists_by_segment
+                                                            : setup_pos_lists_by_chunk(_build_input_table);
     }
 
     // probe_side_pos_lists_by_segment will only be needed if right is a reference table
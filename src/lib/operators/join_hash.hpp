@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <optional>
 
 #include "abstract_join_operator.hpp"
@@ -34,6 +35,30 @@ class JoinHash : public AbstractJoinOperator {
   template <typename T>
   static size_t calculate_radix_bits(const size_t build_relation_size, const size_t probe_relation_size);
 
+  /**
+   * Hash tables that are built from the right input once and shared by the copies of a JoinHash that a MorselPipeline
+   * executes on the morsels of the left input (see there). Only the probe side is materialized and partitioned for
+   * each morsel.
+   */
+  struct SharedHashTables {
+    virtual ~SharedHashTables() = default;
+
+    size_t radix_bits{0};
+  };
+
+  // Returns whether the left input can be probed against SharedHashTables, i.e., whether @param mode allows building
+  // the hash tables from the right input
+  static bool supports_shared_hash_tables(const JoinMode mode);
+
+  // Builds the hash tables of @param build_input_table, which is the right input, for a left input whose join column
+  // has the type @param probe_column_data_type and that is expected to hold about @param probe_row_count rows
+  std::shared_ptr<const SharedHashTables> build_shared_hash_tables(
+      const std::shared_ptr<const Table>& build_input_table, const DataType probe_column_data_type,
+      const size_t probe_row_count) const;
+
+  // The next execution probes the left input against @param shared_hash_tables instead of building its own
+  void set_shared_hash_tables(const std::shared_ptr<const SharedHashTables>& shared_hash_tables);
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
   std::shared_ptr<AbstractOperator> _on_deep_copy(
@@ -44,6 +69,7 @@ class JoinHash : public AbstractJoinOperator {
 
   std::unique_ptr<AbstractReadOnlyOperatorImpl> _impl;
   std::optional<size_t> _radix_bits;
+  std::shared_ptr<const SharedHashTables> _shared_hash_tables;
 
   template <typename LeftType, typename RightType>
   class JoinHashImpl;
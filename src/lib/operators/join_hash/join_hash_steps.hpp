@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include <boost/container/small_vector.hpp>
 #include <boost/lexical_cast.hpp>
 #include <uninitialized_vector.hpp>
@@ -152,6 +154,68 @@ class PosHashTable {
   std::optional<std::vector<std::pair<HashedType, Offset>>> _values{std::nullopt};
 };
 
+/*
+Blocked Bloom filter that is filled with the values of the build side and used to discard probe side tuples that
+cannot find a join partner before they are materialized and radix-partitioned (sideways information passing). Each
+value sets HASH_COUNT bits within a single 64-bit block, so that inserting or testing a value only touches one word
+(see Putze et al., "Cache-, Hash- and Space-Efficient Bloom Filters", WEA 2007). With BITS_PER_VALUE bits per build
+value, about 3% of the probe values without a join partner pass the filter.
+
+Values can be inserted concurrently. contains() must not be called before all insertions are done.
+*/
+template <typename HashedType>
+class BloomFilter {
+ public:
+  static constexpr auto BITS_PER_VALUE = size_t{8};
+  static constexpr auto HASH_COUNT = size_t{4};
+
+  explicit BloomFilter(const size_t expected_value_count) {
+    auto block_count = size_t{1};
+    while (block_count * 64 < expected_value_count * BITS_PER_VALUE) {
+      block_count *= 2;
+    }
+    _blocks = std::vector<std::atomic<uint64_t>>(block_count);
+    _block_mask = block_count - 1;
+  }
+
+  template <typename InputType>
+  void insert(const InputType& value) {
+    const auto hash = _hash(static_cast<HashedType>(value));
+    _blocks[(hash >> 32) & _block_mask].fetch_or(_bits(hash), std::memory_order_relaxed);
+  }
+
+  template <typename InputType>
+  bool contains(const InputType& value) const {
+    const auto hash = _hash(static_cast<HashedType>(value));
+    const auto bits = _bits(hash);
+    return (_blocks[(hash >> 32) & _block_mask].load(std::memory_order_relaxed) & bits) == bits;
+  }
+
+ private:
+  static uint64_t _hash(const HashedType& value) {
+    // std::hash is the identity for integers, so we mix the bits using the finalizer of MurmurHash3
+    auto hash = static_cast<uint64_t>(std::hash<HashedType>{}(value));
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  // The lower 32 bits of the hash select the bits within the block, the upper 32 bits select the block
+  static uint64_t _bits(const uint64_t hash) {
+    auto bits = uint64_t{0};
+    for (auto hash_id = size_t{0}; hash_id < HASH_COUNT; ++hash_id) {
+      bits |= uint64_t{1} << ((hash >> (hash_id * 6)) & 63);
+    }
+    return bits;
+  }
+
+  std::vector<std::atomic<uint64_t>> _blocks;
+  size_t _block_mask;
+};
+
 /*
 This struct contains radix-partitioned data in a contiguous buffer, as well as a list of offsets for each partition.
 The offsets denote the accumulated sizes (we cannot use the last element's position because we could not recognize
@@ -197,10 +261,15 @@ inline std::vector<size_t> determine_chunk_offsets(const std::shared_ptr<const T
   return chunk_offsets;
 }
 
+// If a bloom_filter is passed, values that are not contained in it are skipped as if they were NULL. As this drops
+// tuples from the probe side, it must only be used for joins that do not emit probe tuples without a join partner.
 template <typename T, typename HashedType, bool retain_null_values>
 RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table, ColumnID column_id,
                                     const std::vector<size_t>& chunk_offsets,
-                                    std::vector<std::vector<size_t>>& histograms, const size_t radix_bits) {
+                                    std::vector<std::vector<size_t>>& histograms, const size_t radix_bits,
+                                    const BloomFilter<HashedType>* bloom_filter = nullptr) {
+  DebugAssert(!retain_null_values || !bloom_filter, "Tuples with NULL values cannot be filtered by a Bloom filter");
+
   const std::hash<HashedType> hash_function;
   // list of all elements that will be partitioned
   auto elements = std::make_shared<Partition<T>>(in_table->row_count());
@@ -258,7 +327,8 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
           const auto& value = *it;
           ++it;
 
-          if (!value.is_null() || retain_null_values) {
+          if ((!value.is_null() || retain_null_values) &&
+              (!bloom_filter || bloom_filter->contains(static_cast<HashedType>(value.value())))) {
             /*
             For ReferenceSegments we do not use the RowIDs from the referenced tables.
             Instead, we use the index in the ReferenceSegment itself. This way we can later correctly dereference
@@ -312,6 +382,41 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
   return RadixContainer<T>{elements, std::vector<size_t>{elements->size()}, null_value_bitvector};
 }
 
+/*
+Create a Bloom filter from the materialized values of the build column. One job per materialized chunk.
+*/
+template <typename BuildColumnType, typename HashedType>
+BloomFilter<HashedType> build_bloom_filter(const RadixContainer<BuildColumnType>& radix_container,
+                                           const std::vector<size_t>& chunk_offsets) {
+  const auto& elements = *radix_container.elements;
+  auto bloom_filter = BloomFilter<HashedType>{elements.size()};
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(chunk_offsets.size());
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_offsets.size(); ++chunk_id) {
+    const auto begin = chunk_offsets[chunk_id];
+    const auto end = chunk_id < chunk_offsets.size() - 1 ? chunk_offsets[chunk_id + 1] : elements.size();
+    if (begin == end) continue;
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, begin, end]() {
+      for (auto position = begin; position < end; ++position) {
+        const auto& element = elements[position];
+
+        // Skip NULL values and the initialized PartitionedElements that might remain after the materialization phase
+        if (element.row_id == NULL_ROW_ID) continue;
+
+        bloom_filter.insert(element.value);
+      }
+    }));
+    jobs.back()->schedule();
+  }
+
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+
+  return bloom_filter;
+}
+
 /*
 Build all the hash tables for the partitions of the build column. One job per partition
 */
@@ -393,14 +498,9 @@ RadixContainer<T> partition_radix_parallel(const RadixContainer<T>& radix_contai
   size_t pass = 0;
   size_t mask = static_cast<uint32_t>(pow(2, radix_bits * (pass + 1)) - 1);
 
-  // allocate new (shared) output
+  // allocate new (shared) output, which is sized once the number of partitioned elements is known
   auto output = std::make_shared<Partition<T>>();
-  output->resize(container_elements.size());
-
   [[maybe_unused]] auto output_nulls = std::make_shared<std::vector<bool>>();
-  if constexpr (retain_null_values) {
-    output_nulls->resize(null_value_bitvector.size());
-  }
 
   RadixContainer<T> radix_output;
   radix_output.elements = output;
@@ -449,6 +549,13 @@ RadixContainer<T> partition_radix_parallel(const RadixContainer<T>& radix_contai
     prefix_sums[position] += prefix_sums[position - 1];
   }
 
+  // The histograms only count the elements that are partitioned. Elements that were skipped during the
+  // materialization (e.g., NULL values or values rejected by a Bloom filter) do not take up space in the output.
+  output->resize(prefix_sums.back());
+  if constexpr (retain_null_values) {
+    output_nulls->resize(prefix_sums.back());
+  }
+
   // Offset vector creation: third step
   for (auto chunk_id = ChunkID{0}; chunk_id < chunk_offsets.size(); ++chunk_id) {
     // Skip the first item of the loop
@@ -13,6 +13,7 @@
 #include "multi_predicate_join/multi_predicate_join_evaluator.hpp"
 #include "resolve_type.hpp"
 #include "storage/index/abstract_index.hpp"
+#include "storage/index/table_index.hpp"
 #include "storage/segment_iterate.hpp"
 #include "type_comparison.hpp"
 #include "utils/assert.hpp"
@@ -135,6 +136,14 @@ std::shared_ptr<const Table> JoinIndex::_on_execute() {
 
   auto secondary_predicate_evaluator = MultiPredicateJoinEvaluator{*_probe_input_table, *_index_input_table, _mode, {}};
 
+  // TableIndexes contain RowIDs of data tables and are looked up with values of the indexed column's type
+  auto table_index = std::shared_ptr<TableIndex>{};
+  if (_index_input_table->type() == TableType::Data &&
+      _index_input_table->column_data_type(_adjusted_primary_predicate.column_ids.second) ==
+          _probe_input_table->column_data_type(_adjusted_primary_predicate.column_ids.first)) {
+    table_index = _index_input_table->get_table_index({_adjusted_primary_predicate.column_ids.second});
+  }
+
   if (_mode == JoinMode::Inner && _index_input_table->type() == TableType::References &&
       _secondary_predicates.empty()) {  // INNER REFERENCE JOIN
     // Scan all chunks for index input
@@ -147,8 +156,8 @@ std::shared_ptr<const Table> JoinIndex::_on_execute() {
         continue;
       }
 
-      const auto& reference_segment =
-          std::dynamic_pointer_cast<ReferenceSegment>(index_chunk->get_segment(_primary_predicate.column_ids.second));
+      const auto& reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(
+          index_chunk->get_segment(_adjusted_primary_predicate.column_ids.second));
       Assert(reference_segment != nullptr,
              "Non-empty index input table (reference table) has to have only reference segments.");
       auto index_data_table = reference_segment->referenced_table();
@@ -191,6 +200,21 @@ std::shared_ptr<const Table> JoinIndex::_on_execute() {
                               secondary_predicate_evaluator);
       }
     }
+  } else if (table_index) {  // DATA JOIN using a TableIndex
+    // Look up each probe side value once in the index that covers all chunks of the index side
+    const auto chunk_count_probe_input_table = _probe_input_table->chunk_count();
+    for (ChunkID probe_chunk_id{0}; probe_chunk_id < chunk_count_probe_input_table; ++probe_chunk_id) {
+      const auto chunk = _probe_input_table->get_chunk(probe_chunk_id);
+      Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+      const auto& probe_segment = chunk->get_segment(_adjusted_primary_predicate.column_ids.first);
+      segment_with_iterators(*probe_segment, [&](auto probe_iter, const auto probe_end) {
+        _data_join_two_segments_using_table_index(probe_iter, probe_end, probe_chunk_id, *table_index);
+      });
+    }
+    performance_data.chunks_scanned_with_index += _index_input_table->chunk_count();
+
+    _append_matches_non_inner(is_semi_or_anti_join);
   } else {  // DATA JOIN since only inner joins are supported for a reference table on the index side
     // Scan all chunks for index input
     const auto chunk_count_index_input_table = _index_input_table->chunk_count();
@@ -305,6 +329,23 @@ void JoinIndex::_data_join_two_segments_using_index(ProbeIterator probe_iter, Pr
   }
 }
 
+template <typename ProbeIterator>
+void JoinIndex::_data_join_two_segments_using_table_index(ProbeIterator probe_iter, ProbeIterator probe_end,
+                                                          const ChunkID probe_chunk_id,
+                                                          const TableIndex& table_index) {
+  // The adjusted predicate compares the probe side value with the index side value, the index is searched the other
+  // way around
+  const auto lookup_predicate_condition = flip_predicate_condition(_adjusted_primary_predicate.predicate_condition);
+
+  for (; probe_iter != probe_end; ++probe_iter) {
+    const auto probe_side_position = *probe_iter;
+    if (probe_side_position.is_null()) continue;
+
+    const auto index_matches = table_index.lookup(lookup_predicate_condition, {probe_side_position.value()});
+    _append_table_index_matches(index_matches, probe_side_position.chunk_offset(), probe_chunk_id);
+  }
+}
+
 template <typename ProbeIterator>
 void JoinIndex::_reference_join_two_segments_using_index(
     ProbeIterator probe_iter, ProbeIterator probe_end, const ChunkID probe_chunk_id, const ChunkID index_chunk_id,
@@ -419,6 +460,36 @@ void JoinIndex::_append_matches(const AbstractIndex::Iterator& range_begin, cons
   }
 }
 
+void JoinIndex::_append_table_index_matches(const PosList& index_matches, const ChunkOffset probe_chunk_offset,
+                                            const ChunkID probe_chunk_id) {
+  const auto is_semi_or_anti_join =
+      _mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsFalse || _mode == JoinMode::AntiNullAsTrue;
+  const auto track_probe_matches = _mode == JoinMode::FullOuter ||
+                                   (_mode == JoinMode::Left && _index_side == IndexSide::Right) ||
+                                   (_mode == JoinMode::Right && _index_side == IndexSide::Left) ||
+                                   (is_semi_or_anti_join && _index_side == IndexSide::Right);
+  const auto track_index_matches = _mode == JoinMode::FullOuter ||
+                                   (_mode == JoinMode::Left && _index_side == IndexSide::Left) ||
+                                   (_mode == JoinMode::Right && _index_side == IndexSide::Right) ||
+                                   (is_semi_or_anti_join && _index_side == IndexSide::Left);
+
+  const auto index_chunk_count = _index_input_table->chunk_count();
+  for (const auto& index_row_id : index_matches) {
+    // The index also contains rows that were added to the stored table after the index side input was created
+    if (index_row_id.chunk_id >= index_chunk_count) continue;
+    if (track_index_matches && index_row_id.chunk_offset >= _index_matches[index_row_id.chunk_id].size()) continue;
+
+    // Remember the matches for outer, semi, and anti joins. The PosLists of semi and anti joins are written by
+    // _append_matches_non_inner().
+    if (track_probe_matches) _probe_matches[probe_chunk_id][probe_chunk_offset] = true;
+    if (track_index_matches) _index_matches[index_row_id.chunk_id][index_row_id.chunk_offset] = true;
+    if (is_semi_or_anti_join) continue;
+
+    _probe_pos_list->emplace_back(RowID{probe_chunk_id, probe_chunk_offset});
+    _index_pos_list->emplace_back(index_row_id);
+  }
+}
+
 void JoinIndex::_append_matches_dereferenced(const ChunkID& probe_chunk_id, const ChunkOffset& probe_chunk_offset,
                                              const PosList& index_table_matches) {
   for (const auto& index_side_row_id : index_table_matches) {
@@ -14,6 +14,7 @@
 namespace opossum {
 
 class MultiPredicateJoinEvaluator;
+class TableIndex;
 using IndexRange = std::pair<AbstractIndex::Iterator, AbstractIndex::Iterator>;
 
 /**
@@ -26,6 +27,9 @@ using IndexRange = std::pair<AbstractIndex::Iterator, AbstractIndex::Iterator>;
    * fallback solution (nested join loop) is used. Using the fallback solution does not increment the number of chunks
    * scanned with index in the performance data.
    *
+   * If the index side is a data table with a TableIndex on the join column, each probe side value is looked up once in
+   * that index instead of once per chunk of the index side.
+   *
    * Note: An index needs to be present on the index side table in order to execute an index join.
    */
 class JoinIndex : public AbstractJoinOperator {
@@ -63,6 +67,10 @@ class JoinIndex : public AbstractJoinOperator {
                                            const ChunkID probe_chunk_id, const ChunkID index_chunk_id,
                                            const std::shared_ptr<AbstractIndex>& index);
 
+  template <typename ProbeIterator>
+  void _data_join_two_segments_using_table_index(ProbeIterator probe_iter, ProbeIterator probe_end,
+                                                 const ChunkID probe_chunk_id, const TableIndex& table_index);
+
   template <typename ProbeIterator>
   void _reference_join_two_segments_using_index(ProbeIterator probe_iter, ProbeIterator probe_end,
                                                 const ChunkID probe_chunk_id, const ChunkID index_chunk_id,
@@ -77,6 +85,9 @@ class JoinIndex : public AbstractJoinOperator {
                        const ChunkOffset probe_chunk_offset, const ChunkID probe_chunk_id,
                        const ChunkID index_chunk_id);
 
+  void _append_table_index_matches(const PosList& index_matches, const ChunkOffset probe_chunk_offset,
+                                   const ChunkID probe_chunk_id);
+
   void _append_matches_dereferenced(const ChunkID& probe_chunk_id, const ChunkOffset& probe_chunk_offset,
                                     const PosList& index_table_matches);
 
@@ -162,8 +162,10 @@ class ColumnMaterializer {
     });
 
     if (_sort) {
-      std::sort(output.begin(), output.end(),
-                [](const auto& left, const auto& right) { return left.value < right.value; });
+      const auto compare = [](const auto& left, const auto& right) { return left.value < right.value; };
+      if (!std::is_sorted(output.begin(), output.end(), compare)) {
+        std::sort(output.begin(), output.end(), compare);
+      }
     }
 
     _gather_samples_from_segment(output, subsample);
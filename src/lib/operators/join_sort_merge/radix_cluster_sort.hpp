@@ -312,11 +312,15 @@ class RadixClusterSort {
   }
 
   /**
-  * Sorts all clusters of a materialized table.
+  * Sorts all clusters of a materialized table. Clusters of inputs that are already sorted by the join column (e.g.,
+  * the output of a Sort operator) are in order after the clustering, so checking for that first is cheap compared to
+  * sorting them again.
   **/
   void _sort_clusters(std::unique_ptr<MaterializedSegmentList<T>>& clusters) {
+    const auto compare = [](const auto& left, const auto& right) { return left.value < right.value; };
     for (auto cluster : *clusters) {
-      std::sort(cluster->begin(), cluster->end(), [](auto& left, auto& right) { return left.value < right.value; });
+      if (std::is_sorted(cluster->begin(), cluster->end(), compare)) continue;
+      std::sort(cluster->begin(), cluster->end(), compare);
     }
   }
 
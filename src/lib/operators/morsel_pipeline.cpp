@@ -0,0 +1,398 @@
+#include "morsel_pipeline.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
+#include "operators/aggregate_hash.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/reference_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+bool contains_subquery(const std::vector<std::shared_ptr<AbstractExpression>>& expressions) {
+  auto subquery_found = false;
+  for (const auto& expression : expressions) {
+    visit_expression(expression, [&](const auto& sub_expression) {
+      if (sub_expression->type == ExpressionType::PQPSubquery) subquery_found = true;
+      return subquery_found ? ExpressionVisitation::DoNotVisitArguments : ExpressionVisitation::VisitArguments;
+    });
+  }
+  return subquery_found;
+}
+
+// Makes the ReferenceSegments of @param chunk that reference @param morsel_table reference the chunk @param chunk_id
+// of @param input_table instead. The PosLists of the morsel might still be referenced elsewhere (e.g., by the output
+// of an operator that is kept in a cache), so they are copied instead of updated in place. PosLists shared by
+// multiple segments are copied once and remain shared.
+std::shared_ptr<Chunk> rebase_chunk(const std::shared_ptr<Chunk>& chunk,
+                                    const std::shared_ptr<const Table>& morsel_table,
+                                    const std::shared_ptr<const Table>& input_table, const ChunkID chunk_id) {
+  auto rebased_pos_lists = std::unordered_map<std::shared_ptr<const PosList>, std::shared_ptr<const PosList>>{};
+  auto segments = Segments{};
+  auto rebased_any_segment = false;
+
+  const auto column_count = chunk->column_count();
+  segments.reserve(column_count);
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    const auto segment = chunk->get_segment(column_id);
+    const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(segment);
+    if (!reference_segment || reference_segment->referenced_table() != morsel_table) {
+      segments.emplace_back(segment);
+      continue;
+    }
+
+    const auto& pos_list = reference_segment->pos_list();
+    auto rebased_pos_list_iter = rebased_pos_lists.find(pos_list);
+    if (rebased_pos_list_iter == rebased_pos_lists.end()) {
+      auto rebased_pos_list = std::make_shared<PosList>(pos_list->size());
+      auto rebased_row_id_iter = rebased_pos_list->begin();
+      for (const auto& row_id : *pos_list) {
+        // NULL_ROW_IDs (e.g., of outer joins) do not reference any chunk
+        *rebased_row_id_iter = row_id.is_null() ? row_id : RowID{chunk_id, row_id.chunk_offset};
+        ++rebased_row_id_iter;
+      }
+      if (pos_list->references_single_chunk()) rebased_pos_list->guarantee_single_chunk();
+
+      rebased_pos_list_iter = rebased_pos_lists.emplace(pos_list, std::move(rebased_pos_list)).first;
+    }
+
+    segments.emplace_back(std::make_shared<ReferenceSegment>(input_table, reference_segment->referenced_column_id(),
+                                                             rebased_pos_list_iter->second));
+    rebased_any_segment = true;
+  }
+
+  if (!rebased_any_segment) return chunk;
+
+  const auto rebased_chunk = std::make_shared<Chunk>(std::move(segments), chunk->mvcc_data(), chunk->get_allocator());
+  if (chunk->ordered_by()) rebased_chunk->set_ordered_by(*chunk->ordered_by());
+  return rebased_chunk;
+}
+
+}  // namespace
+
+namespace opossum {
+
+MorselPipeline::MorselPipeline(const std::shared_ptr<const AbstractOperator>& in,
+                               const std::vector<std::shared_ptr<AbstractOperator>>& operators,
+                               const std::shared_ptr<const AbstractOperator>& build_input)
+    : AbstractReadOnlyOperator(OperatorType::MorselPipeline, in, build_input), _operators(operators) {
+  Assert(!_operators.empty(), "MorselPipeline needs at least one operator");
+  DebugAssert(std::all_of(_operators.cbegin(), _operators.cend(),
+                          [](const auto& op) { return !op->input_left() && !op->input_right() && is_fusable(*op); }),
+              "Fused operators must be fusable and must not have inputs");
+
+  const auto join_count = std::count_if(_operators.cbegin(), _operators.cend(),
+                                        [](const auto& op) { return op->type() == OperatorType::JoinHash; });
+  Assert(join_count <= 1, "MorselPipeline can contain at most one JoinHash");
+  Assert((join_count == 1) == static_cast<bool>(build_input),
+         "Expected a build input if and only if a JoinHash is fused");
+  Assert(std::none_of(_operators.cbegin(), _operators.cend() - 1,
+                      [](const auto& op) { return op->type() == OperatorType::Aggregate; }),
+         "An AggregateHash can only be the last operator of a MorselPipeline");
+}
+
+const std::vector<std::shared_ptr<AbstractOperator>>& MorselPipeline::operators() const { return _operators; }
+
+const std::string& MorselPipeline::name() const {
+  static const auto name = std::string{"MorselPipeline"};
+  return name;
+}
+
+std::string MorselPipeline::description(DescriptionMode description_mode) const {
+  const auto separator = description_mode == DescriptionMode::MultiLine ? "\n" : " -> ";
+
+  std::stringstream stream;
+  stream << name() << (description_mode == DescriptionMode::MultiLine ? "\n" : " [");
+  for (auto operator_idx = size_t{0}; operator_idx < _operators.size(); ++operator_idx) {
+    if (operator_idx > 0) stream << separator;
+    stream << _operators[operator_idx]->description(description_mode);
+  }
+  if (description_mode == DescriptionMode::SingleLine) stream << "]";
+
+  return stream.str();
+}
+
+bool MorselPipeline::is_fusable(const AbstractOperator& op) {
+  switch (op.type()) {
+    case OperatorType::Validate:
+      return true;
+
+    case OperatorType::TableScan: {
+      const auto& table_scan = static_cast<const TableScan&>(op);
+      return table_scan.excluded_chunk_ids.empty() && !contains_subquery({table_scan.predicate()});
+    }
+
+    case OperatorType::Projection:
+      return !contains_subquery(static_cast<const Projection&>(op).expressions);
+
+    case OperatorType::JoinHash:
+      return JoinHash::supports_shared_hash_tables(static_cast<const JoinHash&>(op).mode());
+
+    case OperatorType::Aggregate:
+      return dynamic_cast<const AggregateHash*>(&op) != nullptr;
+
+    default:
+      return false;
+  }
+}
+
+std::shared_ptr<const Table> MorselPipeline::_on_execute() {
+  const auto input_table = input_table_left();
+  const auto chunk_count = input_table->chunk_count();
+
+  // Without any morsels, the operators still have to determine the layout of the (empty) output table
+  if (chunk_count == 0) return _execute_operators(input_table, _operators.size());
+
+  const auto join_iter = std::find_if(_operators.cbegin(), _operators.cend(),
+                                      [](const auto& op) { return op->type() == OperatorType::JoinHash; });
+  auto shared_hash_tables = std::shared_ptr<const JoinHash::SharedHashTables>{};
+  if (join_iter != _operators.cend()) {
+    const auto& join = static_cast<const JoinHash&>(**join_iter);
+    const auto& build_table = input_table_right();
+
+    // JoinHash builds the hash tables of inner joins from the smaller input. If the right input is larger than even the
+    // unfiltered left input, building them from the right input once would be more expensive than not pipelining.
+    if (join.mode() == JoinMode::Inner && build_table->row_count() > input_table->row_count()) {
+      return _execute_operators(input_table, _operators.size());
+    }
+
+    // The operators below the join determine the data type of the probe column
+    const auto join_operator_idx = static_cast<size_t>(std::distance(_operators.cbegin(), join_iter));
+    const auto empty_table = std::make_shared<Table>(input_table->column_definitions(), input_table->type(),
+                                                     std::vector<std::shared_ptr<Chunk>>{}, input_table->uses_mvcc());
+    const auto empty_probe_table = _execute_operators(empty_table, join_operator_idx);
+    if (!empty_probe_table) return nullptr;
+
+    const auto probe_column_id = join.primary_predicate().column_ids.first;
+    shared_hash_tables = join.build_shared_hash_tables(
+        build_table, empty_probe_table->column_data_type(probe_column_id), input_table->row_count());
+  }
+
+  // An AggregateHash at the top of the chain pre-aggregates each morsel output
+  const auto aggregate = std::dynamic_pointer_cast<const AggregateHash>(_operators.back());
+  const auto morsel_operator_count = aggregate ? _operators.size() - 1 : _operators.size();
+  const auto morsel_pre_aggregation = aggregate ? aggregate->create_morsel_pre_aggregation(chunk_count) : nullptr;
+
+  auto morsel_outputs = std::vector<std::shared_ptr<const Table>>(chunk_count);
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_count);
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto chunk = input_table->get_chunk(chunk_id);
+      Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+      // The chunk is only read by the fused operators, but Table expects mutable chunks
+      const auto morsel_table = std::make_shared<Table>(
+          input_table->column_definitions(), input_table->type(),
+          std::vector<std::shared_ptr<Chunk>>{std::const_pointer_cast<Chunk>(chunk)}, input_table->uses_mvcc());
+
+      morsel_outputs[chunk_id] = _execute_operators(morsel_table, morsel_operator_count, shared_hash_tables);
+      if (!morsel_outputs[chunk_id]) return;
+
+      if (input_table->type() == TableType::Data) {
+        // Operators that reference a data table (e.g., a TableScan directly on a stored table) have referenced the
+        // morsel table, not the input table
+        const auto morsel_output = std::const_pointer_cast<Table>(morsel_outputs[chunk_id]);
+        const auto morsel_output_chunk_count = morsel_output->chunk_count();
+        auto rebased_chunks = std::vector<std::shared_ptr<Chunk>>{};
+        rebased_chunks.reserve(morsel_output_chunk_count);
+        for (auto output_chunk_id = ChunkID{0}; output_chunk_id < morsel_output_chunk_count; ++output_chunk_id) {
+          rebased_chunks.emplace_back(
+              rebase_chunk(morsel_output->get_chunk(output_chunk_id), morsel_table, input_table, chunk_id));
+        }
+        morsel_outputs[chunk_id] =
+            std::make_shared<Table>(morsel_output->column_definitions(), morsel_output->type(),
+                                    std::move(rebased_chunks), morsel_output->uses_mvcc());
+      }
+
+      if (morsel_pre_aggregation) {
+        const auto morsel_output_wrapper = std::make_shared<TableWrapper>(morsel_outputs[chunk_id]);
+        morsel_output_wrapper->execute();
+        const auto morsel_aggregate = aggregate->copy_with_inputs(morsel_output_wrapper, nullptr);
+        static_cast<const AggregateHash&>(*morsel_aggregate).pre_aggregate_morsel(*morsel_pre_aggregation, chunk_id);
+      }
+    }));
+    jobs.back()->schedule();
+  }
+
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+
+  // Projections decide the nullability of computed columns per morsel, so the output columns are nullable if they are
+  // nullable in any morsel
+  auto column_definitions = TableColumnDefinitions{};
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>{};
+  for (const auto& morsel_output : morsel_outputs) {
+    if (!morsel_output) return nullptr;
+
+    if (column_definitions.empty()) {
+      column_definitions = morsel_output->column_definitions();
+    } else {
+      for (auto column_id = ColumnID{0}; column_id < column_definitions.size(); ++column_id) {
+        column_definitions[column_id].nullable =
+            column_definitions[column_id].nullable || morsel_output->column_is_nullable(column_id);
+      }
+    }
+
+    // The partial results of the pre-aggregation reference the chunks of the morsel outputs, so that empty chunks are
+    // kept in that case
+    const auto morsel_output_chunk_count = morsel_output->chunk_count();
+    for (auto output_chunk_id = ChunkID{0}; output_chunk_id < morsel_output_chunk_count; ++output_chunk_id) {
+      const auto output_chunk = std::const_pointer_cast<Table>(morsel_output)->get_chunk(output_chunk_id);
+      if (output_chunk->size() > 0 || morsel_pre_aggregation) output_chunks.emplace_back(output_chunk);
+    }
+  }
+
+  const auto& first_morsel_output = *morsel_outputs.front();
+  const auto output_table = std::make_shared<Table>(column_definitions, first_morsel_output.type(),
+                                                    std::move(output_chunks), first_morsel_output.uses_mvcc());
+  if (!aggregate) return output_table;
+
+  // Merge the partial results of all morsels
+  const auto output_table_wrapper = std::make_shared<TableWrapper>(output_table);
+  output_table_wrapper->execute();
+  const auto merging_aggregate = aggregate->copy_with_inputs(output_table_wrapper, nullptr);
+  static_cast<AggregateHash&>(*merging_aggregate).set_morsel_pre_aggregation(morsel_pre_aggregation);
+  merging_aggregate->execute();
+  return merging_aggregate->get_output();
+}
+
+std::shared_ptr<const Table> MorselPipeline::_execute_operators(
+    const std::shared_ptr<const Table>& table, const size_t operator_count,
+    const std::shared_ptr<const JoinHash::SharedHashTables>& shared_hash_tables) const {
+  auto op = std::shared_ptr<AbstractOperator>{std::make_shared<TableWrapper>(table)};
+  op->execute();
+
+  for (auto operator_idx = size_t{0}; operator_idx < operator_count; ++operator_idx) {
+    const auto& fused_operator = _operators[operator_idx];
+    if (fused_operator->type() == OperatorType::JoinHash) {
+      const auto build_input = std::make_shared<TableWrapper>(input_table_right());
+      build_input->execute();
+      op = fused_operator->copy_with_inputs(op, build_input);
+      if (shared_hash_tables) static_cast<JoinHash&>(*op).set_shared_hash_tables(shared_hash_tables);
+    } else {
+      op = fused_operator->copy_with_inputs(op, nullptr);
+    }
+
+    op->execute();
+    if (!op->get_output()) return nullptr;
+  }
+
+  return op->get_output();
+}
+
+std::shared_ptr<AbstractOperator> MorselPipeline::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_input_left,
+    const std::shared_ptr<AbstractOperator>& copied_input_right) const {
+  auto copied_operators = std::vector<std::shared_ptr<AbstractOperator>>{};
+  copied_operators.reserve(_operators.size());
+  for (const auto& fused_operator : _operators) {
+    copied_operators.emplace_back(fused_operator->copy_with_inputs(nullptr, nullptr));
+  }
+  return std::make_shared<MorselPipeline>(copied_input_left, copied_operators, copied_input_right);
+}
+
+void MorselPipeline::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  for (const auto& fused_operator : _operators) {
+    fused_operator->set_parameters(parameters);
+  }
+}
+
+void MorselPipeline::_on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) {
+  for (const auto& fused_operator : _operators) {
+    fused_operator->set_transaction_context(transaction_context);
+  }
+}
+
+std::shared_ptr<AbstractOperator> create_morsel_pipelines(const std::shared_ptr<AbstractOperator>& pqp) {
+  // Operators consumed by more than one operator (diamonds) have to remain materialized
+  auto consumer_counts = std::unordered_map<const AbstractOperator*, size_t>{};
+  auto visited_operators = std::unordered_set<const AbstractOperator*>{};
+  const auto count_consumers = [&](const auto& self, const std::shared_ptr<AbstractOperator>& op) -> void {
+    if (!visited_operators.emplace(op.get()).second) return;
+    for (const auto& input : {op->mutable_input_left(), op->mutable_input_right()}) {
+      if (!input) continue;
+      ++consumer_counts[input.get()];
+      self(self, input);
+    }
+  };
+  count_consumers(count_consumers, pqp);
+
+  const auto copy_operator = [](const AbstractOperator& op, const std::shared_ptr<AbstractOperator>& input_left,
+                                const std::shared_ptr<AbstractOperator>& input_right) {
+    const auto copied_op = op.copy_with_inputs(input_left, input_right);
+    if (op.type() == OperatorType::TableScan) {
+      static_cast<TableScan&>(*copied_op).excluded_chunk_ids = static_cast<const TableScan&>(op).excluded_chunk_ids;
+    }
+    return copied_op;
+  };
+
+  auto rewritten_operators = std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>{};
+  const auto rewrite = [&](const auto& self,
+                           const std::shared_ptr<AbstractOperator>& op) -> std::shared_ptr<AbstractOperator> {
+    if (!op) return nullptr;
+
+    const auto rewritten_operator_iter = rewritten_operators.find(op.get());
+    if (rewritten_operator_iter != rewritten_operators.end()) return rewritten_operator_iter->second;
+
+    auto rewritten_operator = op;
+
+    // Collect the longest chain of fusable operators that starts at op, from top to bottom. The chain continues through
+    // the left input of a JoinHash, its right input becomes the build input of the MorselPipeline.
+    auto chain = std::vector<std::shared_ptr<AbstractOperator>>{};
+    auto chain_input = op;
+    auto build_input = std::shared_ptr<AbstractOperator>{};
+    while (chain_input && MorselPipeline::is_fusable(*chain_input) &&
+           (chain.empty() || consumer_counts[chain_input.get()] == 1)) {
+      if (chain_input->type() == OperatorType::Aggregate && !chain.empty()) break;
+      if (chain_input->type() == OperatorType::JoinHash) {
+        if (build_input) break;
+        build_input = chain_input->mutable_input_right();
+      }
+
+      chain.emplace_back(chain_input);
+      chain_input = chain_input->mutable_input_left();
+    }
+
+    if (chain.size() >= 2) {
+      auto fused_operators = std::vector<std::shared_ptr<AbstractOperator>>{};
+      fused_operators.reserve(chain.size());
+      for (auto chain_iter = chain.crbegin(); chain_iter != chain.crend(); ++chain_iter) {
+        fused_operators.emplace_back(copy_operator(**chain_iter, nullptr, nullptr));
+      }
+
+      rewritten_operator =
+          std::make_shared<MorselPipeline>(self(self, chain_input), fused_operators, self(self, build_input));
+      rewritten_operator->lqp_node = op->lqp_node;
+      if (op->transaction_context_is_set()) rewritten_operator->set_transaction_context(op->transaction_context());
+    } else {
+      const auto input_left = self(self, op->mutable_input_left());
+      const auto input_right = self(self, op->mutable_input_right());
+      if (input_left != op->mutable_input_left() || input_right != op->mutable_input_right()) {
+        rewritten_operator = copy_operator(*op, input_left, input_right);
+      }
+    }
+
+    rewritten_operators.emplace(op.get(), rewritten_operator);
+    return rewritten_operator;
+  };
+
+  return rewrite(rewrite, pqp);
+}
+
+}  // namespace opossum
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "join_hash.hpp"
+
+namespace opossum {
+
+/**
+ * Executes a chain of operators (see is_fusable()) one input chunk (the "morsel") at a time, instead of letting every
+ * operator of the chain materialize its complete output before the next one starts.
+ *
+ * For every chunk of the input table, a task wraps the chunk into a single-chunk table and pushes it through fresh
+ * copies of all fused operators. While the chain works on the same morsel, the intermediate PosLists and segments are
+ * small and likely to remain in the cache. The morsels are processed concurrently, the output chunks are kept in the
+ * order of the input chunks.
+ *
+ * As the fused operators only see the morsel table, ReferenceSegments that reference the morsel table are rewritten
+ * to reference the input table.
+ *
+ * Two pipeline breakers can be part of the chain, as their blocking phase does not depend on the morsels:
+ *  - A JoinHash whose left input is part of the chain. Its right input is the right input of the MorselPipeline. Its
+ *    hash tables are built once from the right input and then probed by each morsel (see
+ *    JoinHash::build_shared_hash_tables()). Right outer joins are not fused, as their unmatched build rows can only be
+ *    emitted once all morsels are probed. If an inner join's right input is larger than the input of the
+ *    MorselPipeline, where JoinHash would have built the hash tables from the left input, the operators are executed
+ *    one after another instead.
+ *  - An AggregateHash at the top of the chain. Each morsel output is pre-aggregated right after it has been produced,
+ *    only the merge of the partial results waits for all morsels (see AggregateHash::MorselPreAggregation).
+ *
+ * All other pipeline breakers (other joins, sorts, ...) are not fused. They consume the output of the MorselPipeline
+ * below them.
+ */
+class MorselPipeline : public AbstractReadOnlyOperator {
+ public:
+  // @param operators   The fused operators from bottom to top. They serve as templates and are never executed
+  //                    themselves, thus they have no inputs.
+  // @param build_input The right input of the fused JoinHash, if there is one
+  MorselPipeline(const std::shared_ptr<const AbstractOperator>& in,
+                 const std::vector<std::shared_ptr<AbstractOperator>>& operators,
+                 const std::shared_ptr<const AbstractOperator>& build_input = nullptr);
+
+  const std::vector<std::shared_ptr<AbstractOperator>>& operators() const;
+
+  const std::string& name() const override;
+  std::string description(DescriptionMode description_mode = DescriptionMode::SingleLine) const override;
+
+  // Returns whether @param op can be part of a MorselPipeline. This is true for TableScans, Validates, and Projections,
+  // which produce each of their output chunks from a single input chunk, as long as they do not execute subqueries
+  // (which would be re-executed for every morsel) or exclude chunks. It is also true for JoinHashes, except for right
+  // outer joins, and for AggregateHashes. A MorselPipeline contains at most one JoinHash and only has an AggregateHash
+  // as its last operator.
+  static bool is_fusable(const AbstractOperator& op);
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_input_left,
+      const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+  void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) override;
+
+  // Runs copies of the first @param operator_count fused operators on @param table. A fused JoinHash probes
+  // @param shared_hash_tables if they are set. Returns nullptr if the transaction was aborted.
+  std::shared_ptr<const Table> _execute_operators(
+      const std::shared_ptr<const Table>& table, const size_t operator_count,
+      const std::shared_ptr<const JoinHash::SharedHashTables>& shared_hash_tables = nullptr) const;
+
+  const std::vector<std::shared_ptr<AbstractOperator>> _operators;
+};
+
+// Returns a PQP in which every chain of at least two fusable operators (see MorselPipeline::is_fusable()) is replaced
+// by a MorselPipeline. Operators that are consumed more than once end a chain. @param pqp itself is not modified;
+// operators above a replaced chain are copied, all other operators are reused.
+std::shared_ptr<AbstractOperator> create_morsel_pipelines(const std::shared_ptr<AbstractOperator>& pqp);
+
+}  // namespace opossum
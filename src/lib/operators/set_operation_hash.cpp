@@ -0,0 +1,162 @@
+#include "set_operation_hash.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "operators/set_operation_hash/set_operation_hash_steps.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+SetOperationHash::SetOperationHash(const std::shared_ptr<const AbstractOperator>& left_in,
+                                   const std::shared_ptr<const AbstractOperator>& right_in,
+                                   const SetOperationType set_operation_type,
+                                   const SetOperationMode set_operation_mode)
+    : AbstractReadOnlyOperator(OperatorType::SetOperationHash, left_in, right_in),
+      _set_operation_type(set_operation_type),
+      _set_operation_mode(set_operation_mode) {}
+
+const std::string& SetOperationHash::name() const {
+  static const auto name = std::string{"SetOperationHash"};
+  return name;
+}
+
+std::string SetOperationHash::description(DescriptionMode description_mode) const {
+  const auto separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+
+  std::stringstream stream;
+  stream << name() << separator << "(" << _set_operation_type << " " << _set_operation_mode << ")";
+  return stream.str();
+}
+
+SetOperationType SetOperationHash::set_operation_type() const { return _set_operation_type; }
+
+SetOperationMode SetOperationHash::set_operation_mode() const { return _set_operation_mode; }
+
+std::shared_ptr<AbstractOperator> SetOperationHash::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_input_left,
+    const std::shared_ptr<AbstractOperator>& copied_input_right) const {
+  return std::make_shared<SetOperationHash>(copied_input_left, copied_input_right, _set_operation_type,
+                                            _set_operation_mode);
+}
+
+void SetOperationHash::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
+
+std::shared_ptr<const Table> SetOperationHash::_on_execute() {
+  const auto left_table = input_table_left();
+  const auto right_table = input_table_right();
+
+  Assert(left_table->column_count() == right_table->column_count(),
+         "Input tables of a set operation must have the same number of columns");
+
+  auto output_column_definitions = TableColumnDefinitions{};
+  for (auto column_id = ColumnID{0}; column_id < left_table->column_count(); ++column_id) {
+    Assert(left_table->column_data_type(column_id) == right_table->column_data_type(column_id),
+           "Input columns of a set operation must have the same DataType");
+
+    output_column_definitions.emplace_back(
+        left_table->column_name(column_id), left_table->column_data_type(column_id),
+        left_table->column_is_nullable(column_id) || right_table->column_is_nullable(column_id));
+  }
+
+  // The ChunkOffsets of the output rows, per input chunk
+  auto left_offsets = std::vector<std::vector<ChunkOffset>>(left_table->chunk_count());
+  auto right_offsets = std::vector<std::vector<ChunkOffset>>(right_table->chunk_count());
+
+  if (_set_operation_type == SetOperationType::Union && _set_operation_mode == SetOperationMode::All) {
+    // All rows of both inputs are part of the output, there is nothing to compare
+    for (auto [table, offsets] : {std::pair{left_table, &left_offsets}, std::pair{right_table, &right_offsets}}) {
+      const auto chunk_count = table->chunk_count();
+      for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+        const auto chunk = table->get_chunk(chunk_id);
+        Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+        auto& chunk_offsets = (*offsets)[chunk_id];
+        chunk_offsets.resize(chunk->size());
+        std::iota(chunk_offsets.begin(), chunk_offsets.end(), ChunkOffset{0});
+      }
+    }
+  } else {
+    // 1. Materialize and hash the rows of both inputs in parallel
+    auto left_rows = MaterializedRows{left_table};
+    auto right_rows = MaterializedRows{right_table};
+
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    jobs.reserve(left_table->chunk_count() + right_table->chunk_count());
+    left_rows.materialize(jobs);
+    right_rows.materialize(jobs);
+    Hyrise::get().scheduler()->wait_for_tasks(jobs);
+
+    // 2. Count the rows of the right input per group of equal rows
+    auto row_groups = RowGroups{};
+
+    const auto right_chunk_count = right_table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < right_chunk_count; ++chunk_id) {
+      const auto chunk_size = right_table->get_chunk(chunk_id)->size();
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        ++row_groups.find_or_insert(right_rows, RowID{chunk_id, chunk_offset}).right_count;
+      }
+    }
+
+    // 3. Count the rows of the left input in their order and decide for each row whether it is part of the output. As
+    //    left_count is the number of equal left rows up to and including the current one, the decision does not
+    //    depend on later rows. E.g., EXCEPT ALL emits the copies of a row that exceed the right_count copies.
+    const auto left_chunk_count = left_table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < left_chunk_count; ++chunk_id) {
+      const auto chunk_size = left_table->get_chunk(chunk_id)->size();
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        auto& group = row_groups.find_or_insert(left_rows, RowID{chunk_id, chunk_offset});
+        ++group.left_count;
+
+        if (_emit_left_row(group.left_count, group.right_count)) {
+          left_offsets[chunk_id].emplace_back(chunk_offset);
+        }
+      }
+    }
+
+    // 4. For UNION DISTINCT, add the first occurrence of each row that only the right input contains
+    if (_set_operation_type == SetOperationType::Union) {
+      for (const auto& group : row_groups.groups()) {
+        if (group.left_count > 0) continue;
+
+        DebugAssert(group.rows == &right_rows, "Groups without left rows should stem from the right input");
+        right_offsets[group.representative.chunk_id].emplace_back(group.representative.chunk_offset);
+      }
+
+      for (auto& chunk_offsets : right_offsets) {
+        std::sort(chunk_offsets.begin(), chunk_offsets.end());
+      }
+    }
+  }
+
+  // 5. Build the output, referencing the rows of both inputs
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>{};
+  append_reference_chunks(left_table, left_offsets, output_chunks);
+  append_reference_chunks(right_table, right_offsets, output_chunks);
+
+  return std::make_shared<Table>(output_column_definitions, TableType::References, std::move(output_chunks));
+}
+
+bool SetOperationHash::_emit_left_row(const size_t left_count, const size_t right_count) const {
+  const auto distinct = _set_operation_mode == SetOperationMode::Distinct;
+
+  switch (_set_operation_type) {
+    case SetOperationType::Union:
+      return !distinct || left_count == 1;
+    case SetOperationType::Intersect:
+      return distinct ? left_count == 1 && right_count > 0 : left_count <= right_count;
+    case SetOperationType::Except:
+      return distinct ? left_count == 1 && right_count == 0 : left_count > right_count;
+  }
+  Fail("Invalid enum value");
+}
+
+}  // namespace opossum
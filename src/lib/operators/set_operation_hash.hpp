@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "abstract_read_only_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Hash-based implementation of the SQL set operations UNION, INTERSECT, and EXCEPT, with either DISTINCT or ALL
+ * semantics (see SetOperationType and SetOperationMode). Two rows are equal if all their values are equal, where NULLs
+ * are not distinct from each other.
+ *
+ * Both inputs are materialized chunk by chunk in parallel, with typed values and a hash per row (see
+ * set_operation_hash_steps.hpp). Equal rows are then grouped in a hash table that counts the rows of each input.
+ *
+ * The inputs need to have the same number of columns and the same DataTypes, the column names are taken from the left
+ * input. The output references the rows of the inputs: Rows of the left input come first and keep their order, rows of
+ * the right input (only for UNION) follow. For the DISTINCT modes, the first occurrence of a row is part of the output.
+ */
+class SetOperationHash : public AbstractReadOnlyOperator {
+ public:
+  SetOperationHash(const std::shared_ptr<const AbstractOperator>& left_in,
+                   const std::shared_ptr<const AbstractOperator>& right_in,
+                   const SetOperationType set_operation_type, const SetOperationMode set_operation_mode);
+
+  const std::string& name() const override;
+  std::string description(DescriptionMode description_mode) const override;
+
+  SetOperationType set_operation_type() const;
+  SetOperationMode set_operation_mode() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_input_left,
+      const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+
+  // Whether a row of the left input is part of the output, given the counts of its group after the row was counted
+  bool _emit_left_row(const size_t left_count, const size_t right_count) const;
+
+  const SetOperationType _set_operation_type;
+  const SetOperationMode _set_operation_mode;
+};
+
+}  // namespace opossum
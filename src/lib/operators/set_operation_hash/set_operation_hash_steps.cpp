@@ -0,0 +1,170 @@
+#include "set_operation_hash_steps.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "hyrise.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+MaterializedRows::MaterializedRows(const std::shared_ptr<const Table>& table)
+    : _table(table), _hashes(table->chunk_count()) {
+  const auto chunk_count = _table->chunk_count();
+  for (auto column_id = ColumnID{0}; column_id < _table->column_count(); ++column_id) {
+    resolve_data_type(_table->column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      _columns.emplace_back(std::make_unique<MaterializedColumn<ColumnDataType>>(chunk_count));
+    });
+  }
+}
+
+void MaterializedRows::materialize(std::vector<std::shared_ptr<AbstractTask>>& jobs) {
+  const auto chunk_count = _table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([this, chunk_id]() { _materialize_chunk(chunk_id); }));
+    jobs.back()->schedule();
+  }
+}
+
+bool MaterializedRows::rows_equal(const RowID& row_id, const MaterializedRows& other,
+                                  const RowID& other_row_id) const {
+  if (hash(row_id) != other.hash(other_row_id)) return false;
+
+  for (auto column_index = size_t{0}; column_index < _columns.size(); ++column_index) {
+    if (!_columns[column_index]->values_equal(row_id, *other._columns[column_index], other_row_id)) return false;
+  }
+
+  return true;
+}
+
+const std::shared_ptr<const Table>& MaterializedRows::table() const { return _table; }
+
+void MaterializedRows::_materialize_chunk(const ChunkID chunk_id) {
+  const auto chunk = _table->get_chunk(chunk_id);
+  Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+  const auto chunk_size = chunk->size();
+  auto& hashes = _hashes[chunk_id];
+  hashes.resize(chunk_size);
+
+  for (auto column_id = ColumnID{0}; column_id < _table->column_count(); ++column_id) {
+    resolve_data_type(_table->column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      auto& column = static_cast<MaterializedColumn<ColumnDataType>&>(*_columns[column_id]);
+      auto& values = column.values[chunk_id];
+      auto& null_values = column.null_values[chunk_id];
+      values.resize(chunk_size);
+      null_values.resize(chunk_size);
+
+      segment_iterate<ColumnDataType>(*chunk->get_segment(column_id), [&](const auto& position) {
+        const auto chunk_offset = position.chunk_offset();
+        if (position.is_null()) {
+          null_values[chunk_offset] = true;
+          boost::hash_combine(hashes[chunk_offset], size_t{0});
+        } else {
+          values[chunk_offset] = position.value();
+          boost::hash_combine(hashes[chunk_offset], position.value());
+        }
+      });
+    });
+  }
+}
+
+RowGroups::Group* RowGroups::find(const MaterializedRows& rows, const RowID& row_id) {
+  const auto first_group_iter = _first_group_index_by_hash.find(rows.hash(row_id));
+  if (first_group_iter == _first_group_index_by_hash.end()) return nullptr;
+
+  for (auto group_index = first_group_iter->second; group_index != NO_GROUP;
+       group_index = _groups[group_index].next_group_index) {
+    auto& group = _groups[group_index];
+    if (rows.rows_equal(row_id, *group.rows, group.representative)) return &group;
+  }
+
+  return nullptr;
+}
+
+RowGroups::Group& RowGroups::find_or_insert(const MaterializedRows& rows, const RowID& row_id) {
+  const auto [first_group_iter, inserted] = _first_group_index_by_hash.try_emplace(rows.hash(row_id), _groups.size());
+
+  if (!inserted) {
+    auto group_index = first_group_iter->second;
+    while (true) {
+      auto& group = _groups[group_index];
+      if (rows.rows_equal(row_id, *group.rows, group.representative)) return group;
+
+      if (group.next_group_index == NO_GROUP) {
+        group.next_group_index = _groups.size();
+        break;
+      }
+      group_index = group.next_group_index;
+    }
+  }
+
+  _groups.emplace_back(Group{&rows, row_id, 0, 0, NO_GROUP});
+  return _groups.back();
+}
+
+const std::vector<RowGroups::Group>& RowGroups::groups() const { return _groups; }
+
+void append_reference_chunks(const std::shared_ptr<const Table>& input_table,
+                             const std::vector<std::vector<ChunkOffset>>& offsets,
+                             std::vector<std::shared_ptr<Chunk>>& output_chunks) {
+  const auto chunk_count = input_table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto& chunk_offsets = offsets[chunk_id];
+    if (chunk_offsets.empty()) continue;
+
+    const auto chunk = input_table->get_chunk(chunk_id);
+    Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+    // Segments that reference the same PosList share their output PosList (see table_scan.hpp). The PosList of data
+    // segments is stored under nullptr.
+    auto output_pos_lists = std::unordered_map<std::shared_ptr<const PosList>, std::shared_ptr<PosList>>{};
+
+    auto output_segments = Segments{};
+    for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+      const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(column_id));
+      const auto input_pos_list = reference_segment ? reference_segment->pos_list() : nullptr;
+
+      auto& output_pos_list = output_pos_lists[input_pos_list];
+      if (!output_pos_list) {
+        output_pos_list = std::make_shared<PosList>();
+        output_pos_list->reserve(chunk_offsets.size());
+
+        if (input_pos_list) {
+          for (const auto chunk_offset : chunk_offsets) {
+            output_pos_list->emplace_back((*input_pos_list)[chunk_offset]);
+          }
+          if (input_pos_list->references_single_chunk()) output_pos_list->guarantee_single_chunk();
+        } else {
+          for (const auto chunk_offset : chunk_offsets) {
+            output_pos_list->emplace_back(RowID{chunk_id, chunk_offset});
+          }
+          output_pos_list->guarantee_single_chunk();
+        }
+      }
+
+      if (reference_segment) {
+        output_segments.emplace_back(std::make_shared<ReferenceSegment>(
+            reference_segment->referenced_table(), reference_segment->referenced_column_id(), output_pos_list));
+      } else {
+        output_segments.emplace_back(std::make_shared<ReferenceSegment>(input_table, column_id, output_pos_list));
+      }
+    }
+
+    output_chunks.emplace_back(std::make_shared<Chunk>(output_segments));
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/chunk.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractTask;
+class Table;
+
+/**
+ * Building blocks of the hash-based set operators (SetOperationHash and Difference). Rows are compared with the typed
+ * values of all their columns. As in SQL set operations, NULLs are not distinct from each other.
+ */
+
+class BaseMaterializedColumn {
+ public:
+  virtual ~BaseMaterializedColumn() = default;
+
+  virtual bool values_equal(const RowID& row_id, const BaseMaterializedColumn& other,
+                            const RowID& other_row_id) const = 0;
+};
+
+// The values of one column of a table, one vector per chunk
+template <typename T>
+class MaterializedColumn : public BaseMaterializedColumn {
+ public:
+  explicit MaterializedColumn(const ChunkID chunk_count) : values(chunk_count), null_values(chunk_count) {}
+
+  bool values_equal(const RowID& row_id, const BaseMaterializedColumn& other,
+                    const RowID& other_row_id) const final {
+    const auto& typed_other = static_cast<const MaterializedColumn<T>&>(other);
+
+    const auto is_null = null_values[row_id.chunk_id][row_id.chunk_offset];
+    const auto other_is_null = typed_other.null_values[other_row_id.chunk_id][other_row_id.chunk_offset];
+    if (is_null || other_is_null) return is_null && other_is_null;
+
+    return values[row_id.chunk_id][row_id.chunk_offset] ==
+           typed_other.values[other_row_id.chunk_id][other_row_id.chunk_offset];
+  }
+
+  std::vector<std::vector<T>> values;
+  std::vector<std::vector<bool>> null_values;
+};
+
+// The rows of a table, materialized column by column, together with a hash of each row
+class MaterializedRows : private Noncopyable {
+ public:
+  explicit MaterializedRows(const std::shared_ptr<const Table>& table);
+
+  // Schedules one job per chunk that materializes and hashes the rows of the chunk. The jobs are appended to @param
+  // jobs so that the caller can wait for the jobs of multiple tables at once.
+  void materialize(std::vector<std::shared_ptr<AbstractTask>>& jobs);
+
+  size_t hash(const RowID& row_id) const { return _hashes[row_id.chunk_id][row_id.chunk_offset]; }
+
+  bool rows_equal(const RowID& row_id, const MaterializedRows& other, const RowID& other_row_id) const;
+
+  const std::shared_ptr<const Table>& table() const;
+
+ protected:
+  void _materialize_chunk(const ChunkID chunk_id);
+
+  const std::shared_ptr<const Table> _table;
+  std::vector<std::unique_ptr<BaseMaterializedColumn>> _columns;
+  std::vector<std::vector<size_t>> _hashes;
+};
+
+// Groups equal rows of one or two MaterializedRows and counts how many rows of the left and right input each group has
+class RowGroups {
+ public:
+  struct Group {
+    // The first row that was added to the group
+    const MaterializedRows* rows;
+    RowID representative;
+
+    size_t left_count{0};
+    size_t right_count{0};
+
+    // Groups with the same hash are chained
+    size_t next_group_index;
+  };
+
+  // Returns the group of the row @param row_id of @param rows, or nullptr if no equal row was added before
+  Group* find(const MaterializedRows& rows, const RowID& row_id);
+
+  // Returns the group of the row @param row_id of @param rows and creates the group if it does not exist yet. The
+  // reference is invalidated by the next call of find_or_insert().
+  Group& find_or_insert(const MaterializedRows& rows, const RowID& row_id);
+
+  const std::vector<Group>& groups() const;
+
+ protected:
+  static constexpr auto NO_GROUP = std::numeric_limits<size_t>::max();
+
+  std::unordered_map<size_t, size_t> _first_group_index_by_hash;
+  std::vector<Group> _groups;
+};
+
+// Appends one chunk for each chunk of @param input_table that has rows in @param offsets (the sorted ChunkOffsets of
+// the rows per chunk) to @param output_chunks. ReferenceSegments are dereferenced, so that the output chunks reference
+// the same data tables as the input.
+void append_reference_chunks(const std::shared_ptr<const Table>& input_table,
+                             const std::vector<std::vector<ChunkOffset>>& offsets,
+                             std::vector<std::shared_ptr<Chunk>>& output_chunks);
+
+}  // namespace opossum
@@ -1,260 +1,433 @@
 #include "sort.hpp"
 
-#include <functional>
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <queue>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "storage/reference_segment.hpp"
+#include "hyrise.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/segment_accessor.hpp"
 #include "storage/segment_iterate.hpp"
 #include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+/**
+ * Normalized keys
+ *
+ * The sort columns of a row are encoded into a byte string (the key) so that comparing two keys with memcmp yields the
+ * order of the rows. For each sort column, the key holds a marker byte followed by the encoded value:
+ *  - The marker tells NULLs from values. Depending on the OrderByMode, the marker of NULLs is smaller or larger than
+ *    that of values.
+ *  - Integers are stored big-endian with their sign bit flipped, so that negative values come first.
+ *  - Floating point numbers are stored big-endian. For positive numbers, the sign bit is flipped; for negative numbers,
+ *    all bits are flipped so that larger magnitudes come first.
+ *  - Strings are terminated by two zero bytes, and zero bytes within the string are escaped as 0x00 0xFF. Thus, a
+ *    string comes before all strings that it is a prefix of, and the end of the string is unambiguous.
+ *  - For descending columns, all bytes of the encoded value are inverted.
+ * NULLs take up as many bytes as a value of the column (zeros for fixed-size types, none for strings), so that the
+ * following columns are compared at the same positions.
+ */
+
+constexpr auto NULLS_FIRST_MARKER = uint8_t{0x00};
+constexpr auto VALUE_MARKER = uint8_t{0x01};
+constexpr auto NULLS_LAST_MARKER = uint8_t{0x02};
+
+template <typename UnsignedType>
+void encode_big_endian(const UnsignedType value, uint8_t* key) {
+  for (auto byte_index = size_t{0}; byte_index < sizeof(UnsignedType); ++byte_index) {
+    key[byte_index] = static_cast<uint8_t>(value >> ((sizeof(UnsignedType) - 1 - byte_index) * 8));
+  }
+}
 
-namespace opossum {
+// Number of bytes that a non-NULL value takes up in the key
+template <typename ColumnDataType>
+size_t encoded_size(const ColumnDataType& value) {
+  if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+    return value.size() + static_cast<size_t>(std::count(value.begin(), value.end(), '\0')) + 2;
+  } else {
+    return sizeof(ColumnDataType);
+  }
+}
 
-Sort::Sort(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id, const OrderByMode order_by_mode,
-           const size_t output_chunk_size)
-    : AbstractReadOnlyOperator(OperatorType::Sort, in),
-      _column_id(column_id),
-      _order_by_mode(order_by_mode),
-      _output_chunk_size(output_chunk_size) {}
+// Writes the encoded value to @param key, which must have room for encoded_size(value) bytes
+template <typename ColumnDataType>
+void encode_value(const ColumnDataType& value, uint8_t* key) {
+  if constexpr (std::is_integral_v<ColumnDataType>) {
+    using UnsignedType = std::make_unsigned_t<ColumnDataType>;
+    constexpr auto sign_bit = UnsignedType{1} << (sizeof(ColumnDataType) * 8 - 1);
+    encode_big_endian(static_cast<UnsignedType>(static_cast<UnsignedType>(value) ^ sign_bit), key);
+  } else if constexpr (std::is_floating_point_v<ColumnDataType>) {
+    using UnsignedType = std::conditional_t<sizeof(ColumnDataType) == 4, uint32_t, uint64_t>;
+    constexpr auto sign_bit = UnsignedType{1} << (sizeof(ColumnDataType) * 8 - 1);
+
+    // -0.0 and 0.0 are equal, so they need to have the same key
+    const auto normalized_value = value == ColumnDataType{0} ? ColumnDataType{0} : value;
+    auto bits = UnsignedType{};
+    std::memcpy(&bits, &normalized_value, sizeof(ColumnDataType));
+    encode_big_endian(static_cast<UnsignedType>((bits & sign_bit) ? ~bits : bits | sign_bit), key);
+  } else {
+    for (const auto character : value) {
+      *key++ = static_cast<uint8_t>(character);
+      if (character == '\0') *key++ = uint8_t{0xFF};
+    }
+    *key++ = uint8_t{0x00};
+    *key = uint8_t{0x00};
+  }
+}
 
-ColumnID Sort::column_id() const { return _column_id; }
+// A row of a sorted run. The first bytes of the key are copied into key_prefix, so that most comparisons do not need to
+// access the key buffer.
+struct SortEntry {
+  uint64_t key_prefix;
+  const uint8_t* key;
+  uint32_t key_size;
+  RowID row_id;
+};
 
-OrderByMode Sort::order_by_mode() const { return _order_by_mode; }
+bool operator<(const SortEntry& lhs, const SortEntry& rhs) {
+  if (lhs.key_prefix != rhs.key_prefix) return lhs.key_prefix < rhs.key_prefix;
 
-const std::string& Sort::name() const {
-  static const auto name = std::string{"Sort"};
-  return name;
-}
+  const auto result = std::memcmp(lhs.key, rhs.key, std::min(lhs.key_size, rhs.key_size));
+  if (result != 0) return result < 0;
+  if (lhs.key_size != rhs.key_size) return lhs.key_size < rhs.key_size;
 
-std::shared_ptr<AbstractOperator> Sort::_on_deep_copy(
-    const std::shared_ptr<AbstractOperator>& copied_input_left,
-    const std::shared_ptr<AbstractOperator>& copied_input_right) const {
-  return std::make_shared<Sort>(copied_input_left, _column_id, _order_by_mode, _output_chunk_size);
+  // Rows with equal keys keep their input order, which makes the sort stable
+  return lhs.row_id < rhs.row_id;
 }
 
-void Sort::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
+// The rows of one input chunk in sorted order, together with the buffer that holds their keys
+struct SortRun {
+  std::vector<uint8_t> key_buffer;
+  std::vector<SortEntry> entries;
+};
 
-std::shared_ptr<const Table> Sort::_on_execute() {
-  _impl = make_unique_by_data_type<AbstractReadOnlyOperatorImpl, SortImpl>(
-      input_table_left()->column_data_type(_column_id), input_table_left(), _column_id, _order_by_mode,
-      _output_chunk_size);
-  return _impl->_on_execute();
-}
+SortRun create_sorted_run(const Table& table, const ChunkID chunk_id,
+                          const std::vector<SortColumnDefinition>& sort_definitions) {
+  const auto chunk = table.get_chunk(chunk_id);
+  Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+  const auto row_count = chunk->size();
+
+  // 1. Determine the size of each key. Only strings have a variable size.
+  auto key_sizes = std::vector<uint32_t>(row_count, 0);
+  for (const auto& sort_definition : sort_definitions) {
+    resolve_data_type(table.column_data_type(sort_definition.column), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+        segment_iterate<ColumnDataType>(*chunk->get_segment(sort_definition.column), [&](const auto& position) {
+          key_sizes[position.chunk_offset()] +=
+              static_cast<uint32_t>(1 + (position.is_null() ? 0 : encoded_size(position.value())));
+        });
+      } else {
+        for (auto& key_size : key_sizes) {
+          key_size += static_cast<uint32_t>(1 + sizeof(ColumnDataType));
+        }
+      }
+    });
+  }
 
-void Sort::_on_cleanup() { _impl.reset(); }
+  auto key_offsets = std::vector<size_t>(row_count + 1, 0);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+    key_offsets[chunk_offset + 1] = key_offsets[chunk_offset] + key_sizes[chunk_offset];
+  }
 
-// This class fulfills only the materialization task for a sorted row_id_value_vector.
-template <typename SortColumnType>
-class Sort::SortImplMaterializeOutput {
- public:
-  // creates a new table with reference segments
-  SortImplMaterializeOutput(const std::shared_ptr<const Table>& in,
-                            const std::shared_ptr<std::vector<std::pair<RowID, SortColumnType>>>& id_value_map,
-                            const size_t output_chunk_size)
-      : _table_in(in), _output_chunk_size(output_chunk_size), _row_id_value_vector(id_value_map) {}
+  // 2. Write the keys column by column. write_positions[chunk_offset] points to the end of the part of the row's key
+  //    that has been written so far.
+  auto run = SortRun{};
+  run.key_buffer.resize(key_offsets.back());
+  auto write_positions = std::vector<size_t>(key_offsets.begin(), key_offsets.end() - 1);
 
-  std::shared_ptr<Table> execute() {
-    // First we create a new table as the output
-    auto output = std::make_shared<Table>(_table_in->column_definitions(), TableType::Data, _output_chunk_size);
+  for (const auto& sort_definition : sort_definitions) {
+    const auto order_by_mode = sort_definition.order_by_mode;
+    const auto descending =
+        order_by_mode == OrderByMode::Descending || order_by_mode == OrderByMode::DescendingNullsLast;
+    const auto null_marker = order_by_mode == OrderByMode::Ascending || order_by_mode == OrderByMode::Descending
+                                 ? NULLS_FIRST_MARKER
+                                 : NULLS_LAST_MARKER;
 
-    // We have decided against duplicating MVCC data in https://github.com/hyrise/hyrise/issues/408
+    resolve_data_type(table.column_data_type(sort_definition.column), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
 
-    // After we created the output table and initialized the column structure, we can start adding values. Because the
-    // values are not ordered by input chunks anymore, we can't process them chunk by chunk. Instead the values are
-    // copied column by column for each output row. For each column in a row we visit the input segment with a reference
-    // to the output segment. This enables for the SortImplMaterializeOutput class to ignore the column types during the
-    // copying of the values.
-    const auto row_count_out = _row_id_value_vector->size();
+      segment_iterate<ColumnDataType>(*chunk->get_segment(sort_definition.column), [&](const auto& position) {
+        auto& write_position = write_positions[position.chunk_offset()];
+        auto* key = run.key_buffer.data() + write_position;
 
-    // Ceiling of integer division
-    const auto div_ceil = [](auto x, auto y) { return (x + y - 1u) / y; };
+        if (position.is_null()) {
+          // The buffer is zero-initialized, so the remaining bytes of fixed-size types are already set
+          *key = null_marker;
+          write_position += 1 + (std::is_same_v<ColumnDataType, pmr_string> ? 0 : sizeof(ColumnDataType));
+          return;
+        }
 
-    const auto chunk_count_out = div_ceil(row_count_out, _output_chunk_size);
+        *key = VALUE_MARKER;
+        const auto value_size = encoded_size(position.value());
+        encode_value(position.value(), key + 1);
+        if (descending) {
+          std::transform(key + 1, key + 1 + value_size, key + 1,
+                         [](const uint8_t byte) { return static_cast<uint8_t>(~byte); });
+        }
+        write_position += 1 + value_size;
+      });
+    });
+  }
 
-    // Vector of segments for each chunk
-    std::vector<Segments> output_segments_by_chunk(chunk_count_out);
+  // 3. Sort the rows of the chunk
+  run.entries.resize(row_count);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+    auto& entry = run.entries[chunk_offset];
+    entry.key = run.key_buffer.data() + key_offsets[chunk_offset];
+    entry.key_size = key_sizes[chunk_offset];
+    entry.row_id = RowID{chunk_id, chunk_offset};
+
+    entry.key_prefix = 0;
+    const auto prefix_size = std::min(entry.key_size, uint32_t{sizeof(uint64_t)});
+    for (auto byte_index = uint32_t{0}; byte_index < prefix_size; ++byte_index) {
+      entry.key_prefix |= static_cast<uint64_t>(entry.key[byte_index]) << ((sizeof(uint64_t) - 1 - byte_index) * 8);
+    }
+  }
 
-    // Materialize segment-wise
-    for (ColumnID column_id{0u}; column_id < output->column_count(); ++column_id) {
-      const auto column_data_type = output->column_data_type(column_id);
+  std::sort(run.entries.begin(), run.entries.end());
 
-      resolve_data_type(column_data_type, [&](auto type) {
-        using ColumnDataType = typename decltype(type)::type;
+  return run;
+}
 
-        auto chunk_it = output_segments_by_chunk.begin();
-        auto chunk_offset_out = 0u;
+/**
+ * Merges the sorted runs into the RowIDs of the output. The output is split into partitions that are merged by
+ * separate tasks. The partition boundaries are taken from a sample of all runs, so that each partition covers a
+ * similar number of rows. Within each run, a partition starts at the first entry that is not less than its splitter.
+ */
+std::vector<RowID> merge_runs(const std::vector<SortRun>& runs, const size_t row_count) {
+  auto row_ids = std::vector<RowID>(row_count);
+  const auto run_count = runs.size();
+
+  if (run_count == 1) {
+    std::transform(runs.front().entries.begin(), runs.front().entries.end(), row_ids.begin(),
+                   [](const auto& entry) { return entry.row_id; });
+    return row_ids;
+  }
 
-        auto value_segment_value_vector = pmr_concurrent_vector<ColumnDataType>();
-        auto value_segment_null_vector = pmr_concurrent_vector<bool>();
+  const auto partition_count = std::max(size_t{1}, std::min(run_count, size_t{std::thread::hardware_concurrency()}));
 
-        value_segment_value_vector.reserve(row_count_out);
-        value_segment_null_vector.reserve(row_count_out);
+  auto samples = std::vector<SortEntry>{};
+  samples.reserve(run_count * partition_count);
+  for (const auto& run : runs) {
+    for (auto sample_index = size_t{0}; sample_index < partition_count && !run.entries.empty(); ++sample_index) {
+      samples.emplace_back(run.entries[run.entries.size() * sample_index / partition_count]);
+    }
+  }
+  std::sort(samples.begin(), samples.end());
+
+  // All runs are empty, there are no splitters to partition by
+  if (samples.empty()) return row_ids;
+
+  // partition_begins[partition_index][run_index] is the first entry of the run that belongs to the partition
+  auto partition_begins = std::vector<std::vector<size_t>>(partition_count + 1, std::vector<size_t>(run_count, 0));
+  for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+    const auto& entries = runs[run_index].entries;
+    for (auto partition_index = size_t{1}; partition_index < partition_count; ++partition_index) {
+      const auto& splitter = samples[samples.size() * partition_index / partition_count];
+      partition_begins[partition_index][run_index] =
+          std::lower_bound(entries.begin(), entries.end(), splitter) - entries.begin();
+    }
+    partition_begins[partition_count][run_index] = entries.size();
+  }
 
-        auto segment_ptr_and_accessor_by_chunk_id =
-            std::unordered_map<ChunkID, std::pair<std::shared_ptr<const BaseSegment>,
-                                                  std::shared_ptr<AbstractSegmentAccessor<ColumnDataType>>>>();
-        segment_ptr_and_accessor_by_chunk_id.reserve(row_count_out);
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(partition_count);
+
+  auto output_begin = size_t{0};
+  for (auto partition_index = size_t{0}; partition_index < partition_count; ++partition_index) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_index, output_begin]() {
+      auto cursors = partition_begins[partition_index];
+      const auto& ends = partition_begins[partition_index + 1];
+
+      // The heap holds the index of each run that still has entries in this partition. Its top is the run with the
+      // smallest current entry.
+      const auto comparator = [&](const size_t lhs, const size_t rhs) {
+        return runs[rhs].entries[cursors[rhs]] < runs[lhs].entries[cursors[lhs]];
+      };
+      auto heap = std::priority_queue<size_t, std::vector<size_t>, decltype(comparator)>{comparator};
+      for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+        if (cursors[run_index] < ends[run_index]) heap.push(run_index);
+      }
 
-        for (auto row_index = 0u; row_index < row_count_out; ++row_index) {
-          const auto [chunk_id, chunk_offset] = _row_id_value_vector->at(row_index).first;
+      auto output_position = output_begin;
+      while (!heap.empty()) {
+        const auto run_index = heap.top();
+        heap.pop();
 
-          auto& segment_ptr_and_typed_ptr_pair = segment_ptr_and_accessor_by_chunk_id[chunk_id];
-          auto& base_segment = segment_ptr_and_typed_ptr_pair.first;
-          auto& accessor = segment_ptr_and_typed_ptr_pair.second;
+        row_ids[output_position] = runs[run_index].entries[cursors[run_index]].row_id;
+        ++output_position;
 
-          if (!base_segment) {
-            base_segment = _table_in->get_chunk(chunk_id)->get_segment(column_id);
-            accessor = create_segment_accessor<ColumnDataType>(base_segment);
-          }
+        ++cursors[run_index];
+        if (cursors[run_index] < ends[run_index]) heap.push(run_index);
+      }
+    }));
+    jobs.back()->schedule();
 
-          // If the input segment is not a ReferenceSegment, we can take a fast(er) path
-          if (accessor) {
-            const auto typed_value = accessor->access(chunk_offset);
-            const auto is_null = !typed_value;
-            value_segment_value_vector.push_back(is_null ? ColumnDataType{} : typed_value.value());
-            value_segment_null_vector.push_back(is_null);
-          } else {
-            const auto value = (*base_segment)[chunk_offset];
-            const auto is_null = variant_is_null(value);
-            value_segment_value_vector.push_back(is_null ? ColumnDataType{} : boost::get<ColumnDataType>(value));
-            value_segment_null_vector.push_back(is_null);
-          }
+    for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+      output_begin +=
+          partition_begins[partition_index + 1][run_index] - partition_begins[partition_index][run_index];
+    }
+  }
 
-          ++chunk_offset_out;
-
-          // Check if value segment is full
-          if (chunk_offset_out >= _output_chunk_size) {
-            chunk_offset_out = 0u;
-            auto value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector),
-                                                                                std::move(value_segment_null_vector));
-            chunk_it->push_back(value_segment);
-            value_segment_value_vector = pmr_concurrent_vector<ColumnDataType>();
-            value_segment_null_vector = pmr_concurrent_vector<bool>();
-            ++chunk_it;
-          }
-        }
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
 
-        // Last segment has not been added
-        if (chunk_offset_out > 0u) {
-          auto value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector),
-                                                                              std::move(value_segment_null_vector));
-          chunk_it->push_back(value_segment);
-        }
-      });
-    }
+  return row_ids;
+}
 
-    for (auto& segments : output_segments_by_chunk) {
-      output->append_chunk(segments);
-    }
+}  // namespace
 
-    return output;
-  }
+namespace opossum {
 
- protected:
-  const std::shared_ptr<const Table> _table_in;
-  const size_t _output_chunk_size;
-  const std::shared_ptr<std::vector<std::pair<RowID, SortColumnType>>> _row_id_value_vector;
-};
+Sort::Sort(const std::shared_ptr<const AbstractOperator>& in,
+           const std::vector<SortColumnDefinition>& sort_definitions, const size_t output_chunk_size)
+    : AbstractReadOnlyOperator(OperatorType::Sort, in),
+      _sort_definitions(sort_definitions),
+      _output_chunk_size(output_chunk_size) {
+  Assert(!_sort_definitions.empty(), "Expected at least one sort criterion");
+}
 
-// we need to use the impl pattern because the scan operator of the sort depends on the type of the column
-template <typename SortColumnType>
-class Sort::SortImpl : public AbstractReadOnlyOperatorImpl {
- public:
-  using RowIDValuePair = std::pair<RowID, SortColumnType>;
-
-  SortImpl(const std::shared_ptr<const Table>& table_in, const ColumnID column_id,
-           const OrderByMode order_by_mode = OrderByMode::Ascending, const size_t output_chunk_size = 0)
-      : _table_in(table_in),
-        _column_id(column_id),
-        _order_by_mode(order_by_mode),
-        _output_chunk_size(output_chunk_size) {
-    // initialize a structure which can be sorted by std::sort
-    _row_id_value_vector = std::make_shared<std::vector<RowIDValuePair>>();
-    _null_value_rows = std::make_shared<std::vector<RowIDValuePair>>();
-  }
+Sort::Sort(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id, const OrderByMode order_by_mode,
+           const size_t output_chunk_size)
+    : Sort(in, std::vector<SortColumnDefinition>{SortColumnDefinition{column_id, order_by_mode}}, output_chunk_size) {}
 
- protected:
-  std::shared_ptr<const Table> _on_execute() override {
-    // 1. Prepare Sort: Creating rowid-value-Structure
-    _materialize_sort_column();
+const std::vector<SortColumnDefinition>& Sort::sort_definitions() const { return _sort_definitions; }
 
-    // 2. After we got our ValueRowID Map we sort the map by the value of the pair
-    if (_order_by_mode == OrderByMode::Ascending || _order_by_mode == OrderByMode::AscendingNullsLast) {
-      _sort_with_operator<std::less<>>();
-    } else {
-      _sort_with_operator<std::greater<>>();
-    }
+ColumnID Sort::column_id() const { return _sort_definitions.front().column; }
 
-    // 2b. Insert null rows if necessary
-    if (!_null_value_rows->empty()) {
-      if (_order_by_mode == OrderByMode::AscendingNullsLast || _order_by_mode == OrderByMode::DescendingNullsLast) {
-        // NULLs last
-        _row_id_value_vector->insert(_row_id_value_vector->end(), _null_value_rows->begin(), _null_value_rows->end());
-      } else {
-        // NULLs first (default behavior)
-        _row_id_value_vector->insert(_row_id_value_vector->begin(), _null_value_rows->begin(), _null_value_rows->end());
-      }
-    }
+OrderByMode Sort::order_by_mode() const { return _sort_definitions.front().order_by_mode; }
 
-    // 3. Materialization of the result: We take the sorted ValueRowID Vector, create chunks fill them until they are
-    // full and create the next one. Each chunk is filled row by row.
-    auto materialization = std::make_shared<SortImplMaterializeOutput<SortColumnType>>(_table_in, _row_id_value_vector,
-                                                                                       _output_chunk_size);
-    auto output = materialization->execute();
+const std::string& Sort::name() const {
+  static const auto name = std::string{"Sort"};
+  return name;
+}
 
-    const auto chunk_count = output->chunk_count();
-    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
-      output->get_chunk(chunk_id)->set_ordered_by(std::make_pair(_column_id, _order_by_mode));
-    }
+std::string Sort::description(DescriptionMode description_mode) const {
+  const auto separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
 
-    return output;
+  std::stringstream stream;
+  stream << name() << separator << "(";
+  for (auto definition_idx = size_t{0}; definition_idx < _sort_definitions.size(); ++definition_idx) {
+    if (definition_idx > 0) stream << ", ";
+    stream << "Column #" << _sort_definitions[definition_idx].column << " "
+           << _sort_definitions[definition_idx].order_by_mode;
   }
+  stream << ")";
+  return stream.str();
+}
 
-  // completely materializes the sort column to create a vector of RowID-Value pairs
-  void _materialize_sort_column() {
-    auto& row_id_value_vector = *_row_id_value_vector;
-    row_id_value_vector.reserve(_table_in->row_count());
+std::shared_ptr<AbstractOperator> Sort::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_input_left,
+    const std::shared_ptr<AbstractOperator>& copied_input_right) const {
+  return std::make_shared<Sort>(copied_input_left, _sort_definitions, _output_chunk_size);
+}
 
-    auto& null_value_rows = *_null_value_rows;
+void Sort::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
-    const auto chunk_count = _table_in->chunk_count();
-    for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
-      const auto chunk = _table_in->get_chunk(chunk_id);
-      Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+std::shared_ptr<const Table> Sort::_on_execute() {
+  const auto& input_table = *input_table_left();
+  const auto chunk_count = input_table.chunk_count();
+
+  // 1. Encode the sort columns of each chunk into normalized keys and sort them. Each chunk becomes one sorted run.
+  auto runs = std::vector<SortRun>(chunk_count);
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      runs[chunk_id] = create_sorted_run(input_table, chunk_id, _sort_definitions);
+    }));
+    jobs.back()->schedule();
+  }
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
 
-      auto base_segment = chunk->get_segment(_column_id);
+  // 2. Merge the runs
+  const auto row_ids = merge_runs(runs, input_table.row_count());
 
-      segment_iterate<SortColumnType>(*base_segment, [&](const auto& position) {
-        if (position.is_null()) {
-          null_value_rows.emplace_back(RowID{chunk_id, position.chunk_offset()}, SortColumnType{});
-        } else {
-          row_id_value_vector.emplace_back(RowID{chunk_id, position.chunk_offset()}, position.value());
-        }
-      });
-    }
-  }
+  // 3. Materialize the rows in their sorted order
+  return _materialize_output(row_ids);
+}
+
+std::shared_ptr<Table> Sort::_materialize_output(const std::vector<RowID>& row_ids) const {
+  const auto& input_table = input_table_left();
+
+  // We have decided against duplicating MVCC data in https://github.com/hyrise/hyrise/issues/408
+  auto output = std::make_shared<Table>(input_table->column_definitions(), TableType::Data, _output_chunk_size);
+
+  const auto row_count = row_ids.size();
+  const auto output_chunk_count = (row_count + _output_chunk_size - 1) / _output_chunk_size;
+  auto output_segments_by_chunk = std::vector<Segments>(output_chunk_count);
+
+  // Each task materializes one output chunk. The accessors are not thread-safe, so each task creates its own.
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(output_chunk_count);
+  for (auto output_chunk_index = size_t{0}; output_chunk_index < output_chunk_count; ++output_chunk_index) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, output_chunk_index]() {
+      const auto begin_row_index = output_chunk_index * _output_chunk_size;
+      const auto end_row_index = std::min(begin_row_index + _output_chunk_size, row_count);
+      auto& output_segments = output_segments_by_chunk[output_chunk_index];
+
+      for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+        resolve_data_type(input_table->column_data_type(column_id), [&](const auto data_type_t) {
+          using ColumnDataType = typename decltype(data_type_t)::type;
+
+          auto accessor_by_chunk_id =
+              std::unordered_map<ChunkID, std::unique_ptr<AbstractSegmentAccessor<ColumnDataType>>>{};
+
+          auto values = pmr_concurrent_vector<ColumnDataType>(end_row_index - begin_row_index);
+          auto null_values = pmr_concurrent_vector<bool>(end_row_index - begin_row_index);
+
+          for (auto row_index = begin_row_index; row_index < end_row_index; ++row_index) {
+            const auto& row_id = row_ids[row_index];
+
+            auto& accessor = accessor_by_chunk_id[row_id.chunk_id];
+            if (!accessor) {
+              accessor = create_segment_accessor<ColumnDataType>(
+                  input_table->get_chunk(row_id.chunk_id)->get_segment(column_id));
+            }
+
+            auto typed_value = accessor->access(row_id.chunk_offset);
+            if (typed_value) {
+              values[row_index - begin_row_index] = std::move(*typed_value);
+            } else {
+              null_values[row_index - begin_row_index] = true;
+            }
+          }
 
-  template <typename Comparator>
-  void _sort_with_operator() {
-    Comparator comparator;
-    std::stable_sort(_row_id_value_vector->begin(), _row_id_value_vector->end(),
-                     [comparator](RowIDValuePair a, RowIDValuePair b) { return comparator(a.second, b.second); });
+          output_segments.emplace_back(
+              std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(null_values)));
+        });
+      }
+    }));
+    jobs.back()->schedule();
   }
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
 
-  const std::shared_ptr<const Table> _table_in;
+  for (auto& segments : output_segments_by_chunk) {
+    output->append_chunk(segments);
+  }
 
-  // column to sort by
-  const ColumnID _column_id;
-  const OrderByMode _order_by_mode;
-  // chunk size of the materialized output
-  const size_t _output_chunk_size;
+  const auto& primary_definition = _sort_definitions.front();
+  const auto chunk_count = output->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    output->get_chunk(chunk_id)->set_ordered_by(std::make_pair(primary_definition.column,
+                                                               primary_definition.order_by_mode));
+  }
 
-  std::shared_ptr<std::vector<RowIDValuePair>> _row_id_value_vector;
-  std::shared_ptr<std::vector<RowIDValuePair>> _null_value_rows;
-};
+  return output;
+}
 
 }  // namespace opossum
@@ -4,6 +4,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -14,41 +15,53 @@
 
 namespace opossum {
 
+struct SortColumnDefinition final {
+  explicit SortColumnDefinition(const ColumnID& init_column,
+                                const OrderByMode init_order_by_mode = OrderByMode::Ascending)
+      : column(init_column), order_by_mode(init_order_by_mode) {}
+
+  ColumnID column;
+  OrderByMode order_by_mode;
+};
+
 /**
- * Operator to sort a table by a single column. This implements a stable sort, i.e., rows that share the same value will
- * maintain their relative order.
- * Multi-column sort is not supported yet. For now, you will have to sort by the secondary criterion, then by the first
+ * Operator to sort a table by one or more columns. This implements a stable sort, i.e., rows that share the same values
+ * in all sort columns will maintain their relative order.
+ *
+ * The values of all sort columns of a row are encoded into a single normalized key, which can be compared with memcmp
+ * (see sort.cpp). The order_by_mode of each column, i.e., descending order and the position of NULLs, is part of that
+ * encoding. Each input chunk is turned into a sorted run by its own task, and the runs are then merged by multiple
+ * tasks, each of which produces a disjoint range of the output.
  */
 class Sort : public AbstractReadOnlyOperator {
  public:
   // The parameter chunk_size sets the chunk size of the output table, which will always be materialized
+  Sort(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const size_t output_chunk_size = Chunk::DEFAULT_SIZE);
+
   Sort(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id,
        const OrderByMode order_by_mode = OrderByMode::Ascending, const size_t output_chunk_size = Chunk::DEFAULT_SIZE);
 
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+
+  // Column and order_by_mode of the primary sort definition
   ColumnID column_id() const;
   OrderByMode order_by_mode() const;
 
   const std::string& name() const override;
+  std::string description(DescriptionMode description_mode = DescriptionMode::SingleLine) const override;
 
  protected:
   std::shared_ptr<const Table> _on_execute() override;
-  void _on_cleanup() override;
   std::shared_ptr<AbstractOperator> _on_deep_copy(
       const std::shared_ptr<AbstractOperator>& copied_input_left,
       const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
 
-  // The operator is separated in three different classes. SortImpl is the common templated implementation of the
-  // operator. SortImpl* und SortImplMaterializeOutput are extra classes for the visitor pattern. They fulfill a certain
-  // task during the Sort process, as described later on.
-  template <typename SortColumnType>
-  class SortImpl;
-  template <typename SortColumnType>
-  class SortImplMaterializeOutput;
-
-  std::unique_ptr<AbstractReadOnlyOperatorImpl> _impl;
-  const ColumnID _column_id;
-  const OrderByMode _order_by_mode;
+  // Creates a table that holds the rows identified by @param row_ids in that order
+  std::shared_ptr<Table> _materialize_output(const std::vector<RowID>& row_ids) const;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
   const size_t _output_chunk_size;
 };
 
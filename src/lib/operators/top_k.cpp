@@ -0,0 +1,382 @@
+#include "top_k.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expression/evaluation/expression_evaluator.hpp"
+#include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/min_max_filter.hpp"
+#include "statistics/statistics_objects/range_filter.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+bool is_ascending(const OrderByMode order_by_mode) {
+  return order_by_mode == OrderByMode::Ascending || order_by_mode == OrderByMode::AscendingNullsLast;
+}
+
+bool is_nulls_first(const OrderByMode order_by_mode) {
+  return order_by_mode == OrderByMode::Ascending || order_by_mode == OrderByMode::Descending;
+}
+
+// Returns the smallest and the largest value of a segment as stored in the pruning statistics of its chunk, if any
+template <typename ColumnDataType>
+std::optional<std::pair<ColumnDataType, ColumnDataType>> segment_min_max(const Chunk& chunk,
+                                                                          const ColumnID column_id) {
+  const auto& pruning_statistics = chunk.pruning_statistics();
+  if (!pruning_statistics) return std::nullopt;
+
+  const auto segment_statistics =
+      std::dynamic_pointer_cast<AttributeStatistics<ColumnDataType>>((*pruning_statistics)[column_id]);
+  if (!segment_statistics) return std::nullopt;
+
+  if constexpr (std::is_arithmetic_v<ColumnDataType>) {
+    if (segment_statistics->range_filter && !segment_statistics->range_filter->ranges.empty()) {
+      const auto& ranges = segment_statistics->range_filter->ranges;
+      return std::make_pair(ranges.front().first, ranges.back().second);
+    }
+  }
+
+  if (segment_statistics->min_max_filter) {
+    return std::make_pair(segment_statistics->min_max_filter->min, segment_statistics->min_max_filter->max);
+  }
+
+  return std::nullopt;
+}
+
+}  // namespace
+
+namespace opossum {
+
+TopK::TopK(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id,
+           const OrderByMode order_by_mode, const std::shared_ptr<AbstractExpression>& row_count_expression,
+           const size_t output_chunk_size)
+    : AbstractReadOnlyOperator(OperatorType::TopK, in),
+      _column_id(column_id),
+      _order_by_mode(order_by_mode),
+      _row_count_expression(row_count_expression),
+      _output_chunk_size(output_chunk_size) {}
+
+ColumnID TopK::column_id() const { return _column_id; }
+
+OrderByMode TopK::order_by_mode() const { return _order_by_mode; }
+
+std::shared_ptr<AbstractExpression> TopK::row_count_expression() const { return _row_count_expression; }
+
+const std::string& TopK::name() const {
+  static const auto name = std::string{"TopK"};
+  return name;
+}
+
+std::string TopK::description(DescriptionMode description_mode) const {
+  const auto separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+
+  std::stringstream stream;
+  stream << name() << separator << "(" << _row_count_expression->as_column_name() << " rows by Column #" << _column_id
+         << " " << _order_by_mode << ")";
+  return stream.str();
+}
+
+std::shared_ptr<AbstractOperator> TopK::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_input_left,
+    const std::shared_ptr<AbstractOperator>& copied_input_right) const {
+  return std::make_shared<TopK>(copied_input_left, _column_id, _order_by_mode, _row_count_expression->deep_copy(),
+                                _output_chunk_size);
+}
+
+void TopK::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  expression_set_parameters(_row_count_expression, parameters);
+}
+
+void TopK::_on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) {
+  expression_set_transaction_context(_row_count_expression, transaction_context);
+}
+
+std::shared_ptr<const Table> TopK::_on_execute() {
+  /**
+   * Evaluate the _row_count_expression to determine k, the same way Limit does
+   */
+  auto k = size_t{};
+
+  resolve_data_type(_row_count_expression->data_type(), [&](const auto data_type_t) {
+    using LimitDataType = typename decltype(data_type_t)::type;
+
+    if constexpr (std::is_integral_v<LimitDataType>) {
+      const auto num_rows_expression_result =
+          ExpressionEvaluator{}.evaluate_expression_to_result<LimitDataType>(*_row_count_expression);
+      Assert(num_rows_expression_result->size() == 1, "Expected exactly one row for TopK");
+      Assert(!num_rows_expression_result->is_null(0), "Expected non-null for TopK");
+
+      const auto signed_num_rows = num_rows_expression_result->value(0);
+      Assert(signed_num_rows >= 0, "Can't Limit to a negative number of Rows");
+
+      k = static_cast<size_t>(signed_num_rows);
+    } else {
+      Fail("Non-integral types not allowed in TopK");
+    }
+  });
+
+  auto row_ids = std::vector<RowID>{};
+  if (k > 0) {
+    resolve_data_type(input_table_left()->column_data_type(_column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      row_ids = _top_k_row_ids<ColumnDataType>(k);
+    });
+  }
+
+  return _materialize_output(row_ids);
+}
+
+template <typename ColumnDataType>
+std::vector<RowID> TopK::_top_k_row_ids(const size_t k) const {
+  using Candidate = std::pair<ColumnDataType, RowID>;
+
+  const auto& input_table = *input_table_left();
+  const auto ascending = is_ascending(_order_by_mode);
+
+  // Returns true if the candidate lhs comes before the candidate rhs in the output. Ties are broken by the RowID so
+  // that the result matches that of the stable Sort.
+  const auto precedes = [ascending](const Candidate& lhs, const Candidate& rhs) {
+    if (lhs.first < rhs.first) return ascending;
+    if (rhs.first < lhs.first) return !ascending;
+    return lhs.second < rhs.second;
+  };
+
+  const auto chunk_ids = _chunks_to_scan<ColumnDataType>(k);
+
+  // 1. Find the best k non-NULL rows and the first k NULL rows of each chunk. The candidates of a chunk end up sorted
+  //    in output order.
+  auto candidates_per_chunk = std::vector<std::vector<Candidate>>(chunk_ids.size());
+  auto null_row_ids_per_chunk = std::vector<std::vector<RowID>>(chunk_ids.size());
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_ids.size());
+
+  for (auto chunk_index = size_t{0}; chunk_index < chunk_ids.size(); ++chunk_index) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_index]() {
+      const auto chunk_id = chunk_ids[chunk_index];
+      const auto chunk = input_table.get_chunk(chunk_id);
+
+      // If the chunk is already sorted the way we need it, only its first k rows can qualify
+      const auto& ordered_by = chunk->ordered_by();
+      const auto chunk_is_ordered =
+          ordered_by && ordered_by->first == _column_id && ordered_by->second == _order_by_mode;
+
+      // The top of the heap is the worst candidate found so far
+      auto heap = std::priority_queue<Candidate, std::vector<Candidate>, decltype(precedes)>{precedes};
+      auto& null_row_ids = null_row_ids_per_chunk[chunk_index];
+
+      segment_with_iterators<ColumnDataType>(*chunk->get_segment(_column_id), [&](auto it, const auto end) {
+        for (auto row_count = size_t{0}; it != end && !(chunk_is_ordered && row_count == k); ++it, ++row_count) {
+          const auto& position = *it;
+          const auto row_id = RowID{chunk_id, position.chunk_offset()};
+
+          if (position.is_null()) {
+            if (null_row_ids.size() < k) null_row_ids.emplace_back(row_id);
+            continue;
+          }
+
+          if (heap.size() < k) {
+            heap.emplace(position.value(), row_id);
+            continue;
+          }
+
+          auto candidate = Candidate{position.value(), row_id};
+          if (precedes(candidate, heap.top())) {
+            heap.pop();
+            heap.emplace(std::move(candidate));
+          }
+        }
+      });
+
+      auto& candidates = candidates_per_chunk[chunk_index];
+      candidates.resize(heap.size());
+      for (auto candidate_it = candidates.rbegin(); candidate_it != candidates.rend(); ++candidate_it) {
+        *candidate_it = heap.top();
+        heap.pop();
+      }
+    }));
+    jobs.back()->schedule();
+  }
+
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+
+  // 2. Merge the sorted candidates of all chunks. The heap holds the next candidate of each chunk, its top is the
+  //    overall best one.
+  using CursorPosition = std::pair<size_t, size_t>;  // chunk_index, candidate_index
+  const auto cursor_comparator = [&](const CursorPosition& lhs, const CursorPosition& rhs) {
+    return precedes(candidates_per_chunk[rhs.first][rhs.second], candidates_per_chunk[lhs.first][lhs.second]);
+  };
+  auto cursors = std::priority_queue<CursorPosition, std::vector<CursorPosition>, decltype(cursor_comparator)>{
+      cursor_comparator};
+  for (auto chunk_index = size_t{0}; chunk_index < chunk_ids.size(); ++chunk_index) {
+    if (!candidates_per_chunk[chunk_index].empty()) cursors.emplace(chunk_index, 0);
+  }
+
+  auto value_row_ids = std::vector<RowID>{};
+  value_row_ids.reserve(std::min(k, static_cast<size_t>(input_table.row_count())));
+  while (value_row_ids.size() < k && !cursors.empty()) {
+    const auto [chunk_index, candidate_index] = cursors.top();
+    cursors.pop();
+
+    value_row_ids.emplace_back(candidates_per_chunk[chunk_index][candidate_index].second);
+    if (candidate_index + 1 < candidates_per_chunk[chunk_index].size()) {
+      cursors.emplace(chunk_index, candidate_index + 1);
+    }
+  }
+
+  // NULLs are ordered by their RowID. As the chunks were scanned in the order of their ids, appending the NULLs of each
+  // chunk keeps them sorted.
+  auto null_row_ids = std::vector<RowID>{};
+  for (const auto& chunk_null_row_ids : null_row_ids_per_chunk) {
+    const auto null_count = std::min(chunk_null_row_ids.size(), k - null_row_ids.size());
+    null_row_ids.insert(null_row_ids.end(), chunk_null_row_ids.begin(), chunk_null_row_ids.begin() + null_count);
+    if (null_row_ids.size() == k) break;
+  }
+
+  auto row_ids = is_nulls_first(_order_by_mode) ? std::move(null_row_ids) : std::move(value_row_ids);
+  const auto& remaining_row_ids = is_nulls_first(_order_by_mode) ? value_row_ids : null_row_ids;
+  const auto remaining_count = std::min(remaining_row_ids.size(), k - row_ids.size());
+  row_ids.insert(row_ids.end(), remaining_row_ids.begin(), remaining_row_ids.begin() + remaining_count);
+
+  return row_ids;
+}
+
+template <typename ColumnDataType>
+std::vector<ChunkID> TopK::_chunks_to_scan(const size_t k) const {
+  const auto& input_table = *input_table_left();
+  const auto ascending = is_ascending(_order_by_mode);
+  const auto chunk_count = input_table.chunk_count();
+
+  const auto value_precedes = [ascending](const ColumnDataType& lhs, const ColumnDataType& rhs) {
+    return ascending ? lhs < rhs : rhs < lhs;
+  };
+
+  // The best and the worst value of each chunk according to the pruning statistics. If the column can contain NULLs,
+  // we cannot tell how many rows of a chunk are non-NULL and whether a chunk contains any NULLs, so no chunk is
+  // skipped.
+  auto bounds_per_chunk = std::vector<std::optional<std::pair<ColumnDataType, ColumnDataType>>>(chunk_count);
+  auto worst_values = std::vector<std::pair<ColumnDataType, size_t>>{};
+
+  if (!input_table.column_is_nullable(_column_id)) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = input_table.get_chunk(chunk_id);
+      if (!chunk) continue;
+
+      auto min_max = segment_min_max<ColumnDataType>(*chunk, _column_id);
+      if (!min_max) continue;
+
+      if (!ascending) std::swap(min_max->first, min_max->second);
+      worst_values.emplace_back(min_max->second, chunk->size());
+      bounds_per_chunk[chunk_id] = std::move(min_max);
+    }
+  }
+
+  // Find the best value v for which the chunks whose values are all at least as good as v hold k rows. A chunk whose
+  // best value is worse than v cannot contribute to the result.
+  std::sort(worst_values.begin(), worst_values.end(),
+            [&](const auto& lhs, const auto& rhs) { return value_precedes(lhs.first, rhs.first); });
+
+  auto threshold = std::optional<ColumnDataType>{};
+  auto row_count = size_t{0};
+  for (const auto& [worst_value, chunk_row_count] : worst_values) {
+    row_count += chunk_row_count;
+    if (row_count >= k) {
+      threshold = worst_value;
+      break;
+    }
+  }
+
+  auto chunk_ids = std::vector<ChunkID>{};
+  chunk_ids.reserve(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = input_table.get_chunk(chunk_id);
+    Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+    const auto& bounds = bounds_per_chunk[chunk_id];
+    if (threshold && bounds && value_precedes(*threshold, bounds->first)) continue;
+
+    chunk_ids.emplace_back(chunk_id);
+  }
+
+  return chunk_ids;
+}
+
+std::shared_ptr<Table> TopK::_materialize_output(const std::vector<RowID>& row_ids) const {
+  const auto& input_table = input_table_left();
+
+  // We have decided against duplicating MVCC data in https://github.com/hyrise/hyrise/issues/408
+  auto output = std::make_shared<Table>(input_table->column_definitions(), TableType::Data, _output_chunk_size);
+
+  const auto row_count = row_ids.size();
+  const auto output_chunk_count = (row_count + _output_chunk_size - 1) / _output_chunk_size;
+  auto output_segments_by_chunk = std::vector<Segments>(output_chunk_count);
+
+  // As the output holds at most k rows, it is materialized row by row with one accessor per input segment
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    resolve_data_type(input_table->column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      auto accessors =
+          std::vector<std::unique_ptr<AbstractSegmentAccessor<ColumnDataType>>>(input_table->chunk_count());
+
+      for (auto output_chunk_index = size_t{0}; output_chunk_index < output_chunk_count; ++output_chunk_index) {
+        const auto begin_row_index = output_chunk_index * _output_chunk_size;
+        const auto end_row_index = std::min(begin_row_index + _output_chunk_size, row_count);
+
+        auto values = pmr_concurrent_vector<ColumnDataType>(end_row_index - begin_row_index);
+        auto null_values = pmr_concurrent_vector<bool>(end_row_index - begin_row_index);
+
+        for (auto row_index = begin_row_index; row_index < end_row_index; ++row_index) {
+          const auto& row_id = row_ids[row_index];
+
+          auto& accessor = accessors[row_id.chunk_id];
+          if (!accessor) {
+            accessor = create_segment_accessor<ColumnDataType>(
+                input_table->get_chunk(row_id.chunk_id)->get_segment(column_id));
+          }
+
+          auto typed_value = accessor->access(row_id.chunk_offset);
+          if (typed_value) {
+            values[row_index - begin_row_index] = std::move(*typed_value);
+          } else {
+            null_values[row_index - begin_row_index] = true;
+          }
+        }
+
+        output_segments_by_chunk[output_chunk_index].emplace_back(
+            std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(null_values)));
+      }
+    });
+  }
+
+  for (auto& segments : output_segments_by_chunk) {
+    output->append_chunk(segments);
+  }
+
+  const auto chunk_count = output->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    output->get_chunk(chunk_id)->set_ordered_by(std::make_pair(_column_id, _order_by_mode));
+  }
+
+  return output;
+}
+
+}  // namespace opossum
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "expression/abstract_expression.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Operator that returns the first k rows of a table sorted by a single column, i.e., the fusion of Sort and Limit. The
+ * result is the same as that of a stable Sort followed by a Limit: rows that share the same value are emitted in the
+ * order of their RowIDs in the input table.
+ *
+ * Instead of sorting the entire input, each chunk is scanned by its own task that keeps its best k rows in a bounded
+ * heap, which costs O(n log k). The per-chunk candidates are then merged into the k result rows.
+ *
+ * Chunks are skipped without being scanned (a) partially, if they are already ordered_by() the sort column in the
+ * requested order, where only their first k rows can qualify, and (b) entirely, if their pruning statistics show that
+ * other chunks hold at least k rows that are better than every value of the chunk. (b) is only applied to columns that
+ * are not nullable, as the pruning statistics do not tell whether a segment contains NULLs.
+ */
+class TopK : public AbstractReadOnlyOperator {
+ public:
+  // The parameter output_chunk_size sets the chunk size of the output table, which will always be materialized
+  TopK(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id, const OrderByMode order_by_mode,
+       const std::shared_ptr<AbstractExpression>& row_count_expression,
+       const size_t output_chunk_size = Chunk::DEFAULT_SIZE);
+
+  ColumnID column_id() const;
+  OrderByMode order_by_mode() const;
+  std::shared_ptr<AbstractExpression> row_count_expression() const;
+
+  const std::string& name() const override;
+  std::string description(DescriptionMode description_mode = DescriptionMode::SingleLine) const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_input_left,
+      const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+  void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) override;
+
+  // Returns the RowIDs of the k best rows in output order
+  template <typename ColumnDataType>
+  std::vector<RowID> _top_k_row_ids(const size_t k) const;
+
+  // Returns the ids of the chunks that have to be scanned, i.e., that are not skipped based on their pruning statistics
+  template <typename ColumnDataType>
+  std::vector<ChunkID> _chunks_to_scan(const size_t k) const;
+
+  std::shared_ptr<Table> _materialize_output(const std::vector<RowID>& row_ids) const;
+
+  const ColumnID _column_id;
+  const OrderByMode _order_by_mode;
+  const std::shared_ptr<AbstractExpression> _row_count_expression;
+  const size_t _output_chunk_size;
+};
+
+}  // namespace opossum
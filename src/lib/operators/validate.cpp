@@ -24,6 +24,60 @@ bool is_row_visible(TransactionID our_tid, CommitID snapshot_commit_id, ChunkOff
   return Validate::is_row_visible(our_tid, snapshot_commit_id, row_tid, begin_cid, end_cid);
 }
 
+// Appends all visible rows of a chunk with contiguous MVCC columns to pos_list. Similar to _simd_scan_with_iterators
+// in abstract_table_scan_impl.hpp, the rows are processed in blocks so that the visibility check is vectorized.
+// Blocks without any visible row are skipped. For all other blocks, the offset of every row is written to pos_list,
+// but the write position only advances for visible rows. This avoids branching on the visibility of single rows.
+void validate_contiguous_mvcc_columns(const TransactionID our_tid, const CommitID snapshot_commit_id,
+                                      const MvccData::ContiguousColumns& mvcc_columns, const ChunkID chunk_id,
+                                      const ChunkOffset chunk_size, PosList& pos_list) {
+  // We assume a SIMD register size of 256 bit, see _simd_scan_with_iterators
+  constexpr auto SIMD_SIZE = size_t{256 / 8};
+  constexpr auto BLOCK_SIZE = static_cast<ChunkOffset>(SIMD_SIZE / sizeof(CommitID));
+
+  // Every row might be visible. Resizing once saves us from calling into the stdlib from the hot loop. The surplus is
+  // cut off in the end.
+  auto pos_list_index = pos_list.size();
+  pos_list.resize(pos_list_index + chunk_size, RowID{chunk_id, 0});
+
+  const auto* const tids = mvcc_columns.tids;
+  const auto* const begin_cids = mvcc_columns.begin_cids;
+  const auto* const end_cids = mvcc_columns.end_cids;
+
+  auto block_offset = ChunkOffset{0};
+  for (; block_offset + BLOCK_SIZE <= chunk_size; block_offset += BLOCK_SIZE) {
+    auto mask = uint16_t{0};
+
+    // NOLINTNEXTLINE
+    {}  // clang-format off
+    #pragma omp simd reduction(|:mask) safelen(BLOCK_SIZE)
+    // clang-format on
+    for (auto index = ChunkOffset{0}; index < BLOCK_SIZE; ++index) {
+      const auto chunk_offset = block_offset + index;
+      mask |= Validate::is_row_visible(our_tid, snapshot_commit_id, tids[chunk_offset], begin_cids[chunk_offset],
+                                       end_cids[chunk_offset])
+              << index;
+    }
+
+    if (!mask) continue;
+
+    for (auto index = ChunkOffset{0}; index < BLOCK_SIZE; ++index) {
+      pos_list[pos_list_index].chunk_offset = block_offset + index;
+      pos_list_index += (mask >> index) & 1u;
+    }
+  }
+
+  // Do the remainder the easy way
+  for (auto chunk_offset = block_offset; chunk_offset < chunk_size; ++chunk_offset) {
+    if (Validate::is_row_visible(our_tid, snapshot_commit_id, tids[chunk_offset], begin_cids[chunk_offset],
+                                 end_cids[chunk_offset])) {
+      pos_list[pos_list_index++].chunk_offset = chunk_offset;
+    }
+  }
+
+  pos_list.resize(pos_list_index);
+}
+
 }  // namespace
 
 bool Validate::is_row_visible(TransactionID our_tid, CommitID snapshot_commit_id, const TransactionID row_tid,
@@ -219,6 +273,10 @@ void Validate::_validate_chunks(const std::shared_ptr<const Table>& in_table, co
         for (auto chunk_offset = 0u; chunk_offset < chunk_size; ++chunk_offset) {
           temp_pos_list[chunk_offset] = RowID{chunk_id, chunk_offset};
         }
+      } else if (const auto& mvcc_columns = mvcc_data->contiguous_columns()) {
+        // Finalized chunks - their MVCC columns are not segmented and can be checked in blocks.
+        validate_contiguous_mvcc_columns(our_tid, snapshot_commit_id, *mvcc_columns, chunk_id, chunk_in->size(),
+                                         temp_pos_list);
       } else {
         // Generate pos_list_out.
         auto chunk_size = chunk_in->size();  // The compiler fails to optimize this in the for clause :(
@@ -232,7 +232,10 @@ std::shared_ptr<TableStatistics> ChunkPruningRule::_prune_table_statistics(const
     }
   }
 
-  return std::make_shared<TableStatistics>(std::move(column_statistics), old_statistics.row_count - num_rows_pruned);
+  const auto table_statistics =
+      std::make_shared<TableStatistics>(std::move(column_statistics), old_statistics.row_count - num_rows_pruned);
+  table_statistics->column_pair_statistics = old_statistics.column_pair_statistics;
+  return table_statistics;
 }
 
 }  // namespace opossum
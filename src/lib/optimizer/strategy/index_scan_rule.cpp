@@ -46,6 +46,12 @@ void IndexScanRule::apply_to(const std::shared_ptr<AbstractLQPNode>& root) const
             predicate_node->scan_type = ScanType::IndexScan;
           }
         }
+
+        for (const auto& column_ids : stored_table_node->table_indexes_column_ids()) {
+          if (column_ids.size() == 1 && _is_index_scan_applicable(column_ids[0], predicate_node)) {
+            predicate_node->scan_type = ScanType::IndexScan;
+          }
+        }
       }
     }
 
@@ -59,6 +65,11 @@ bool IndexScanRule::_is_index_scan_applicable(const IndexStatistics& index_stati
 
   if (index_statistics.type != SegmentIndexType::GroupKey) return false;
 
+  return _is_index_scan_applicable(index_statistics.column_ids[0], predicate_node);
+}
+
+bool IndexScanRule::_is_index_scan_applicable(const ColumnID indexed_column_id,
+                                              const std::shared_ptr<PredicateNode>& predicate_node) const {
   const auto operator_predicates =
       OperatorScanPredicate::from_expression(*predicate_node->predicate(), *predicate_node);
   if (!operator_predicates) return false;
@@ -66,10 +77,12 @@ bool IndexScanRule::_is_index_scan_applicable(const IndexStatistics& index_stati
 
   const auto& operator_predicate = (*operator_predicates)[0];
 
-  // Currently, we do not support two-column predicates
-  if (is_column_id(operator_predicate.value)) return false;
+  // Currently, we do not support two-column predicates. Parameters are not supported either, as the IndexScan is
+  // translated with the values of the predicate.
+  if (!is_variant(operator_predicate.value)) return false;
+  if (operator_predicate.value2 && !is_variant(*operator_predicate.value2)) return false;
 
-  if (index_statistics.column_ids[0] != operator_predicate.column_id) return false;
+  if (indexed_column_id != operator_predicate.column_id) return false;
 
   const auto row_count_table =
       cost_estimator->cardinality_estimator->estimate_cardinality(predicate_node->left_input());
@@ -22,7 +22,7 @@ class PredicateNode;
  * For now this rule is only applicable to single-column indexes. Multi-column predicates (i.e. WHERE a < b) are also
  * not supported. We also assume that if chunks have an index, all of them are of the same type, we do not mix GroupKey
  * and ART indexes. In addition, chains of IndexScans are not possible since an IndexScan's input must be a GetTable.
- * Currently, only GroupKeyIndexes are supported.
+ * Currently, only GroupKeyIndexes and single-column TableIndexes are supported.
  */
 
 class IndexScanRule : public AbstractRule {
@@ -32,6 +32,8 @@ class IndexScanRule : public AbstractRule {
  protected:
   bool _is_index_scan_applicable(const IndexStatistics& index_statistics,
                                  const std::shared_ptr<PredicateNode>& predicate_node) const;
+  bool _is_index_scan_applicable(const ColumnID indexed_column_id,
+                                 const std::shared_ptr<PredicateNode>& predicate_node) const;
   static bool _is_single_segment_index(const IndexStatistics& index_statistics);
 };
 
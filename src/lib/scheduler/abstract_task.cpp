@@ -1,5 +1,6 @@
 #include "abstract_task.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -78,6 +79,19 @@ void AbstractTask::_join() {
   _done_condition_variable.wait(lock, [&]() { return static_cast<bool>(_done); });
 }
 
+bool AbstractTask::_try_register_waiting_worker(Worker* worker) {
+  std::lock_guard<std::mutex> lock(_done_mutex);
+  if (_done) return false;
+
+  _waiting_workers.emplace_back(worker);
+  return true;
+}
+
+void AbstractTask::_unregister_waiting_worker(Worker* worker) {
+  std::lock_guard<std::mutex> lock(_done_mutex);
+  _waiting_workers.erase(std::remove(_waiting_workers.begin(), _waiting_workers.end(), worker), _waiting_workers.end());
+}
+
 void AbstractTask::execute() {
   DTRACE_PROBE3(HYRISE, JOB_START, _id.load(), _description.c_str(), reinterpret_cast<uintptr_t>(this));
   DebugAssert(!(_started.exchange(true)), "Possible bug: Trying to execute the same task twice");
@@ -99,11 +113,16 @@ void AbstractTask::execute() {
 
   if (_done_callback) _done_callback();
 
+  auto waiting_workers = std::vector<Worker*>{};
   {
     std::lock_guard<std::mutex> lock(_done_mutex);
     _done = true;
+    waiting_workers.swap(_waiting_workers);
   }
   _done_condition_variable.notify_all();
+  for (auto* worker : waiting_workers) {
+    worker->unpark();
+  }
   DTRACE_PROBE2(HYRISE, JOB_END, _id, reinterpret_cast<uintptr_t>(this));
 }
 
@@ -124,7 +143,7 @@ void AbstractTask::_on_predecessor_done() {
       // the sake of a clearly defined life cycle, we wait for the task to be scheduled.
       if (!_is_scheduled) return;
 
-      worker->queue()->push(shared_from_this(), static_cast<uint32_t>(SchedulePriority::High));
+      worker->push_task(shared_from_this(), SchedulePriority::High);
     } else {
       if (_is_scheduled) execute();
       // Otherwise it will get execute()d once it is scheduled. It is entirely possible for Tasks to "become ready"
@@ -21,6 +21,7 @@ class Worker;
  */
 class AbstractTask : public std::enable_shared_from_this<AbstractTask> {
   friend class AbstractScheduler;
+  friend class Worker;
 
  public:
   explicit AbstractTask(SchedulePriority priority = SchedulePriority::Default, bool stealable = true);
@@ -127,6 +128,13 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask> {
    */
   void _join();
 
+  /**
+   * A Worker that waits for this task and has nothing else to do parks itself. It registers here to be unparked once
+   * the task is done. Returns false if the task is already done.
+   */
+  bool _try_register_waiting_worker(Worker* worker);
+  void _unregister_waiting_worker(Worker* worker);
+
   std::atomic<TaskID> _id{INVALID_TASK_ID};
   std::atomic<NodeID> _node_id = INVALID_NODE_ID;
   SchedulePriority _priority;
@@ -148,6 +156,7 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask> {
   // For making Tasks join()-able
   std::condition_variable _done_condition_variable;
   std::mutex _done_mutex;
+  std::vector<Worker*> _waiting_workers;
 
   // Purely for debugging purposes, in order to be able to identify tasks after they have been scheduled
   std::string _description;
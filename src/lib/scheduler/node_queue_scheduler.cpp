@@ -8,6 +8,7 @@
 #include "abstract_task.hpp"
 #include "hyrise.hpp"
 #include "task_queue.hpp"
+#include "work_stealing_deque.hpp"
 #include "worker.hpp"
 
 #include "uid_allocator.hpp"
@@ -15,7 +16,9 @@
 
 namespace opossum {
 
-NodeQueueScheduler::NodeQueueScheduler() { _worker_id_allocator = std::make_shared<UidAllocator>(); }
+NodeQueueScheduler::NodeQueueScheduler(UseWorkerDeques use_worker_deques) : _use_worker_deques(use_worker_deques) {
+  _worker_id_allocator = std::make_shared<UidAllocator>();
+}
 
 NodeQueueScheduler::~NodeQueueScheduler() {
   if (HYRISE_DEBUG && _active) {
@@ -39,7 +42,25 @@ void NodeQueueScheduler::begin() {
     auto& topology_node = Hyrise::get().topology.nodes()[node_id];
 
     for (auto& topology_cpu : topology_node.cpus) {
-      _workers.emplace_back(std::make_shared<Worker>(queue, _worker_id_allocator->allocate(), topology_cpu.cpu_id));
+      _workers.emplace_back(std::make_shared<Worker>(queue, _worker_id_allocator->allocate(), topology_cpu.cpu_id,
+                                                     _use_worker_deques));
+    }
+  }
+
+  if (_use_worker_deques == UseWorkerDeques::Yes) {
+    for (const auto& worker : _workers) {
+      auto node_local_victims = std::vector<Worker*>{};
+      auto remote_victims = std::vector<Worker*>{};
+      for (const auto& victim : _workers) {
+        if (victim == worker) continue;
+
+        if (victim->queue() == worker->queue()) {
+          node_local_victims.emplace_back(victim.get());
+        } else {
+          remote_victims.emplace_back(victim.get());
+        }
+      }
+      worker->_set_steal_victims(std::move(node_local_victims), std::move(remote_victims));
     }
   }
 
@@ -71,10 +92,19 @@ void NodeQueueScheduler::finish() {
     for ([[maybe_unused]] auto& queue : _queues) {
       DebugAssert(queue->empty(), "NodeQueueScheduler bug: Queue wasn't empty even though all tasks finished");
     }
+    for ([[maybe_unused]] auto& worker : _workers) {
+      DebugAssert(!worker->_deque || worker->_deque->empty(),
+                  "NodeQueueScheduler bug: Deque wasn't empty even though all tasks finished");
+    }
   }
 
   _active = false;
 
+  // Parked workers would never notice that the scheduler was shut down
+  for (auto& queue : _queues) {
+    queue->unpark_all();
+  }
+
   for (auto& worker : _workers) {
     worker->join();
   }
@@ -88,6 +118,8 @@ bool NodeQueueScheduler::active() const { return _active; }
 
 const std::vector<std::shared_ptr<TaskQueue>>& NodeQueueScheduler::queues() const { return _queues; }
 
+const std::vector<std::shared_ptr<Worker>>& NodeQueueScheduler::workers() const { return _workers; }
+
 void NodeQueueScheduler::schedule(std::shared_ptr<AbstractTask> task, NodeID preferred_node_id,
                                   SchedulePriority priority) {
   /**
@@ -101,9 +133,13 @@ void NodeQueueScheduler::schedule(std::shared_ptr<AbstractTask> task, NodeID pre
 
   if (!task->is_ready()) return;
 
+  // Only look up the current worker if we need it, as it requires locking a weak_ptr.
+  const auto worker = preferred_node_id == CURRENT_NODE_ID || _use_worker_deques == UseWorkerDeques::Yes
+                          ? Worker::get_this_thread_worker()
+                          : nullptr;
+
   // Lookup node id for current worker.
   if (preferred_node_id == CURRENT_NODE_ID) {
-    auto worker = Worker::get_this_thread_worker();
     if (worker) {
       preferred_node_id = worker->queue()->node_id();
     } else {
@@ -115,6 +151,12 @@ void NodeQueueScheduler::schedule(std::shared_ptr<AbstractTask> task, NodeID pre
   DebugAssert(!(static_cast<size_t>(preferred_node_id) >= _queues.size()),
               "preferred_node_id is not within range of available nodes");
 
+  // Tasks scheduled by a worker for its own node are pushed to the worker's deque, where its siblings can steal them.
+  if (_use_worker_deques == UseWorkerDeques::Yes && worker && worker->queue()->node_id() == preferred_node_id) {
+    worker->push_task(task, priority);
+    return;
+  }
+
   auto queue = _queues[preferred_node_id];
   queue->push(task, static_cast<uint32_t>(priority));
 }
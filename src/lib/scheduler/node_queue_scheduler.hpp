@@ -56,7 +56,7 @@ namespace opossum {
  *
  * WORK STEALING
  *
- * Currently, a simple work stealing is implemented. Work stealing is useful to avoid idle workers (and therefore
+ * By default, a simple work stealing is implemented. Work stealing is useful to avoid idle workers (and therefore
  * idle CPUs) while there are still tasks in the system that need to be processed. A worker gets idle if it can not
  * pull a ready task. This occurs in two cases:
  *  1) all tasks in the queue are not ready
@@ -69,6 +69,19 @@ namespace opossum {
  * worker of the remote node pulled the task, the current worker is pulling the task and therefore steals it.
  * Afterwards, the current worker is checking its local queue gain.
  *
+ * Optionally (UseWorkerDeques::Yes), each worker additionally owns a Chase-Lev deque. Tasks scheduled from within a
+ * worker go to its deque instead of the node's TaskQueue, so that the workers do not fight over the queue head when
+ * operators spawn hundreds of small jobs. Idle workers first steal from the deques of their node-local siblings before
+ * they turn to remote nodes.
+ *
+ *
+ * IDLE WORKERS
+ *
+ * Workers that do not find any work do not poll the queues. Instead, one worker per node spins for a few microseconds,
+ * all others park themselves. Adding a task to a TaskQueue unparks exactly one worker of that node (or, if all of them
+ * are busy and the task is stealable, of another node), unless the spinning worker is going to take the task anyway.
+ * See TaskQueue for details.
+ *
  * [1] http://frankdenneman.nl/2016/07/13/numa-deep-dive-4-local-memory-optimization/
  */
 
@@ -81,7 +94,12 @@ class UidAllocator;
  */
 class NodeQueueScheduler : public AbstractScheduler {
  public:
-  NodeQueueScheduler();
+  /**
+   * @param use_worker_deques If set, each Worker owns a work-stealing deque that the tasks it spawns are pushed to,
+   *                          see worker.hpp. Reduces the contention on the node queues when many small JobTasks are
+   *                          scheduled.
+   */
+  explicit NodeQueueScheduler(UseWorkerDeques use_worker_deques = UseWorkerDeques::No);
   ~NodeQueueScheduler() override;
 
   /**
@@ -96,6 +114,8 @@ class NodeQueueScheduler : public AbstractScheduler {
 
   const std::vector<std::shared_ptr<TaskQueue>>& queues() const override;
 
+  const std::vector<std::shared_ptr<Worker>>& workers() const;
+
   /**
    * @param task
    * @param preferred_node_id The Task will be initially added to this node, but might get stolen by other Nodes later
@@ -112,6 +132,7 @@ class NodeQueueScheduler : public AbstractScheduler {
   std::vector<std::shared_ptr<TaskQueue>> _queues;
   std::vector<std::shared_ptr<Worker>> _workers;
   std::atomic_bool _active{false};
+  const UseWorkerDeques _use_worker_deques;
 };
 
 }  // namespace opossum
@@ -1,10 +1,15 @@
 #include "task_queue.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "abstract_scheduler.hpp"
 #include "abstract_task.hpp"
+#include "hyrise.hpp"
 #include "utils/assert.hpp"
+#include "worker.hpp"
 
 namespace opossum {
 
@@ -28,7 +33,7 @@ void TaskQueue::push(const std::shared_ptr<AbstractTask>& task, uint32_t priorit
   task->set_node_id(_node_id);
   _queues[priority].push(task);
 
-  new_task.notify_one();
+  notify_new_task(task->is_stealable());
 }
 
 std::shared_ptr<AbstractTask> TaskQueue::pull() {
@@ -55,4 +60,80 @@ std::shared_ptr<AbstractTask> TaskQueue::steal() {
   return nullptr;
 }
 
+void TaskQueue::notify_new_task(bool stealable) {
+  // Pairs with the fence in Worker::_park(): Either the parking Worker sees the new task or we see the parked Worker.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  // The spinning Worker will find the task. If it finds work, it wakes up another Worker, see Worker::_wait_for_work().
+  if (_num_spinning_workers > 0) return;
+
+  if (_num_parked_workers > 0 && unpark_one()) return;
+
+  if (!stealable) return;
+
+  // All Workers of this node are busy. Instead of waiting for one of them, let an idle remote Worker steal the task.
+  for (const auto& queue : Hyrise::get().scheduler()->queues()) {
+    if (queue.get() == this) continue;
+
+    if (queue->_num_spinning_workers > 0) return;
+    if (queue->_num_parked_workers > 0 && queue->unpark_one()) return;
+  }
+}
+
+bool TaskQueue::try_start_spinning() {
+  auto expected = uint32_t{0};
+  return _num_spinning_workers.compare_exchange_strong(expected, 1u);
+}
+
+void TaskQueue::stop_spinning() {
+  [[maybe_unused]] const auto previous_spinning_workers = _num_spinning_workers--;
+  DebugAssert(previous_spinning_workers == 1, "Expected exactly one spinning Worker");
+}
+
+void TaskQueue::add_parked_worker(Worker* worker) {
+  std::lock_guard<std::mutex> lock(_parked_workers_mutex);
+  _parked_workers.emplace_back(worker);
+  ++_num_parked_workers;
+}
+
+bool TaskQueue::remove_parked_worker(Worker* worker) {
+  std::lock_guard<std::mutex> lock(_parked_workers_mutex);
+  const auto iter = std::find(_parked_workers.begin(), _parked_workers.end(), worker);
+  if (iter == _parked_workers.end()) return false;
+
+  _parked_workers.erase(iter);
+  --_num_parked_workers;
+  return true;
+}
+
+bool TaskQueue::unpark_one() {
+  Worker* worker = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(_parked_workers_mutex);
+    if (_parked_workers.empty()) return false;
+
+    worker = _parked_workers.back();
+    _parked_workers.pop_back();
+    --_num_parked_workers;
+  }
+
+  worker->unpark();
+  return true;
+}
+
+void TaskQueue::unpark_all() {
+  auto workers = std::vector<Worker*>{};
+  {
+    std::lock_guard<std::mutex> lock(_parked_workers_mutex);
+    workers.swap(_parked_workers);
+    _num_parked_workers = 0;
+  }
+
+  for (auto* worker : workers) {
+    worker->unpark();
+  }
+}
+
+size_t TaskQueue::num_parked_workers() const { return _num_parked_workers; }
+
 }  // namespace opossum
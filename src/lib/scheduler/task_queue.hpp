@@ -4,17 +4,25 @@
 #include <tbb/concurrent_queue.h>
 #include <array>
 #include <atomic>
-#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "types.hpp"
 
 namespace opossum {
 
 class AbstractTask;
+class Worker;
 
 /**
  * Holds a queue of AbstractTasks, usually one of these exists per node
+ *
+ * The TaskQueue also keeps track of the idle Workers of its node. An idle Worker first spins for a short while (at most
+ * one per node at a time, see try_start_spinning()) and then parks itself until it is unparked. Whenever a task is
+ * added, notify_new_task() wakes up exactly one parked Worker, unless a spinning Worker is going to pick the task up
+ * anyway. Lost wake-ups are prevented by the Worker re-checking the queue after it registered itself as parked, see
+ * Worker::_park().
  */
 class TaskQueue {
  public:
@@ -39,18 +47,52 @@ class TaskQueue {
   std::shared_ptr<AbstractTask> steal();
 
   /**
-   * Notifies one worker as soon as a new task gets pushed into the queue
+   * Wakes up a Worker to process a newly added task. If no Worker of this node is idle and the task may be stolen,
+   * an idle Worker of another node is woken up instead. Called by push(), but also when a task was pushed to a
+   * Worker's deque.
    */
-  std::condition_variable new_task;
+  void notify_new_task(bool stealable = true);
 
   /**
-   * Mutex accessed by workers in order to notify them using condition variable
+   * A Worker that did not find any work may spin if no other Worker of this node is currently spinning. Returns true if
+   * the caller became the spinning Worker, in which case it has to call stop_spinning() afterwards.
    */
-  std::mutex lock;
+  bool try_start_spinning();
+  void stop_spinning();
+
+  /**
+   * Registers a Worker as parked. The Worker has to re-check for work afterwards and call remove_parked_worker() if it
+   * decides not to sleep.
+   */
+  void add_parked_worker(Worker* worker);
+
+  /**
+   * Returns false if the Worker was not parked (anymore), i.e., if someone else unparked it in the meantime.
+   */
+  bool remove_parked_worker(Worker* worker);
+
+  /**
+   * Returns false if no Worker was parked.
+   */
+  bool unpark_one();
+
+  /**
+   * Used to shut down the Workers.
+   */
+  void unpark_all();
+
+  size_t num_parked_workers() const;
 
  private:
   NodeID _node_id;
   std::array<tbb::concurrent_queue<std::shared_ptr<AbstractTask>>, NUM_PRIORITY_LEVELS> _queues;
+
+  // Workers are unparked in LIFO order, as the most recently parked Worker is the most likely one to still have its
+  // data in the cache.
+  std::mutex _parked_workers_mutex;
+  std::vector<Worker*> _parked_workers;
+  std::atomic_uint32_t _num_parked_workers{0};
+  std::atomic_uint32_t _num_spinning_workers{0};
 };
 
 }  // namespace opossum
@@ -0,0 +1,121 @@
+#include "work_stealing_deque.hpp"
+
+#include <memory>
+
+#include "abstract_task.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+WorkStealingDeque::RingBuffer::RingBuffer(size_t init_capacity)
+    : capacity(init_capacity), mask(init_capacity - 1), slots(std::make_unique<std::atomic<Element*>[]>(capacity)) {
+  Assert(capacity > 0 && (capacity & mask) == 0, "Capacity of WorkStealingDeque needs to be a power of two");
+}
+
+WorkStealingDeque::Element* WorkStealingDeque::RingBuffer::get(int64_t index) const {
+  return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+}
+
+void WorkStealingDeque::RingBuffer::put(int64_t index, Element* element) {
+  slots[static_cast<size_t>(index) & mask].store(element, std::memory_order_relaxed);
+}
+
+WorkStealingDeque::WorkStealingDeque(size_t initial_capacity) {
+  _ring_buffers.emplace_back(std::make_unique<RingBuffer>(initial_capacity));
+  _ring_buffer.store(_ring_buffers.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque() {
+  // Free the elements that were never taken out of the deque
+  auto* ring_buffer = _ring_buffer.load(std::memory_order_relaxed);
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  for (auto index = _top.load(std::memory_order_relaxed); index < bottom; ++index) {
+    delete ring_buffer->get(index);
+  }
+}
+
+void WorkStealingDeque::push(const std::shared_ptr<AbstractTask>& task) {
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  const auto top = _top.load(std::memory_order_acquire);
+  auto* ring_buffer = _ring_buffer.load(std::memory_order_relaxed);
+
+  if (bottom - top > static_cast<int64_t>(ring_buffer->capacity) - 1) {
+    ring_buffer = _grow(ring_buffer, top, bottom);
+  }
+
+  ring_buffer->put(bottom, new Element(task));
+
+  // Publishes the element to thieves, which acquire _bottom before reading the slot. [2] uses a release fence followed
+  // by a relaxed store, which is equivalent but not understood by tsan.
+  _bottom.store(bottom + 1, std::memory_order_release);
+}
+
+std::shared_ptr<AbstractTask> WorkStealingDeque::pop() {
+  const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+  auto* ring_buffer = _ring_buffer.load(std::memory_order_relaxed);
+  _bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto top = _top.load(std::memory_order_relaxed);
+
+  if (top > bottom) {
+    // Deque was empty
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  auto* element = ring_buffer->get(bottom);
+  if (top == bottom) {
+    // Last element - race against thieves
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      element = nullptr;
+    }
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  if (!element) return nullptr;
+
+  auto task = std::move(*element);
+  delete element;
+  return task;
+}
+
+std::shared_ptr<AbstractTask> WorkStealingDeque::steal() {
+  auto top = _top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const auto bottom = _bottom.load(std::memory_order_acquire);
+
+  if (top >= bottom) return nullptr;
+
+  auto* ring_buffer = _ring_buffer.load(std::memory_order_acquire);
+  auto* element = ring_buffer->get(top);
+  if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    // Lost the race against the owner or another thief
+    return nullptr;
+  }
+
+  auto task = std::move(*element);
+  delete element;
+  return task;
+}
+
+size_t WorkStealingDeque::size() const {
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  const auto top = _top.load(std::memory_order_relaxed);
+  return bottom > top ? static_cast<size_t>(bottom - top) : size_t{0};
+}
+
+bool WorkStealingDeque::empty() const { return size() == 0; }
+
+WorkStealingDeque::RingBuffer* WorkStealingDeque::_grow(RingBuffer* ring_buffer, int64_t top, int64_t bottom) {
+  auto new_ring_buffer = std::make_unique<RingBuffer>(ring_buffer->capacity * 2);
+  for (auto index = top; index < bottom; ++index) {
+    new_ring_buffer->put(index, ring_buffer->get(index));
+  }
+
+  auto* new_ring_buffer_ptr = new_ring_buffer.get();
+  _ring_buffers.emplace_back(std::move(new_ring_buffer));
+  _ring_buffer.store(new_ring_buffer_ptr, std::memory_order_release);
+  return new_ring_buffer_ptr;
+}
+
+}  // namespace opossum
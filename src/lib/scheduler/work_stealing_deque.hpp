@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractTask;
+
+/**
+ * Chase-Lev work-stealing deque [1], using the memory orderings of the C11 formulation by Lê et al. [2].
+ *
+ * Each deque is owned by exactly one Worker. Only the owner may push() and pop(), both of which operate on the bottom
+ * end of the deque (LIFO, so that freshly spawned jobs are executed while their data is still in the cache). Any
+ * other thread may steal() from the top end (FIFO, so that thieves take the oldest and usually largest tasks). In the
+ * common case, push() and pop() do not execute any atomic read-modify-write operation. Only when the deque contains a
+ * single element, the owner and thieves race for it using a CAS on _top.
+ *
+ * Since slots of the ring buffer might be overwritten by the owner while a thief still reads them, the deque does not
+ * store the shared_ptrs themselves but heap-allocated copies of them. Whoever wins the CAS on _top (or pops an element
+ * without contention) takes ownership of that copy. When the ring buffer runs full, it is replaced with one of twice the
+ * size. The old buffers are retired but kept alive until the deque is destroyed, because a thief might still read from
+ * them.
+ *
+ * [1] Chase and Lev, "Dynamic Circular Work-Stealing Deque", SPAA 2005
+ * [2] Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013
+ */
+class WorkStealingDeque : private Noncopyable {
+ public:
+  explicit WorkStealingDeque(size_t initial_capacity = 1024);
+  ~WorkStealingDeque();
+
+  /**
+   * Adds a task to the bottom of the deque. Must only be called by the owner.
+   */
+  void push(const std::shared_ptr<AbstractTask>& task);
+
+  /**
+   * Removes and returns the task at the bottom of the deque, or nullptr if the deque is empty. Must only be called by
+   * the owner.
+   */
+  std::shared_ptr<AbstractTask> pop();
+
+  /**
+   * Removes and returns the task at the top of the deque. Returns nullptr if the deque is empty or if another thread
+   * won the race for the top element. Can be called by any thread.
+   */
+  std::shared_ptr<AbstractTask> steal();
+
+  /**
+   * Approximate number of tasks in the deque. Might be outdated by the time it is returned.
+   */
+  size_t size() const;
+  bool empty() const;
+
+ private:
+  using Element = std::shared_ptr<AbstractTask>;
+
+  struct RingBuffer {
+    explicit RingBuffer(size_t init_capacity);
+
+    Element* get(int64_t index) const;
+    void put(int64_t index, Element* element);
+
+    const size_t capacity;
+    const size_t mask;
+    std::unique_ptr<std::atomic<Element*>[]> slots;
+  };
+
+  RingBuffer* _grow(RingBuffer* ring_buffer, int64_t top, int64_t bottom);
+
+  // _top and _bottom are modified by different threads (thieves and owner, respectively), so we place them on separate
+  // cache lines.
+  alignas(64) std::atomic<int64_t> _top{0};
+  alignas(64) std::atomic<int64_t> _bottom{0};
+  alignas(64) std::atomic<RingBuffer*> _ring_buffer;
+
+  // Holds the current buffer as well as all retired buffers. Only accessed by the owner.
+  std::vector<std::unique_ptr<RingBuffer>> _ring_buffers;
+};
+
+}  // namespace opossum
@@ -15,6 +15,7 @@
 #include "abstract_task.hpp"
 #include "hyrise.hpp"
 #include "task_queue.hpp"
+#include "work_stealing_deque.hpp"
 
 namespace {
 
@@ -25,15 +26,23 @@ namespace {
 thread_local std::weak_ptr<opossum::Worker> this_thread_worker;
 }  // namespace
 
-// The sleep time was determined experimentally
-static constexpr auto WORKER_SLEEP_TIME = std::chrono::microseconds(300);
+// How long an idle worker spins before it parks itself. Spinning avoids the latency of unparking a worker when tasks
+// are scheduled in quick succession. As only one worker per node spins, the CPU time spent on spinning is bounded.
+static constexpr auto WORKER_SPIN_TIME = std::chrono::microseconds(50);
 
 namespace opossum {
 
 std::shared_ptr<Worker> Worker::get_this_thread_worker() { return ::this_thread_worker.lock(); }
 
-Worker::Worker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id)
-    : _queue(queue), _id(id), _cpu_id(cpu_id) {}
+Worker::Worker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id,
+               UseWorkerDeques use_worker_deques)
+    : _queue(queue), _id(id), _cpu_id(cpu_id) {
+  if (use_worker_deques == UseWorkerDeques::Yes) {
+    _deque = std::make_unique<WorkStealingDeque>();
+  }
+}
+
+Worker::~Worker() = default;
 
 WorkerID Worker::id() const { return _id; }
 
@@ -53,41 +62,213 @@ void Worker::operator()() {
   }
 }
 
-void Worker::_work() {
-  auto task = _queue->pull();
+void Worker::_work(const std::shared_ptr<AbstractTask>& awaited_task) {
+  auto task = _find_task();
 
+  if (_woken_up) {
+    _woken_up = false;
+    if (!task && !(awaited_task && awaited_task->is_done())) {
+      ++_num_spurious_wakeups;
+    }
+  }
+
+  // If there is no ready task neither in our queue nor in any other, worker waits for a new task to be pushed to the
+  // own queue or for the awaited task to finish (whatever occurs first).
   if (!task) {
-    // Simple work stealing without explicitly transferring data between nodes.
-    auto work_stealing_successful = false;
-    for (auto& queue : Hyrise::get().scheduler()->queues()) {
-      if (queue == _queue) {
-        continue;
-      }
+    _wait_for_work(awaited_task);
+    return;
+  }
 
-      task = queue->steal();
-      if (task) {
-        task->set_node_id(_queue->node_id());
-        work_stealing_successful = true;
+  task->execute();
+
+  // This is part of the Scheduler shutdown system. Count the number of tasks a Worker executed to allow the
+  // Scheduler to determine whether all tasks finished
+  _num_finished_tasks++;
+}
+
+void Worker::_wait_for_work(const std::shared_ptr<AbstractTask>& awaited_task) {
+  if (_queue->try_start_spinning()) {
+    const auto spin_end = std::chrono::steady_clock::now() + WORKER_SPIN_TIME;
+    auto found_work = false;
+    while (std::chrono::steady_clock::now() < spin_end) {
+      if (_has_work() || (awaited_task && awaited_task->is_done())) {
+        found_work = true;
         break;
       }
+      std::this_thread::yield();
     }
 
-    // If there is no ready task neither in our queue nor in any other, worker waits for a new task to be pushed to the
-    // own queue or returns after timer exceeded (whatever occurs first).
-    if (!work_stealing_successful) {
-      {
-        std::unique_lock<std::mutex> unique_lock(_queue->lock);
-        _queue->new_task.wait_for(unique_lock, WORKER_SLEEP_TIME);
-      }
+    _queue->stop_spinning();
+
+    if (found_work) {
+      // While we were spinning, pushers did not wake up anybody. If there is more work than what we are about to take,
+      // anywhere we could take it from, make sure that someone else takes care of it.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (_has_work()) _queue->notify_new_task(false);
       return;
     }
   }
 
-  task->execute();
+  _park(awaited_task);
+}
 
-  // This is part of the Scheduler shutdown system. Count the number of tasks a Worker executed to allow the
-  // Scheduler to determine whether all tasks finished
-  _num_finished_tasks++;
+void Worker::_park(const std::shared_ptr<AbstractTask>& awaited_task) {
+  if (awaited_task && !awaited_task->_try_register_waiting_worker(this)) {
+    // Awaited task finished in the meantime
+    return;
+  }
+
+  _queue->add_parked_worker(this);
+
+  // Pairs with the fence in TaskQueue::notify_new_task(). Only after registering as parked, we re-check for work so
+  // that a task that was pushed in the meantime either becomes visible here or leads to this Worker being unparked.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  const auto keep_awake = !Hyrise::get().scheduler()->active() || _has_work() ||
+                          (awaited_task && awaited_task->is_done());
+
+  // If someone else already removed us from the list of parked workers, an unpark() is on its way. Wait for it so that
+  // it does not carry over to the next call of _park().
+  auto removed_from_parked_workers = keep_awake && _queue->remove_parked_worker(this);
+  if (!removed_from_parked_workers) {
+    {
+      std::unique_lock<std::mutex> lock(_park_mutex);
+      _park_condition_variable.wait(lock, [&]() { return _unparked; });
+      _unparked = false;
+
+      ++_num_wakeups;
+      _accumulated_wakeup_latency_ns += static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _unpark_time)
+              .count());
+      _woken_up = true;
+    }
+
+    // When unparked by the awaited task, we are still registered in the TaskQueue
+    removed_from_parked_workers = _queue->remove_parked_worker(this);
+  }
+
+  if (awaited_task) {
+    awaited_task->_unregister_waiting_worker(this);
+
+    // Someone picked us to process a new task, but we are going back to the task that waited. Pass the wake-up on.
+    if (!removed_from_parked_workers && awaited_task->is_done()) _queue->notify_new_task();
+  }
+}
+
+void Worker::unpark() {
+  {
+    std::lock_guard<std::mutex> lock(_park_mutex);
+    _unparked = true;
+    _unpark_time = std::chrono::steady_clock::now();
+  }
+  _park_condition_variable.notify_one();
+}
+
+bool Worker::_has_work() const {
+  if (!_queue->empty()) return true;
+  if (_deque) {
+    if (!_deque->empty()) return true;
+    for (const auto* victim : _node_local_victims) {
+      if (!victim->_deque->empty()) return true;
+    }
+  }
+
+  // Tasks in the queues of other nodes and in the deques of remote Workers can be stolen, see _find_task()
+  for (const auto& queue : Hyrise::get().scheduler()->queues()) {
+    if (queue != _queue && !queue->empty()) return true;
+  }
+  if (_deque) {
+    for (const auto* victim : _remote_victims) {
+      if (!victim->_deque->empty()) return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<AbstractTask> Worker::_find_task() {
+  if (_deque) {
+    auto task = _deque->pop();
+    if (task) return task;
+  }
+
+  auto task = _queue->pull();
+  if (task) return task;
+
+  // Stealing from workers on the same node is cheap, as the data of their tasks is likely in the shared L3 cache
+  if (_deque) {
+    task = _steal_from_deques(_node_local_victims);
+    if (task) return task;
+  }
+
+  // Simple work stealing without explicitly transferring data between nodes.
+  for (auto& queue : Hyrise::get().scheduler()->queues()) {
+    if (queue == _queue) {
+      continue;
+    }
+
+    task = queue->steal();
+    if (task) {
+      task->set_node_id(_queue->node_id());
+      return task;
+    }
+  }
+
+  if (_deque) {
+    task = _steal_from_deques(_remote_victims);
+    if (task) {
+      task->set_node_id(_queue->node_id());
+      return task;
+    }
+  }
+
+  return nullptr;
+}
+
+std::shared_ptr<AbstractTask> Worker::_steal_from_deques(const std::vector<Worker*>& victims) {
+  // Start with a different victim every time so that idle workers do not all contend for the same deque
+  const auto victim_count = victims.size();
+  for (auto victim_idx = size_t{0}; victim_idx < victim_count; ++victim_idx) {
+    auto& victim_deque = *victims[(_next_victim_offset + victim_idx) % victim_count]->_deque;
+
+    // steal() fails if we lose the race for the top element. Retry as long as there is something left to steal.
+    while (!victim_deque.empty()) {
+      auto task = victim_deque.steal();
+      if (task) {
+        _next_victim_offset += victim_idx;
+        return task;
+      }
+    }
+  }
+
+  ++_next_victim_offset;
+  return nullptr;
+}
+
+void Worker::push_task(const std::shared_ptr<AbstractTask>& task, SchedulePriority priority) {
+  DebugAssert(::this_thread_worker.lock().get() == this, "Tasks can only be pushed by the Worker's own thread");
+
+  // Tasks that may not leave their node are never put into a deque, as deques can be stolen from by remote workers
+  if (!_deque || !task->is_stealable()) {
+    _queue->push(task, static_cast<uint32_t>(priority));
+    return;
+  }
+
+  // Someone else was first to enqueue this task? No problem!
+  if (!task->try_mark_as_enqueued()) return;
+
+  // The deque does not know priorities. As it is LIFO, the pushed task is the next one the owner executes anyway.
+  task->set_node_id(_queue->node_id());
+  _deque->push(task);
+
+  // Wake up an idle worker of this node so that it can steal the task while we are busy
+  _queue->notify_new_task();
+}
+
+void Worker::_set_steal_victims(std::vector<Worker*>&& node_local_victims, std::vector<Worker*>&& remote_victims) {
+  DebugAssert(_deque, "Only Workers with a deque steal from other deques");
+  _node_local_victims = std::move(node_local_victims);
+  _remote_victims = std::move(remote_victims);
+  _next_victim_offset = _id;
 }
 
 void Worker::start() { _thread = std::thread(&Worker::operator(), this); }
@@ -99,6 +280,14 @@ void Worker::join() {
 
 uint64_t Worker::num_finished_tasks() const { return _num_finished_tasks; }
 
+uint64_t Worker::num_wakeups() const { return _num_wakeups; }
+
+uint64_t Worker::num_spurious_wakeups() const { return _num_spurious_wakeups; }
+
+std::chrono::nanoseconds Worker::accumulated_wakeup_latency() const {
+  return std::chrono::nanoseconds{_accumulated_wakeup_latency_ns.load()};
+}
+
 void Worker::_set_affinity() {
 #if HYRISE_NUMA_SUPPORT
   cpu_set_t cpuset;
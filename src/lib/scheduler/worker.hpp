@@ -1,7 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -10,19 +13,33 @@
 
 namespace opossum {
 
+class AbstractTask;
 class TaskQueue;
+class WorkStealingDeque;
 
 /**
  * To be executed on a separate Thread, fetches and executes tasks until the queue is empty AND the shutdown flag is set
  * Ideally there should be one Worker actively doing work per CPU, but multiple might be active occasionally
+ *
+ * If the Worker is created with UseWorkerDeques::Yes, it additionally owns a WorkStealingDeque. Tasks that are
+ * scheduled by the task running on this Worker are pushed to that deque instead of the shared TaskQueue of the node.
+ * When looking for work, the Worker first pops from its own deque, then pulls from its node's TaskQueue, then steals
+ * from the deques of the other Workers on the same node, and only then turns to remote nodes.
+ *
+ * If no work is found, the Worker does not poll but spins briefly (at most one Worker per node) and then parks until it
+ * is unparked by its TaskQueue because a new task arrived, or - if it is waiting for tasks - until one of the awaited
+ * tasks is done.
  */
 class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable {
   friend class AbstractScheduler;
+  friend class NodeQueueScheduler;
 
  public:
   static std::shared_ptr<Worker> get_this_thread_worker();
 
-  Worker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id);
+  Worker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id,
+         UseWorkerDeques use_worker_deques = UseWorkerDeques::No);
+  ~Worker();
 
   /**
    * Unique ID of a worker. Currently not in use, but really helpful for debugging.
@@ -31,32 +48,57 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
   std::shared_ptr<TaskQueue> queue() const;
   CpuID cpu_id() const;
 
+  /**
+   * Enqueues a task that became ready on this Worker (e.g., a job spawned by the currently executed task or a successor
+   * of it). Goes to the Worker's deque if it has one and the task may be stolen, otherwise to the node's TaskQueue.
+   * Must only be called from the thread of this Worker.
+   */
+  void push_task(const std::shared_ptr<AbstractTask>& task, SchedulePriority priority);
+
+  /**
+   * Wakes up the Worker if it is parked. If it is not, its next attempt to park returns immediately.
+   */
+  void unpark();
+
   void start();
   void join();
 
   uint64_t num_finished_tasks() const;
 
+  /**
+   * Metrics of the parking protocol. A wake-up is spurious if the Worker did not find anything to do afterwards. The
+   * wake-up latency is the time between the call to unpark() and the Worker resuming execution.
+   */
+  uint64_t num_wakeups() const;
+  uint64_t num_spurious_wakeups() const;
+  std::chrono::nanoseconds accumulated_wakeup_latency() const;
+
   void operator=(const Worker&) = delete;
   void operator=(Worker&&) = delete;
 
  protected:
   void operator()();
-  void _work();
+
+  /**
+   * Executes one task or, if none is available, waits for work. If awaited_task is set, the wait also ends when that
+   * task is done.
+   */
+  void _work(const std::shared_ptr<AbstractTask>& awaited_task = nullptr);
 
   template <typename TaskType>
   void _wait_for_tasks(const std::vector<std::shared_ptr<TaskType>>& tasks) {
-    auto tasks_completed = [&tasks]() {
+    auto find_unfinished_task = [&tasks]() -> std::shared_ptr<AbstractTask> {
       // Reversely iterate through the list of tasks, because unfinished tasks are likely at the end of the list.
       for (auto it = tasks.rbegin(); it != tasks.rend(); ++it) {
         if (!(*it)->is_done()) {
-          return false;
+          return *it;
         }
       }
-      return true;
+      return nullptr;
     };
 
-    while (!tasks_completed()) {
-      _work();
+    while (const auto unfinished_task = find_unfinished_task()) {
+      _work(unfinished_task);
     }
   }
 
@@ -67,11 +109,47 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
    */
   void _set_affinity();
 
+  /**
+   * Looks for a task that can be executed, see class comment for the order in which the different sources are visited
+   */
+  std::shared_ptr<AbstractTask> _find_task();
+  std::shared_ptr<AbstractTask> _steal_from_deques(const std::vector<Worker*>& victims);
+
+  /**
+   * Set by the NodeQueueScheduler once all Workers have been created. Only used if the Worker owns a deque. The
+   * scheduler guarantees that the Workers outlive each other's threads, so raw pointers are sufficient.
+   */
+  void _set_steal_victims(std::vector<Worker*>&& node_local_victims, std::vector<Worker*>&& remote_victims);
+
+  /**
+   * Cheap check whether there might be work in any of the queues and deques that _find_task() takes tasks from, used
+   * while spinning and before going to sleep.
+   */
+  bool _has_work() const;
+
+  void _wait_for_work(const std::shared_ptr<AbstractTask>& awaited_task);
+  void _park(const std::shared_ptr<AbstractTask>& awaited_task);
+
   std::shared_ptr<TaskQueue> _queue;
+  std::unique_ptr<WorkStealingDeque> _deque;
+  std::vector<Worker*> _node_local_victims;
+  std::vector<Worker*> _remote_victims;
+  size_t _next_victim_offset{0};
   WorkerID _id;
   CpuID _cpu_id;
   std::thread _thread;
   std::atomic<uint64_t> _num_finished_tasks{0};
+
+  // For parking
+  std::mutex _park_mutex;
+  std::condition_variable _park_condition_variable;
+  bool _unparked{false};
+  std::chrono::steady_clock::time_point _unpark_time;
+  bool _woken_up{false};
+
+  std::atomic<uint64_t> _num_wakeups{0};
+  std::atomic<uint64_t> _num_spurious_wakeups{0};
+  std::atomic<uint64_t> _accumulated_wakeup_latency_ns{0};
 };
 
 }  // namespace opossum
@@ -0,0 +1,235 @@
+#include "parameterized_plan.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "cost_estimation/cost_estimator_logical.hpp"
+#include "expression/abstract_predicate_expression.hpp"
+#include "expression/correlated_parameter_expression.hpp"
+#include "expression/expression_utils.hpp"
+#include "expression/lqp_subquery_expression.hpp"
+#include "expression/placeholder_expression.hpp"
+#include "expression/value_expression.hpp"
+#include "logical_query_plan/abstract_lqp_node.hpp"
+#include "logical_query_plan/lqp_translator.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "operators/abstract_operator.hpp"
+#include "optimizer/optimizer.hpp"
+#include "statistics/cardinality_estimator.hpp"
+#include "storage/prepared_plan.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Raises @param next_parameter_id above the ParameterIDs used in @param lqp and its subqueries, so that the
+// ParameterIDs of the replaced literals do not collide with those of correlated subqueries.
+void skip_used_parameter_ids(const std::shared_ptr<AbstractLQPNode>& lqp,
+                             std::unordered_set<std::shared_ptr<AbstractLQPNode>>& visited_nodes,
+                             ParameterID& next_parameter_id) {
+  const auto skip_parameter_id = [&](const ParameterID parameter_id) {
+    next_parameter_id = std::max(next_parameter_id, ParameterID{parameter_id + 1});
+  };
+
+  visit_lqp(lqp, [&](const auto& node) {
+    if (!visited_nodes.emplace(node).second) return LQPVisitation::DoNotVisitInputs;
+
+    for (const auto& expression : node->node_expressions) {
+      visit_expression(expression, [&](const auto& sub_expression) {
+        if (const auto parameter_expression =
+                std::dynamic_pointer_cast<CorrelatedParameterExpression>(sub_expression)) {
+          skip_parameter_id(parameter_expression->parameter_id);
+        } else if (const auto placeholder_expression =
+                       std::dynamic_pointer_cast<PlaceholderExpression>(sub_expression)) {
+          skip_parameter_id(placeholder_expression->parameter_id);
+        } else if (const auto subquery_expression = std::dynamic_pointer_cast<LQPSubqueryExpression>(sub_expression)) {
+          for (const auto parameter_id : subquery_expression->parameter_ids) {
+            skip_parameter_id(parameter_id);
+          }
+          skip_used_parameter_ids(subquery_expression->lqp, visited_nodes, next_parameter_id);
+        }
+        return ExpressionVisitation::VisitArguments;
+      });
+    }
+
+    return LQPVisitation::VisitInputs;
+  });
+}
+
+bool is_parameterizable_literal(const std::shared_ptr<AbstractExpression>& expression) {
+  return expression->type == ExpressionType::Value &&
+         !variant_is_null(static_cast<const ValueExpression&>(*expression).value);
+}
+
+// Returns a copy of @param lqp in which the CorrelatedParameterExpressions of @param parameters are replaced by their
+// values. Subqueries are not visited, as the literals are only replaced outside of them.
+std::shared_ptr<AbstractLQPNode> lqp_bind_parameter_values(
+    const std::shared_ptr<AbstractLQPNode>& lqp, const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  const auto bound_lqp = lqp->deep_copy();
+
+  visit_lqp(bound_lqp, [&](const auto& node) {
+    for (auto& expression : node->node_expressions) {
+      visit_expression(expression, [&](auto& sub_expression) {
+        if (sub_expression->type != ExpressionType::CorrelatedParameter) return ExpressionVisitation::VisitArguments;
+
+        const auto& parameter_expression = static_cast<const CorrelatedParameterExpression&>(*sub_expression);
+        const auto parameter_iter = parameters.find(parameter_expression.parameter_id);
+        if (parameter_iter != parameters.end()) {
+          sub_expression = std::make_shared<ValueExpression>(parameter_iter->second);
+        }
+        return ExpressionVisitation::DoNotVisitArguments;
+      });
+    }
+
+    return LQPVisitation::VisitInputs;
+  });
+
+  return bound_lqp;
+}
+
+Cost estimate_plan_cost(const std::shared_ptr<AbstractLQPNode>& lqp) {
+  return CostEstimatorLogical{std::make_shared<CardinalityEstimator>()}.estimate_plan_cost(lqp);
+}
+
+}  // namespace
+
+namespace opossum {
+
+bool NormalizedStatement::operator==(const NormalizedStatement& rhs) const {
+  return parameter_data_types == rhs.parameter_data_types && *lqp == *rhs.lqp;
+}
+
+std::optional<ParameterizedStatement> parameterize_literals(const std::shared_ptr<AbstractLQPNode>& lqp) {
+  auto parameterized_statement = ParameterizedStatement{};
+  auto& normalized_statement = parameterized_statement.normalized_statement;
+  normalized_statement.lqp = lqp->deep_copy();
+
+  auto visited_nodes = std::unordered_set<std::shared_ptr<AbstractLQPNode>>{};
+  auto next_parameter_id = ParameterID{0};
+  skip_used_parameter_ids(normalized_statement.lqp, visited_nodes, next_parameter_id);
+
+  const auto replace_literal = [&](std::shared_ptr<AbstractExpression>& argument) {
+    if (!is_parameterizable_literal(argument)) return;
+
+    const auto& value = static_cast<const ValueExpression&>(*argument).value;
+    normalized_statement.parameter_data_types.emplace_back(data_type_from_all_type_variant(value));
+    parameterized_statement.parameter_ids.emplace_back(next_parameter_id);
+    parameterized_statement.parameters.emplace(next_parameter_id, value);
+
+    argument = std::make_shared<PlaceholderExpression>(next_parameter_id);
+    ++next_parameter_id;
+  };
+
+  visit_lqp(normalized_statement.lqp, [&](const auto& node) {
+    if (node->type != LQPNodeType::Predicate) return LQPVisitation::VisitInputs;
+
+    visit_expression(node->node_expressions.front(), [&](auto& sub_expression) {
+      const auto predicate_expression = std::dynamic_pointer_cast<AbstractPredicateExpression>(sub_expression);
+      if (!predicate_expression) return ExpressionVisitation::VisitArguments;
+
+      // Literals compared with literals are left to the ExpressionReductionRule
+      auto& arguments = predicate_expression->arguments;
+      const auto predicate_condition = predicate_expression->predicate_condition;
+      if (is_binary_numeric_predicate_condition(predicate_condition) &&
+          is_parameterizable_literal(arguments[0]) != is_parameterizable_literal(arguments[1])) {
+        replace_literal(arguments[0]);
+        replace_literal(arguments[1]);
+      } else if (is_between_predicate_condition(predicate_condition) && arguments[0]->type != ExpressionType::Value) {
+        replace_literal(arguments[1]);
+        replace_literal(arguments[2]);
+      }
+
+      return ExpressionVisitation::DoNotVisitArguments;
+    });
+
+    return LQPVisitation::VisitInputs;
+  });
+
+  if (parameterized_statement.parameter_ids.empty()) return std::nullopt;
+
+  return parameterized_statement;
+}
+
+ParameterizedPlan::ParameterizedPlan(const std::shared_ptr<AbstractLQPNode>& init_lqp,
+                                     const std::shared_ptr<AbstractOperator>& init_pqp, const Cost init_reference_cost)
+    : lqp(init_lqp), pqp(init_pqp), reference_cost(init_reference_cost) {}
+
+std::shared_ptr<ParameterizedPlan> ParameterizedPlan::create(const ParameterizedStatement& parameterized_statement,
+                                                             const Optimizer& optimizer,
+                                                             const std::shared_ptr<AbstractLQPNode>& optimized_lqp) {
+  const auto& normalized_statement = parameterized_statement.normalized_statement;
+  const auto parameter_count = parameterized_statement.parameter_ids.size();
+
+  // Turn the placeholders into CorrelatedParameterExpressions, which, other than placeholders, have a DataType and can
+  // be bound in the PQP
+  auto parameter_expressions = std::vector<std::shared_ptr<AbstractExpression>>{};
+  parameter_expressions.reserve(parameter_count);
+  for (auto parameter_idx = size_t{0}; parameter_idx < parameter_count; ++parameter_idx) {
+    const auto referenced_expression_info = CorrelatedParameterExpression::ReferencedExpressionInfo{
+        normalized_statement.parameter_data_types[parameter_idx], "literal"};
+    parameter_expressions.emplace_back(std::make_shared<CorrelatedParameterExpression>(
+        parameterized_statement.parameter_ids[parameter_idx], referenced_expression_info));
+  }
+
+  const auto prepared_plan = PreparedPlan{normalized_statement.lqp, parameterized_statement.parameter_ids};
+  const auto generic_lqp = optimizer.optimize(prepared_plan.instantiate(parameter_expressions));
+
+  const auto generic_cost =
+      estimate_plan_cost(lqp_bind_parameter_values(generic_lqp, parameterized_statement.parameters));
+  const auto optimized_cost = estimate_plan_cost(optimized_lqp);
+
+  if (generic_cost > optimized_cost * REOPTIMIZATION_THRESHOLD) {
+    return std::make_shared<ParameterizedPlan>(generic_lqp, nullptr, generic_cost);
+  }
+
+  // Translate a copy, as the LQPTranslator might modify mutable fields of the LQP (see SQLPipelineStatement)
+  const auto generic_pqp = LQPTranslator{}.translate_node(generic_lqp->deep_copy());
+  return std::make_shared<ParameterizedPlan>(generic_lqp, generic_pqp, generic_cost);
+}
+
+std::shared_ptr<AbstractOperator> ParameterizedPlan::instantiate(
+    const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  ++_lookup_count;
+  if (!pqp) return nullptr;
+
+  const auto cost = estimate_plan_cost(lqp_bind_parameter_values(lqp, parameters));
+  if (cost > reference_cost * REOPTIMIZATION_THRESHOLD || reference_cost > cost * REOPTIMIZATION_THRESHOLD) {
+    return nullptr;
+  }
+
+  ++_hit_count;
+  const auto bound_pqp = pqp->deep_copy();
+  bound_pqp->set_parameters(parameters);
+  return bound_pqp;
+}
+
+bool ParameterizedPlan::is_selectivity_sensitive() const { return !pqp; }
+
+size_t ParameterizedPlan::lookup_count() const { return _lookup_count; }
+
+size_t ParameterizedPlan::hit_count() const { return _hit_count; }
+
+float ParameterizedPlan::hit_rate() const {
+  return static_cast<float>(_hit_count) / static_cast<float>(_lookup_count);
+}
+
+}  // namespace opossum
+
+namespace std {
+
+size_t hash<opossum::NormalizedStatement>::operator()(
+    const opossum::NormalizedStatement& normalized_statement) const {
+  auto hash = normalized_statement.lqp->hash();
+  for (const auto data_type : normalized_statement.parameter_data_types) {
+    boost::hash_combine(hash, static_cast<size_t>(data_type));
+  }
+  return hash;
+}
+
+}  // namespace std
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractLQPNode;
+class AbstractOperator;
+class Optimizer;
+
+/**
+ * An SQL statement with the literals of its predicates replaced by PlaceholderExpressions (see
+ * parameterize_literals()). Statements that only differ in these literals have equal NormalizedStatements, which are
+ * used as the keys of the SQLParameterizedPlanCache.
+ */
+struct NormalizedStatement {
+  bool operator==(const NormalizedStatement& rhs) const;
+
+  // The unoptimized LQP, with a PlaceholderExpression for each replaced literal
+  std::shared_ptr<AbstractLQPNode> lqp;
+
+  // Literals of different types (e.g., `a > 1` and `a > 1.5`) are scanned differently, so their types are part of the
+  // statement.
+  std::vector<DataType> parameter_data_types;
+};
+
+struct ParameterizedStatement {
+  NormalizedStatement normalized_statement;
+
+  // The ParameterIDs of the PlaceholderExpressions in the order of parameter_data_types, and the replaced literals
+  std::vector<ParameterID> parameter_ids;
+  std::unordered_map<ParameterID, AllTypeVariant> parameters;
+};
+
+/**
+ * Replaces the non-NULL literals that are compared to a non-literal in the PredicateNodes of @param lqp (e.g., `5` in
+ * `a > 5` or both bounds in `a BETWEEN 2 AND 3`) by PlaceholderExpressions. Other literals (e.g., in projections,
+ * LIMIT, or IN lists) and subqueries are left untouched, as they usually determine the shape of the plan.
+ * @param lqp itself is not modified.
+ *
+ * @return std::nullopt if the LQP has no literals to replace
+ */
+std::optional<ParameterizedStatement> parameterize_literals(const std::shared_ptr<AbstractLQPNode>& lqp);
+
+/**
+ * A generic plan for a NormalizedStatement, as stored in the SQLParameterizedPlanCache. Its optimized LQP and PQP hold
+ * a CorrelatedParameterExpression for each replaced literal, so that the PQP can be bound to the literals of a
+ * statement with AbstractOperator::set_parameters().
+ *
+ * The optimizer does not know the values of parameters: It uses default selectivities and the ChunkPruningRule and
+ * IndexScanRule do not apply. A generic plan is thus a bad choice if the best plan depends on the literals. To detect
+ * this, create() compares the estimated cost of the generic plan with that of the plan optimized for the literals of
+ * the first execution. If the generic plan is more than REOPTIMIZATION_THRESHOLD times as expensive, the statement is
+ * considered selectivity-sensitive and no PQP is kept - every execution is optimized for its literals. Likewise, if
+ * the literals of a later execution change the estimated cost of the generic plan by more than
+ * REOPTIMIZATION_THRESHOLD in either direction, that execution is optimized for its literals instead.
+ */
+class ParameterizedPlan : private Noncopyable {
+ public:
+  static constexpr auto REOPTIMIZATION_THRESHOLD = 2.0f;
+
+  ParameterizedPlan(const std::shared_ptr<AbstractLQPNode>& init_lqp, const std::shared_ptr<AbstractOperator>& init_pqp,
+                    const Cost init_reference_cost);
+
+  /**
+   * Optimizes the generic plan for @param parameterized_statement with @param optimizer and compares it with
+   * @param optimized_lqp, the plan optimized for the literals of the statement. Counts as the first lookup.
+   */
+  static std::shared_ptr<ParameterizedPlan> create(const ParameterizedStatement& parameterized_statement,
+                                                   const Optimizer& optimizer,
+                                                   const std::shared_ptr<AbstractLQPNode>& optimized_lqp);
+
+  /**
+   * @return a copy of the PQP that is bound to @param parameters, or nullptr if the statement has to be optimized for
+   *         these parameters. Counts as a lookup and, if a PQP is returned, as a hit.
+   */
+  std::shared_ptr<AbstractOperator> instantiate(const std::unordered_map<ParameterID, AllTypeVariant>& parameters);
+
+  bool is_selectivity_sensitive() const;
+
+  size_t lookup_count() const;
+  size_t hit_count() const;
+
+  // The share of lookups (i.e., executions of the NormalizedStatement) that were served with the cached PQP
+  float hit_rate() const;
+
+  // The optimized generic LQP
+  const std::shared_ptr<AbstractLQPNode> lqp;
+
+  // The PQP translated from `lqp`, without a TransactionContext. nullptr if the statement is selectivity-sensitive.
+  const std::shared_ptr<AbstractOperator> pqp;
+
+  // The estimated cost of `lqp` for the literals of the first execution
+  const Cost reference_cost;
+
+ private:
+  std::atomic<size_t> _lookup_count{1};
+  std::atomic<size_t> _hit_count{0};
+};
+
+}  // namespace opossum
+
+namespace std {
+
+template <>
+struct hash<opossum::NormalizedStatement> {
+  size_t operator()(const opossum::NormalizedStatement& normalized_statement) const;
+};
+
+}  // namespace std
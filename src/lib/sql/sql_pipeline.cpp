@@ -18,9 +18,12 @@ SQLPipeline::SQLPipeline(const std::string& sql, const std::shared_ptr<Transacti
                          const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
                          const std::shared_ptr<SQLPhysicalPlanCache>& pqp_cache,
                          const std::shared_ptr<SQLLogicalPlanCache>& lqp_cache,
-                         const CleanupTemporaries cleanup_temporaries)
+                         const std::shared_ptr<SQLParameterizedPlanCache>& parameterized_plan_cache,
+                         const CleanupTemporaries cleanup_temporaries,
+                         const UseMorselPipelines use_morsel_pipelines)
     : pqp_cache(pqp_cache),
       lqp_cache(lqp_cache),
+      parameterized_plan_cache(parameterized_plan_cache),
       _sql(sql),
       _transaction_context(transaction_context),
       _optimizer(optimizer) {
@@ -80,9 +83,9 @@ SQLPipeline::SQLPipeline(const std::string& sql, const std::shared_ptr<Transacti
     const auto statement_string = boost::trim_copy(sql.substr(sql_string_offset, statement_string_length));
     sql_string_offset += statement_string_length;
 
-    auto pipeline_statement = std::make_shared<SQLPipelineStatement>(statement_string, std::move(parsed_statement),
-                                                                     use_mvcc, transaction_context, optimizer,
-                                                                     pqp_cache, lqp_cache, cleanup_temporaries);
+    auto pipeline_statement = std::make_shared<SQLPipelineStatement>(
+        statement_string, std::move(parsed_statement), use_mvcc, transaction_context, optimizer, pqp_cache, lqp_cache,
+        parameterized_plan_cache, cleanup_temporaries, use_morsel_pipelines);
     _sql_pipeline_statements.push_back(std::move(pipeline_statement));
   }
 
@@ -273,6 +276,7 @@ std::ostream& operator<<(std::ostream& stream, const SQLPipelineMetrics& metrics
   auto total_lqp_translate_nanos = std::chrono::nanoseconds::zero();
   auto total_execute_nanos = std::chrono::nanoseconds::zero();
   std::vector<bool> query_plan_cache_hits;
+  auto num_parameterized_plan_cache_hits = size_t{0};
 
   for (const auto& statement_metric : metrics.statement_metrics) {
     total_sql_translate_nanos += statement_metric->sql_translation_duration;
@@ -281,6 +285,7 @@ std::ostream& operator<<(std::ostream& stream, const SQLPipelineMetrics& metrics
     total_execute_nanos += statement_metric->plan_execution_duration;
 
     query_plan_cache_hits.push_back(statement_metric->query_plan_cache_hit);
+    if (statement_metric->parameterized_plan_cache_hit) ++num_parameterized_plan_cache_hits;
   }
 
   const auto num_cache_hits = std::count(query_plan_cache_hits.begin(), query_plan_cache_hits.end(), true);
@@ -291,7 +296,9 @@ std::ostream& operator<<(std::ostream& stream, const SQLPipelineMetrics& metrics
   stream << "OPTIMIZE: " << format_duration(total_optimize_nanos) << ", ";
   stream << "LQP TRANSLATE: " << format_duration(total_lqp_translate_nanos) << ", ";
   stream << "EXECUTE: " << format_duration(total_execute_nanos) << " (wall time) | ";
-  stream << "QUERY PLAN CACHE HITS: " << num_cache_hits << "/" << query_plan_cache_hits.size() << " statement(s)";
+  stream << "QUERY PLAN CACHE HITS: " << num_cache_hits << "/" << query_plan_cache_hits.size() << " statement(s), ";
+  stream << "PARAMETERIZED PLAN CACHE HITS: " << num_parameterized_plan_cache_hits << "/"
+         << query_plan_cache_hits.size() << " statement(s)";
   stream << "]\n";
 
   return stream;
@@ -36,7 +36,9 @@ class SQLPipeline : public Noncopyable {
   SQLPipeline(const std::string& sql, const std::shared_ptr<TransactionContext>& transaction_context,
               const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
               const std::shared_ptr<SQLPhysicalPlanCache>& pqp_cache,
-              const std::shared_ptr<SQLLogicalPlanCache>& lqp_cache, const CleanupTemporaries cleanup_temporaries);
+              const std::shared_ptr<SQLLogicalPlanCache>& lqp_cache,
+              const std::shared_ptr<SQLParameterizedPlanCache>& parameterized_plan_cache,
+              const CleanupTemporaries cleanup_temporaries, const UseMorselPipelines use_morsel_pipelines);
 
   // Returns the original SQL string
   const std::string& get_sql() const;
@@ -93,6 +95,7 @@ class SQLPipeline : public Noncopyable {
 
   const std::shared_ptr<SQLPhysicalPlanCache> pqp_cache;
   const std::shared_ptr<SQLLogicalPlanCache> lqp_cache;
+  const std::shared_ptr<SQLParameterizedPlanCache> parameterized_plan_cache;
 
  private:
   std::string _sql;
@@ -5,9 +5,13 @@ namespace opossum {
 
 std::shared_ptr<SQLPhysicalPlanCache> SQLPipelineBuilder::default_pqp_cache{};
 std::shared_ptr<SQLLogicalPlanCache> SQLPipelineBuilder::default_lqp_cache{};
+std::shared_ptr<SQLParameterizedPlanCache> SQLPipelineBuilder::default_parameterized_plan_cache{};
 
 SQLPipelineBuilder::SQLPipelineBuilder(const std::string& sql)
-    : _sql(sql), _pqp_cache(default_pqp_cache), _lqp_cache(default_lqp_cache) {}
+    : _sql(sql),
+      _pqp_cache(default_pqp_cache),
+      _lqp_cache(default_lqp_cache),
+      _parameterized_plan_cache(default_parameterized_plan_cache) {}
 
 SQLPipelineBuilder& SQLPipelineBuilder::with_mvcc(const UseMvcc use_mvcc) {
   _use_mvcc = use_mvcc;
@@ -37,6 +41,12 @@ SQLPipelineBuilder& SQLPipelineBuilder::with_lqp_cache(const std::shared_ptr<SQL
   return *this;
 }
 
+SQLPipelineBuilder& SQLPipelineBuilder::with_parameterized_plan_cache(
+    const std::shared_ptr<SQLParameterizedPlanCache>& parameterized_plan_cache) {
+  _parameterized_plan_cache = parameterized_plan_cache;
+  return *this;
+}
+
 SQLPipelineBuilder& SQLPipelineBuilder::disable_mvcc() { return with_mvcc(UseMvcc::No); }
 
 SQLPipelineBuilder& SQLPipelineBuilder::dont_cleanup_temporaries() {
@@ -44,11 +54,16 @@ SQLPipelineBuilder& SQLPipelineBuilder::dont_cleanup_temporaries() {
   return *this;
 }
 
+SQLPipelineBuilder& SQLPipelineBuilder::with_morsel_pipelines(const UseMorselPipelines use_morsel_pipelines) {
+  _use_morsel_pipelines = use_morsel_pipelines;
+  return *this;
+}
+
 SQLPipeline SQLPipelineBuilder::create_pipeline() const {
   DTRACE_PROBE1(HYRISE, CREATE_PIPELINE, reinterpret_cast<uintptr_t>(this));
   auto optimizer = _optimizer ? _optimizer : Optimizer::create_default_optimizer();
-  auto pipeline =
-      SQLPipeline(_sql, _transaction_context, _use_mvcc, optimizer, _pqp_cache, _lqp_cache, _cleanup_temporaries);
+  auto pipeline = SQLPipeline(_sql, _transaction_context, _use_mvcc, optimizer, _pqp_cache, _lqp_cache,
+                              _parameterized_plan_cache, _cleanup_temporaries, _use_morsel_pipelines);
   DTRACE_PROBE3(HYRISE, PIPELINE_CREATION_DONE, pipeline.get_sql_per_statement().size(), _sql.c_str(),
                 reinterpret_cast<uintptr_t>(this));
   return pipeline;
@@ -58,8 +73,16 @@ SQLPipelineStatement SQLPipelineBuilder::create_pipeline_statement(
     std::shared_ptr<hsql::SQLParserResult> parsed_sql) const {
   auto optimizer = _optimizer ? _optimizer : Optimizer::create_default_optimizer();
 
-  return {_sql,       std::move(parsed_sql), _use_mvcc, _transaction_context, optimizer, _pqp_cache,
-          _lqp_cache, _cleanup_temporaries};
+  return {_sql,
+          std::move(parsed_sql),
+          _use_mvcc,
+          _transaction_context,
+          optimizer,
+          _pqp_cache,
+          _lqp_cache,
+          _parameterized_plan_cache,
+          _cleanup_temporaries,
+          _use_morsel_pipelines};
 }
 
 }  // namespace opossum
@@ -41,6 +41,7 @@ class SQLPipelineBuilder final {
   // way of communicating with Hyrise are global variables.
   static std::shared_ptr<SQLPhysicalPlanCache> default_pqp_cache;
   static std::shared_ptr<SQLLogicalPlanCache> default_lqp_cache;
+  static std::shared_ptr<SQLParameterizedPlanCache> default_parameterized_plan_cache;
 
   explicit SQLPipelineBuilder(const std::string& sql);
 
@@ -50,6 +51,13 @@ class SQLPipelineBuilder final {
   SQLPipelineBuilder& with_pqp_cache(const std::shared_ptr<SQLPhysicalPlanCache>& pqp_cache);
   SQLPipelineBuilder& with_lqp_cache(const std::shared_ptr<SQLLogicalPlanCache>& lqp_cache);
 
+  /*
+   * Share optimized plans between statements that only differ in the literals of their predicates, see
+   * ParameterizedPlan. Not used by default.
+   */
+  SQLPipelineBuilder& with_parameterized_plan_cache(
+      const std::shared_ptr<SQLParameterizedPlanCache>& parameterized_plan_cache);
+
   /**
    * Short for with_mvcc(UseMvcc::No)
    */
@@ -60,6 +68,12 @@ class SQLPipelineBuilder final {
    */
   SQLPipelineBuilder& dont_cleanup_temporaries();
 
+  /*
+   * Execute chains of chunk-local operators (TableScan, Validate, Projection) chunk by chunk instead of materializing
+   * the output of each operator, see MorselPipeline
+   */
+  SQLPipelineBuilder& with_morsel_pipelines(const UseMorselPipelines use_morsel_pipelines);
+
   SQLPipeline create_pipeline() const;
 
   /**
@@ -76,7 +90,9 @@ class SQLPipelineBuilder final {
   std::shared_ptr<Optimizer> _optimizer;
   std::shared_ptr<SQLPhysicalPlanCache> _pqp_cache;
   std::shared_ptr<SQLLogicalPlanCache> _lqp_cache;
+  std::shared_ptr<SQLParameterizedPlanCache> _parameterized_plan_cache;
   CleanupTemporaries _cleanup_temporaries{true};
+  UseMorselPipelines _use_morsel_pipelines{UseMorselPipelines::No};
 };
 
 }  // namespace opossum
@@ -1,6 +1,7 @@
 #include "sql_pipeline_statement.hpp"
 
 #include <iomanip>
+#include <unordered_set>
 #include <utility>
 
 #include <boost/algorithm/string.hpp>
@@ -10,12 +11,15 @@
 #include "expression/value_expression.hpp"
 #include "hyrise.hpp"
 #include "logical_query_plan/lqp_utils.hpp"
+#include "operators/abstract_join_operator.hpp"
 #include "operators/maintenance/create_prepared_plan.hpp"
 #include "operators/maintenance/create_table.hpp"
 #include "operators/maintenance/create_view.hpp"
 #include "operators/maintenance/drop_table.hpp"
 #include "operators/maintenance/drop_view.hpp"
+#include "operators/morsel_pipeline.hpp"
 #include "optimizer/optimizer.hpp"
+#include "sql/parameterized_plan.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_plan_cache.hpp"
 #include "sql/sql_translator.hpp"
@@ -30,9 +34,12 @@ SQLPipelineStatement::SQLPipelineStatement(const std::string& sql, std::shared_p
                                            const std::shared_ptr<Optimizer>& optimizer,
                                            const std::shared_ptr<SQLPhysicalPlanCache>& pqp_cache,
                                            const std::shared_ptr<SQLLogicalPlanCache>& lqp_cache,
-                                           const CleanupTemporaries cleanup_temporaries)
+                                           const std::shared_ptr<SQLParameterizedPlanCache>& parameterized_plan_cache,
+                                           const CleanupTemporaries cleanup_temporaries,
+                                           const UseMorselPipelines use_morsel_pipelines)
     : pqp_cache(pqp_cache),
       lqp_cache(lqp_cache),
+      parameterized_plan_cache(parameterized_plan_cache),
       _sql_string(sql),
       _use_mvcc(use_mvcc),
       _auto_commit(_use_mvcc == UseMvcc::Yes && !transaction_context),
@@ -40,7 +47,8 @@ SQLPipelineStatement::SQLPipelineStatement(const std::string& sql, std::shared_p
       _optimizer(optimizer),
       _parsed_sql_statement(std::move(parsed_sql)),
       _metrics(std::make_shared<SQLPipelineStatementMetrics>()),
-      _cleanup_temporaries(cleanup_temporaries) {
+      _cleanup_temporaries(cleanup_temporaries),
+      _use_morsel_pipelines(use_morsel_pipelines) {
   Assert(!_parsed_sql_statement || _parsed_sql_statement->size() == 1,
          "SQLPipelineStatement must hold exactly one SQL statement");
   DebugAssert(!_sql_string.empty(), "An SQLPipelineStatement should always contain a SQL statement string for caching");
@@ -102,7 +110,7 @@ const std::shared_ptr<AbstractLQPNode>& SQLPipelineStatement::get_optimized_logi
 
   // Handle logical query plan if statement has been cached
   if (lqp_cache) {
-    if (const auto cached_plan = lqp_cache->try_get(_sql_string)) {
+    if (const auto cached_plan = lqp_cache->try_get(_sql_string, lqp_uses_outdated_statistics)) {
       const auto plan = *cached_plan;
       DebugAssert(plan, "Optimized logical query plan retrieved from cache is empty.");
       // MVCC-enabled and MVCC-disabled LQPs will evict each other
@@ -153,7 +161,11 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
 
   // Try to retrieve the PQP from cache
   if (pqp_cache) {
-    if (const auto cached_physical_plan = pqp_cache->try_get(_sql_string)) {
+    // The root operator references the root of the LQP that the plan was translated from
+    const auto cached_physical_plan = pqp_cache->try_get(_sql_string, [](const auto& plan) {
+      return plan->lqp_node && lqp_uses_outdated_statistics(std::const_pointer_cast<AbstractLQPNode>(plan->lqp_node));
+    });
+    if (cached_physical_plan) {
       if ((*cached_physical_plan)->transaction_context_is_set()) {
         Assert(_use_mvcc == UseMvcc::Yes, "Trying to use MVCC cached query without a transaction context.");
       } else {
@@ -165,6 +177,10 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
     }
   }
 
+  if (!_physical_plan && parameterized_plan_cache) {
+    _physical_plan = _get_parameterized_physical_plan();
+  }
+
   if (!_physical_plan) {
     // "Normal" path in which the query plan is created instead of begin retrieved from cache
     const auto& lqp = get_optimized_logical_plan();
@@ -176,6 +192,20 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
 
   done = std::chrono::high_resolution_clock::now();
 
+  // Cache a generic plan for statements that only differ in their literals. This optimizes the statement a second time.
+  if (_parameterized_statement) {
+    const auto parameterization_started = std::chrono::high_resolution_clock::now();
+
+    const auto parameterized_plan =
+        ParameterizedPlan::create(*_parameterized_statement, *_optimizer, get_optimized_logical_plan());
+    parameterized_plan_cache->set(_parameterized_statement->normalized_statement, parameterized_plan);
+    _parameterized_statement.reset();
+
+    const auto parameterization_done = std::chrono::high_resolution_clock::now();
+    _metrics->optimization_duration +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(parameterization_done - parameterization_started);
+  }
+
   if (_use_mvcc == UseMvcc::Yes) _physical_plan->set_transaction_context_recursively(_transaction_context);
 
   // Cache newly created plan for the according sql statement (only if not already cached)
@@ -183,8 +213,29 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
     pqp_cache->set(_sql_string, _physical_plan);
   }
 
+  // The cache keeps the unfused plan, so that it can also be used by pipelines that do not use MorselPipelines
+  if (_use_morsel_pipelines == UseMorselPipelines::Yes) _physical_plan = create_morsel_pipelines(_physical_plan);
+
   _metrics->lqp_translation_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
 
+  // Collected from the final PQP, no matter whether it was translated or taken from one of the caches. Operators fused
+  // into a MorselPipeline are visited as well.
+  _metrics->join_operators.clear();
+  auto visited_operators = std::unordered_set<std::shared_ptr<const AbstractOperator>>{};
+  const auto collect_join_operators = [&](const auto& self, const std::shared_ptr<const AbstractOperator>& op) {
+    if (!op || !visited_operators.emplace(op).second) return;
+    if (const auto morsel_pipeline = std::dynamic_pointer_cast<const MorselPipeline>(op)) {
+      const auto& fused_operators = morsel_pipeline->operators();
+      for (auto it = fused_operators.rbegin(); it != fused_operators.rend(); ++it) {
+        self(self, *it);
+      }
+    }
+    if (std::dynamic_pointer_cast<const AbstractJoinOperator>(op)) _metrics->join_operators.emplace_back(op->name());
+    self(self, op->input_left());
+    self(self, op->input_right());
+  };
+  collect_join_operators(collect_join_operators, _physical_plan);
+
   return _physical_plan;
 }
 
@@ -245,6 +296,8 @@ std::pair<SQLPipelineStatus, const std::shared_ptr<const Table>&> SQLPipelineSta
   const auto done = std::chrono::high_resolution_clock::now();
   _metrics->plan_execution_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
 
+  Hyrise::get().encoding_advisor.record_accesses(get_physical_plan());
+
   // Get output from the last task
   _result_table = tasks.back()->get_operator()->get_output();
   if (!_result_table) _query_has_output = false;
@@ -263,6 +316,31 @@ const std::shared_ptr<TransactionContext>& SQLPipelineStatement::transaction_con
 
 const std::shared_ptr<SQLPipelineStatementMetrics>& SQLPipelineStatement::metrics() const { return _metrics; }
 
+std::shared_ptr<AbstractOperator> SQLPipelineStatement::_get_parameterized_physical_plan() {
+  // PREPAREd statements already have parameters and the plans of other statements are rarely shared
+  if (!get_parsed_sql_statement()->getStatement(0)->isType(hsql::kStmtSelect)) return nullptr;
+
+  auto parameterized_statement = parameterize_literals(get_unoptimized_logical_plan());
+  if (!parameterized_statement) return nullptr;
+
+  const auto cached_plan = parameterized_plan_cache->try_get(
+      parameterized_statement->normalized_statement,
+      [](const auto& parameterized_plan) { return lqp_uses_outdated_statistics(parameterized_plan->lqp); });
+  if (!cached_plan) {
+    _parameterized_statement = std::move(parameterized_statement);
+    return nullptr;
+  }
+
+  const auto& parameterized_plan = *cached_plan;
+  DebugAssert(parameterized_plan, "Parameterized plan retrieved from cache is empty.");
+  auto physical_plan = parameterized_plan->instantiate(parameterized_statement->parameters);
+
+  _metrics->parameterized_plan_cache_hit = physical_plan != nullptr;
+  _metrics->parameterized_plan_cache_hit_rate = parameterized_plan->hit_rate();
+
+  return physical_plan;
+}
+
 void SQLPipelineStatement::_precheck_ddl_operators(const std::shared_ptr<AbstractOperator>& pqp) {
   const auto& storage_manager = Hyrise::get().storage_manager;
 
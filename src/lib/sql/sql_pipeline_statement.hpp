@@ -1,6 +1,8 @@
 #pragma once
 
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "SQLParserResult.h"
 #include "cache/cache.hpp"
@@ -20,6 +22,16 @@ struct SQLPipelineStatementMetrics {
   std::chrono::nanoseconds plan_execution_duration{};
 
   bool query_plan_cache_hit = false;
+
+  // Whether the PQP was taken from the SQLParameterizedPlanCache, i.e., bound to the literals of this statement. The
+  // hit rate is the share of the executions of the parameterized statement (including this one) that used the cached
+  // plan. It stays 0 if the statement was not looked up in the cache.
+  bool parameterized_plan_cache_hit = false;
+  float parameterized_plan_cache_hit_rate = 0.0f;
+
+  // Names of the join operators in the PQP (excluding subqueries), in the order of a depth-first traversal. Used by the
+  // benchmarks to report which join implementations were chosen.
+  std::vector<std::string> join_operators;
 };
 
 enum class SQLPipelineStatus {
@@ -43,6 +55,12 @@ enum class SQLPipelineStatus {
  *  If a physical plan for an SQL statement is in the SQLPhysicalPlanCache, it will be used instead of translating the
  *  optimized LQP (get_optimized_logical_plans()) into a PQP. Thus, in this case, the optimized LQP and PQP could be
  *  different.
+ *
+ * NOTE:
+ *  If there is no physical plan for the SQL string, but an SQLParameterizedPlanCache is used, the literals of the
+ *  statement's predicates are replaced by parameters (see parameterize_literals()). If a generic plan for the resulting
+ *  statement is cached, it is bound to the literals of this statement and used as the physical plan. Otherwise, the
+ *  statement is optimized as usual and a generic plan is added to the cache (see ParameterizedPlan).
  */
 class SQLPipelineStatement : public Noncopyable {
  public:
@@ -52,7 +70,9 @@ class SQLPipelineStatement : public Noncopyable {
                        const std::shared_ptr<Optimizer>& optimizer,
                        const std::shared_ptr<SQLPhysicalPlanCache>& pqp_cache,
                        const std::shared_ptr<SQLLogicalPlanCache>& lqp_cache,
-                       const CleanupTemporaries cleanup_temporaries);
+                       const std::shared_ptr<SQLParameterizedPlanCache>& parameterized_plan_cache,
+                       const CleanupTemporaries cleanup_temporaries,
+                       const UseMorselPipelines use_morsel_pipelines);
 
   // Returns the raw SQL string.
   const std::string& get_sql_string();
@@ -91,8 +111,14 @@ class SQLPipelineStatement : public Noncopyable {
 
   const std::shared_ptr<SQLPhysicalPlanCache> pqp_cache;
   const std::shared_ptr<SQLLogicalPlanCache> lqp_cache;
+  const std::shared_ptr<SQLParameterizedPlanCache> parameterized_plan_cache;
 
  private:
+  // Looks up the generic plan for the statement in the parameterized_plan_cache and returns it bound to the literals
+  // of the statement. Returns nullptr if the statement has to be optimized, in which case _parameterized_statement is
+  // set if a new generic plan is to be cached.
+  std::shared_ptr<AbstractOperator> _get_parameterized_physical_plan();
+
   // Performs a sanity check in order to prevent an execution of a predictably failing DDL operator (e.g., creating a
   // table that already exists).
   // Throws an InvalidInputException if an invalid PQP is detected.
@@ -114,6 +140,7 @@ class SQLPipelineStatement : public Noncopyable {
   std::shared_ptr<AbstractLQPNode> _unoptimized_logical_plan;
   std::shared_ptr<AbstractLQPNode> _optimized_logical_plan;
   std::shared_ptr<AbstractOperator> _physical_plan;
+  std::optional<ParameterizedStatement> _parameterized_statement;
   std::vector<std::shared_ptr<OperatorTask>> _tasks;
   std::shared_ptr<const Table> _result_table;
   // Assume there is an output table. Only change if nullptr is returned from execution.
@@ -123,6 +150,9 @@ class SQLPipelineStatement : public Noncopyable {
 
   // Delete temporary tables
   const CleanupTemporaries _cleanup_temporaries;
+
+  // Fuse chunk-local operators of the PQP into MorselPipelines
+  const UseMorselPipelines _use_morsel_pipelines;
 };
 
 }  // namespace opossum
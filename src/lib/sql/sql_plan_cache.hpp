@@ -4,6 +4,7 @@
 #include <string>
 
 #include "cache/cache.hpp"
+#include "sql/parameterized_plan.hpp"
 
 namespace opossum {
 
@@ -13,4 +14,7 @@ class AbstractLQPNode;
 using SQLPhysicalPlanCache = Cache<std::shared_ptr<AbstractOperator>, std::string>;
 using SQLLogicalPlanCache = Cache<std::shared_ptr<AbstractLQPNode>, std::string>;
 
+// Caches generic plans for statements that only differ in the literals of their predicates, see ParameterizedPlan
+using SQLParameterizedPlanCache = Cache<std::shared_ptr<ParameterizedPlan>, NormalizedStatement>;
+
 }  // namespace opossum
@@ -211,6 +211,8 @@ std::shared_ptr<AbstractLQPNode> SQLTranslator::_translate_select_statement(cons
 
   AssertInput(select.selectList, "SELECT list needs to exist");
   AssertInput(!select.selectList->empty(), "SELECT list needs to have entries");
+  // The SetOperationHash operator implements UNION, INTERSECT, and EXCEPT. However, the parsed statement only holds the
+  // second SELECT of a set operation (unionSelect), but neither the type of the operation nor whether ALL was given.
   AssertInput(!select.unionSelect, "Set operations (UNION/INTERSECT/...) are not supported yet");
 
   // Translate WITH clause
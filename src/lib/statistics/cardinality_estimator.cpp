@@ -1,5 +1,6 @@
 #include "cardinality_estimator.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -239,14 +240,20 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_alias_node(
 
   auto column_statistics =
       std::vector<std::shared_ptr<BaseAttributeStatistics>>{alias_node.column_expressions().size()};
+  auto input_column_ids = std::vector<ColumnID>(alias_node.column_expressions().size());
 
   for (size_t expression_idx{0}; expression_idx < alias_node.column_expressions().size(); ++expression_idx) {
     const auto& expression = *alias_node.column_expressions()[expression_idx];
     const auto input_column_id = alias_node.left_input()->get_column_id(expression);
     column_statistics[expression_idx] = input_table_statistics->column_statistics[input_column_id];
+    input_column_ids[expression_idx] = input_column_id;
   }
 
-  return std::make_shared<TableStatistics>(std::move(column_statistics), input_table_statistics->row_count);
+  const auto output_table_statistics =
+      std::make_shared<TableStatistics>(std::move(column_statistics), input_table_statistics->row_count);
+  output_table_statistics->copy_column_correlations(*input_table_statistics, input_column_ids);
+
+  return output_table_statistics;
 }
 
 std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_projection_node(
@@ -338,6 +345,8 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_predicate_node(
 
       const auto output_table_statistics =
           std::make_shared<TableStatistics>(std::move(output_column_statistics), row_count);
+      output_table_statistics->column_pair_statistics = input_table_statistics->column_pair_statistics;
+      output_table_statistics->equality_filtered_column_ids = input_table_statistics->equality_filtered_column_ids;
 
       return output_table_statistics;
     } else if (logical_expression->logical_operator == LogicalOperator::And) {
@@ -754,6 +763,37 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_operator_scan_pr
     return input_table_statistics;
   }
 
+  /**
+   * The selectivities of predicates on different columns are multiplied, i.e., the columns are assumed to be
+   * independent. For equality predicates on correlated columns, e.g., `city = 'Potsdam' AND zipcode = 14482`, this
+   * underestimates the selectivity by orders of magnitude. Thus, if an equality predicate was estimated on a column
+   * that is correlated with the scanned one, the selectivity is corrected with the ColumnPairStatistics. If there are
+   * multiple such columns, the strongest correlation is used, as the columns are likely correlated among themselves.
+   */
+  const auto is_equality_predicate =
+      predicate.predicate_condition == PredicateCondition::Equals && predicate.value.type() != typeid(ColumnID);
+  if (is_equality_predicate && selectivity > 0.0f) {
+    auto correlation_factor = 1.0f;
+    const auto& equality_filtered_column_ids = input_table_statistics->equality_filtered_column_ids;
+    for (const auto& pair_statistics : input_table_statistics->column_pair_statistics) {
+      const auto& [first_column_id, second_column_id] = pair_statistics.column_ids;
+      if (first_column_id != left_column_id && second_column_id != left_column_id) continue;
+
+      const auto paired_column_id = first_column_id == left_column_id ? second_column_id : first_column_id;
+      if (std::find(equality_filtered_column_ids.begin(), equality_filtered_column_ids.end(), paired_column_id) !=
+          equality_filtered_column_ids.end()) {
+        correlation_factor = std::max(correlation_factor, pair_statistics.correlation_factor());
+      }
+    }
+
+    const auto correlated_selectivity = std::min(selectivity * correlation_factor, 1.0f);
+    if (output_column_statistics[left_column_id] && correlated_selectivity != selectivity) {
+      output_column_statistics[left_column_id] =
+          output_column_statistics[left_column_id]->scaled(correlated_selectivity / selectivity);
+    }
+    selectivity = correlated_selectivity;
+  }
+
   // Scale the other columns' AttributeStatistics (those that we didn't write to above) with the selectivity
   for (auto column_id = ColumnID{0}; column_id < output_column_statistics.size(); ++column_id) {
     if (!output_column_statistics[column_id]) {
@@ -762,7 +802,17 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_operator_scan_pr
   }
 
   const auto row_count = Cardinality{input_table_statistics->row_count * selectivity};
-  return std::make_shared<TableStatistics>(std::move(output_column_statistics), row_count);
+  const auto output_table_statistics =
+      std::make_shared<TableStatistics>(std::move(output_column_statistics), row_count);
+
+  // Remember the equality predicate, so that the predicates estimated afterwards can account for their correlation
+  output_table_statistics->column_pair_statistics = input_table_statistics->column_pair_statistics;
+  output_table_statistics->equality_filtered_column_ids = input_table_statistics->equality_filtered_column_ids;
+  if (is_equality_predicate) {
+    output_table_statistics->equality_filtered_column_ids.emplace_back(left_column_id);
+  }
+
+  return output_table_statistics;
 }
 
 template <typename T>
@@ -1111,6 +1161,7 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::prune_column_statistics(
 
   auto output_column_statistics = std::vector<std::shared_ptr<BaseAttributeStatistics>>(
       table_statistics->column_statistics.size() - pruned_column_ids.size());
+  auto input_column_ids = std::vector<ColumnID>(output_column_statistics.size());
 
   auto pruned_column_ids_iter = pruned_column_ids.begin();
 
@@ -1123,10 +1174,15 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::prune_column_statistics(
     }
 
     output_column_statistics[output_column_id] = table_statistics->column_statistics[input_column_id];
+    input_column_ids[output_column_id] = input_column_id;
     ++output_column_id;
   }
 
-  return std::make_shared<TableStatistics>(std::move(output_column_statistics), table_statistics->row_count);
+  const auto output_table_statistics =
+      std::make_shared<TableStatistics>(std::move(output_column_statistics), table_statistics->row_count);
+  output_table_statistics->copy_column_correlations(*table_statistics, input_column_ids);
+
+  return output_table_statistics;
 }
 
 }  // namespace opossum
@@ -0,0 +1,64 @@
+#include "hyper_log_log.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Finalizer of MurmurHash3, spreads the entropy of the input over all bits
+uint64_t mix_hash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+}  // namespace
+
+namespace opossum {
+
+HyperLogLog::HyperLogLog() : _registers(REGISTER_COUNT, uint8_t{0}) {}
+
+void HyperLogLog::add_hash(const size_t hash) {
+  const auto mixed_hash = mix_hash(static_cast<uint64_t>(hash));
+
+  // The upper PRECISION bits select the register, the position of the first set bit in the remaining bits is the rank
+  const auto register_id = mixed_hash >> (64 - PRECISION);
+  const auto remaining_bits = mixed_hash << PRECISION;
+  const auto rank = remaining_bits == 0 ? static_cast<uint8_t>(64 - PRECISION + 1)
+                                        : static_cast<uint8_t>(__builtin_clzll(remaining_bits) + 1);
+
+  _registers[register_id] = std::max(_registers[register_id], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+  for (auto register_id = size_t{0}; register_id < REGISTER_COUNT; ++register_id) {
+    _registers[register_id] = std::max(_registers[register_id], other._registers[register_id]);
+  }
+}
+
+double HyperLogLog::estimate() const {
+  const auto register_count = static_cast<double>(REGISTER_COUNT);
+
+  auto harmonic_sum = 0.0;
+  auto empty_register_count = size_t{0};
+  for (const auto rank : _registers) {
+    harmonic_sum += std::ldexp(1.0, -rank);
+    if (rank == 0) ++empty_register_count;
+  }
+
+  const auto alpha = 0.7213 / (1.0 + 1.079 / register_count);
+  const auto raw_estimate = alpha * register_count * register_count / harmonic_sum;
+
+  // For small cardinalities, many registers are still empty and linear counting is more accurate. With 64 bit hashes,
+  // no correction for large cardinalities is needed.
+  if (raw_estimate <= 2.5 * register_count && empty_register_count > 0) {
+    return register_count * std::log(register_count / static_cast<double>(empty_register_count));
+  }
+
+  return raw_estimate;
+}
+
+}  // namespace opossum
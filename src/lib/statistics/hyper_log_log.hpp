@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace opossum {
+
+/**
+ * HyperLogLog sketch (Flajolet et al., 2007) for estimating the number of distinct values in a multiset with a fixed
+ * amount of memory. The hash of each value selects one of 2^PRECISION registers, which keeps the maximum number of
+ * leading zeros seen in the remaining bits of the hashes. With PRECISION = 12, the sketch needs 4 KB and the standard
+ * error of the estimate is about 1.6%.
+ *
+ * Adding a value multiple times does not change the sketch, so it suffices to add the dictionary of a
+ * DictionarySegment instead of all of its values. Sketches of disjoint parts of a column (e.g., of its chunks) can be
+ * built in parallel and merged afterwards.
+ */
+class HyperLogLog {
+ public:
+  static constexpr uint8_t PRECISION = 12;
+  static constexpr size_t REGISTER_COUNT = size_t{1} << PRECISION;
+
+  HyperLogLog();
+
+  template <typename T>
+  void add(const T& value) {
+    add_hash(std::hash<T>{}(value));
+  }
+
+  // Adds a value by its hash. The hash is mixed before use, so identity hashes (e.g., std::hash<int>) are fine.
+  void add_hash(const size_t hash);
+
+  // Combines the sketches, as if all values of @param other had been added to this sketch.
+  void merge(const HyperLogLog& other);
+
+  // The estimated number of distinct values added to the sketch
+  double estimate() const;
+
+ private:
+  std::vector<uint8_t> _registers;
+};
+
+}  // namespace opossum
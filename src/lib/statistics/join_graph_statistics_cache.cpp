@@ -124,6 +124,7 @@ std::shared_ptr<TableStatistics> JoinGraphStatisticsCache::get(
 
   const auto result_table_statistics =
       std::make_shared<TableStatistics>(std::move(output_column_statistics), cached_table_statistics->row_count);
+  result_table_statistics->copy_column_correlations(*cached_table_statistics, cached_column_ids);
 
   return result_table_statistics;
 }
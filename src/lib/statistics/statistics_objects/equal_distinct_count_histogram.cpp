@@ -16,26 +16,6 @@ namespace {
 
 using namespace opossum;  // NOLINT
 
-template <typename T>
-void add_segment_to_value_distribution(const BaseSegment& segment,
-                                       std::unordered_map<T, HistogramCountType>& value_distribution,
-                                       const HistogramDomain<T>& domain) {
-  segment_iterate<T>(segment, [&](const auto& iterator_value) {
-    if (iterator_value.is_null()) return;
-
-    if constexpr (std::is_same_v<T, pmr_string>) {
-      // Do "contains()" check first to avoid the string copy incurred by string_to_domain() where possible
-      if (domain.contains(iterator_value.value())) {
-        ++value_distribution[iterator_value.value()];
-      } else {
-        ++value_distribution[domain.string_to_domain(iterator_value.value())];
-      }
-    } else {
-      ++value_distribution[iterator_value.value()];
-    }
-  });
-}
-
 template <typename T>
 std::vector<std::pair<T, HistogramCountType>> value_distribution_from_column(const Table& table,
                                                                              const ColumnID column_id,
@@ -49,7 +29,8 @@ std::vector<std::pair<T, HistogramCountType>> value_distribution_from_column(con
     const auto chunk = table.get_chunk(chunk_id);
     if (!chunk) continue;
 
-    add_segment_to_value_distribution<T>(*chunk->get_segment(column_id), value_distribution_map, domain);
+    EqualDistinctCountHistogram<T>::add_segment_to_value_distribution(*chunk->get_segment(column_id),
+                                                                      value_distribution_map, domain);
   }
 
   auto value_distribution =
@@ -90,9 +71,14 @@ EqualDistinctCountHistogram<T>::EqualDistinctCountHistogram(std::vector<T>&& bin
 template <typename T>
 std::shared_ptr<EqualDistinctCountHistogram<T>> EqualDistinctCountHistogram<T>::from_column(
     const Table& table, const ColumnID column_id, const BinID max_bin_count, const HistogramDomain<T>& domain) {
-  Assert(max_bin_count > 0, "max_bin_count must be greater than zero ");
+  return from_value_distribution(value_distribution_from_column(table, column_id, domain), max_bin_count);
+}
 
-  const auto value_distribution = value_distribution_from_column(table, column_id, domain);
+template <typename T>
+std::shared_ptr<EqualDistinctCountHistogram<T>> EqualDistinctCountHistogram<T>::from_value_distribution(
+    std::vector<std::pair<T, HistogramCountType>>&& value_distribution, const BinID max_bin_count,
+    const std::optional<HistogramCountType>& distinct_count) {
+  Assert(max_bin_count > 0, "max_bin_count must be greater than zero ");
 
   if (value_distribution.empty()) {
     return nullptr;
@@ -136,11 +122,41 @@ std::shared_ptr<EqualDistinctCountHistogram<T>> EqualDistinctCountHistogram<T>::
     min_value_idx = max_value_idx + 1;
   }
 
+  // Distinct values that are not part of the value distribution are spread evenly. As the bins are no longer
+  // distinguished by their number of distinct values, none of them has an extra value.
+  if (distinct_count && *distinct_count > static_cast<HistogramCountType>(value_distribution.size())) {
+    const auto extrapolated_distinct_count_per_bin = *distinct_count / static_cast<HistogramCountType>(bin_count);
+    return std::make_shared<EqualDistinctCountHistogram<T>>(std::move(bin_minima), std::move(bin_maxima),
+                                                            std::move(bin_heights),
+                                                            extrapolated_distinct_count_per_bin, BinID{0});
+  }
+
   return std::make_shared<EqualDistinctCountHistogram<T>>(
       std::move(bin_minima), std::move(bin_maxima), std::move(bin_heights),
       static_cast<HistogramCountType>(distinct_count_per_bin), bin_count_with_extra_value);
 }
 
+template <typename T>
+void EqualDistinctCountHistogram<T>::add_segment_to_value_distribution(
+    const BaseSegment& segment, std::unordered_map<T, HistogramCountType>& value_distribution,
+    const HistogramDomain<T>& domain, const ChunkOffset begin_chunk_offset, const ChunkOffset end_chunk_offset) {
+  segment_iterate<T>(segment, [&](const auto& iterator_value) {
+    const auto chunk_offset = iterator_value.chunk_offset();
+    if (iterator_value.is_null() || chunk_offset < begin_chunk_offset || chunk_offset >= end_chunk_offset) return;
+
+    if constexpr (std::is_same_v<T, pmr_string>) {
+      // Do "contains()" check first to avoid the string copy incurred by string_to_domain() where possible
+      if (domain.contains(iterator_value.value())) {
+        ++value_distribution[iterator_value.value()];
+      } else {
+        ++value_distribution[domain.string_to_domain(iterator_value.value())];
+      }
+    } else {
+      ++value_distribution[iterator_value.value()];
+    }
+  });
+}
+
 template <typename T>
 std::string EqualDistinctCountHistogram<T>::name() const {
   return "EqualDistinctCount";
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -36,6 +38,29 @@ class EqualDistinctCountHistogram : public AbstractHistogram<T> {
                                                                      const BinID max_bin_count,
                                                                      const HistogramDomain<T>& domain = {});
 
+  /**
+   * Create an EqualDistinctCountHistogram from the distinct non-NULL values of a column and their counts
+   * @param value_distribution  Sorted by value. The counts need not be integral, e.g., if they are extrapolated from a
+   *                            sample.
+   * @param distinct_count      Number of distinct values of the column that the bins are built for. If it is larger
+   *                            than the number of values in @param value_distribution (e.g., because they stem from a
+   *                            sample), the additional distinct values are distributed evenly over the bins.
+   * @return nullptr if @param value_distribution is empty
+   */
+  static std::shared_ptr<EqualDistinctCountHistogram<T>> from_value_distribution(
+      std::vector<std::pair<T, HistogramCountType>>&& value_distribution, const BinID max_bin_count,
+      const std::optional<HistogramCountType>& distinct_count = std::nullopt);
+
+  /**
+   * Add the non-NULL values of @param segment in [@param begin_chunk_offset, @param end_chunk_offset) to
+   * @param value_distribution. Strings are mapped to @param domain.
+   */
+  static void add_segment_to_value_distribution(const BaseSegment& segment,
+                                                std::unordered_map<T, HistogramCountType>& value_distribution,
+                                                const HistogramDomain<T>& domain = {},
+                                                const ChunkOffset begin_chunk_offset = ChunkOffset{0},
+                                                const ChunkOffset end_chunk_offset = INVALID_CHUNK_OFFSET);
+
   std::string name() const override;
   std::shared_ptr<AbstractHistogram<T>> clone() const override;
   HistogramCountType total_distinct_count() const override;
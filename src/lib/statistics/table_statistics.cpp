@@ -1,76 +1,433 @@
 #include "table_statistics.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 #include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <boost/functional/hash.hpp>
 
 #include "attribute_statistics.hpp"
 #include "resolve_type.hpp"
+#include "statistics/hyper_log_log.hpp"
 #include "statistics/statistics_objects/abstract_histogram.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/segment_iterate.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
 
-namespace opossum {
+namespace {
 
-std::shared_ptr<TableStatistics> TableStatistics::from_table(const Table& table) {
-  std::vector<std::shared_ptr<BaseAttributeStatistics>> column_statistics(table.column_count());
+using namespace opossum;  // NOLINT
+
+/**
+ * Calls @param function with (thread_id, index) for each index in [0, @param count), using @param thread_count threads.
+ * thread_id can be used to access per-thread state without synchronization.
+ */
+template <typename Function>
+void parallel_for(const size_t count, const size_t thread_count, const Function& function) {
+  auto next_index = std::atomic<size_t>{0};
+  auto threads = std::vector<std::thread>{};
+
+  for (auto thread_id = size_t{0}; thread_id < thread_count; ++thread_id) {
+    threads.emplace_back([&, thread_id] {
+      while (true) {
+        const auto index = next_index++;
+        if (index >= count) return;
+
+        function(thread_id, index);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+size_t thread_count_for(const size_t count) {
+  return std::min(count, static_cast<size_t>(std::thread::hardware_concurrency()) + 1);
+}
+
+template <typename T>
+std::shared_ptr<AttributeStatistics<T>> attribute_statistics_from_histogram(
+    const std::shared_ptr<EqualDistinctCountHistogram<T>>& histogram, const uint64_t row_count) {
+  const auto attribute_statistics = std::make_shared<AttributeStatistics<T>>();
+
+  if (histogram) {
+    attribute_statistics->set_statistics_object(histogram);
+
+    // Use the insight that the histogram will only contain non-null values to generate the NullValueRatio property
+    const auto null_value_ratio =
+        row_count == 0 ? 0.0f : std::max(0.0f, 1.0f - (histogram->total_count() / static_cast<float>(row_count)));
+    attribute_statistics->set_statistics_object(std::make_shared<NullValueRatioStatistics>(null_value_ratio));
+  } else {
+    // Failure to generate a histogram currently only stems from all-null segments.
+    // TODO(anybody) this is a slippery assumption. But the alternative would be a full segment scan...
+    attribute_statistics->set_statistics_object(std::make_shared<NullValueRatioStatistics>(1.0f));
+  }
+
+  return attribute_statistics;
+}
+
+// Chunks that are spread evenly over the table, including the first and the last one
+std::vector<ChunkID> sample_chunk_ids(const Table& table, const float chunk_ratio) {
+  const auto chunk_count = static_cast<size_t>(table.chunk_count());
+  const auto sampled_chunk_count = std::clamp(
+      static_cast<size_t>(std::ceil(chunk_ratio * static_cast<float>(chunk_count))), size_t{1}, chunk_count);
+
+  auto sampled_chunk_ids = std::vector<ChunkID>{};
+  sampled_chunk_ids.reserve(sampled_chunk_count);
+  for (auto sample_idx = size_t{0}; sample_idx < sampled_chunk_count; ++sample_idx) {
+    const auto chunk_id =
+        sampled_chunk_count == 1 ? size_t{0} : sample_idx * (chunk_count - 1) / (sampled_chunk_count - 1);
+    if (table.get_chunk(ChunkID{static_cast<ChunkID::base_type>(chunk_id)})) {
+      sampled_chunk_ids.emplace_back(static_cast<ChunkID::base_type>(chunk_id));
+    }
+  }
+
+  return sampled_chunk_ids;
+}
+
+struct BaseColumnSample {
+  virtual ~BaseColumnSample() = default;
+};
+
+// The value distributions of the sampled chunks of a column, built independently so that chunks can be processed in
+// parallel
+template <typename T>
+struct ColumnSample : public BaseColumnSample {
+  explicit ColumnSample(const size_t sampled_chunk_count) : value_distributions(sampled_chunk_count) {}
+
+  std::vector<std::unordered_map<T, HistogramCountType>> value_distributions;
+};
+
+std::vector<std::shared_ptr<BaseAttributeStatistics>> sampled_column_statistics(const Table& table,
+                                                                                const StatisticsSampling& sampling,
+                                                                                const BinID histogram_bin_count) {
+  const auto column_count = static_cast<size_t>(table.column_count());
+  const auto chunk_count = static_cast<size_t>(table.chunk_count());
+
+  const auto sampled_chunk_ids = sample_chunk_ids(table, sampling.chunk_ratio);
+  constexpr auto NOT_SAMPLED = std::numeric_limits<size_t>::max();
+  auto sample_idx_by_chunk_id = std::vector<size_t>(chunk_count, NOT_SAMPLED);
+  auto sampled_row_count = uint64_t{0};
+  for (auto sample_idx = size_t{0}; sample_idx < sampled_chunk_ids.size(); ++sample_idx) {
+    sample_idx_by_chunk_id[sampled_chunk_ids[sample_idx]] = sample_idx;
+    sampled_row_count += table.get_chunk(sampled_chunk_ids[sample_idx])->size();
+  }
+
+  auto column_samples = std::vector<std::unique_ptr<BaseColumnSample>>(column_count);
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      column_samples[column_id] = std::make_unique<ColumnSample<ColumnDataType>>(sampled_chunk_ids.size());
+    });
+  }
 
   /**
-   * Determine bin count, within mostly arbitrarily chosen bounds: 5 (for tables with <=2k rows) up to 100 bins
-   * (for tables with >= 200m rows) are created.
+   * 1. Parallely process all segments: Build the value distributions of the sampled segments and a HyperLogLog sketch
+   *    per column and thread for the distinct counts.
    */
-  const auto histogram_bin_count = std::min<size_t>(100, std::max<size_t>(5, table.row_count() / 2'000));
+  const auto segment_count = chunk_count * column_count;
+  const auto thread_count = thread_count_for(segment_count);
+  auto sketches = std::vector<std::vector<HyperLogLog>>(thread_count, std::vector<HyperLogLog>(column_count));
 
-  auto next_column_id = std::atomic<size_t>{0u};
-  auto threads = std::vector<std::thread>{};
+  parallel_for(segment_count, thread_count, [&](const size_t thread_id, const size_t segment_idx) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(segment_idx / column_count)};
+    const auto column_id = ColumnID{static_cast<ColumnID::base_type>(segment_idx % column_count)};
+
+    const auto chunk = table.get_chunk(chunk_id);
+    if (!chunk) return;
+
+    const auto segment = chunk->get_segment(column_id);
+    auto& sketch = sketches[thread_id][column_id];
+
+    resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      const auto sample_idx = sample_idx_by_chunk_id[chunk_id];
+      if (sample_idx != NOT_SAMPLED) {
+        auto& column_sample = static_cast<ColumnSample<ColumnDataType>&>(*column_samples[column_id]);
+        auto& value_distribution = column_sample.value_distributions[sample_idx];
+        EqualDistinctCountHistogram<ColumnDataType>::add_segment_to_value_distribution(*segment, value_distribution);
+        for (const auto& value_and_count : value_distribution) {
+          sketch.add(value_and_count.first);
+        }
+      } else if (const auto dictionary_segment =
+                     std::dynamic_pointer_cast<const DictionarySegment<ColumnDataType>>(segment)) {
+        // Adding values multiple times does not change the sketch, so the dictionary suffices
+        for (const auto& value : *dictionary_segment->dictionary()) {
+          sketch.add(value);
+        }
+      } else {
+        segment_iterate<ColumnDataType>(*segment, [&](const auto& position) {
+          if (!position.is_null()) sketch.add(position.value());
+        });
+      }
+    });
+  });
 
   /**
-   * Parallely create statistics objects for the Table's columns
+   * 2. Parallely merge the value distributions and sketches of each column and build its histogram. The counts of the
+   *    sampled values are extrapolated to the row count of the table.
    */
-  for (auto thread_id = 0u;
-       thread_id < std::min(static_cast<uint>(table.column_count()), std::thread::hardware_concurrency() + 1);
-       ++thread_id) {
-    threads.emplace_back([&] {
-      while (true) {
-        auto my_column_id = ColumnID{static_cast<ColumnID::base_type>(next_column_id++)};
-        if (static_cast<ColumnCount>(my_column_id) >= table.column_count()) return;
+  const auto count_scale = sampled_row_count == 0 ? 1.0f
+                                                  : static_cast<float>(table.row_count()) /
+                                                        static_cast<float>(sampled_row_count);
+
+  std::vector<std::shared_ptr<BaseAttributeStatistics>> column_statistics(column_count);
+  parallel_for(column_count, thread_count_for(column_count), [&](const size_t, const size_t column_idx) {
+    const auto column_id = ColumnID{static_cast<ColumnID::base_type>(column_idx)};
+
+    auto sketch = HyperLogLog{};
+    for (const auto& thread_sketches : sketches) {
+      sketch.merge(thread_sketches[column_id]);
+    }
+    const auto distinct_count = static_cast<HistogramCountType>(sketch.estimate());
+
+    resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      auto& value_distributions =
+          static_cast<ColumnSample<ColumnDataType>&>(*column_samples[column_id]).value_distributions;
+      auto merged_value_distribution = std::unordered_map<ColumnDataType, HistogramCountType>{};
+      for (auto& chunk_value_distribution : value_distributions) {
+        for (const auto& [value, count] : chunk_value_distribution) {
+          merged_value_distribution[value] += count;
+        }
+        chunk_value_distribution = {};
+      }
+
+      auto value_distribution = std::vector<std::pair<ColumnDataType, HistogramCountType>>{
+          merged_value_distribution.begin(), merged_value_distribution.end()};
+      merged_value_distribution = {};
+      std::sort(value_distribution.begin(), value_distribution.end(),
+                [&](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+      for (auto& value_and_count : value_distribution) {
+        value_and_count.second *= count_scale;
+      }
+
+      auto histogram = EqualDistinctCountHistogram<ColumnDataType>::from_value_distribution(
+          std::move(value_distribution), histogram_bin_count, distinct_count);
+
+      // The sampled chunks only contained NULLs, but others do not
+      if (!histogram && distinct_count > 0.0f) {
+        histogram = EqualDistinctCountHistogram<ColumnDataType>::from_column(table, column_id, histogram_bin_count);
+      }
+
+      column_statistics[column_id] = attribute_statistics_from_histogram(histogram, table.row_count());
+    });
+  });
+
+  return column_statistics;
+}
 
-        const auto column_data_type = table.column_data_type(my_column_id);
+// Only columns with few distinct values are paired: Equality predicates on other columns are selective on their own,
+// and the number of pairs grows quadratically with the number of columns.
+constexpr auto MAX_PAIRED_COLUMN_DISTINCT_COUNT = HistogramCountType{10'000};
+constexpr auto MAX_PAIRED_COLUMN_COUNT = size_t{16};
 
-        resolve_data_type(column_data_type, [&](auto type) {
-          using ColumnDataType = typename decltype(type)::type;
+// Pairs of (almost) independent columns are not kept. Also covers the error of the HyperLogLog estimates.
+constexpr auto MIN_CORRELATION_FACTOR = 1.5f;
 
-          const auto output_column_statistics = std::make_shared<AttributeStatistics<ColumnDataType>>();
+/**
+ * Estimates the distinct counts of all pairs of columns with few distinct values from the rows of @param chunk_ids and
+ * returns those of correlated pairs. Uses a HyperLogLog sketch per column and pair and thread.
+ */
+std::vector<ColumnPairStatistics> column_pair_statistics(
+    const Table& table, const std::vector<ChunkID>& chunk_ids,
+    const std::vector<std::shared_ptr<BaseAttributeStatistics>>& column_statistics) {
+  auto paired_column_ids = std::vector<ColumnID>{};
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
 
-          const auto histogram =
-              EqualDistinctCountHistogram<ColumnDataType>::from_column(table, my_column_id, histogram_bin_count);
+      const auto& histogram = static_cast<const AttributeStatistics<ColumnDataType>&>(*column_statistics[column_id])
+                                  .histogram;
+      if (!histogram) return;
 
-          if (histogram) {
-            output_column_statistics->set_statistics_object(histogram);
+      // Skip constant columns and (almost) unique ones, which determine all other columns
+      const auto distinct_count = histogram->total_distinct_count();
+      if (distinct_count >= 2.0f && distinct_count <= MAX_PAIRED_COLUMN_DISTINCT_COUNT &&
+          distinct_count <= 0.5f * histogram->total_count()) {
+        paired_column_ids.emplace_back(column_id);
+      }
+    });
+  }
+
+  paired_column_ids.resize(std::min(paired_column_ids.size(), MAX_PAIRED_COLUMN_COUNT));
+  const auto paired_column_count = paired_column_ids.size();
+  if (paired_column_count < 2) return {};
+
+  auto pair_indices = std::vector<std::pair<size_t, size_t>>{};
+  for (auto first_idx = size_t{0}; first_idx < paired_column_count; ++first_idx) {
+    for (auto second_idx = first_idx + 1; second_idx < paired_column_count; ++second_idx) {
+      pair_indices.emplace_back(first_idx, second_idx);
+    }
+  }
+
+  /**
+   * 1. Parallely hash the values of each sampled chunk and add them and the combined hashes of each pair to the
+   *    sketches of the thread
+   */
+  const auto thread_count = thread_count_for(chunk_ids.size());
+  auto column_sketches =
+      std::vector<std::vector<HyperLogLog>>(thread_count, std::vector<HyperLogLog>(paired_column_count));
+  auto pair_sketches =
+      std::vector<std::vector<HyperLogLog>>(thread_count, std::vector<HyperLogLog>(pair_indices.size()));
 
-            // Use the insight that the histogram will only contain non-null values to generate the NullValueRatio
-            // property
-            const auto null_value_ratio =
-                table.row_count() == 0 ? 0.0f
-                                       : 1.0f - (static_cast<float>(histogram->total_count()) / table.row_count());
-            output_column_statistics->set_statistics_object(
-                std::make_shared<NullValueRatioStatistics>(null_value_ratio));
+  parallel_for(chunk_ids.size(), thread_count, [&](const size_t thread_id, const size_t chunk_idx) {
+    const auto chunk = table.get_chunk(chunk_ids[chunk_idx]);
+    if (!chunk) return;
+
+    const auto chunk_size = chunk->size();
+    auto hashes = std::vector<std::vector<size_t>>(paired_column_count, std::vector<size_t>(chunk_size));
+    auto null_values = std::vector<std::vector<bool>>(paired_column_count, std::vector<bool>(chunk_size));
+
+    for (auto column_idx = size_t{0}; column_idx < paired_column_count; ++column_idx) {
+      const auto column_id = paired_column_ids[column_idx];
+      resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+
+        auto& sketch = column_sketches[thread_id][column_idx];
+        segment_iterate<ColumnDataType>(*chunk->get_segment(column_id), [&](const auto& position) {
+          // Inserts might append rows to mutable chunks in the meantime, which are left out
+          const auto chunk_offset = position.chunk_offset();
+          if (chunk_offset >= chunk_size) return;
+
+          if (position.is_null()) {
+            null_values[column_idx][chunk_offset] = true;
           } else {
-            // Failure to generate a histogram currently only stems from all-null segments.
-            // TODO(anybody) this is a slippery assumption. But the alternative would be a full segment scan...
-            output_column_statistics->set_statistics_object(std::make_shared<NullValueRatioStatistics>(1.0f));
+            hashes[column_idx][chunk_offset] = std::hash<ColumnDataType>{}(position.value());
+            sketch.add_hash(hashes[column_idx][chunk_offset]);
           }
-
-          column_statistics[my_column_id] = output_column_statistics;
         });
+      });
+    }
+
+    for (auto pair_idx = size_t{0}; pair_idx < pair_indices.size(); ++pair_idx) {
+      const auto [first_idx, second_idx] = pair_indices[pair_idx];
+      auto& sketch = pair_sketches[thread_id][pair_idx];
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        if (null_values[first_idx][chunk_offset] || null_values[second_idx][chunk_offset]) continue;
+
+        auto hash = hashes[first_idx][chunk_offset];
+        boost::hash_combine(hash, hashes[second_idx][chunk_offset]);
+        sketch.add_hash(hash);
       }
-    });
+    }
+  });
+
+  /**
+   * 2. Merge the sketches of the threads and keep the correlated pairs
+   */
+  auto column_distinct_counts = std::vector<Cardinality>(paired_column_count);
+  for (auto column_idx = size_t{0}; column_idx < paired_column_count; ++column_idx) {
+    auto sketch = HyperLogLog{};
+    for (const auto& thread_sketches : column_sketches) {
+      sketch.merge(thread_sketches[column_idx]);
+    }
+    column_distinct_counts[column_idx] = static_cast<Cardinality>(sketch.estimate());
   }
 
-  for (auto& thread : threads) {
-    thread.join();
+  auto pair_statistics = std::vector<ColumnPairStatistics>{};
+  for (auto pair_idx = size_t{0}; pair_idx < pair_indices.size(); ++pair_idx) {
+    auto sketch = HyperLogLog{};
+    for (const auto& thread_sketches : pair_sketches) {
+      sketch.merge(thread_sketches[pair_idx]);
+    }
+
+    const auto [first_idx, second_idx] = pair_indices[pair_idx];
+    auto statistics = ColumnPairStatistics{};
+    statistics.column_ids = {paired_column_ids[first_idx], paired_column_ids[second_idx]};
+    statistics.column_distinct_counts = {column_distinct_counts[first_idx], column_distinct_counts[second_idx]};
+    statistics.distinct_count = static_cast<Cardinality>(sketch.estimate());
+
+    if (statistics.correlation_factor() >= MIN_CORRELATION_FACTOR) {
+      pair_statistics.emplace_back(statistics);
+    }
   }
 
-  return std::make_shared<TableStatistics>(std::move(column_statistics), table.row_count());
+  return pair_statistics;
+}
+
+}  // namespace
+
+namespace opossum {
+
+float ColumnPairStatistics::correlation_factor() const {
+  if (distinct_count == 0.0f) return 1.0f;
+
+  // Two columns cannot have fewer value combinations than either of them has values
+  const auto combined_distinct_count =
+      std::max({distinct_count, column_distinct_counts.first, column_distinct_counts.second});
+  return std::max(1.0f, column_distinct_counts.first * column_distinct_counts.second / combined_distinct_count);
+}
+
+bool StatisticsSampling::applies_to(const Table& table) const {
+  return table.row_count() >= min_row_count && table.chunk_count() > 1;
+}
+
+std::optional<StatisticsSampling> TableStatistics::default_sampling;
+
+std::shared_ptr<TableStatistics> TableStatistics::from_table(const Table& table,
+                                                             const std::optional<StatisticsSampling>& sampling) {
+  /**
+   * Determine bin count, within mostly arbitrarily chosen bounds: 5 (for tables with <=2k rows) up to 100 bins
+   * (for tables with >= 200m rows) are created.
+   */
+  const auto histogram_bin_count = std::min<size_t>(100, std::max<size_t>(5, table.row_count() / 2'000));
+
+  auto coverage = TableStatisticsCoverage{};
+  coverage.built_row_count = table.row_count();
+  coverage.chunk_row_counts.resize(table.chunk_count());
+  for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    coverage.chunk_row_counts[chunk_id] = chunk ? chunk->size() : ChunkOffset{0};
+  }
+
+  if (sampling && sampling->applies_to(table)) {
+    const auto table_statistics = std::make_shared<TableStatistics>(
+        sampled_column_statistics(table, *sampling, histogram_bin_count), table.row_count());
+    table_statistics->coverage = std::move(coverage);
+    table_statistics->column_pair_statistics = column_pair_statistics(
+        table, sample_chunk_ids(table, sampling->chunk_ratio), table_statistics->column_statistics);
+    return table_statistics;
+  }
+
+  std::vector<std::shared_ptr<BaseAttributeStatistics>> column_statistics(table.column_count());
+
+  /**
+   * Parallely create statistics objects for the Table's columns
+   */
+  const auto column_count = static_cast<size_t>(table.column_count());
+  parallel_for(column_count, thread_count_for(column_count), [&](const size_t, const size_t column_idx) {
+    const auto column_id = ColumnID{static_cast<ColumnID::base_type>(column_idx)};
+
+    resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      const auto histogram =
+          EqualDistinctCountHistogram<ColumnDataType>::from_column(table, column_id, histogram_bin_count);
+      column_statistics[column_id] = attribute_statistics_from_histogram(histogram, table.row_count());
+    });
+  });
+
+  const auto table_statistics = std::make_shared<TableStatistics>(std::move(column_statistics), table.row_count());
+  table_statistics->coverage = std::move(coverage);
+
+  auto chunk_ids = std::vector<ChunkID>{};
+  chunk_ids.reserve(table.chunk_count());
+  for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    chunk_ids.emplace_back(chunk_id);
+  }
+  table_statistics->column_pair_statistics =
+      column_pair_statistics(table, chunk_ids, table_statistics->column_statistics);
+  return table_statistics;
 }
 
 TableStatistics::TableStatistics(std::vector<std::shared_ptr<BaseAttributeStatistics>>&& column_statistics,
@@ -82,6 +439,31 @@ DataType TableStatistics::column_data_type(const ColumnID column_id) const {
   return column_statistics[column_id]->data_type;
 }
 
+void TableStatistics::copy_column_correlations(const TableStatistics& input_table_statistics,
+                                               const std::vector<ColumnID>& input_column_ids) {
+  DebugAssert(input_column_ids.size() == column_statistics.size(), "Expected an input column for each column");
+
+  auto column_ids = std::vector<ColumnID>(input_table_statistics.column_statistics.size(), INVALID_COLUMN_ID);
+  for (auto column_id = ColumnID{0}; column_id < input_column_ids.size(); ++column_id) {
+    column_ids[input_column_ids[column_id]] = column_id;
+  }
+
+  for (const auto& input_pair_statistics : input_table_statistics.column_pair_statistics) {
+    const auto first_column_id = column_ids[input_pair_statistics.column_ids.first];
+    const auto second_column_id = column_ids[input_pair_statistics.column_ids.second];
+    if (first_column_id == INVALID_COLUMN_ID || second_column_id == INVALID_COLUMN_ID) continue;
+
+    auto& pair_statistics = column_pair_statistics.emplace_back(input_pair_statistics);
+    pair_statistics.column_ids = {first_column_id, second_column_id};
+  }
+
+  for (const auto input_column_id : input_table_statistics.equality_filtered_column_ids) {
+    if (column_ids[input_column_id] != INVALID_COLUMN_ID) {
+      equality_filtered_column_ids.emplace_back(column_ids[input_column_id]);
+    }
+  }
+}
+
 std::ostream& operator<<(std::ostream& stream, const TableStatistics& table_statistics) {
   stream << "TableStatistics {" << std::endl;
   stream << "  RowCount: " << table_statistics.row_count << "; " << std::endl;
@@ -5,6 +5,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "all_type_variant.hpp"
@@ -14,6 +15,63 @@ namespace opossum {
 class BaseAttributeStatistics;
 class Table;
 
+/**
+ * Configures TableStatistics::from_table() to build the histograms of large tables from a block sample of their
+ * chunks instead of from all of their values. The sampled chunks are spread evenly over the table, so that sorted
+ * columns are covered from their first to their last chunk. The number of distinct values per column is estimated
+ * with a HyperLogLog sketch of all chunks, which, for dictionary-encoded chunks, only reads the dictionaries.
+ */
+struct StatisticsSampling {
+  // Share of the chunks whose values are put into the histograms. At least one chunk is sampled.
+  float chunk_ratio{0.1f};
+
+  // Tables with fewer rows are not sampled, as their histograms are cheap to build completely.
+  uint64_t min_row_count{1'000'000};
+
+  // Whether the statistics of @param table are built from a sample
+  bool applies_to(const Table& table) const;
+};
+
+/**
+ * Describes which rows of a Table its TableStatistics reflect, so that they can be maintained incrementally while the
+ * Table is modified (see update_table_statistics()).
+ */
+struct TableStatisticsCoverage {
+  // Number of rows of each chunk that are part of the statistics
+  std::vector<ChunkOffset> chunk_row_counts;
+
+  // Number of invalidated rows of these chunks whose removal the statistics account for
+  uint64_t invalid_row_count{0};
+
+  // Number of rows when the statistics were last built completely, and number of rows merged or invalidated since
+  uint64_t built_row_count{0};
+  uint64_t drifted_row_count{0};
+
+  bool rebuild_scheduled{false};
+};
+
+/**
+ * Number of distinct value combinations of two columns of a Table, compared with the distinct counts of the single
+ * columns. For independent columns, most combinations of their values occur. For correlated columns, e.g., a city and
+ * its zipcode, far fewer do, and assuming independence underestimates the selectivity of `city = x AND zipcode = y`
+ * by orders of magnitude.
+ *
+ * All three distinct counts are estimated from the same rows, so that their ratio is meaningful even if the histograms
+ * are built from a sample. Rows with a NULL in either column are ignored.
+ */
+struct ColumnPairStatistics {
+  /**
+   * The selectivity of equality predicates on both columns divided by the product of their single selectivities,
+   * assuming that the values are taken from a combination that occurs in the table:
+   * d(first) * d(second) / d(first, second)
+   */
+  float correlation_factor() const;
+
+  std::pair<ColumnID, ColumnID> column_ids;
+  std::pair<Cardinality, Cardinality> column_distinct_counts;
+  Cardinality distinct_count{0};
+};
+
 /**
  * Container for all cardinality estimation statistics gathered about a Table. Also used to represent the estimation of
  * a temporary Table during Optimization.
@@ -22,9 +80,14 @@ class TableStatistics {
  public:
   /**
    * Creates statistics objects for cardinality estimation for all Columns in @param table. See implementation for
-   * which statistics objects are created.
+   * which statistics objects are created. Large tables are sampled if @param sampling is set.
    */
-  static std::shared_ptr<TableStatistics> from_table(const Table& table);
+  static std::shared_ptr<TableStatistics> from_table(
+      const Table& table, const std::optional<StatisticsSampling>& sampling = default_sampling);
+
+  // Used by from_table() if no sampling is passed explicitly, e.g., when tables are added to the StorageManager. Not
+  // set by default, i.e., the histograms are built from all values.
+  static std::optional<StatisticsSampling> default_sampling;
 
   TableStatistics(std::vector<std::shared_ptr<BaseAttributeStatistics>>&& column_statistics,
                   const Cardinality row_count);
@@ -34,8 +97,29 @@ class TableStatistics {
    */
   DataType column_data_type(const ColumnID column_id) const;
 
+  /**
+   * Copies column_pair_statistics and equality_filtered_column_ids from @param input_table_statistics, whose column
+   * @param input_column_ids[column_id] is column_id of these statistics. Pairs of columns that are not part of these
+   * statistics anymore are dropped.
+   */
+  void copy_column_correlations(const TableStatistics& input_table_statistics,
+                                const std::vector<ColumnID>& input_column_ids);
+
   const std::vector<std::shared_ptr<BaseAttributeStatistics>> column_statistics;
   Cardinality row_count;
+
+  // Only set by from_table(), i.e., not for the statistics estimated for temporary Tables
+  std::optional<TableStatisticsCoverage> coverage;
+
+  /**
+   * Correlated pairs of columns. Built by from_table() and forwarded by the CardinalityEstimator through the
+   * predicates on a single table, but not through joins, aggregates, or projections.
+   */
+  std::vector<ColumnPairStatistics> column_pair_statistics;
+
+  // Columns that the CardinalityEstimator has estimated an equality predicate on, so that the correlation of a pair
+  // is accounted for once equality predicates on both of its columns are estimated
+  std::vector<ColumnID> equality_filtered_column_ids;
 };
 
 std::ostream& operator<<(std::ostream& stream, const TableStatistics& table_statistics);
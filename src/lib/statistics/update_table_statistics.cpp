@@ -0,0 +1,325 @@
+#include "update_table_statistics.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/abstract_histogram.hpp"
+#include "statistics/statistics_objects/equal_distinct_count_histogram.hpp"
+#include "statistics/statistics_objects/generic_histogram_builder.hpp"
+#include "statistics/statistics_objects/null_value_ratio_statistics.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Rows of a chunk that are not yet part of the statistics
+struct MergedChunkRange {
+  ChunkID chunk_id;
+  ChunkOffset begin_chunk_offset;
+  ChunkOffset end_chunk_offset;
+};
+
+// Number of rows at the beginning of @param chunk that have been written, i.e., whose Inserts have committed or rolled
+// back. Rows are allocated in the order of their reservations, so that this is a prefix of the rows of the chunk.
+ChunkOffset written_row_count(const Chunk& chunk, const ChunkOffset begin_chunk_offset) {
+  const auto chunk_size = chunk.size();
+  if (!chunk.is_mutable() || !chunk.has_mvcc_data()) return chunk_size;
+
+  // The MVCC data grow before the segments (see Insert), so they cover all rows of the chunk
+  const auto mvcc_data = chunk.get_scoped_mvcc_data_lock();
+  auto chunk_offset = begin_chunk_offset;
+  while (chunk_offset < chunk_size && mvcc_data->get_begin_cid(chunk_offset) != MvccData::MAX_COMMIT_ID) {
+    ++chunk_offset;
+  }
+  return chunk_offset;
+}
+
+// Number of invalidated rows among the rows of the chunks that are part of the statistics
+uint64_t covered_invalid_row_count(const Table& table, const TableStatisticsCoverage& coverage) {
+  auto invalid_row_count = uint64_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < coverage.chunk_row_counts.size(); ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    invalid_row_count += std::min(chunk->invalid_row_count(), coverage.chunk_row_counts[chunk_id]);
+  }
+  return invalid_row_count;
+}
+
+/**
+ * Merges the bins of the histograms of two disjoint sets of rows, splitting them where they overlap. The heights of
+ * overlapping bins are added up. The distinct values of the added rows are assumed to mostly repeat those of the
+ * existing rows in the same range (e.g., for categories or foreign keys), so the larger distinct count is used. Values
+ * outside of the existing bins, e.g., ascending keys, end up in bins of their own and are fully counted.
+ */
+template <typename T>
+std::shared_ptr<AbstractHistogram<T>> merge_histograms(const std::shared_ptr<AbstractHistogram<T>>& histogram,
+                                                       const std::shared_ptr<AbstractHistogram<T>>& added_histogram) {
+  if (!histogram || histogram->total_count() == 0.0f) return added_histogram;
+  if (!added_histogram) return histogram;
+
+  // NOLINTNEXTLINE clang-tidy is crazy and sees a "potentially unintended semicolon" here...
+  if constexpr (std::is_arithmetic_v<T>) {
+    const auto unified_histogram = histogram->split_at_bin_bounds(added_histogram->bin_bounds());
+    const auto unified_added_histogram = added_histogram->split_at_bin_bounds(histogram->bin_bounds());
+
+    const auto bin_count = unified_histogram->bin_count();
+    const auto added_bin_count = unified_added_histogram->bin_count();
+    GenericHistogramBuilder<T> builder{bin_count + added_bin_count, histogram->domain()};
+
+    auto bin_id = BinID{0};
+    auto added_bin_id = BinID{0};
+    while (bin_id < bin_count || added_bin_id < added_bin_count) {
+      if (added_bin_id == added_bin_count ||
+          (bin_id < bin_count &&
+           unified_histogram->bin_minimum(bin_id) < unified_added_histogram->bin_minimum(added_bin_id))) {
+        builder.add_copied_bins(*unified_histogram, bin_id, bin_id + 1);
+        ++bin_id;
+      } else if (bin_id == bin_count ||
+                 unified_added_histogram->bin_minimum(added_bin_id) < unified_histogram->bin_minimum(bin_id)) {
+        builder.add_copied_bins(*unified_added_histogram, added_bin_id, added_bin_id + 1);
+        ++added_bin_id;
+      } else {
+        DebugAssert(unified_histogram->bin_maximum(bin_id) == unified_added_histogram->bin_maximum(added_bin_id),
+                    "Histogram bin boundaries do not match");
+        builder.add_bin(unified_histogram->bin_minimum(bin_id), unified_histogram->bin_maximum(bin_id),
+                        unified_histogram->bin_height(bin_id) + unified_added_histogram->bin_height(added_bin_id),
+                        std::max(unified_histogram->bin_distinct_count(bin_id),
+                                 unified_added_histogram->bin_distinct_count(added_bin_id)));
+        ++bin_id;
+        ++added_bin_id;
+      }
+    }
+
+    return builder.build();
+  } else {
+    // String histograms cannot be split at bin bounds. If the added values follow the existing ones, the bins are
+    // concatenated. Otherwise, the added rows are assumed to follow the distribution of the existing ones.
+    const auto bin_count = histogram->bin_count();
+    if (added_histogram->bin_minimum(BinID{0}) > histogram->bin_maximum(bin_count - 1)) {
+      GenericHistogramBuilder<T> builder{bin_count + added_histogram->bin_count(), histogram->domain()};
+      builder.add_copied_bins(*histogram, BinID{0}, bin_count);
+      builder.add_copied_bins(*added_histogram, BinID{0}, added_histogram->bin_count());
+      return builder.build();
+    }
+
+    const auto selectivity = (histogram->total_count() + added_histogram->total_count()) / histogram->total_count();
+    return std::static_pointer_cast<AbstractHistogram<T>>(histogram->scaled(selectivity));
+  }
+}
+
+// Adds the rows of @param merged_chunk_ranges to the statistics of a column and scales them by @param selectivity
+template <typename T>
+std::shared_ptr<AttributeStatistics<T>> merged_attribute_statistics(
+    const Table& table, const ColumnID column_id, const AttributeStatistics<T>& attribute_statistics,
+    const Cardinality row_count, const std::vector<MergedChunkRange>& merged_chunk_ranges,
+    const uint64_t merged_row_count, const Selectivity selectivity) {
+  auto value_distribution_map = std::unordered_map<T, HistogramCountType>{};
+  for (const auto& merged_chunk_range : merged_chunk_ranges) {
+    const auto segment = table.get_chunk(merged_chunk_range.chunk_id)->get_segment(column_id);
+    EqualDistinctCountHistogram<T>::add_segment_to_value_distribution(*segment, value_distribution_map, {},
+                                                                      merged_chunk_range.begin_chunk_offset,
+                                                                      merged_chunk_range.end_chunk_offset);
+  }
+
+  auto value_distribution =
+      std::vector<std::pair<T, HistogramCountType>>{value_distribution_map.begin(), value_distribution_map.end()};
+  value_distribution_map = {};
+  std::sort(value_distribution.begin(), value_distribution.end(),
+            [&](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+  auto merged_non_null_count = HistogramCountType{0};
+  for (const auto& value_and_count : value_distribution) {
+    merged_non_null_count += value_and_count.second;
+  }
+
+  // As in TableStatistics::from_table(), 5 to 100 bins depending on the number of rows
+  const auto bin_count = std::min<BinID>(100, std::max<BinID>(5, merged_row_count / 2'000));
+  const auto added_histogram = EqualDistinctCountHistogram<T>::from_value_distribution(std::move(value_distribution),
+                                                                                       bin_count);
+
+  const auto merged_statistics = std::make_shared<AttributeStatistics<T>>();
+  const auto histogram = merge_histograms<T>(attribute_statistics.histogram, added_histogram);
+  if (histogram) {
+    merged_statistics->set_statistics_object(histogram->scaled(selectivity));
+  }
+
+  const auto null_value_ratio =
+      attribute_statistics.null_value_ratio ? attribute_statistics.null_value_ratio->ratio : 0.0f;
+  const auto merged_statistics_row_count = row_count + static_cast<Cardinality>(merged_row_count);
+  const auto null_value_count =
+      null_value_ratio * row_count + (static_cast<Cardinality>(merged_row_count) - merged_non_null_count);
+  merged_statistics->set_statistics_object(std::make_shared<NullValueRatioStatistics>(
+      merged_statistics_row_count > 0 ? null_value_count / merged_statistics_row_count : 0.0f));
+
+  return merged_statistics;
+}
+
+void rebuild_table_statistics(const std::shared_ptr<Table>& table) {
+  auto table_statistics = TableStatistics::from_table(*table);
+  auto coverage = *table_statistics->coverage;
+
+  // The statistics are built from all rows. Scale them to the valid ones, like update_table_statistics() does.
+  const auto invalid_row_count = covered_invalid_row_count(*table, coverage);
+  if (invalid_row_count > 0 && table_statistics->row_count > 0) {
+    const auto selectivity = (table_statistics->row_count - static_cast<Cardinality>(invalid_row_count)) /
+                             table_statistics->row_count;
+
+    auto column_statistics = std::vector<std::shared_ptr<BaseAttributeStatistics>>{};
+    column_statistics.reserve(table_statistics->column_statistics.size());
+    for (const auto& attribute_statistics : table_statistics->column_statistics) {
+      column_statistics.emplace_back(attribute_statistics->scaled(selectivity));
+    }
+
+    auto scaled_table_statistics = std::make_shared<TableStatistics>(std::move(column_statistics),
+                                                                     table_statistics->row_count * selectivity);
+    scaled_table_statistics->column_pair_statistics = std::move(table_statistics->column_pair_statistics);
+    table_statistics = scaled_table_statistics;
+  }
+
+  coverage.invalid_row_count = invalid_row_count;
+  coverage.built_row_count -= invalid_row_count;
+  table_statistics->coverage = std::move(coverage);
+
+  const auto statistics_lock = table->acquire_statistics_mutex();
+  table->set_table_statistics(table_statistics);
+  // Only changed after the statistics are published. Plans that are optimized in between might use the new statistics
+  // with the old version and are dropped unnecessarily, but never the other way around.
+  table->update_statistics_version();
+}
+
+}  // namespace
+
+namespace opossum {
+
+void update_table_statistics(const std::shared_ptr<Table>& table) {
+  auto statistics_lock = table->acquire_statistics_mutex(true);
+  if (!statistics_lock.owns_lock()) return;
+
+  const auto table_statistics = table->table_statistics();
+  if (!table_statistics || !table_statistics->coverage) return;
+  const auto& coverage = *table_statistics->coverage;
+
+  // All committed rows are looked at below
+  table->reset_pending_statistics_row_count();
+
+  /**
+   * 1. Find the rows that are not part of the statistics yet. Rows of mutable chunks that Inserts might still be
+   *    writing to are left for later.
+   */
+  auto updated_coverage = coverage;
+  const auto chunk_count = table->chunk_count();
+  updated_coverage.chunk_row_counts.resize(chunk_count, ChunkOffset{0});
+
+  auto merged_chunk_ranges = std::vector<MergedChunkRange>{};
+  auto merged_row_count = uint64_t{0};
+  auto covered_row_count = uint64_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    auto& chunk_row_count = updated_coverage.chunk_row_counts[chunk_id];
+
+    // Chunks are only physically deleted once all of their rows are invalid, which they are then no longer counted as
+    if (!chunk) {
+      chunk_row_count = 0;
+      continue;
+    }
+
+    const auto written_chunk_size = written_row_count(*chunk, chunk_row_count);
+    if (written_chunk_size > chunk_row_count) {
+      merged_chunk_ranges.emplace_back(MergedChunkRange{chunk_id, chunk_row_count, written_chunk_size});
+      merged_row_count += written_chunk_size - chunk_row_count;
+      chunk_row_count = written_chunk_size;
+    }
+
+    covered_row_count += chunk_row_count;
+  }
+
+  const auto invalid_row_count = covered_invalid_row_count(*table, updated_coverage);
+  const auto invalidated_row_count = invalid_row_count > coverage.invalid_row_count
+                                         ? invalid_row_count - coverage.invalid_row_count
+                                         : coverage.invalid_row_count - invalid_row_count;
+
+  if (static_cast<float>(merged_row_count + invalidated_row_count) <=
+      STATISTICS_UPDATE_THRESHOLD * static_cast<float>(covered_row_count)) {
+    return;
+  }
+
+  /**
+   * 2. Merge the new rows into the statistics of each column and scale them to the number of valid rows.
+   */
+  const auto valid_row_count = static_cast<Cardinality>(covered_row_count - invalid_row_count);
+  const auto merged_statistics_row_count = table_statistics->row_count + static_cast<Cardinality>(merged_row_count);
+  const auto selectivity = merged_statistics_row_count > 0 ? valid_row_count / merged_statistics_row_count : 1.0f;
+
+  const auto column_count = table->column_count();
+  auto column_statistics = std::vector<std::shared_ptr<BaseAttributeStatistics>>(column_count);
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    resolve_data_type(table->column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      const auto& attribute_statistics =
+          static_cast<const AttributeStatistics<ColumnDataType>&>(*table_statistics->column_statistics[column_id]);
+      column_statistics[column_id] =
+          merged_attribute_statistics(*table, column_id, attribute_statistics, table_statistics->row_count,
+                                      merged_chunk_ranges, merged_row_count, selectivity);
+    });
+  }
+
+  /**
+   * 3. Publish the updated statistics and rebuild them if they have drifted too far from the rows they were built from
+   */
+  updated_coverage.invalid_row_count = invalid_row_count;
+  updated_coverage.drifted_row_count += merged_row_count + invalidated_row_count;
+
+  const auto rebuild = !updated_coverage.rebuild_scheduled &&
+                       static_cast<float>(updated_coverage.drifted_row_count) >=
+                           STATISTICS_REBUILD_THRESHOLD * static_cast<float>(updated_coverage.built_row_count);
+  if (rebuild) updated_coverage.rebuild_scheduled = true;
+
+  const auto updated_table_statistics =
+      std::make_shared<TableStatistics>(std::move(column_statistics), merged_statistics_row_count * selectivity);
+  updated_table_statistics->coverage = std::move(updated_coverage);
+  // The correlations of the columns are not maintained incrementally, the rebuild refreshes them
+  updated_table_statistics->column_pair_statistics = table_statistics->column_pair_statistics;
+  table->set_table_statistics(updated_table_statistics);
+
+  // Without a scheduler, the rebuild is executed immediately and needs the mutex itself
+  statistics_lock.unlock();
+
+  if (rebuild) {
+    std::make_shared<JobTask>([table]() { rebuild_table_statistics(table); })->schedule();
+  }
+}
+
+void schedule_table_statistics_update(const std::shared_ptr<Table>& table, const uint64_t changed_row_count) {
+  const auto table_statistics = table->table_statistics();
+  if (!table_statistics || !table_statistics->coverage) return;
+
+  // The row count of the statistics is an estimate, which suffices to decide whether iterating the chunks is worthwhile
+  const auto threshold_row_count = STATISTICS_UPDATE_THRESHOLD * table_statistics->row_count;
+  const auto pending_row_count = table->increase_pending_statistics_row_count(changed_row_count);
+  if (static_cast<float>(pending_row_count) <= threshold_row_count) return;
+
+  if (!Hyrise::get().scheduler()->active()) return;
+
+  // Of concurrently committing transactions, only the one that takes the pending rows schedules the update
+  const auto taken_row_count = table->reset_pending_statistics_row_count();
+  if (static_cast<float>(taken_row_count) <= threshold_row_count) {
+    table->increase_pending_statistics_row_count(taken_row_count);
+    return;
+  }
+
+  std::make_shared<JobTask>([table]() { update_table_statistics(table); })->schedule();
+}
+
+}  // namespace opossum
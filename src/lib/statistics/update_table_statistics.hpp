@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace opossum {
+
+class Table;
+
+/**
+ * Share of the rows that the statistics of a Table were built from that may be merged or invalidated before the
+ * statistics are rebuilt. Merged histograms get more and more bins, and invalidated rows are only accounted for by
+ * scaling the histograms uniformly, so the estimates drift from the actual data over time.
+ */
+inline constexpr auto STATISTICS_REBUILD_THRESHOLD = 0.25f;
+
+/**
+ * Share of the rows of a Table that have to be added or invalidated before the statistics are updated for them. Avoids
+ * replacing the statistics on every Insert and Delete.
+ */
+inline constexpr auto STATISTICS_UPDATE_THRESHOLD = 0.01f;
+
+/**
+ * Incrementally maintains the TableStatistics of @param table (as created by TableStatistics::from_table()):
+ *   - Rows that were added since the statistics were built are merged into them. For each column, a histogram of the
+ *     new rows is built and its bins are merged with those of the existing histogram. Rows of mutable chunks are
+ *     merged up to the first row whose Insert has not committed yet, as it might still be writing the row.
+ *   - Invalidated rows are accounted for by scaling the statistics to the number of valid rows.
+ *   - Once the merged and invalidated rows exceed STATISTICS_REBUILD_THRESHOLD, the statistics are rebuilt completely
+ *     by a JobTask, i.e., in the background if a scheduler is active.
+ *
+ * Called after chunks have been finalized (see ChunkCompressionTask) and by schedule_table_statistics_update(). Returns
+ * immediately if another thread is updating the statistics of the same Table.
+ */
+void update_table_statistics(const std::shared_ptr<Table>& table);
+
+/**
+ * Called when Inserts and Deletes commit, with the number of rows that they added to or invalidated in @param table.
+ * The rows are accumulated per Table, and update_table_statistics() is only scheduled as a JobTask once they exceed
+ * STATISTICS_UPDATE_THRESHOLD. Thus, small transactions do not iterate all chunks of large Tables.
+ *
+ * Without an active scheduler (i.e., with the ImmediateExecutionScheduler), the JobTask would run within the commit.
+ * The rows then remain pending until the statistics are updated otherwise, e.g., once a chunk is finalized.
+ */
+void schedule_table_statistics_update(const std::shared_ptr<Table>& table, const uint64_t changed_row_count);
+
+}  // namespace opossum
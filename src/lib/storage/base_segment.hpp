@@ -4,6 +4,7 @@
 #include <string>
 
 #include "all_type_variant.hpp"
+#include "storage/segment_access_counter.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -32,6 +33,9 @@ class BaseSegment : private Noncopyable {
   // such as strings who memory usage is implementation defined
   virtual size_t estimate_memory_usage() const = 0;
 
+  // Counts the values read from the segment. It is mutable, as reading a segment does not modify it.
+  mutable SegmentAccessCounter access_counter;
+
  private:
   const DataType _data_type;
 };
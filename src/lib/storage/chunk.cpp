@@ -1,11 +1,13 @@
 #include "chunk.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -38,9 +40,12 @@ Chunk::Chunk(Segments segments, const std::shared_ptr<MvccData>& mvcc_data,
   }
 
   if (alloc) _alloc = *alloc;
+
+  _reserved_row_count = size();
+  _allocated_row_count = size();
 }
 
-bool Chunk::is_mutable() const { return _is_mutable; }
+bool Chunk::is_mutable() const { return _is_mutable.load(std::memory_order_acquire); }
 
 void Chunk::replace_segment(size_t column_id, const std::shared_ptr<BaseSegment>& segment) {
   std::atomic_store(&_segments.at(column_id), segment);
@@ -64,6 +69,66 @@ void Chunk::append(const std::vector<AllTypeVariant>& values) {
     DebugAssert(base_value_segment, "Can't append to segment that is not a ValueSegment");
     base_value_segment->append(*value_it);
   }
+
+  ++_reserved_row_count;
+  ++_allocated_row_count;
+}
+
+std::pair<ChunkOffset, ChunkOffset> Chunk::reserve_rows(const ChunkOffset row_count,
+                                                        const ChunkOffset max_chunk_size) {
+  auto begin_chunk_offset = _reserved_row_count.load();
+  auto end_chunk_offset = begin_chunk_offset;
+
+  do {
+    if (!is_mutable() || _allocation_failed || begin_chunk_offset >= max_chunk_size) {
+      return {begin_chunk_offset, begin_chunk_offset};
+    }
+    const auto remaining_row_count = static_cast<ChunkOffset>(max_chunk_size - begin_chunk_offset);
+    end_chunk_offset = static_cast<ChunkOffset>(begin_chunk_offset + std::min(row_count, remaining_row_count));
+  } while (!_reserved_row_count.compare_exchange_weak(begin_chunk_offset, end_chunk_offset));
+
+  return {begin_chunk_offset, end_chunk_offset};
+}
+
+bool Chunk::wait_for_allocated_rows(const ChunkOffset begin_chunk_offset) const {
+  // Allocations only grow the segments and are usually done after a few yields. Waits behind allocations that take
+  // longer, e.g., because the segments need new memory, should not keep the CPU busy.
+  constexpr auto SPIN_COUNT = 64;
+  constexpr auto MAX_BACKOFF = std::chrono::microseconds{1'000};
+
+  auto backoff = std::chrono::microseconds{1};
+  for (auto attempt = 0; _allocated_row_count.load(std::memory_order_acquire) != begin_chunk_offset; ++attempt) {
+    if (_allocation_failed) return false;
+
+    if (attempt < SPIN_COUNT) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(backoff);
+      backoff = std::min(backoff * 2, MAX_BACKOFF);
+    }
+  }
+
+  return true;
+}
+
+void Chunk::set_allocated_rows(const ChunkOffset end_chunk_offset) {
+  _allocated_row_count.store(end_chunk_offset, std::memory_order_release);
+}
+
+void Chunk::fail_allocation() { _allocation_failed = true; }
+
+bool Chunk::allocation_failed() const { return _allocation_failed; }
+
+Chunk::RowAllocationGuard::RowAllocationGuard(Chunk& chunk, const ChunkOffset end_chunk_offset)
+    : _chunk(chunk), _end_chunk_offset(end_chunk_offset) {}
+
+Chunk::RowAllocationGuard::~RowAllocationGuard() {
+  if (!_allocated) _chunk.fail_allocation();
+}
+
+void Chunk::RowAllocationGuard::set_allocated() {
+  _chunk.set_allocated_rows(_end_chunk_offset);
+  _allocated = true;
 }
 
 std::shared_ptr<BaseSegment> Chunk::get_segment(ColumnID column_id) const {
@@ -98,17 +163,26 @@ std::vector<std::shared_ptr<AbstractIndex>> Chunk::get_indexes(
 
 void Chunk::finalize() {
   Assert(is_mutable(), "Only mutable chunks can be finalized. Chunks cannot be finalized twice.");
-  _is_mutable = false;
+  _is_mutable.store(false, std::memory_order_release);
 
   if (has_mvcc_data()) {
     auto mvcc = get_scoped_mvcc_data_lock();
-    Assert(!mvcc->begin_cids.empty(), "Cannot calculate max_begin_cid on an empty begin_cid vector.");
 
-    mvcc->max_begin_cid = *(std::max_element(mvcc->begin_cids.begin(), mvcc->begin_cids.end()));
+    // The rows of a failed allocation have MVCC entries, but were never written and never commit
+    const auto begin_cids_end =
+        _allocation_failed ? mvcc->begin_cids.begin() + std::min<size_t>(size(), mvcc->begin_cids.size())
+                           : mvcc->begin_cids.end();
+    Assert(begin_cids_end != mvcc->begin_cids.begin(), "Cannot calculate max_begin_cid on an empty begin_cid vector.");
+
+    mvcc->max_begin_cid = *(std::max_element(mvcc->begin_cids.begin(), begin_cids_end));
     Assert(mvcc->max_begin_cid != MvccData::MAX_COMMIT_ID,
            "max_begin_cid should not be MAX_COMMIT_ID when finalizing a chunk. This probably means the chunk was "
            "finalized before all transactions committed/rolled back.");
   }
+
+  // The MVCC vectors do not grow anymore, so we can merge their segments. This needs to happen after the scoped lock
+  // above has been released, as shrink() locks the MvccData exclusively.
+  if (has_mvcc_data()) _mvcc_data->shrink();
 }
 
 std::vector<std::shared_ptr<AbstractIndex>> Chunk::get_indexes(const std::vector<ColumnID>& column_ids) const {
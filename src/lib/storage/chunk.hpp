@@ -66,6 +66,57 @@ class Chunk : private Noncopyable {
   // note this is slow and not thread-safe and should be used for testing purposes only
   void append(const std::vector<AllTypeVariant>& values);
 
+  /**
+   * Concurrent Inserts append rows to a mutable chunk without holding the table's append_mutex. First, an Insert
+   * reserves a range of rows by atomically advancing a counter. Second, it allocates the rows, i.e., grows the
+   * MvccData and the segments, which the Inserts do in the order of their reservations: Otherwise, an Insert that
+   * grows the segments beyond the rows of another Insert could still be constructing values that the other Insert
+   * already wrote. Allocating is cheap compared to writing the values, which the Inserts then do in parallel.
+   * @{
+   */
+
+  // Reserves up to @param row_count rows, but none beyond @param max_chunk_size. Returns the ChunkOffsets
+  // [begin, end) of the reserved rows, an empty range means that the chunk is full or immutable.
+  std::pair<ChunkOffset, ChunkOffset> reserve_rows(const ChunkOffset row_count, const ChunkOffset max_chunk_size);
+
+  // Waits until all rows before @param begin_chunk_offset, i.e., those reserved before, are allocated. Spins first and
+  // then backs off to sleeping. Returns false if an earlier allocation failed, as the rows are never allocated then.
+  bool wait_for_allocated_rows(const ChunkOffset begin_chunk_offset) const;
+
+  // Marks all rows before @param end_chunk_offset as allocated, which lets the next reservation proceed
+  void set_allocated_rows(const ChunkOffset end_chunk_offset);
+
+  // Marks the allocation of the rows that are not allocated yet as failed. The chunk does not accept reservations
+  // anymore, and Inserts that wait for the allocation of their rows give up their reservations.
+  void fail_allocation();
+
+  /**
+   * Whether an allocation failed, see fail_allocation(). Such a chunk never becomes full. Only its allocated rows are
+   * part of size(), but the failed Insert might already have grown the MvccData beyond them. The ChunkCompressionTask
+   * considers the chunk completed once the Inserts of its allocated rows are done, and finalize() ignores the MVCC
+   * entries beyond size().
+   */
+  bool allocation_failed() const;
+
+  /**
+   * Ends the allocation of reserved rows on every path: set_allocated() calls set_allocated_rows(). If the guard is
+   * destroyed before, e.g., because growing the segments threw, it calls fail_allocation(), so that the Inserts that
+   * reserved rows afterwards do not wait forever.
+   */
+  class RowAllocationGuard : private Noncopyable {
+   public:
+    RowAllocationGuard(Chunk& chunk, const ChunkOffset end_chunk_offset);
+    ~RowAllocationGuard();
+
+    void set_allocated();
+
+   private:
+    Chunk& _chunk;
+    const ChunkOffset _end_chunk_offset;
+    bool _allocated{false};
+  };
+  /** @} */
+
   /**
    * Atomically accesses and returns the segment at a given position
    *
@@ -193,10 +244,16 @@ class Chunk : private Noncopyable {
   std::shared_ptr<MvccData> _mvcc_data;
   Indexes _indexes;
   std::optional<ChunkPruningStatistics> _pruning_statistics;
-  bool _is_mutable = true;
+  // Read by Inserts without holding the append mutex (see reserve_rows()), while finalize() might be writing it
+  std::atomic_bool _is_mutable{true};
   std::optional<std::pair<ColumnID, OrderByMode>> _ordered_by;
   mutable std::atomic<ChunkOffset> _invalid_row_count{0};
 
+  // See reserve_rows()
+  std::atomic<ChunkOffset> _reserved_row_count{0};
+  std::atomic<ChunkOffset> _allocated_row_count{0};
+  std::atomic_bool _allocation_failed{false};
+
   // Default value of zero means "not set"
   std::atomic<CommitID> _cleanup_commit_id{0};
   static_assert(std::is_same<uint32_t, CommitID>::value, "Type of _cleanup_commit_id does not match type of CommitID.");
@@ -102,6 +102,9 @@ void ChunkEncoder::encode_chunk(const std::shared_ptr<Chunk>& chunk, const std::
          "Number of column encoding specs must match the chunk’s column count.");
   Assert(!chunk->is_mutable(), "Only immutable chunks can be encoded.");
 
+  // Reading the segments for encoding them and for generating the pruning statistics is not part of the workload
+  const auto uncounted_scope = SegmentAccessCounter::UncountedScope{};
+
   for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
     const auto spec = chunk_encoding_spec[column_id];
 
@@ -109,6 +112,8 @@ void ChunkEncoder::encode_chunk(const std::shared_ptr<Chunk>& chunk, const std::
     const auto base_segment = chunk->get_segment(column_id);
 
     const auto encoded_segment = encode_segment(base_segment, data_type, spec);
+    // The encoded segment takes over the accesses recorded so far
+    if (encoded_segment != base_segment) encoded_segment->access_counter.add(base_segment->access_counter);
     chunk->replace_segment(column_id, encoded_segment);
   }
 
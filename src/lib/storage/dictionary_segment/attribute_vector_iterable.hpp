@@ -2,6 +2,7 @@
 
 #include <utility>
 
+#include "storage/segment_access_counter.hpp"
 #include "storage/segment_iterables.hpp"
 #include "storage/vector_compression/resolve_compressed_vector_type.hpp"
 
@@ -11,11 +12,13 @@ class AttributeVectorIterable : public PointAccessibleSegmentIterable<AttributeV
  public:
   using ValueType = ValueID;
 
-  explicit AttributeVectorIterable(const BaseCompressedVector& attribute_vector, const ValueID null_value_id)
-      : _attribute_vector{attribute_vector}, _null_value_id{null_value_id} {}
+  explicit AttributeVectorIterable(const BaseCompressedVector& attribute_vector, const ValueID null_value_id,
+                                   SegmentAccessCounter& access_counter)
+      : _attribute_vector{attribute_vector}, _null_value_id{null_value_id}, _access_counter{access_counter} {}
 
   template <typename Functor>
   void _on_with_iterators(const Functor& functor) const {
+    _access_counter.increment(SegmentAccessCounter::AccessType::Sequential, _attribute_vector.size());
     resolve_compressed_vector_type(_attribute_vector, [&](const auto& vector) {
       using ZsIteratorType = decltype(vector.cbegin());
 
@@ -28,6 +31,7 @@ class AttributeVectorIterable : public PointAccessibleSegmentIterable<AttributeV
 
   template <typename Functor>
   void _on_with_iterators(const std::shared_ptr<const PosList>& position_filter, const Functor& functor) const {
+    _access_counter.increment(SegmentAccessCounter::AccessType::Random, position_filter->size());
     resolve_compressed_vector_type(_attribute_vector, [&](const auto& vector) {
       auto decompressor = vector.create_decompressor();
       using ZsDecompressorType = std::decay_t<decltype(*decompressor)>;
@@ -45,6 +49,8 @@ class AttributeVectorIterable : public PointAccessibleSegmentIterable<AttributeV
  private:
   const BaseCompressedVector& _attribute_vector;
   const ValueID _null_value_id;
+  // Counts the accesses of the dictionary segment that the attribute vector belongs to
+  SegmentAccessCounter& _access_counter;
 
  private:
   template <typename ZsIteratorType>
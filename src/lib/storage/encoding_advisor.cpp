@@ -0,0 +1,584 @@
+#include "encoding_advisor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <unordered_set>
+
+#include "expression/expression_utils.hpp"
+#include "expression/lqp_column_expression.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/abstract_lqp_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "operators/abstract_join_operator.hpp"
+#include "operators/abstract_operator.hpp"
+#include "operators/morsel_pipeline.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/base_encoded_segment.hpp"
+#include "storage/base_value_segment.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/pos_list.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "tasks/chunk_compression_task.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Rough costs of reading a value from a segment with the given encoding, relative to reading it from an unencoded
+// segment. Scans read all values in sequence, point accesses decode the values at individual positions.
+struct AccessCosts {
+  double scan;
+  double point_access;
+};
+
+AccessCosts access_costs(const EncodingType encoding_type, const SegmentCharacteristics& characteristics) {
+  switch (encoding_type) {
+    case EncodingType::Unencoded:
+      return {1.0, 1.0};
+    case EncodingType::Dictionary:
+      // Scans compare the value ids with a value id that is looked up in the dictionary only once
+      return {0.7, 1.5};
+    case EncodingType::FixedStringDictionary:
+      return {0.8, 1.8};
+    case EncodingType::FrameOfReference:
+      return {1.2, 1.3};
+    case EncodingType::RunLength: {
+      // Scans handle a complete run at once, point accesses have to search for the run that contains the position
+      const auto runs_per_row = static_cast<double>(characteristics.run_count) /
+                                static_cast<double>(std::max(characteristics.row_count, size_t{1}));
+      return {0.2 + 2.0 * runs_per_row, 3.0};
+    }
+    case EncodingType::LZ4:
+      // Every access decompresses an entire block
+      return {4.0, 12.0};
+  }
+  Fail("Invalid enum value");
+}
+
+// Width of a FixedSizeByteAligned vector that stores values up to @param max_value
+size_t byte_aligned_width(const uint64_t max_value) {
+  if (max_value <= std::numeric_limits<uint8_t>::max()) return 1;
+  if (max_value <= std::numeric_limits<uint16_t>::max()) return 2;
+  return 4;
+}
+
+size_t estimate_memory_usage(const EncodingType encoding_type, const SegmentCharacteristics& characteristics) {
+  const auto row_count = static_cast<double>(characteristics.row_count);
+  const auto distinct_count = static_cast<double>(characteristics.distinct_count);
+  // Encodings that store NULLs in a separate vector use one byte per row for it
+  const auto null_values_size = characteristics.null_count > 0 ? row_count : 0.0;
+  // The largest value id is reserved for NULL
+  const auto value_id_width = static_cast<double>(byte_aligned_width(characteristics.distinct_count));
+
+  auto memory_usage = 0.0;
+  switch (encoding_type) {
+    case EncodingType::Unencoded:
+      memory_usage = row_count * characteristics.value_size + null_values_size;
+      break;
+    case EncodingType::Dictionary:
+      memory_usage = distinct_count * characteristics.value_size + row_count * value_id_width;
+      break;
+    case EncodingType::FixedStringDictionary:
+      memory_usage =
+          distinct_count * static_cast<double>(characteristics.max_string_length) + row_count * value_id_width;
+      break;
+    case EncodingType::FrameOfReference: {
+      const auto block_count = std::ceil(row_count / static_cast<double>(EncodingAdvisor::SAMPLE_BLOCK_SIZE));
+      const auto offset_width = byte_aligned_width(characteristics.max_block_value_range.value_or(0));
+      memory_usage = row_count * static_cast<double>(offset_width) + block_count * characteristics.value_size +
+                     null_values_size;
+    } break;
+    case EncodingType::RunLength:
+      // Each run stores its value, its end position, and whether it is NULL
+      memory_usage = static_cast<double>(characteristics.run_count) *
+                     (characteristics.value_size + static_cast<double>(sizeof(ChunkOffset)) + 1.0);
+      break;
+    case EncodingType::LZ4:
+      memory_usage = static_cast<double>(characteristics.lz4_size);
+      break;
+  }
+  return static_cast<size_t>(std::ceil(memory_usage));
+}
+
+}  // namespace
+
+namespace opossum {
+
+EncodingAdvisor& EncodingAdvisor::operator=(EncodingAdvisor&& encoding_advisor) noexcept {
+  _access_recording_enabled = encoding_advisor._access_recording_enabled.load();
+  _column_accesses = std::move(encoding_advisor._column_accesses);
+  _memory_budget = encoding_advisor._memory_budget;
+  _decisions = std::move(encoding_advisor._decisions);
+  return *this;
+}
+
+void EncodingAdvisor::set_access_recording_enabled(const bool enabled) { _access_recording_enabled = enabled; }
+
+bool EncodingAdvisor::access_recording_enabled() const { return _access_recording_enabled; }
+
+void EncodingAdvisor::record_accesses(const std::shared_ptr<const AbstractOperator>& pqp) {
+  if (!_access_recording_enabled) return;
+
+  auto column_accesses = std::map<std::pair<std::string, ColumnID>, ColumnAccesses>{};
+
+  auto operator_queue = std::queue<std::shared_ptr<const AbstractOperator>>{};
+  operator_queue.push(pqp);
+  auto visited_operators = std::unordered_set<std::shared_ptr<const AbstractOperator>>{};
+
+  while (!operator_queue.empty()) {
+    const auto op = operator_queue.front();
+    operator_queue.pop();
+    if (!op || !visited_operators.emplace(op).second) continue;
+
+    operator_queue.push(op->input_left());
+    operator_queue.push(op->input_right());
+
+    // The operators fused into a MorselPipeline have no inputs, but they still access the columns
+    if (const auto morsel_pipeline = std::dynamic_pointer_cast<const MorselPipeline>(op)) {
+      for (const auto& fused_operator : morsel_pipeline->operators()) {
+        operator_queue.push(fused_operator);
+      }
+    }
+
+    if (!op->lqp_node) continue;
+
+    // The LQP node of an operator refers to the columns of stored tables, while the operator itself only knows the
+    // positions of the columns in its input. Joins and aggregates materialize their input columns in sequence.
+    const auto is_scan = op->type() == OperatorType::TableScan || op->type() == OperatorType::IndexScan ||
+                         op->type() == OperatorType::Aggregate ||
+                         std::dynamic_pointer_cast<const AbstractJoinOperator>(op) != nullptr;
+    for (const auto& node_expression : op->lqp_node->node_expressions) {
+      // Projections forward plain columns without accessing them
+      if (op->type() == OperatorType::Projection && node_expression->type == ExpressionType::LQPColumn) continue;
+
+      visit_expression(node_expression, [&](const auto& sub_expression) {
+        if (sub_expression->type != ExpressionType::LQPColumn) return ExpressionVisitation::VisitArguments;
+
+        const auto& column_reference = static_cast<const LQPColumnExpression&>(*sub_expression).column_reference;
+        const auto original_node = column_reference.original_node();
+        if (original_node && original_node->type == LQPNodeType::StoredTable) {
+          const auto& table_name = static_cast<const StoredTableNode&>(*original_node).table_name;
+          auto& accesses = column_accesses[{table_name, column_reference.original_column_id()}];
+          ++(is_scan ? accesses.scan_count : accesses.point_access_count);
+        }
+        return ExpressionVisitation::DoNotVisitArguments;
+      });
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (const auto& [column, accesses] : column_accesses) {
+    auto& recorded_accesses = _column_accesses[column];
+    recorded_accesses.scan_count += accesses.scan_count;
+    recorded_accesses.point_access_count += accesses.point_access_count;
+  }
+}
+
+ColumnAccesses EncodingAdvisor::column_accesses(const std::string& table_name, const ColumnID column_id) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto iter = _column_accesses.find({table_name, column_id});
+  return iter != _column_accesses.end() ? iter->second : ColumnAccesses{};
+}
+
+void EncodingAdvisor::reset_accesses() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _column_accesses.clear();
+}
+
+void EncodingAdvisor::set_memory_budget(const std::optional<size_t>& memory_budget) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _memory_budget = memory_budget;
+}
+
+std::optional<size_t> EncodingAdvisor::memory_budget() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _memory_budget;
+}
+
+void EncodingAdvisor::run() {
+  // Collect the segments of all immutable chunks. Mutable chunks cannot be encoded yet, chunks that were deleted
+  // logically are about to be removed.
+  auto decisions = std::vector<SegmentEncodingDecision>{};
+  auto segments = std::vector<std::shared_ptr<const BaseSegment>>{};
+  auto data_types = std::vector<DataType>{};
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& [table_name, table] : Hyrise::get().storage_manager.tables()) {
+      const auto chunk_count = table->chunk_count();
+      for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+        const auto chunk = table->get_chunk(chunk_id);
+        if (!chunk || chunk->is_mutable() || chunk->get_cleanup_commit_id()) continue;
+
+        for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+          auto decision = SegmentEncodingDecision{};
+          decision.table_name = table_name;
+          decision.chunk_id = chunk_id;
+          decision.column_id = column_id;
+          decision.column_name = table->column_name(column_id);
+
+          const auto accesses_iter = _column_accesses.find({table_name, column_id});
+          if (accesses_iter != _column_accesses.end()) decision.column_accesses = accesses_iter->second;
+
+          const auto segment = chunk->get_segment(column_id);
+          if (const auto encoded_segment = std::dynamic_pointer_cast<const BaseEncodedSegment>(segment)) {
+            decision.previous_encoding_type = encoded_segment->encoding_type();
+          } else if (std::dynamic_pointer_cast<const BaseValueSegment>(segment)) {
+            decision.previous_encoding_type = EncodingType::Unencoded;
+          }
+          decision.previous_memory_usage = segment->estimate_memory_usage();
+
+          decisions.emplace_back(std::move(decision));
+          segments.emplace_back(segment);
+          data_types.emplace_back(table->column_data_type(column_id));
+        }
+      }
+    }
+  }
+
+  // Sample the segments and estimate the candidates concurrently
+  auto candidates = std::vector<std::vector<SegmentEncodingCandidate>>(decisions.size());
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(decisions.size());
+  for (auto segment_index = size_t{0}; segment_index < decisions.size(); ++segment_index) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, segment_index]() {
+      auto& decision = decisions[segment_index];
+      decision.characteristics = sample_segment(segments[segment_index], data_types[segment_index]);
+      candidates[segment_index] =
+          estimate_candidates(decision.characteristics, data_types[segment_index], decision.column_accesses);
+    }));
+    jobs.back()->schedule();
+  }
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+
+  // Without recorded accesses, there is no reason to change the encoding of a segment unless the budget requires it
+  auto initial_candidates = std::vector<std::optional<size_t>>(decisions.size());
+  for (auto segment_index = size_t{0}; segment_index < decisions.size(); ++segment_index) {
+    const auto& decision = decisions[segment_index];
+    if (decision.column_accesses.scan_count > 0 || decision.column_accesses.point_access_count > 0) continue;
+
+    const auto& segment_candidates = candidates[segment_index];
+    const auto current_candidate =
+        std::find_if(segment_candidates.begin(), segment_candidates.end(), [&](const auto& candidate) {
+          return candidate.encoding_spec.encoding_type == decision.previous_encoding_type;
+        });
+    if (current_candidate != segment_candidates.end()) {
+      initial_candidates[segment_index] =
+          static_cast<size_t>(std::distance(segment_candidates.begin(), current_candidate));
+    }
+  }
+
+  const auto chosen_candidates = choose_candidates(candidates, memory_budget(), initial_candidates);
+
+  // Re-encode the chunks in which the encoding of at least one segment changes
+  auto tasks = std::vector<std::shared_ptr<ChunkCompressionTask>>{};
+  auto chunk_begin = size_t{0};
+  while (chunk_begin < decisions.size()) {
+    auto chunk_encoding_spec = ChunkEncodingSpec{};
+    auto encoding_changes = false;
+
+    auto chunk_end = chunk_begin;
+    for (; chunk_end < decisions.size() && decisions[chunk_end].table_name == decisions[chunk_begin].table_name &&
+           decisions[chunk_end].chunk_id == decisions[chunk_begin].chunk_id;
+         ++chunk_end) {
+      auto& decision = decisions[chunk_end];
+      decision.chosen_candidate = candidates[chunk_end][chosen_candidates[chunk_end]];
+
+      const auto& encoding_spec = decision.chosen_candidate.encoding_spec;
+      chunk_encoding_spec.emplace_back(encoding_spec);
+      if (decision.previous_encoding_type != encoding_spec.encoding_type) encoding_changes = true;
+    }
+
+    if (encoding_changes) {
+      const auto& table_name = decisions[chunk_begin].table_name;
+      const auto chunk_ids = std::vector<ChunkID>{decisions[chunk_begin].chunk_id};
+      tasks.emplace_back(std::make_shared<ChunkCompressionTask>(table_name, chunk_ids, chunk_encoding_spec));
+    }
+
+    chunk_begin = chunk_end;
+  }
+
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _decisions = std::move(decisions);
+}
+
+std::vector<SegmentEncodingDecision> EncodingAdvisor::decisions() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _decisions;
+}
+
+SegmentCharacteristics EncodingAdvisor::sample_segment(const std::shared_ptr<const BaseSegment>& segment,
+                                                       const DataType data_type) {
+  auto characteristics = SegmentCharacteristics{};
+  const auto row_count = static_cast<size_t>(segment->size());
+  characteristics.row_count = row_count;
+  if (row_count == 0) return characteristics;
+
+  // Sampling is not part of the workload
+  const auto uncounted_scope = SegmentAccessCounter::UncountedScope{};
+
+  // Sample SAMPLE_BLOCK_COUNT evenly spaced blocks. Segments that are not larger than the sample are sampled entirely.
+  const auto block_stride = std::max(row_count / SAMPLE_BLOCK_COUNT, SAMPLE_BLOCK_SIZE);
+
+  // Only the rows of the sampled blocks are read, so that, e.g., LZ4 segments are not decompressed entirely
+  auto position_filter = std::shared_ptr<PosList>{};
+  if (block_stride > SAMPLE_BLOCK_SIZE) {
+    position_filter = std::make_shared<PosList>();
+    position_filter->reserve(SAMPLE_BLOCK_COUNT * SAMPLE_BLOCK_SIZE);
+    for (auto block_begin = size_t{0}; block_begin < row_count; block_begin += block_stride) {
+      const auto block_end = std::min(block_begin + SAMPLE_BLOCK_SIZE, row_count);
+      for (auto chunk_offset = block_begin; chunk_offset < block_end; ++chunk_offset) {
+        position_filter->emplace_back(RowID{ChunkID{0}, static_cast<ChunkOffset>(chunk_offset)});
+      }
+    }
+    position_filter->guarantee_single_chunk();
+  }
+
+  resolve_data_type(data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    auto values = std::vector<ColumnDataType>{};
+    auto null_values = std::vector<bool>{};
+    // Transitions between two adjacent sampled rows with different values, used to extrapolate the number of runs
+    auto adjacent_pair_count = size_t{0};
+    auto transition_count = size_t{0};
+    // The value range is determined per sampled block, as FrameOfReference stores the values relative to the minimum
+    // of their block
+    auto block_minimum = std::optional<ColumnDataType>{};
+    auto block_maximum = std::optional<ColumnDataType>{};
+    auto previous_chunk_offset = ChunkOffset{0};
+
+    // Filtered iterators number their positions by their index in the PosList
+    auto sample_index = size_t{0};
+    const auto sample_position = [&](const auto& position) {
+      const auto chunk_offset =
+          position_filter ? (*position_filter)[sample_index++].chunk_offset : position.chunk_offset();
+
+      const auto is_null = position.is_null();
+      const auto value = is_null ? ColumnDataType{} : position.value();
+
+      const auto is_adjacent = !values.empty() && chunk_offset == previous_chunk_offset + 1;
+      if (is_adjacent) {
+        ++adjacent_pair_count;
+        if (is_null != null_values.back() || value != values.back()) ++transition_count;
+      }
+
+      if constexpr (std::is_integral_v<ColumnDataType>) {
+        if (!is_adjacent) {
+          block_minimum.reset();
+          block_maximum.reset();
+        }
+        if (!is_null) {
+          block_minimum = block_minimum ? std::min(*block_minimum, value) : value;
+          block_maximum = block_maximum ? std::max(*block_maximum, value) : value;
+          const auto block_value_range = static_cast<uint64_t>(*block_maximum) - static_cast<uint64_t>(*block_minimum);
+          characteristics.max_block_value_range =
+              std::max(characteristics.max_block_value_range.value_or(0), block_value_range);
+        }
+      }
+
+      values.emplace_back(value);
+      null_values.emplace_back(is_null);
+      previous_chunk_offset = chunk_offset;
+    };
+
+    if (position_filter) {
+      segment_iterate_filtered<ColumnDataType, EraseTypes::Always>(*segment, position_filter, sample_position);
+    } else {
+      segment_iterate<ColumnDataType, EraseTypes::Always>(*segment, sample_position);
+    }
+
+    const auto sampled_row_count = values.size();
+    const auto is_complete_sample = sampled_row_count == row_count;
+    const auto scale_factor = static_cast<double>(row_count) / static_cast<double>(sampled_row_count);
+    characteristics.sampled_row_count = sampled_row_count;
+
+    const auto sampled_null_count = static_cast<size_t>(std::count(null_values.begin(), null_values.end(), true));
+    characteristics.null_count =
+        static_cast<size_t>(std::round(static_cast<double>(sampled_null_count) * scale_factor));
+
+    auto non_null_values = std::vector<ColumnDataType>{};
+    non_null_values.reserve(sampled_row_count - sampled_null_count);
+    for (auto value_index = size_t{0}; value_index < sampled_row_count; ++value_index) {
+      if (!null_values[value_index]) non_null_values.emplace_back(values[value_index]);
+    }
+
+    if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+      // Strings that do not fit into the string object itself are allocated on the heap
+      const auto inline_capacity = pmr_string{}.capacity();
+      auto heap_size = size_t{0};
+      for (const auto& value : non_null_values) {
+        if (value.size() > inline_capacity) heap_size += value.size() + 1;
+        characteristics.max_string_length = std::max(characteristics.max_string_length, value.size());
+      }
+      const auto average_heap_size =
+          non_null_values.empty() ? 0.0 : static_cast<double>(heap_size) / static_cast<double>(non_null_values.size());
+      characteristics.value_size = static_cast<double>(sizeof(pmr_string)) + average_heap_size;
+    } else {
+      characteristics.value_size = static_cast<double>(sizeof(ColumnDataType));
+    }
+
+    // Estimate the distinct count with the Guaranteed-Error Estimator (GEE, Charikar et al., 2000): Values that occur
+    // only once in the sample are scaled up, all others are assumed to have been found already.
+    std::sort(non_null_values.begin(), non_null_values.end());
+    auto sampled_distinct_count = size_t{0};
+    auto singleton_count = size_t{0};
+    for (auto group_begin = non_null_values.begin(); group_begin != non_null_values.end();) {
+      const auto group_end = std::upper_bound(group_begin, non_null_values.end(), *group_begin);
+      ++sampled_distinct_count;
+      if (std::distance(group_begin, group_end) == 1) ++singleton_count;
+      group_begin = group_end;
+    }
+
+    if (is_complete_sample) {
+      characteristics.distinct_count = sampled_distinct_count;
+    } else {
+      const auto estimated_distinct_count = std::sqrt(scale_factor) * static_cast<double>(singleton_count) +
+                                            static_cast<double>(sampled_distinct_count - singleton_count);
+      const auto max_distinct_count = std::max(sampled_distinct_count, row_count - characteristics.null_count);
+      characteristics.distinct_count = std::clamp(static_cast<size_t>(std::round(estimated_distinct_count)),
+                                                  sampled_distinct_count, max_distinct_count);
+    }
+
+    if (adjacent_pair_count == 0) {
+      characteristics.run_count = row_count;
+    } else {
+      const auto transitions_per_pair =
+          static_cast<double>(transition_count) / static_cast<double>(adjacent_pair_count);
+      characteristics.run_count =
+          1 + static_cast<size_t>(std::round(transitions_per_pair * static_cast<double>(row_count - 1)));
+    }
+
+    // LZ4 compresses based on byte sequences, which are not captured by the characteristics above. Thus, the sample
+    // is compressed and its size is extrapolated.
+    const auto sample_segment =
+        std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(null_values));
+    const auto lz4_segment = ChunkEncoder::encode_segment(sample_segment, data_type, EncodingType::LZ4);
+    characteristics.lz4_size =
+        static_cast<size_t>(std::ceil(static_cast<double>(lz4_segment->estimate_memory_usage()) * scale_factor));
+  });
+
+  return characteristics;
+}
+
+std::vector<SegmentEncodingCandidate> EncodingAdvisor::estimate_candidates(
+    const SegmentCharacteristics& characteristics, const DataType data_type, const ColumnAccesses& column_accesses) {
+  auto candidates = std::vector<SegmentEncodingCandidate>{};
+
+  for (const auto encoding_type : all_encoding_types) {
+    if (!encoding_supports_data_type(encoding_type, data_type)) continue;
+
+    auto candidate = SegmentEncodingCandidate{};
+    candidate.encoding_spec = SegmentEncodingSpec{encoding_type};
+    if (encoding_type == EncodingType::Dictionary || encoding_type == EncodingType::FixedStringDictionary ||
+        encoding_type == EncodingType::FrameOfReference) {
+      // The memory usage estimation assumes byte-aligned vectors, which are also faster to access than SIMD-BP128
+      candidate.encoding_spec.vector_compression_type = VectorCompressionType::FixedSizeByteAligned;
+    }
+
+    candidate.estimated_memory_usage = estimate_memory_usage(encoding_type, characteristics);
+
+    const auto costs = access_costs(encoding_type, characteristics);
+    candidate.estimated_access_cost =
+        static_cast<double>(characteristics.row_count) *
+        (static_cast<double>(column_accesses.scan_count) * costs.scan +
+         static_cast<double>(column_accesses.point_access_count) * costs.point_access);
+
+    candidates.emplace_back(candidate);
+  }
+
+  return candidates;
+}
+
+std::vector<size_t> EncodingAdvisor::choose_candidates(
+    const std::vector<std::vector<SegmentEncodingCandidate>>& candidates, const std::optional<size_t>& memory_budget,
+    const std::vector<std::optional<size_t>>& initial_candidates) {
+  Assert(initial_candidates.empty() || initial_candidates.size() == candidates.size(),
+         "Expected an initial candidate (or none) for each segment");
+
+  // Start with the initial or else the cheapest candidate of each segment, choosing the smaller one if two candidates
+  // are equally cheap
+  auto chosen_candidates = std::vector<size_t>(candidates.size());
+  auto total_memory_usage = size_t{0};
+  for (auto segment_index = size_t{0}; segment_index < candidates.size(); ++segment_index) {
+    const auto& segment_candidates = candidates[segment_index];
+    Assert(!segment_candidates.empty(), "Each segment needs at least one candidate");
+
+    if (!initial_candidates.empty() && initial_candidates[segment_index]) {
+      chosen_candidates[segment_index] = *initial_candidates[segment_index];
+      total_memory_usage += segment_candidates[*initial_candidates[segment_index]].estimated_memory_usage;
+      continue;
+    }
+
+    const auto cheapest_candidate =
+        std::min_element(segment_candidates.begin(), segment_candidates.end(), [](const auto& lhs, const auto& rhs) {
+          return std::tie(lhs.estimated_access_cost, lhs.estimated_memory_usage) <
+                 std::tie(rhs.estimated_access_cost, rhs.estimated_memory_usage);
+        });
+    chosen_candidates[segment_index] =
+        static_cast<size_t>(std::distance(segment_candidates.begin(), cheapest_candidate));
+    total_memory_usage += cheapest_candidate->estimated_memory_usage;
+  }
+
+  if (!memory_budget) return chosen_candidates;
+
+  // Returns the smaller candidate of a segment that has the lowest additional access cost per saved byte, together
+  // with that ratio
+  const auto next_smaller_candidate = [&](const size_t segment_index) -> std::optional<std::pair<double, size_t>> {
+    const auto& segment_candidates = candidates[segment_index];
+    const auto& chosen_candidate = segment_candidates[chosen_candidates[segment_index]];
+
+    auto best_candidate = std::optional<std::pair<double, size_t>>{};
+    for (auto candidate_index = size_t{0}; candidate_index < segment_candidates.size(); ++candidate_index) {
+      const auto& candidate = segment_candidates[candidate_index];
+      if (candidate.estimated_memory_usage >= chosen_candidate.estimated_memory_usage) continue;
+
+      const auto saved_bytes =
+          static_cast<double>(chosen_candidate.estimated_memory_usage - candidate.estimated_memory_usage);
+      const auto cost_per_saved_byte =
+          (candidate.estimated_access_cost - chosen_candidate.estimated_access_cost) / saved_bytes;
+      if (!best_candidate || cost_per_saved_byte < best_candidate->first) {
+        best_candidate = std::pair{cost_per_saved_byte, candidate_index};
+      }
+    }
+    return best_candidate;
+  };
+
+  // (cost per saved byte, segment index, candidate index), ordered so that the lowest cost per saved byte is on top
+  using Step = std::tuple<double, size_t, size_t>;
+  auto steps = std::priority_queue<Step, std::vector<Step>, std::greater<Step>>{};
+  for (auto segment_index = size_t{0}; segment_index < candidates.size(); ++segment_index) {
+    if (const auto step = next_smaller_candidate(segment_index)) {
+      steps.emplace(step->first, segment_index, step->second);
+    }
+  }
+
+  while (total_memory_usage > *memory_budget && !steps.empty()) {
+    const auto step = steps.top();
+    steps.pop();
+
+    const auto segment_index = std::get<1>(step);
+    const auto candidate_index = std::get<2>(step);
+    total_memory_usage -= candidates[segment_index][chosen_candidates[segment_index]].estimated_memory_usage;
+    total_memory_usage += candidates[segment_index][candidate_index].estimated_memory_usage;
+    chosen_candidates[segment_index] = candidate_index;
+
+    if (const auto next_step = next_smaller_candidate(segment_index)) {
+      steps.emplace(next_step->first, segment_index, next_step->second);
+    }
+  }
+
+  return chosen_candidates;
+}
+
+}  // namespace opossum
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/encoding_type.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractOperator;
+class BaseSegment;
+
+// Data characteristics of a segment that decide how well the different encodings compress it. They are obtained from
+// a sample of the segment (see EncodingAdvisor::sample_segment()) and extrapolated to the size of the segment.
+struct SegmentCharacteristics {
+  size_t row_count{0};
+  size_t sampled_row_count{0};
+
+  size_t null_count{0};
+  size_t distinct_count{0};
+  size_t run_count{0};
+
+  // Size of an unencoded value in bytes. For strings, this includes the heap allocations of long strings.
+  double value_size{0.0};
+
+  // Only for strings
+  size_t max_string_length{0};
+
+  // Only for integers: The largest difference between two values within a sampled block
+  std::optional<uint64_t> max_block_value_range;
+
+  // Estimated size of an LZ4-encoded segment, obtained by compressing the sample
+  size_t lz4_size{0};
+};
+
+// An encoding that a segment could be encoded with, together with its estimated memory usage and its estimated cost
+// of accessing the segment with the recorded workload
+struct SegmentEncodingCandidate {
+  SegmentEncodingSpec encoding_spec;
+  size_t estimated_memory_usage{0};
+  double estimated_access_cost{0.0};
+};
+
+// Number of times the columns of a stored table were accessed by executed PQPs
+struct ColumnAccesses {
+  // Scans (e.g., by TableScans), joins, and aggregates read the values of the segments in sequence
+  size_t scan_count{0};
+
+  // All other operators (e.g., projections) read the values at the positions that previous operators have selected
+  size_t point_access_count{0};
+};
+
+struct SegmentEncodingDecision {
+  std::string table_name;
+  ChunkID chunk_id{INVALID_CHUNK_ID};
+  ColumnID column_id{INVALID_COLUMN_ID};
+  std::string column_name;
+
+  std::optional<EncodingType> previous_encoding_type;
+  size_t previous_memory_usage{0};
+
+  SegmentCharacteristics characteristics;
+  ColumnAccesses column_accesses;
+  SegmentEncodingCandidate chosen_candidate;
+};
+
+/**
+ * Chooses an encoding for every segment of the immutable chunks in the StorageManager based on the data and on the
+ * workload, instead of applying one static ChunkEncodingSpec to everything.
+ *
+ * (1) While access recording is enabled, the SQLPipelineStatement passes every executed PQP to record_accesses(),
+ *     which counts how often each stored column is scanned or accessed at selected positions.
+ * (2) run() samples the data characteristics of each segment and estimates the memory usage and the access cost of
+ *     every encoding that supports the column's data type. The access cost uses rough per-row costs of each encoding
+ *     (e.g., RunLength is cheap to scan but expensive to access at random positions), weighted with the recorded
+ *     accesses. Each segment starts with its cheapest encoding. As long as the estimated memory usage of all segments
+ *     exceeds the memory budget, the segment whose next smaller encoding adds the least access cost per saved byte is
+ *     switched to that encoding. Segments of columns without recorded accesses start with their current encoding
+ *     instead, as there is no workload that would justify re-encoding them.
+ * (3) Segments whose chosen encoding differs from their current one are re-encoded by ChunkCompressionTasks.
+ *
+ * The decisions of the last run are available in the meta table "encoding_decisions".
+ */
+class EncodingAdvisor : public Noncopyable {
+ public:
+  // Blocks of this many consecutive rows are sampled so that runs and value ranges of the segment are preserved
+  static constexpr auto SAMPLE_BLOCK_SIZE = size_t{2'048};
+  static constexpr auto SAMPLE_BLOCK_COUNT = size_t{4};
+
+  void set_access_recording_enabled(const bool enabled);
+  bool access_recording_enabled() const;
+
+  // Counts the accesses of @param pqp's operators to stored columns, if access recording is enabled
+  void record_accesses(const std::shared_ptr<const AbstractOperator>& pqp);
+  ColumnAccesses column_accesses(const std::string& table_name, const ColumnID column_id) const;
+  void reset_accesses();
+
+  // If no budget is set, each segment is encoded with the encoding that is cheapest to access
+  void set_memory_budget(const std::optional<size_t>& memory_budget);
+  std::optional<size_t> memory_budget() const;
+
+  // Chooses the encodings of all segments of immutable chunks and re-encodes the segments accordingly
+  void run();
+
+  std::vector<SegmentEncodingDecision> decisions() const;
+
+  static SegmentCharacteristics sample_segment(const std::shared_ptr<const BaseSegment>& segment,
+                                               const DataType data_type);
+
+  // Returns one candidate for each encoding that supports @param data_type
+  static std::vector<SegmentEncodingCandidate> estimate_candidates(const SegmentCharacteristics& characteristics,
+                                                                   const DataType data_type,
+                                                                   const ColumnAccesses& column_accesses);
+
+  // Returns the index of the chosen candidate for each segment. Segments start with their cheapest candidate, or with
+  // @param initial_candidates[segment_index] if it is set.
+  static std::vector<size_t> choose_candidates(const std::vector<std::vector<SegmentEncodingCandidate>>& candidates,
+                                               const std::optional<size_t>& memory_budget,
+                                               const std::vector<std::optional<size_t>>& initial_candidates = {});
+
+ protected:
+  friend class Hyrise;
+
+  EncodingAdvisor() = default;
+  EncodingAdvisor& operator=(EncodingAdvisor&& encoding_advisor) noexcept;
+
+  std::atomic_bool _access_recording_enabled{false};
+
+  mutable std::mutex _mutex;
+  std::map<std::pair<std::string, ColumnID>, ColumnAccesses> _column_accesses;
+  std::optional<size_t> _memory_budget;
+  std::vector<SegmentEncodingDecision> _decisions;
+};
+
+}  // namespace opossum
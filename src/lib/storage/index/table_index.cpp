@@ -0,0 +1,257 @@
+#include "table_index.hpp"
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/chunk.hpp"
+#include "storage/segment_access_counter.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+/**
+ * Appends @param value to @param key so that comparing two keys byte by byte (as std::string does, with unsigned
+ * chars) gives the order of their values:
+ *  - Integers are stored big-endian with the sign bit flipped, so that negative values come first.
+ *  - Floating-point values are stored big-endian with the sign bit flipped if they are positive and with all bits
+ *    flipped if they are negative, so that larger negative values come first. -0.0 is stored as 0.0.
+ *  - Strings are terminated by two zero bytes, and zero bytes within them are escaped as 0x00 0xFF. Thus, a string
+ *    comes before all strings that it is a prefix of, and the key of the following column starts at a defined offset.
+ */
+template <typename T>
+void append_normalized_value(std::string& key, const T& value) {
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    for (const auto character : value) {
+      key += character;
+      if (character == '\0') key += '\xFF';
+    }
+    key.append(2, '\0');
+  } else {
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    constexpr auto SIGN_BIT = Bits{1} << (sizeof(Bits) * 8 - 1);
+
+    auto bits = Bits{};
+    if constexpr (std::is_floating_point_v<T>) {
+      const auto normalized_value = value == T{0} ? T{0} : value;
+      std::memcpy(&bits, &normalized_value, sizeof(bits));
+      bits = (bits & SIGN_BIT) != 0 ? ~bits : bits | SIGN_BIT;
+    } else {
+      bits = static_cast<Bits>(value) ^ SIGN_BIT;
+    }
+
+    for (auto shift = static_cast<int>(sizeof(Bits) * 8) - 8; shift >= 0; shift -= 8) {
+      key += static_cast<char>(static_cast<uint8_t>(bits >> shift));
+    }
+  }
+}
+
+}  // namespace
+
+TableIndex::TableIndex(const std::vector<ColumnID>& column_ids, const std::vector<DataType>& data_types)
+    : _column_ids(column_ids), _data_types(data_types) {
+  Assert(!_column_ids.empty(), "TableIndex requires at least one column");
+  Assert(_column_ids.size() == _data_types.size(), "Expected one DataType per indexed column");
+}
+
+const std::vector<ColumnID>& TableIndex::column_ids() const { return _column_ids; }
+
+void TableIndex::insert(const Chunk& chunk, const ChunkID chunk_id, const ChunkOffset begin_chunk_offset,
+                        const ChunkOffset end_chunk_offset) {
+  auto keys = _materialize_keys(chunk, begin_chunk_offset, end_chunk_offset);
+
+  std::lock_guard lock(_pending_entries_mutex);
+  for (auto key_index = size_t{0}; key_index < keys.size(); ++key_index) {
+    if (!keys[key_index]) continue;
+
+    const auto chunk_offset = static_cast<ChunkOffset>(begin_chunk_offset + key_index);
+    _pending_entries.emplace_back(std::move(*keys[key_index]), RowID{chunk_id, chunk_offset});
+  }
+  _has_pending_entries = !_pending_entries.empty();
+}
+
+void TableIndex::remove(const Chunk& chunk, const ChunkID chunk_id) {
+  auto keys = _materialize_keys(chunk, ChunkOffset{0}, chunk.size());
+
+  _merge_pending_entries();
+
+  std::unique_lock lock(_mutex);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < keys.size(); ++chunk_offset) {
+    if (!keys[chunk_offset]) continue;
+
+    _entries.erase(Entry{std::move(*keys[chunk_offset]), RowID{chunk_id, chunk_offset}});
+  }
+}
+
+PosList TableIndex::lookup(const PredicateCondition predicate_condition, const std::vector<AllTypeVariant>& values,
+                           const std::vector<AllTypeVariant>& values2) const {
+  const auto is_between = is_between_predicate_condition(predicate_condition);
+  Assert(values.size() == _column_ids.size(), "Expected one value per indexed column");
+  Assert(!is_between || values2.size() == _column_ids.size(), "Expected one upper bound per indexed column");
+
+  auto row_ids = PosList{};
+
+  for (auto column_index = size_t{0}; column_index < _column_ids.size(); ++column_index) {
+    if (variant_is_null(values[column_index]) || (is_between && variant_is_null(values2[column_index]))) {
+      return row_ids;
+    }
+
+    Assert(data_type_from_all_type_variant(values[column_index]) == _data_types[column_index] &&
+               (!is_between || data_type_from_all_type_variant(values2[column_index]) == _data_types[column_index]),
+           "Lookup value does not match the DataType of the indexed column");
+  }
+
+  const auto key = _normalize_values(values);
+  const auto key2 = is_between ? _normalize_values(values2) : Key{};
+
+  // Empty ranges, for which the lower bound of the range would be behind the upper bound
+  if (is_between && (key2 < key || (key2 == key && predicate_condition != PredicateCondition::BetweenInclusive))) {
+    return row_ids;
+  }
+
+  _merge_pending_entries();
+
+  std::shared_lock lock(_mutex);
+
+  const auto append_range = [&](const auto range_begin, const auto range_end) {
+    for (auto iter = range_begin; iter != range_end; ++iter) {
+      row_ids.emplace_back(iter->second);
+    }
+  };
+
+  switch (predicate_condition) {
+    case PredicateCondition::Equals:
+      append_range(_entries.lower_bound(key), _entries.upper_bound(key));
+      break;
+    case PredicateCondition::NotEquals:
+      append_range(_entries.cbegin(), _entries.lower_bound(key));
+      append_range(_entries.upper_bound(key), _entries.cend());
+      break;
+    case PredicateCondition::LessThan:
+      append_range(_entries.cbegin(), _entries.lower_bound(key));
+      break;
+    case PredicateCondition::LessThanEquals:
+      append_range(_entries.cbegin(), _entries.upper_bound(key));
+      break;
+    case PredicateCondition::GreaterThan:
+      append_range(_entries.upper_bound(key), _entries.cend());
+      break;
+    case PredicateCondition::GreaterThanEquals:
+      append_range(_entries.lower_bound(key), _entries.cend());
+      break;
+    case PredicateCondition::BetweenInclusive:
+      append_range(_entries.lower_bound(key), _entries.upper_bound(key2));
+      break;
+    case PredicateCondition::BetweenLowerExclusive:
+      append_range(_entries.upper_bound(key), _entries.upper_bound(key2));
+      break;
+    case PredicateCondition::BetweenUpperExclusive:
+      append_range(_entries.lower_bound(key), _entries.lower_bound(key2));
+      break;
+    case PredicateCondition::BetweenExclusive:
+      append_range(_entries.upper_bound(key), _entries.lower_bound(key2));
+      break;
+    default:
+      Fail("Unsupported comparison type encountered");
+  }
+
+  return row_ids;
+}
+
+size_t TableIndex::size() const {
+  _merge_pending_entries();
+
+  std::shared_lock lock(_mutex);
+  return _entries.size();
+}
+
+TableIndex::Key TableIndex::_normalize_values(const std::vector<AllTypeVariant>& values) const {
+  auto key = Key{};
+  for (auto column_index = size_t{0}; column_index < _column_ids.size(); ++column_index) {
+    resolve_data_type(_data_types[column_index], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      append_normalized_value(key, boost::get<ColumnDataType>(values[column_index]));
+    });
+  }
+  return key;
+}
+
+void TableIndex::_merge_pending_entries() const {
+  if (!_has_pending_entries) return;
+
+  // The pending entries are taken while holding the exclusive lock on the set. Thus, a lookup that does not find any
+  // pending entries anymore cannot acquire its shared lock before they were merged.
+  std::unique_lock lock(_mutex);
+
+  auto pending_entries = std::vector<Entry>{};
+  {
+    std::lock_guard pending_entries_lock(_pending_entries_mutex);
+    pending_entries.swap(_pending_entries);
+    _has_pending_entries = false;
+  }
+
+  for (auto& entry : pending_entries) {
+    _entries.emplace(std::move(entry));
+  }
+}
+
+std::vector<std::optional<TableIndex::Key>> TableIndex::_materialize_keys(const Chunk& chunk,
+                                                                          const ChunkOffset begin_chunk_offset,
+                                                                          const ChunkOffset end_chunk_offset) const {
+  DebugAssert(begin_chunk_offset <= end_chunk_offset && end_chunk_offset <= chunk.size(), "Invalid row range");
+
+  auto keys = std::vector<std::optional<Key>>(end_chunk_offset - begin_chunk_offset, Key{});
+
+  for (auto column_index = size_t{0}; column_index < _column_ids.size(); ++column_index) {
+    const auto segment = chunk.get_segment(_column_ids[column_index]);
+
+    resolve_data_type(_data_types[column_index], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      const auto set_value = [&](const ChunkOffset chunk_offset, const bool is_null, const ColumnDataType& value) {
+        auto& key = keys[chunk_offset - begin_chunk_offset];
+        if (!key) return;
+
+        if (is_null) {
+          key.reset();
+        } else {
+          append_normalized_value(*key, value);
+        }
+      };
+
+      if (const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<ColumnDataType>>(segment)) {
+        // Fast path for the mutable chunks that Insert writes to, which would otherwise be iterated entirely for each
+        // inserted row range
+        const auto& values = value_segment->values();
+        for (auto chunk_offset = begin_chunk_offset; chunk_offset < end_chunk_offset; ++chunk_offset) {
+          set_value(chunk_offset, value_segment->is_nullable() && value_segment->null_values()[chunk_offset],
+                    values[chunk_offset]);
+        }
+        return;
+      }
+
+      // Reading the segment to maintain the index is not an access of the workload
+      const auto uncounted_scope = SegmentAccessCounter::UncountedScope{};
+      segment_iterate<ColumnDataType>(*segment, [&](const auto& position) {
+        const auto chunk_offset = position.chunk_offset();
+        if (chunk_offset < begin_chunk_offset || chunk_offset >= end_chunk_offset) return;
+
+        set_value(chunk_offset, position.is_null(), position.value());
+      });
+    });
+  }
+
+  return keys;
+}
+
+}  // namespace opossum
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "storage/pos_list.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+
+/**
+ * A TableIndex maps the values of one or more columns to the RowIDs of all chunks of a table. While the chunk-local
+ * indexes (see AbstractIndex) have to be searched once per chunk, a TableIndex answers a lookup with a single search in
+ * O(log n), independent of the number of chunks.
+ *
+ * Like AbstractIndex, a TableIndex is a composite index: Keys are compared by their first column and, if and only if
+ * these values are equal, by the following columns. Rows with a NULL value in one of the indexed columns are not
+ * indexed, as they never satisfy a predicate.
+ *
+ * The Table maintains its TableIndexes when rows are added (by Insert, Table::append(), and Table::append_chunk()) and
+ * when chunks are physically removed. Deleted rows are not removed from the index: Under MVCC, a deleted row stays in
+ * its chunk until the chunk is removed, and an Update is a Delete of the old row followed by an Insert of the new one.
+ * Lookups thus return all rows with a matching key, and Validate filters those that are not visible to a transaction.
+ *
+ * Keys are stored as normalized byte strings, whose lexicographical order is the order of the values (see
+ * append_normalized_value() in table_index.cpp). The index is an ordered set of (key, RowID) entries, so that the
+ * entry of a single row is found in O(log n) when its chunk is removed.
+ *
+ * Lookups hold a shared lock on the set. Rows added by Insert are first appended to a buffer of pending entries under a
+ * short-lived lock and only merged into the set by the next lookup, so that concurrent Inserts do not serialize on the
+ * set and its rebalancing.
+ */
+class TableIndex : private Noncopyable {
+ public:
+  // @param data_types are the DataTypes of the indexed columns, in the order of @param column_ids
+  TableIndex(const std::vector<ColumnID>& column_ids, const std::vector<DataType>& data_types);
+
+  const std::vector<ColumnID>& column_ids() const;
+
+  // Adds the rows of @param chunk from @param begin_chunk_offset (inclusive) to @param end_chunk_offset (exclusive)
+  void insert(const Chunk& chunk, const ChunkID chunk_id, const ChunkOffset begin_chunk_offset,
+              const ChunkOffset end_chunk_offset);
+
+  // Removes all rows of @param chunk, e.g., when the chunk is physically deleted
+  void remove(const Chunk& chunk, const ChunkID chunk_id);
+
+  /**
+   * Returns the RowIDs of all rows whose key satisfies the predicate `key <predicate_condition> values` (for BETWEEN
+   * predicates: `key BETWEEN values AND values2`), ordered by their keys. As for the chunk-local indexes, the values
+   * have to be of the DataTypes of the indexed columns.
+   */
+  PosList lookup(const PredicateCondition predicate_condition, const std::vector<AllTypeVariant>& values,
+                 const std::vector<AllTypeVariant>& values2 = {}) const;
+
+  // Number of indexed rows
+  size_t size() const;
+
+ protected:
+  using Key = std::string;
+  using Entry = std::pair<Key, RowID>;
+
+  // Orders entries by their key and then by their RowID. Transparent, so that the entries of a key can be searched by
+  // the key alone.
+  struct EntryLess {
+    using is_transparent = void;
+
+    bool operator()(const Entry& lhs, const Entry& rhs) const { return lhs < rhs; }
+    bool operator()(const Entry& lhs, const Key& rhs) const { return lhs.first < rhs; }
+    bool operator()(const Key& lhs, const Entry& rhs) const { return lhs < rhs.first; }
+  };
+
+  // Returns the keys of the rows from @param begin_chunk_offset to @param end_chunk_offset, nullopt for rows with NULLs
+  std::vector<std::optional<Key>> _materialize_keys(const Chunk& chunk, const ChunkOffset begin_chunk_offset,
+                                                    const ChunkOffset end_chunk_offset) const;
+
+  // Returns the key of the lookup @param values, which have to be of the DataTypes of the indexed columns
+  Key _normalize_values(const std::vector<AllTypeVariant>& values) const;
+
+  // Moves the pending entries of Inserts into _entries
+  void _merge_pending_entries() const;
+
+  const std::vector<ColumnID> _column_ids;
+  const std::vector<DataType> _data_types;
+
+  // Mutable, as the pending entries are merged by the (const) lookups
+  mutable std::shared_mutex _mutex;
+  mutable std::set<Entry, EntryLess> _entries;
+
+  mutable std::mutex _pending_entries_mutex;
+  mutable std::vector<Entry> _pending_entries;
+  mutable std::atomic_bool _has_pending_entries{false};
+};
+
+}  // namespace opossum
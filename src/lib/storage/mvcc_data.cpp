@@ -4,6 +4,24 @@
 
 #include "utils/assert.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+template <typename T>
+bool is_contiguous(const pmr_concurrent_vector<T>& vector) {
+  if (vector.empty()) return false;
+
+  const auto* first_element = &vector[0];
+  const auto size = vector.size();
+  for (auto index = size_t{1}; index < size; ++index) {
+    if (&vector[index] != first_element + index) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 namespace opossum {
 
 MvccData::MvccData(const size_t size, CommitID begin_commit_id) {
@@ -25,10 +43,23 @@ void MvccData::shrink() {
   tids.shrink_to_fit();
   begin_cids.shrink_to_fit();
   end_cids.shrink_to_fit();
+
+  // Reading the TIDs through a plain pointer requires the atomics to be nothing but the plain value
+  static_assert(sizeof(decltype(tids)::value_type) == sizeof(TransactionID));
+  static_assert(std::atomic<TransactionID>::is_always_lock_free);
+
+  _contiguous_columns.reset();
+  if (is_contiguous(tids) && is_contiguous(begin_cids) && is_contiguous(end_cids)) {
+    _contiguous_columns = ContiguousColumns{reinterpret_cast<const TransactionID*>(&tids[0]), &begin_cids[0],
+                                            &end_cids[0]};
+  }
 }
 
+const std::optional<MvccData::ContiguousColumns>& MvccData::contiguous_columns() const { return _contiguous_columns; }
+
 void MvccData::grow_by(size_t delta, TransactionID transaction_id, CommitID begin_commit_id) {
   _size += delta;
+  _contiguous_columns.reset();
   tids.grow_to_at_least(_size);
 
   for (auto chunk_offset = _size - delta; chunk_offset < _size; ++chunk_offset) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <optional>
 #include <shared_mutex>  // NOLINT lint thinks this is a C header or something
 
 #include "types.hpp"
@@ -32,6 +33,13 @@ struct MvccData {
   // Validate::_on_execute for further details.
   std::optional<CommitID> max_begin_cid;
 
+  // Raw pointers to the MVCC vectors, see contiguous_columns()
+  struct ContiguousColumns {
+    const TransactionID* tids;
+    const CommitID* begin_cids;
+    const CommitID* end_cids;
+  };
+
   explicit MvccData(const size_t size, CommitID begin_commit_id);
 
   size_t size() const;
@@ -43,7 +51,17 @@ struct MvccData {
   void shrink();
 
   /**
-   * Grows mvcc data by the given delta. The caller should guard this using the table's append_mutex.
+   * tbb::concurrent_vector stores its elements in multiple segments, which keeps the compiler from vectorizing loops
+   * over them. Once shrink() has merged all three vectors into single blocks of memory (which it does for finalized
+   * chunks), this returns pointers to these blocks so that Validate can check the visibility of multiple rows at once.
+   * Otherwise, std::nullopt is returned. Values read through these pointers are not synchronized, the same reasoning
+   * as for get_begin_cid() etc. applies.
+   */
+  const std::optional<ContiguousColumns>& contiguous_columns() const;
+
+  /**
+   * Grows mvcc data by the given delta. Concurrent Inserts grow a chunk one after another (see Chunk::reserve_rows()),
+   * other callers should guard this using the table's append_mutex.
    */
   void grow_by(size_t delta, TransactionID transaction_id, CommitID begin_commit_id);
 
@@ -70,9 +88,12 @@ struct MvccData {
   std::shared_mutex _mutex;
 
   /**
-   * This does not need to be atomic, as appends to a chunk's MvccData are guarded by the table's append_mutex.
+   * This does not need to be atomic, as appends to a chunk's MvccData do not happen concurrently (see grow_by()).
    */
   size_t _size{0};
+
+  // Set by shrink() if the vectors are contiguous, reset once they grow
+  std::optional<ContiguousColumns> _contiguous_columns;
 };
 
 std::ostream& operator<<(std::ostream& stream, const MvccData& mvcc_data);
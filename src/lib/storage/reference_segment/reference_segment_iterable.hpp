@@ -214,7 +214,7 @@ class ReferenceSegmentIterable : public SegmentIterable<ReferenceSegmentIterable
 
     void _create_accessor(const ChunkID chunk_id) const {
       auto segment = _referenced_table->get_chunk(chunk_id)->get_segment(_referenced_column_id);
-      auto accessor = std::move(create_segment_accessor<T>(segment));
+      auto accessor = std::move(create_segment_accessor<T>(segment, SegmentAccessCounter::AccessType::Random));
       (*_accessors)[chunk_id] = std::move(accessor);
     }
 
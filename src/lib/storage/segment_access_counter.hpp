@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace opossum {
+
+/**
+ * Counts the values that were read from a segment, broken down by the way they were read. Together with the meta table
+ * "segments_accesses", this shows which parts of the data the workload actually uses (hot/cold data analysis).
+ *
+ * To keep the overhead small enough for the counters to remain enabled, they are not incremented for every value.
+ * Iterables add the number of values they iterate over once per call of with_iterators(), and SegmentAccessors sum up
+ * their accesses locally and add them when they are destroyed. The counters are relaxed atomics, as concurrent
+ * operators may access the same segment and exact ordering between the counters is not needed.
+ *
+ * Reads that are not part of the workload, e.g., encoding or sampling a segment, are made within an UncountedScope.
+ */
+class SegmentAccessCounter {
+ public:
+  enum class AccessType {
+    Sequential,  // All values are iterated in order, e.g., by a TableScan on a data table
+    Random,      // The values at the positions of a PosList are read, e.g., when a ReferenceSegment is iterated
+    Point,       // Individual values are read through a SegmentAccessor, e.g., by the ExpressionEvaluator
+    Count        // Number of access types, not an access type itself
+  };
+
+  // While an instance exists, accesses of the current thread are not counted
+  class UncountedScope {
+   public:
+    UncountedScope() { ++_uncounted_scope_count; }
+    ~UncountedScope() { --_uncounted_scope_count; }
+
+    UncountedScope(const UncountedScope&) = delete;
+    UncountedScope& operator=(const UncountedScope&) = delete;
+  };
+
+  void increment(const AccessType access_type, const uint64_t count) {
+    if (_uncounted_scope_count > 0) return;
+    _counters[static_cast<size_t>(access_type)].fetch_add(count, std::memory_order_relaxed);
+  }
+
+  uint64_t get(const AccessType access_type) const {
+    return _counters[static_cast<size_t>(access_type)].load(std::memory_order_relaxed);
+  }
+
+  // Takes over the accesses of @param other, e.g., when a segment is replaced by its encoded version. They were
+  // counted before, so they are added even within an UncountedScope.
+  void add(const SegmentAccessCounter& other) {
+    for (auto access_type_index = size_t{0}; access_type_index < _counters.size(); ++access_type_index) {
+      _counters[access_type_index].fetch_add(other._counters[access_type_index].load(std::memory_order_relaxed),
+                                             std::memory_order_relaxed);
+    }
+  }
+
+  void reset() {
+    for (auto& counter : _counters) {
+      counter.store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  inline static thread_local uint32_t _uncounted_scope_count = 0;
+
+  std::array<std::atomic<uint64_t>, static_cast<size_t>(AccessType::Count)> _counters{};
+};
+
+}  // namespace opossum
@@ -5,7 +5,7 @@
 namespace opossum::detail {
 template <typename T>
 std::unique_ptr<AbstractSegmentAccessor<T>> CreateSegmentAccessor<T>::create(
-    const std::shared_ptr<const BaseSegment>& segment) {
+    const std::shared_ptr<const BaseSegment>& segment, const SegmentAccessCounter::AccessType access_type) {
   std::unique_ptr<AbstractSegmentAccessor<T>> accessor;
   resolve_segment_type<T>(*segment, [&](const auto& typed_segment) {
     using SegmentType = std::decay_t<decltype(typed_segment)>;
@@ -40,7 +40,7 @@ std::unique_ptr<AbstractSegmentAccessor<T>> CreateSegmentAccessor<T>::create(
         accessor = std::make_unique<MultipleChunkReferenceSegmentAccessor<T>>(typed_segment);
       }
     } else {
-      accessor = std::make_unique<SegmentAccessor<T, SegmentType>>(typed_segment);
+      accessor = std::make_unique<SegmentAccessor<T, SegmentType>>(typed_segment, access_type);
     }
   });
   return accessor;
@@ -6,6 +6,7 @@
 
 #include "storage/base_segment_accessor.hpp"
 #include "storage/dictionary_segment.hpp"
+#include "storage/segment_access_counter.hpp"
 #include "types.hpp"
 #include "utils/performance_warning.hpp"
 
@@ -18,17 +19,22 @@ namespace detail {
 template <typename T>
 class CreateSegmentAccessor {
  public:
-  static std::unique_ptr<AbstractSegmentAccessor<T>> create(const std::shared_ptr<const BaseSegment>& segment);
+  static std::unique_ptr<AbstractSegmentAccessor<T>> create(const std::shared_ptr<const BaseSegment>& segment,
+                                                            const SegmentAccessCounter::AccessType access_type);
 };
 
 }  // namespace detail
 
 /**
- * Utility method to create a SegmentAccessor for a given BaseSegment.
+ * Utility method to create a SegmentAccessor for a given BaseSegment. The accesses are counted as @param access_type
+ * in the segment's access counter. Accesses through ReferenceSegments are always counted as random accesses of the
+ * referenced segments.
  */
 template <typename T>
-std::unique_ptr<AbstractSegmentAccessor<T>> create_segment_accessor(const std::shared_ptr<const BaseSegment>& segment) {
-  return opossum::detail::CreateSegmentAccessor<T>::create(segment);
+std::unique_ptr<AbstractSegmentAccessor<T>> create_segment_accessor(
+    const std::shared_ptr<const BaseSegment>& segment,
+    const SegmentAccessCounter::AccessType access_type = SegmentAccessCounter::AccessType::Point) {
+  return opossum::detail::CreateSegmentAccessor<T>::create(segment, access_type);
 }
 
 /**
@@ -38,17 +44,27 @@ std::unique_ptr<AbstractSegmentAccessor<T>> create_segment_accessor(const std::s
  *   std::optional<T> get_typed_value(const ChunkOffset chunk_offset) const;
  *
  * Accessors are not guaranteed to be thread-safe. For multiple threads that access the same segment, create one
- * accessor each.
+ * accessor each. This also allows them to count their accesses locally and to add them to the segment's access
+ * counter only once, when they are destroyed.
  */
 template <typename T, typename SegmentType>
 class SegmentAccessor final : public AbstractSegmentAccessor<T> {
  public:
-  explicit SegmentAccessor(const SegmentType& segment) : AbstractSegmentAccessor<T>{}, _segment{segment} {}
+  explicit SegmentAccessor(const SegmentType& segment,
+                           const SegmentAccessCounter::AccessType access_type = SegmentAccessCounter::AccessType::Point)
+      : AbstractSegmentAccessor<T>{}, _segment{segment}, _access_type{access_type} {}
 
-  const std::optional<T> access(ChunkOffset offset) const final { return _segment.get_typed_value(offset); }
+  ~SegmentAccessor() override { _segment.access_counter.increment(_access_type, _access_count); }
+
+  const std::optional<T> access(ChunkOffset offset) const final {
+    ++_access_count;
+    return _segment.get_typed_value(offset);
+  }
 
  protected:
   const SegmentType& _segment;
+  const SegmentAccessCounter::AccessType _access_type;
+  mutable uint64_t _access_count{0};
 };
 
 /**
@@ -77,8 +93,9 @@ class MultipleChunkReferenceSegmentAccessor final : public AbstractSegmentAccess
     }
 
     if (!_accessors[chunk_id]) {
-      _accessors[chunk_id] =
-          create_segment_accessor<T>(_table->get_chunk(chunk_id)->get_segment(_segment.referenced_column_id()));
+      _accessors[chunk_id] = create_segment_accessor<T>(
+          _table->get_chunk(chunk_id)->get_segment(_segment.referenced_column_id()),
+          SegmentAccessCounter::AccessType::Random);
     }
 
     return _accessors[chunk_id]->access(row_id.chunk_offset);
@@ -98,7 +115,12 @@ class SingleChunkReferenceSegmentAccessor final : public AbstractSegmentAccessor
   explicit SingleChunkReferenceSegmentAccessor(const PosList& pos_list, const ChunkID chunk_id, const Segment& segment)
       : _pos_list{pos_list}, _chunk_id(chunk_id), _segment(segment) {}
 
+  ~SingleChunkReferenceSegmentAccessor() override {
+    _segment.access_counter.increment(SegmentAccessCounter::AccessType::Random, _access_count);
+  }
+
   const std::optional<T> access(ChunkOffset offset) const final {
+    ++_access_count;
     const auto referenced_chunk_offset = _pos_list[offset].chunk_offset;
     return _segment.get_typed_value(referenced_chunk_offset);
   }
@@ -107,6 +129,7 @@ class SingleChunkReferenceSegmentAccessor final : public AbstractSegmentAccessor
   const PosList& _pos_list;
   const ChunkID _chunk_id;
   const Segment& _segment;
+  mutable uint64_t _access_count{0};
 };
 
 // Accessor for ReferenceSegments that reference only NULL values
@@ -1,21 +1,173 @@
 #include "storage_manager.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "concurrency/transaction_context.hpp"
 #include "hyrise.hpp"
+#include "import_export/binary/binary_parser.hpp"
+#include "import_export/binary/binary_writer.hpp"
 #include "import_export/file_type.hpp"
 #include "logical_query_plan/abstract_lqp_node.hpp"
 #include "operators/export.hpp"
 #include "operators/table_wrapper.hpp"
+#include "resolve_type.hpp"
 #include "scheduler/job_task.hpp"
 #include "statistics/generate_pruning_statistics.hpp"
 #include "statistics/table_statistics.hpp"
+#include "storage/segment_iterate.hpp"
 #include "utils/assert.hpp"
 #include "utils/meta_table_manager.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// The manifest lists the tables of a checkpoint and the directory that holds their files. Every checkpoint writes its
+// files into a fresh directory, the previous checkpoint stays intact until the manifest is atomically replaced. Files
+// are named by the position of the table in the manifest, as table names might not be valid file names.
+constexpr auto CHECKPOINT_MANIFEST = "checkpoint.bin";
+constexpr auto CHECKPOINT_DATA_DIRECTORY_PREFIX = "data_";
+
+std::string checkpoint_table_filename(const std::string& path, const size_t table_index) {
+  return path + "/table_" + std::to_string(table_index) + ".bin";
+}
+
+std::string checkpoint_chunk_filename(const std::string& path, const size_t table_index, const ChunkID chunk_id) {
+  return path + "/table_" + std::to_string(table_index) + "_chunk_" + std::to_string(chunk_id) + ".bin";
+}
+
+// Flushes the file or directory @param path to the disk. For directories, this persists the entries of the files that
+// were created or renamed in it.
+void sync_checkpoint_path(const std::string& path) {
+  const auto file_descriptor = open(path.c_str(), O_RDONLY);
+  Assert(file_descriptor != -1, "Could not open " + path + ": " + std::strerror(errno));
+  const auto sync_result = fsync(file_descriptor);
+  Assert(sync_result == 0, "Could not sync " + path + ": " + std::strerror(errno));
+  close(file_descriptor);
+}
+
+template <typename T>
+void write_checkpoint_value(std::ofstream& ofstream, const T& value) {
+  ofstream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read_checkpoint_value(std::ifstream& ifstream) {
+  auto value = T{};
+  ifstream.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+/**
+ * Writes the chunk in the binary format, followed by
+ *
+ * Description           | Type                                  | Size in bytes
+ * -----------------------------------------------------------------------------------------
+ * Is mutable            | bool (stored as BoolAsByteType)       |   1
+ * Invalid row count     | ChunkOffset                           |   4
+ * Invalid rows          | ChunkOffset array                     |   Invalid row count * 4
+ */
+void write_checkpoint_chunk(const Table& table, const ChunkID chunk_id, const CommitID snapshot_commit_id,
+                            const std::string& filename) {
+  const auto chunk = table.get_chunk(chunk_id);
+  if (!chunk) return;
+
+  // Rows that are appended while the checkpoint is written are not part of the snapshot and are ignored
+  const auto is_mutable = chunk->is_mutable();
+  const auto row_count = chunk->size();
+
+  auto invalid_chunk_offsets = std::vector<ChunkOffset>{};
+  if (chunk->has_mvcc_data()) {
+    const auto mvcc_data = chunk->get_scoped_mvcc_data_lock();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+      const auto begin_cid = mvcc_data->get_begin_cid(chunk_offset);
+      const auto end_cid = mvcc_data->get_end_cid(chunk_offset);
+      if (begin_cid > snapshot_commit_id || end_cid <= snapshot_commit_id) {
+        invalid_chunk_offsets.emplace_back(chunk_offset);
+      }
+    }
+  }
+
+  // Take a snapshot of the segments, as the ChunkCompressionTask or the encoding advisor might replace them
+  // concurrently. Segments that might still grow (i.e., those of mutable chunks) or that already contain rows appended
+  // after row_count was read are cut to their first row_count values, no matter how they are encoded.
+  const auto column_count = table.column_count();
+  auto segments = Segments(column_count);
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    const auto segment = chunk->get_segment(column_id);
+    if (!is_mutable && segment->size() == row_count) {
+      segments[column_id] = segment;
+      continue;
+    }
+
+    const auto nullable = table.column_is_nullable(column_id);
+    resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      if (const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<ColumnDataType>>(segment)) {
+        const auto& values = value_segment->values();
+        auto values_prefix = pmr_concurrent_vector<ColumnDataType>(values.begin(), values.begin() + row_count);
+        if (nullable) {
+          const auto& null_values = value_segment->null_values();
+          auto null_values_prefix = pmr_concurrent_vector<bool>(null_values.begin(), null_values.begin() + row_count);
+          segments[column_id] = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values_prefix),
+                                                                               std::move(null_values_prefix));
+        } else {
+          segments[column_id] = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values_prefix));
+        }
+        return;
+      }
+
+      auto values = pmr_concurrent_vector<ColumnDataType>(row_count);
+      auto null_values = pmr_concurrent_vector<bool>(nullable ? row_count : ChunkOffset{0});
+      segment_iterate<ColumnDataType>(*segment, [&](const auto& position) {
+        const auto chunk_offset = position.chunk_offset();
+        if (chunk_offset >= row_count) return;
+
+        if (position.is_null()) {
+          null_values[chunk_offset] = true;
+        } else {
+          values[chunk_offset] = position.value();
+        }
+      });
+
+      if (nullable) {
+        segments[column_id] = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(null_values));
+      } else {
+        segments[column_id] = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values));
+      }
+    });
+  }
+
+  auto snapshot_table = Table{table.column_definitions(), TableType::Data, table.max_chunk_size(), UseMvcc::No};
+  snapshot_table.append_chunk(segments);
+
+  auto ofstream = std::ofstream{};
+  ofstream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+  ofstream.open(filename, std::ios::binary);
+
+  BinaryWriter::write_chunk(snapshot_table, ChunkID{0}, ofstream);
+
+  write_checkpoint_value(ofstream, static_cast<BoolAsByteType>(is_mutable));
+  write_checkpoint_value(ofstream, static_cast<ChunkOffset>(invalid_chunk_offsets.size()));
+  ofstream.write(reinterpret_cast<const char*>(invalid_chunk_offsets.data()),
+                 invalid_chunk_offsets.size() * sizeof(ChunkOffset));
+
+  ofstream.close();
+  sync_checkpoint_path(filename);
+}
+
+}  // namespace
+
 namespace opossum {
 
 void StorageManager::add_table(const std::string& name, std::shared_ptr<Table> table) {
@@ -26,16 +178,37 @@ void StorageManager::add_table(const std::string& name, std::shared_ptr<Table> t
     // We currently assume that all tables stored in the StorageManager are mutable and, as such, have MVCC data. This
     // way, we do not need to check query plans if they try to update immutable tables. However, this is not a hard
     // limitation and might be changed into more fine-grained assertions if the need arises.
-    Assert(table->get_chunk(chunk_id)->has_mvcc_data(), "Table must have MVCC data.");
+    const auto chunk = table->get_chunk(chunk_id);
+    Assert(!chunk || chunk->has_mvcc_data(), "Table must have MVCC data.");
   }
 
+  if (Hyrise::get().redo_log.is_enabled()) Hyrise::get().redo_log.log_add_table(name, *table);
+
   table->set_table_statistics(TableStatistics::from_table(*table));
+
+  // Loading the table and generating its statistics are not part of the workload, so the segments' access counters
+  // start at zero
+  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); chunk_id++) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    for (ColumnID column_id{0}; column_id < table->column_count(); column_id++) {
+      chunk->get_segment(column_id)->access_counter.reset();
+    }
+  }
+
+  _table_names.emplace(table.get(), name);
   _tables.emplace(name, std::move(table));
 }
 
 void StorageManager::drop_table(const std::string& name) {
+  const auto iter = _tables.find(name);
+  if (iter != _tables.end()) _table_names.erase(iter->second.get());
+
   const auto num_deleted = _tables.erase(name);
   Assert(num_deleted == 1, "Error deleting table " + name + ": _erase() returned " + std::to_string(num_deleted) + ".");
+
+  if (Hyrise::get().redo_log.is_enabled()) Hyrise::get().redo_log.log_drop_table(name);
 }
 
 std::shared_ptr<Table> StorageManager::get_table(const std::string& name) const {
@@ -71,6 +244,12 @@ std::vector<std::string> StorageManager::table_names() const {
 
 const std::map<std::string, std::shared_ptr<Table>>& StorageManager::tables() const { return _tables; }
 
+std::optional<std::string> StorageManager::find_table_name(const Table& table) const {
+  const auto iter = _table_names.find(&table);
+  if (iter == _table_names.end()) return std::nullopt;
+  return iter->second;
+}
+
 void StorageManager::add_view(const std::string& name, const std::shared_ptr<LQPView>& view) {
   std::unique_lock lock(*_view_mutex);
 
@@ -169,6 +348,195 @@ void StorageManager::export_all_tables_as_csv(const std::string& path) {
   Hyrise::get().scheduler()->wait_for_tasks(tasks);
 }
 
+CommitID StorageManager::write_checkpoint(const std::string& path) const {
+  std::filesystem::create_directories(path);
+
+  // The transaction context registers its snapshot with the TransactionManager until the checkpoint is written. This
+  // way, no rows visible in the snapshot are cleaned up in the meantime.
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context();
+  const auto snapshot_commit_id = transaction_context->snapshot_commit_id();
+
+  // Multiple checkpoints can have the same snapshot, so the name of a data directory is not necessarily free
+  auto data_directory_name = CHECKPOINT_DATA_DIRECTORY_PREFIX + std::to_string(snapshot_commit_id);
+  for (auto suffix = size_t{1}; std::filesystem::exists(path + "/" + data_directory_name); ++suffix) {
+    data_directory_name = CHECKPOINT_DATA_DIRECTORY_PREFIX + std::to_string(snapshot_commit_id) + "_" +
+                          std::to_string(suffix);
+  }
+  const auto data_path = path + "/" + data_directory_name;
+  std::filesystem::create_directory(data_path);
+
+  const auto manifest_filename = path + "/" + CHECKPOINT_MANIFEST;
+  auto manifest = std::ofstream{};
+  manifest.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+  manifest.open(manifest_filename + ".tmp", std::ios::binary);
+  write_checkpoint_value(manifest, snapshot_commit_id);
+  write_checkpoint_value(manifest, data_directory_name.size());
+  manifest.write(data_directory_name.data(), static_cast<std::streamsize>(data_directory_name.size()));
+  write_checkpoint_value(manifest, _tables.size());
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  auto table_index = size_t{0};
+  for (const auto& [name, table] : _tables) {
+    // All rows visible in the snapshot are stored in chunks that already exist at this point
+    const auto chunk_count = table->chunk_count();
+
+    write_checkpoint_value(manifest, name.size());
+    manifest.write(name.data(), static_cast<std::streamsize>(name.size()));
+    write_checkpoint_value(manifest, static_cast<ChunkID::base_type>(chunk_count));
+
+    // The schema is stored as an empty table
+    const auto table_filename = checkpoint_table_filename(data_path, table_index);
+    BinaryWriter::write(Table{table->column_definitions(), TableType::Data, table->max_chunk_size(), UseMvcc::Yes},
+                        table_filename);
+    sync_checkpoint_path(table_filename);
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, table = table, table_index, chunk_id]() {
+        write_checkpoint_chunk(*table, chunk_id, snapshot_commit_id,
+                               checkpoint_chunk_filename(data_path, table_index, chunk_id));
+      }));
+      jobs.back()->schedule();
+    }
+    ++table_index;
+  }
+
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+  sync_checkpoint_path(data_path);
+
+  // Only once all files are on the disk, the new manifest replaces the previous one
+  manifest.close();
+  sync_checkpoint_path(manifest_filename + ".tmp");
+  std::filesystem::rename(manifest_filename + ".tmp", manifest_filename);
+  sync_checkpoint_path(path);
+
+  // The data directories of previous checkpoints are not referenced anymore
+  for (const auto& entry : std::filesystem::directory_iterator{path}) {
+    const auto filename = entry.path().filename().string();
+    if (entry.is_directory() && filename != data_directory_name &&
+        filename.rfind(CHECKPOINT_DATA_DIRECTORY_PREFIX, 0) == 0) {
+      std::filesystem::remove_all(entry.path());
+    }
+  }
+
+  // The transaction did not modify anything, so committing it only deregisters the snapshot
+  transaction_context->commit();
+
+  return snapshot_commit_id;
+}
+
+void StorageManager::load_checkpoint(const std::string& path) {
+  auto manifest = std::ifstream{};
+  manifest.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+  manifest.open(path + "/" + CHECKPOINT_MANIFEST, std::ios::binary);
+
+  read_checkpoint_value<CommitID>(manifest);
+  auto data_directory_name = std::string(read_checkpoint_value<size_t>(manifest), '\0');
+  manifest.read(data_directory_name.data(), static_cast<std::streamsize>(data_directory_name.size()));
+  const auto data_path = path + "/" + data_directory_name;
+  const auto table_count = read_checkpoint_value<size_t>(manifest);
+
+  struct LoadedChunk {
+    Segments segments;
+    std::shared_ptr<MvccData> mvcc_data;
+    bool is_mutable{true};
+    ChunkOffset invalid_row_count{0};
+  };
+
+  auto table_names = std::vector<std::string>(table_count);
+  auto tables = std::vector<std::shared_ptr<Table>>(table_count);
+  auto loaded_chunks = std::vector<std::vector<LoadedChunk>>(table_count);
+
+  // Phase 1: Read all chunks in parallel
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto table_index = size_t{0}; table_index < table_count; ++table_index) {
+    auto& table_name = table_names[table_index];
+    table_name.resize(read_checkpoint_value<size_t>(manifest));
+    manifest.read(table_name.data(), static_cast<std::streamsize>(table_name.size()));
+    const auto chunk_count = ChunkID{read_checkpoint_value<ChunkID::base_type>(manifest)};
+
+    tables[table_index] = BinaryParser::parse(checkpoint_table_filename(data_path, table_index));
+    loaded_chunks[table_index].resize(chunk_count);
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, table_index, chunk_id]() {
+        // Chunks that had been physically deleted are not part of the checkpoint
+        const auto filename = checkpoint_chunk_filename(data_path, table_index, chunk_id);
+        if (!std::filesystem::exists(filename)) return;
+
+        auto file = std::ifstream{};
+        file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        file.open(filename, std::ios::binary);
+
+        auto& loaded_chunk = loaded_chunks[table_index][chunk_id];
+        auto [segments, row_count] = BinaryParser::read_chunk(file, *tables[table_index]);
+        loaded_chunk.segments = std::move(segments);
+        loaded_chunk.mvcc_data = std::make_shared<MvccData>(row_count, CommitID{0});
+        loaded_chunk.is_mutable = read_checkpoint_value<BoolAsByteType>(file);
+        loaded_chunk.invalid_row_count = read_checkpoint_value<ChunkOffset>(file);
+
+        auto invalid_chunk_offsets = std::vector<ChunkOffset>(loaded_chunk.invalid_row_count);
+        file.read(reinterpret_cast<char*>(invalid_chunk_offsets.data()),
+                  static_cast<std::streamsize>(invalid_chunk_offsets.size() * sizeof(ChunkOffset)));
+        for (const auto chunk_offset : invalid_chunk_offsets) {
+          loaded_chunk.mvcc_data->set_end_cid(chunk_offset, CommitID{0});
+        }
+      }));
+      jobs.back()->schedule();
+    }
+  }
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+
+  // Phase 2: Append the chunks to their tables, which is not thread-safe. Chunks that had been physically deleted are
+  // replaced by deleted placeholders, so that the ChunkIDs of all other chunks stay the same. Otherwise, the RowIDs in
+  // the redo log that is replayed on top of the checkpoint would point to the wrong rows.
+  for (auto table_index = size_t{0}; table_index < table_count; ++table_index) {
+    const auto& table = tables[table_index];
+    for (auto& loaded_chunk : loaded_chunks[table_index]) {
+      if (loaded_chunk.mvcc_data) {
+        table->append_chunk(loaded_chunk.segments, loaded_chunk.mvcc_data);
+        continue;
+      }
+
+      auto empty_segments = Segments{};
+      const auto column_count = table->column_count();
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        resolve_data_type(table->column_data_type(column_id), [&](auto type) {
+          using ColumnDataType = typename decltype(type)::type;
+          empty_segments.emplace_back(
+              std::make_shared<ValueSegment<ColumnDataType>>(table->column_is_nullable(column_id)));
+        });
+      }
+      table->append_chunk(empty_segments, std::make_shared<MvccData>(0, CommitID{0}));
+      table->remove_chunk(ChunkID{table->chunk_count() - 1});
+    }
+  }
+
+  // Phase 3: Finalize the chunks in parallel. The encoded segments are used as they are.
+  jobs.clear();
+  for (auto table_index = size_t{0}; table_index < table_count; ++table_index) {
+    const auto& table = tables[table_index];
+    const auto chunk_count = table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto& loaded_chunk = loaded_chunks[table_index][chunk_id];
+      if (!loaded_chunk.mvcc_data) continue;
+
+      jobs.emplace_back(std::make_shared<JobTask>([chunk = table->get_chunk(chunk_id), &loaded_chunk]() {
+        chunk->increase_invalid_row_count(loaded_chunk.invalid_row_count);
+        if (loaded_chunk.is_mutable || chunk->size() == 0) return;
+
+        chunk->finalize();
+        generate_chunk_pruning_statistics(chunk);
+      }));
+      jobs.back()->schedule();
+    }
+  }
+  Hyrise::get().scheduler()->wait_for_tasks(jobs);
+
+  for (auto table_index = size_t{0}; table_index < table_count; ++table_index) {
+    add_table(table_names[table_index], tables[table_index]);
+  }
+}
+
 std::ostream& operator<<(std::ostream& stream, const StorageManager& storage_manager) {
   stream << "==================" << std::endl;
   stream << "===== Tables =====" << std::endl << std::endl;
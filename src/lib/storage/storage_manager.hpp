@@ -3,8 +3,10 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "lqp_view.hpp"
@@ -30,6 +32,10 @@ class StorageManager : public Noncopyable {
   bool has_table(const std::string& name) const;
   std::vector<std::string> table_names() const;
   const std::map<std::string, std::shared_ptr<Table>>& tables() const;
+
+  // Returns the name under which @param table is stored, or std::nullopt if it is not part of the StorageManager. Takes
+  // constant time, e.g., for operators that only know the tables that their inputs reference.
+  std::optional<std::string> find_table_name(const Table& table) const;
   /** @} */
 
   /**
@@ -58,12 +64,29 @@ class StorageManager : public Noncopyable {
   // For debugging purposes mostly, dump all tables as csv
   void export_all_tables_as_csv(const std::string& path);
 
+  /**
+   * Writes a checkpoint of all tables into the directory @param path, which is created if necessary. The checkpoint is
+   * transactionally consistent: Rows that are not visible as of the returned snapshot CommitID are marked as invalid.
+   * Segments are stored in their encoded form using the binary format (see BinaryWriter), one file and job per chunk.
+   * The files are written into a new subdirectory and synced to the disk before the manifest is atomically replaced, so
+   * that a crash leaves either the previous or the new checkpoint.
+   */
+  CommitID write_checkpoint(const std::string& path) const;
+
+  /**
+   * Adds all tables of the checkpoint in @param path. Chunks are read in parallel. As the segments are stored encoded,
+   * they are not re-encoded, so that loading is mostly bound by the disk bandwidth. Chunks that had been physically
+   * deleted are restored as deleted (nullptr) chunks, so that all ChunkIDs stay the same.
+   */
+  void load_checkpoint(const std::string& path);
+
  protected:
   StorageManager() = default;
   friend class Hyrise;
 
   // Tables can currently not be modified concurrently
   std::map<std::string, std::shared_ptr<Table>> _tables;
+  std::unordered_map<const Table*, std::string> _table_names;
 
   // The map of views is locked because views are created dynamically, e.g., in TPC-H 15
   std::map<std::string, std::shared_ptr<LQPView>> _views;
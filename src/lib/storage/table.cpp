@@ -1,6 +1,7 @@
 #include "table.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <numeric>
@@ -17,6 +18,12 @@
 #include "utils/assert.hpp"
 #include "value_segment.hpp"
 
+namespace {
+
+std::atomic<uint64_t> next_statistics_version{0};
+
+}  // namespace
+
 namespace opossum {
 
 std::shared_ptr<Table> Table::create_dummy_table(const TableColumnDefinitions& column_definitions) {
@@ -29,7 +36,9 @@ Table::Table(const TableColumnDefinitions& column_definitions, const TableType t
       _type(type),
       _use_mvcc(use_mvcc),
       _max_chunk_size(type == TableType::Data ? max_chunk_size.value_or(Chunk::DEFAULT_SIZE) : Chunk::MAX_SIZE),
-      _append_mutex(std::make_unique<std::mutex>()) {
+      _append_mutex(std::make_unique<std::mutex>()),
+      _statistics_mutex(std::make_unique<std::mutex>()),
+      _statistics_version(next_statistics_version++) {
   // _max_chunk_size has no meaning if the table is a reference table.
   DebugAssert(type == TableType::Data || !max_chunk_size, "Must not set max_chunk_size for reference tables");
   DebugAssert(!max_chunk_size || *max_chunk_size > 0, "Table must have a chunk size greater than 0.");
@@ -130,6 +139,12 @@ void Table::append(const std::vector<AllTypeVariant>& values) {
   }
 
   last_chunk->append(values);
+
+  const auto chunk_size = last_chunk->size();
+  for (const auto& [column_ids, table_index] : _table_indexes) {
+    table_index->insert(*last_chunk, ChunkID{chunk_count() - 1}, static_cast<ChunkOffset>(chunk_size - 1),
+                        chunk_size);
+  }
 }
 
 void Table::append_mutable_chunk() {
@@ -203,6 +218,12 @@ void Table::remove_chunk(ChunkID chunk_id) {
               }()),
               "Physical delete of chunk prevented: Chunk needs to be fully invalidated before.");
   Assert(_type == TableType::Data, "Removing chunks from other tables than data tables is not intended yet.");
+
+  const auto chunk = get_chunk(chunk_id);
+  for (const auto& [column_ids, table_index] : _table_indexes) {
+    table_index->remove(*chunk, chunk_id);
+  }
+
   std::atomic_store(&_chunks[chunk_id], std::shared_ptr<Chunk>(nullptr));
 }
 
@@ -226,7 +247,16 @@ void Table::append_chunk(const Segments& segments, std::shared_ptr<MvccData> mvc
   // making sure that an uninitialized entry compares equal to nullptr and (2) insert the desired chunk atomically.
 
   auto new_chunk_iter = _chunks.push_back(nullptr);
-  std::atomic_store(&*new_chunk_iter, std::make_shared<Chunk>(segments, mvcc_data, alloc));
+  const auto chunk = std::make_shared<Chunk>(segments, mvcc_data, alloc);
+  std::atomic_store(&*new_chunk_iter, chunk);
+
+  // Chunks appended by Insert are still empty, their rows are added to the TableIndexes once they are written
+  if (!_table_indexes.empty() && chunk->size() > 0) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(std::distance(_chunks.begin(), new_chunk_iter))};
+    for (const auto& [column_ids, table_index] : _table_indexes) {
+      table_index->insert(*chunk, chunk_id, ChunkOffset{0}, chunk->size());
+    }
+  }
 }
 
 std::vector<AllTypeVariant> Table::get_row(size_t row_idx) const {
@@ -285,14 +315,68 @@ std::vector<std::vector<AllTypeVariant>> Table::get_rows() const {
 
 std::unique_lock<std::mutex> Table::acquire_append_mutex() { return std::unique_lock<std::mutex>(*_append_mutex); }
 
-std::shared_ptr<TableStatistics> Table::table_statistics() const { return _table_statistics; }
+std::shared_ptr<TableStatistics> Table::table_statistics() const { return std::atomic_load(&_table_statistics); }
 
 void Table::set_table_statistics(const std::shared_ptr<TableStatistics>& table_statistics) {
-  _table_statistics = table_statistics;
+  std::atomic_store(&_table_statistics, table_statistics);
 }
 
+std::unique_lock<std::mutex> Table::acquire_statistics_mutex(const bool try_lock) {
+  if (try_lock) return std::unique_lock<std::mutex>(*_statistics_mutex, std::try_to_lock);
+  return std::unique_lock<std::mutex>(*_statistics_mutex);
+}
+
+uint64_t Table::statistics_version() const { return _statistics_version.load(); }
+
+void Table::update_statistics_version() { _statistics_version = next_statistics_version++; }
+
+uint64_t Table::increase_pending_statistics_row_count(const uint64_t row_count) {
+  return _pending_statistics_row_count += row_count;
+}
+
+uint64_t Table::reset_pending_statistics_row_count() { return _pending_statistics_row_count.exchange(0); }
+
 std::vector<IndexStatistics> Table::indexes_statistics() const { return _indexes; }
 
+void Table::create_table_index(const std::vector<ColumnID>& column_ids) {
+  Assert(_type == TableType::Data, "TableIndexes can only be created on data tables");
+  Assert(!get_table_index(column_ids), "TableIndex already exists");
+
+  auto data_types = std::vector<DataType>{};
+  data_types.reserve(column_ids.size());
+  for (const auto column_id : column_ids) {
+    data_types.emplace_back(column_data_type(column_id));
+  }
+
+  const auto table_index = std::make_shared<TableIndex>(column_ids, data_types);
+
+  const auto chunk_count = _chunks.size();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    table_index->insert(*chunk, chunk_id, ChunkOffset{0}, chunk->size());
+  }
+
+  add_table_index(column_ids, table_index);
+}
+
+void Table::add_table_index(const std::vector<ColumnID>& column_ids, const std::shared_ptr<TableIndex>& table_index) {
+  DebugAssert(column_ids.size() == table_index->column_ids().size(), "Expected one ColumnID per indexed column");
+  _table_indexes.emplace_back(column_ids, table_index);
+}
+
+std::shared_ptr<TableIndex> Table::get_table_index(const std::vector<ColumnID>& column_ids) const {
+  for (const auto& [indexed_column_ids, table_index] : _table_indexes) {
+    if (indexed_column_ids == column_ids) return table_index;
+  }
+  return nullptr;
+}
+
+const std::vector<std::pair<std::vector<ColumnID>, std::shared_ptr<TableIndex>>>& Table::table_indexes() const {
+  return _table_indexes;
+}
+
 const std::vector<TableConstraintDefinition>& Table::get_soft_unique_constraints() const {
   return _constraint_definitions;
 }
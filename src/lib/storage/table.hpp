@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -11,6 +12,7 @@
 #include "chunk.hpp"
 #include "storage/constraints/table_constraint_definition.hpp"
 #include "storage/index/index_statistics.hpp"
+#include "storage/index/table_index.hpp"
 #include "storage/table_column_definition.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
@@ -166,12 +168,29 @@ class Table : private Noncopyable {
 
   /**
    * Tables, typically those stored in the StorageManager, can be associated with statistics to perform Cardinality
-   * estimation during optimization.
+   * estimation during optimization. The statistics of stored Tables are replaced while the Table is modified (see
+   * update_table_statistics()), so they are accessed atomically.
    * @{
    */
   std::shared_ptr<TableStatistics> table_statistics() const;
 
   void set_table_statistics(const std::shared_ptr<TableStatistics>& table_statistics);
+
+  // Serializes the updates of the statistics. If @param try_lock is set, the returned lock does not own the mutex if
+  // another thread holds it.
+  std::unique_lock<std::mutex> acquire_statistics_mutex(const bool try_lock = false);
+
+  // Changes whenever the statistics are rebuilt, but not when they are updated incrementally. Versions are unique
+  // across Tables, so that a re-created Table does not share versions with a dropped one of the same name. Plan caches
+  // compare it with the version that plans were optimized at (see StoredTableNode::statistics_version).
+  uint64_t statistics_version() const;
+
+  void update_statistics_version();
+
+  // Rows that committed Inserts and Deletes added or invalidated since the statistics last looked at the chunks (see
+  // schedule_table_statistics_update()). Increasing returns the new count, resetting the previous one.
+  uint64_t increase_pending_statistics_row_count(const uint64_t row_count);
+  uint64_t reset_pending_statistics_row_count();
   /** @} */
 
   std::vector<IndexStatistics> indexes_statistics() const;
@@ -191,6 +210,25 @@ class Table : private Noncopyable {
     _indexes.emplace_back(index_statistics);
   }
 
+  /**
+   * In contrast to create_index(), which creates one index per chunk, create_table_index() creates a single TableIndex
+   * that covers the rows of all chunks. The index is maintained when rows are appended to the table or chunks are
+   * removed (see TableIndex). Like create_index(), it must not be called while other threads modify the table.
+   */
+  void create_table_index(const std::vector<ColumnID>& column_ids);
+
+  /**
+   * Adds an existing TableIndex whose indexed columns correspond to @param column_ids of this table. Used by GetTable
+   * to pass the indexes of the stored table on to its output. As the index is only maintained by the table that
+   * created it, lookups may return RowIDs of chunks that this table does not have (yet), which callers have to skip.
+   */
+  void add_table_index(const std::vector<ColumnID>& column_ids, const std::shared_ptr<TableIndex>& table_index);
+
+  // Returns the TableIndex on exactly @param column_ids (in this order) or nullptr if there is none
+  std::shared_ptr<TableIndex> get_table_index(const std::vector<ColumnID>& column_ids) const;
+
+  const std::vector<std::pair<std::vector<ColumnID>, std::shared_ptr<TableIndex>>>& table_indexes() const;
+
   /**
    * Add a unique constraint. The column IDs can be passed in an arbitrary order, they will be sorted
    * by this method. Constraint column IDs will always be sorted from here on.
@@ -226,6 +264,10 @@ class Table : private Noncopyable {
 
   std::shared_ptr<TableStatistics> _table_statistics;
   std::unique_ptr<std::mutex> _append_mutex;
+  std::unique_ptr<std::mutex> _statistics_mutex;
+  std::atomic<uint64_t> _statistics_version;
+  std::atomic<uint64_t> _pending_statistics_row_count{0};
   std::vector<IndexStatistics> _indexes;
+  std::vector<std::pair<std::vector<ColumnID>, std::shared_ptr<TableIndex>>> _table_indexes;
 };
 }  // namespace opossum
@@ -3,7 +3,9 @@
 #include <string>
 #include <vector>
 
+#include "concurrency/transaction_manager.hpp"
 #include "hyrise.hpp"
+#include "statistics/update_table_statistics.hpp"
 #include "storage/chunk.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
@@ -16,8 +18,9 @@ namespace opossum {
 ChunkCompressionTask::ChunkCompressionTask(const std::string& table_name, const ChunkID chunk_id)
     : ChunkCompressionTask{table_name, std::vector<ChunkID>{chunk_id}} {}
 
-ChunkCompressionTask::ChunkCompressionTask(const std::string& table_name, const std::vector<ChunkID>& chunk_ids)
-    : _table_name{table_name}, _chunk_ids{chunk_ids} {}
+ChunkCompressionTask::ChunkCompressionTask(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                                           const std::optional<ChunkEncodingSpec>& chunk_encoding_spec)
+    : _table_name{table_name}, _chunk_ids{chunk_ids}, _chunk_encoding_spec{chunk_encoding_spec} {}
 
 void ChunkCompressionTask::_on_execute() {
   auto table = Hyrise::get().storage_manager.get_table(_table_name);
@@ -29,23 +32,48 @@ void ChunkCompressionTask::_on_execute() {
     const auto chunk = table->get_chunk(chunk_id);
     Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
-    DebugAssert(_chunk_is_completed(chunk, table->max_chunk_size()),
-                "Chunk is not completed and thus can’t be compressed.");
-
-    ChunkEncoder::encode_chunk(chunk, table->column_data_types());
+    if (chunk->is_mutable()) {
+      // A completed chunk is full or had an allocation fail, so that no Insert can reserve rows in it anymore (see
+      // Chunk::reserve_rows()). The append mutex serializes the finalization with other tasks, which might have
+      // finalized the chunk already.
+      const auto append_lock = table->acquire_append_mutex();
+      Assert(chunk_is_completed(chunk, table->max_chunk_size()),
+             "Chunk is not completed and thus can’t be compressed.");
+      if (chunk->is_mutable()) chunk->finalize();
+    }
+
+    if (_chunk_encoding_spec) {
+      ChunkEncoder::encode_chunk(chunk, table->column_data_types(), *_chunk_encoding_spec);
+    } else {
+      ChunkEncoder::encode_chunk(chunk, table->column_data_types());
+    }
   }
-}
 
-bool ChunkCompressionTask::_chunk_is_completed(const std::shared_ptr<Chunk>& chunk, const uint32_t max_chunk_size) {
-  if (chunk->size() != max_chunk_size) return false;
-
-  auto mvcc_data = chunk->get_scoped_mvcc_data_lock();
+  // Merge the rows of the finalized chunks into the table's statistics
+  update_table_statistics(table);
+}
 
-  for (const auto begin_cid : mvcc_data->begin_cids) {
-    // TODO(anybody) Reading the non-atomic begin_cid (which is written to in Insert without a write lock) is likely UB
-    //               When activating the ChunkCompressionTask, please look for a different means of determining whether
-    //               all Inserts to a Chunk finished.
-    if (begin_cid == MvccData::MAX_COMMIT_ID) return false;
+bool ChunkCompressionTask::chunk_is_completed(const std::shared_ptr<const Chunk>& chunk,
+                                              const ChunkOffset max_chunk_size) {
+  if (!chunk->is_mutable()) return true;
+
+  // Without MVCC data, we cannot tell whether rows are still being written to the chunk. After a failed allocation,
+  // the chunk does not accept rows anymore and is never full, so only its allocated rows are checked. Chunks without
+  // any allocated rows are left mutable, as there is nothing to encode.
+  const auto chunk_size = chunk->size();
+  if (!chunk->has_mvcc_data()) return false;
+  if (chunk->allocation_failed() ? chunk_size == 0 : chunk_size != max_chunk_size) return false;
+
+  // The Insert operator grows the MvccData before the segments, so the MVCC entries of all rows of a full chunk exist.
+  // Their begin_cids are MAX_COMMIT_ID until the inserting transaction commits (or rolls back, which sets them to 0).
+  // A committing transaction writes its begin_cids before it publishes its commit id as the last commit id. Thus, if
+  // all begin_cids are not greater than a last commit id that was read before them, all inserting transactions are
+  // done writing to the chunk. Validate relies on the same ordering to decide the visibility of a row.
+  const auto last_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+
+  const auto mvcc_data = chunk->get_scoped_mvcc_data_lock();
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    if (mvcc_data->get_begin_cid(chunk_offset) > last_commit_id) return false;
   }
 
   return true;
@@ -1,16 +1,18 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "scheduler/abstract_task.hpp"
+#include "storage/encoding_type.hpp"
 
 namespace opossum {
 
 class Chunk;
 
 /**
- * @brief Compresses a chunk of a table using the default encoding
+ * @brief Compresses a chunk of a table using the given ChunkEncodingSpec or the default encoding
  *
  * The task compresses a chunk by sequentially compressing segments.
  * From each value segment, a dictionary segment is created that replaces the
@@ -24,8 +26,9 @@ class Chunk;
  * it does not touch the segments. However, inserting records while simultaneously
  * compressing the chunk leads to inconsistent state. Therefore only chunks where
  * all insertion has been completed may be compressed. In other words, they need to be
- * full and all of their end-cids must be smaller than infinity. This task calls
- * those chunks “completed”.
+ * either immutable or full, with all inserting transactions having committed or rolled
+ * back. This task calls those chunks “completed”. Completed chunks that are still
+ * mutable are finalized before they are compressed.
  *
  * Note: Reference segments are not invalidated by this task because the order in which
  *       records are stored does not change.
@@ -33,21 +36,22 @@ class Chunk;
 class ChunkCompressionTask : public AbstractTask {
  public:
   explicit ChunkCompressionTask(const std::string& table_name, const ChunkID chunk_id);
-  explicit ChunkCompressionTask(const std::string& table_name, const std::vector<ChunkID>& chunk_ids);
+  explicit ChunkCompressionTask(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                                const std::optional<ChunkEncodingSpec>& chunk_encoding_spec = std::nullopt);
 
- protected:
-  void _on_execute() override;
-
- private:
   /**
-   * @brief Checks if a chunks is completed
+   * @brief Checks if a chunk is completed
    *
    * See class comment for further explanation
    */
-  static bool _chunk_is_completed(const std::shared_ptr<Chunk>& chunk, const uint32_t max_chunk_size);
+  static bool chunk_is_completed(const std::shared_ptr<const Chunk>& chunk, const ChunkOffset max_chunk_size);
+
+ protected:
+  void _on_execute() override;
 
  private:
   const std::string _table_name;
   const std::vector<ChunkID> _chunk_ids;
+  const std::optional<ChunkEncodingSpec> _chunk_encoding_spec;
 };
 }  // namespace opossum
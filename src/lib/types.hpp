@@ -237,6 +237,12 @@ enum class JoinMode { Inner, Left, Right, FullOuter, Cross, Semi, AntiNullAsTrue
 
 enum class UnionMode { Positions, All };
 
+// Set operations of SQL (see SetOperationHash). Distinct removes duplicate rows from the result, while All keeps as
+// many copies of a row as the operation yields for the multisets of rows (e.g., max(m - n, 0) copies for EXCEPT ALL).
+enum class SetOperationType { Union, Intersect, Except };
+
+enum class SetOperationMode { Distinct, All };
+
 enum class OrderByMode { Ascending, Descending, AscendingNullsLast, DescendingNullsLast };
 
 enum class TableType { References, Data };
@@ -245,8 +251,12 @@ enum class DescriptionMode { SingleLine, MultiLine };
 
 enum class UseMvcc : bool { Yes = true, No = false };
 
+enum class UseWorkerDeques : bool { Yes = true, No = false };
+
 enum class CleanupTemporaries : bool { Yes = true, No = false };
 
+enum class UseMorselPipelines : bool { Yes = true, No = false };
+
 enum class HasNullTerminator : bool { Yes = true, No = false };
 
 enum class SendExecutionInfo : bool { Yes = true, No = false };
@@ -275,12 +285,16 @@ extern const boost::bimap<PredicateCondition, std::string> predicate_condition_t
 extern const boost::bimap<OrderByMode, std::string> order_by_mode_to_string;
 extern const boost::bimap<JoinMode, std::string> join_mode_to_string;
 extern const boost::bimap<UnionMode, std::string> union_mode_to_string;
+extern const boost::bimap<SetOperationType, std::string> set_operation_type_to_string;
+extern const boost::bimap<SetOperationMode, std::string> set_operation_mode_to_string;
 extern const boost::bimap<TableType, std::string> table_type_to_string;
 
 std::ostream& operator<<(std::ostream& stream, PredicateCondition predicate_condition);
 std::ostream& operator<<(std::ostream& stream, OrderByMode order_by_mode);
 std::ostream& operator<<(std::ostream& stream, JoinMode join_mode);
 std::ostream& operator<<(std::ostream& stream, UnionMode union_mode);
+std::ostream& operator<<(std::ostream& stream, SetOperationType set_operation_type);
+std::ostream& operator<<(std::ostream& stream, SetOperationMode set_operation_mode);
 std::ostream& operator<<(std::ostream& stream, TableType table_type);
 
 using BoolAsByteType = uint8_t;
@@ -14,6 +14,8 @@ MetaTableManager::MetaTableManager() {
   _methods["columns"] = &MetaTableManager::generate_columns_table;
   _methods["chunks"] = &MetaTableManager::generate_chunks_table;
   _methods["segments"] = &MetaTableManager::generate_segments_table;
+  _methods["segments_accesses"] = &MetaTableManager::generate_segments_accesses_table;
+  _methods["encoding_decisions"] = &MetaTableManager::generate_encoding_decisions_table;
 
   _table_names.reserve(_methods.size());
   for (const auto& [table_name, _] : _methods) {
@@ -118,6 +120,89 @@ std::shared_ptr<Table> MetaTableManager::generate_segments_table() {
   return output_table;
 }
 
+std::shared_ptr<Table> MetaTableManager::generate_segments_accesses_table() {
+  const auto columns = TableColumnDefinitions{{"table_name", DataType::String, false},
+                                              {"chunk_id", DataType::Int, false},
+                                              {"column_id", DataType::Int, false},
+                                              {"column_name", DataType::String, false},
+                                              {"encoding_name", DataType::String, true},
+                                              {"sequential_accesses", DataType::Long, false},
+                                              {"random_accesses", DataType::Long, false},
+                                              {"point_accesses", DataType::Long, false}};
+  auto output_table = std::make_shared<Table>(columns, TableType::Data, std::nullopt, UseMvcc::Yes);
+
+  for (const auto& [table_name, table] : Hyrise::get().storage_manager.tables()) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto& chunk = table->get_chunk(chunk_id);
+      if (!chunk) continue;
+
+      for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+        const auto& segment = chunk->get_segment(column_id);
+
+        AllTypeVariant encoding = NULL_VALUE;
+        if (const auto& encoded_segment = std::dynamic_pointer_cast<BaseEncodedSegment>(segment)) {
+          encoding = pmr_string{encoding_type_to_string.left.at(encoded_segment->encoding_type())};
+        }
+
+        const auto& access_counter = segment->access_counter;
+        output_table->append({pmr_string{table_name}, static_cast<int32_t>(chunk_id), static_cast<int32_t>(column_id),
+                              pmr_string{table->column_name(column_id)}, encoding,
+                              static_cast<int64_t>(access_counter.get(SegmentAccessCounter::AccessType::Sequential)),
+                              static_cast<int64_t>(access_counter.get(SegmentAccessCounter::AccessType::Random)),
+                              static_cast<int64_t>(access_counter.get(SegmentAccessCounter::AccessType::Point))});
+      }
+    }
+  }
+
+  return output_table;
+}
+
+std::shared_ptr<Table> MetaTableManager::generate_encoding_decisions_table() {
+  const auto columns = TableColumnDefinitions{{"table_name", DataType::String, false},
+                                              {"chunk_id", DataType::Int, false},
+                                              {"column_id", DataType::Int, false},
+                                              {"column_name", DataType::String, false},
+                                              {"previous_encoding_name", DataType::String, true},
+                                              {"encoding_name", DataType::String, false},
+                                              {"vector_compression", DataType::String, true},
+                                              {"row_count", DataType::Long, false},
+                                              {"estimated_distinct_count", DataType::Long, false},
+                                              {"estimated_run_count", DataType::Long, false},
+                                              {"scan_count", DataType::Long, false},
+                                              {"point_access_count", DataType::Long, false},
+                                              {"previous_size_in_bytes", DataType::Long, false},
+                                              {"estimated_size_in_bytes", DataType::Long, false},
+                                              {"estimated_access_cost", DataType::Double, false}};
+  auto output_table = std::make_shared<Table>(columns, TableType::Data, std::nullopt, UseMvcc::Yes);
+
+  for (const auto& decision : Hyrise::get().encoding_advisor.decisions()) {
+    const auto& encoding_spec = decision.chosen_candidate.encoding_spec;
+
+    AllTypeVariant previous_encoding = NULL_VALUE;
+    if (decision.previous_encoding_type) {
+      previous_encoding = pmr_string{encoding_type_to_string.left.at(*decision.previous_encoding_type)};
+    }
+    AllTypeVariant vector_compression = NULL_VALUE;
+    if (const auto vector_compression_type = encoding_spec.vector_compression_type) {
+      vector_compression = pmr_string{vector_compression_type_to_string.left.at(*vector_compression_type)};
+    }
+
+    output_table->append({pmr_string{decision.table_name}, static_cast<int32_t>(decision.chunk_id),
+                          static_cast<int32_t>(decision.column_id), pmr_string{decision.column_name},
+                          previous_encoding, pmr_string{encoding_type_to_string.left.at(encoding_spec.encoding_type)},
+                          vector_compression, static_cast<int64_t>(decision.characteristics.row_count),
+                          static_cast<int64_t>(decision.characteristics.distinct_count),
+                          static_cast<int64_t>(decision.characteristics.run_count),
+                          static_cast<int64_t>(decision.column_accesses.scan_count),
+                          static_cast<int64_t>(decision.column_accesses.point_access_count),
+                          static_cast<int64_t>(decision.previous_memory_usage),
+                          static_cast<int64_t>(decision.chosen_candidate.estimated_memory_usage),
+                          decision.chosen_candidate.estimated_access_cost});
+  }
+
+  return output_table;
+}
+
 bool MetaTableManager::is_meta_table_name(const std::string& name) {
   const auto prefix_len = META_PREFIX.size();
   return name.size() > prefix_len && std::string_view{&name[0], prefix_len} == MetaTableManager::META_PREFIX;
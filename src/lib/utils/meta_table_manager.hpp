@@ -24,6 +24,8 @@ class MetaTableManager : public Noncopyable {
   static std::shared_ptr<Table> generate_columns_table();
   static std::shared_ptr<Table> generate_chunks_table();
   static std::shared_ptr<Table> generate_segments_table();
+  static std::shared_ptr<Table> generate_segments_accesses_table();
+  static std::shared_ptr<Table> generate_encoding_decisions_table();
 
   // Returns name.starts_with(META_PREFIX) as stdlibc++ does not support starts_with yet.
   static bool is_meta_table_name(const std::string& name);
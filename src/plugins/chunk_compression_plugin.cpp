@@ -0,0 +1,108 @@
+#include "chunk_compression_plugin.hpp"
+
+#include "storage/base_encoded_segment.hpp"
+#include "storage/base_value_segment.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/table.hpp"
+#include "tasks/chunk_compression_task.hpp"
+
+namespace opossum {
+
+const std::string ChunkCompressionPlugin::description() const { return "Background chunk compression plugin"; }
+
+void ChunkCompressionPlugin::start() {
+  _loop_thread_compression =
+      std::make_unique<PausableLoopThread>(IDLE_DELAY_COMPRESSION, [&](size_t) { _compression_loop(); });
+}
+
+void ChunkCompressionPlugin::stop() {
+  // Call destructor of PausableLoopThread to terminate its thread
+  _loop_thread_compression.reset();
+}
+
+void ChunkCompressionPlugin::set_chunk_encoding_spec(const std::string& table_name,
+                                                     const ChunkEncodingSpec& chunk_encoding_spec) {
+  std::lock_guard<std::mutex> lock(_mutex_chunk_encoding_specs);
+  _chunk_encoding_specs[table_name] = chunk_encoding_spec;
+}
+
+/**
+ * This function looks for completed chunks with unencoded segments in all tables and compresses them. Each chunk is
+ * compressed by a task of its own, so that the scheduler can compress multiple chunks in parallel.
+ */
+void ChunkCompressionPlugin::_compression_loop() {
+  auto tasks = std::vector<std::shared_ptr<ChunkCompressionTask>>{};
+
+  for (const auto& [table_name, table] : Hyrise::get().storage_manager.tables()) {
+    if (table->empty()) continue;
+
+    const auto chunk_encoding_spec = _chunk_encoding_spec(table_name, *table);
+
+    const auto chunk_count = table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      if (!chunk || !_is_compression_candidate(chunk, table->max_chunk_size(), chunk_encoding_spec)) continue;
+
+      tasks.emplace_back(
+          std::make_shared<ChunkCompressionTask>(table_name, std::vector<ChunkID>{chunk_id}, chunk_encoding_spec));
+    }
+  }
+
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+}
+
+ChunkEncodingSpec ChunkCompressionPlugin::_chunk_encoding_spec(const std::string& table_name, const Table& table) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex_chunk_encoding_specs);
+    const auto iter = _chunk_encoding_specs.find(table_name);
+    if (iter != _chunk_encoding_specs.end()) {
+      Assert(iter->second.size() == static_cast<size_t>(table.column_count()),
+             "ChunkEncodingSpec of table '" + table_name + "' does not match its column count.");
+      return iter->second;
+    }
+  }
+
+  auto chunk_encoding_spec = ChunkEncodingSpec(static_cast<size_t>(table.column_count()), SegmentEncodingSpec{});
+
+  const auto chunk_count = table.chunk_count();
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table.get_chunk(chunk_id);
+      if (!chunk) continue;
+
+      const auto encoded_segment = std::dynamic_pointer_cast<const BaseEncodedSegment>(chunk->get_segment(column_id));
+      if (!encoded_segment) continue;
+
+      auto& segment_encoding_spec = chunk_encoding_spec[column_id];
+      segment_encoding_spec.encoding_type = encoded_segment->encoding_type();
+      if (const auto compressed_vector_type = encoded_segment->compressed_vector_type()) {
+        segment_encoding_spec.vector_compression_type = parent_vector_compression_type(*compressed_vector_type);
+      }
+      break;
+    }
+  }
+
+  return chunk_encoding_spec;
+}
+
+bool ChunkCompressionPlugin::_is_compression_candidate(const std::shared_ptr<const Chunk>& chunk,
+                                                       const ChunkOffset max_chunk_size,
+                                                       const ChunkEncodingSpec& chunk_encoding_spec) {
+  // Chunks that were deleted logically by the MvccDeletePlugin are about to be removed
+  if (chunk->get_cleanup_commit_id()) return false;
+
+  auto has_segment_to_encode = false;
+  for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+    if (chunk_encoding_spec[column_id].encoding_type != EncodingType::Unencoded &&
+        std::dynamic_pointer_cast<const BaseValueSegment>(chunk->get_segment(column_id))) {
+      has_segment_to_encode = true;
+      break;
+    }
+  }
+
+  return has_segment_to_encode && ChunkCompressionTask::chunk_is_completed(chunk, max_chunk_size);
+}
+
+EXPORT_PLUGIN(ChunkCompressionPlugin)
+
+}  // namespace opossum
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest_prod.h"
+#include "hyrise.hpp"
+#include "storage/chunk.hpp"
+#include "storage/encoding_type.hpp"
+#include "utils/abstract_plugin.hpp"
+#include "utils/pausable_loop_thread.hpp"
+#include "utils/singleton.hpp"
+
+namespace opossum {
+
+/*
+ * Chunks that are filled by the Insert operator remain mutable and keep their unencoded ValueSegments, even once they
+ * are full. Thus, tables that grow through inserts use more and more memory and cannot benefit from encoding-specific
+ * scan implementations or chunk pruning. This plugin periodically looks for chunks that are completed (see
+ * ChunkCompressionTask) but still have unencoded segments, and schedules a ChunkCompressionTask for each of them.
+ * These tasks finalize the chunks, encode their segments, and generate their pruning statistics. Segments are
+ * exchanged atomically and operators that still hold the old segments keep them alive, so readers are never blocked.
+ *
+ * The encoding can be set per table using set_chunk_encoding_spec(). For all other tables, each column keeps the
+ * encoding of its already encoded segments (e.g., the one chosen when the table was loaded). Columns without encoded
+ * segments are dictionary-encoded.
+ */
+class ChunkCompressionPlugin : public AbstractPlugin {
+  friend class ChunkCompressionPluginTest;
+
+ public:
+  const std::string description() const final;
+
+  void start() final;
+
+  void stop() final;
+
+  void set_chunk_encoding_spec(const std::string& table_name, const ChunkEncodingSpec& chunk_encoding_spec);
+
+  /**
+   * IDLE_DELAY_COMPRESSION: sleep after each search for chunks to compress
+   */
+  constexpr static std::chrono::milliseconds IDLE_DELAY_COMPRESSION = std::chrono::milliseconds(1000);
+
+ private:
+  void _compression_loop();
+
+  ChunkEncodingSpec _chunk_encoding_spec(const std::string& table_name, const Table& table);
+
+  static bool _is_compression_candidate(const std::shared_ptr<const Chunk>& chunk, const ChunkOffset max_chunk_size,
+                                        const ChunkEncodingSpec& chunk_encoding_spec);
+
+  std::unique_ptr<PausableLoopThread> _loop_thread_compression;
+
+  std::mutex _mutex_chunk_encoding_specs;
+  std::unordered_map<std::string, ChunkEncodingSpec> _chunk_encoding_specs;
+};
+
+}  // namespace opossum
@@ -75,6 +75,8 @@ class BaseTestWithParam
     Hyrise::reset();
     SQLPipelineBuilder::default_pqp_cache = nullptr;
     SQLPipelineBuilder::default_lqp_cache = nullptr;
+    SQLPipelineBuilder::default_parameterized_plan_cache = nullptr;
+    TableStatistics::default_sampling = std::nullopt;
   }
 
   static std::shared_ptr<AbstractExpression> get_column_expression(const std::shared_ptr<AbstractOperator>& op,
@@ -1,3 +1,6 @@
+#include <thread>
+#include <vector>
+
 #include "base_test.hpp"
 
 #include "cache/cache.hpp"
@@ -6,6 +9,7 @@
 #include "cache/lru_cache.hpp"
 #include "cache/lru_k_cache.hpp"
 #include "cache/random_cache.hpp"
+#include "cache/sharded_gdfs_cache.hpp"
 
 namespace opossum {
 
@@ -256,6 +260,146 @@ TEST(CachePolicyTest, Iterators) {
   ASSERT_EQ(value_sum, 200);
 }
 
+TEST(CachePolicyTest, OutdatedEntries) {
+  Cache<int, int> cache(2);
+  cache.set(1, 2);
+  cache.set(2, 3);
+
+  const auto is_outdated = [](const int value) { return value == 3; };
+  EXPECT_EQ(cache.try_get(1, is_outdated), 2);
+  EXPECT_FALSE(cache.try_get(2, is_outdated));
+
+  // Outdated entries are replaced by the next set() for their key
+  cache.set(2, 4);
+  EXPECT_EQ(cache.try_get(2, is_outdated), 4);
+}
+
+// With a single shard that holds no more entries than are sampled, the ShardedGDFSCache behaves like the GDFSCache
+TEST(CachePolicyTest, ShardedGDFSCacheTest) {
+  ShardedGDFSCache<int, int> cache(2, 1);
+
+  cache.set(1, 2);  // Miss, insert, L=0, Fr=1
+  ASSERT_EQ(1.0, cache.priority(1));
+
+  ASSERT_EQ(2, cache.get(1));  // Hit, L=0, Fr=2
+  ASSERT_EQ(2.0, cache.priority(1));
+
+  cache.set(1, 2);  // Hit, L=0, Fr=3
+  ASSERT_EQ(3.0, cache.priority(1));
+
+  cache.set(2, 4);  // Miss, insert, L=0, Fr=1
+  ASSERT_EQ(1.0, cache.priority(2));
+
+  cache.set(3, 6);  // Miss, evict 2, L=1, Fr=1
+  ASSERT_EQ(2.0, cache.priority(3));
+  ASSERT_EQ(1.0, cache.inflation(3));
+
+  ASSERT_TRUE(cache.has(1));
+  ASSERT_FALSE(cache.has(2));
+  ASSERT_TRUE(cache.has(3));
+
+  ASSERT_EQ(6, *cache.try_get(3));  // Hit, L=1, Fr=2
+  ASSERT_EQ(3.0, cache.priority(3));
+
+  ASSERT_EQ(6, cache.get(3));  // Hit, L=1, Fr=3
+  ASSERT_EQ(4.0, cache.priority(3));
+  ASSERT_EQ(3.0, cache.priority(1));
+
+  cache.set(2, 5);  // Miss, evict 1, L=3, Fr=1
+  ASSERT_EQ(3.0, cache.inflation(2));
+
+  ASSERT_FALSE(cache.has(1));
+  ASSERT_TRUE(cache.has(2));
+  ASSERT_TRUE(cache.has(3));
+  ASSERT_FALSE(cache.try_get(1));
+
+  ASSERT_EQ(cache.frequency(3), 3);
+  ASSERT_EQ(cache.frequency(100), 0);
+}
+
+TEST(CachePolicyTest, ShardedGDFSCacheSampledEviction) {
+  ShardedGDFSCache<int, int> cache(64, 1);
+
+  for (auto key = 0; key < 64; ++key) {
+    cache.set(key, key);
+  }
+
+  for (auto access = 0; access < 10; ++access) {
+    for (auto key = 0; key < 32; ++key) {
+      cache.get(key);
+    }
+  }
+
+  for (auto key = 64; key < 96; ++key) {
+    cache.set(key, key);
+  }
+  ASSERT_EQ(cache.size(), 64u);
+
+  // A frequently used entry is only evicted if all sampled entries are frequently used
+  auto cached_frequent_key_count = 0;
+  for (auto key = 0; key < 32; ++key) {
+    cached_frequent_key_count += cache.has(key);
+  }
+  EXPECT_GE(cached_frequent_key_count, 30);
+  EXPECT_TRUE(cache.has(95));
+}
+
+TEST(CachePolicyTest, ShardedGDFSCacheShards) {
+  ShardedGDFSCache<int, int> cache(8, 4);
+  ASSERT_EQ(cache.shard_count(), 4u);
+
+  // Each shard holds two entries
+  for (auto key = 0; key < 100; ++key) {
+    cache.set(key, key);
+    ASSERT_TRUE(cache.has(key));
+    ASSERT_LE(cache.size(), 8u);
+  }
+  ASSERT_EQ(cache.size(), 8u);
+
+  cache.resize(4);
+  ASSERT_EQ(cache.capacity(), 4u);
+  ASSERT_EQ(cache.size(), 4u);
+
+  // Not more shards than entries
+  ASSERT_EQ((ShardedGDFSCache<int, int>(2, 16).shard_count()), 2u);
+  ASSERT_EQ((ShardedGDFSCache<int, int>(0, 16).shard_count()), 1u);
+}
+
+TEST(CachePolicyTest, ShardedGDFSCacheConcurrentAccesses) {
+  Cache<int, int> cache;
+  cache.replace_cache_impl<ShardedGDFSCache<int, int>>(64, 8);
+  ASSERT_TRUE(cache.cache().is_thread_safe());
+
+  const auto thread_count = 8;
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < thread_count; ++thread_id) {
+    threads.emplace_back([&cache, thread_id]() {
+      for (auto access = 0; access < 10'000; ++access) {
+        const auto key = (access * thread_count + thread_id) % 256;
+        const auto value = cache.try_get(key);
+        if (value) {
+          EXPECT_EQ(*value, key * 2);
+        } else {
+          cache.set(key, key * 2);
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_LE(cache.size(), 64u);
+
+  auto element_count = size_t{0};
+  for (const auto& [key, value] : cache) {
+    ++element_count;
+    EXPECT_EQ(value, key * 2);
+  }
+  EXPECT_EQ(element_count, cache.size());
+}
+
 template <typename T>
 class CacheTest : public BaseTest {};
 
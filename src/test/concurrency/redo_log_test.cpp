@@ -0,0 +1,149 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/redo_log.hpp"
+#include "hyrise.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class RedoLogTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _log_path = test_data_path + "/redo_log_test.log";
+    std::filesystem::remove(_log_path);
+    Hyrise::get().redo_log.enable(_log_path);
+  }
+
+  void TearDown() override { std::filesystem::remove(_log_path); }
+
+  static std::shared_ptr<const Table> _execute(const std::string& sql) {
+    auto pipeline = SQLPipelineBuilder{sql}.create_pipeline();
+    const auto [pipeline_status, table] = pipeline.get_result_table();
+    EXPECT_EQ(pipeline_status, SQLPipelineStatus::Success);
+    return table;
+  }
+
+  // Simulates a restart: All in-memory state is lost and the tables are rebuilt from the log
+  void _restart() {
+    Hyrise::get().redo_log.disable();
+    Hyrise::reset();
+    Hyrise::get().redo_log.recover(_log_path);
+  }
+
+  std::string _log_path;
+};
+
+TEST_F(RedoLogTest, RecoverInitialData) {
+  Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_float.tbl", 2));
+  Hyrise::get().storage_manager.add_table("table_b", load_table("resources/test_data/tbl/int_float_with_null.tbl", 2));
+  Hyrise::get().storage_manager.add_table("table_c", load_table("resources/test_data/tbl/int_string.tbl", 3));
+  Hyrise::get().storage_manager.add_table("dropped", load_table("resources/test_data/tbl/int_float.tbl", 2));
+  Hyrise::get().storage_manager.drop_table("dropped");
+
+  _restart();
+
+  auto& storage_manager = Hyrise::get().storage_manager;
+  EXPECT_FALSE(storage_manager.has_table("dropped"));
+  EXPECT_TABLE_EQ_ORDERED(storage_manager.get_table("table_a"), load_table("resources/test_data/tbl/int_float.tbl"));
+  EXPECT_TABLE_EQ_ORDERED(storage_manager.get_table("table_b"),
+                          load_table("resources/test_data/tbl/int_float_with_null.tbl"));
+  EXPECT_TABLE_EQ_ORDERED(storage_manager.get_table("table_c"), load_table("resources/test_data/tbl/int_string.tbl"));
+  EXPECT_EQ(storage_manager.get_table("table_a")->max_chunk_size(), ChunkOffset{2});
+  EXPECT_EQ(storage_manager.get_table("table_c")->chunk_count(), ChunkID{3});
+}
+
+TEST_F(RedoLogTest, RecoverCommittedTransactions) {
+  Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_float.tbl", 2));
+
+  _execute("INSERT INTO table_a VALUES (1, 1.5), (2, 2.5)");
+  _execute("DELETE FROM table_a WHERE a = 123");
+  _execute("UPDATE table_a SET b = 3.5 WHERE a = 2");
+  _execute("INSERT INTO table_a VALUES (3, 4.5)");
+  const auto expected_table = _execute("SELECT * FROM table_a");
+
+  EXPECT_GT(Hyrise::get().redo_log.flushed_record_count(), 0u);
+  EXPECT_LE(Hyrise::get().redo_log.flush_count(), Hyrise::get().redo_log.flushed_record_count());
+
+  _restart();
+
+  EXPECT_TABLE_EQ_UNORDERED(_execute("SELECT * FROM table_a"), expected_table);
+
+  // Recovered rows can be modified again, and the modifications are logged once the log is re-enabled
+  Hyrise::get().redo_log.enable(_log_path);
+  _execute("DELETE FROM table_a WHERE a = 1");
+  const auto expected_table_after_delete = _execute("SELECT * FROM table_a");
+
+  _restart();
+
+  EXPECT_TABLE_EQ_UNORDERED(_execute("SELECT * FROM table_a"), expected_table_after_delete);
+}
+
+TEST_F(RedoLogTest, RolledBackTransactionsAreNotRecovered) {
+  Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_float.tbl", 10));
+
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context();
+  auto pipeline = SQLPipelineBuilder{"INSERT INTO table_a VALUES (1, 1.5)"}
+                      .with_transaction_context(transaction_context)
+                      .create_pipeline();
+  pipeline.get_result_table();
+  transaction_context->rollback();
+
+  _execute("INSERT INTO table_a VALUES (2, 2.5)");
+  const auto expected_table = _execute("SELECT * FROM table_a");
+
+  _restart();
+
+  // The rolled back row still occupies its RowID so that the row inserted afterwards keeps its position
+  EXPECT_TABLE_EQ_UNORDERED(_execute("SELECT * FROM table_a"), expected_table);
+  EXPECT_EQ(Hyrise::get().storage_manager.get_table("table_a")->row_count(), 5u);
+}
+
+TEST_F(RedoLogTest, SkipCommitsOfDroppedTables) {
+  Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_float.tbl", 2));
+  Hyrise::get().storage_manager.add_table("dropped", load_table("resources/test_data/tbl/int_float.tbl", 2));
+
+  // The transaction commits after the table it inserted into was dropped
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context();
+  auto pipeline = SQLPipelineBuilder{"INSERT INTO dropped VALUES (1, 1.5)"}
+                      .with_transaction_context(transaction_context)
+                      .create_pipeline();
+  pipeline.get_result_table();
+  Hyrise::get().storage_manager.drop_table("dropped");
+  transaction_context->commit();
+
+  _execute("INSERT INTO table_a VALUES (2, 2.5)");
+  const auto expected_table = _execute("SELECT * FROM table_a");
+
+  _restart();
+
+  EXPECT_FALSE(Hyrise::get().storage_manager.has_table("dropped"));
+  EXPECT_TABLE_EQ_UNORDERED(_execute("SELECT * FROM table_a"), expected_table);
+}
+
+TEST_F(RedoLogTest, DiscardTornFrame) {
+  Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_float.tbl", 2));
+  _execute("INSERT INTO table_a VALUES (1, 1.5)");
+  const auto expected_table = _execute("SELECT * FROM table_a");
+  Hyrise::get().redo_log.disable();
+
+  // Simulate a crash while the last frame was written
+  const auto valid_size = std::filesystem::file_size(_log_path);
+  {
+    auto file = std::ofstream{_log_path, std::ios::binary | std::ios::app};
+    file << "incomplete frame";
+  }
+
+  _restart();
+
+  EXPECT_TABLE_EQ_UNORDERED(_execute("SELECT * FROM table_a"), expected_table);
+  EXPECT_EQ(std::filesystem::file_size(_log_path), valid_size);
+}
+
+}  // namespace opossum
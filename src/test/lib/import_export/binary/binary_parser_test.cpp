@@ -1,3 +1,4 @@
+#include <cstdio>
 #include <memory>
 #include <string>
 #include <vector>
@@ -7,6 +8,8 @@
 
 #include "hyrise.hpp"
 #include "import_export/binary/binary_parser.hpp"
+#include "import_export/binary/binary_writer.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/encoding_type.hpp"
 
@@ -351,6 +354,32 @@ TEST_F(BinaryParserTest, InvalidAttributeVectorWidth) {
   EXPECT_THROW(BinaryParser::parse(filename), std::exception);
 }
 
+TEST_F(BinaryParserTest, ParseChunksConcurrently) {
+  const auto table = load_table("resources/test_data/tbl/int_string.tbl", 2);
+  // Each chunk is encoded differently so that the boundaries of all segment types have to be found
+  const auto chunk_encoding_specs =
+      std::vector<ChunkEncodingSpec>{{EncodingType::Unencoded, EncodingType::Unencoded},
+                                     {EncodingType::Dictionary, EncodingType::Dictionary},
+                                     {EncodingType::FrameOfReference, EncodingType::RunLength},
+                                     {EncodingType::RunLength, EncodingType::LZ4}};
+  ChunkEncoder::encode_all_chunks(table, chunk_encoding_specs);
+
+  const auto filename = test_data_path + "/parse_chunks_concurrently.bin";
+  BinaryWriter::write(*table, filename);
+
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+  const auto parsed_table = BinaryParser::parse(filename);
+  std::remove(filename.c_str());
+
+  EXPECT_TABLE_EQ_ORDERED(parsed_table, table);
+  ASSERT_EQ(parsed_table->chunk_count(), ChunkID{4});
+  EXPECT_TRUE(std::dynamic_pointer_cast<const DictionarySegment<pmr_string>>(
+      parsed_table->get_chunk(ChunkID{1})->get_segment(ColumnID{1})));
+  EXPECT_TRUE(std::dynamic_pointer_cast<const LZ4Segment<pmr_string>>(
+      parsed_table->get_chunk(ChunkID{3})->get_segment(ColumnID{1})));
+}
+
 TEST_F(BinaryParserTest, FileDoesNotExist) { EXPECT_THROW(BinaryParser::parse("not_existing_file"), std::exception); }
 
 TEST_F(BinaryParserTest, TwoColumnsNoValues) {
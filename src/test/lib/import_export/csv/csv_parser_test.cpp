@@ -3,6 +3,8 @@
 
 #include "hyrise.hpp"
 #include "import_export/csv/csv_parser.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/run_length_segment.hpp"
 #include "storage/table.hpp"
 
 #include "scheduler/immediate_execution_scheduler.hpp"
@@ -11,7 +13,14 @@
 
 namespace opossum {
 
-class CsvParserTest : public BaseTest {};
+class CsvParserTest : public BaseTest {
+ protected:
+  static std::shared_ptr<Table> _parse(const std::string& filename, const ChunkOffset chunk_size,
+                                       const size_t read_window_size,
+                                       const std::optional<ChunkEncodingSpec>& chunk_encoding_spec = std::nullopt) {
+    return CsvParser::_parse(filename, chunk_size, std::nullopt, chunk_encoding_spec, read_window_size);
+  }
+};
 
 TEST_F(CsvParserTest, SingleFloatColumn) {
   auto table = CsvParser::parse("resources/test_data/csv/float.csv");
@@ -287,4 +296,35 @@ TEST_F(CsvParserTest, WithScheduler) {
   Hyrise::get().set_scheduler(scheduler);
 }
 
+TEST_F(CsvParserTest, SmallReadWindows) {
+  // With tiny windows, rows and quoted strings are split across windows
+  for (auto read_window_size = size_t{1}; read_window_size <= 16; ++read_window_size) {
+    SCOPED_TRACE(read_window_size);
+
+    EXPECT_TABLE_EQ_ORDERED(_parse("resources/test_data/csv/string_quotes.csv", 2, read_window_size),
+                            load_table("resources/test_data/tbl/string.tbl"));
+    EXPECT_TABLE_EQ_ORDERED(_parse("resources/test_data/csv/float_int_trailing_newline.csv", 2, read_window_size),
+                            load_table("resources/test_data/tbl/float_int.tbl"));
+    EXPECT_EQ(_parse("resources/test_data/csv/string_quotes.csv", 2, read_window_size)->chunk_count(), ChunkID{3});
+  }
+}
+
+TEST_F(CsvParserTest, EncodeChunksWhileParsing) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  const auto table = _parse("resources/test_data/csv/float_int.csv", 2, 8,
+                            ChunkEncodingSpec{EncodingType::Dictionary, EncodingType::RunLength});
+  EXPECT_TABLE_EQ_ORDERED(table, load_table("resources/test_data/tbl/float_int.tbl"));
+
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    EXPECT_FALSE(chunk->is_mutable());
+    EXPECT_TRUE(chunk->pruning_statistics());
+    EXPECT_TRUE(std::dynamic_pointer_cast<const DictionarySegment<float>>(chunk->get_segment(ColumnID{0})));
+    EXPECT_TRUE(std::dynamic_pointer_cast<const RunLengthSegment<int32_t>>(chunk->get_segment(ColumnID{1})));
+  }
+}
+
 }  // namespace opossum
@@ -32,6 +32,7 @@
 #include "operators/get_table.hpp"
 #include "operators/index_scan.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
 #include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
@@ -43,6 +44,7 @@
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_all.hpp"
 #include "operators/union_positions.hpp"
 #include "storage/chunk_encoder.hpp"
@@ -321,22 +323,18 @@ TEST_F(LQPTranslatorTest, Sort) {
   const auto projection_a = std::dynamic_pointer_cast<const Projection>(pqp);
   ASSERT_TRUE(projection_a);
 
-  const auto sort_a = std::dynamic_pointer_cast<const Sort>(pqp->input_left());
-  ASSERT_TRUE(sort_a);
-  EXPECT_EQ(sort_a->column_id(), ColumnID{1});
-  EXPECT_EQ(sort_a->order_by_mode(), OrderByMode::Ascending);
-
-  const auto sort_a_plus_b = std::dynamic_pointer_cast<const Sort>(sort_a->input_left());
-  ASSERT_TRUE(sort_a_plus_b);
-  EXPECT_EQ(sort_a_plus_b->column_id(), ColumnID{0});
-  EXPECT_EQ(sort_a_plus_b->order_by_mode(), OrderByMode::Descending);
-
-  const auto sort_b = std::dynamic_pointer_cast<const Sort>(sort_a_plus_b->input_left());
-  ASSERT_TRUE(sort_b);
-  EXPECT_EQ(sort_b->column_id(), ColumnID{2});
-  EXPECT_EQ(sort_b->order_by_mode(), OrderByMode::AscendingNullsLast);
-
-  const auto projection_b = std::dynamic_pointer_cast<const Projection>(sort_b->input_left());
+  const auto sort = std::dynamic_pointer_cast<const Sort>(pqp->input_left());
+  ASSERT_TRUE(sort);
+  const auto& sort_definitions = sort->sort_definitions();
+  ASSERT_EQ(sort_definitions.size(), 3u);
+  EXPECT_EQ(sort_definitions[0].column, ColumnID{1});
+  EXPECT_EQ(sort_definitions[0].order_by_mode, OrderByMode::Ascending);
+  EXPECT_EQ(sort_definitions[1].column, ColumnID{0});
+  EXPECT_EQ(sort_definitions[1].order_by_mode, OrderByMode::Descending);
+  EXPECT_EQ(sort_definitions[2].column, ColumnID{2});
+  EXPECT_EQ(sort_definitions[2].order_by_mode, OrderByMode::AscendingNullsLast);
+
+  const auto projection_b = std::dynamic_pointer_cast<const Projection>(sort->input_left());
   ASSERT_TRUE(projection_b);
 
   const auto get_table = std::dynamic_pointer_cast<const GetTable>(projection_b->input_left());
@@ -527,6 +525,29 @@ TEST_F(LQPTranslatorTest, PredicateNodeBinaryIndexScan) {
   EXPECT_EQ(*table_scan_op->predicate(), *between_inclusive_(b, 42, 1337));
 }
 
+TEST_F(LQPTranslatorTest, PredicateNodeIndexScanWithTableIndex) {
+  const auto stored_table_node = StoredTableNode::make("int_float_chunked");
+  stored_table_node->set_pruned_column_ids({ColumnID{0}});
+
+  const auto table = Hyrise::get().storage_manager.get_table("int_float_chunked");
+  table->create_table_index({ColumnID{1}});
+
+  auto predicate_node = PredicateNode::make(equals_(stored_table_node->get_column("b"), 42.0f));
+  predicate_node->set_left_input(stored_table_node);
+  predicate_node->scan_type = ScanType::IndexScan;
+  const auto op = LQPTranslator{}.translate_node(predicate_node);
+
+  // The TableIndex covers all chunks, so that no TableScan is needed
+  const auto index_scan_op = std::dynamic_pointer_cast<const IndexScan>(op);
+  ASSERT_TRUE(index_scan_op);
+  EXPECT_TRUE(index_scan_op->included_chunk_ids.empty());
+  EXPECT_EQ(index_scan_op->lqp_node, predicate_node);
+
+  const auto get_table_op = std::dynamic_pointer_cast<const GetTable>(index_scan_op->input_left());
+  ASSERT_TRUE(get_table_op);
+  EXPECT_EQ(get_table_op->pruned_column_ids(), std::vector<ColumnID>{ColumnID{0}});
+}
+
 TEST_F(LQPTranslatorTest, PredicateNodeIndexScanFailsWhenNotApplicable) {
   if (!HYRISE_DEBUG) GTEST_SKIP();
 
@@ -621,6 +642,110 @@ TEST_F(LQPTranslatorTest, JoinNodeToJoinNestedLoop) {
   EXPECT_EQ(join_op->mode(), JoinMode::Inner);
 }
 
+TEST_F(LQPTranslatorTest, JoinNodeToJoinSortMergeForSortedInputs) {
+  /**
+   * Build LQP and translate to PQP
+   */
+  const auto sort_node_a =
+      SortNode::make(expression_vector(int_float_a), std::vector<OrderByMode>{OrderByMode::Ascending}, int_float_node);
+  const auto sort_node_b = SortNode::make(expression_vector(int_float2_a),
+                                          std::vector<OrderByMode>{OrderByMode::Ascending}, int_float2_node);
+  const auto join_node = JoinNode::make(JoinMode::Inner, equals_(int_float_a, int_float2_a), sort_node_a, sort_node_b);
+  const auto op = LQPTranslator{}.translate_node(join_node);
+
+  /**
+   * Check PQP - if both inputs are already sorted by the join column, JoinSortMerge is cheaper than JoinHash
+   */
+  const auto join_op = std::dynamic_pointer_cast<JoinSortMerge>(op);
+  ASSERT_TRUE(join_op);
+  EXPECT_EQ(join_op->primary_predicate().column_ids, ColumnIDPair(ColumnID{0}, ColumnID{0}));
+  EXPECT_EQ(join_op->mode(), JoinMode::Inner);
+
+  // Only one input sorted - we still have to sort the other input, which makes JoinHash the better choice
+  const auto join_node_b =
+      JoinNode::make(JoinMode::Inner, equals_(int_float_a, int_float2_a), sort_node_a, int_float2_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(join_node_b)));
+
+  // Inputs sorted by a different column
+  const auto join_node_c =
+      JoinNode::make(JoinMode::Inner, equals_(int_float_b, int_float2_b), sort_node_a, sort_node_b);
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(join_node_c)));
+}
+
+TEST_F(LQPTranslatorTest, JoinNodeToJoinSortMergeForSortedStoredTable) {
+  const auto table = load_table("resources/test_data/tbl/int_float2_sorted.tbl", 3);
+  Hyrise::get().storage_manager.add_table("int_float2_sorted", table);
+
+  const auto stored_table_node = StoredTableNode::make("int_float2_sorted");
+  const auto sort_node =
+      SortNode::make(expression_vector(int_float_a), std::vector<OrderByMode>{OrderByMode::Ascending}, int_float_node);
+  const auto join_node = JoinNode::make(JoinMode::Inner, equals_(int_float_a, stored_table_node->get_column("a")),
+                                        sort_node, stored_table_node);
+
+  // The chunks are sorted, but the table does not know it yet
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(join_node)));
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    table->get_chunk(chunk_id)->set_ordered_by({ColumnID{0}, OrderByMode::Ascending});
+  }
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinSortMerge>(LQPTranslator{}.translate_node(join_node)));
+}
+
+TEST_F(LQPTranslatorTest, JoinNodeToJoinIndex) {
+  // Two chunks, both of which are indexed
+  const auto table = load_table("resources/test_data/tbl/int_float2.tbl", 2);
+  ChunkEncoder::encode_all_chunks(table);
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    table->get_chunk(chunk_id)->create_index<GroupKeyIndex>(std::vector<ColumnID>{ColumnID{0}});
+  }
+  Hyrise::get().storage_manager.add_table("int_float2_indexed", table);
+
+  const auto indexed_node = StoredTableNode::make("int_float2_indexed");
+  const auto indexed_a = indexed_node->get_column("a");
+
+  /**
+   * Check PQP - looking up the few values of the other input in the indexes is cheaper than building a hash table
+   */
+  const auto join_node = JoinNode::make(JoinMode::Inner, equals_(int_float_a, indexed_a), int_float_node, indexed_node);
+  const auto join_op = std::dynamic_pointer_cast<JoinIndex>(LQPTranslator{}.translate_node(join_node));
+  ASSERT_TRUE(join_op);
+  EXPECT_EQ(join_op->primary_predicate().column_ids, ColumnIDPair(ColumnID{0}, ColumnID{0}));
+
+  const auto join_node_b =
+      JoinNode::make(JoinMode::Inner, equals_(indexed_a, int_float_a), indexed_node, int_float_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinIndex>(LQPTranslator{}.translate_node(join_node_b)));
+
+  // JoinIndex can only use the indexes of validated (i.e., reference) tables for inner joins
+  const auto validate_node = ValidateNode::make(indexed_node);
+  const auto join_node_c =
+      JoinNode::make(JoinMode::Inner, equals_(int_float_a, indexed_a), int_float_node, validate_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinIndex>(LQPTranslator{}.translate_node(join_node_c)));
+  const auto join_node_d =
+      JoinNode::make(JoinMode::Semi, equals_(int_float_a, indexed_a), int_float_node, validate_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(join_node_d)));
+
+  // Not indexed join column
+  const auto join_node_e = JoinNode::make(JoinMode::Inner, equals_(int_float_b, indexed_node->get_column("b")),
+                                          int_float_node, indexed_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(join_node_e)));
+}
+
+TEST_F(LQPTranslatorTest, JoinNodeToJoinHashForPartiallyIndexedTable) {
+  // Only two of the three chunks are indexed
+  const auto table = Hyrise::get().storage_manager.get_table("int_float_chunked");
+  table->get_chunk(ChunkID{0})->create_index<GroupKeyIndex>(std::vector<ColumnID>{ColumnID{0}});
+  table->get_chunk(ChunkID{2})->create_index<GroupKeyIndex>(std::vector<ColumnID>{ColumnID{0}});
+
+  const auto stored_table_node = StoredTableNode::make("int_float_chunked");
+  const auto join_node = JoinNode::make(JoinMode::Inner, equals_(int_float2_a, stored_table_node->get_column("a")),
+                                        int_float2_node, stored_table_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(join_node)));
+
+  // Once the remaining chunk is pruned, all chunks that the join sees are indexed
+  stored_table_node->set_pruned_chunk_ids({ChunkID{1}});
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinIndex>(LQPTranslator{}.translate_node(join_node)));
+}
+
 TEST_F(LQPTranslatorTest, AggregateNodeSimple) {
   /**
    * Build LQP and translate to PQP
@@ -704,6 +829,64 @@ TEST_F(LQPTranslatorTest, LimitNode) {
   EXPECT_EQ(*limit_op->row_count_expression(), *value_(2));
 }
 
+TEST_F(LQPTranslatorTest, SortAndLimitToTopK) {
+  /**
+   * Build LQP and translate to PQP
+   *
+   * LQP resembles:
+   *   SELECT * FROM int_float ORDER BY a DESC LIMIT 3
+   */
+  // clang-format off
+  const auto lqp =
+  LimitNode::make(value_(3),
+    SortNode::make(expression_vector(int_float_a), std::vector<OrderByMode>{OrderByMode::Descending},
+      int_float_node));
+  // clang-format on
+  const auto pqp = LQPTranslator{}.translate_node(lqp);
+
+  /**
+   * Check PQP
+   */
+  const auto top_k = std::dynamic_pointer_cast<const TopK>(pqp);
+  ASSERT_TRUE(top_k);
+  EXPECT_EQ(top_k->column_id(), ColumnID{0});
+  EXPECT_EQ(top_k->order_by_mode(), OrderByMode::Descending);
+  EXPECT_EQ(*top_k->row_count_expression(), *value_(3));
+
+  const auto get_table = std::dynamic_pointer_cast<const GetTable>(top_k->input_left());
+  ASSERT_TRUE(get_table);
+}
+
+TEST_F(LQPTranslatorTest, MultiColumnSortAndLimit) {
+  /**
+   * Build LQP and translate to PQP
+   *
+   * LQP resembles:
+   *   SELECT * FROM int_float ORDER BY a DESC, b LIMIT 3
+   */
+  const auto order_by_modes = std::vector<OrderByMode>({OrderByMode::Descending, OrderByMode::AscendingNullsLast});
+
+  // clang-format off
+  const auto lqp =
+  LimitNode::make(value_(3),
+    SortNode::make(expression_vector(int_float_a, int_float_b), order_by_modes,
+      int_float_node));
+  // clang-format on
+  const auto pqp = LQPTranslator{}.translate_node(lqp);
+
+  /**
+   * Check PQP - TopK only supports a single column, so the Sort is not fused with the Limit
+   */
+  const auto limit = std::dynamic_pointer_cast<const Limit>(pqp);
+  ASSERT_TRUE(limit);
+
+  const auto sort = std::dynamic_pointer_cast<const Sort>(limit->input_left());
+  ASSERT_TRUE(sort);
+  ASSERT_EQ(sort->sort_definitions().size(), 2u);
+  EXPECT_EQ(sort->sort_definitions()[1].column, ColumnID{1});
+  EXPECT_EQ(sort->sort_definitions()[1].order_by_mode, OrderByMode::AscendingNullsLast);
+}
+
 TEST_F(LQPTranslatorTest, DiamondShapeSimple) {
   /**
    * Test that
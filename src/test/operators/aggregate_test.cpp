@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -791,4 +792,189 @@ TYPED_TEST(OperatorsAggregateTest, OuterJoinThenAggregate) {
                     "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/outer_join.tbl", 1, false);
 }
 
+class OperatorsAggregateHashTest : public BaseTest {};
+
+TEST_F(OperatorsAggregateHashTest, PartitionedAggregation) {
+  // The input is split into multiple pre-aggregation jobs, and the job-local tables for the high-cardinality column a
+  // exceed PRE_AGGREGATION_MAX_GROUPS, so that multiple partial tables are merged across multiple radix partitions. The
+  // result is compared to the aggregation of the same data stored in a single chunk, which is not partitioned.
+  constexpr auto CHUNK_SIZE = ChunkOffset{5'000};
+  constexpr auto ROW_COUNT = 150'000;
+  constexpr auto HIGH_CARDINALITY = 40'000;
+  static_assert(ROW_COUNT > 2 * AggregateHash::PRE_AGGREGATION_ROWS_PER_JOB);
+  static_assert(HIGH_CARDINALITY > AggregateHash::PRE_AGGREGATION_MAX_GROUPS);
+  static_assert(HIGH_CARDINALITY > AggregateHash::MERGE_GROUPS_PER_PARTITION);
+
+  const auto column_definitions =
+      TableColumnDefinitions{{"a", DataType::Int, false},
+                             {"b", DataType::Int, false},
+                             {"c", DataType::String, false},
+                             {"d", DataType::Int, true},
+                             {"e", DataType::Double, false}};
+
+  const auto create_table = [&](const ChunkOffset chunk_size) {
+    const auto table = std::make_shared<Table>(column_definitions, TableType::Data, chunk_size);
+
+    for (auto chunk_begin = 0; chunk_begin < ROW_COUNT; chunk_begin += static_cast<int>(chunk_size)) {
+      auto a_values = pmr_concurrent_vector<int32_t>{};
+      auto b_values = pmr_concurrent_vector<int32_t>{};
+      auto c_values = pmr_concurrent_vector<pmr_string>{};
+      auto d_values = pmr_concurrent_vector<int32_t>{};
+      auto d_null_values = pmr_concurrent_vector<bool>{};
+      auto e_values = pmr_concurrent_vector<double>{};
+
+      for (auto row = chunk_begin; row < std::min(chunk_begin + static_cast<int>(chunk_size), ROW_COUNT); ++row) {
+        a_values.push_back(row % HIGH_CARDINALITY);
+        b_values.push_back(row % 7);
+        c_values.push_back(pmr_string{std::to_string(row % 5'000)});
+        d_values.push_back(row % 1'000);
+        d_null_values.push_back(row % 13 == 0);
+        e_values.push_back((row % 100) * 0.5);
+      }
+
+      table->append_chunk({std::make_shared<ValueSegment<int32_t>>(std::move(a_values)),
+                           std::make_shared<ValueSegment<int32_t>>(std::move(b_values)),
+                           std::make_shared<ValueSegment<pmr_string>>(std::move(c_values)),
+                           std::make_shared<ValueSegment<int32_t>>(std::move(d_values), std::move(d_null_values)),
+                           std::make_shared<ValueSegment<double>>(std::move(e_values))});
+    }
+
+    const auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+    return table_wrapper;
+  };
+
+  const auto table_wrapper = create_table(CHUNK_SIZE);
+  const auto single_chunk_table_wrapper = create_table(ChunkOffset{ROW_COUNT});
+
+  const auto aggregates = std::vector<AggregateColumnDefinition>{
+      {ColumnID{3}, AggregateFunction::Min},
+      {ColumnID{3}, AggregateFunction::Max},
+      {ColumnID{3}, AggregateFunction::Sum},
+      {ColumnID{3}, AggregateFunction::Avg},
+      {ColumnID{3}, AggregateFunction::Count},
+      {ColumnID{3}, AggregateFunction::CountDistinct},
+      {ColumnID{4}, AggregateFunction::StandardDeviationSample},
+      {ColumnID{2}, AggregateFunction::Min},
+      {INVALID_COLUMN_ID, AggregateFunction::Count},
+  };
+
+  // Covers all AggregateKey types as well as integer (a, b) and string (c) group keys
+  const auto groupby_column_id_sets =
+      std::vector<std::vector<ColumnID>>{{},
+                                         {ColumnID{1}},
+                                         {ColumnID{0}},
+                                         {ColumnID{2}},
+                                         {ColumnID{0}, ColumnID{1}},
+                                         {ColumnID{0}, ColumnID{1}, ColumnID{2}}};
+
+  for (const auto& groupby_column_ids : groupby_column_id_sets) {
+    const auto aggregate = std::make_shared<AggregateHash>(table_wrapper, aggregates, groupby_column_ids);
+    aggregate->execute();
+    const auto expected = std::make_shared<AggregateHash>(single_chunk_table_wrapper, aggregates, groupby_column_ids);
+    expected->execute();
+    EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected->get_output());
+
+    if (groupby_column_ids.empty()) continue;
+
+    // DISTINCT
+    const auto distinct = std::make_shared<AggregateHash>(table_wrapper, std::vector<AggregateColumnDefinition>{},
+                                                          groupby_column_ids);
+    distinct->execute();
+    const auto expected_distinct = std::make_shared<AggregateHash>(
+        single_chunk_table_wrapper, std::vector<AggregateColumnDefinition>{}, groupby_column_ids);
+    expected_distinct->execute();
+    EXPECT_TABLE_EQ_UNORDERED(distinct->get_output(), expected_distinct->get_output());
+  }
+}
+
+TEST_F(OperatorsAggregateHashTest, CountDistinctAcrossChunksAndJobs) {
+  // The values of b repeat across all chunks, so that every pre-aggregation job and every partial table sees the same
+  // values. With the high group cardinality, the job-local tables are handed over to the merge phase multiple times per
+  // job. Rows with a NULL in b are not counted, and the group a == 0 only has NULLs in b.
+  constexpr auto CHUNK_SIZE = ChunkOffset{5'000};
+  constexpr auto ROW_COUNT = 150'000;
+  static_assert(ROW_COUNT > 2 * AggregateHash::PRE_AGGREGATION_ROWS_PER_JOB);
+
+  for (const auto group_count : {1, 100, 20'000}) {
+    const auto table = std::make_shared<Table>(
+        TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Int, true}}, TableType::Data, CHUNK_SIZE);
+    auto expected_values = std::map<int32_t, std::set<int32_t>>{};
+
+    for (auto chunk_begin = 0; chunk_begin < ROW_COUNT; chunk_begin += static_cast<int>(CHUNK_SIZE)) {
+      auto a_values = pmr_concurrent_vector<int32_t>{};
+      auto b_values = pmr_concurrent_vector<int32_t>{};
+      auto b_null_values = pmr_concurrent_vector<bool>{};
+
+      for (auto row = chunk_begin; row < chunk_begin + static_cast<int>(CHUNK_SIZE); ++row) {
+        const auto a = row % group_count;
+        const auto b = (row / group_count) % 50;
+        const auto b_is_null = (group_count > 1 && a == 0) || row % 11 == 0;
+        a_values.push_back(a);
+        b_values.push_back(b);
+        b_null_values.push_back(b_is_null);
+
+        auto& group_values = expected_values[a];
+        if (!b_is_null) group_values.emplace(b);
+      }
+
+      table->append_chunk({std::make_shared<ValueSegment<int32_t>>(std::move(a_values)),
+                           std::make_shared<ValueSegment<int32_t>>(std::move(b_values), std::move(b_null_values))});
+    }
+
+    const auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+
+    const auto aggregate = std::make_shared<AggregateHash>(
+        table_wrapper, std::vector<AggregateColumnDefinition>{{ColumnID{1}, AggregateFunction::CountDistinct}},
+        std::vector<ColumnID>{ColumnID{0}});
+    aggregate->execute();
+
+    const auto& output = aggregate->get_output();
+    ASSERT_EQ(output->row_count(), expected_values.size());
+    for (const auto& row : output->get_rows()) {
+      const auto a = boost::get<int32_t>(row[0]);
+      ASSERT_TRUE(expected_values.count(a));
+      EXPECT_EQ(boost::get<int64_t>(row[1]), static_cast<int64_t>(expected_values[a].size())) << "Group " << a;
+    }
+    if (group_count > 1) EXPECT_TRUE(expected_values[0].empty());
+  }
+}
+
+TEST_F(OperatorsAggregateHashTest, CountDistinctWithNull) {
+  // NULLs are neither counted as a value nor do they form a group of their own within COUNT(DISTINCT). A NULL group key
+  // forms a group, though.
+  const auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::Int, true}}, TableType::Data, ChunkOffset{2});
+  table->append({1, 10});
+  table->append({1, NullValue{}});
+  table->append({1, 10});
+  table->append({1, 20});
+  table->append({2, NullValue{}});
+  table->append({2, NullValue{}});
+  table->append({NullValue{}, 30});
+  table->append({NullValue{}, 30});
+  table->append({NullValue{}, NullValue{}});
+
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto aggregates = std::vector<AggregateColumnDefinition>{{ColumnID{1}, AggregateFunction::CountDistinct}};
+
+  const auto grouped = std::make_shared<AggregateHash>(table_wrapper, aggregates, std::vector<ColumnID>{ColumnID{0}});
+  grouped->execute();
+
+  auto counts = std::map<std::optional<int32_t>, int64_t>{};
+  for (const auto& row : grouped->get_output()->get_rows()) {
+    const auto a = variant_is_null(row[0]) ? std::nullopt : std::optional<int32_t>{boost::get<int32_t>(row[0])};
+    counts.emplace(a, boost::get<int64_t>(row[1]));
+  }
+  EXPECT_EQ(counts, (std::map<std::optional<int32_t>, int64_t>{{std::nullopt, 1}, {1, 2}, {2, 0}}));
+
+  const auto ungrouped = std::make_shared<AggregateHash>(table_wrapper, aggregates, std::vector<ColumnID>{});
+  ungrouped->execute();
+  ASSERT_EQ(ungrouped->get_output()->row_count(), 1u);
+  EXPECT_EQ(ungrouped->get_output()->get_value<int64_t>(ColumnID{0}, 0u), 3);
+}
+
 }  // namespace opossum
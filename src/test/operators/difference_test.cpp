@@ -59,6 +59,34 @@ TEST_F(OperatorsDifferenceTest, DifferneceOnReferenceTables) {
   EXPECT_TABLE_EQ_UNORDERED(difference->get_output(), expected_result);
 }
 
+TEST_F(OperatorsDifferenceTest, DifferenceWithNullsAndDuplicates) {
+  const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::Float, false}};
+
+  const auto table_left = std::make_shared<Table>(column_definitions, TableType::Data, 2);
+  table_left->append({1, 1.5f});
+  table_left->append({NULL_VALUE, 2.5f});
+  table_left->append({1, 1.5f});
+  table_left->append({NULL_VALUE, 3.5f});
+
+  const auto table_right = std::make_shared<Table>(column_definitions, TableType::Data, 2);
+  table_right->append({NULL_VALUE, 2.5f});
+
+  const auto expected_result = std::make_shared<Table>(column_definitions, TableType::Data);
+  expected_result->append({1, 1.5f});
+  expected_result->append({1, 1.5f});
+  expected_result->append({NULL_VALUE, 3.5f});
+
+  auto table_wrapper_left = std::make_shared<TableWrapper>(table_left);
+  table_wrapper_left->execute();
+  auto table_wrapper_right = std::make_shared<TableWrapper>(table_right);
+  table_wrapper_right->execute();
+
+  auto difference = std::make_shared<Difference>(table_wrapper_left, table_wrapper_right);
+  difference->execute();
+
+  EXPECT_TABLE_EQ_ORDERED(difference->get_output(), expected_result);
+}
+
 TEST_F(OperatorsDifferenceTest, ThrowWrongColumnNumberException) {
   if (!HYRISE_DEBUG) GTEST_SKIP();
   auto table_wrapper_c = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int.tbl", 2));
@@ -1,5 +1,7 @@
+#include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "base_test.hpp"
@@ -317,4 +319,55 @@ TEST_F(OperatorsInsertTest, InsertIntoEmptyTable) {
   EXPECT_TABLE_EQ_ORDERED(target_table, table_int_float);
 }
 
+TEST_F(OperatorsInsertTest, ConcurrentInserts) {
+  // Small chunks so that the Inserts share chunks, split their rows over chunks, and append new ones concurrently
+  const auto target_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}},
+                                                    TableType::Data, ChunkOffset{10}, UseMvcc::Yes);
+  Hyrise::get().storage_manager.add_table("target_table", target_table);
+
+  const auto values_to_insert = load_table("resources/test_data/tbl/int.tbl");
+
+  constexpr auto THREAD_COUNT = 8;
+  constexpr auto INSERTS_PER_THREAD = 20;
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_index = 0; thread_index < THREAD_COUNT; ++thread_index) {
+    threads.emplace_back([&]() {
+      for (auto insert_index = 0; insert_index < INSERTS_PER_THREAD; ++insert_index) {
+        const auto table_wrapper = std::make_shared<TableWrapper>(values_to_insert);
+        table_wrapper->execute();
+
+        const auto insert = std::make_shared<Insert>("target_table", table_wrapper);
+        const auto context = Hyrise::get().transaction_manager.new_transaction_context();
+        insert->set_transaction_context(context);
+        insert->execute();
+        context->commit();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto row_count = size_t{THREAD_COUNT * INSERTS_PER_THREAD * 3};
+  EXPECT_EQ(target_table->row_count(), row_count);
+  EXPECT_EQ(target_table->chunk_count(), row_count / 10);
+
+  // Every inserted row is written and visible
+  const auto get_table = std::make_shared<GetTable>("target_table");
+  const auto validate = std::make_shared<Validate>(get_table);
+  validate->set_transaction_context(Hyrise::get().transaction_manager.new_transaction_context());
+  get_table->execute();
+  validate->execute();
+  EXPECT_EQ(validate->get_output()->row_count(), row_count);
+
+  auto value_counts = std::map<int32_t, size_t>{};
+  for (const auto& row : target_table->get_rows()) {
+    ++value_counts[boost::get<int32_t>(row[0])];
+  }
+  const auto expected_value_counts =
+      std::map<int32_t, size_t>{{123, row_count / 3}, {1234, row_count / 3}, {12345, row_count / 3}};
+  EXPECT_EQ(value_counts, expected_value_counts);
+}
+
 }  // namespace opossum
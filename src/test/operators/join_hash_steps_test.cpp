@@ -100,6 +100,57 @@ TEST_F(JoinHashStepsTest, LargeHashTableSinglePositions) {
   }
 }
 
+TEST_F(JoinHashStepsTest, BloomFilter) {
+  auto bloom_filter = BloomFilter<int>{1'000};
+  for (auto value = 0; value < 1'000; ++value) {
+    bloom_filter.insert(value * 2);
+  }
+
+  // There are no false negatives
+  for (auto value = 0; value < 1'000; ++value) {
+    EXPECT_TRUE(bloom_filter.contains(value * 2));
+  }
+
+  // False positives are rare
+  auto false_positive_count = 0;
+  for (auto value = 0; value < 1'000; ++value) {
+    if (bloom_filter.contains(value * 2 + 1)) ++false_positive_count;
+  }
+  EXPECT_LT(false_positive_count, 100);
+
+  // An empty filter rejects all values
+  const auto empty_bloom_filter = BloomFilter<pmr_string>{0};
+  EXPECT_FALSE(empty_bloom_filter.contains(pmr_string{"a"}));
+}
+
+TEST_F(JoinHashStepsTest, MaterializeInputWithBloomFilter) {
+  // Only the ones of the 0/1 table pass the filter
+  auto bloom_filter = BloomFilter<int>{1};
+  bloom_filter.insert(1);
+
+  std::vector<std::vector<size_t>> histograms;
+  const auto chunk_offsets = determine_chunk_offsets(_table_zero_one);
+  const auto radix_bit_count = size_t{1};
+  const auto materialized = materialize_input<int, int, false>(_table_zero_one, ColumnID{0}, chunk_offsets, histograms,
+                                                               radix_bit_count, &bloom_filter);
+
+  auto materialized_count = size_t{0};
+  for (const auto& element : *materialized.elements) {
+    if (element.row_id == NULL_ROW_ID) continue;
+    EXPECT_EQ(element.value, 1);
+    ++materialized_count;
+  }
+  EXPECT_EQ(materialized_count, _table_size_zero_one / 2);
+
+  // Filtered values are neither counted in the histograms nor copied by the radix partitioning
+  const auto partitioned = partition_radix_parallel<int, int, false>(materialized, chunk_offsets, histograms,
+                                                                     radix_bit_count);
+  EXPECT_EQ(partitioned.elements->size(), _table_size_zero_one / 2);
+  for (const auto& element : *partitioned.elements) {
+    EXPECT_EQ(element.value, 1);
+  }
+}
+
 TEST_F(JoinHashStepsTest, MaterializeInput) {
   std::vector<std::vector<size_t>> histograms;
   const auto chunk_offsets = determine_chunk_offsets(_table_with_nulls_and_zeros_scanned->get_output());
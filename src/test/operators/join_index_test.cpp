@@ -240,6 +240,18 @@ TYPED_TEST(JoinIndexTest, InnerJoinBig) {
                          "resources/test_data/tbl/join_operators/int_string_inner_join.tbl", 1);
 }
 
+TYPED_TEST(JoinIndexTest, InnerRefJoinBigIndexSideIsLeft) {
+  // scans that return all rows. The join columns have different ColumnIDs on the two sides.
+  auto scan_c = this->create_table_scan(this->_table_wrapper_c, ColumnID{0}, PredicateCondition::GreaterThanEquals, 0);
+  scan_c->execute();
+  auto scan_d = this->create_table_scan(this->_table_wrapper_d, ColumnID{1}, PredicateCondition::GreaterThanEquals, 0);
+  scan_d->execute();
+
+  this->test_join_output(scan_c, scan_d, {{ColumnID{0}, ColumnID{1}}, PredicateCondition::Equals}, JoinMode::Inner,
+                         "resources/test_data/tbl/join_operators/int_string_inner_join.tbl", 1, true,
+                         IndexSide::Left);
+}
+
 TYPED_TEST(JoinIndexTest, InnerRefJoinFilteredBig) {
   auto scan_c = this->create_table_scan(this->_table_wrapper_c, ColumnID{0}, PredicateCondition::GreaterThanEquals, 0);
   scan_c->execute();
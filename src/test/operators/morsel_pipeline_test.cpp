@@ -0,0 +1,345 @@
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "operators/aggregate_hash.hpp"
+#include "operators/get_table.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/limit.hpp"
+#include "operators/morsel_pipeline.hpp"
+#include "operators/projection.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/union_all.hpp"
+#include "operators/validate.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/operator_task.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class MorselPipelineTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = load_table("resources/test_data/tbl/int_float4.tbl", 2);
+    Hyrise::get().storage_manager.add_table("table_a", _table);
+
+    _a = pqp_column_(ColumnID{0}, DataType::Int, false, "a");
+    _b = pqp_column_(ColumnID{1}, DataType::Float, false, "b");
+  }
+
+  static std::shared_ptr<const Table> _execute(const std::shared_ptr<AbstractOperator>& pqp) {
+    const auto tasks = OperatorTask::make_tasks_from_operator(pqp, CleanupTemporaries::No);
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+    return pqp->get_output();
+  }
+
+  // Executes the plan created by @param create_plan with and without MorselPipelines and compares the results
+  static void _expect_same_result(const std::function<std::shared_ptr<AbstractOperator>()>& create_plan,
+                                  const OrderSensitivity order_sensitivity = OrderSensitivity::Yes) {
+    const auto expected_result = _execute(create_plan());
+
+    const auto pipelined_plan = create_morsel_pipelines(create_plan());
+    ASSERT_EQ(pipelined_plan->type(), OperatorType::MorselPipeline);
+    const auto result = _execute(pipelined_plan);
+
+    EXPECT_TABLE_EQ(result, expected_result, order_sensitivity, TypeCmpMode::Strict,
+                    FloatComparisonMode::AbsoluteDifference);
+    for (auto column_id = ColumnID{0}; column_id < result->column_count(); ++column_id) {
+      EXPECT_EQ(result->column_is_nullable(column_id), expected_result->column_is_nullable(column_id));
+    }
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<AbstractExpression> _a, _b;
+};
+
+TEST_F(MorselPipelineTest, FusesChainsOfChunkLocalOperators) {
+  const auto get_table = std::make_shared<GetTable>("table_a");
+  const auto validate = std::make_shared<Validate>(get_table);
+  const auto table_scan = std::make_shared<TableScan>(validate, greater_than_(_a, 100));
+  const auto projection = std::make_shared<Projection>(table_scan, expression_vector(_a, add_(_b, 1)));
+  const auto sort = std::make_shared<Sort>(projection, ColumnID{0});
+
+  const auto pipelined_plan = create_morsel_pipelines(sort);
+  ASSERT_EQ(pipelined_plan->type(), OperatorType::Sort);
+  EXPECT_NE(pipelined_plan, sort);
+
+  const auto morsel_pipeline = std::dynamic_pointer_cast<const MorselPipeline>(pipelined_plan->input_left());
+  ASSERT_TRUE(morsel_pipeline);
+  EXPECT_EQ(morsel_pipeline->input_left(), get_table);
+  ASSERT_EQ(morsel_pipeline->operators().size(), 3u);
+  EXPECT_EQ(morsel_pipeline->operators()[0]->type(), OperatorType::Validate);
+  EXPECT_EQ(morsel_pipeline->operators()[1]->type(), OperatorType::TableScan);
+  EXPECT_EQ(morsel_pipeline->operators()[2]->type(), OperatorType::Projection);
+  EXPECT_EQ(morsel_pipeline->description(), "MorselPipeline [Validate -> TableScan Impl: Unset a > 100 -> Projection]");
+
+  // The original plan is not modified
+  EXPECT_EQ(sort->input_left(), projection);
+
+  const auto copied_morsel_pipeline = std::dynamic_pointer_cast<const MorselPipeline>(morsel_pipeline->deep_copy());
+  ASSERT_TRUE(copied_morsel_pipeline);
+  EXPECT_EQ(copied_morsel_pipeline->operators().size(), 3u);
+}
+
+TEST_F(MorselPipelineTest, DoesNotFuseSingleOrSharedOperators) {
+  const auto create_plan = [&]() {
+    const auto table_wrapper = std::make_shared<TableWrapper>(_table);
+    const auto shared_table_scan = std::make_shared<TableScan>(table_wrapper, greater_than_(_a, 100));
+    const auto left_table_scan = std::make_shared<TableScan>(shared_table_scan, less_than_(_b, 800));
+    const auto left_projection = std::make_shared<Projection>(left_table_scan, expression_vector(_a, _b));
+    const auto right_table_scan = std::make_shared<TableScan>(shared_table_scan, greater_than_(_b, 500));
+    return std::make_shared<UnionAll>(left_projection, right_table_scan);
+  };
+
+  const auto union_all = create_plan();
+  const auto pipelined_plan = create_morsel_pipelines(union_all);
+  ASSERT_EQ(pipelined_plan->type(), OperatorType::UnionAll);
+
+  // The shared TableScan is not fused into the left pipeline, and the single TableScan on the right is not fused at all
+  const auto morsel_pipeline = std::dynamic_pointer_cast<const MorselPipeline>(pipelined_plan->input_left());
+  ASSERT_TRUE(morsel_pipeline);
+  EXPECT_EQ(morsel_pipeline->operators().size(), 2u);
+  EXPECT_EQ(morsel_pipeline->input_left(), union_all->input_right()->input_left());
+  EXPECT_EQ(pipelined_plan->input_right(), union_all->input_right());
+
+  EXPECT_TABLE_EQ_ORDERED(_execute(pipelined_plan), _execute(create_plan()));
+}
+
+TEST_F(MorselPipelineTest, FusesJoinHashAndAggregateHash) {
+  const auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  const auto build_table_wrapper = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int_float2.tbl"));
+  const auto table_scan = std::make_shared<TableScan>(table_wrapper, greater_than_(_a, 100));
+  const auto join = std::make_shared<JoinHash>(
+      table_scan, build_table_wrapper, JoinMode::Inner,
+      OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals});
+  const auto aggregate = std::make_shared<AggregateHash>(
+      join, std::vector<AggregateColumnDefinition>{{ColumnID{3}, AggregateFunction::Sum}},
+      std::vector<ColumnID>{ColumnID{0}});
+
+  // Only one JoinHash per MorselPipeline, which continues with its left input. AggregateHashes end a MorselPipeline.
+  const auto second_join = std::make_shared<JoinHash>(
+      aggregate, build_table_wrapper, JoinMode::Semi,
+      OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals});
+  const auto projection = std::make_shared<Projection>(second_join, expression_vector(_a));
+
+  const auto pipelined_plan = create_morsel_pipelines(projection);
+  const auto upper_morsel_pipeline = std::dynamic_pointer_cast<const MorselPipeline>(pipelined_plan);
+  ASSERT_TRUE(upper_morsel_pipeline);
+  EXPECT_EQ(upper_morsel_pipeline->input_right(), build_table_wrapper);
+  ASSERT_EQ(upper_morsel_pipeline->operators().size(), 2u);
+  EXPECT_EQ(upper_morsel_pipeline->operators()[0]->type(), OperatorType::JoinHash);
+  EXPECT_EQ(upper_morsel_pipeline->operators()[1]->type(), OperatorType::Projection);
+
+  const auto lower_morsel_pipeline = std::dynamic_pointer_cast<const MorselPipeline>(pipelined_plan->input_left());
+  ASSERT_TRUE(lower_morsel_pipeline);
+  EXPECT_EQ(lower_morsel_pipeline->input_left(), table_wrapper);
+  EXPECT_EQ(lower_morsel_pipeline->input_right(), build_table_wrapper);
+  ASSERT_EQ(lower_morsel_pipeline->operators().size(), 3u);
+  EXPECT_EQ(lower_morsel_pipeline->operators()[0]->type(), OperatorType::TableScan);
+  EXPECT_EQ(lower_morsel_pipeline->operators()[1]->type(), OperatorType::JoinHash);
+  EXPECT_EQ(lower_morsel_pipeline->operators()[2]->type(), OperatorType::Aggregate);
+
+  const auto copied_morsel_pipeline =
+      std::dynamic_pointer_cast<const MorselPipeline>(lower_morsel_pipeline->deep_copy());
+  ASSERT_TRUE(copied_morsel_pipeline);
+  EXPECT_TRUE(copied_morsel_pipeline->input_right());
+
+  // The unmatched rows of right outer joins are only known once all morsels are probed
+  const auto right_join = std::make_shared<JoinHash>(
+      table_scan, build_table_wrapper, JoinMode::Right,
+      OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals});
+  EXPECT_EQ(create_morsel_pipelines(right_join), right_join);
+}
+
+TEST_F(MorselPipelineTest, JoinHashSameResultAsOperatorAtATime) {
+  // The build side contains a NULL value, which makes the result of AntiNullAsTrue empty
+  const auto build_table = load_table("resources/test_data/tbl/int_float_with_null.tbl", 2);
+  const auto build_a = pqp_column_(ColumnID{0}, DataType::Int, true, "a");
+
+  for (const auto chunk_size : {ChunkOffset{1}, ChunkOffset{3}, Chunk::DEFAULT_SIZE}) {
+    const auto table = load_table("resources/test_data/tbl/int_float4.tbl", chunk_size);
+    for (const auto mode : {JoinMode::Inner, JoinMode::Left, JoinMode::Semi, JoinMode::AntiNullAsTrue,
+                            JoinMode::AntiNullAsFalse}) {
+      SCOPED_TRACE(std::to_string(chunk_size) + " " + join_mode_to_string.left.at(mode));
+      _expect_same_result(
+          [&]() {
+            const auto table_wrapper = std::make_shared<TableWrapper>(table);
+            const auto table_scan = std::make_shared<TableScan>(table_wrapper, greater_than_(_a, 100));
+            const auto build_table_wrapper = std::make_shared<TableWrapper>(build_table);
+            return std::make_shared<JoinHash>(
+                table_scan, build_table_wrapper, mode,
+                OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals});
+          },
+          OrderSensitivity::No);
+    }
+
+    // The right input is larger than the left input, so the operators are executed one after another
+    _expect_same_result(
+        [&]() {
+          const auto table_wrapper = std::make_shared<TableWrapper>(build_table);
+          const auto table_scan = std::make_shared<TableScan>(table_wrapper, is_not_null_(build_a));
+          return std::make_shared<JoinHash>(
+              table_scan, std::make_shared<TableWrapper>(table), JoinMode::Inner,
+              OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals});
+        },
+        OrderSensitivity::No);
+  }
+}
+
+TEST_F(MorselPipelineTest, AggregateHashSameResultAsOperatorAtATime) {
+  const auto a = pqp_column_(ColumnID{0}, DataType::Int, true, "a");
+  const auto b = pqp_column_(ColumnID{1}, DataType::Float, true, "b");
+
+  // Covers all AggregateKey types as well as int (a) and float (b) group keys. The ids of the float values are shared
+  // by all morsels.
+  const auto groupby_column_id_sets = std::vector<std::vector<ColumnID>>{
+      {}, {ColumnID{0}}, {ColumnID{1}}, {ColumnID{0}, ColumnID{1}}, {ColumnID{0}, ColumnID{1}, ColumnID{2}}};
+  const auto aggregates = std::vector<AggregateColumnDefinition>{{ColumnID{1}, AggregateFunction::Sum},
+                                                                 {ColumnID{1}, AggregateFunction::CountDistinct},
+                                                                 {ColumnID{2}, AggregateFunction::Max},
+                                                                 {INVALID_COLUMN_ID, AggregateFunction::Count}};
+
+  for (const auto chunk_size : {ChunkOffset{1}, ChunkOffset{2}, Chunk::DEFAULT_SIZE}) {
+    const auto table = load_table("resources/test_data/tbl/int_float_with_null.tbl", chunk_size);
+    for (const auto& groupby_column_ids : groupby_column_id_sets) {
+      SCOPED_TRACE(std::to_string(chunk_size) + " " + std::to_string(groupby_column_ids.size()));
+      _expect_same_result(
+          [&]() {
+            const auto table_wrapper = std::make_shared<TableWrapper>(table);
+            const auto projection =
+                std::make_shared<Projection>(table_wrapper, expression_vector(a, b, add_(a, 1)));
+            return std::make_shared<AggregateHash>(projection, aggregates, groupby_column_ids);
+          },
+          OrderSensitivity::No);
+    }
+  }
+}
+
+TEST_F(MorselPipelineTest, RebasedSegmentsSharePosLists) {
+  const auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  const auto table_scan = std::make_shared<TableScan>(table_wrapper, greater_than_(_a, 100));
+  const auto pipelined_plan = create_morsel_pipelines(std::make_shared<TableScan>(table_scan, less_than_(_b, 800)));
+  ASSERT_EQ(pipelined_plan->type(), OperatorType::MorselPipeline);
+
+  // The PosLists of the morsel outputs are copied when they are rebased, but segments that shared a PosList keep
+  // sharing the copy
+  const auto result = _execute(pipelined_plan);
+  ASSERT_GT(result->chunk_count(), ChunkID{0});
+  for (auto chunk_id = ChunkID{0}; chunk_id < result->chunk_count(); ++chunk_id) {
+    const auto chunk = result->get_chunk(chunk_id);
+    const auto& segment_a = static_cast<const ReferenceSegment&>(*chunk->get_segment(ColumnID{0}));
+    const auto& segment_b = static_cast<const ReferenceSegment&>(*chunk->get_segment(ColumnID{1}));
+    EXPECT_EQ(segment_a.referenced_table(), _table);
+    EXPECT_EQ(segment_a.pos_list(), segment_b.pos_list());
+    for (const auto& row_id : *segment_a.pos_list()) {
+      EXPECT_EQ(row_id.chunk_id, chunk_id);
+    }
+  }
+}
+
+TEST_F(MorselPipelineTest, SameResultAsOperatorAtATime) {
+  for (const auto chunk_size : {ChunkOffset{1}, ChunkOffset{2}, ChunkOffset{3}, Chunk::DEFAULT_SIZE}) {
+    SCOPED_TRACE(std::to_string(chunk_size));
+    const auto table = load_table("resources/test_data/tbl/int_float4.tbl", chunk_size);
+
+    // Data table as input, the output references the input table
+    _expect_same_result([&]() {
+      const auto table_wrapper = std::make_shared<TableWrapper>(table);
+      const auto table_scan = std::make_shared<TableScan>(table_wrapper, greater_than_equals_(_a, 12345));
+      return std::make_shared<TableScan>(table_scan, less_than_(_b, 800));
+    });
+
+    // Reference table as input, computed columns
+    _expect_same_result([&]() {
+      const auto table_wrapper = std::make_shared<TableWrapper>(table);
+      const auto limit = std::make_shared<Limit>(table_wrapper, value_(int64_t{6}));
+      const auto table_scan = std::make_shared<TableScan>(limit, not_equals_(_a, 123));
+      const auto projection = std::make_shared<Projection>(table_scan, expression_vector(add_(_a, 1), _b));
+      const auto a_plus_one = pqp_column_(ColumnID{0}, DataType::Int, false, "a + 1");
+      return std::make_shared<TableScan>(projection, greater_than_(a_plus_one, 200));
+    });
+
+    // Columns that are only nullable in some morsels
+    const auto table_with_null = load_table("resources/test_data/tbl/int_float_with_null.tbl", chunk_size);
+    _expect_same_result([&]() {
+      const auto table_wrapper = std::make_shared<TableWrapper>(table_with_null);
+      const auto a = pqp_column_(ColumnID{0}, DataType::Int, true, "a");
+      const auto projection = std::make_shared<Projection>(table_wrapper, expression_vector(add_(a, 1), a));
+      return std::make_shared<TableScan>(projection, is_not_null_(pqp_column_(ColumnID{1}, DataType::Int, true, "a")));
+    });
+  }
+}
+
+TEST_F(MorselPipelineTest, WithScheduler) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  const auto table = load_table("resources/test_data/tbl/int_float4.tbl", 1);
+  _expect_same_result([&]() {
+    const auto table_wrapper = std::make_shared<TableWrapper>(table);
+    const auto table_scan = std::make_shared<TableScan>(table_wrapper, greater_than_(_a, 100));
+    return std::make_shared<Projection>(table_scan, expression_vector(_b, add_(_a, _a)));
+  });
+}
+
+TEST_F(MorselPipelineTest, EmptyInput) {
+  const auto empty_table = std::make_shared<Table>(_table->column_definitions(), TableType::Data);
+  _expect_same_result([&]() {
+    const auto table_wrapper = std::make_shared<TableWrapper>(empty_table);
+    const auto table_scan = std::make_shared<TableScan>(table_wrapper, greater_than_(_a, 100));
+    return std::make_shared<Projection>(table_scan, expression_vector(add_(_a, 1)));
+  });
+}
+
+TEST_F(MorselPipelineTest, SQLPipeline) {
+  const auto queries = std::vector<std::string>{
+      "SELECT * FROM table_a WHERE a > 1000",
+      "SELECT a, b + 1 AS c FROM table_a WHERE b < 800 AND a > 100",
+      "SELECT a FROM table_a WHERE b IN (SELECT b FROM table_a WHERE a > 12345)",
+      "SELECT a, SUM(b) FROM table_a WHERE b > 400 GROUP BY a"};
+
+  for (const auto& query : queries) {
+    SCOPED_TRACE(query);
+    const auto [expected_status, expected_result] = SQLPipelineBuilder{query}.create_pipeline().get_result_table();
+    ASSERT_EQ(expected_status, SQLPipelineStatus::Success);
+
+    auto sql_pipeline = SQLPipelineBuilder{query}.with_morsel_pipelines(UseMorselPipelines::Yes).create_pipeline();
+    const auto [status, result] = sql_pipeline.get_result_table();
+    ASSERT_EQ(status, SQLPipelineStatus::Success);
+    EXPECT_TABLE_EQ_UNORDERED(result, expected_result);
+  }
+
+  // The first query is executed as a single MorselPipeline consisting of the Validate and the TableScan. Its output
+  // references the output of the GetTable, not the morsels.
+  auto sql_pipeline = SQLPipelineBuilder{queries[0]}
+                          .with_morsel_pipelines(UseMorselPipelines::Yes)
+                          .dont_cleanup_temporaries()
+                          .create_pipeline();
+  const auto& pqp = sql_pipeline.get_physical_plans().at(0);
+  ASSERT_EQ(pqp->type(), OperatorType::MorselPipeline);
+
+  const auto [status, result] = sql_pipeline.get_result_table();
+  ASSERT_EQ(status, SQLPipelineStatus::Success);
+  ASSERT_GT(result->chunk_count(), ChunkID{0});
+  for (auto chunk_id = ChunkID{0}; chunk_id < result->chunk_count(); ++chunk_id) {
+    const auto reference_segment =
+        std::dynamic_pointer_cast<const ReferenceSegment>(result->get_chunk(chunk_id)->get_segment(ColumnID{0}));
+    ASSERT_TRUE(reference_segment);
+    EXPECT_EQ(reference_segment->referenced_table(), pqp->input_left()->get_output());
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,156 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "expression/expression_functional.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "operators/projection.hpp"
+#include "operators/set_operation_hash.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class OperatorsSetOperationHashTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Duplicates, NULLs, and rows that only differ in one column spread over multiple chunks
+    _table_wrapper_left = _make_table_wrapper({{1, pmr_string{"a"}},
+                                               {1, pmr_string{"a"}},
+                                               {1, pmr_string{"a"}},
+                                               {2, pmr_string{"b"}},
+                                               {NULL_VALUE, pmr_string{"c"}},
+                                               {3, pmr_string{"d"}}});
+    _table_wrapper_right = _make_table_wrapper({{1, pmr_string{"a"}},
+                                                {NULL_VALUE, pmr_string{"c"}},
+                                                {4, pmr_string{"e"}},
+                                                {4, pmr_string{"e"}},
+                                                {2, pmr_string{"x"}}});
+  }
+
+  static std::shared_ptr<Table> _make_table(const std::vector<std::vector<AllTypeVariant>>& rows) {
+    const auto column_definitions =
+        TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::String, false}};
+    const auto table = std::make_shared<Table>(column_definitions, TableType::Data, 2);
+    for (const auto& row : rows) {
+      table->append(row);
+    }
+    return table;
+  }
+
+  static std::shared_ptr<TableWrapper> _make_table_wrapper(const std::vector<std::vector<AllTypeVariant>>& rows) {
+    const auto table_wrapper = std::make_shared<TableWrapper>(_make_table(rows));
+    table_wrapper->execute();
+    return table_wrapper;
+  }
+
+  std::shared_ptr<const Table> _execute(const SetOperationType set_operation_type,
+                                        const SetOperationMode set_operation_mode) {
+    const auto set_operation = std::make_shared<SetOperationHash>(_table_wrapper_left, _table_wrapper_right,
+                                                                  set_operation_type, set_operation_mode);
+    set_operation->execute();
+    return set_operation->get_output();
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper_left;
+  std::shared_ptr<TableWrapper> _table_wrapper_right;
+};
+
+TEST_F(OperatorsSetOperationHashTest, Except) {
+  const auto expected_distinct = _make_table({{2, pmr_string{"b"}}, {3, pmr_string{"d"}}});
+  EXPECT_TABLE_EQ_ORDERED(_execute(SetOperationType::Except, SetOperationMode::Distinct), expected_distinct);
+
+  const auto expected_all =
+      _make_table({{1, pmr_string{"a"}}, {1, pmr_string{"a"}}, {2, pmr_string{"b"}}, {3, pmr_string{"d"}}});
+  EXPECT_TABLE_EQ_ORDERED(_execute(SetOperationType::Except, SetOperationMode::All), expected_all);
+}
+
+TEST_F(OperatorsSetOperationHashTest, Intersect) {
+  const auto expected = _make_table({{1, pmr_string{"a"}}, {NULL_VALUE, pmr_string{"c"}}});
+  EXPECT_TABLE_EQ_ORDERED(_execute(SetOperationType::Intersect, SetOperationMode::Distinct), expected);
+  EXPECT_TABLE_EQ_ORDERED(_execute(SetOperationType::Intersect, SetOperationMode::All), expected);
+}
+
+TEST_F(OperatorsSetOperationHashTest, Union) {
+  const auto expected_distinct = _make_table({{1, pmr_string{"a"}},
+                                              {2, pmr_string{"b"}},
+                                              {NULL_VALUE, pmr_string{"c"}},
+                                              {3, pmr_string{"d"}},
+                                              {4, pmr_string{"e"}},
+                                              {2, pmr_string{"x"}}});
+  EXPECT_TABLE_EQ_ORDERED(_execute(SetOperationType::Union, SetOperationMode::Distinct), expected_distinct);
+
+  const auto expected_all = _make_table({{1, pmr_string{"a"}},
+                                         {1, pmr_string{"a"}},
+                                         {1, pmr_string{"a"}},
+                                         {2, pmr_string{"b"}},
+                                         {NULL_VALUE, pmr_string{"c"}},
+                                         {3, pmr_string{"d"}},
+                                         {1, pmr_string{"a"}},
+                                         {NULL_VALUE, pmr_string{"c"}},
+                                         {4, pmr_string{"e"}},
+                                         {4, pmr_string{"e"}},
+                                         {2, pmr_string{"x"}}});
+  EXPECT_TABLE_EQ_ORDERED(_execute(SetOperationType::Union, SetOperationMode::All), expected_all);
+}
+
+TEST_F(OperatorsSetOperationHashTest, ReferenceInputs) {
+  const auto a = PQPColumnExpression::from_table(*_table_wrapper_left->get_output(), "a");
+  const auto b = PQPColumnExpression::from_table(*_table_wrapper_left->get_output(), "b");
+
+  const auto projection_left = std::make_shared<Projection>(_table_wrapper_left, expression_vector(b, a));
+  projection_left->execute();
+  const auto projection_right = std::make_shared<Projection>(_table_wrapper_right, expression_vector(b, a));
+  projection_right->execute();
+
+  const auto set_operation = std::make_shared<SetOperationHash>(projection_left, projection_right,
+                                                                SetOperationType::Except, SetOperationMode::All);
+  set_operation->execute();
+
+  const auto expected = std::make_shared<Table>(
+      TableColumnDefinitions{{"b", DataType::String, false}, {"a", DataType::Int, true}}, TableType::Data);
+  expected->append({pmr_string{"a"}, 1});
+  expected->append({pmr_string{"a"}, 1});
+  expected->append({pmr_string{"b"}, 2});
+  expected->append({pmr_string{"d"}, 3});
+
+  EXPECT_TABLE_EQ_ORDERED(set_operation->get_output(), expected);
+}
+
+TEST_F(OperatorsSetOperationHashTest, EmptyInputs) {
+  const auto empty = _make_table_wrapper({});
+
+  const auto except = std::make_shared<SetOperationHash>(_table_wrapper_left, empty, SetOperationType::Except,
+                                                         SetOperationMode::Distinct);
+  except->execute();
+  EXPECT_EQ(except->get_output()->row_count(), 4u);
+
+  const auto intersect = std::make_shared<SetOperationHash>(empty, _table_wrapper_right, SetOperationType::Intersect,
+                                                            SetOperationMode::All);
+  intersect->execute();
+  EXPECT_EQ(intersect->get_output()->row_count(), 0u);
+}
+
+TEST_F(OperatorsSetOperationHashTest, ThrowsForMismatchingInputs) {
+  const auto int_float = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int_float.tbl", 2));
+  int_float->execute();
+
+  const auto set_operation = std::make_shared<SetOperationHash>(_table_wrapper_left, int_float,
+                                                                SetOperationType::Union, SetOperationMode::Distinct);
+  EXPECT_THROW(set_operation->execute(), std::logic_error);
+}
+
+TEST_F(OperatorsSetOperationHashTest, Description) {
+  const auto set_operation = std::make_shared<SetOperationHash>(_table_wrapper_left, _table_wrapper_right,
+                                                                SetOperationType::Intersect, SetOperationMode::All);
+  EXPECT_EQ(set_operation->description(), "SetOperationHash (Intersect All)");
+  EXPECT_EQ(set_operation->description(DescriptionMode::MultiLine), "SetOperationHash\n(Intersect All)");
+}
+
+}  // namespace opossum
@@ -5,6 +5,8 @@
 #include "base_test.hpp"
 #include "gtest/gtest.h"
 
+#include "hyrise.hpp"
+
 #include "operators/abstract_read_only_operator.hpp"
 #include "operators/join_nested_loop.hpp"
 #include "operators/print.hpp"
@@ -12,6 +14,7 @@
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
 #include "operators/union_all.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
@@ -52,6 +55,42 @@ class OperatorsSortTest : public BaseTestWithParam<EncodingType> {
   EncodingType _encoding_type;
 };
 
+class OperatorsSortMultiColumnTest : public BaseTestWithParam<EncodingType> {
+ protected:
+  void SetUp() override {
+    _table = load_table("resources/test_data/tbl/sort_multi_column.tbl", 2);
+
+    auto encoded_table = load_table("resources/test_data/tbl/sort_multi_column.tbl", 2);
+    ChunkEncoder::encode_all_chunks(encoded_table, GetParam());
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+    _encoded_table_wrapper = std::make_shared<TableWrapper>(encoded_table);
+    _encoded_table_wrapper->execute();
+  }
+
+  // Returns a table with the rows of the input table in the given order
+  std::shared_ptr<Table> _rows(const std::vector<size_t>& row_indices) const {
+    auto expected_table = std::make_shared<Table>(_table->column_definitions(), TableType::Data);
+    for (const auto row_idx : row_indices) {
+      expected_table->append(_table->get_row(row_idx));
+    }
+    return expected_table;
+  }
+
+  void _expect_sorted(const std::vector<SortColumnDefinition>& sort_definitions,
+                      const std::vector<size_t>& expected_row_indices) const {
+    for (const auto& table_wrapper : {_table_wrapper, _encoded_table_wrapper}) {
+      const auto sort = std::make_shared<Sort>(table_wrapper, sort_definitions, 2u);
+      sort->execute();
+      EXPECT_TABLE_EQ_ORDERED(sort->get_output(), _rows(expected_row_indices));
+    }
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper, _encoded_table_wrapper;
+};
+
 auto formatter = [](const ::testing::TestParamInfo<EncodingType> info) {
   return std::to_string(static_cast<uint32_t>(info.param));
 };
@@ -59,6 +98,9 @@ auto formatter = [](const ::testing::TestParamInfo<EncodingType> info) {
 // As long as two implementation of dictionary encoding exist, this ensure to run the tests for both.
 INSTANTIATE_TEST_SUITE_P(DictionaryEncodingTypes, OperatorsSortTest, ::testing::Values(EncodingType::Dictionary),
                          formatter);
+INSTANTIATE_TEST_SUITE_P(EncodingTypes, OperatorsSortMultiColumnTest,
+                         ::testing::Values(EncodingType::Dictionary, EncodingType::RunLength, EncodingType::LZ4),
+                         formatter);
 
 TEST_P(OperatorsSortTest, AscendingSortOfOneColumn) {
   std::shared_ptr<Table> expected_result = load_table("resources/test_data/tbl/int_float_sorted.tbl", 2);
@@ -236,4 +278,64 @@ TEST_P(OperatorsSortTest, SortAfterOuterJoin) {
   EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_result);
 }
 
+TEST_P(OperatorsSortTest, SortOfEmptyChunks) {
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data);
+  table->append_chunk({std::make_shared<ValueSegment<int32_t>>()});
+  table->append_chunk({std::make_shared<ValueSegment<int32_t>>()});
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto sort = std::make_shared<Sort>(table_wrapper, ColumnID{0}, OrderByMode::Ascending);
+  sort->execute();
+
+  EXPECT_EQ(sort->get_output()->row_count(), 0u);
+}
+
+TEST_P(OperatorsSortMultiColumnTest, MixedOrderByModes) {
+  _expect_sorted({SortColumnDefinition{ColumnID{0}, OrderByMode::Ascending},
+                  SortColumnDefinition{ColumnID{1}, OrderByMode::Descending},
+                  SortColumnDefinition{ColumnID{3}, OrderByMode::AscendingNullsLast}},
+                 {3, 4, 1, 0, 5, 2});
+  _expect_sorted({SortColumnDefinition{ColumnID{2}, OrderByMode::Descending},
+                  SortColumnDefinition{ColumnID{3}, OrderByMode::DescendingNullsLast}},
+                 {1, 2, 4, 5, 0, 3});
+}
+
+TEST_P(OperatorsSortMultiColumnTest, NegativeNumbersAndStability) {
+  // 0.0 and -0.0 are equal, so the rows keep their input order
+  _expect_sorted({SortColumnDefinition{ColumnID{1}, OrderByMode::Ascending}}, {2, 1, 3, 4, 0, 5});
+  _expect_sorted({SortColumnDefinition{ColumnID{2}, OrderByMode::Ascending}}, {3, 0, 5, 4, 2, 1});
+  _expect_sorted({SortColumnDefinition{ColumnID{0}, OrderByMode::DescendingNullsLast}}, {0, 2, 5, 1, 4, 3});
+}
+
+TEST_P(OperatorsSortMultiColumnTest, StringPrefixes) {
+  _expect_sorted({SortColumnDefinition{ColumnID{3}, OrderByMode::Ascending}}, {2, 3, 1, 0, 4, 5});
+  _expect_sorted({SortColumnDefinition{ColumnID{3}, OrderByMode::Descending}}, {2, 5, 4, 0, 1, 3});
+  _expect_sorted({SortColumnDefinition{ColumnID{3}, OrderByMode::AscendingNullsLast}}, {3, 1, 0, 4, 5, 2});
+}
+
+TEST_P(OperatorsSortMultiColumnTest, WithScheduler) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  _expect_sorted({SortColumnDefinition{ColumnID{0}, OrderByMode::Ascending},
+                  SortColumnDefinition{ColumnID{1}, OrderByMode::Descending},
+                  SortColumnDefinition{ColumnID{3}, OrderByMode::AscendingNullsLast}},
+                 {3, 4, 1, 0, 5, 2});
+}
+
+TEST_P(OperatorsSortMultiColumnTest, OutputIsOrderedByPrimaryColumn) {
+  const auto sort = std::make_shared<Sort>(
+      _table_wrapper,
+      std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{2}, OrderByMode::Descending},
+                                        SortColumnDefinition{ColumnID{0}}},
+      4u);
+  sort->execute();
+
+  const auto& output = sort->get_output();
+  EXPECT_EQ(output->chunk_count(), ChunkID{2});
+  EXPECT_EQ(output->get_chunk(ChunkID{0})->ordered_by(), std::make_pair(ColumnID{2}, OrderByMode::Descending));
+  EXPECT_EQ(output->get_chunk(ChunkID{1})->ordered_by(), std::make_pair(ColumnID{2}, OrderByMode::Descending));
+}
+
 }  // namespace opossum
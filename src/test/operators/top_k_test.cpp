@@ -0,0 +1,152 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "operators/limit.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/generate_pruning_statistics.hpp"
+#include "statistics/statistics_objects/min_max_filter.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class OperatorsTopKTest : public BaseTest {
+ protected:
+  static std::shared_ptr<AbstractOperator> _wrap(const std::shared_ptr<Table>& table) {
+    const auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+    return table_wrapper;
+  }
+
+  // TopK has to return the same result as the stable Sort followed by a Limit
+  static void _expect_same_as_sort_and_limit(const std::shared_ptr<AbstractOperator>& input, const ColumnID column_id) {
+    const auto order_by_modes = std::vector<OrderByMode>{OrderByMode::Ascending, OrderByMode::Descending,
+                                                         OrderByMode::AscendingNullsLast,
+                                                         OrderByMode::DescendingNullsLast};
+
+    for (const auto order_by_mode : order_by_modes) {
+      for (const auto k : {int64_t{0}, int64_t{1}, int64_t{2}, int64_t{3}, int64_t{5}, int64_t{100}}) {
+        SCOPED_TRACE(std::to_string(k) + " rows " + order_by_mode_to_string.left.at(order_by_mode));
+
+        const auto sort = std::make_shared<Sort>(input, column_id, order_by_mode);
+        sort->execute();
+        const auto limit = std::make_shared<Limit>(sort, value_(k));
+        limit->execute();
+
+        const auto top_k = std::make_shared<TopK>(input, column_id, order_by_mode, value_(k), 2u);
+        top_k->execute();
+
+        EXPECT_TABLE_EQ_ORDERED(top_k->get_output(), limit->get_output());
+      }
+    }
+  }
+};
+
+TEST_F(OperatorsTopKTest, SameResultAsSortAndLimit) {
+  for (const auto chunk_size : {ChunkOffset{1}, ChunkOffset{2}, ChunkOffset{3}, Chunk::DEFAULT_SIZE}) {
+    const auto input = _wrap(load_table("resources/test_data/tbl/int_float4.tbl", chunk_size));
+    _expect_same_as_sort_and_limit(input, ColumnID{0});
+    _expect_same_as_sort_and_limit(input, ColumnID{1});
+
+    _expect_same_as_sort_and_limit(_wrap(load_table("resources/test_data/tbl/int_float_with_null.tbl", chunk_size)),
+                                   ColumnID{0});
+    _expect_same_as_sort_and_limit(_wrap(load_table("resources/test_data/tbl/int_string.tbl", chunk_size)),
+                                   ColumnID{1});
+  }
+}
+
+TEST_F(OperatorsTopKTest, ReferenceSegments) {
+  const auto input = _wrap(load_table("resources/test_data/tbl/int_float4.tbl", 2));
+  const auto scan = create_table_scan(input, ColumnID{0}, PredicateCondition::NotEquals, 123);
+  scan->execute();
+
+  _expect_same_as_sort_and_limit(scan, ColumnID{0});
+  _expect_same_as_sort_and_limit(scan, ColumnID{1});
+}
+
+TEST_F(OperatorsTopKTest, WithScheduler) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  _expect_same_as_sort_and_limit(_wrap(load_table("resources/test_data/tbl/int_float4.tbl", 1)), ColumnID{0});
+  _expect_same_as_sort_and_limit(_wrap(load_table("resources/test_data/tbl/int_float_with_null.tbl", 1)), ColumnID{0});
+}
+
+TEST_F(OperatorsTopKTest, OutputIsOrdered) {
+  const auto top_k = std::make_shared<TopK>(_wrap(load_table("resources/test_data/tbl/int_float4.tbl", 2)),
+                                            ColumnID{1}, OrderByMode::Descending, value_(int64_t{5}), 2u);
+  top_k->execute();
+
+  const auto& output = top_k->get_output();
+  EXPECT_EQ(output->row_count(), 5u);
+  EXPECT_EQ(output->chunk_count(), ChunkID{3});
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    EXPECT_EQ(output->get_chunk(chunk_id)->ordered_by(), std::make_pair(ColumnID{1}, OrderByMode::Descending));
+  }
+}
+
+TEST_F(OperatorsTopKTest, OnlyFirstRowsOfOrderedChunksAreScanned) {
+  // The chunk claims to be sorted, so only its first two rows (12345 and 123456) are candidates
+  const auto table = load_table("resources/test_data/tbl/int_float4.tbl");
+  table->get_chunk(ChunkID{0})->set_ordered_by(std::make_pair(ColumnID{0}, OrderByMode::Ascending));
+
+  const auto top_k = std::make_shared<TopK>(_wrap(table), ColumnID{0}, OrderByMode::Ascending, value_(int64_t{2}));
+  top_k->execute();
+
+  const auto& output = top_k->get_output();
+  ASSERT_EQ(output->row_count(), 2u);
+  EXPECT_EQ(output->get_value<int32_t>(ColumnID{0}, 0u), 12345);
+  EXPECT_EQ(output->get_value<int32_t>(ColumnID{0}, 1u), 123456);
+}
+
+TEST_F(OperatorsTopKTest, ChunksArePrunedBasedOnStatistics) {
+  // Chunks: {12345, 123456}, {12345, 123456}, {123, 12}, {123456}
+  const auto table = load_table("resources/test_data/tbl/int_float4.tbl", 2);
+  generate_chunk_pruning_statistics(table);
+
+  // The accurate statistics do not lead to pruning the chunk that holds the best rows
+  auto top_k = std::make_shared<TopK>(_wrap(table), ColumnID{0}, OrderByMode::Ascending, value_(int64_t{2}));
+  top_k->execute();
+  ASSERT_EQ(top_k->get_output()->row_count(), 2u);
+  EXPECT_EQ(top_k->get_output()->get_value<int32_t>(ColumnID{0}, 0u), 12);
+  EXPECT_EQ(top_k->get_output()->get_value<int32_t>(ColumnID{0}, 1u), 123);
+
+  // Pretend that the third chunk only holds values that are larger than those of the first chunk. As the first chunk
+  // already holds two rows, the third chunk is skipped.
+  const auto chunk = table->get_chunk(ChunkID{2});
+  auto pruning_statistics = *chunk->pruning_statistics();
+  const auto segment_statistics = std::make_shared<AttributeStatistics<int32_t>>();
+  segment_statistics->set_statistics_object(std::make_shared<MinMaxFilter<int32_t>>(200'000, 200'000));
+  pruning_statistics[ColumnID{0}] = segment_statistics;
+  chunk->set_pruning_statistics(pruning_statistics);
+
+  top_k = std::make_shared<TopK>(_wrap(table), ColumnID{0}, OrderByMode::Ascending, value_(int64_t{2}));
+  top_k->execute();
+  ASSERT_EQ(top_k->get_output()->row_count(), 2u);
+  EXPECT_EQ(top_k->get_output()->get_value<int32_t>(ColumnID{0}, 0u), 12345);
+  EXPECT_EQ(top_k->get_output()->get_value<int32_t>(ColumnID{0}, 1u), 12345);
+}
+
+TEST_F(OperatorsTopKTest, DeepCopy) {
+  const auto top_k = std::make_shared<TopK>(_wrap(load_table("resources/test_data/tbl/int_float4.tbl", 2)),
+                                            ColumnID{0}, OrderByMode::Descending, value_(int64_t{3}));
+  const auto copy = std::dynamic_pointer_cast<TopK>(top_k->deep_copy());
+  ASSERT_TRUE(copy);
+  EXPECT_EQ(copy->column_id(), ColumnID{0});
+  EXPECT_EQ(copy->order_by_mode(), OrderByMode::Descending);
+  EXPECT_EQ(*copy->row_count_expression(), *value_(int64_t{3}));
+}
+
+}  // namespace opossum
@@ -239,4 +239,58 @@ TEST_F(OperatorsValidateTest, ValidateReferenceSegmentWithMultipleChunks) {
   EXPECT_TABLE_EQ_UNORDERED(validate->get_output(), expected_result);
 }
 
+TEST_F(OperatorsValidateTest, ValidateContiguousMvccData) {
+  // Finalized chunks have contiguous MVCC data, which Validate checks in blocks of rows. Use enough rows to have
+  // multiple blocks and a remainder.
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                             Chunk::DEFAULT_SIZE, UseMvcc::Yes);
+  const auto row_count = 45;
+  for (auto value = 0; value < row_count; ++value) {
+    table->append({value});
+  }
+  table->last_chunk()->finalize();
+
+  const auto our_tid = TransactionID{7};
+  const auto snapshot_commit_id = CommitID{3};
+  auto expected_values = std::vector<int32_t>{};
+  {
+    auto mvcc_data = table->get_chunk(ChunkID{0})->get_scoped_mvcc_data_lock();
+    ASSERT_TRUE(mvcc_data->contiguous_columns());
+
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(row_count); ++chunk_offset) {
+      // Rows 8 to 15 are deleted, rows 16 to 23 are inserted in the future. Rows 24 to 31 are our own inserts and
+      // every fifth row is deleted by a past transaction.
+      if (chunk_offset >= 8 && chunk_offset < 16) {
+        mvcc_data->set_end_cid(chunk_offset, CommitID{1});
+      } else if (chunk_offset >= 16 && chunk_offset < 24) {
+        mvcc_data->set_begin_cid(chunk_offset, CommitID{5});
+      } else if (chunk_offset >= 24 && chunk_offset < 32) {
+        mvcc_data->tids[chunk_offset] = our_tid;
+        mvcc_data->set_begin_cid(chunk_offset, MvccData::MAX_COMMIT_ID);
+      } else if (chunk_offset % 5 == 0) {
+        mvcc_data->set_end_cid(chunk_offset, CommitID{2});
+      }
+
+      if (Validate::is_row_visible(our_tid, snapshot_commit_id, mvcc_data->tids[chunk_offset],
+                                   mvcc_data->get_begin_cid(chunk_offset), mvcc_data->get_end_cid(chunk_offset))) {
+        expected_values.emplace_back(static_cast<int32_t>(chunk_offset));
+      }
+    }
+  }
+  table->get_chunk(ChunkID{0})->increase_invalid_row_count(8);
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  auto validate = std::make_shared<Validate>(table_wrapper);
+  validate->set_transaction_context(std::make_shared<TransactionContext>(our_tid, snapshot_commit_id));
+  validate->execute();
+
+  const auto& output = validate->get_output();
+  auto values = std::vector<int32_t>{};
+  for (auto row_number = size_t{0}; row_number < output->row_count(); ++row_number) {
+    values.emplace_back(output->get_value<int32_t>(ColumnID{0}, row_number));
+  }
+  EXPECT_EQ(values, expected_values);
+}
+
 }  // namespace opossum
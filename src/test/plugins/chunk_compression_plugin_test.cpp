@@ -0,0 +1,159 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../../plugins/chunk_compression_plugin.hpp"
+#include "../utils/plugin_test_utils.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "hyrise.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/base_encoded_segment.hpp"
+#include "storage/base_value_segment.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/table.hpp"
+#include "utils/plugin_manager.hpp"
+
+namespace opossum {
+
+class ChunkCompressionPluginTest : public BaseTest {
+ public:
+  void SetUp() override {
+    _column_definitions = TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::String, true}};
+    _table = std::make_shared<Table>(_column_definitions, TableType::Data, ChunkOffset{3}, UseMvcc::Yes);
+    Hyrise::get().storage_manager.add_table(_table_name, _table);
+  }
+
+  void TearDown() override { Hyrise::reset(); }
+
+ protected:
+  // Inserts @param row_count rows into the test table and returns the (neither committed nor rolled back) transaction
+  std::shared_ptr<TransactionContext> _insert(const size_t row_count) {
+    const auto values = std::make_shared<Table>(_column_definitions, TableType::Data);
+    for (auto row_id = size_t{0}; row_id < row_count; ++row_id) {
+      values->append({static_cast<int32_t>(row_id), pmr_string{"value" + std::to_string(row_id)}});
+    }
+
+    const auto table_wrapper = std::make_shared<TableWrapper>(values);
+    table_wrapper->execute();
+
+    const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context();
+    const auto insert = std::make_shared<Insert>(_table_name, table_wrapper);
+    insert->set_transaction_context(transaction_context);
+    insert->execute();
+    return transaction_context;
+  }
+
+  void _compression_loop() { _plugin._compression_loop(); }
+
+  bool _is_encoded(const ChunkID chunk_id) const {
+    const auto chunk = _table->get_chunk(chunk_id);
+    for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+      if (std::dynamic_pointer_cast<const BaseValueSegment>(chunk->get_segment(column_id))) return false;
+    }
+    return true;
+  }
+
+  EncodingType _encoding_type(const ChunkID chunk_id, const ColumnID column_id) const {
+    const auto segment = _table->get_chunk(chunk_id)->get_segment(column_id);
+    const auto encoded_segment = std::dynamic_pointer_cast<const BaseEncodedSegment>(segment);
+    return encoded_segment ? encoded_segment->encoding_type() : EncodingType::Unencoded;
+  }
+
+  const std::string _table_name{"compressionTestTable"};
+  TableColumnDefinitions _column_definitions;
+  std::shared_ptr<Table> _table;
+  ChunkCompressionPlugin _plugin;
+};
+
+TEST_F(ChunkCompressionPluginTest, LoadUnloadPlugin) {
+  auto& pm = Hyrise::get().plugin_manager;
+  pm.load_plugin(build_dylib_path("libChunkCompressionPlugin"));
+  pm.unload_plugin("ChunkCompressionPlugin");
+}
+
+TEST_F(ChunkCompressionPluginTest, CompressesCompletedChunks) {
+  _insert(7)->commit();
+  ASSERT_EQ(_table->chunk_count(), 3);
+
+  _compression_loop();
+
+  // The two full chunks are finalized and encoded, the last chunk is still used for inserts
+  for (const auto chunk_id : {ChunkID{0}, ChunkID{1}}) {
+    const auto chunk = _table->get_chunk(chunk_id);
+    EXPECT_FALSE(chunk->is_mutable());
+    EXPECT_TRUE(_is_encoded(chunk_id));
+    EXPECT_EQ(_encoding_type(chunk_id, ColumnID{0}), EncodingType::Dictionary);
+    EXPECT_TRUE(chunk->pruning_statistics());
+  }
+  EXPECT_TRUE(_table->get_chunk(ChunkID{2})->is_mutable());
+  EXPECT_FALSE(_is_encoded(ChunkID{2}));
+
+  // Subsequent inserts go to the mutable chunk and then to a new one
+  _insert(3)->commit();
+  EXPECT_EQ(_table->chunk_count(), 4);
+  EXPECT_EQ(_table->row_count(), 10);
+  EXPECT_EQ(_table->get_value<int32_t>(ColumnID{0}, 4), 4);
+  EXPECT_EQ(_table->get_value<pmr_string>(ColumnID{1}, 9), "value2");
+
+  _compression_loop();
+  EXPECT_TRUE(_is_encoded(ChunkID{2}));
+  EXPECT_FALSE(_is_encoded(ChunkID{3}));
+}
+
+TEST_F(ChunkCompressionPluginTest, DoesNotCompressChunksWithPendingInserts) {
+  const auto pending_transaction_context = _insert(3);
+  const auto rolled_back_transaction_context = _insert(3);
+  ASSERT_EQ(_table->chunk_count(), 2);
+
+  _compression_loop();
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_TRUE(_table->get_chunk(ChunkID{1})->is_mutable());
+
+  // Rolled back rows are never going to be written to again
+  rolled_back_transaction_context->rollback();
+  _compression_loop();
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_FALSE(_table->get_chunk(ChunkID{1})->is_mutable());
+  EXPECT_TRUE(_is_encoded(ChunkID{1}));
+
+  pending_transaction_context->commit();
+  _compression_loop();
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_TRUE(_is_encoded(ChunkID{0}));
+}
+
+TEST_F(ChunkCompressionPluginTest, PerTableChunkEncodingSpec) {
+  _plugin.set_chunk_encoding_spec(_table_name, {EncodingType::RunLength, EncodingType::Unencoded});
+  _insert(3)->commit();
+
+  _compression_loop();
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{0}), EncodingType::RunLength);
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{1}), EncodingType::Unencoded);
+
+  // Chunks that are to remain unencoded are not touched at all
+  _plugin.set_chunk_encoding_spec(_table_name, {EncodingType::Unencoded, EncodingType::Unencoded});
+  _insert(3)->commit();
+
+  _compression_loop();
+  EXPECT_TRUE(_table->get_chunk(ChunkID{1})->is_mutable());
+}
+
+TEST_F(ChunkCompressionPluginTest, KeepsEncodingOfTable) {
+  _insert(3)->commit();
+  const auto first_chunk = _table->get_chunk(ChunkID{0});
+  first_chunk->finalize();
+  ChunkEncoder::encode_chunk(first_chunk, _table->column_data_types(),
+                             ChunkEncodingSpec{EncodingType::FrameOfReference, EncodingType::LZ4});
+
+  _insert(3)->commit();
+  _compression_loop();
+  EXPECT_EQ(_encoding_type(ChunkID{1}, ColumnID{0}), EncodingType::FrameOfReference);
+  EXPECT_EQ(_encoding_type(ChunkID{1}, ColumnID{1}), EncodingType::LZ4);
+}
+
+}  // namespace opossum
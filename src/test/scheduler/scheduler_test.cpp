@@ -1,4 +1,6 @@
+#include <chrono>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -13,6 +15,8 @@
 #include "scheduler/job_task.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "scheduler/task_queue.hpp"
+#include "scheduler/worker.hpp"
 
 using namespace opossum::expression_functional;  // NOLINT
 
@@ -125,6 +129,21 @@ TEST_F(SchedulerTest, BasicTest) {
   Hyrise::get().set_scheduler(std::make_shared<ImmediateExecutionScheduler>());
 }
 
+TEST_F(SchedulerTest, BasicTestWithWorkerDeques) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>(UseWorkerDeques::Yes));
+
+  std::atomic_uint counter{0};
+
+  increment_counter_in_subtasks(counter);
+
+  Hyrise::get().scheduler()->finish();
+
+  ASSERT_EQ(counter, 30u);
+
+  Hyrise::get().set_scheduler(std::make_shared<ImmediateExecutionScheduler>());
+}
+
 TEST_F(SchedulerTest, BasicTestWithoutScheduler) {
   std::atomic_uint counter{0};
   increment_counter_in_subtasks(counter);
@@ -170,6 +189,52 @@ TEST_F(SchedulerTest, DiamondDependenciesWithScheduler) {
   ASSERT_EQ(counter, 7u);
 }
 
+TEST_F(SchedulerTest, DependenciesWithWorkerDeques) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 2);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>(UseWorkerDeques::Yes));
+
+  std::atomic_uint linear_counter{0u};
+  std::atomic_uint multiple_counter{0u};
+  std::atomic_uint diamond_counter{0u};
+
+  // Schedule the dependent tasks from within a worker so that they are pushed to the worker's deque
+  auto task = std::make_shared<JobTask>([&]() {
+    stress_linear_dependencies(linear_counter);
+    stress_multiple_dependencies(multiple_counter);
+    stress_diamond_dependencies(diamond_counter);
+  });
+  task->schedule();
+
+  Hyrise::get().scheduler()->finish();
+
+  ASSERT_EQ(linear_counter, 3u);
+  ASSERT_EQ(multiple_counter, 4u);
+  ASSERT_EQ(diamond_counter, 7u);
+}
+
+TEST_F(SchedulerTest, WorkerDequesWithManyJobs) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>(UseWorkerDeques::Yes));
+
+  std::atomic_uint counter{0};
+
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto task_idx = 0; task_idx < 8; ++task_idx) {
+    tasks.emplace_back(std::make_shared<JobTask>([&]() {
+      auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+      for (auto job_idx = 0; job_idx < 1'000; ++job_idx) {
+        jobs.emplace_back(std::make_shared<JobTask>([&]() { ++counter; }));
+      }
+      Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+
+  EXPECT_EQ(counter, 8'000u);
+
+  Hyrise::get().scheduler()->finish();
+}
+
 TEST_F(SchedulerTest, LinearDependenciesWithoutScheduler) {
   std::atomic_uint counter{0u};
   stress_linear_dependencies(counter);
@@ -257,4 +322,40 @@ TEST_F(SchedulerTest, SingleWorkerGuaranteeProgress) {
   Hyrise::get().scheduler()->finish();
 }
 
+TEST_F(SchedulerTest, IdleWorkersAreParkedAndUnparked) {
+  Hyrise::get().topology.use_fake_numa_topology(4, 2);
+  const auto node_queue_scheduler = std::make_shared<NodeQueueScheduler>();
+  Hyrise::get().set_scheduler(node_queue_scheduler);
+
+  const auto num_parked_workers = [&]() {
+    auto num_parked_workers = size_t{0};
+    for (const auto& queue : node_queue_scheduler->queues()) {
+      num_parked_workers += queue->num_parked_workers();
+    }
+    return num_parked_workers;
+  };
+
+  // Without any work, all workers park themselves after spinning for a few microseconds
+  const auto num_workers = Hyrise::get().topology.num_cpus();
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (num_parked_workers() < num_workers && std::chrono::steady_clock::now() < timeout) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(num_parked_workers(), num_workers);
+
+  auto task_done = std::atomic_bool{false};
+  auto task = std::make_shared<JobTask>([&]() { task_done = true; });
+  task->schedule();
+  Hyrise::get().scheduler()->wait_for_tasks(std::vector<std::shared_ptr<AbstractTask>>{task});
+  EXPECT_TRUE(task_done);
+
+  auto num_wakeups = uint64_t{0};
+  for (const auto& worker : node_queue_scheduler->workers()) {
+    num_wakeups += worker->num_wakeups();
+  }
+  EXPECT_GE(num_wakeups, 1u);
+
+  Hyrise::get().scheduler()->finish();
+}
+
 }  // namespace opossum
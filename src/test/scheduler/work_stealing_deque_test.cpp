@@ -0,0 +1,118 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "scheduler/job_task.hpp"
+#include "scheduler/work_stealing_deque.hpp"
+
+namespace opossum {
+
+class WorkStealingDequeTest : public BaseTest {};
+
+TEST_F(WorkStealingDequeTest, PopIsLifoAndStealIsFifo) {
+  auto deque = WorkStealingDeque{};
+  EXPECT_TRUE(deque.empty());
+  EXPECT_EQ(deque.pop(), nullptr);
+  EXPECT_EQ(deque.steal(), nullptr);
+
+  const auto task_a = std::make_shared<JobTask>([]() {});
+  const auto task_b = std::make_shared<JobTask>([]() {});
+  const auto task_c = std::make_shared<JobTask>([]() {});
+
+  deque.push(task_a);
+  deque.push(task_b);
+  deque.push(task_c);
+  EXPECT_EQ(deque.size(), 3u);
+
+  EXPECT_EQ(deque.pop(), task_c);
+  EXPECT_EQ(deque.steal(), task_a);
+  EXPECT_EQ(deque.pop(), task_b);
+  EXPECT_TRUE(deque.empty());
+  EXPECT_EQ(deque.pop(), nullptr);
+  EXPECT_EQ(deque.steal(), nullptr);
+}
+
+TEST_F(WorkStealingDequeTest, Grow) {
+  auto deque = WorkStealingDeque{4};
+
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto task_idx = 0; task_idx < 100; ++task_idx) {
+    tasks.emplace_back(std::make_shared<JobTask>([]() {}));
+    deque.push(tasks.back());
+  }
+  EXPECT_EQ(deque.size(), 100u);
+
+  for (auto task_idx = 0; task_idx < 50; ++task_idx) {
+    EXPECT_EQ(deque.steal(), tasks[task_idx]);
+  }
+  for (auto task_idx = 99; task_idx >= 50; --task_idx) {
+    EXPECT_EQ(deque.pop(), tasks[task_idx]);
+  }
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST_F(WorkStealingDequeTest, ReleasesRemainingTasks) {
+  auto task = std::make_shared<JobTask>([]() {});
+  {
+    auto deque = WorkStealingDeque{};
+    deque.push(task);
+    EXPECT_EQ(task.use_count(), 2);
+  }
+  EXPECT_EQ(task.use_count(), 1);
+}
+
+TEST_F(WorkStealingDequeTest, ConcurrentSteals) {
+  // The owner pushes and pops while several thieves steal. Every task must be taken out exactly once.
+  constexpr auto NUM_TASKS = 10'000;
+  constexpr auto NUM_THIEVES = 4;
+
+  auto deque = WorkStealingDeque{16};
+  auto execution_counts = std::vector<std::atomic_uint>(NUM_TASKS);
+  auto tasks_taken = std::atomic_uint{0};
+
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  tasks.reserve(NUM_TASKS);
+  for (auto task_idx = 0; task_idx < NUM_TASKS; ++task_idx) {
+    tasks.emplace_back(std::make_shared<JobTask>([&, task_idx]() { ++execution_counts[task_idx]; }));
+  }
+
+  auto thieves = std::vector<std::thread>{};
+  for (auto thief_idx = 0; thief_idx < NUM_THIEVES; ++thief_idx) {
+    thieves.emplace_back([&]() {
+      while (tasks_taken < NUM_TASKS) {
+        const auto task = deque.steal();
+        if (!task) continue;
+        task->schedule();
+        ++tasks_taken;
+      }
+    });
+  }
+
+  for (auto task_idx = 0; task_idx < NUM_TASKS; ++task_idx) {
+    deque.push(tasks[task_idx]);
+    if (task_idx % 3 == 0) {
+      const auto task = deque.pop();
+      if (!task) continue;
+      task->schedule();
+      ++tasks_taken;
+    }
+  }
+  while (const auto task = deque.pop()) {
+    task->schedule();
+    ++tasks_taken;
+  }
+
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  EXPECT_EQ(tasks_taken, NUM_TASKS);
+  for (const auto& execution_count : execution_counts) {
+    EXPECT_EQ(execution_count, 1u);
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,110 @@
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "sql/parameterized_plan.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "sql/sql_pipeline_statement.hpp"
+#include "sql/sql_plan_cache.hpp"
+
+namespace opossum {
+
+class ParameterizedPlanTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_float.tbl", 2));
+    _cache = std::make_shared<SQLParameterizedPlanCache>();
+  }
+
+  static std::shared_ptr<AbstractLQPNode> _translate(const std::string& sql) {
+    return SQLPipelineBuilder{sql}.disable_mvcc().create_pipeline_statement().get_unoptimized_logical_plan();
+  }
+
+  std::shared_ptr<SQLPipelineStatementMetrics> _execute(const std::string& sql,
+                                                        const std::shared_ptr<const Table>& expected_table) {
+    auto pipeline_statement =
+        SQLPipelineBuilder{sql}.disable_mvcc().with_parameterized_plan_cache(_cache).create_pipeline_statement();
+    EXPECT_TABLE_EQ_UNORDERED(pipeline_statement.get_result_table().second, expected_table);
+    return pipeline_statement.metrics();
+  }
+
+  std::shared_ptr<SQLParameterizedPlanCache> _cache;
+};
+
+TEST_F(ParameterizedPlanTest, ParameterizeLiterals) {
+  const auto parameterized_statement = parameterize_literals(_translate("SELECT a FROM table_a WHERE a > 5"));
+  ASSERT_TRUE(parameterized_statement);
+  ASSERT_EQ(parameterized_statement->parameter_ids.size(), 1u);
+  EXPECT_EQ(parameterized_statement->parameters.at(parameterized_statement->parameter_ids[0]), AllTypeVariant{5});
+  EXPECT_EQ(parameterized_statement->normalized_statement.parameter_data_types, std::vector<DataType>{DataType::Int});
+
+  const auto between_statement = parameterize_literals(_translate("SELECT a FROM table_a WHERE b BETWEEN 1 AND 2.5"));
+  ASSERT_TRUE(between_statement);
+  EXPECT_EQ(between_statement->normalized_statement.parameter_data_types,
+            std::vector<DataType>({DataType::Int, DataType::Double}));
+}
+
+TEST_F(ParameterizedPlanTest, ParameterizeLiteralsIgnoresOtherLiterals) {
+  EXPECT_FALSE(parameterize_literals(_translate("SELECT a + 1 FROM table_a")));
+  EXPECT_FALSE(parameterize_literals(_translate("SELECT a FROM table_a WHERE a IS NULL LIMIT 2")));
+  EXPECT_FALSE(parameterize_literals(_translate("SELECT a FROM table_a WHERE a = NULL")));
+  EXPECT_FALSE(parameterize_literals(_translate("SELECT a FROM table_a WHERE 1 = 2")));
+
+  // Literals in subqueries are not replaced
+  const auto parameterized_statement = parameterize_literals(
+      _translate("SELECT a FROM table_a WHERE a IN (SELECT a FROM table_a WHERE a > 5) AND a < 9"));
+  ASSERT_TRUE(parameterized_statement);
+  EXPECT_EQ(parameterized_statement->parameter_ids.size(), 1u);
+}
+
+TEST_F(ParameterizedPlanTest, NormalizedStatementEquality) {
+  const auto statement_a = parameterize_literals(_translate("SELECT a FROM table_a WHERE a > 5 AND b < 3.5"));
+  const auto statement_b = parameterize_literals(_translate("SELECT a FROM table_a WHERE a > 17 AND b < 8.0"));
+  const auto statement_c = parameterize_literals(_translate("SELECT a FROM table_a WHERE a > 5.5 AND b < 3.5"));
+  const auto statement_d = parameterize_literals(_translate("SELECT b FROM table_a WHERE a > 5 AND b < 3.5"));
+
+  EXPECT_TRUE(statement_a->normalized_statement == statement_b->normalized_statement);
+  EXPECT_EQ(std::hash<NormalizedStatement>{}(statement_a->normalized_statement),
+            std::hash<NormalizedStatement>{}(statement_b->normalized_statement));
+
+  // Different types of literals and different statements
+  EXPECT_FALSE(statement_a->normalized_statement == statement_c->normalized_statement);
+  EXPECT_FALSE(statement_a->normalized_statement == statement_d->normalized_statement);
+}
+
+TEST_F(ParameterizedPlanTest, CachedPlanIsBoundToLiterals) {
+  const auto expected_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}},
+                                                      TableType::Data);
+  expected_table->append({12345});
+  expected_table->append({1234});
+
+  const auto miss_metrics = _execute("SELECT a FROM table_a WHERE a > 200", expected_table);
+  EXPECT_FALSE(miss_metrics->parameterized_plan_cache_hit);
+  EXPECT_EQ(_cache->size(), 1u);
+
+  const auto hit_metrics = _execute("SELECT a FROM table_a WHERE a > 1000", expected_table);
+  EXPECT_TRUE(hit_metrics->parameterized_plan_cache_hit);
+  EXPECT_FLOAT_EQ(hit_metrics->parameterized_plan_cache_hit_rate, 0.5f);
+
+  const auto plan = (*_cache->cache().begin()).second;
+  EXPECT_FALSE(plan->is_selectivity_sensitive());
+  EXPECT_EQ(plan->lookup_count(), 2u);
+  EXPECT_EQ(plan->hit_count(), 1u);
+
+  // A literal of a different type leads to a different statement
+  const auto double_metrics = _execute("SELECT a FROM table_a WHERE a > 200.5", expected_table);
+  EXPECT_FALSE(double_metrics->parameterized_plan_cache_hit);
+  EXPECT_EQ(_cache->size(), 2u);
+
+  // Statements without literals do not use the cache
+  auto pipeline_statement = SQLPipelineBuilder{"SELECT a FROM table_a"}
+                                .disable_mvcc()
+                                .with_parameterized_plan_cache(_cache)
+                                .create_pipeline_statement();
+  pipeline_statement.get_result_table();
+  EXPECT_EQ(_cache->size(), 2u);
+}
+
+}  // namespace opossum
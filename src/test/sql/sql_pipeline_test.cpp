@@ -287,6 +287,26 @@ TEST_F(SQLPipelineTest, GetQueryPlanTwice) {
   EXPECT_EQ(plans.size(), 1u);
 }
 
+TEST_F(SQLPipelineTest, GetQueryPlanJoinOperators) {
+  auto sql_pipeline = SQLPipelineBuilder{_join_query}.create_pipeline();
+  sql_pipeline.get_physical_plans();
+
+  const auto& metrics = sql_pipeline.metrics();
+  ASSERT_EQ(metrics.statement_metrics.size(), 1u);
+  EXPECT_EQ(metrics.statement_metrics[0]->join_operators, std::vector<std::string>{"JoinHash"});
+
+  // Also reported if the PQP is taken from the cache
+  for (auto run = 0; run < 2; ++run) {
+    auto cached_sql_pipeline = SQLPipelineBuilder{_join_query}.with_pqp_cache(_pqp_cache).create_pipeline();
+    cached_sql_pipeline.get_physical_plans();
+
+    const auto& cached_metrics = cached_sql_pipeline.metrics();
+    ASSERT_EQ(cached_metrics.statement_metrics.size(), 1u);
+    EXPECT_EQ(cached_metrics.statement_metrics[0]->query_plan_cache_hit, run == 1);
+    EXPECT_EQ(cached_metrics.statement_metrics[0]->join_operators, std::vector<std::string>{"JoinHash"});
+  }
+}
+
 TEST_F(SQLPipelineTest, GetQueryPlansExecutionRequired) {
   auto sql_pipeline = SQLPipelineBuilder{_multi_statement_dependent}.create_pipeline();
   try {
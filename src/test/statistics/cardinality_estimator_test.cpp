@@ -696,6 +696,50 @@ TEST_F(CardinalityEstimatorTest, PredicateWithNull) {
   EXPECT_FLOAT_EQ(estimator.estimate_cardinality(lqp_c), 0.0f);
 }
 
+TEST_F(CardinalityEstimatorTest, PredicateEqualsOnCorrelatedColumns) {
+  // 10 cities with 10 zipcodes each, i.e., "zip" determines "city"
+  const auto node = create_mock_node_with_statistics(
+      MockNode::ColumnDefinitions{{DataType::Int, "id"}, {DataType::Int, "city"}, {DataType::Int, "zip"}}, 1'000,
+      {GenericHistogram<int32_t>::with_single_bin(1, 1'000, 1'000, 1'000),
+       GenericHistogram<int32_t>::with_single_bin(1, 10, 1'000, 10),
+       GenericHistogram<int32_t>::with_single_bin(1, 100, 1'000, 100)});
+  const auto city = node->get_column("city");
+  const auto zip = node->get_column("zip");
+
+  // clang-format off
+  const auto city_zip_lqp =
+  PredicateNode::make(equals_(zip, 42),
+    PredicateNode::make(equals_(city, 5),
+      node));
+
+  const auto zip_city_lqp =
+  PredicateNode::make(equals_(city, 5),
+    PredicateNode::make(equals_(zip, 42),
+      node));
+
+  const auto city_zip_range_lqp =
+  PredicateNode::make(less_than_(zip, 42),
+    PredicateNode::make(equals_(city, 5),
+      node));
+  // clang-format on
+
+  // Without ColumnPairStatistics, the columns are assumed to be independent
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(city_zip_lqp), 1.0f);
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(zip_city_lqp), 1.0f);
+  const auto range_cardinality = estimator.estimate_cardinality(city_zip_range_lqp);
+
+  node->table_statistics()->column_pair_statistics = {ColumnPairStatistics{{ColumnID{1}, ColumnID{2}}, {10, 100}, 100}};
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(city_zip_lqp), 10.0f);
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(zip_city_lqp), 10.0f);
+
+  // Only equality predicates are corrected
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(city_zip_range_lqp), range_cardinality);
+
+  // The ColumnPairStatistics are adjusted to the pruned columns
+  node->set_pruned_column_ids({ColumnID{0}});
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(city_zip_lqp), 10.0f);
+}
+
 TEST_F(CardinalityEstimatorTest, PredicateEstimateColumnVsColumnEquiScan) {
   // clang-format off
   const auto left_histogram = GenericHistogram<int32_t>(
@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+
+#include "statistics/hyper_log_log.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class HyperLogLogTest : public ::testing::Test {};
+
+TEST_F(HyperLogLogTest, Estimate) {
+  auto sketch = HyperLogLog{};
+  EXPECT_DOUBLE_EQ(sketch.estimate(), 0.0);
+
+  for (auto value = int32_t{0}; value < 10; ++value) {
+    sketch.add(value);
+  }
+  EXPECT_NEAR(sketch.estimate(), 10.0, 0.5);
+
+  for (auto value = int32_t{0}; value < 100'000; ++value) {
+    sketch.add(value);
+  }
+  EXPECT_NEAR(sketch.estimate(), 100'000.0, 5'000.0);
+}
+
+TEST_F(HyperLogLogTest, Duplicates) {
+  auto sketch = HyperLogLog{};
+  for (auto value = int32_t{0}; value < 1'000; ++value) {
+    sketch.add(pmr_string{std::to_string(value)});
+  }
+  const auto estimate = sketch.estimate();
+  EXPECT_NEAR(estimate, 1'000.0, 50.0);
+
+  for (auto repetition = 0; repetition < 3; ++repetition) {
+    for (auto value = int32_t{0}; value < 1'000; ++value) {
+      sketch.add(pmr_string{std::to_string(value)});
+    }
+  }
+  EXPECT_DOUBLE_EQ(sketch.estimate(), estimate);
+}
+
+TEST_F(HyperLogLogTest, Merge) {
+  auto sketch_a = HyperLogLog{};
+  auto sketch_b = HyperLogLog{};
+  auto sketch_union = HyperLogLog{};
+
+  for (auto value = int64_t{0}; value < 20'000; ++value) {
+    sketch_a.add(value);
+    sketch_union.add(value);
+  }
+  for (auto value = int64_t{10'000}; value < 50'000; ++value) {
+    sketch_b.add(value);
+    sketch_union.add(value);
+  }
+
+  sketch_a.merge(sketch_b);
+  EXPECT_DOUBLE_EQ(sketch_a.estimate(), sketch_union.estimate());
+  EXPECT_NEAR(sketch_a.estimate(), 50'000.0, 2'500.0);
+}
+
+}  // namespace opossum
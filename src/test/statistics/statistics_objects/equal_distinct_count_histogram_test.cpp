@@ -61,4 +61,26 @@ TEST_F(EqualDistinctCountHistogramTest, FromColumnFloat) {
   EXPECT_EQ(hist->bin(BinID{2}), HistogramBin<float>(3.6f, 6.1f, 4, 3));
 }
 
+TEST_F(EqualDistinctCountHistogramTest, FromValueDistribution) {
+  auto value_distribution = std::vector<std::pair<int32_t, HistogramCountType>>{{1, 2.5f}, {3, 1.0f}, {7, 4.0f}};
+  const auto hist = EqualDistinctCountHistogram<int32_t>::from_value_distribution(std::move(value_distribution), 2u);
+
+  ASSERT_EQ(hist->bin_count(), 2u);
+  EXPECT_EQ(hist->bin(BinID{0}), HistogramBin<int32_t>(1, 3, 3.5f, 2));
+  EXPECT_EQ(hist->bin(BinID{1}), HistogramBin<int32_t>(7, 7, 4.0f, 1));
+
+  // Distinct values beyond the ones in the distribution (e.g., of a sample) are spread evenly over the bins
+  auto sampled_value_distribution =
+      std::vector<std::pair<int32_t, HistogramCountType>>{{1, 2.5f}, {3, 1.0f}, {7, 4.0f}};
+  const auto sampled_hist = EqualDistinctCountHistogram<int32_t>::from_value_distribution(
+      std::move(sampled_value_distribution), 2u, HistogramCountType{10});
+
+  ASSERT_EQ(sampled_hist->bin_count(), 2u);
+  EXPECT_EQ(sampled_hist->bin(BinID{0}), HistogramBin<int32_t>(1, 3, 3.5f, 5));
+  EXPECT_EQ(sampled_hist->bin(BinID{1}), HistogramBin<int32_t>(7, 7, 4.0f, 5));
+  EXPECT_FLOAT_EQ(sampled_hist->total_distinct_count(), 10.0f);
+
+  EXPECT_FALSE(EqualDistinctCountHistogram<int32_t>::from_value_distribution({}, 2u));
+}
+
 }  // namespace opossum
@@ -4,6 +4,7 @@
 #include "statistics/generate_pruning_statistics.hpp"
 #include "statistics/statistics_objects/abstract_histogram.hpp"
 #include "statistics/table_statistics.hpp"
+#include "storage/table.hpp"
 #include "utils/load_table.hpp"
 
 namespace opossum {
@@ -41,4 +42,91 @@ TEST_F(TableStatisticsTest, FromTable) {
   EXPECT_FLOAT_EQ(histogram_b->total_distinct_count(), 190);
 }
 
+TEST_F(TableStatisticsTest, FromTableSampled) {
+  // 10 chunks of 100 rows. Column "a" is unique, column "b" has ten distinct values, which occur in every chunk.
+  const auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Int, false}}, TableType::Data, 100);
+  for (auto row_idx = int32_t{0}; row_idx < 1'000; ++row_idx) {
+    table->append({row_idx, row_idx % 10});
+  }
+
+  // Samples the chunks 0, 4, and 9
+  const auto table_statistics = TableStatistics::from_table(*table, StatisticsSampling{0.3f, 0});
+  ASSERT_EQ(table_statistics->row_count, 1'000u);
+
+  const auto histogram_a = std::dynamic_pointer_cast<AbstractHistogram<int32_t>>(
+      std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(table_statistics->column_statistics.at(0))->histogram);
+  ASSERT_TRUE(histogram_a);
+  EXPECT_NEAR(histogram_a->total_count(), 1'000.0f, 1.0f);
+  EXPECT_NEAR(histogram_a->total_distinct_count(), 1'000.0f, 50.0f);
+  EXPECT_EQ(histogram_a->bin_minimum(BinID{0}), 0);
+  EXPECT_EQ(histogram_a->bin_maximum(histogram_a->bin_count() - 1), 999);
+
+  const auto histogram_b = std::dynamic_pointer_cast<AbstractHistogram<int32_t>>(
+      std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(table_statistics->column_statistics.at(1))->histogram);
+  ASSERT_TRUE(histogram_b);
+  EXPECT_NEAR(histogram_b->total_count(), 1'000.0f, 1.0f);
+  EXPECT_NEAR(histogram_b->total_distinct_count(), 10.0f, 0.5f);
+
+  // Tables below the minimum row count are not sampled
+  const auto full_table_statistics = TableStatistics::from_table(*table, StatisticsSampling{0.3f, 10'000});
+  const auto full_histogram_a = std::dynamic_pointer_cast<AbstractHistogram<int32_t>>(
+      std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(full_table_statistics->column_statistics.at(0))
+          ->histogram);
+  ASSERT_TRUE(full_histogram_a);
+  EXPECT_FLOAT_EQ(full_histogram_a->total_count(), 1'000.0f);
+  EXPECT_FLOAT_EQ(full_histogram_a->total_distinct_count(), 1'000.0f);
+}
+
+TEST_F(TableStatisticsTest, FromTableColumnPairs) {
+  // "zip" determines "city" and "year", which are independent of each other. "id" is unique and thus not paired.
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"id", DataType::Int, false},
+                                                                    {"city", DataType::Int, false},
+                                                                    {"zip", DataType::Int, false},
+                                                                    {"year", DataType::Int, true}},
+                                             TableType::Data, 100);
+  for (auto row_idx = int32_t{0}; row_idx < 1'000; ++row_idx) {
+    table->append({row_idx, row_idx % 10, row_idx % 100, (row_idx / 10) % 10});
+  }
+
+  for (const auto& sampling : {std::optional<StatisticsSampling>{}, std::optional<StatisticsSampling>{{0.5f, 0}}}) {
+    const auto table_statistics = TableStatistics::from_table(*table, sampling);
+
+    const auto& column_pair_statistics = table_statistics->column_pair_statistics;
+    ASSERT_EQ(column_pair_statistics.size(), 2u);
+
+    const auto& city_zip_statistics = column_pair_statistics[0];
+    EXPECT_EQ(city_zip_statistics.column_ids, std::make_pair(ColumnID{1}, ColumnID{2}));
+    EXPECT_NEAR(city_zip_statistics.column_distinct_counts.first, 10.0f, 0.5f);
+    EXPECT_NEAR(city_zip_statistics.column_distinct_counts.second, 100.0f, 5.0f);
+    EXPECT_NEAR(city_zip_statistics.distinct_count, 100.0f, 5.0f);
+    EXPECT_NEAR(city_zip_statistics.correlation_factor(), 10.0f, 0.5f);
+
+    const auto& zip_year_statistics = column_pair_statistics[1];
+    EXPECT_EQ(zip_year_statistics.column_ids, std::make_pair(ColumnID{2}, ColumnID{3}));
+    EXPECT_NEAR(zip_year_statistics.correlation_factor(), 10.0f, 0.5f);
+  }
+}
+
+TEST_F(TableStatisticsTest, CopyColumnCorrelations) {
+  auto input_column_statistics = std::vector<std::shared_ptr<BaseAttributeStatistics>>{
+      std::make_shared<AttributeStatistics<int32_t>>(), std::make_shared<AttributeStatistics<int32_t>>(),
+      std::make_shared<AttributeStatistics<int32_t>>()};
+  const auto input_table_statistics = std::make_shared<TableStatistics>(std::move(input_column_statistics), 100);
+  input_table_statistics->column_pair_statistics = {ColumnPairStatistics{{ColumnID{0}, ColumnID{2}}, {10, 10}, 10},
+                                                    ColumnPairStatistics{{ColumnID{0}, ColumnID{1}}, {10, 10}, 10}};
+  input_table_statistics->equality_filtered_column_ids = {ColumnID{1}, ColumnID{2}};
+
+  // Swaps the columns 0 and 2 and drops column 1
+  auto column_statistics = std::vector<std::shared_ptr<BaseAttributeStatistics>>{
+      input_table_statistics->column_statistics[2], input_table_statistics->column_statistics[0]};
+  auto table_statistics = TableStatistics{std::move(column_statistics), 100};
+  table_statistics.copy_column_correlations(*input_table_statistics, {ColumnID{2}, ColumnID{0}});
+
+  ASSERT_EQ(table_statistics.column_pair_statistics.size(), 1u);
+  EXPECT_EQ(table_statistics.column_pair_statistics[0].column_ids, std::make_pair(ColumnID{1}, ColumnID{0}));
+  EXPECT_FLOAT_EQ(table_statistics.column_pair_statistics[0].correlation_factor(), 10.0f);
+  EXPECT_EQ(table_statistics.equality_filtered_column_ids, std::vector<ColumnID>{ColumnID{0}});
+}
+
 }  // namespace opossum
@@ -0,0 +1,195 @@
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "cache/cache.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/abstract_histogram.hpp"
+#include "statistics/table_statistics.hpp"
+#include "statistics/update_table_statistics.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class UpdateTableStatisticsTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Five finalized chunks of 20 rows. Column "a" is unique, column "b" has ten distinct values.
+    _table = std::make_shared<Table>(
+        TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Int, true}}, TableType::Data, 20,
+        UseMvcc::Yes);
+    _append_rows(0, 100);
+    _table->last_chunk()->finalize();
+
+    Hyrise::get().storage_manager.add_table("table", _table);
+  }
+
+  void _append_rows(const int32_t begin, const int32_t end) {
+    for (auto value = begin; value < end; ++value) {
+      _table->append({value, value % 10});
+    }
+  }
+
+  std::shared_ptr<AbstractHistogram<int32_t>> _histogram(const ColumnID column_id) const {
+    const auto& attribute_statistics =
+        static_cast<const AttributeStatistics<int32_t>&>(*_table->table_statistics()->column_statistics[column_id]);
+    return attribute_statistics.histogram;
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(UpdateTableStatisticsTest, MergeFinalizedChunks) {
+  const auto version = _table->statistics_version();
+  const auto statistics = _table->table_statistics();
+
+  // Rows of mutable chunks are merged up to the first row whose Insert has not committed yet
+  _append_rows(100, 110);
+  _table->last_chunk()->get_scoped_mvcc_data_lock()->set_begin_cid(ChunkOffset{5}, MvccData::MAX_COMMIT_ID);
+  update_table_statistics(_table);
+
+  const auto mutable_chunk_statistics = _table->table_statistics();
+  ASSERT_NE(mutable_chunk_statistics, statistics);
+  EXPECT_FLOAT_EQ(mutable_chunk_statistics->row_count, 105.0f);
+  EXPECT_EQ(mutable_chunk_statistics->coverage->chunk_row_counts.back(), 5u);
+
+  _table->last_chunk()->get_scoped_mvcc_data_lock()->set_begin_cid(ChunkOffset{5}, CommitID{0});
+  _append_rows(110, 120);
+  _table->last_chunk()->finalize();
+  update_table_statistics(_table);
+
+  const auto updated_statistics = _table->table_statistics();
+  ASSERT_NE(updated_statistics, mutable_chunk_statistics);
+  EXPECT_FLOAT_EQ(updated_statistics->row_count, 120.0f);
+  EXPECT_EQ(updated_statistics->coverage->chunk_row_counts.size(), 6u);
+  EXPECT_EQ(updated_statistics->coverage->drifted_row_count, 20u);
+
+  // The ascending values of "a" are added as new bins, the values of "b" repeat the existing ones
+  const auto histogram_a = _histogram(ColumnID{0});
+  EXPECT_FLOAT_EQ(histogram_a->total_count(), 120.0f);
+  EXPECT_FLOAT_EQ(histogram_a->total_distinct_count(), 120.0f);
+  EXPECT_EQ(histogram_a->bin_maximum(histogram_a->bin_count() - 1), 119);
+
+  const auto histogram_b = _histogram(ColumnID{1});
+  EXPECT_FLOAT_EQ(histogram_b->total_count(), 120.0f);
+  EXPECT_FLOAT_EQ(histogram_b->total_distinct_count(), 10.0f);
+
+  // Incremental updates do not invalidate cached plans
+  EXPECT_EQ(_table->statistics_version(), version);
+}
+
+TEST_F(UpdateTableStatisticsTest, NullValues) {
+  _table->append({100, NullValue{}});
+  _table->append({101, NullValue{}});
+  _table->last_chunk()->finalize();
+  update_table_statistics(_table);
+
+  const auto& attribute_statistics =
+      static_cast<const AttributeStatistics<int32_t>&>(*_table->table_statistics()->column_statistics[ColumnID{1}]);
+  ASSERT_TRUE(attribute_statistics.null_value_ratio);
+  EXPECT_FLOAT_EQ(attribute_statistics.null_value_ratio->ratio, 2.0f / 102.0f);
+  EXPECT_FLOAT_EQ(attribute_statistics.histogram->total_count(), 100.0f);
+}
+
+TEST_F(UpdateTableStatisticsTest, InvalidatedRows) {
+  const auto statistics = _table->table_statistics();
+
+  // Invalidating up to one percent of the rows does not update the statistics
+  _table->get_chunk(ChunkID{0})->increase_invalid_row_count(1);
+  update_table_statistics(_table);
+  EXPECT_EQ(_table->table_statistics(), statistics);
+
+  _table->get_chunk(ChunkID{1})->increase_invalid_row_count(9);
+  update_table_statistics(_table);
+
+  const auto updated_statistics = _table->table_statistics();
+  EXPECT_FLOAT_EQ(updated_statistics->row_count, 90.0f);
+  EXPECT_EQ(updated_statistics->coverage->invalid_row_count, 10u);
+  EXPECT_FLOAT_EQ(_histogram(ColumnID{0})->total_count(), 90.0f);
+  EXPECT_FLOAT_EQ(_histogram(ColumnID{1})->total_count(), 90.0f);
+}
+
+TEST_F(UpdateTableStatisticsTest, RebuildAfterDrift) {
+  const auto version = _table->statistics_version();
+
+  _append_rows(100, 140);
+  _table->last_chunk()->finalize();
+  _table->get_chunk(ChunkID{0})->increase_invalid_row_count(14);
+
+  // Without a scheduler, the rebuild is executed immediately
+  update_table_statistics(_table);
+  EXPECT_NE(_table->statistics_version(), version);
+
+  const auto rebuilt_statistics = _table->table_statistics();
+  EXPECT_FLOAT_EQ(rebuilt_statistics->row_count, 126.0f);
+  EXPECT_EQ(rebuilt_statistics->coverage->built_row_count, 126u);
+  EXPECT_EQ(rebuilt_statistics->coverage->drifted_row_count, 0u);
+  EXPECT_FALSE(rebuilt_statistics->coverage->rebuild_scheduled);
+  EXPECT_FLOAT_EQ(_histogram(ColumnID{0})->total_count(), 126.0f);
+
+  // The rebuilt statistics are up to date
+  update_table_statistics(_table);
+  EXPECT_EQ(_table->table_statistics(), rebuilt_statistics);
+}
+
+TEST_F(UpdateTableStatisticsTest, ScheduleUpdateAfterCommit) {
+  const auto statistics = _table->table_statistics();
+
+  // Committing up to one percent of the rows does not look at the chunks
+  _append_rows(100, 101);
+  schedule_table_statistics_update(_table, 1);
+  EXPECT_EQ(_table->table_statistics(), statistics);
+
+  // Without an active scheduler, the update would delay the commit. The rows remain pending.
+  _append_rows(101, 110);
+  schedule_table_statistics_update(_table, 9);
+  EXPECT_EQ(_table->table_statistics(), statistics);
+
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+  _append_rows(110, 111);
+  schedule_table_statistics_update(_table, 1);
+  Hyrise::get().scheduler()->finish();
+
+  const auto updated_statistics = _table->table_statistics();
+  ASSERT_NE(updated_statistics, statistics);
+  EXPECT_FLOAT_EQ(updated_statistics->row_count, 111.0f);
+  EXPECT_EQ(_table->reset_pending_statistics_row_count(), 0u);
+}
+
+TEST_F(UpdateTableStatisticsTest, PlansAreOutdatedAfterRebuild) {
+  const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, false}};
+  Hyrise::get().storage_manager.add_table("other_table", std::make_shared<Table>(column_definitions, TableType::Data));
+  const auto other_lqp = StoredTableNode::make("other_table");
+
+  const auto lqp = StoredTableNode::make("table");
+  auto cache = Cache<std::shared_ptr<AbstractLQPNode>, int32_t>{};
+  cache.set(1, lqp);
+  EXPECT_TRUE(cache.try_get(1, lqp_uses_outdated_statistics));
+
+  _append_rows(100, 140);
+  _table->last_chunk()->finalize();
+  update_table_statistics(_table);
+
+  // Plans optimized before the rebuild are no longer returned, even if they are set() after it
+  EXPECT_TRUE(lqp_uses_outdated_statistics(lqp));
+  EXPECT_FALSE(cache.try_get(1, lqp_uses_outdated_statistics));
+  cache.set(1, lqp);
+  EXPECT_FALSE(cache.try_get(1, lqp_uses_outdated_statistics));
+
+  cache.set(1, StoredTableNode::make("table"));
+  EXPECT_TRUE(cache.try_get(1, lqp_uses_outdated_statistics));
+
+  // Plans that do not reference the Table are not affected
+  EXPECT_FALSE(lqp_uses_outdated_statistics(other_lqp));
+
+  // Neither are the plans of a dropped Table valid for a new Table with the same name
+  Hyrise::get().storage_manager.drop_table("other_table");
+  Hyrise::get().storage_manager.add_table("other_table", std::make_shared<Table>(column_definitions, TableType::Data));
+  EXPECT_TRUE(lqp_uses_outdated_statistics(other_lqp));
+}
+
+}  // namespace opossum
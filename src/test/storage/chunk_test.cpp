@@ -78,6 +78,50 @@ TEST_F(StorageChunkTest, FinalizingAFinalizedChunkThrows) {
   EXPECT_THROW(chunk->finalize(), std::logic_error);
 }
 
+TEST_F(StorageChunkTest, ReserveRows) {
+  chunk = std::make_shared<Chunk>(Segments({vs_int, vs_str}));
+
+  EXPECT_EQ(chunk->reserve_rows(2, 6), (std::pair{ChunkOffset{3}, ChunkOffset{5}}));
+  EXPECT_EQ(chunk->reserve_rows(2, 6), (std::pair{ChunkOffset{5}, ChunkOffset{6}}));
+  EXPECT_EQ(chunk->reserve_rows(1, 6), (std::pair{ChunkOffset{6}, ChunkOffset{6}}));
+
+  // Reserving rows does not change the size of the chunk, the Insert operator grows the segments
+  EXPECT_EQ(chunk->size(), 3u);
+
+  // The first reservation does not wait for any other one
+  EXPECT_TRUE(chunk->wait_for_allocated_rows(3));
+  chunk->set_allocated_rows(5);
+  EXPECT_TRUE(chunk->wait_for_allocated_rows(5));
+
+  const auto immutable_chunk = std::make_shared<Chunk>(Segments({vs_int, vs_str}));
+  immutable_chunk->finalize();
+  EXPECT_EQ(immutable_chunk->reserve_rows(1, 6), (std::pair{ChunkOffset{3}, ChunkOffset{3}}));
+}
+
+TEST_F(StorageChunkTest, FailedRowAllocation) {
+  chunk = std::make_shared<Chunk>(Segments({vs_int, vs_str}));
+
+  const auto first_rows = chunk->reserve_rows(2, 10);
+  const auto second_rows = chunk->reserve_rows(2, 10);
+  const auto third_rows = chunk->reserve_rows(2, 10);
+
+  {
+    auto allocation_guard = Chunk::RowAllocationGuard{*chunk, first_rows.second};
+    EXPECT_TRUE(chunk->wait_for_allocated_rows(first_rows.first));
+    allocation_guard.set_allocated();
+  }
+
+  // The guard of the second reservation is destroyed before the rows are allocated, e.g., by an exception
+  {
+    auto allocation_guard = Chunk::RowAllocationGuard{*chunk, second_rows.second};
+    EXPECT_TRUE(chunk->wait_for_allocated_rows(second_rows.first));
+  }
+
+  // Later reservations give up instead of waiting forever, and no more rows can be reserved
+  EXPECT_FALSE(chunk->wait_for_allocated_rows(third_rows.first));
+  EXPECT_EQ(chunk->reserve_rows(1, 10), (std::pair{ChunkOffset{9}, ChunkOffset{9}}));
+}
+
 TEST_F(StorageChunkTest, FinalizeSetsMaxBeginCid) {
   auto mvcc_data = std::make_shared<MvccData>(3, 0);
   mvcc_data->begin_cids = {1, 2, 3};
@@ -89,6 +133,22 @@ TEST_F(StorageChunkTest, FinalizeSetsMaxBeginCid) {
   EXPECT_EQ(mvcc_data_chunk->max_begin_cid, 3);
 }
 
+TEST_F(StorageChunkTest, FinalizeMakesMvccDataContiguous) {
+  auto mvcc_data = std::make_shared<MvccData>(3, 0);
+  mvcc_data->tids[1] = TransactionID{4};
+  mvcc_data->begin_cids = {1, 2, 3};
+
+  chunk = std::make_shared<Chunk>(Segments({vs_int, vs_str}), mvcc_data);
+  EXPECT_FALSE(mvcc_data->contiguous_columns());
+  chunk->finalize();
+
+  const auto& contiguous_columns = mvcc_data->contiguous_columns();
+  ASSERT_TRUE(contiguous_columns);
+  EXPECT_EQ(contiguous_columns->tids[1], TransactionID{4});
+  EXPECT_EQ(contiguous_columns->begin_cids[2], CommitID{3});
+  EXPECT_EQ(contiguous_columns->end_cids[0], MvccData::MAX_COMMIT_ID);
+}
+
 TEST_F(StorageChunkTest, UnknownColumnType) {
   // Exception will only be thrown in debug builds
   if (!HYRISE_DEBUG) GTEST_SKIP();
@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "hyrise.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/base_encoded_segment.hpp"
+#include "storage/encoding_advisor.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/meta_table_manager.hpp"
+
+namespace opossum {
+
+class EncodingAdvisorTest : public BaseTest {
+ public:
+  void SetUp() override {
+    // Column a is sorted and consists of few runs, column b is a permutation of the values 0 to 999 in each chunk. The
+    // last chunk is still mutable.
+    const auto column_definitions =
+        TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Int, false}};
+    _table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{1'000}, UseMvcc::Yes);
+    for (auto row_id = int32_t{0}; row_id < 2'500; ++row_id) {
+      _table->append({row_id / 100, (row_id * 7'919) % 1'000});
+    }
+    Hyrise::get().storage_manager.add_table("advised_table", _table);
+  }
+
+  EncodingType _encoding_type(const ChunkID chunk_id, const ColumnID column_id) const {
+    const auto segment = _table->get_chunk(chunk_id)->get_segment(column_id);
+    const auto encoded_segment = std::dynamic_pointer_cast<const BaseEncodedSegment>(segment);
+    return encoded_segment ? encoded_segment->encoding_type() : EncodingType::Unencoded;
+  }
+
+  // Checks that @param decision chose the candidate with the lowest estimated memory usage
+  static void _expect_smallest_candidate(const SegmentEncodingDecision& decision) {
+    const auto candidates = EncodingAdvisor::estimate_candidates(decision.characteristics, DataType::Int, {});
+    const auto smallest_candidate =
+        std::min_element(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+          return lhs.estimated_memory_usage < rhs.estimated_memory_usage;
+        });
+    EXPECT_EQ(decision.chosen_candidate.estimated_memory_usage, smallest_candidate->estimated_memory_usage);
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(EncodingAdvisorTest, SampleSmallSegment) {
+  const auto segment = std::make_shared<ValueSegment<int32_t>>(
+      std::vector<int32_t>{5, 5, 5, 0, 7, 7, 100, 100, 100, 5},
+      std::vector<bool>{false, false, false, true, false, false, false, false, false, false});
+
+  // Small segments are sampled entirely
+  const auto characteristics = EncodingAdvisor::sample_segment(segment, DataType::Int);
+  EXPECT_EQ(characteristics.row_count, 10);
+  EXPECT_EQ(characteristics.sampled_row_count, 10);
+  EXPECT_EQ(characteristics.null_count, 1);
+  EXPECT_EQ(characteristics.distinct_count, 3);
+  EXPECT_EQ(characteristics.run_count, 5);
+  EXPECT_EQ(characteristics.max_block_value_range, uint64_t{95});
+  EXPECT_DOUBLE_EQ(characteristics.value_size, 4.0);
+  EXPECT_GT(characteristics.lz4_size, 0);
+
+  const auto string_segment =
+      std::make_shared<ValueSegment<pmr_string>>(std::vector<pmr_string>{"a", "bb", "a", pmr_string(100, 'c')});
+  const auto string_characteristics = EncodingAdvisor::sample_segment(string_segment, DataType::String);
+  EXPECT_EQ(string_characteristics.distinct_count, 3);
+  EXPECT_EQ(string_characteristics.run_count, 4);
+  EXPECT_EQ(string_characteristics.max_string_length, 100);
+  EXPECT_FALSE(string_characteristics.max_block_value_range);
+  EXPECT_GT(string_characteristics.value_size, static_cast<double>(sizeof(pmr_string)));
+}
+
+TEST_F(EncodingAdvisorTest, SampleLargeSegment) {
+  auto values = std::vector<int32_t>(10'000);
+  for (auto row_id = size_t{0}; row_id < values.size(); ++row_id) {
+    values[row_id] = static_cast<int32_t>(row_id / 1'000);
+  }
+  const auto segment = std::make_shared<ValueSegment<int32_t>>(std::move(values));
+
+  // Only SAMPLE_BLOCK_COUNT blocks are sampled, the characteristics are extrapolated
+  const auto characteristics = EncodingAdvisor::sample_segment(segment, DataType::Int);
+  EXPECT_EQ(characteristics.row_count, 10'000);
+  EXPECT_EQ(characteristics.sampled_row_count,
+            EncodingAdvisor::SAMPLE_BLOCK_COUNT * EncodingAdvisor::SAMPLE_BLOCK_SIZE);
+  EXPECT_EQ(characteristics.null_count, 0);
+  EXPECT_EQ(characteristics.distinct_count, 10);
+  EXPECT_NEAR(static_cast<double>(characteristics.run_count), 10.0, 2.0);
+  EXPECT_EQ(characteristics.max_block_value_range, uint64_t{2});
+}
+
+TEST_F(EncodingAdvisorTest, EstimateCandidates) {
+  auto characteristics = SegmentCharacteristics{};
+  characteristics.row_count = 1'000;
+  characteristics.distinct_count = 10;
+  characteristics.run_count = 10;
+  characteristics.value_size = 4.0;
+  characteristics.max_block_value_range = 9;
+  characteristics.lz4_size = 500;
+
+  const auto candidates = EncodingAdvisor::estimate_candidates(characteristics, DataType::Int, {2, 0});
+  auto encoding_types = std::vector<EncodingType>{};
+  for (const auto& candidate : candidates) {
+    encoding_types.emplace_back(candidate.encoding_spec.encoding_type);
+  }
+  EXPECT_EQ(encoding_types, std::vector<EncodingType>({EncodingType::Unencoded, EncodingType::Dictionary,
+                                                       EncodingType::FrameOfReference, EncodingType::RunLength,
+                                                       EncodingType::LZ4}));
+
+  EXPECT_EQ(candidates[0].estimated_memory_usage, 4'000);
+  EXPECT_EQ(candidates[1].estimated_memory_usage, 10 * 4 + 1'000);
+  EXPECT_EQ(candidates[2].estimated_memory_usage, 1'000 + 4);
+  EXPECT_EQ(candidates[3].estimated_memory_usage, 10 * 9);
+  EXPECT_EQ(candidates[4].estimated_memory_usage, 500);
+
+  // Scans are cheapest on the few runs of the RunLength encoding
+  for (const auto& candidate : candidates) {
+    if (candidate.encoding_spec.encoding_type == EncodingType::RunLength) continue;
+    EXPECT_LT(candidates[3].estimated_access_cost, candidate.estimated_access_cost);
+  }
+
+  // Strings are not supported by FrameOfReference, but by FixedStringDictionary
+  const auto string_candidates = EncodingAdvisor::estimate_candidates(characteristics, DataType::String, {});
+  EXPECT_EQ(string_candidates.size(), 5);
+  EXPECT_EQ(string_candidates[2].encoding_spec.encoding_type, EncodingType::FixedStringDictionary);
+  EXPECT_EQ(string_candidates[2].estimated_access_cost, 0.0);
+}
+
+TEST_F(EncodingAdvisorTest, ChooseCandidates) {
+  const auto candidates = std::vector<std::vector<SegmentEncodingCandidate>>{
+      {{EncodingType::Unencoded, 100, 10.0}, {EncodingType::Dictionary, 50, 20.0}, {EncodingType::LZ4, 10, 100.0}},
+      {{EncodingType::Unencoded, 100, 10.0}, {EncodingType::Dictionary, 20, 15.0}}};
+
+  EXPECT_EQ(EncodingAdvisor::choose_candidates(candidates, std::nullopt), std::vector<size_t>({0, 0}));
+  EXPECT_EQ(EncodingAdvisor::choose_candidates(candidates, 200), std::vector<size_t>({0, 0}));
+
+  // The second segment saves more bytes per additional cost
+  EXPECT_EQ(EncodingAdvisor::choose_candidates(candidates, 150), std::vector<size_t>({0, 1}));
+  EXPECT_EQ(EncodingAdvisor::choose_candidates(candidates, 100), std::vector<size_t>({1, 1}));
+
+  // Budgets that cannot be met result in the smallest candidates
+  EXPECT_EQ(EncodingAdvisor::choose_candidates(candidates, 0), std::vector<size_t>({2, 1}));
+
+  // Initial candidates are kept as long as the budget allows it
+  const auto initial_candidates = std::vector<std::optional<size_t>>{1, std::nullopt};
+  EXPECT_EQ(EncodingAdvisor::choose_candidates(candidates, std::nullopt, initial_candidates),
+            std::vector<size_t>({1, 0}));
+  EXPECT_EQ(EncodingAdvisor::choose_candidates(candidates, 100, initial_candidates), std::vector<size_t>({1, 1}));
+  EXPECT_EQ(EncodingAdvisor::choose_candidates(candidates, 0, initial_candidates), std::vector<size_t>({2, 1}));
+}
+
+TEST_F(EncodingAdvisorTest, RecordAccesses) {
+  auto& encoding_advisor = Hyrise::get().encoding_advisor;
+  const auto query = std::string{"SELECT a + 1, b FROM advised_table WHERE b > 500"};
+
+  // Access recording is disabled by default
+  SQLPipelineBuilder{query}.create_pipeline().get_result_table();
+  EXPECT_EQ(encoding_advisor.column_accesses("advised_table", ColumnID{1}).scan_count, 0);
+
+  encoding_advisor.set_access_recording_enabled(true);
+  SQLPipelineBuilder{query}.create_pipeline().get_result_table();
+  SQLPipelineBuilder{query}.create_pipeline().get_result_table();
+
+  // Column a is accessed by the projection. Column b is only forwarded by it.
+  const auto a_accesses = encoding_advisor.column_accesses("advised_table", ColumnID{0});
+  EXPECT_EQ(a_accesses.scan_count, 0);
+  EXPECT_EQ(a_accesses.point_access_count, 2);
+  const auto b_accesses = encoding_advisor.column_accesses("advised_table", ColumnID{1});
+  EXPECT_EQ(b_accesses.scan_count, 2);
+  EXPECT_EQ(b_accesses.point_access_count, 0);
+
+  encoding_advisor.reset_accesses();
+  EXPECT_EQ(encoding_advisor.column_accesses("advised_table", ColumnID{1}).scan_count, 0);
+
+  // Joins and aggregates read their input columns in sequence
+  SQLPipelineBuilder{"SELECT b, MIN(a) FROM advised_table GROUP BY b"}.create_pipeline().get_result_table();
+  SQLPipelineBuilder{"SELECT t1.a FROM advised_table t1 JOIN advised_table t2 ON t1.a = t2.b"}
+      .create_pipeline()
+      .get_result_table();
+  EXPECT_GE(encoding_advisor.column_accesses("advised_table", ColumnID{0}).scan_count, 2);
+  EXPECT_EQ(encoding_advisor.column_accesses("advised_table", ColumnID{0}).point_access_count, 0);
+  EXPECT_GE(encoding_advisor.column_accesses("advised_table", ColumnID{1}).scan_count, 2);
+  EXPECT_EQ(encoding_advisor.column_accesses("advised_table", ColumnID{1}).point_access_count, 0);
+}
+
+TEST_F(EncodingAdvisorTest, RunEncodesSegments) {
+  auto& encoding_advisor = Hyrise::get().encoding_advisor;
+  encoding_advisor.set_access_recording_enabled(true);
+  SQLPipelineBuilder{"SELECT b FROM advised_table WHERE a = 5"}.create_pipeline().get_result_table();
+
+  encoding_advisor.run();
+
+  // Only the two immutable chunks are considered
+  const auto decisions = encoding_advisor.decisions();
+  ASSERT_EQ(decisions.size(), 4);
+  EXPECT_TRUE(_table->get_chunk(ChunkID{2})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{2}, ColumnID{0}), EncodingType::Unencoded);
+
+  for (const auto& decision : decisions) {
+    EXPECT_EQ(decision.table_name, "advised_table");
+    EXPECT_EQ(decision.previous_encoding_type, EncodingType::Unencoded);
+    EXPECT_EQ(_encoding_type(decision.chunk_id, decision.column_id),
+              decision.chosen_candidate.encoding_spec.encoding_type);
+
+    if (decision.column_id == ColumnID{0}) {
+      // The scanned column is cheapest to scan with RunLength encoding
+      EXPECT_EQ(decision.column_accesses.scan_count, 1);
+      EXPECT_EQ(decision.chosen_candidate.encoding_spec.encoding_type, EncodingType::RunLength);
+    } else {
+      // Column b is not accessed, so it keeps its encoding
+      EXPECT_EQ(decision.column_accesses.scan_count, 0);
+      EXPECT_EQ(decision.column_accesses.point_access_count, 0);
+      EXPECT_EQ(decision.chosen_candidate.encoding_spec.encoding_type, EncodingType::Unencoded);
+    }
+  }
+
+  const auto meta_table = Hyrise::get().storage_manager.get_table(MetaTableManager::META_PREFIX + "encoding_decisions");
+  EXPECT_EQ(meta_table->row_count(), 4);
+  EXPECT_EQ(meta_table->get_value<pmr_string>(ColumnID{5}, 0), "RunLength");
+
+  // With a budget that cannot be met, all segments get their smallest encoding
+  encoding_advisor.set_memory_budget(0);
+  encoding_advisor.run();
+  for (const auto& decision : encoding_advisor.decisions()) {
+    _expect_smallest_candidate(decision);
+    EXPECT_EQ(_encoding_type(decision.chunk_id, decision.column_id),
+              decision.chosen_candidate.encoding_spec.encoding_type);
+  }
+}
+
+}  // namespace opossum
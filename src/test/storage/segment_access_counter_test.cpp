@@ -0,0 +1,194 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "hyrise.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_access_counter.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/segment_iterables/create_iterable_from_attribute_vector.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/meta_table_manager.hpp"
+
+namespace opossum {
+
+class SegmentAccessCounterTest : public BaseTest {
+ public:
+  void SetUp() override {
+    _table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Int, false}},
+                                     TableType::Data, ChunkOffset{4}, UseMvcc::Yes);
+    for (auto row_id = int32_t{0}; row_id < 8; ++row_id) {
+      _table->append({row_id, row_id * 2});
+    }
+  }
+
+  static uint64_t _count(const std::shared_ptr<const BaseSegment>& segment,
+                         const SegmentAccessCounter::AccessType access_type) {
+    return segment->access_counter.get(access_type);
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(SegmentAccessCounterTest, IncrementAndReset) {
+  auto access_counter = SegmentAccessCounter{};
+  access_counter.increment(SegmentAccessCounter::AccessType::Sequential, 5);
+  access_counter.increment(SegmentAccessCounter::AccessType::Sequential, 2);
+  access_counter.increment(SegmentAccessCounter::AccessType::Point, 1);
+  EXPECT_EQ(access_counter.get(SegmentAccessCounter::AccessType::Sequential), 7);
+  EXPECT_EQ(access_counter.get(SegmentAccessCounter::AccessType::Random), 0);
+  EXPECT_EQ(access_counter.get(SegmentAccessCounter::AccessType::Point), 1);
+
+  auto other_access_counter = SegmentAccessCounter{};
+  other_access_counter.add(access_counter);
+  EXPECT_EQ(other_access_counter.get(SegmentAccessCounter::AccessType::Sequential), 7);
+
+  access_counter.reset();
+  EXPECT_EQ(access_counter.get(SegmentAccessCounter::AccessType::Sequential), 0);
+  EXPECT_EQ(access_counter.get(SegmentAccessCounter::AccessType::Point), 0);
+}
+
+TEST_F(SegmentAccessCounterTest, UncountedScope) {
+  auto access_counter = SegmentAccessCounter{};
+  auto other_access_counter = SegmentAccessCounter{};
+  other_access_counter.increment(SegmentAccessCounter::AccessType::Random, 3);
+
+  {
+    const auto uncounted_scope = SegmentAccessCounter::UncountedScope{};
+    access_counter.increment(SegmentAccessCounter::AccessType::Sequential, 5);
+
+    // Accesses that were already counted are still taken over
+    access_counter.add(other_access_counter);
+  }
+
+  access_counter.increment(SegmentAccessCounter::AccessType::Sequential, 2);
+  EXPECT_EQ(access_counter.get(SegmentAccessCounter::AccessType::Sequential), 2);
+  EXPECT_EQ(access_counter.get(SegmentAccessCounter::AccessType::Random), 3);
+}
+
+TEST_F(SegmentAccessCounterTest, Iterables) {
+  const auto segment = _table->get_chunk(ChunkID{0})->get_segment(ColumnID{0});
+
+  segment_iterate<int32_t>(*segment, [](const auto& position) {});
+  EXPECT_EQ(_count(segment, SegmentAccessCounter::AccessType::Sequential), 4);
+  EXPECT_EQ(_count(segment, SegmentAccessCounter::AccessType::Random), 0);
+
+  const auto position_filter = std::make_shared<PosList>(PosList{RowID{ChunkID{0}, ChunkOffset{3}},
+                                                                 RowID{ChunkID{0}, ChunkOffset{1}}});
+  position_filter->guarantee_single_chunk();
+  segment_iterate_filtered<int32_t>(*segment, position_filter, [](const auto& position) {});
+  EXPECT_EQ(_count(segment, SegmentAccessCounter::AccessType::Sequential), 4);
+  EXPECT_EQ(_count(segment, SegmentAccessCounter::AccessType::Random), 2);
+
+  // Encoded segments count their accesses as well, including scans of the attribute vector
+  const auto chunk = _table->get_chunk(ChunkID{1});
+  chunk->finalize();
+  ChunkEncoder::encode_chunk(chunk, _table->column_data_types(), EncodingType::Dictionary);
+  const auto dictionary_segment =
+      std::dynamic_pointer_cast<const BaseDictionarySegment>(chunk->get_segment(ColumnID{0}));
+  ASSERT_TRUE(dictionary_segment);
+
+  segment_iterate<int32_t>(*dictionary_segment, [](const auto& position) {});
+  create_iterable_from_attribute_vector(*dictionary_segment).for_each([](const auto& position) {});
+  EXPECT_EQ(_count(dictionary_segment, SegmentAccessCounter::AccessType::Sequential), 8);
+}
+
+TEST_F(SegmentAccessCounterTest, Accessors) {
+  const auto segment = _table->get_chunk(ChunkID{0})->get_segment(ColumnID{0});
+
+  {
+    const auto accessor = create_segment_accessor<int32_t>(segment);
+    EXPECT_EQ(accessor->access(ChunkOffset{2}), 2);
+    EXPECT_EQ(accessor->access(ChunkOffset{3}), 3);
+    EXPECT_EQ(accessor->access(ChunkOffset{2}), 2);
+
+    // The accesses are added when the accessor is destroyed
+    EXPECT_EQ(_count(segment, SegmentAccessCounter::AccessType::Point), 0);
+  }
+  EXPECT_EQ(_count(segment, SegmentAccessCounter::AccessType::Point), 3);
+  EXPECT_EQ(_count(segment, SegmentAccessCounter::AccessType::Random), 0);
+}
+
+TEST_F(SegmentAccessCounterTest, ReferenceSegments) {
+  const auto first_segment = _table->get_chunk(ChunkID{0})->get_segment(ColumnID{0});
+  const auto second_segment = _table->get_chunk(ChunkID{1})->get_segment(ColumnID{0});
+
+  // Accesses through ReferenceSegments are random accesses of the referenced segments
+  const auto single_chunk_pos_list = std::make_shared<PosList>(PosList{RowID{ChunkID{1}, ChunkOffset{0}},
+                                                                       RowID{ChunkID{1}, ChunkOffset{2}}});
+  single_chunk_pos_list->guarantee_single_chunk();
+  const auto single_chunk_segment = std::make_shared<ReferenceSegment>(_table, ColumnID{0}, single_chunk_pos_list);
+  segment_iterate<int32_t>(*single_chunk_segment, [](const auto& position) {});
+  EXPECT_EQ(_count(second_segment, SegmentAccessCounter::AccessType::Random), 2);
+
+  {
+    const auto accessor = create_segment_accessor<int32_t>(single_chunk_segment);
+    EXPECT_EQ(accessor->access(ChunkOffset{1}), 6);
+  }
+  EXPECT_EQ(_count(second_segment, SegmentAccessCounter::AccessType::Random), 3);
+
+  const auto multiple_chunks_pos_list = std::make_shared<PosList>(
+      PosList{RowID{ChunkID{0}, ChunkOffset{1}}, RowID{ChunkID{1}, ChunkOffset{1}}, NULL_ROW_ID});
+  const auto multiple_chunks_segment =
+      std::make_shared<ReferenceSegment>(_table, ColumnID{0}, multiple_chunks_pos_list);
+  segment_iterate<int32_t>(*multiple_chunks_segment, [](const auto& position) {});
+  {
+    const auto accessor = create_segment_accessor<int32_t>(multiple_chunks_segment);
+    EXPECT_EQ(accessor->access(ChunkOffset{0}), 1);
+  }
+  EXPECT_EQ(_count(first_segment, SegmentAccessCounter::AccessType::Random), 2);
+  EXPECT_EQ(_count(second_segment, SegmentAccessCounter::AccessType::Random), 4);
+
+  EXPECT_EQ(_count(first_segment, SegmentAccessCounter::AccessType::Point), 0);
+  EXPECT_EQ(_count(second_segment, SegmentAccessCounter::AccessType::Point), 0);
+  EXPECT_EQ(_count(multiple_chunks_segment, SegmentAccessCounter::AccessType::Random), 0);
+}
+
+TEST_F(SegmentAccessCounterTest, EncodingKeepsAccesses) {
+  const auto chunk = _table->get_chunk(ChunkID{0});
+  segment_iterate<int32_t>(*chunk->get_segment(ColumnID{0}), [](const auto& position) {});
+
+  // Neither encoding the chunk nor generating its pruning statistics is counted
+  ChunkEncoder::encode_chunk(chunk, _table->column_data_types(), EncodingType::RunLength);
+  EXPECT_EQ(_count(chunk->get_segment(ColumnID{0}), SegmentAccessCounter::AccessType::Sequential), 4);
+  EXPECT_EQ(_count(chunk->get_segment(ColumnID{1}), SegmentAccessCounter::AccessType::Sequential), 0);
+}
+
+TEST_F(SegmentAccessCounterTest, MetaTable) {
+  Hyrise::get().storage_manager.add_table("access_table", _table);
+
+  // Adding the table does not count as an access
+  EXPECT_EQ(_count(_table->get_chunk(ChunkID{0})->get_segment(ColumnID{0}), SegmentAccessCounter::AccessType::Random),
+            0);
+
+  const auto [status, result] =
+      SQLPipelineBuilder{"SELECT a FROM access_table WHERE a > 5"}.create_pipeline().get_result_table();
+  ASSERT_EQ(status, SQLPipelineStatus::Success);
+  EXPECT_EQ(result->row_count(), 2);
+
+  const auto meta_table = Hyrise::get().storage_manager.get_table(MetaTableManager::META_PREFIX + "segments_accesses");
+  ASSERT_EQ(meta_table->row_count(), 4);
+
+  for (auto row_id = size_t{0}; row_id < meta_table->row_count(); ++row_id) {
+    const auto column_name = meta_table->get_value<pmr_string>(ColumnID{3}, row_id);
+    const auto access_count = meta_table->get_value<int64_t>(ColumnID{5}, row_id) +
+                              meta_table->get_value<int64_t>(ColumnID{6}, row_id) +
+                              meta_table->get_value<int64_t>(ColumnID{7}, row_id);
+
+    // Column a is scanned, column b is never read
+    if (column_name == "a") {
+      EXPECT_GT(access_count, 0);
+    } else {
+      EXPECT_EQ(access_count, 0);
+    }
+  }
+}
+
+}  // namespace opossum
@@ -8,6 +8,9 @@
 
 #include "hyrise.hpp"
 #include "logical_query_plan/stored_table_node.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/dictionary_segment.hpp"
 #include "storage/table.hpp"
 #include "utils/meta_table_manager.hpp"
 
@@ -58,6 +61,19 @@ TEST_F(StorageManagerTest, DropTable) {
   EXPECT_THROW(sm.drop_table("first_table"), std::exception);
 }
 
+TEST_F(StorageManagerTest, FindTableName) {
+  auto& sm = Hyrise::get().storage_manager;
+  const auto table = sm.get_table("second_table");
+  EXPECT_EQ(sm.find_table_name(*table), "second_table");
+
+  sm.drop_table("second_table");
+  EXPECT_EQ(sm.find_table_name(*table), std::nullopt);
+
+  const auto unknown_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data);
+  EXPECT_EQ(sm.find_table_name(*unknown_table), std::nullopt);
+}
+
 TEST_F(StorageManagerTest, DoesNotHaveTable) {
   auto& sm = Hyrise::get().storage_manager;
   EXPECT_EQ(sm.has_table("third_table"), false);
@@ -153,4 +169,83 @@ TEST_F(StorageManagerTest, ExportTables) {
   std::filesystem::remove(filename);
 }
 
+TEST_F(StorageManagerTest, WriteAndLoadCheckpoint) {
+  auto& sm = Hyrise::get().storage_manager;
+  const auto table = load_table("resources/test_data/tbl/int_float_with_null.tbl", 3);
+  ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{EncodingType::Dictionary});
+  sm.add_table("int_float", table);
+
+  SQLPipelineBuilder{"DELETE FROM int_float WHERE a = 123"}.create_pipeline().get_result_table();
+  SQLPipelineBuilder{"INSERT INTO int_float VALUES (2, 2.5)"}.create_pipeline().get_result_table();
+  const auto [expected_status, expected_table] =
+      SQLPipelineBuilder{"SELECT * FROM int_float"}.create_pipeline().get_result_table();
+
+  // The insert is not committed when the checkpoint is written, so it must not be part of it
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context();
+  SQLPipelineBuilder{"INSERT INTO int_float VALUES (1, 1.5)"}
+      .with_transaction_context(transaction_context)
+      .create_pipeline()
+      .get_result_table();
+
+  const auto path = test_data_path + "/checkpoint";
+  sm.write_checkpoint(path);
+  transaction_context->rollback();
+
+  Hyrise::reset();
+  Hyrise::get().storage_manager.load_checkpoint(path);
+  std::filesystem::remove_all(path);
+
+  EXPECT_TRUE(Hyrise::get().storage_manager.has_table("first_table"));
+  EXPECT_EQ(Hyrise::get().storage_manager.get_table("second_table")->max_chunk_size(), ChunkOffset{4});
+
+  const auto [status, loaded_table] =
+      SQLPipelineBuilder{"SELECT * FROM int_float"}.create_pipeline().get_result_table();
+  EXPECT_TABLE_EQ_UNORDERED(loaded_table, expected_table);
+
+  // Encoded chunks are loaded as they are, the last chunk remains mutable
+  const auto stored_table = Hyrise::get().storage_manager.get_table("int_float");
+  ASSERT_EQ(stored_table->chunk_count(), ChunkID{3});
+  EXPECT_TRUE(std::dynamic_pointer_cast<const DictionarySegment<int32_t>>(
+      stored_table->get_chunk(ChunkID{0})->get_segment(ColumnID{0})));
+  EXPECT_FALSE(stored_table->get_chunk(ChunkID{1})->is_mutable());
+  EXPECT_TRUE(stored_table->get_chunk(ChunkID{2})->is_mutable());
+  EXPECT_EQ(stored_table->get_chunk(ChunkID{2})->invalid_row_count(), ChunkOffset{1});
+}
+
+TEST_F(StorageManagerTest, CheckpointKeepsChunkIDsOfDeletedChunks) {
+  auto& sm = Hyrise::get().storage_manager;
+  const auto table = load_table("resources/test_data/tbl/int_float.tbl", 1);
+  sm.add_table("int_float", table);
+
+  // Physically delete the first chunk, as the MvccDeletePlugin would
+  const auto first_chunk = table->get_chunk(ChunkID{0});
+  first_chunk->get_scoped_mvcc_data_lock()->set_end_cid(ChunkOffset{0}, CommitID{0});
+  first_chunk->increase_invalid_row_count(1);
+  first_chunk->finalize();
+  table->remove_chunk(ChunkID{0});
+
+  // Writing a second checkpoint into the same directory replaces the first one
+  const auto path = test_data_path + "/checkpoint";
+  sm.write_checkpoint(path);
+  sm.write_checkpoint(path);
+
+  auto data_directory_count = size_t{0};
+  for (const auto& entry : std::filesystem::directory_iterator{path}) {
+    if (entry.is_directory()) ++data_directory_count;
+  }
+  EXPECT_EQ(data_directory_count, 1u);
+
+  Hyrise::reset();
+  Hyrise::get().storage_manager.load_checkpoint(path);
+  std::filesystem::remove_all(path);
+
+  const auto loaded_table = Hyrise::get().storage_manager.get_table("int_float");
+  ASSERT_EQ(loaded_table->chunk_count(), table->chunk_count());
+  EXPECT_FALSE(loaded_table->get_chunk(ChunkID{0}));
+  for (auto chunk_id = ChunkID{1}; chunk_id < table->chunk_count(); ++chunk_id) {
+    EXPECT_EQ((*loaded_table->get_chunk(chunk_id)->get_segment(ColumnID{0}))[ChunkOffset{0}],
+              (*table->get_chunk(chunk_id)->get_segment(ColumnID{0}))[ChunkOffset{0}]);
+  }
+}
+
 }  // namespace opossum
@@ -0,0 +1,314 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "operators/get_table.hpp"
+#include "operators/index_scan.hpp"
+#include "operators/insert.hpp"
+#include "operators/join_index.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/index/table_index.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class TableIndexTest : public BaseTest {
+ public:
+  void SetUp() override {
+    // Three chunks of three rows, the last chunk is still mutable
+    _table = std::make_shared<Table>(
+        TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::String, false}, {"c", DataType::Int, false}},
+        TableType::Data, ChunkOffset{3}, UseMvcc::Yes);
+    _table->append({4, "d", 0});
+    _table->append({1, "a", 1});
+    _table->append({3, "c", 2});
+    _table->append({2, "b", 3});
+    _table->append({NullValue{}, "x", 4});
+    _table->append({3, "e", 5});
+    _table->append({5, "f", 6});
+    _table->append({1, "g", 7});
+  }
+
+  static std::shared_ptr<Table> _values_table(const std::vector<int32_t>& values) {
+    auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data);
+    for (const auto value : values) {
+      table->append({value});
+    }
+    return table;
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(TableIndexTest, Lookup) {
+  _table->create_table_index({ColumnID{0}});
+  const auto table_index = _table->get_table_index({ColumnID{0}});
+  ASSERT_TRUE(table_index);
+  EXPECT_FALSE(_table->get_table_index({ColumnID{1}}));
+
+  // The row with a NULL value is not indexed
+  EXPECT_EQ(table_index->size(), 7);
+
+  EXPECT_EQ(table_index->lookup(PredicateCondition::Equals, {3}),
+            PosList({RowID{ChunkID{0}, ChunkOffset{2}}, RowID{ChunkID{1}, ChunkOffset{2}}}));
+  EXPECT_EQ(table_index->lookup(PredicateCondition::Equals, {7}), PosList{});
+  EXPECT_EQ(table_index->lookup(PredicateCondition::Equals, {NullValue{}}), PosList{});
+
+  // Results are ordered by key
+  EXPECT_EQ(table_index->lookup(PredicateCondition::LessThan, {3}),
+            PosList({RowID{ChunkID{0}, ChunkOffset{1}}, RowID{ChunkID{2}, ChunkOffset{1}},
+                     RowID{ChunkID{1}, ChunkOffset{0}}}));
+  EXPECT_EQ(table_index->lookup(PredicateCondition::GreaterThanEquals, {4}),
+            PosList({RowID{ChunkID{0}, ChunkOffset{0}}, RowID{ChunkID{2}, ChunkOffset{0}}}));
+  EXPECT_EQ(table_index->lookup(PredicateCondition::NotEquals, {3}).size(), 5);
+  EXPECT_EQ(table_index->lookup(PredicateCondition::BetweenInclusive, {2}, {3}).size(), 3);
+  EXPECT_EQ(table_index->lookup(PredicateCondition::BetweenExclusive, {2}, {4}).size(), 2);
+  EXPECT_EQ(table_index->lookup(PredicateCondition::BetweenExclusive, {3}, {3}).size(), 0);
+  EXPECT_EQ(table_index->lookup(PredicateCondition::BetweenInclusive, {4}, {2}).size(), 0);
+
+  EXPECT_THROW(table_index->lookup(PredicateCondition::Equals, {int64_t{3}}), std::logic_error);
+}
+
+TEST_F(TableIndexTest, CompositeKeys) {
+  _table->create_table_index({ColumnID{0}, ColumnID{1}});
+  const auto table_index = _table->get_table_index({ColumnID{0}, ColumnID{1}});
+  ASSERT_TRUE(table_index);
+  EXPECT_FALSE(_table->get_table_index({ColumnID{1}, ColumnID{0}}));
+
+  EXPECT_EQ(table_index->lookup(PredicateCondition::Equals, {3, pmr_string{"e"}}),
+            PosList({RowID{ChunkID{1}, ChunkOffset{2}}}));
+  EXPECT_EQ(table_index->lookup(PredicateCondition::LessThan, {3, pmr_string{"e"}}).size(), 4);
+}
+
+TEST_F(TableIndexTest, KeyOrder) {
+  // Keys are compared as normalized bytes, which have to keep the order of negative numbers and of string prefixes
+  auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Long, false}, {"b", DataType::Double, false},
+                             {"c", DataType::String, false}},
+      TableType::Data, ChunkOffset{2});
+  table->append({int64_t{-3}, -2.5, pmr_string{"ab"}});
+  table->append({int64_t{2}, 0.0, pmr_string{"a"}});
+  table->append({int64_t{-1}, -0.0, pmr_string{""}});
+  table->append({int64_t{1}, 1.5, pmr_string{"b"}});
+  table->append({int64_t{-4}, -10.0, pmr_string("a\0", 2)});
+
+  table->create_table_index({ColumnID{0}});
+  table->create_table_index({ColumnID{1}});
+  table->create_table_index({ColumnID{2}});
+
+  EXPECT_EQ(table->get_table_index({ColumnID{0}})->lookup(PredicateCondition::LessThan, {int64_t{0}}),
+            PosList({RowID{ChunkID{2}, ChunkOffset{0}}, RowID{ChunkID{0}, ChunkOffset{0}},
+                     RowID{ChunkID{1}, ChunkOffset{0}}}));
+
+  // -0.0 equals 0.0
+  const auto double_index = table->get_table_index({ColumnID{1}});
+  EXPECT_EQ(double_index->lookup(PredicateCondition::Equals, {0.0}),
+            PosList({RowID{ChunkID{0}, ChunkOffset{1}}, RowID{ChunkID{1}, ChunkOffset{0}}}));
+  EXPECT_EQ(double_index->lookup(PredicateCondition::LessThan, {-1.0}),
+            PosList({RowID{ChunkID{2}, ChunkOffset{0}}, RowID{ChunkID{0}, ChunkOffset{0}}}));
+  EXPECT_EQ(double_index->lookup(PredicateCondition::GreaterThan, {-0.0}),
+            PosList({RowID{ChunkID{1}, ChunkOffset{1}}}));
+
+  // A string comes before the strings it is a prefix of, also if they continue with a zero byte
+  EXPECT_EQ(table->get_table_index({ColumnID{2}})->lookup(PredicateCondition::LessThanEquals, {pmr_string{"ab"}}),
+            PosList({RowID{ChunkID{1}, ChunkOffset{0}}, RowID{ChunkID{0}, ChunkOffset{1}},
+                     RowID{ChunkID{2}, ChunkOffset{0}}, RowID{ChunkID{0}, ChunkOffset{0}}}));
+}
+
+TEST_F(TableIndexTest, Maintenance) {
+  // Encoded chunks are indexed as well
+  ChunkEncoder::encode_chunk(_table->get_chunk(ChunkID{0}), _table->column_data_types(), EncodingType::Dictionary);
+  _table->create_table_index({ColumnID{0}});
+  const auto table_index = _table->get_table_index({ColumnID{0}});
+
+  _table->append({3, "h", 8});
+  _table->append_chunk(Segments{std::make_shared<ValueSegment<int32_t>>(std::vector<int32_t>{3, 1, 3}),
+                                std::make_shared<ValueSegment<pmr_string>>(std::vector<pmr_string>{"i", "j", "k"}),
+                                std::make_shared<ValueSegment<int32_t>>(std::vector<int32_t>{9, 10, 11})},
+                       std::make_shared<MvccData>(3, CommitID{0}));
+  EXPECT_EQ(table_index->lookup(PredicateCondition::Equals, {3}),
+            PosList({RowID{ChunkID{0}, ChunkOffset{2}}, RowID{ChunkID{1}, ChunkOffset{2}},
+                     RowID{ChunkID{2}, ChunkOffset{2}}, RowID{ChunkID{3}, ChunkOffset{0}},
+                     RowID{ChunkID{3}, ChunkOffset{2}}}));
+
+  // Physically removing a chunk removes its rows from the index
+  const auto chunk = _table->get_chunk(ChunkID{1});
+  chunk->increase_invalid_row_count(chunk->size());
+  _table->remove_chunk(ChunkID{1});
+  EXPECT_EQ(table_index->lookup(PredicateCondition::Equals, {3}).size(), 4);
+  EXPECT_EQ(table_index->size(), 9);
+}
+
+TEST_F(TableIndexTest, RemoveChunkWithDuplicateKeys) {
+  // Removing the rows of a chunk does not search through all rows with the same key
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                       ChunkOffset{1'000});
+  for (auto row_index = 0; row_index < 10'000; ++row_index) {
+    table->append({row_index % 2});
+  }
+  table->create_table_index({ColumnID{0}});
+  const auto table_index = table->get_table_index({ColumnID{0}});
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < ChunkID{9}; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    chunk->increase_invalid_row_count(chunk->size());
+    table->remove_chunk(chunk_id);
+  }
+
+  EXPECT_EQ(table_index->size(), 1'000);
+  const auto matches = table_index->lookup(PredicateCondition::Equals, {1});
+  ASSERT_EQ(matches.size(), 500);
+  EXPECT_EQ(matches.front(), (RowID{ChunkID{9}, ChunkOffset{1}}));
+  EXPECT_EQ(matches.back(), (RowID{ChunkID{9}, ChunkOffset{999}}));
+}
+
+TEST_F(TableIndexTest, MaintenanceByInsert) {
+  _table->create_table_index({ColumnID{2}});
+  const auto table_index = _table->get_table_index({ColumnID{2}});
+  Hyrise::get().storage_manager.add_table("indexed_table", _table);
+
+  auto values_to_insert = std::make_shared<Table>(_table->column_definitions(), TableType::Data);
+  values_to_insert->append({6, "y", 10});
+  values_to_insert->append({7, "z", 11});
+  auto table_wrapper = std::make_shared<TableWrapper>(values_to_insert);
+  table_wrapper->execute();
+
+  const auto insert = std::make_shared<Insert>("indexed_table", table_wrapper);
+  const auto insert_context = Hyrise::get().transaction_manager.new_transaction_context();
+  insert->set_transaction_context(insert_context);
+  insert->execute();
+
+  // The rows are indexed right away, but Validate filters them until the transaction commits
+  EXPECT_EQ(table_index->lookup(PredicateCondition::Equals, {11}), PosList({RowID{ChunkID{3}, ChunkOffset{0}}}));
+
+  const auto scan_for_inserted_row = [&]() {
+    const auto get_table = std::make_shared<GetTable>("indexed_table");
+    const auto index_scan = std::make_shared<IndexScan>(get_table, SegmentIndexType::GroupKey,
+                                                        std::vector<ColumnID>{ColumnID{2}}, PredicateCondition::Equals,
+                                                        std::vector<AllTypeVariant>{11});
+    const auto validate = std::make_shared<Validate>(index_scan);
+    const auto context = Hyrise::get().transaction_manager.new_transaction_context();
+    get_table->set_transaction_context(context);
+    validate->set_transaction_context(context);
+    get_table->execute();
+    index_scan->execute();
+    validate->execute();
+    return validate->get_output()->row_count();
+  };
+
+  EXPECT_EQ(scan_for_inserted_row(), 0);
+  insert_context->commit();
+  EXPECT_EQ(scan_for_inserted_row(), 1);
+}
+
+TEST_F(TableIndexTest, IndexScan) {
+  _table->create_table_index({ColumnID{0}});
+  Hyrise::get().storage_manager.add_table("indexed_table", _table);
+
+  // No chunk has a chunk-local index, so the IndexScan can only succeed by using the forwarded TableIndex
+  const auto get_table = std::make_shared<GetTable>("indexed_table", std::vector<ChunkID>{},
+                                                    std::vector<ColumnID>{ColumnID{1}});
+  get_table->execute();
+  ASSERT_TRUE(get_table->get_output()->get_table_index({ColumnID{0}}));
+
+  const auto index_scan = std::make_shared<IndexScan>(get_table, SegmentIndexType::GroupKey,
+                                                      std::vector<ColumnID>{ColumnID{0}}, PredicateCondition::LessThan,
+                                                      std::vector<AllTypeVariant>{3});
+  index_scan->execute();
+
+  // One output chunk per input chunk with matches
+  const auto output = index_scan->get_output();
+  ASSERT_EQ(output->chunk_count(), 3);
+  EXPECT_EQ(output->row_count(), 3);
+  EXPECT_EQ(output->get_value<int32_t>(ColumnID{1}, 0), 1);
+
+  // Only chunks that are included are scanned
+  const auto included_index_scan = std::make_shared<IndexScan>(
+      get_table, SegmentIndexType::GroupKey, std::vector<ColumnID>{ColumnID{0}}, PredicateCondition::LessThan,
+      std::vector<AllTypeVariant>{3});
+  included_index_scan->included_chunk_ids = {ChunkID{1}, ChunkID{2}};
+  included_index_scan->execute();
+  EXPECT_EQ(included_index_scan->get_output()->row_count(), 2);
+
+  // If GetTable cannot forward the TableIndex, the chunks without a chunk-local index are scanned by a TableScan
+  const auto pruned_get_table = std::make_shared<GetTable>("indexed_table", std::vector<ChunkID>{ChunkID{1}},
+                                                           std::vector<ColumnID>{});
+  pruned_get_table->execute();
+  ASSERT_TRUE(pruned_get_table->get_output()->table_indexes().empty());
+
+  const auto fallback_index_scan = std::make_shared<IndexScan>(
+      pruned_get_table, SegmentIndexType::GroupKey, std::vector<ColumnID>{ColumnID{0}},
+      PredicateCondition::BetweenInclusive, std::vector<AllTypeVariant>{1}, std::vector<AllTypeVariant>{3});
+  fallback_index_scan->execute();
+  EXPECT_EQ(fallback_index_scan->get_output()->row_count(), 3);
+}
+
+TEST_F(TableIndexTest, GetTableForwarding) {
+  _table->create_table_index({ColumnID{2}});
+  Hyrise::get().storage_manager.add_table("indexed_table", _table);
+
+  // The ColumnIDs are adapted to the pruned columns
+  const auto pruned_columns = std::make_shared<GetTable>("indexed_table", std::vector<ChunkID>{},
+                                                         std::vector<ColumnID>{ColumnID{0}});
+  pruned_columns->execute();
+  EXPECT_TRUE(pruned_columns->get_output()->get_table_index({ColumnID{1}}));
+
+  // Indexes on pruned columns are not forwarded
+  const auto pruned_indexed_column = std::make_shared<GetTable>("indexed_table", std::vector<ChunkID>{},
+                                                                std::vector<ColumnID>{ColumnID{2}});
+  pruned_indexed_column->execute();
+  EXPECT_TRUE(pruned_indexed_column->get_output()->table_indexes().empty());
+
+  // If a chunk in the middle is pruned, the ChunkIDs do not match the RowIDs in the index anymore
+  const auto pruned_chunk = std::make_shared<GetTable>("indexed_table", std::vector<ChunkID>{ChunkID{1}},
+                                                       std::vector<ColumnID>{});
+  pruned_chunk->execute();
+  EXPECT_TRUE(pruned_chunk->get_output()->table_indexes().empty());
+
+  const auto pruned_last_chunk = std::make_shared<GetTable>("indexed_table", std::vector<ChunkID>{ChunkID{2}},
+                                                            std::vector<ColumnID>{});
+  pruned_last_chunk->execute();
+  EXPECT_TRUE(pruned_last_chunk->get_output()->get_table_index({ColumnID{2}}));
+}
+
+TEST_F(TableIndexTest, JoinIndex) {
+  _table->create_table_index({ColumnID{0}});
+
+  const auto index_side = std::make_shared<TableWrapper>(_table);
+  const auto probe_side = std::make_shared<TableWrapper>(_values_table({3, 1, 6}));
+  index_side->execute();
+  probe_side->execute();
+
+  const auto join = std::make_shared<JoinIndex>(
+      probe_side, index_side, JoinMode::Inner, OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}},
+                                                                     PredicateCondition::Equals});
+  join->execute();
+  EXPECT_EQ(join->get_output()->row_count(), 4);
+
+  const auto& performance_data = static_cast<const JoinIndex::PerformanceData&>(join->performance_data());
+  EXPECT_EQ(performance_data.chunks_scanned_with_index, 3);
+  EXPECT_EQ(performance_data.chunks_scanned_without_index, 0);
+
+  // The probe side value is the left operand of the predicate, the index is searched for values less than it
+  const auto greater_than_join = std::make_shared<JoinIndex>(
+      probe_side, index_side, JoinMode::Inner, OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}},
+                                                                     PredicateCondition::GreaterThan});
+  greater_than_join->execute();
+  EXPECT_EQ(greater_than_join->get_output()->row_count(), 3 + 0 + 7);
+
+  // Probe side values without matches are kept by outer joins
+  const auto left_join = std::make_shared<JoinIndex>(
+      probe_side, index_side, JoinMode::Left, OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}},
+                                                                    PredicateCondition::Equals});
+  left_join->execute();
+  EXPECT_EQ(left_join->get_output()->row_count(), 5);
+}
+
+}  // namespace opossum
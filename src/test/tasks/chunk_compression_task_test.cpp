@@ -10,6 +10,7 @@
 #include "operators/get_table.hpp"
 #include "operators/insert.hpp"
 #include "operators/validate.hpp"
+#include "storage/base_encoded_segment.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "tasks/chunk_compression_task.hpp"
 
@@ -116,4 +117,78 @@ TEST_F(ChunkCompressionTaskTest, CompressionWithAbortedInsert) {
   EXPECT_EQ(validate->get_output()->row_count(), 12u);
 }
 
+TEST_F(ChunkCompressionTaskTest, FinalizesCompletedChunks) {
+  auto table = load_table("resources/test_data/tbl/compression_input.tbl", 6u);
+  Hyrise::get().storage_manager.add_table("table_insert", table);
+
+  auto gt = std::make_shared<GetTable>("table_insert");
+  gt->execute();
+
+  auto ins = std::make_shared<Insert>("table_insert", gt);
+  auto context = Hyrise::get().transaction_manager.new_transaction_context();
+  ins->set_transaction_context(context);
+  ins->execute();
+
+  ASSERT_EQ(table->chunk_count(), 4u);
+  const auto chunk = table->get_chunk(ChunkID{2});
+  ASSERT_TRUE(chunk->is_mutable());
+
+  // The inserting transaction has not committed yet
+  EXPECT_FALSE(ChunkCompressionTask::chunk_is_completed(chunk, table->max_chunk_size()));
+
+  context->commit();
+  EXPECT_TRUE(ChunkCompressionTask::chunk_is_completed(chunk, table->max_chunk_size()));
+
+  auto compression = std::make_shared<ChunkCompressionTask>(
+      "table_insert", std::vector<ChunkID>{ChunkID{2}},
+      ChunkEncodingSpec{SegmentEncodingSpec{EncodingType::RunLength}, SegmentEncodingSpec{EncodingType::RunLength}});
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(
+      std::vector<std::shared_ptr<ChunkCompressionTask>>{compression});
+
+  EXPECT_FALSE(chunk->is_mutable());
+  EXPECT_TRUE(chunk->pruning_statistics());
+  const auto encoded_segment = std::dynamic_pointer_cast<const BaseEncodedSegment>(chunk->get_segment(ColumnID{0}));
+  ASSERT_TRUE(encoded_segment);
+  EXPECT_EQ(encoded_segment->encoding_type(), EncodingType::RunLength);
+
+  auto gt2 = std::make_shared<GetTable>("table_insert");
+  gt2->execute();
+  auto validate = std::make_shared<Validate>(gt2);
+  validate->set_transaction_context(Hyrise::get().transaction_manager.new_transaction_context());
+  validate->execute();
+  EXPECT_EQ(validate->get_output()->row_count(), 24u);
+}
+
+TEST_F(ChunkCompressionTaskTest, CompressesChunkWithFailedAllocation) {
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data, 10u,
+                                       UseMvcc::Yes);
+  table->append({1});
+  table->append({2});
+  Hyrise::get().storage_manager.add_table("table_failed_allocation", table);
+
+  const auto chunk = table->get_chunk(ChunkID{0});
+  EXPECT_FALSE(ChunkCompressionTask::chunk_is_completed(chunk, table->max_chunk_size()));
+
+  // An Insert grows the MvccData of its reserved rows, but fails to grow the segments, e.g., because it runs out of
+  // memory. Its rows are never written and never committed.
+  const auto reserved_rows = chunk->reserve_rows(3, table->max_chunk_size());
+  {
+    auto allocation_guard = Chunk::RowAllocationGuard{*chunk, reserved_rows.second};
+    ASSERT_TRUE(chunk->wait_for_allocated_rows(reserved_rows.first));
+    chunk->get_scoped_mvcc_data_lock()->grow_by(3u, TransactionID{1}, MvccData::MAX_COMMIT_ID);
+  }
+
+  ASSERT_TRUE(chunk->allocation_failed());
+  EXPECT_EQ(chunk->size(), 2u);
+  EXPECT_TRUE(ChunkCompressionTask::chunk_is_completed(chunk, table->max_chunk_size()));
+
+  auto compression = std::make_shared<ChunkCompressionTask>("table_failed_allocation", ChunkID{0});
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(
+      std::vector<std::shared_ptr<ChunkCompressionTask>>{compression});
+
+  EXPECT_FALSE(chunk->is_mutable());
+  EXPECT_EQ(chunk->get_scoped_mvcc_data_lock()->max_begin_cid, CommitID{0});
+  EXPECT_TRUE(std::dynamic_pointer_cast<const BaseEncodedSegment>(chunk->get_segment(ColumnID{0})));
+}
+
 }  // namespace opossum